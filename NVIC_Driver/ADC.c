@@ -0,0 +1,320 @@
+/*
+ * ADC.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "DWT.h"
+#include "UDMA.h"
+#include "ADC.h"
+
+#define ADC_SEQUENCER_MASK(Sequencer)     ((uint32)1 << (Sequencer))
+
+/* ADC0 sequencers use uDMA channels 14 .. 17 (encoding 0), ADC1 sequencers channels 24 .. 27 (encoding 1) */
+#define ADC_DMA_CHANNEL(Module, Sequencer) \
+    ((Udma_ChannelType)((((Module) == ADC_MODULE_0) ? 14 : 24) + (Sequencer)))
+#define ADC_DMA_ENCODING(Module)          ((uint8)(Module))
+
+/* The sequencer IRQs of each ADC follow each other */
+#define ADC_IRQ_NUM(Module, Sequencer) \
+    ((NVIC_IRQType)((((Module) == ADC_MODULE_0) ? NVIC_IRQ_ADC0_SS0 : NVIC_IRQ_ADC1_SS0) + (Sequencer)))
+
+typedef struct
+{
+    uint16 *Buffers[2];
+    uint16 BlockSamples;
+    uint32 Control;                       /* Control word re-armed in each completed structure */
+    Udma_StructureType Next;              /* Structure that completes next, keeps the blocks in order */
+    Adc_BlockCallbackType Callback;
+    Adc_StatsType Stats;
+}Adc_ContextType;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+static const uint8 Adc_Depths[ADC_SEQUENCERS] = { ADC_SS0_STEPS, ADC_SS1_STEPS, ADC_SS2_STEPS, ADC_SS3_STEPS };
+
+static Adc_ContextType Adc_Contexts[ADC_MODULES][ADC_SEQUENCERS];
+
+/*******************************************************************************
+ *                       Private Functions Definitions                         *
+ *******************************************************************************/
+
+/* Largest power of 2 arbitration size that fits one sequence */
+static uint8 Adc_ArbitrationLog2(uint8 a_Steps)
+{
+    uint8 Log2 = 0;
+
+    while((2U << Log2) <= a_Steps)
+    {
+        Log2++;
+    }
+    return Log2;
+}
+
+/* Drop the results of the broken sequence and the partly filled buffer, restart both on a sequence boundary */
+static void Adc_Restart(volatile ADC_RegType *a_Regs, Adc_ContextType *a_Context, Adc_ModuleType a_Module,
+                        Adc_SequencerType a_Sequencer)
+{
+    Udma_ChannelType Channel = ADC_DMA_CHANNEL(a_Module, a_Sequencer);
+
+    a_Regs->ACTSS &= ~ADC_SEQUENCER_MASK(a_Sequencer);
+    Udma_AssignChannel(Channel, ADC_DMA_ENCODING(a_Module));
+    while(0 == (a_Regs->SS[a_Sequencer].SSFSTAT & ADC_SSFSTAT_EMPTY_MASK))
+    {
+        (void)a_Regs->SS[a_Sequencer].SSFIFO;
+    }
+    a_Regs->OSTAT = ADC_SEQUENCER_MASK(a_Sequencer);
+
+    Udma_Rearm(Channel, UDMA_PRIMARY, a_Context->Control, a_Context->BlockSamples);
+    Udma_Rearm(Channel, UDMA_ALTERNATE, a_Context->Control, a_Context->BlockSamples);
+    a_Context->Next = UDMA_PRIMARY;
+    Udma_ClearDone(Channel);
+    Udma_EnableChannel(Channel);
+    a_Regs->ACTSS |= ADC_SEQUENCER_MASK(a_Sequencer);
+}
+
+/* Hand the completed buffers to the callback in the order they were filled and re-arm them */
+static void Adc_Dispatch(Adc_ModuleType a_Module, Adc_SequencerType a_Sequencer)
+{
+    uint32 Start = DWT_GetCycles();
+    uint32 Callbacks = 0;
+    uint32 Mark;
+    volatile ADC_RegType *Regs = ADC(a_Module);
+    Adc_ContextType *Context = &Adc_Contexts[a_Module][a_Sequencer];
+    Udma_ChannelType Channel = ADC_DMA_CHANNEL(a_Module, a_Sequencer);
+    boolean Overflow;
+
+    Regs->ISC = ADC_SEQUENCER_MASK(a_Sequencer);
+    Udma_ClearDone(Channel);
+    Overflow = (Regs->OSTAT & ADC_SEQUENCER_MASK(a_Sequencer)) ? TRUE : FALSE;
+
+    while(Udma_GetMode(Channel, Context->Next) == UDMA_MODE_STOP)
+    {
+        if(Context->Callback != NULL_PTR)
+        {
+            Mark = DWT_GetCycles();
+            Context->Callback(Context->Buffers[Context->Next], Context->BlockSamples);
+            Callbacks += DWT_GetCycles() - Mark;
+        }
+        /* Re-armed after the callback: a transfer that catches up stops instead of overwriting the block */
+        Udma_Rearm(Channel, Context->Next, Context->Control, Context->BlockSamples);
+        Context->Next = (Context->Next == UDMA_PRIMARY) ? UDMA_ALTERNATE : UDMA_PRIMARY;
+        Context->Stats.Blocks++;
+        Context->Stats.Samples += Context->BlockSamples;
+    }
+
+    /* The controller stopped on a buffer still in use or the FIFO dropped results */
+    if(Overflow || !Udma_IsChannelEnabled(Channel))
+    {
+        Context->Stats.Overruns++;
+        Adc_Restart(Regs, Context, a_Module, a_Sequencer);
+    }
+
+    Context->Stats.CallbackCycles += Callbacks;
+    Context->Stats.DriverCycles   += (DWT_GetCycles() - Start) - Callbacks;
+}
+
+/*************************************************************************************
+* Service Name      : Adc_Init
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Config - Sequencer, trigger, steps, buffers and callback
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : FALSE if the configuration is not supported by the sequencer
+* Description       : The last step raises the uDMA request, one arbitration moves a whole sequence out of
+*                     the FIFO. ADC_IM stays masked: the CPU is only interrupted by the uDMA done signal of
+*                     the channel, once per buffer instead of once per sequence. The sequencer is left
+*                     disabled.
+**************************************************************************************/
+boolean Adc_Init(const Adc_ConfigType *a_Config)
+{
+    volatile ADC_RegType *Regs;
+    Adc_ContextType *Context;
+    Udma_ChannelType Channel;
+    NVIC_IRQType IRQ_Num;
+    uint32 Mask;
+    uint32 Mux = 0;
+    uint8 Step;
+
+    if((a_Config == NULL_PTR) || (a_Config->Module >= ADC_MODULES) || (a_Config->Sequencer >= ADC_SEQUENCERS) ||
+       (a_Config->Inputs == NULL_PTR) || (a_Config->Buffers[0] == NULL_PTR) || (a_Config->Buffers[1] == NULL_PTR))
+    {
+        return FALSE; /* Report an Error */
+    }
+    if((a_Config->Steps == 0) || (a_Config->Steps > Adc_Depths[a_Config->Sequencer]) ||
+       (a_Config->BlockSamples == 0) || (a_Config->BlockSamples > ADC_MAX_BLOCK_SAMPLES) ||
+       ((a_Config->BlockSamples % a_Config->Steps) != 0) || (a_Config->Averaging > 6))
+    {
+        return FALSE; /* Report an Error */
+    }
+    for(Step = 0; Step < a_Config->Steps; Step++)
+    {
+        if(a_Config->Inputs[Step] >= ADC_INPUTS)
+        {
+            return FALSE; /* Report an Error */
+        }
+        Mux |= (uint32)a_Config->Inputs[Step] << (Step * ADC_SSCTL_STEP_BITS);
+    }
+
+    Regs    = ADC(a_Config->Module);
+    Context = &Adc_Contexts[a_Config->Module][a_Config->Sequencer];
+    Channel = ADC_DMA_CHANNEL(a_Config->Module, a_Config->Sequencer);
+    IRQ_Num = ADC_IRQ_NUM(a_Config->Module, a_Config->Sequencer);
+    Mask    = ADC_SEQUENCER_MASK(a_Config->Sequencer);
+
+    SYSCTL_RCGCADC_REG |= (uint32)1 << a_Config->Module;
+    while(0 == (SYSCTL_PRADC_REG & ((uint32)1 << a_Config->Module)));
+    DWT_EnableCycleCounter();
+
+    NVIC_DisableIRQ(IRQ_Num);
+    Regs->ACTSS &= ~Mask;
+    Regs->IM    &= ~Mask;
+    Regs->EMUX   = (Regs->EMUX & ~((uint32)0xF << (a_Config->Sequencer * ADC_EMUX_FIELD_BITS))) |
+                   ((uint32)a_Config->Trigger << (a_Config->Sequencer * ADC_EMUX_FIELD_BITS));
+    Regs->SAC    = a_Config->Averaging;
+    Regs->SS[a_Config->Sequencer].SSMUX = Mux;
+    Regs->SS[a_Config->Sequencer].SSCTL = (uint32)(ADC_SSCTL_END_MASK | ADC_SSCTL_IE_MASK) <<
+                                          ((a_Config->Steps - 1) * ADC_SSCTL_STEP_BITS);
+    Regs->OSTAT  = Mask;
+    Regs->USTAT  = Mask;
+    Regs->ISC    = Mask;
+
+    Context->Buffers[0]   = a_Config->Buffers[0];
+    Context->Buffers[1]   = a_Config->Buffers[1];
+    Context->BlockSamples = a_Config->BlockSamples;
+    Context->Callback     = a_Config->Callback;
+    Context->Next         = UDMA_PRIMARY;
+    Context->Control      = UDMA_CONTROL(UDMA_SIZE_16, UDMA_INC_NONE, UDMA_SIZE_16,
+                                         Adc_ArbitrationLog2(a_Config->Steps), UDMA_MODE_PINGPONG);
+    Context->Stats.Blocks         = 0;
+    Context->Stats.Samples        = 0;
+    Context->Stats.Overruns       = 0;
+    Context->Stats.DriverCycles   = 0;
+    Context->Stats.CallbackCycles = 0;
+
+    /* Results are read from the FIFO as half-words, the FIFO is popped whatever the access size */
+    Udma_AssignChannel(Channel, ADC_DMA_ENCODING(a_Config->Module));
+    (void)Udma_SetTransfer(Channel, UDMA_PRIMARY, Context->Control, &Regs->SS[a_Config->Sequencer].SSFIFO,
+                           a_Config->Buffers[0], a_Config->BlockSamples);
+    (void)Udma_SetTransfer(Channel, UDMA_ALTERNATE, Context->Control, &Regs->SS[a_Config->Sequencer].SSFIFO,
+                           a_Config->Buffers[1], a_Config->BlockSamples);
+    Udma_ClearDone(Channel);
+    Udma_EnableChannel(Channel);
+
+    NVIC_SetPriorityIRQ(IRQ_Num, a_Config->Priority);
+    NVIC_EnableIRQ(IRQ_Num);
+    return TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : Adc_Start
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Module - ADC, a_Sequencer - Sequencer
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Enable the sequencer, it converts on each trigger from now on
+**************************************************************************************/
+void Adc_Start(Adc_ModuleType a_Module, Adc_SequencerType a_Sequencer)
+{
+    uint32 State;
+
+    if((a_Module >= ADC_MODULES) || (a_Sequencer >= ADC_SEQUENCERS))
+    {
+        return; /* Report an Error */
+    }
+    State = Enter_Critical(); /* The other sequencers may be started from another context */
+    ADC(a_Module)->ACTSS |= ADC_SEQUENCER_MASK(a_Sequencer);
+    Exit_Critical(State);
+}
+
+/*************************************************************************************
+* Service Name      : Adc_Stop
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Module - ADC, a_Sequencer - Sequencer
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Disable the sequencer, a partly filled buffer is not reported
+**************************************************************************************/
+void Adc_Stop(Adc_ModuleType a_Module, Adc_SequencerType a_Sequencer)
+{
+    uint32 State;
+
+    if((a_Module >= ADC_MODULES) || (a_Sequencer >= ADC_SEQUENCERS))
+    {
+        return; /* Report an Error */
+    }
+    State = Enter_Critical();
+    ADC(a_Module)->ACTSS &= ~ADC_SEQUENCER_MASK(a_Sequencer);
+    Exit_Critical(State);
+}
+
+/*************************************************************************************
+* Service Name      : Adc_Trigger
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Module - ADC, a_Sequencer - Sequencer
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : ADC_PSSI bits are write only, no read-modify-write is needed
+**************************************************************************************/
+void Adc_Trigger(Adc_ModuleType a_Module, Adc_SequencerType a_Sequencer)
+{
+    if((a_Module >= ADC_MODULES) || (a_Sequencer >= ADC_SEQUENCERS))
+    {
+        return; /* Report an Error */
+    }
+    ADC(a_Module)->PSSI = ADC_SEQUENCER_MASK(a_Sequencer);
+}
+
+/*************************************************************************************
+* Service Name      : Adc_GetStats
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Module - ADC, a_Sequencer - Sequencer
+* Parameters (inout): None
+* Parameters (out)  : a_Stats - Blocks, overruns and cycles since Adc_Init
+* Return value      : FALSE for an unknown sequencer
+* Description       : Copied with interrupts disabled so the counters belong to the same block
+**************************************************************************************/
+boolean Adc_GetStats(Adc_ModuleType a_Module, Adc_SequencerType a_Sequencer, Adc_StatsType *a_Stats)
+{
+    uint32 State;
+
+    if((a_Module >= ADC_MODULES) || (a_Sequencer >= ADC_SEQUENCERS) || (a_Stats == NULL_PTR))
+    {
+        return FALSE; /* Report an Error */
+    }
+    State = Enter_Critical();
+    *a_Stats = Adc_Contexts[a_Module][a_Sequencer].Stats;
+    Exit_Critical(State);
+    return TRUE;
+}
+
+/*******************************************************************************
+ *                            Sequencer Handlers                               *
+ *******************************************************************************/
+
+#define ADC_HANDLER(Name, Module, Sequencer)   void Name(void) { Adc_Dispatch((Module), (Sequencer)); }
+
+ADC_HANDLER(ADC0Seq0_Handler, ADC_MODULE_0, ADC_SS0)
+ADC_HANDLER(ADC0Seq1_Handler, ADC_MODULE_0, ADC_SS1)
+ADC_HANDLER(ADC0Seq2_Handler, ADC_MODULE_0, ADC_SS2)
+ADC_HANDLER(ADC0Seq3_Handler, ADC_MODULE_0, ADC_SS3)
+ADC_HANDLER(ADC1Seq0_Handler, ADC_MODULE_1, ADC_SS0)
+ADC_HANDLER(ADC1Seq1_Handler, ADC_MODULE_1, ADC_SS1)
+ADC_HANDLER(ADC1Seq2_Handler, ADC_MODULE_1, ADC_SS2)
+ADC_HANDLER(ADC1Seq3_Handler, ADC_MODULE_1, ADC_SS3)
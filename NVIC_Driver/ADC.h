@@ -0,0 +1,145 @@
+/******************************************************************************
+ *
+ * Module: ADC
+ *
+ * File Name: ADC.h
+ *
+ * Description: Header file for the ADC sequencers, timer triggered acquisition drained by uDMA into
+ *              ping-pong buffers
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef ADC_H_
+#define ADC_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "UDMA.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define ADC_MODULES                       DEVICE_ADCS
+#define ADC_SEQUENCERS                    4
+#define ADC_INPUTS                        12     /* AIN0 .. AIN11 */
+#define ADC_MAX_BLOCK_SAMPLES             UDMA_MAX_ITEMS
+
+/* Steps of each sequencer, also the depth of its FIFO */
+#define ADC_SS0_STEPS                     8
+#define ADC_SS1_STEPS                     4
+#define ADC_SS2_STEPS                     4
+#define ADC_SS3_STEPS                     1
+
+/* ADC_SSCTLn, 4 bits per step */
+#define ADC_SSCTL_STEP_BITS               4
+#define ADC_SSCTL_END_MASK                0x2    /* Last step of the sequence */
+#define ADC_SSCTL_IE_MASK                 0x4    /* Raise the sequence interrupt and the uDMA request */
+
+/* ADC_SSFSTATn */
+#define ADC_SSFSTAT_EMPTY_MASK            0x00000100
+
+#define ADC_EMUX_FIELD_BITS               4
+#define ADC_SAMPLE_MASK                   0x0FFF /* 12-bit conversion results */
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef enum
+{
+    ADC_MODULE_0, ADC_MODULE_1
+}Adc_ModuleType;
+
+typedef enum
+{
+    ADC_SS0, ADC_SS1, ADC_SS2, ADC_SS3
+}Adc_SequencerType;
+
+/* ADC_EMUX encodings */
+typedef enum
+{
+    ADC_TRIGGER_PROCESSOR = 0x0,          /* Adc_Trigger() */
+    ADC_TRIGGER_TIMER     = 0x5,          /* Time-outs of a GPTM half configured with AdcTrigger */
+    ADC_TRIGGER_ALWAYS    = 0xF           /* Back to back conversions */
+}Adc_TriggerType;
+
+/* Called from the sequencer interrupt with a completed buffer, the other buffer is filling meanwhile.
+ * a_Samples holds a_Count results, the steps of the sequence repeated in order. */
+typedef void (*Adc_BlockCallbackType)(const uint16 *a_Samples, uint16 a_Count);
+
+typedef struct
+{
+    Adc_ModuleType Module;
+    Adc_SequencerType Sequencer;
+    Adc_TriggerType Trigger;
+    const uint8 *Inputs;                  /* Analog input of each step, AIN0 .. AIN11 */
+    uint8 Steps;                          /* 1 .. depth of the sequencer */
+    uint8 Averaging;                      /* 2^Averaging samples per result, 0 .. 6, shared by the module */
+    uint16 *Buffers[2];                   /* Ping and pong, BlockSamples results each */
+    uint16 BlockSamples;                  /* Multiple of Steps, up to ADC_MAX_BLOCK_SAMPLES */
+    Adc_BlockCallbackType Callback;
+    NVIC_IRQPriorityType Priority;
+}Adc_ConfigType;
+
+/* Cost of the acquisition, cycles per sample = DriverCycles / Samples */
+typedef struct
+{
+    uint32 Blocks;                        /* Completed buffers handed to the callback */
+    uint32 Samples;
+    uint32 Overruns;                      /* FIFO overflows and transfers stopped on a buffer still in use */
+    uint32 DriverCycles;                  /* Sequencer interrupt cycles, callbacks excluded */
+    uint32 CallbackCycles;
+}Adc_StatsType;
+
+
+/*************************************************************************************
+* Service Name   : Adc_Init
+* Parameters (in): a_Config - Sequencer, trigger, steps, buffers and callback
+* Return value   : FALSE if the configuration is not supported by the sequencer
+* Description    : Configure the sequencer and its uDMA channel in ping-pong mode, Udma_Init must run first.
+*                  The analog pins are configured by the application.
+**************************************************************************************/
+extern boolean Adc_Init(const Adc_ConfigType *a_Config);
+
+/*************************************************************************************
+* Service Name   : Adc_Start
+* Parameters (in): a_Module - ADC, a_Sequencer - Sequencer
+* Description    : Enable the sequencer, it converts on each trigger from now on
+**************************************************************************************/
+extern void Adc_Start(Adc_ModuleType a_Module, Adc_SequencerType a_Sequencer);
+
+/*************************************************************************************
+* Service Name   : Adc_Stop
+* Parameters (in): a_Module - ADC, a_Sequencer - Sequencer
+* Description    : Disable the sequencer, a partly filled buffer is not reported
+**************************************************************************************/
+extern void Adc_Stop(Adc_ModuleType a_Module, Adc_SequencerType a_Sequencer);
+
+/*************************************************************************************
+* Service Name   : Adc_Trigger
+* Parameters (in): a_Module - ADC, a_Sequencer - Sequencer
+* Description    : Start one sequence of a sequencer on the processor trigger
+**************************************************************************************/
+extern void Adc_Trigger(Adc_ModuleType a_Module, Adc_SequencerType a_Sequencer);
+
+/*************************************************************************************
+* Service Name   : Adc_GetStats
+* Parameters (in): a_Module - ADC, a_Sequencer - Sequencer
+* Parameters (out): a_Stats - Blocks, overruns and cycles since Adc_Init
+* Return value   : FALSE for an unknown sequencer
+* Description    : Report the CPU cost of the acquisition
+**************************************************************************************/
+extern boolean Adc_GetStats(Adc_ModuleType a_Module, Adc_SequencerType a_Sequencer, Adc_StatsType *a_Stats);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* ADC_H_ */
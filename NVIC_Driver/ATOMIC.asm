@@ -0,0 +1,119 @@
+;******************************************************************************
+;
+; Module: Atomic
+;
+; File Name: ATOMIC.asm
+;
+; Description: LDREX/STREX atomic operations, declared in ATOMIC.h
+;
+; Author: Muhamed Amr
+;
+;******************************************************************************
+
+        .thumb
+        .text
+
+        .global Atomic_FetchAdd
+        .global Atomic_CompareExchange
+        .global Atomic_Exchange
+        .global Atomic_SetBits
+        .global Atomic_ClearBits
+        .global Atomic_ClearExclusive
+
+;******************************************************************************
+; All the operations take the variable address in r0 and the operand in r1.
+; STREX writes 1 in r12 when the exclusive access was lost (an exception was
+; taken since the LDREX), the sequence is then run again from the LDREX.
+;******************************************************************************
+
+;******************************************************************************
+; Atomic_FetchAdd
+; Returns the old value, stores old + r1.
+;******************************************************************************
+Atomic_FetchAdd: .asmfunc
+        MOV     r2, r0
+Atomic_FetchAdd_Retry:
+        LDREX   r0, [r2]
+        ADD     r3, r0, r1
+        STREX   r12, r3, [r2]
+        CMP     r12, #0
+        BNE     Atomic_FetchAdd_Retry
+        BX      lr
+        .endasmfunc
+
+;******************************************************************************
+; Atomic_CompareExchange
+; Stores r2 if the variable holds r1, returns 1 on success and 0 otherwise.
+; A failed compare releases the monitor with CLREX.
+;******************************************************************************
+Atomic_CompareExchange: .asmfunc
+Atomic_CompareExchange_Retry:
+        LDREX   r3, [r0]
+        CMP     r3, r1
+        BNE     Atomic_CompareExchange_Fail
+        STREX   r12, r2, [r0]
+        CMP     r12, #0
+        BNE     Atomic_CompareExchange_Retry
+        MOVS    r0, #1
+        BX      lr
+Atomic_CompareExchange_Fail:
+        CLREX
+        MOVS    r0, #0
+        BX      lr
+        .endasmfunc
+
+;******************************************************************************
+; Atomic_Exchange
+; Returns the old value, stores r1.
+;******************************************************************************
+Atomic_Exchange: .asmfunc
+        MOV     r2, r0
+Atomic_Exchange_Retry:
+        LDREX   r0, [r2]
+        STREX   r12, r1, [r2]
+        CMP     r12, #0
+        BNE     Atomic_Exchange_Retry
+        BX      lr
+        .endasmfunc
+
+;******************************************************************************
+; Atomic_SetBits
+; Returns the old value, stores old | r1.
+;******************************************************************************
+Atomic_SetBits: .asmfunc
+        MOV     r2, r0
+Atomic_SetBits_Retry:
+        LDREX   r0, [r2]
+        ORR     r3, r0, r1
+        STREX   r12, r3, [r2]
+        CMP     r12, #0
+        BNE     Atomic_SetBits_Retry
+        BX      lr
+        .endasmfunc
+
+;******************************************************************************
+; Atomic_ClearBits
+; Returns the old value, stores old & ~r1.
+;******************************************************************************
+Atomic_ClearBits: .asmfunc
+        MOV     r2, r0
+Atomic_ClearBits_Retry:
+        LDREX   r0, [r2]
+        BIC     r3, r0, r1
+        STREX   r12, r3, [r2]
+        CMP     r12, #0
+        BNE     Atomic_ClearBits_Retry
+        BX      lr
+        .endasmfunc
+
+;******************************************************************************
+; Atomic_ClearExclusive
+; The Cortex-M4 clears the local monitor on every exception entry and return,
+; only a context switch done without an exception needs this.
+;******************************************************************************
+Atomic_ClearExclusive: .asmfunc
+        CLREX
+        BX      lr
+        .endasmfunc
+
+        .end
@@ -0,0 +1,108 @@
+/*
+ * ATOMIC.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*
+ * Host fallback of ATOMIC.asm, lets the modules using the atomic operations be built and stress
+ * tested on a PC with GCC or Clang. Empty for the TI ARM compiler.
+ */
+#if !defined(__TI_ARM__)
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "ATOMIC.h"
+
+/*************************************************************************************
+* Service Name      : Atomic_FetchAdd
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Value - Added value
+* Parameters (inout): a_Variable - Shared variable
+* Parameters (out)  : None
+* Return value      : Value before the addition
+* Description       : Atomic addition
+**************************************************************************************/
+uint32 Atomic_FetchAdd(volatile uint32 *a_Variable, uint32 a_Value)
+{
+    return __atomic_fetch_add(a_Variable, a_Value, __ATOMIC_SEQ_CST);
+}
+
+/*************************************************************************************
+* Service Name      : Atomic_CompareExchange
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Expected - Value the variable must hold, a_Desired - New value
+* Parameters (inout): a_Variable - Shared variable
+* Parameters (out)  : None
+* Return value      : TRUE if the variable held a_Expected and was replaced
+* Description       : Atomic compare and swap
+**************************************************************************************/
+boolean Atomic_CompareExchange(volatile uint32 *a_Variable, uint32 a_Expected, uint32 a_Desired)
+{
+    return __atomic_compare_exchange_n(a_Variable, &a_Expected, a_Desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? TRUE : FALSE;
+}
+
+/*************************************************************************************
+* Service Name      : Atomic_Exchange
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Value - New value
+* Parameters (inout): a_Variable - Shared variable
+* Parameters (out)  : None
+* Return value      : Value before the exchange
+* Description       : Atomic swap
+**************************************************************************************/
+uint32 Atomic_Exchange(volatile uint32 *a_Variable, uint32 a_Value)
+{
+    return __atomic_exchange_n(a_Variable, a_Value, __ATOMIC_SEQ_CST);
+}
+
+/*************************************************************************************
+* Service Name      : Atomic_SetBits
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Mask - Bits to set
+* Parameters (inout): a_Variable - Shared variable
+* Parameters (out)  : None
+* Return value      : Value before the bits were set
+* Description       : Atomic OR
+**************************************************************************************/
+uint32 Atomic_SetBits(volatile uint32 *a_Variable, uint32 a_Mask)
+{
+    return __atomic_fetch_or(a_Variable, a_Mask, __ATOMIC_SEQ_CST);
+}
+
+/*************************************************************************************
+* Service Name      : Atomic_ClearBits
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Mask - Bits to clear
+* Parameters (inout): a_Variable - Shared variable
+* Parameters (out)  : None
+* Return value      : Value before the bits were cleared
+* Description       : Atomic AND NOT
+**************************************************************************************/
+uint32 Atomic_ClearBits(volatile uint32 *a_Variable, uint32 a_Mask)
+{
+    return __atomic_fetch_and(a_Variable, ~a_Mask, __ATOMIC_SEQ_CST);
+}
+
+/*************************************************************************************
+* Service Name      : Atomic_ClearExclusive
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : No exclusive monitor on the host
+**************************************************************************************/
+void Atomic_ClearExclusive(void)
+{
+}
+
+#endif /* !defined(__TI_ARM__) */
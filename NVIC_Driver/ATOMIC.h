@@ -0,0 +1,95 @@
+/******************************************************************************
+ *
+ * Module: Atomic
+ *
+ * File Name: ATOMIC.h
+ *
+ * Description: Header file for the LDREX/STREX atomic operations on the state shared with the ISRs
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef ATOMIC_H_
+#define ATOMIC_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/*
+ * Aligned 32-bit loads and stores are single accesses on the Cortex-M4, they need no exclusive
+ * pair. The read-modify-write operations below retry until their STREX succeeds: an interrupt
+ * between LDREX and STREX clears the local monitor on exception entry and return, the STREX then
+ * fails and the operation runs again on the value written by the handler. No interrupt is ever
+ * disabled. Target: ATOMIC.asm, host builds: ATOMIC.c with the compiler builtins.
+ */
+#define ATOMIC_LOAD(Variable)             (Variable)
+#define ATOMIC_STORE(Variable, Value)     ((Variable) = (Value))
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/*************************************************************************************
+* Service Name   : Atomic_FetchAdd
+* Parameters (in): a_Value - Added value, two's complement for a subtraction
+* Parameters (inout): a_Variable - Shared variable
+* Return value   : Value before the addition
+* Description    : Atomic addition
+**************************************************************************************/
+extern uint32 Atomic_FetchAdd(volatile uint32 *a_Variable, uint32 a_Value);
+
+/*************************************************************************************
+* Service Name   : Atomic_CompareExchange
+* Parameters (in): a_Expected - Value the variable must hold, a_Desired - New value
+* Parameters (inout): a_Variable - Shared variable
+* Return value   : TRUE if the variable held a_Expected and was replaced
+* Description    : Atomic compare and swap
+**************************************************************************************/
+extern boolean Atomic_CompareExchange(volatile uint32 *a_Variable, uint32 a_Expected, uint32 a_Desired);
+
+/*************************************************************************************
+* Service Name   : Atomic_Exchange
+* Parameters (in): a_Value - New value
+* Parameters (inout): a_Variable - Shared variable
+* Return value   : Value before the exchange
+* Description    : Atomic swap
+**************************************************************************************/
+extern uint32 Atomic_Exchange(volatile uint32 *a_Variable, uint32 a_Value);
+
+/*************************************************************************************
+* Service Name   : Atomic_SetBits
+* Parameters (in): a_Mask - Bits to set
+* Parameters (inout): a_Variable - Shared variable
+* Return value   : Value before the bits were set
+* Description    : Atomic OR
+**************************************************************************************/
+extern uint32 Atomic_SetBits(volatile uint32 *a_Variable, uint32 a_Mask);
+
+/*************************************************************************************
+* Service Name   : Atomic_ClearBits
+* Parameters (in): a_Mask - Bits to clear
+* Parameters (inout): a_Variable - Shared variable
+* Return value   : Value before the bits were cleared
+* Description    : Atomic AND NOT
+**************************************************************************************/
+extern uint32 Atomic_ClearBits(volatile uint32 *a_Variable, uint32 a_Mask);
+
+/*************************************************************************************
+* Service Name   : Atomic_ClearExclusive
+* Description    : CLREX, for code that switches context without an exception entry
+**************************************************************************************/
+extern void Atomic_ClearExclusive(void);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* ATOMIC_H_ */
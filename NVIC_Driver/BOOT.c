@@ -0,0 +1,135 @@
+/*
+ * BOOT.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "CLOCK.h"
+#include "DWT.h"
+#include "BOOT.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static Boot_MilestoneRecordType Boot_Milestones[BOOT_MILESTONE_COUNT];
+
+/*******************************************************************************
+ *                       Private Functions Definitions                         *
+ *******************************************************************************/
+
+/* One poll of the SYSCTL_PRx bank, TRUE when every peripheral of a_Clocks is ready */
+static boolean Boot_PeripheralsReady(const uint32 *a_Clocks)
+{
+    const volatile uint32 *PeripheralReady = &SYSCTL_PRWD_REG;
+    uint8 Index;
+
+    for(Index = 0; Index < BOOT_CLOCK_BANK_WORDS; Index++)
+    {
+        if((PeripheralReady[Index] & a_Clocks[Index]) != a_Clocks[Index])
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : Boot_BringUp
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Config - Peripheral clocks and interrupts of the application
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : TRUE when all the peripherals reported ready
+* Description       : Each peripheral needs a few clocks after its RCGCx bit is set before it can be
+*                     accessed. Setting all the bits first and then polling all the PRx registers together
+*                     overlaps these delays instead of paying them one peripheral at a time.
+**************************************************************************************/
+boolean Boot_BringUp(const Boot_ConfigType *a_Config)
+{
+    volatile uint32 *RunClockGate = &SYSCTL_RCGCWD_REG;
+    uint32 Timeout = BOOT_READY_TIMEOUT;
+    boolean Ready = FALSE;
+    uint8 Index;
+
+    if(a_Config == NULL_PTR)
+    {
+        return FALSE; /* Report an Error */
+    }
+
+    /* Enable all the clocks in one batch */
+    for(Index = 0; Index < BOOT_CLOCK_BANK_WORDS; Index++)
+    {
+        if(a_Config->Clocks[Index] != 0)
+        {
+            RunClockGate[Index] |= a_Config->Clocks[Index];
+        }
+    }
+
+    /* Wait for all of them together */
+    while((Ready == FALSE) && (Timeout != 0))
+    {
+        Ready = Boot_PeripheralsReady(a_Config->Clocks);
+        Timeout--;
+    }
+    Boot_Mark(BOOT_MILESTONE_PERIPHERALS);
+
+    /* Apply the interrupt configuration in one pass */
+    for(Index = 0; Index < a_Config->IrqsCount; Index++)
+    {
+        NVIC_SetPriorityIRQ(a_Config->Irqs[Index].IRQ_Num, a_Config->Irqs[Index].IRQ_Priority);
+        if(a_Config->Irqs[Index].Enable)
+        {
+            NVIC_EnableIRQ(a_Config->Irqs[Index].IRQ_Num);
+        }
+    }
+    Boot_Mark(BOOT_MILESTONE_NVIC);
+
+    return Ready;
+}
+
+/*************************************************************************************
+* Service Name      : Boot_Mark
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Milestone - Boot milestone reached
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Record the core cycles elapsed since reset, ResetISR clears the cycle counter
+**************************************************************************************/
+void Boot_Mark(Boot_MilestoneType a_Milestone)
+{
+    if(a_Milestone < BOOT_MILESTONE_COUNT)
+    {
+        Boot_Milestones[a_Milestone].Cycles      = DWT_GetCycles();
+        Boot_Milestones[a_Milestone].CoreClockHz = Clock_GetCoreClock();
+    }
+    else
+    {
+        /* Report an Error */
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Boot_GetMilestone
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Milestone - Boot milestone
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : Cycles since reset and core clock when the milestone was reached
+* Description       : Read a boot milestone record, an unreached milestone reads as zero
+**************************************************************************************/
+Boot_MilestoneRecordType Boot_GetMilestone(Boot_MilestoneType a_Milestone)
+{
+    Boot_MilestoneRecordType Empty = { 0, 0 };
+
+    return (a_Milestone < BOOT_MILESTONE_COUNT) ? Boot_Milestones[a_Milestone] : Empty;
+}
@@ -0,0 +1,113 @@
+/******************************************************************************
+ *
+ * Module: Boot
+ *
+ * File Name: BOOT.h
+ *
+ * Description: Header file for the batched peripheral bring-up and the boot time profiler
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef BOOT_H_
+#define BOOT_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "NVIC.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define BOOT_CLOCK_BANK_WORDS             24     /* SYSCTL_RCGCWD_REG .. SYSCTL_RCGCWTIMER_REG */
+#define BOOT_READY_TIMEOUT                100000
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Index of a peripheral in the SYSCTL RCGCx / PRx register banks */
+typedef enum
+{
+    BOOT_CLOCK_WATCHDOG   = 0,
+    BOOT_CLOCK_TIMER      = 1,
+    BOOT_CLOCK_GPIO       = 2,
+    BOOT_CLOCK_DMA        = 3,
+    BOOT_CLOCK_HIBERNATE  = 5,
+    BOOT_CLOCK_UART       = 6,
+    BOOT_CLOCK_SSI        = 7,
+    BOOT_CLOCK_I2C        = 8,
+    BOOT_CLOCK_USB        = 10,
+    BOOT_CLOCK_CAN        = 13,
+    BOOT_CLOCK_ADC        = 14,
+    BOOT_CLOCK_ACMP       = 15,
+    BOOT_CLOCK_PWM        = 16,
+    BOOT_CLOCK_QEI        = 17,
+    BOOT_CLOCK_EEPROM     = 22,
+    BOOT_CLOCK_WIDE_TIMER = 23
+}Boot_ClockBankType;
+
+typedef enum
+{
+    BOOT_MILESTONE_MAIN,                  /* C runtime initialization done, main() entered */
+    BOOT_MILESTONE_CLOCK,                 /* Core clock configured */
+    BOOT_MILESTONE_PERIPHERALS,           /* All peripheral clocks ready */
+    BOOT_MILESTONE_NVIC,                  /* Interrupt priorities and enables applied */
+    BOOT_MILESTONE_READY,                 /* System ready, application started */
+    BOOT_MILESTONE_COUNT
+}Boot_MilestoneType;
+
+typedef struct
+{
+    NVIC_IRQType IRQ_Num;
+    NVIC_IRQPriorityType IRQ_Priority;
+    boolean Enable;
+}Boot_IrqConfigType;
+
+typedef struct
+{
+    uint32 Clocks[BOOT_CLOCK_BANK_WORDS]; /* Bits to set in each RCGCx register, indexed by Boot_ClockBankType */
+    const Boot_IrqConfigType *Irqs;
+    uint8 IrqsCount;
+}Boot_ConfigType;
+
+typedef struct
+{
+    uint32 Cycles;                        /* Core cycles since reset */
+    uint32 CoreClockHz;                   /* Core clock when the milestone was reached */
+}Boot_MilestoneRecordType;
+
+
+/*************************************************************************************
+* Service Name   : Boot_BringUp
+* Parameters (in): a_Config - Peripheral clocks and interrupts of the application
+* Return value   : TRUE when all the peripherals reported ready
+* Description    : Enable all the clocks in one batch, wait for all of them together and configure the NVIC in one pass
+**************************************************************************************/
+extern boolean Boot_BringUp(const Boot_ConfigType *a_Config);
+
+/*************************************************************************************
+* Service Name   : Boot_Mark
+* Parameters (in): a_Milestone - Boot milestone reached
+* Description    : Record the core cycles elapsed since reset for a milestone
+**************************************************************************************/
+extern void Boot_Mark(Boot_MilestoneType a_Milestone);
+
+/*************************************************************************************
+* Service Name   : Boot_GetMilestone
+* Parameters (in): a_Milestone - Boot milestone
+* Return value   : Cycles since reset and core clock when the milestone was reached
+* Description    : Read a boot milestone record
+**************************************************************************************/
+extern Boot_MilestoneRecordType Boot_GetMilestone(Boot_MilestoneType a_Milestone);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* BOOT_H_ */
@@ -0,0 +1,211 @@
+/*
+ * CLOCK.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "tm4c123gh6pm_registers.h"
+#include "CLOCK.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static volatile uint32 Clock_CoreClockHz = CLOCK_RESET_HZ;
+static Clock_NotifierType Clock_Notifiers[CLOCK_MAX_NOTIFIERS];
+static uint8 Clock_NotifiersCount = 0;
+
+/*************************************************************************************
+* Service Name      : Clock_ComputeSysDiv
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Hz - Requested core clock
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : RCC2 SYSDIV2:SYSDIV2LSB divider giving the closest frequency not above a_Hz
+* Description       : Divider math of the 400 MHz PLL output, f = 400 MHz / (SysDiv + 1)
+**************************************************************************************/
+uint8 Clock_ComputeSysDiv(uint32 a_Hz)
+{
+    uint32 SysDiv;
+
+    if(a_Hz >= CLOCK_MAX_HZ)
+    {
+        return CLOCK_MIN_SYSDIV;
+    }
+    if(a_Hz <= CLOCK_MOSC_HZ)
+    {
+        return CLOCK_MAX_SYSDIV;
+    }
+
+    /* Smallest divisor (SysDiv + 1) with 400 MHz / divisor <= a_Hz */
+    SysDiv = ((CLOCK_PLL_HZ + a_Hz - 1) / a_Hz) - 1;
+    if(SysDiv < CLOCK_MIN_SYSDIV)
+    {
+        SysDiv = CLOCK_MIN_SYSDIV;
+    }
+    else if(SysDiv > CLOCK_MAX_SYSDIV)
+    {
+        SysDiv = CLOCK_MAX_SYSDIV;
+    }
+    else
+    {
+        /* In range */
+    }
+    return (uint8)SysDiv;
+}
+
+/*************************************************************************************
+* Service Name      : Clock_SysDivToHz
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_SysDiv - RCC2 SYSDIV2:SYSDIV2LSB divider
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : Core clock produced by the divider
+* Description       : Inverse of Clock_ComputeSysDiv
+**************************************************************************************/
+uint32 Clock_SysDivToHz(uint8 a_SysDiv)
+{
+    return CLOCK_PLL_HZ / ((uint32)a_SysDiv + 1);
+}
+
+/*************************************************************************************
+* Service Name      : Clock_SetCoreClock
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Hz - Requested core clock, 16 MHz to 80 MHz
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : TRUE when the clock was switched, FALSE if the MOSC did not start or the PLL did not lock
+* Description       : Follows the datasheet sequence: run from the bypassed oscillator, start the MOSC and
+*                     wait for MOSCPUPRIS before selecting it, program the PLL and the divider, wait for
+*                     PLLSTAT.LOCK and then switch the core to the PLL. 16 MHz and below runs from the MOSC
+*                     directly with the PLL powered down. On a failure the PLL is powered down and the core
+*                     stays on the bypassed 16 MHz oscillator. The timing users are notified in every case,
+*                     the bypass changed the core clock even when the switch failed.
+**************************************************************************************/
+boolean Clock_SetCoreClock(uint32 a_Hz)
+{
+    uint32 Timeout = CLOCK_MOSC_POWER_UP_TIMEOUT;
+    boolean Switched = TRUE;
+    uint8 SysDiv;
+    uint8 Index;
+
+    /* Use RCC2 and bypass the PLL while it is reconfigured, the core runs from the oscillator source */
+    SYSCTL_RCC2_REG |= CLOCK_RCC2_USERCC2_MASK | CLOCK_RCC2_BYPASS2_MASK;
+    SYSCTL_RCC_REG  &= ~CLOCK_RCC_USESYSDIV_MASK;
+
+    /* Main oscillator with the 16 MHz crystal, selected only once it is stable */
+    SYSCTL_RCC_REG = (SYSCTL_RCC_REG & ~CLOCK_RCC_XTAL_MASK) | (CLOCK_RCC_XTAL_16MHZ << CLOCK_RCC_XTAL_BITS_POS);
+    if(0 != (SYSCTL_RCC_REG & CLOCK_RCC_MOSCDIS_MASK))
+    {
+        SYSCTL_MISC_REG = CLOCK_MOSCPUP_MASK; /* Clear a stale power up event */
+        SYSCTL_RCC_REG &= ~CLOCK_RCC_MOSCDIS_MASK;
+        while((0 == (SYSCTL_RIS_REG & CLOCK_MOSCPUP_MASK)) && (Timeout != 0))
+        {
+            Timeout--;
+        }
+    }
+    if(Timeout == 0)
+    {
+        /* Report an Error, stay on the current oscillator (PIOSC or MOSC, both 16 MHz) */
+        SYSCTL_RCC2_REG |= CLOCK_RCC2_PWRDN2_MASK;
+        Clock_CoreClockHz = CLOCK_RESET_HZ;
+        Switched = FALSE;
+    }
+    else if(a_Hz <= CLOCK_MOSC_HZ)
+    {
+        SYSCTL_RCC2_REG &= ~CLOCK_RCC2_OSCSRC2_MASK;
+        SYSCTL_RCC2_REG |= CLOCK_RCC2_PWRDN2_MASK;
+        Clock_CoreClockHz = CLOCK_MOSC_HZ;
+    }
+    else
+    {
+        SYSCTL_RCC2_REG &= ~CLOCK_RCC2_OSCSRC2_MASK;
+        SysDiv = Clock_ComputeSysDiv(a_Hz);
+
+        SYSCTL_RCC2_REG &= ~CLOCK_RCC2_PWRDN2_MASK; /* Power up the PLL */
+        SYSCTL_RCC2_REG  = (SYSCTL_RCC2_REG & ~(CLOCK_RCC2_SYSDIV2_MASK | CLOCK_RCC2_SYSDIV2LSB_MASK)) |
+                           CLOCK_RCC2_DIV400_MASK | ((uint32)SysDiv << (CLOCK_RCC2_SYSDIV2_BITS_POS - 1));
+        SYSCTL_RCC_REG  |= CLOCK_RCC_USESYSDIV_MASK;
+
+        Timeout = CLOCK_PLL_LOCK_TIMEOUT;
+        while((0 == (SYSCTL_PLLSTAT_REG & CLOCK_PLLSTAT_LOCK_MASK)) && (Timeout != 0))
+        {
+            Timeout--;
+        }
+        if(Timeout == 0)
+        {
+            /* Report an Error, stay on the bypassed MOSC with the PLL powered down again */
+            SYSCTL_RCC_REG  &= ~CLOCK_RCC_USESYSDIV_MASK;
+            SYSCTL_RCC2_REG |= CLOCK_RCC2_PWRDN2_MASK;
+            Clock_CoreClockHz = CLOCK_MOSC_HZ;
+            Switched = FALSE;
+        }
+        else
+        {
+            SYSCTL_RCC2_REG &= ~CLOCK_RCC2_BYPASS2_MASK; /* Run from the PLL */
+            Clock_CoreClockHz = Clock_SysDivToHz(SysDiv);
+        }
+    }
+
+    for(Index = 0; Index < Clock_NotifiersCount; Index++)
+    {
+        Clock_Notifiers[Index](Clock_CoreClockHz);
+    }
+    return Switched;
+}
+
+/*************************************************************************************
+* Service Name      : Clock_GetCoreClock
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : Current core clock in Hz
+* Description       : Get the current core clock
+**************************************************************************************/
+uint32 Clock_GetCoreClock(void)
+{
+    return Clock_CoreClockHz;
+}
+
+/*************************************************************************************
+* Service Name      : Clock_RegisterNotifier
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Notifier - Function called after each frequency change
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Register a timing user (SysTick, timers, UART baud rate ...), duplicates are ignored
+**************************************************************************************/
+void Clock_RegisterNotifier(Clock_NotifierType a_Notifier)
+{
+    uint8 Index;
+
+    if(a_Notifier == NULL_PTR)
+    {
+        return; /* Report an Error */
+    }
+    for(Index = 0; Index < Clock_NotifiersCount; Index++)
+    {
+        if(Clock_Notifiers[Index] == a_Notifier)
+        {
+            return; /* Already registered */
+        }
+    }
+    if(Clock_NotifiersCount < CLOCK_MAX_NOTIFIERS)
+    {
+        Clock_Notifiers[Clock_NotifiersCount++] = a_Notifier;
+    }
+    else
+    {
+        /* Report an Error */
+    }
+}
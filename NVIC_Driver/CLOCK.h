@@ -0,0 +1,109 @@
+/******************************************************************************
+ *
+ * Module: Clock
+ *
+ * File Name: CLOCK.h
+ *
+ * Description: Header file for the TM4C123 system clock (MOSC / PLL) driver
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef CLOCK_H_
+#define CLOCK_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define CLOCK_RESET_HZ                    16000000UL  /* PIOSC, the clock after reset */
+#define CLOCK_MOSC_HZ                     16000000UL  /* Crystal on the LaunchPad */
+#define CLOCK_PLL_HZ                      400000000UL /* PLL output used with DIV400 */
+#define CLOCK_MAX_HZ                      80000000UL
+
+#define CLOCK_MIN_SYSDIV                  4           /* 400 MHz / (4 + 1) = 80 MHz */
+#define CLOCK_MAX_SYSDIV                  24          /* 400 MHz / (24 + 1) = 16 MHz */
+
+#define CLOCK_PLL_LOCK_TIMEOUT            100000
+#define CLOCK_MOSC_POWER_UP_TIMEOUT       100000
+#define CLOCK_MAX_NOTIFIERS               4
+
+#define CLOCK_RCC_MOSCDIS_MASK            0x00000001
+#define CLOCK_RCC_XTAL_MASK               0x000007C0
+#define CLOCK_RCC_XTAL_BITS_POS           6
+#define CLOCK_RCC_XTAL_16MHZ              0x15
+#define CLOCK_RCC_USESYSDIV_MASK          0x00400000
+
+#define CLOCK_RCC2_USERCC2_MASK           0x80000000
+#define CLOCK_RCC2_DIV400_MASK            0x40000000
+#define CLOCK_RCC2_SYSDIV2_MASK           0x1F800000
+#define CLOCK_RCC2_SYSDIV2_BITS_POS       23
+#define CLOCK_RCC2_SYSDIV2LSB_MASK        0x00400000
+#define CLOCK_RCC2_PWRDN2_MASK            0x00002000
+#define CLOCK_RCC2_BYPASS2_MASK           0x00000800
+#define CLOCK_RCC2_OSCSRC2_MASK           0x00000070
+
+#define CLOCK_PLLSTAT_LOCK_MASK           0x00000001
+
+#define CLOCK_MOSCPUP_MASK                0x00000100  /* MOSCPUPRIS in SYSCTL_RIS_REG, cleared by writing SYSCTL_MISC_REG */
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Called after every frequency change with the new core clock */
+typedef void (*Clock_NotifierType)(uint32 a_CoreClockHz);
+
+
+/*************************************************************************************
+* Service Name   : Clock_SetCoreClock
+* Parameters (in): a_Hz - Requested core clock, 16 MHz to 80 MHz
+* Return value   : TRUE when the clock was switched, FALSE if the MOSC did not start or the PLL did not lock
+* Description    : Switch the core clock to the closest PLL frequency not above a_Hz and notify the timing users,
+*                  on a failure the core runs at 16 MHz from the bypassed oscillator and they are notified too
+**************************************************************************************/
+extern boolean Clock_SetCoreClock(uint32 a_Hz);
+
+/*************************************************************************************
+* Service Name   : Clock_GetCoreClock
+* Parameters (in): None
+* Return value   : Current core clock in Hz
+* Description    : Get the current core clock
+**************************************************************************************/
+extern uint32 Clock_GetCoreClock(void);
+
+/*************************************************************************************
+* Service Name   : Clock_ComputeSysDiv
+* Parameters (in): a_Hz - Requested core clock
+* Return value   : RCC2 SYSDIV2:SYSDIV2LSB divider giving the closest frequency not above a_Hz
+* Description    : Divider math of the 400 MHz PLL output, f = 400 MHz / (SysDiv + 1)
+**************************************************************************************/
+extern uint8 Clock_ComputeSysDiv(uint32 a_Hz);
+
+/*************************************************************************************
+* Service Name   : Clock_SysDivToHz
+* Parameters (in): a_SysDiv - RCC2 SYSDIV2:SYSDIV2LSB divider
+* Return value   : Core clock produced by the divider
+* Description    : Inverse of Clock_ComputeSysDiv
+**************************************************************************************/
+extern uint32 Clock_SysDivToHz(uint8 a_SysDiv);
+
+/*************************************************************************************
+* Service Name   : Clock_RegisterNotifier
+* Parameters (in): a_Notifier - Function called after each frequency change
+* Description    : Register a timing user (SysTick, timers, UART baud rate ...), duplicates are ignored
+**************************************************************************************/
+extern void Clock_RegisterNotifier(Clock_NotifierType a_Notifier);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* CLOCK_H_ */
@@ -0,0 +1,165 @@
+/*
+ * COALESCE.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "NVIC.h"
+#include "SYSTICK.h"
+#include "COALESCE.h"
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    Coalesce_ConfigType Config;
+    volatile boolean Armed;               /* IRQ masked, batch pending */
+    volatile uint16 RemainingTicks;
+    Coalesce_StatsType Stats;
+}Coalesce_EntryType;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static Coalesce_EntryType Coalesce_Entries[COALESCE_MAX_IRQS];
+static uint8 Coalesce_EntriesCount = 0;
+
+/*************************************************************************************
+* Service Name      : Coalesce_Register
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Config - IRQ, window, batch size and batch handler
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : Coalescing id passed to Coalesce_Arrival, COALESCE_INVALID_ID if the table is full
+* Description       : Opt an IRQ in coalescing mode, call it before the IRQ is enabled
+**************************************************************************************/
+Coalesce_IdType Coalesce_Register(const Coalesce_ConfigType *a_Config)
+{
+    Coalesce_EntryType *Entry;
+
+    if((a_Config == NULL_PTR) || (a_Config->Handler == NULL_PTR) || (a_Config->WindowTicks == 0) ||
+       (a_Config->MaxBatch == 0) || (Coalesce_EntriesCount >= COALESCE_MAX_IRQS))
+    {
+        return COALESCE_INVALID_ID; /* Report an Error */
+    }
+
+    Entry = &Coalesce_Entries[Coalesce_EntriesCount];
+    Entry->Config          = *a_Config;
+    Entry->Armed           = FALSE;
+    Entry->RemainingTicks  = 0;
+    Entry->Stats.Arrivals  = 0;
+    Entry->Stats.Batches   = 0;
+    Entry->Stats.Items     = 0;
+    Entry->Stats.MaxItems  = 0;
+
+    SysTick_RegisterTickHook(Coalesce_Tick);
+    return Coalesce_EntriesCount++;
+}
+
+/*************************************************************************************
+* Service Name      : Coalesce_Arrival
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Id - Coalescing id of the IRQ
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : The first arrival masks the IRQ and opens the window, the next items accumulate in the
+*                     peripheral (FIFO, DMA buffer ...) without entering the handler again until the batch
+*                     is processed.
+**************************************************************************************/
+void Coalesce_Arrival(Coalesce_IdType a_Id)
+{
+    Coalesce_EntryType *Entry;
+
+    if(a_Id >= Coalesce_EntriesCount)
+    {
+        return; /* Report an Error */
+    }
+
+    Entry = &Coalesce_Entries[a_Id];
+    NVIC_DisableIRQ(Entry->Config.IRQ_Num);
+    Entry->Stats.Arrivals++;
+    if(Entry->Armed == FALSE)
+    {
+        Entry->RemainingTicks = Entry->Config.WindowTicks;
+        Entry->Armed          = TRUE;
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Coalesce_Tick
+* Sync/Async        : Asynchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Called every SysTick period. When a window expires the batch handler processes up to
+*                     MaxBatch items. A full batch means more items are waiting, the IRQ stays masked and the
+*                     rest is processed on the next tick, otherwise the IRQ is unmasked and the next arrival
+*                     opens a new window.
+**************************************************************************************/
+void Coalesce_Tick(void)
+{
+    Coalesce_EntryType *Entry;
+    uint16 Items;
+    uint8 Index;
+
+    for(Index = 0; Index < Coalesce_EntriesCount; Index++)
+    {
+        Entry = &Coalesce_Entries[Index];
+        if((Entry->Armed == FALSE) || (--Entry->RemainingTicks != 0))
+        {
+            continue;
+        }
+
+        Items = Entry->Config.Handler(Entry->Config.MaxBatch);
+        Entry->Stats.Batches++;
+        Entry->Stats.Items += Items;
+        if(Items > Entry->Stats.MaxItems)
+        {
+            Entry->Stats.MaxItems = Items;
+        }
+
+        if(Items >= Entry->Config.MaxBatch)
+        {
+            Entry->RemainingTicks = 1;
+        }
+        else
+        {
+            Entry->Armed = FALSE;
+            NVIC_EnableIRQ(Entry->Config.IRQ_Num);
+        }
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Coalesce_GetStats
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Id - Coalescing id of the IRQ
+* Parameters (inout): None
+* Parameters (out)  : a_Stats - Arrival and batch counters
+* Return value      : None
+* Description       : Read the counters of a coalesced IRQ, Items / Batches is the average batch size
+**************************************************************************************/
+void Coalesce_GetStats(Coalesce_IdType a_Id, Coalesce_StatsType *a_Stats)
+{
+    uint32 State;
+
+    if((a_Id >= Coalesce_EntriesCount) || (a_Stats == NULL_PTR))
+    {
+        return; /* Report an Error */
+    }
+
+    State = Enter_Critical();
+    *a_Stats = Coalesce_Entries[a_Id].Stats;
+    Exit_Critical(State);
+}
@@ -0,0 +1,89 @@
+/******************************************************************************
+ *
+ * Module: Coalesce
+ *
+ * File Name: COALESCE.h
+ *
+ * Description: Header file for the interrupt coalescing layer, high rate IRQs processed in batches
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef COALESCE_H_
+#define COALESCE_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "NVIC.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define COALESCE_MAX_IRQS                 4
+#define COALESCE_INVALID_ID               0xFF
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef uint8 Coalesce_IdType;
+
+/* Processes up to a_MaxItems accumulated items, returns the number of items processed */
+typedef uint16 (*Coalesce_BatchHandlerType)(uint16 a_MaxItems);
+
+typedef struct
+{
+    NVIC_IRQType IRQ_Num;
+    uint16 WindowTicks;                   /* SysTick periods the IRQ stays masked after the first arrival */
+    uint16 MaxBatch;                      /* Items processed by one call of the batch handler */
+    Coalesce_BatchHandlerType Handler;
+}Coalesce_ConfigType;
+
+typedef struct
+{
+    uint32 Arrivals;                      /* Interrupt handler entries */
+    uint32 Batches;                       /* Batch handler calls */
+    uint32 Items;                         /* Items processed by all the batches */
+    uint16 MaxItems;                      /* Largest batch */
+}Coalesce_StatsType;
+
+
+/*************************************************************************************
+* Service Name   : Coalesce_Register
+* Parameters (in): a_Config - IRQ, window, batch size and batch handler
+* Return value   : Coalescing id passed to Coalesce_Arrival, COALESCE_INVALID_ID if the table is full
+* Description    : Opt an IRQ in coalescing mode, the SysTick hook is registered on the first call
+**************************************************************************************/
+extern Coalesce_IdType Coalesce_Register(const Coalesce_ConfigType *a_Config);
+
+/*************************************************************************************
+* Service Name   : Coalesce_Arrival
+* Parameters (in): a_Id - Coalescing id of the IRQ
+* Description    : Mask the IRQ and open the window, called by the interrupt handler instead of processing the item
+**************************************************************************************/
+extern void Coalesce_Arrival(Coalesce_IdType a_Id);
+
+/*************************************************************************************
+* Service Name   : Coalesce_Tick
+* Parameters (in): None
+* Description    : Run the batch handler of the expired windows and unmask their IRQs, SysTick tick hook
+**************************************************************************************/
+extern void Coalesce_Tick(void);
+
+/*************************************************************************************
+* Service Name   : Coalesce_GetStats
+* Parameters (in): a_Id - Coalescing id of the IRQ
+* Parameters (out): a_Stats - Arrival and batch counters
+* Description    : Read the counters of a coalesced IRQ
+**************************************************************************************/
+extern void Coalesce_GetStats(Coalesce_IdType a_Id, Coalesce_StatsType *a_Stats);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* COALESCE_H_ */
@@ -0,0 +1,188 @@
+/*
+ * CYCLIC.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "SYSTICK.h"
+#include "DWT.h"
+#include "CYCLIC.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static const Cyclic_TableType *Cyclic_Table = NULL_PTR;
+static uint16 Cyclic_Frame = 0;
+static uint8 Cyclic_TickInFrame = 0;
+static Cyclic_StatsType Cyclic_Stats;
+static Cyclic_TaskStatsType Cyclic_TaskStats[CYCLIC_MAX_TASKS];
+
+/*************************************************************************************
+* Service Name      : Cyclic_Init
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Table - Generated major frame table
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : FALSE if the table is inconsistent
+* Description       : Start the executive at frame 0 on the next SysTick period
+**************************************************************************************/
+boolean Cyclic_Init(const Cyclic_TableType *a_Table)
+{
+    uint16 Slot;
+    uint8 Task;
+    uint32 State;
+
+    if((a_Table == NULL_PTR) || (a_Table->FramesCount == 0) || (a_Table->MinorTicks == 0) ||
+       (a_Table->TasksCount > CYCLIC_MAX_TASKS) || (a_Table->FrameStart[0] != 0))
+    {
+        return FALSE; /* Report an Error */
+    }
+    for(Slot = 0; Slot < a_Table->FrameStart[a_Table->FramesCount]; Slot++)
+    {
+        if(a_Table->Slots[Slot] >= a_Table->TasksCount)
+        {
+            return FALSE; /* Report an Error */
+        }
+    }
+
+    State = Enter_Critical();
+    Cyclic_Table       = a_Table;
+    Cyclic_Frame       = 0;
+    Cyclic_TickInFrame = 0;
+    Cyclic_Stats.Frames           = 0;
+    Cyclic_Stats.Overruns         = 0;
+    Cyclic_Stats.MaxFrameCycles   = 0;
+    Cyclic_Stats.LastOverrunFrame = CYCLIC_NO_FRAME;
+    for(Task = 0; Task < CYCLIC_MAX_TASKS; Task++)
+    {
+        Cyclic_TaskStats[Task].Runs       = 0;
+        Cyclic_TaskStats[Task].LastCycles = 0;
+        Cyclic_TaskStats[Task].MaxCycles  = 0;
+    }
+    Exit_Critical(State);
+
+    DWT_EnableCycleCounter();
+    SysTick_RegisterTickHook(Cyclic_Tick);
+    return TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : Cyclic_Tick
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : The phase offsets of the table spread the rates over the frames, so a frame only
+*                     runs its own slots. A frame that is still running when the next SysTick wrap is
+*                     pending delays the tick and is counted as an overrun, it is not aborted.
+**************************************************************************************/
+void Cyclic_Tick(void)
+{
+    const Cyclic_TableType *Table = Cyclic_Table;
+    uint16 Slot;
+    uint16 LastSlot;
+    uint8 Task;
+    uint32 FrameStart;
+    uint32 Start;
+    uint32 Cycles;
+
+    if(Table == NULL_PTR)
+    {
+        return;
+    }
+    if(++Cyclic_TickInFrame < Table->MinorTicks)
+    {
+        return;
+    }
+    Cyclic_TickInFrame = 0;
+
+    FrameStart = DWT_GetCycles();
+    LastSlot   = Table->FrameStart[Cyclic_Frame + 1];
+    for(Slot = Table->FrameStart[Cyclic_Frame]; Slot < LastSlot; Slot++)
+    {
+        Task  = Table->Slots[Slot];
+        Start = DWT_GetCycles();
+        Table->Runnables[Task]();
+        Cycles = DWT_GetCycles() - Start;
+
+        Cyclic_TaskStats[Task].Runs++;
+        Cyclic_TaskStats[Task].LastCycles = Cycles;
+        if(Cycles > Cyclic_TaskStats[Task].MaxCycles)
+        {
+            Cyclic_TaskStats[Task].MaxCycles = Cycles;
+        }
+    }
+
+    Cycles = DWT_GetCycles() - FrameStart;
+    if(Cycles > Cyclic_Stats.MaxFrameCycles)
+    {
+        Cyclic_Stats.MaxFrameCycles = Cycles;
+    }
+    if(0 != (SCB_REGS->INTCTRL & SYSTICK_PENDING_MASK))
+    {
+        Cyclic_Stats.Overruns++;
+        Cyclic_Stats.LastOverrunFrame = Cyclic_Frame;
+    }
+    Cyclic_Stats.Frames++;
+
+    if(++Cyclic_Frame >= Table->FramesCount)
+    {
+        Cyclic_Frame = 0; /* Next major frame */
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Cyclic_GetStats
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : a_Stats - Frames, overruns and longest frame
+* Return value      : None
+* Description       : Read the executive statistics
+**************************************************************************************/
+void Cyclic_GetStats(Cyclic_StatsType *a_Stats)
+{
+    uint32 State;
+
+    if(a_Stats == NULL_PTR)
+    {
+        return; /* Report an Error */
+    }
+    State = Enter_Critical();
+    *a_Stats = Cyclic_Stats;
+    Exit_Critical(State);
+}
+
+/*************************************************************************************
+* Service Name      : Cyclic_GetTaskStats
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Task - Task index in the table
+* Parameters (inout): None
+* Parameters (out)  : a_Stats - Runs and execution time of the task
+* Return value      : FALSE if the task index is out of range
+* Description       : Read the execution time statistics of one task
+**************************************************************************************/
+boolean Cyclic_GetTaskStats(uint8 a_Task, Cyclic_TaskStatsType *a_Stats)
+{
+    uint32 State;
+
+    if((a_Task >= CYCLIC_MAX_TASKS) || (a_Stats == NULL_PTR))
+    {
+        return FALSE; /* Report an Error */
+    }
+    State = Enter_Critical();
+    *a_Stats = Cyclic_TaskStats[a_Task];
+    Exit_Critical(State);
+    return TRUE;
+}
@@ -0,0 +1,97 @@
+/******************************************************************************
+ *
+ * Module: Cyclic
+ *
+ * File Name: CYCLIC.h
+ *
+ * Description: Header file for the static cyclic executive driven by the SysTick tick hooks.
+ *              The frame tables are generated offline by tools/cyclic_gen.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef CYCLIC_H_
+#define CYCLIC_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define CYCLIC_MAX_TASKS                  16
+#define CYCLIC_NO_FRAME                   0xFFFF
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef void (*Cyclic_RunnableType)(void);
+
+/* Major frame table, frame f runs Slots[FrameStart[f]] .. Slots[FrameStart[f + 1] - 1] in order */
+typedef struct
+{
+    const Cyclic_RunnableType *Runnables; /* One entry per task */
+    const uint8 *Slots;                   /* Task index of each slot, frame after frame */
+    const uint16 *FrameStart;             /* First slot of each frame, FramesCount + 1 entries */
+    uint16 FramesCount;                   /* Minor frames in the major frame */
+    uint8 TasksCount;
+    uint8 MinorTicks;                     /* SysTick periods per minor frame */
+}Cyclic_TableType;
+
+typedef struct
+{
+    uint32 Runs;
+    uint32 LastCycles;                    /* Execution time of the last run */
+    uint32 MaxCycles;
+}Cyclic_TaskStatsType;
+
+typedef struct
+{
+    uint32 Frames;                        /* Minor frames dispatched */
+    uint32 Overruns;                      /* Frames still running when the next tick was due */
+    uint32 MaxFrameCycles;
+    uint16 LastOverrunFrame;              /* Index in the major frame, CYCLIC_NO_FRAME if none */
+}Cyclic_StatsType;
+
+
+/*************************************************************************************
+* Service Name   : Cyclic_Init
+* Parameters (in): a_Table - Generated major frame table
+* Return value   : FALSE if the table is inconsistent
+* Description    : Start the executive at frame 0 on the next SysTick period
+**************************************************************************************/
+extern boolean Cyclic_Init(const Cyclic_TableType *a_Table);
+
+/*************************************************************************************
+* Service Name   : Cyclic_Tick
+* Parameters (in): None
+* Description    : Dispatch the current minor frame, SysTick tick hook
+**************************************************************************************/
+extern void Cyclic_Tick(void);
+
+/*************************************************************************************
+* Service Name   : Cyclic_GetStats
+* Parameters (out): a_Stats - Frames, overruns and longest frame
+* Description    : Read the executive statistics
+**************************************************************************************/
+extern void Cyclic_GetStats(Cyclic_StatsType *a_Stats);
+
+/*************************************************************************************
+* Service Name   : Cyclic_GetTaskStats
+* Parameters (in): a_Task - Task index in the table
+* Parameters (out): a_Stats - Runs and execution time of the task
+* Return value   : FALSE if the task index is out of range
+* Description    : Read the execution time statistics of one task
+**************************************************************************************/
+extern boolean Cyclic_GetTaskStats(uint8 a_Task, Cyclic_TaskStatsType *a_Stats);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* CYCLIC_H_ */
@@ -0,0 +1,157 @@
+/*
+ * DELAY.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "tm4c123gh6pm_registers.h"
+#include "SYSTICK.h"
+#include "CLOCK.h"
+#include "DWT.h"
+#include "DELAY.h"
+
+/*******************************************************************************
+ *                       Private Functions Definitions                         *
+ *******************************************************************************/
+
+/* SysTick stopped, spin on the core cycle counter in chunks shorter than its wrap */
+static void Delay_SpinCycles(uint64 a_Cycles)
+{
+    uint32 Chunk;
+    uint32 Start;
+
+    DWT_EnableCycleCounter();
+    while(a_Cycles != 0)
+    {
+        Chunk = (a_Cycles > 0x80000000UL) ? 0x80000000UL : (uint32)a_Cycles;
+        Start = DWT_GetCycles();
+        while((uint32)(DWT_GetCycles() - Start) < Chunk);
+        a_Cycles -= Chunk;
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Delay_WallCycles
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Ticks - Tick count, a_Current - Counter value, a_Reload - Reload value,
+*                     a_Pending - Wrap not served by the handler yet
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : Core clocks counted since the first tick
+* Description       : Each tick is one wrap of the counter from a_Reload down to 0. A pending wrap is
+*                     counted here, the tick count only moves when the handler runs.
+**************************************************************************************/
+uint64 Delay_WallCycles(uint32 a_Ticks, uint32 a_Current, uint32 a_Reload, boolean a_Pending)
+{
+    if(a_Pending)
+    {
+        a_Ticks++;
+    }
+    return ((uint64)a_Ticks * (a_Reload + 1)) + (a_Reload - a_Current);
+}
+
+/*************************************************************************************
+* Service Name      : Delay_GetWallCycles
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : Core clocks counted by SysTick since it was started
+* Description       : Lock free snapshot: the reads are retried when the handler moved the tick count in
+*                     between. The counter is read again after a wrap is seen pending, the first read may
+*                     have been taken before the wrap. In a handler that masks SysTick the tick count can
+*                     not move and the first pass is kept.
+**************************************************************************************/
+uint64 Delay_GetWallCycles(void)
+{
+    uint32 Reload;
+    uint32 Current;
+    uint32 Ticks;
+    boolean Pending;
+
+    do
+    {
+        Ticks   = SysTick_GetTickCount();
+        Reload  = SYSTICK_REGS->RELOAD;
+        Current = SYSTICK_REGS->CURRENT;
+        Pending = FALSE;
+        if(0 != (SCB_REGS->INTCTRL & SYSTICK_PENDING_MASK))
+        {
+            Current = SYSTICK_REGS->CURRENT;
+            Pending = TRUE;
+        }
+    }while(Ticks != SysTick_GetTickCount());
+
+    return Delay_WallCycles(Ticks, Current, Reload, Pending);
+}
+
+/*************************************************************************************
+* Service Name      : Delay_Us
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Us - Delay in microseconds
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : The elapsed time is read from the SysTick counter, CTRL and RELOAD are never written so
+*                     the periodic tick keeps running. In thread mode the wait sleeps in WFI while the next
+*                     tick is due before the deadline, SysTick keeps counting while the core sleeps. With
+*                     interrupts disabled the wraps after the first one are missed and the delay gets longer,
+*                     never shorter. The elapsed time is taken modulo the wrap of the tick count, a delay
+*                     across the wrap ends on time. SysTick stopped falls back to a busy wait on the DWT
+*                     cycle counter.
+**************************************************************************************/
+void Delay_Us(uint32 a_Us)
+{
+    uint64 Cycles = (uint64)a_Us * (Clock_GetCoreClock() / 1000000);
+    uint64 Start;
+    uint64 Elapsed;
+    uint64 Span;
+    uint32 Period;
+
+    if(0 == (SYSTICK_REGS->CTRL & SYSTICK_TIMER_ENABLE_MASK))
+    {
+        Delay_SpinCycles(Cycles);
+        return;
+    }
+
+    Period = SYSTICK_REGS->RELOAD + 1;
+    Span   = (uint64)Period << 32; /* The wall clock wraps with the 32-bit tick count */
+    Start  = Delay_GetWallCycles();
+    for(;;)
+    {
+        Elapsed = Delay_GetWallCycles();
+        Elapsed = (Elapsed >= Start) ? (Elapsed - Start) : ((Elapsed + Span) - Start);
+        if(Elapsed >= Cycles)
+        {
+            break;
+        }
+        if(((Cycles - Elapsed) > ((uint64)Period + DELAY_WFI_MARGIN_CYCLES)) &&
+           (0 != (SYSTICK_REGS->CTRL & SYSTICK_INTERRUPT_ENABLE_MASK)) &&
+           (0 == (SCB_REGS->INTCTRL & DELAY_VECACT_MASK)))
+        {
+            __asm(" WFI"); /* Woken up by the next tick at the latest */
+        }
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Delay_Ms
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Ms - Delay in milliseconds
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Wait without reprogramming SysTick
+**************************************************************************************/
+void Delay_Ms(uint16 a_Ms)
+{
+    Delay_Us((uint32)a_Ms * 1000);
+}
@@ -0,0 +1,69 @@
+/******************************************************************************
+ *
+ * Module: Delay
+ *
+ * File Name: DELAY.h
+ *
+ * Description: Header file for the microsecond delays measured on the running SysTick counter
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef DELAY_H_
+#define DELAY_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define DELAY_VECACT_MASK                 0x000001FF  /* Active exception number in NVIC_SYSTEM_INTCTRL, 0 in thread mode */
+#define DELAY_WFI_MARGIN_CYCLES           200         /* Wake up latency kept out of the sleeps */
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+
+/*************************************************************************************
+* Service Name   : Delay_Us
+* Parameters (in): a_Us - Delay in microseconds
+* Description    : Wait without reprogramming SysTick, sleeps in WFI while more than one tick remains
+**************************************************************************************/
+extern void Delay_Us(uint32 a_Us);
+
+/*************************************************************************************
+* Service Name   : Delay_Ms
+* Parameters (in): a_Ms - Delay in milliseconds
+* Description    : Wait without reprogramming SysTick
+**************************************************************************************/
+extern void Delay_Ms(uint16 a_Ms);
+
+/*************************************************************************************
+* Service Name   : Delay_GetWallCycles
+* Parameters (in): None
+* Return value   : Core clocks counted by SysTick since it was started
+* Description    : Wall clock built from the tick count and the current down counter value
+**************************************************************************************/
+extern uint64 Delay_GetWallCycles(void);
+
+/*************************************************************************************
+* Service Name   : Delay_WallCycles
+* Parameters (in): a_Ticks - Tick count, a_Current - Counter value, a_Reload - Reload value,
+*                  a_Pending - Wrap not served by the handler yet
+* Return value   : Core clocks counted since the first tick
+* Description    : Combine a snapshot of the down counter into a wall clock, also used with a modeled counter
+**************************************************************************************/
+extern uint64 Delay_WallCycles(uint32 a_Ticks, uint32 a_Current, uint32 a_Reload, boolean a_Pending);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* DELAY_H_ */
@@ -0,0 +1,87 @@
+/******************************************************************************
+ *
+ * Module: Device
+ *
+ * File Name: DEVICE.h
+ *
+ * Description: Compile-time description of the selected TM4C123 part: memory map, NVIC size and the
+ *              peripherals present. The .cproject build configuration selects the part: Debug and
+ *              Release define PART_TM4C123GE6PM and link tm4c123ge6pm.cmd, Debug_TM4C123GH6PM and
+ *              Release_TM4C123GH6PM define PART_TM4C123GH6PM and link tm4c123gh6pm.cmd.
+ *              Only preprocessor lines in this file, tm4c123.cmd includes it too.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef DEVICE_H_
+#define DEVICE_H_
+
+/*******************************************************************************
+ *                              Part Selection                                 *
+ *******************************************************************************/
+
+#if defined(PART_TM4C123GE6PM) && defined(PART_TM4C123GH6PM)
+#error "Select a single part"
+#endif
+
+/* The board of this project carries a TM4C123GE6PM */
+#if !defined(PART_TM4C123GE6PM) && !defined(PART_TM4C123GH6PM)
+#define PART_TM4C123GE6PM
+#endif
+
+/*******************************************************************************
+ *                                Memory Map                                   *
+ *******************************************************************************/
+
+#define DEVICE_FLASH_BASE                 0x00000000
+#define DEVICE_FLASH_SECTOR_SIZE          0x00000400  /* Erase block */
+#define DEVICE_SRAM_BASE                  0x20000000
+#define DEVICE_SRAM_SIZE                  0x00008000
+#define DEVICE_EEPROM_SIZE                0x00000800
+
+#if defined(PART_TM4C123GE6PM)
+#define DEVICE_NAME                       "TM4C123GE6PM"
+#define DEVICE_FLASH_SIZE                 0x00020000
+#elif defined(PART_TM4C123GH6PM)
+#define DEVICE_NAME                       "TM4C123GH6PM"
+#define DEVICE_FLASH_SIZE                 0x00040000
+#endif
+
+/* Top of the flash kept out of the link for the persistent store, NVM_SECTORS * NVM_SECTOR_SIZE */
+#define DEVICE_NVM_SIZE                   0x00001000
+#define DEVICE_NVM_BASE                   (DEVICE_FLASH_BASE + DEVICE_FLASH_SIZE - DEVICE_NVM_SIZE)
+
+/*******************************************************************************
+ *                                   NVIC                                      *
+ *******************************************************************************/
+
+#define DEVICE_IRQ_COUNT                  139    /* IRQ 0 .. 138, the last one is PWM 1 Fault */
+#define DEVICE_PRIORITY_BITS              3      /* Implemented upper bits of each priority byte */
+
+/*******************************************************************************
+ *                           Peripherals Present                               *
+ *******************************************************************************/
+
+/* Both parts are the 64-pin package with the same peripherals, the IRQs of the bigger parts of the
+ * family (GPIO ports G and up, I2C4/5, QEI2, analog comparator 2) are reserved vectors */
+#define DEVICE_GPIO_PORTS                 6      /* PORTA .. PORTF */
+#define DEVICE_UARTS                      8
+#define DEVICE_SSIS                       4
+#define DEVICE_I2CS                       4
+#define DEVICE_CANS                       2
+#define DEVICE_PWMS                       2
+#define DEVICE_QEIS                       2
+#define DEVICE_ADCS                       2
+#define DEVICE_COMPARATORS                2
+#define DEVICE_TIMERS                     6
+#define DEVICE_WIDE_TIMERS                6
+#define DEVICE_USB                        1
+#define DEVICE_HIBERNATE                  1
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* DEVICE_H_ */
@@ -0,0 +1,37 @@
+/******************************************************************************
+ *
+ * Module: DWT
+ *
+ * File Name: DWT.h
+ *
+ * Description: Cycle counter helpers for the ARM Cortex M4 Data Watchpoint and Trace unit
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef DWT_H_
+#define DWT_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define CORE_DEBUG_TRCENA_MASK            0x01000000
+#define DWT_CYCCNTENA_MASK                0x00000001
+
+/* Enable the free running core cycle counter, it is safe to call it more than once */
+#define DWT_EnableCycleCounter()    do { CORE_DEBUG_DEMCR_REG |= CORE_DEBUG_TRCENA_MASK; \
+                                         DWT_CTRL_REG         |= DWT_CYCCNTENA_MASK; } while(0)
+
+/* Read the current value of the core cycle counter, it wraps every 2^32 core clocks */
+#define DWT_GetCycles()             (DWT_CYCCNT_REG)
+
+
+#endif /* DWT_H_ */
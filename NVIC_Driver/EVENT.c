@@ -0,0 +1,154 @@
+/*
+ * EVENT.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "SYSTICK.h"
+#include "ATOMIC.h"
+#include "EVENT.h"
+
+/*******************************************************************************
+ *                       Private Functions Definitions                         *
+ *******************************************************************************/
+
+/* Awaited bits found set, 0 while the condition is not met */
+static uint32 Event_Match(uint32 a_Flags, uint32 a_Mask, uint8 a_Options)
+{
+    uint32 Matched = a_Flags & a_Mask;
+
+    if(a_Options & EVENT_WAIT_ALL)
+    {
+        return (Matched == a_Mask) ? Matched : 0;
+    }
+    return Matched;
+}
+
+/*************************************************************************************
+* Service Name      : Event_Init
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): a_Group - Event flags group
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Clear all the flags of a group
+**************************************************************************************/
+void Event_Init(Event_GroupType *a_Group)
+{
+    if(a_Group == NULL_PTR)
+    {
+        return; /* Report an Error */
+    }
+    a_Group->Flags = 0;
+}
+
+/*************************************************************************************
+* Service Name      : Event_Set
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Mask - Bits to set
+* Parameters (inout): a_Group - Event flags group
+* Parameters (out)  : None
+* Return value      : None
+* Description       : The bits are set before SEV, a waiter that tested the flags just before sees the
+*                     event register set and its WFE returns at once, so the wake up is never lost.
+**************************************************************************************/
+void Event_Set(Event_GroupType *a_Group, uint32 a_Mask)
+{
+    if(a_Group == NULL_PTR)
+    {
+        return; /* Report an Error */
+    }
+    (void)Atomic_SetBits(&a_Group->Flags, a_Mask);
+
+    __asm(" DSB");
+    __asm(" SEV");
+}
+
+/*************************************************************************************
+* Service Name      : Event_Clear
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Mask - Bits to clear
+* Parameters (inout): a_Group - Event flags group
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Clear flags
+**************************************************************************************/
+void Event_Clear(Event_GroupType *a_Group, uint32 a_Mask)
+{
+    if(a_Group == NULL_PTR)
+    {
+        return; /* Report an Error */
+    }
+    (void)Atomic_ClearBits(&a_Group->Flags, a_Mask);
+}
+
+/*************************************************************************************
+* Service Name      : Event_Get
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Group - Event flags group
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : Current flags
+* Description       : Read the flags without waiting
+**************************************************************************************/
+uint32 Event_Get(const Event_GroupType *a_Group)
+{
+    return (a_Group != NULL_PTR) ? a_Group->Flags : 0;
+}
+
+/*************************************************************************************
+* Service Name      : Event_Wait
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Mask - Awaited bits, a_Options - EVENT_WAIT_xxx | EVENT_CLEAR_ON_EXIT,
+*                     a_TimeoutTicks - SysTick periods to wait, EVENT_WAIT_FOREVER for no timeout
+* Parameters (inout): a_Group - Event flags group
+* Parameters (out)  : None
+* Return value      : Awaited bits found set, 0 on timeout
+* Description       : WFE returns on Event_Set (SEV) and on every exception, the SysTick interrupt included,
+*                     so the timeout is checked at least once per tick. A stale event register only costs
+*                     one more pass of the loop. The test and the clear on exit are one compare-exchange,
+*                     two waiters on the same bits can not both consume them.
+**************************************************************************************/
+uint32 Event_Wait(Event_GroupType *a_Group, uint32 a_Mask, uint8 a_Options, uint32 a_TimeoutTicks)
+{
+    uint32 Start = SysTick_GetTickCount();
+    uint32 Matched;
+    uint32 Flags;
+
+    if((a_Group == NULL_PTR) || (a_Mask == 0))
+    {
+        return 0; /* Report an Error */
+    }
+
+    for(;;)
+    {
+        Flags   = a_Group->Flags;
+        Matched = Event_Match(Flags, a_Mask, a_Options);
+        if((Matched != 0) && (a_Options & EVENT_CLEAR_ON_EXIT))
+        {
+            if(!Atomic_CompareExchange(&a_Group->Flags, Flags, Flags & ~Matched))
+            {
+                continue; /* Flags changed since the read, test again */
+            }
+        }
+
+        if(Matched != 0)
+        {
+            return Matched;
+        }
+        if((a_TimeoutTicks != EVENT_WAIT_FOREVER) && ((SysTick_GetTickCount() - Start) >= a_TimeoutTicks))
+        {
+            return 0; /* Timeout */
+        }
+        __asm(" WFE");
+    }
+}
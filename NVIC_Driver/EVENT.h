@@ -0,0 +1,87 @@
+/******************************************************************************
+ *
+ * Module: Event
+ *
+ * File Name: EVENT.h
+ *
+ * Description: Header file for the event flags, set from the ISRs and waited on in WFE
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef EVENT_H_
+#define EVENT_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Event_Wait options */
+#define EVENT_WAIT_ANY                    0x00   /* Return when any bit of the mask is set */
+#define EVENT_WAIT_ALL                    0x01   /* Return when all the bits of the mask are set */
+#define EVENT_CLEAR_ON_EXIT               0x02   /* Clear the awaited bits before returning */
+
+#define EVENT_WAIT_FOREVER                0xFFFFFFFF
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    volatile uint32 Flags;
+}Event_GroupType;
+
+
+/*************************************************************************************
+* Service Name   : Event_Init
+* Parameters (inout): a_Group - Event flags group
+* Description    : Clear all the flags of a group
+**************************************************************************************/
+extern void Event_Init(Event_GroupType *a_Group);
+
+/*************************************************************************************
+* Service Name   : Event_Set
+* Parameters (in): a_Mask - Bits to set
+* Parameters (inout): a_Group - Event flags group
+* Description    : Set flags and wake up the waiters, callable from any interrupt
+**************************************************************************************/
+extern void Event_Set(Event_GroupType *a_Group, uint32 a_Mask);
+
+/*************************************************************************************
+* Service Name   : Event_Clear
+* Parameters (in): a_Mask - Bits to clear
+* Parameters (inout): a_Group - Event flags group
+* Description    : Clear flags
+**************************************************************************************/
+extern void Event_Clear(Event_GroupType *a_Group, uint32 a_Mask);
+
+/*************************************************************************************
+* Service Name   : Event_Get
+* Parameters (in): a_Group - Event flags group
+* Return value   : Current flags
+* Description    : Read the flags without waiting
+**************************************************************************************/
+extern uint32 Event_Get(const Event_GroupType *a_Group);
+
+/*************************************************************************************
+* Service Name   : Event_Wait
+* Parameters (in): a_Mask - Awaited bits, a_Options - EVENT_WAIT_xxx | EVENT_CLEAR_ON_EXIT,
+*                  a_TimeoutTicks - SysTick periods to wait, EVENT_WAIT_FOREVER for no timeout
+* Parameters (inout): a_Group - Event flags group
+* Return value   : Awaited bits found set, 0 on timeout
+* Description    : Sleep in WFE until the condition on the mask is met, thread mode only
+**************************************************************************************/
+extern uint32 Event_Wait(Event_GroupType *a_Group, uint32 a_Mask, uint8 a_Options, uint32 a_TimeoutTicks);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* EVENT_H_ */
@@ -0,0 +1,144 @@
+/*
+ * FPU.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "FPU.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static volatile uint8 Fpu_IsrReport[FPU_EXCEPTIONS];
+static volatile uint8 Fpu_FirstViolation = FPU_NO_VIOLATION;
+
+/*************************************************************************************
+* Service Name      : Fpu_Init
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Stacking - FP context stacking on exception entry
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : With lazy stacking a handler entered from FP code only reserves the 18 FP words of
+*                     the frame, they are written only if the handler itself executes an FP instruction.
+*                     FP-free handlers therefore keep the entry latency of the 8 words basic frame.
+**************************************************************************************/
+void Fpu_Init(Fpu_StackingType a_Stacking)
+{
+    FPU_CPAC_REG |= FPU_CPAC_CP10_CP11_FULL_MASK; /* Already done by the C runtime, kept for an explicit configuration */
+    __asm(" DSB");
+    __asm(" ISB");
+
+    switch(a_Stacking)
+    {
+    case FPU_STACKING_LAZY      : FPU_FPCC_REG = FPU_FPCC_ASPEN_MASK | FPU_FPCC_LSPEN_MASK; break;
+    case FPU_STACKING_AUTOMATIC : FPU_FPCC_REG = FPU_FPCC_ASPEN_MASK;                       break;
+    case FPU_STACKING_NONE      : FPU_FPCC_REG = 0;                                         break;
+    default                     : break; /* Report an Error */
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Fpu_DeclareFpFree
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_ExceptionNum - Exception number of the handler
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Declare a latency critical handler FP-free, FP use in it is reported as a violation
+**************************************************************************************/
+void Fpu_DeclareFpFree(uint8 a_ExceptionNum)
+{
+    uint32 State;
+
+    if(a_ExceptionNum >= FPU_EXCEPTIONS)
+    {
+        return; /* Report an Error */
+    }
+    State = Enter_Critical();
+    Fpu_IsrReport[a_ExceptionNum] |= FPU_ISR_FP_FREE;
+    Exit_Critical(State);
+}
+
+/*************************************************************************************
+* Service Name      : Fpu_IsrCheck
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_ExceptionNum - Exception number of the handler, a_EntryState - FPCCR at handler entry
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : LSPACT set at entry means the interrupted context used the FPU and the handler got an
+*                     extended frame, LSPACT cleared since then means the handler triggered the lazy save.
+*                     CONTROL.FPCA is cleared on exception entry, set at exit it means the handler used the FPU.
+**************************************************************************************/
+void Fpu_IsrCheck(uint8 a_ExceptionNum, uint32 a_EntryState)
+{
+    uint8 Report = 0;
+    uint32 State;
+
+    if(a_ExceptionNum >= FPU_EXCEPTIONS)
+    {
+        return; /* Report an Error */
+    }
+
+    if(a_EntryState & FPU_FPCC_LSPACT_MASK)
+    {
+        Report |= FPU_ISR_EXTENDED_FRAME;
+        if(0 == (FPU_FPCC_REG & FPU_FPCC_LSPACT_MASK))
+        {
+            Report |= FPU_ISR_LAZY_SAVE;
+        }
+    }
+    if(Fpu_GetControl() & FPU_CONTROL_FPCA_MASK)
+    {
+        Report |= FPU_ISR_FP_USED;
+    }
+
+    State = Enter_Critical();
+    Fpu_IsrReport[a_ExceptionNum] |= Report;
+    if((Report & FPU_ISR_FP_USED) && (Fpu_IsrReport[a_ExceptionNum] & FPU_ISR_FP_FREE) &&
+       (Fpu_FirstViolation == FPU_NO_VIOLATION))
+    {
+        Fpu_FirstViolation = a_ExceptionNum;
+    }
+    Exit_Critical(State);
+}
+
+/*************************************************************************************
+* Service Name      : Fpu_GetIsrReport
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_ExceptionNum - Exception number of the handler
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : FPU_ISR_xxx flags recorded for the handler
+* Description       : Tell whether a handler was entered with extended frames and whether it used the FPU
+**************************************************************************************/
+uint8 Fpu_GetIsrReport(uint8 a_ExceptionNum)
+{
+    return (a_ExceptionNum < FPU_EXCEPTIONS) ? Fpu_IsrReport[a_ExceptionNum] : 0;
+}
+
+/*************************************************************************************
+* Service Name      : Fpu_GetFirstViolation
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : Exception number of the first FP-free handler that used the FPU, FPU_NO_VIOLATION if none
+* Description       : Get the first FP use detected in an FP-free handler
+**************************************************************************************/
+uint8 Fpu_GetFirstViolation(void)
+{
+    return Fpu_FirstViolation;
+}
@@ -0,0 +1,118 @@
+/******************************************************************************
+ *
+ * Module: FPU
+ *
+ * File Name: FPU.h
+ *
+ * Description: Header file for the FPU context control, lazy stacking and FP use checks of the handlers
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef FPU_H_
+#define FPU_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* The FP use checks of the handlers are compiled in debug builds only */
+#ifndef NDEBUG
+#define FPU_CHECK_ENABLE                  TRUE
+#else
+#define FPU_CHECK_ENABLE                  FALSE
+#endif
+
+#define FPU_EXCEPTIONS                    NVIC_EXCEPTIONS   /* 16 system exceptions + the IRQs */
+
+/* FPU_CPAC_REG */
+#define FPU_CPAC_CP10_CP11_FULL_MASK      0x00F00000
+
+/* FPU_FPCC_REG */
+#define FPU_FPCC_ASPEN_MASK               0x80000000  /* Set CONTROL.FPCA on FP use, stack the extended frame */
+#define FPU_FPCC_LSPEN_MASK               0x40000000  /* Reserve the FP registers space but save them on first use */
+#define FPU_FPCC_LSPACT_MASK              0x00000001  /* Lazy save pending */
+
+#define FPU_CONTROL_FPCA_MASK             0x00000004
+
+/* Report flags of an exception, Fpu_GetIsrReport */
+#define FPU_ISR_FP_FREE                   0x01   /* Declared FP-free with Fpu_DeclareFpFree */
+#define FPU_ISR_EXTENDED_FRAME            0x02   /* Entered at least once with a 26 words frame */
+#define FPU_ISR_LAZY_SAVE                 0x04   /* Triggered the lazy save of the interrupted FP context */
+#define FPU_ISR_FP_USED                   0x08   /* Executed at least one FP instruction */
+
+#define FPU_NO_VIOLATION                  0xFF
+
+#if (FPU_CHECK_ENABLE == TRUE)
+/* Hooks to be placed at the first and last line of a handler, the id is the exception number */
+#define FPU_ISR_ENTER()                   uint32 Fpu_EntryState = FPU_FPCC_REG
+#define FPU_ISR_EXIT(ExceptionNum)        Fpu_IsrCheck((ExceptionNum), Fpu_EntryState)
+#else
+#define FPU_ISR_ENTER()
+#define FPU_ISR_EXIT(ExceptionNum)
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef enum
+{
+    FPU_STACKING_LAZY,                    /* Extended frame reserved, FP registers saved on the first FP instruction */
+    FPU_STACKING_AUTOMATIC,               /* Extended frame always saved when the interrupted context used the FPU */
+    FPU_STACKING_NONE                     /* Basic frame only, the handlers must not use the FPU */
+}Fpu_StackingType;
+
+
+/*************************************************************************************
+* Service Name   : Fpu_Init
+* Parameters (in): a_Stacking - FP context stacking on exception entry
+* Description    : Enable the FPU and configure the FP context stacking
+**************************************************************************************/
+extern void Fpu_Init(Fpu_StackingType a_Stacking);
+
+/*************************************************************************************
+* Service Name   : Fpu_DeclareFpFree
+* Parameters (in): a_ExceptionNum - Exception number of the handler
+* Description    : Declare a latency critical handler FP-free, FP use in it is reported as a violation
+**************************************************************************************/
+extern void Fpu_DeclareFpFree(uint8 a_ExceptionNum);
+
+/*************************************************************************************
+* Service Name   : Fpu_IsrCheck
+* Parameters (in): a_ExceptionNum - Exception number of the handler, a_EntryState - FPCCR at handler entry
+* Description    : Record the frame type and FP use of a handler, called by FPU_ISR_EXIT
+**************************************************************************************/
+extern void Fpu_IsrCheck(uint8 a_ExceptionNum, uint32 a_EntryState);
+
+/*************************************************************************************
+* Service Name   : Fpu_GetIsrReport
+* Parameters (in): a_ExceptionNum - Exception number of the handler
+* Return value   : FPU_ISR_xxx flags recorded for the handler
+* Description    : Tell whether a handler was entered with extended frames and whether it used the FPU
+**************************************************************************************/
+extern uint8 Fpu_GetIsrReport(uint8 a_ExceptionNum);
+
+/*************************************************************************************
+* Service Name   : Fpu_GetFirstViolation
+* Parameters (in): None
+* Return value   : Exception number of the first FP-free handler that used the FPU, FPU_NO_VIOLATION if none
+* Description    : Get the first FP use detected in an FP-free handler
+**************************************************************************************/
+extern uint8 Fpu_GetFirstViolation(void);
+
+extern uint32 Fpu_GetControl(void);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* FPU_H_ */
@@ -0,0 +1,29 @@
+;******************************************************************************
+;
+; Module: FPU
+;
+; File Name: FPU_CONTROL.asm
+;
+; Description: Access to the CONTROL special register for the FPU context checks
+;
+; Author: Muhamed Amr
+;
+;******************************************************************************
+
+        .thumb
+        .text
+
+        .global Fpu_GetControl
+
+;******************************************************************************
+; Fpu_GetControl
+; Returns the CONTROL register. Bit 2 (FPCA) is cleared on exception entry and
+; set by the first floating point instruction, so reading it at the end of a
+; handler tells whether the handler used the FPU. Uses no FPU instruction.
+;******************************************************************************
+Fpu_GetControl: .asmfunc
+        MRS     r0, CONTROL
+        BX      lr
+        .endasmfunc
+
+        .end
@@ -0,0 +1,218 @@
+/*
+ * GOVERNOR.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "NVIC.h"
+#include "SYSTICK.h"
+#include "TRACE.h"
+#include "GOVERNOR.h"
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    Governor_ConfigType Config;
+    uint16 Slots[GOVERNOR_WINDOW_SLOTS];  /* Firings in each part of the sliding window */
+    uint16 WindowCount;                   /* Sum of Slots */
+    uint16 SlotTicks;                     /* Ticks left in the current slot */
+    uint16 SlotLength;
+    uint8 Slot;
+    boolean Throttled;
+    uint16 ResumeTicks;                   /* Ticks left before the IRQ is re-enabled */
+    uint16 Backoff;
+    uint32 Firings;
+    uint32 Throttles;
+}Governor_EntryType;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static Governor_EntryType Governor_Entries[GOVERNOR_MAX_IRQS];
+static uint8 Governor_EntriesCount = 0;
+
+/*************************************************************************************
+* Service Name      : Governor_Register
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Config - IRQ, budget, window and back-off
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : Governor id passed to Governor_Count, GOVERNOR_INVALID_ID if the table is full or the
+*                     window is not a whole number of slots
+* Description       : Put an IRQ under the governor, call it before the IRQ is enabled
+**************************************************************************************/
+Governor_IdType Governor_Register(const Governor_ConfigType *a_Config)
+{
+    Governor_EntryType *Entry;
+    uint8 Index;
+
+    if((a_Config == NULL_PTR) || (a_Config->WindowTicks == 0) || ((a_Config->WindowTicks % GOVERNOR_WINDOW_SLOTS) != 0) ||
+       (a_Config->BackoffTicks == 0) || (Governor_EntriesCount >= GOVERNOR_MAX_IRQS))
+    {
+        return GOVERNOR_INVALID_ID; /* Report an Error */
+    }
+
+    Entry = &Governor_Entries[Governor_EntriesCount];
+    Entry->Config      = *a_Config;
+    Entry->SlotLength  = a_Config->WindowTicks / GOVERNOR_WINDOW_SLOTS;
+    Entry->SlotTicks   = Entry->SlotLength;
+    Entry->Slot        = 0;
+    Entry->WindowCount = 0;
+    Entry->Throttled   = FALSE;
+    Entry->ResumeTicks = 0;
+    Entry->Backoff     = a_Config->BackoffTicks;
+    Entry->Firings     = 0;
+    Entry->Throttles   = 0;
+    for(Index = 0; Index < GOVERNOR_WINDOW_SLOTS; Index++)
+    {
+        Entry->Slots[Index] = 0;
+    }
+    if(Entry->Config.MaxBackoffTicks < a_Config->BackoffTicks)
+    {
+        Entry->Config.MaxBackoffTicks = a_Config->BackoffTicks;
+    }
+
+    SysTick_RegisterTickHook(Governor_Tick);
+    return Governor_EntriesCount++;
+}
+
+/*************************************************************************************
+* Service Name      : Governor_Count
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Id - Governor id of the IRQ
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : FALSE if this firing exceeded the budget and the IRQ is now disabled
+* Description       : Count one firing in the current slot. When the window holds more firings than the
+*                     budget the IRQ is disabled for the back-off and the back-off is doubled for the next
+*                     storm, so a source that keeps storming is held off longer and longer. The current
+*                     firing must still be serviced by the caller.
+**************************************************************************************/
+boolean Governor_Count(Governor_IdType a_Id)
+{
+    Governor_EntryType *Entry;
+    boolean Allowed = TRUE;
+    uint32 State;
+
+    if(a_Id >= Governor_EntriesCount)
+    {
+        return TRUE; /* Report an Error */
+    }
+
+    Entry = &Governor_Entries[a_Id];
+    State = Enter_Critical();
+    Entry->Slots[Entry->Slot]++;
+    Entry->WindowCount++;
+    Entry->Firings++;
+    if((Entry->WindowCount > Entry->Config.Budget) && (Entry->Throttled == FALSE))
+    {
+        NVIC_DisableIRQ(Entry->Config.IRQ_Num);
+        Entry->Throttled   = TRUE;
+        Entry->ResumeTicks = Entry->Backoff;
+        Entry->Backoff     = ((uint32)Entry->Backoff * 2 > Entry->Config.MaxBackoffTicks) ?
+                             Entry->Config.MaxBackoffTicks : (Entry->Backoff * 2);
+        Entry->Throttles++;
+        TRACE_IRQ_THROTTLE(Entry->Config.IRQ_Num);
+        Allowed = FALSE;
+    }
+    Exit_Critical(State);
+
+    return Allowed;
+}
+
+/*************************************************************************************
+* Service Name      : Governor_Tick
+* Sync/Async        : Asynchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Called every SysTick period. Drops the oldest slot of each window, re-enables the
+*                     IRQs whose back-off expired and halves the back-off after a quiet window.
+**************************************************************************************/
+void Governor_Tick(void)
+{
+    Governor_EntryType *Entry;
+    uint32 State;
+    uint8 Index;
+    uint8 Slot;
+
+    for(Index = 0; Index < Governor_EntriesCount; Index++)
+    {
+        Entry = &Governor_Entries[Index];
+        State = Enter_Critical();
+        if(Entry->Throttled)
+        {
+            if(--Entry->ResumeTicks == 0)
+            {
+                /* Restart with an empty window, the firings counted before the back-off are stale */
+                for(Slot = 0; Slot < GOVERNOR_WINDOW_SLOTS; Slot++)
+                {
+                    Entry->Slots[Slot] = 0;
+                }
+                Entry->Slot        = 0;
+                Entry->SlotTicks   = Entry->SlotLength;
+                Entry->WindowCount = 0;
+                Entry->Throttled   = FALSE;
+                NVIC_EnableIRQ(Entry->Config.IRQ_Num);
+                TRACE_IRQ_RESUME(Entry->Config.IRQ_Num);
+            }
+        }
+        else if(--Entry->SlotTicks == 0)
+        {
+            Entry->SlotTicks = Entry->SlotLength;
+            Entry->Slot      = (Entry->Slot + 1) % GOVERNOR_WINDOW_SLOTS;
+            Entry->WindowCount -= Entry->Slots[Entry->Slot];
+            Entry->Slots[Entry->Slot] = 0;
+            if((Entry->Slot == 0) && (Entry->WindowCount == 0) && (Entry->Backoff > Entry->Config.BackoffTicks))
+            {
+                Entry->Backoff /= 2;
+                if(Entry->Backoff < Entry->Config.BackoffTicks)
+                {
+                    Entry->Backoff = Entry->Config.BackoffTicks;
+                }
+            }
+        }
+        else
+        {
+            /* Same slot */
+        }
+        Exit_Critical(State);
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Governor_GetStats
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Id - Governor id of the IRQ
+* Parameters (inout): None
+* Parameters (out)  : a_Stats - Firing and throttle counters
+* Return value      : None
+* Description       : Read the counters of a governed IRQ
+**************************************************************************************/
+void Governor_GetStats(Governor_IdType a_Id, Governor_StatsType *a_Stats)
+{
+    uint32 State;
+
+    if((a_Id >= Governor_EntriesCount) || (a_Stats == NULL_PTR))
+    {
+        return; /* Report an Error */
+    }
+
+    State = Enter_Critical();
+    a_Stats->Firings             = Governor_Entries[a_Id].Firings;
+    a_Stats->Throttles           = Governor_Entries[a_Id].Throttles;
+    a_Stats->CurrentBackoffTicks = Governor_Entries[a_Id].Backoff;
+    a_Stats->Throttled           = Governor_Entries[a_Id].Throttled;
+    Exit_Critical(State);
+}
@@ -0,0 +1,90 @@
+/******************************************************************************
+ *
+ * Module: Governor
+ *
+ * File Name: GOVERNOR.h
+ *
+ * Description: Header file for the interrupt storm governor, per IRQ rate limiting over a sliding SysTick window
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef GOVERNOR_H_
+#define GOVERNOR_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "NVIC.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define GOVERNOR_MAX_IRQS                 8
+#define GOVERNOR_WINDOW_SLOTS             4      /* The window slides by WindowTicks / GOVERNOR_WINDOW_SLOTS */
+#define GOVERNOR_INVALID_ID               0xFF
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef uint8 Governor_IdType;
+
+typedef struct
+{
+    NVIC_IRQType IRQ_Num;
+    uint16 Budget;                        /* Firings allowed in one window */
+    uint16 WindowTicks;                   /* Window length in SysTick periods, a multiple of GOVERNOR_WINDOW_SLOTS */
+    uint16 BackoffTicks;                  /* First back-off, doubled on each throttle in a row */
+    uint16 MaxBackoffTicks;
+}Governor_ConfigType;
+
+typedef struct
+{
+    uint32 Firings;                       /* Total firings counted */
+    uint32 Throttles;                     /* Times the IRQ was disabled */
+    uint16 CurrentBackoffTicks;           /* Back-off applied by the next throttle */
+    boolean Throttled;
+}Governor_StatsType;
+
+
+/*************************************************************************************
+* Service Name   : Governor_Register
+* Parameters (in): a_Config - IRQ, budget, window and back-off
+* Return value   : Governor id passed to Governor_Count, GOVERNOR_INVALID_ID if the table is full or the
+*                  window is not a whole number of slots
+* Description    : Put an IRQ under the governor, the SysTick hook is registered on the first call
+**************************************************************************************/
+extern Governor_IdType Governor_Register(const Governor_ConfigType *a_Config);
+
+/*************************************************************************************
+* Service Name   : Governor_Count
+* Parameters (in): a_Id - Governor id of the IRQ
+* Return value   : FALSE if this firing exceeded the budget and the IRQ is now disabled
+* Description    : Count one firing, called at the start of the interrupt handler
+**************************************************************************************/
+extern boolean Governor_Count(Governor_IdType a_Id);
+
+/*************************************************************************************
+* Service Name   : Governor_Tick
+* Parameters (in): None
+* Description    : Slide the windows and re-enable the IRQs whose back-off expired, SysTick tick hook
+**************************************************************************************/
+extern void Governor_Tick(void);
+
+/*************************************************************************************
+* Service Name   : Governor_GetStats
+* Parameters (in): a_Id - Governor id of the IRQ
+* Parameters (out): a_Stats - Firing and throttle counters
+* Description    : Read the counters of a governed IRQ
+**************************************************************************************/
+extern void Governor_GetStats(Governor_IdType a_Id, Governor_StatsType *a_Stats);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* GOVERNOR_H_ */
@@ -0,0 +1,424 @@
+/*
+ * GPTM.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "GPTM.h"
+
+/* Timer B registers follow the timer A ones in the block, a_Half is GPTM_HALF_A or GPTM_HALF_B */
+#define GPTM_HALF_REG(Regs, RegA, Half)   ((&(Regs)->RegA)[((Half) == GPTM_HALF_B) ? 1 : 0])
+
+#define GPTM_HALF_SHIFT(Half)             (((Half) == GPTM_HALF_B) ? GPTM_HALF_B_SHIFT : 0)
+#define GPTM_IS_WIDE(Timer)               ((Timer) >= GPTM_WIDE_TIMER_0)
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+/* IRQ of timer A of each timer, timer B is the next IRQ */
+static const NVIC_IRQType Gptm_IrqNums[GPTM_TIMERS] =
+{
+    NVIC_IRQ_TIMER0A,  NVIC_IRQ_TIMER1A,  NVIC_IRQ_TIMER2A,  NVIC_IRQ_TIMER3A,  NVIC_IRQ_TIMER4A,  NVIC_IRQ_TIMER5A,
+    NVIC_IRQ_WTIMER0A, NVIC_IRQ_WTIMER1A, NVIC_IRQ_WTIMER2A, NVIC_IRQ_WTIMER3A, NVIC_IRQ_WTIMER4A, NVIC_IRQ_WTIMER5A
+};
+
+static Gptm_CallbackType Gptm_Callbacks[GPTM_TIMERS][2];
+static Gptm_ModeType Gptm_Modes[GPTM_TIMERS][2];
+
+/*******************************************************************************
+ *                       Private Functions Definitions                         *
+ *******************************************************************************/
+
+static void Gptm_EnableClock(Gptm_TimerType a_Timer)
+{
+    uint32 Bit;
+
+    if(GPTM_IS_WIDE(a_Timer))
+    {
+        Bit = (uint32)1 << (a_Timer - GPTM_WIDE_TIMER_0);
+        SYSCTL_RCGCWTIMER_REG |= Bit;
+        while(0 == (SYSCTL_PRWTIMER_REG & Bit));
+    }
+    else
+    {
+        Bit = (uint32)1 << a_Timer;
+        SYSCTL_RCGCTIMER_REG |= Bit;
+        while(0 == (SYSCTL_PRTIMER_REG & Bit));
+    }
+}
+
+/* Acknowledge the events of one half and call its callback, the capture time stamp is read before returning */
+static void Gptm_Dispatch(Gptm_TimerType a_Timer, Gptm_HalfType a_Half)
+{
+    volatile GPTM_RegType *Regs = GPTM_TIMER(a_Timer);
+    uint32 Status = Regs->MIS & ((uint32)GPTM_INT_HALF_MASK << GPTM_HALF_SHIFT(a_Half));
+    Gptm_CallbackType Callback = Gptm_Callbacks[a_Timer][(a_Half == GPTM_HALF_B) ? 1 : 0];
+    uint64 Value = 0;
+
+    Regs->ICR = Status;
+    if(Gptm_Modes[a_Timer][(a_Half == GPTM_HALF_B) ? 1 : 0] == GPTM_MODE_CAPTURE_TIME)
+    {
+        Value = Gptm_GetCapture(a_Timer, a_Half);
+    }
+    if((Status != 0) && (Callback != NULL_PTR))
+    {
+        Callback(Value);
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Gptm_ConfigureBlock
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Config - Timer, half and mode
+* Parameters (inout): a_Regs - Register block of the timer
+* Parameters (out)  : None
+* Return value      : FALSE if the configuration is not supported by the timer
+* Description       : One-shot and periodic counts down from Period - 1, in split mode the prescaler divides
+*                     the clock when the period does not fit the half. PWM and capture use the prescaler as
+*                     the upper bits of the counter: 24 bits on a 16-bit half, 48 bits on a wide half.
+*                     The timer is left stopped.
+**************************************************************************************/
+boolean Gptm_ConfigureBlock(volatile GPTM_RegType *a_Regs, const Gptm_ConfigType *a_Config)
+{
+    boolean Concatenated;
+    uint8 HalfBits;
+    uint8 PrescaleBits;
+    uint8 Shift;
+    uint64 Load;
+    uint64 Match;
+    uint32 Prescale;
+    uint32 Mode;
+    uint32 IntMask;
+    uint32 Ctl;
+
+    if((a_Regs == NULL_PTR) || (a_Config == NULL_PTR) || (a_Config->Timer >= GPTM_TIMERS) ||
+       (a_Config->Half > GPTM_HALF_CONCATENATED))
+    {
+        return FALSE; /* Report an Error */
+    }
+
+    Concatenated = (a_Config->Half == GPTM_HALF_CONCATENATED) ? TRUE : FALSE;
+    HalfBits     = GPTM_IS_WIDE(a_Config->Timer) ? GPTM_WIDE_HALF_BITS : GPTM_HALF_BITS;
+    PrescaleBits = GPTM_IS_WIDE(a_Config->Timer) ? GPTM_WIDE_PRESCALE_BITS : GPTM_PRESCALE_BITS;
+    Shift        = GPTM_HALF_SHIFT(a_Config->Half);
+
+    if(Concatenated && ((a_Config->Mode == GPTM_MODE_CAPTURE_TIME) || (a_Config->Mode == GPTM_MODE_PWM)))
+    {
+        return FALSE; /* Report an Error */
+    }
+    if((a_Config->Mode != GPTM_MODE_CAPTURE_TIME) && (a_Config->Period == 0))
+    {
+        return FALSE; /* Report an Error */
+    }
+    Load = a_Config->Period - 1;
+
+    /* Stop the half and clear its output and event settings */
+    Ctl = a_Regs->CTL & ~((uint32)(GPTM_CTL_EN_MASK | GPTM_CTL_EVENT_MASK | GPTM_CTL_OTE_MASK | GPTM_CTL_PWML_MASK) << Shift);
+    a_Regs->CTL = Ctl;
+    a_Regs->CFG = Concatenated ? GPTM_CFG_CONCATENATED : GPTM_CFG_SPLIT;
+
+    switch(a_Config->Mode)
+    {
+    case GPTM_MODE_ONE_SHOT :
+    case GPTM_MODE_PERIODIC :
+        Mode    = (a_Config->Mode == GPTM_MODE_ONE_SHOT) ? GPTM_MR_ONE_SHOT : GPTM_MR_PERIODIC;
+        IntMask = GPTM_INT_TIMEOUT_MASK;
+        if(Concatenated)
+        {
+            if(!GPTM_IS_WIDE(a_Config->Timer) && (Load > 0xFFFFFFFFUL))
+            {
+                return FALSE; /* Report an Error */
+            }
+            a_Regs->TAILR = (uint32)Load;
+            a_Regs->TBILR = (uint32)(Load >> 32); /* Upper half of the 64-bit wide timer */
+        }
+        else
+        {
+            Prescale = (uint32)(Load >> HalfBits);
+            if(Prescale >= ((uint32)1 << PrescaleBits))
+            {
+                return FALSE; /* Report an Error */
+            }
+            GPTM_HALF_REG(a_Regs, TAPR, a_Config->Half)  = Prescale;
+            GPTM_HALF_REG(a_Regs, TAILR, a_Config->Half) = (uint32)((a_Config->Period / (Prescale + 1)) - 1);
+        }
+        if(a_Config->AdcTrigger)
+        {
+            Ctl |= (uint32)GPTM_CTL_OTE_MASK << Shift;
+        }
+        break;
+
+    case GPTM_MODE_CAPTURE_TIME :
+        /* Free running up counter over the full width, the edges latch it in TnR */
+        Mode    = GPTM_MR_CAPTURE | GPTM_MR_CMR_MASK | GPTM_MR_CDIR_MASK;
+        IntMask = GPTM_INT_CAPTURE_EVENT_MASK;
+        GPTM_HALF_REG(a_Regs, TAILR, a_Config->Half) = (uint32)(((uint64)1 << HalfBits) - 1);
+        GPTM_HALF_REG(a_Regs, TAPR, a_Config->Half)  = ((uint32)1 << PrescaleBits) - 1;
+        Ctl |= ((uint32)a_Config->Edge << GPTM_CTL_EVENT_BITS_POS) << Shift;
+        break;
+
+    case GPTM_MODE_PWM :
+        /* The output is set at the reload and cleared when the down counter reaches the match value */
+        if(((Load >> (HalfBits + PrescaleBits)) != 0) || (a_Config->HighTime > Load))
+        {
+            return FALSE; /* Report an Error */
+        }
+        Mode    = GPTM_MR_PERIODIC | GPTM_MR_AMS_MASK | GPTM_MR_MRSU_MASK;
+        IntMask = 0;
+        Match   = Load - a_Config->HighTime;
+        GPTM_HALF_REG(a_Regs, TAPR, a_Config->Half)     = (uint32)(Load >> HalfBits);
+        GPTM_HALF_REG(a_Regs, TAILR, a_Config->Half)    = (uint32)(Load & (((uint64)1 << HalfBits) - 1));
+        GPTM_HALF_REG(a_Regs, TAPMR, a_Config->Half)    = (uint32)(Match >> HalfBits);
+        GPTM_HALF_REG(a_Regs, TAMATCHR, a_Config->Half) = (uint32)(Match & (((uint64)1 << HalfBits) - 1));
+        if(a_Config->InvertOutput)
+        {
+            Ctl |= (uint32)GPTM_CTL_PWML_MASK << Shift;
+        }
+        break;
+
+    default :
+        return FALSE; /* Report an Error */
+    }
+
+    GPTM_HALF_REG(a_Regs, TAMR, a_Config->Half) = Mode;
+    a_Regs->CTL = Ctl;
+
+    a_Regs->ICR = (uint32)GPTM_INT_HALF_MASK << Shift;
+    if(a_Config->Callback != NULL_PTR)
+    {
+        a_Regs->IMR = (a_Regs->IMR & ~((uint32)GPTM_INT_HALF_MASK << Shift)) | (IntMask << Shift);
+    }
+    else
+    {
+        a_Regs->IMR &= ~((uint32)GPTM_INT_HALF_MASK << Shift);
+    }
+    return TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : Gptm_Init
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Config - Timer, half, mode and interrupt
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : FALSE if the configuration is not supported by the timer
+* Description       : Enable the timer clock, configure the mode and route its interrupt through the NVIC
+**************************************************************************************/
+boolean Gptm_Init(const Gptm_ConfigType *a_Config)
+{
+    uint8 Index;
+    NVIC_IRQType IRQ_Num;
+
+    if((a_Config == NULL_PTR) || (a_Config->Timer >= GPTM_TIMERS) || (a_Config->Half > GPTM_HALF_CONCATENATED))
+    {
+        return FALSE; /* Report an Error */
+    }
+    Index   = (a_Config->Half == GPTM_HALF_B) ? 1 : 0;
+    IRQ_Num = Gptm_IrqNums[a_Config->Timer] + Index;
+
+    Gptm_EnableClock(a_Config->Timer);
+    NVIC_DisableIRQ(IRQ_Num);
+    if(!Gptm_ConfigureBlock(GPTM_TIMER(a_Config->Timer), a_Config))
+    {
+        return FALSE; /* Report an Error */
+    }
+    Gptm_Callbacks[a_Config->Timer][Index] = a_Config->Callback;
+    Gptm_Modes[a_Config->Timer][Index]     = a_Config->Mode;
+
+    if(a_Config->Callback != NULL_PTR)
+    {
+        NVIC_SetPriorityIRQ(IRQ_Num, a_Config->Priority);
+        NVIC_EnableIRQ(IRQ_Num);
+    }
+    return TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : Gptm_Start
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Timer - Timer, a_Half - Half
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Start counting, the counter freezes while the debugger halts the core
+**************************************************************************************/
+void Gptm_Start(Gptm_TimerType a_Timer, Gptm_HalfType a_Half)
+{
+    uint32 State;
+
+    if(a_Timer >= GPTM_TIMERS)
+    {
+        return; /* Report an Error */
+    }
+    State = Enter_Critical(); /* The other half may be started from another context */
+    GPTM_TIMER(a_Timer)->CTL |= (uint32)(GPTM_CTL_EN_MASK | GPTM_CTL_STALL_MASK) << GPTM_HALF_SHIFT(a_Half);
+    Exit_Critical(State);
+}
+
+/*************************************************************************************
+* Service Name      : Gptm_Stop
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Timer - Timer, a_Half - Half
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Stop counting
+**************************************************************************************/
+void Gptm_Stop(Gptm_TimerType a_Timer, Gptm_HalfType a_Half)
+{
+    uint32 State;
+
+    if(a_Timer >= GPTM_TIMERS)
+    {
+        return; /* Report an Error */
+    }
+    State = Enter_Critical();
+    GPTM_TIMER(a_Timer)->CTL &= ~((uint32)GPTM_CTL_EN_MASK << GPTM_HALF_SHIFT(a_Half));
+    Exit_Critical(State);
+}
+
+/*************************************************************************************
+* Service Name      : Gptm_GetValue
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Timer - Timer, a_Half - Half
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : Current counter value, prescaler extension included
+* Description       : The 64-bit value of a concatenated wide timer is read upper, lower, upper until the
+*                     upper word is stable, so a carry between the two reads is never missed.
+**************************************************************************************/
+uint64 Gptm_GetValue(Gptm_TimerType a_Timer, Gptm_HalfType a_Half)
+{
+    volatile GPTM_RegType *Regs;
+    uint32 High;
+    uint32 Low;
+
+    if(a_Timer >= GPTM_TIMERS)
+    {
+        return 0; /* Report an Error */
+    }
+    Regs = GPTM_TIMER(a_Timer);
+
+    if(a_Half == GPTM_HALF_CONCATENATED)
+    {
+        if(!GPTM_IS_WIDE(a_Timer))
+        {
+            return Regs->TAV;
+        }
+        do
+        {
+            High = Regs->TBV;
+            Low  = Regs->TAV;
+        }while(High != Regs->TBV);
+        return ((uint64)High << 32) | Low;
+    }
+    if(GPTM_IS_WIDE(a_Timer))
+    {
+        return ((uint64)GPTM_HALF_REG(Regs, TAPV, a_Half) << GPTM_WIDE_HALF_BITS) | GPTM_HALF_REG(Regs, TAV, a_Half);
+    }
+    return GPTM_HALF_REG(Regs, TAV, a_Half); /* Prescaler already in bits 23..16 */
+}
+
+/*************************************************************************************
+* Service Name      : Gptm_GetCapture
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Timer - Timer, a_Half - Half
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : Time stamp of the last captured edge
+* Description       : Read the hardware time stamp of the last external event
+**************************************************************************************/
+uint64 Gptm_GetCapture(Gptm_TimerType a_Timer, Gptm_HalfType a_Half)
+{
+    volatile GPTM_RegType *Regs;
+
+    if((a_Timer >= GPTM_TIMERS) || (a_Half == GPTM_HALF_CONCATENATED))
+    {
+        return 0; /* Report an Error */
+    }
+    Regs = GPTM_TIMER(a_Timer);
+
+    if(GPTM_IS_WIDE(a_Timer))
+    {
+        return ((uint64)GPTM_HALF_REG(Regs, TAPS, a_Half) << GPTM_WIDE_HALF_BITS) | GPTM_HALF_REG(Regs, TAR, a_Half);
+    }
+    return GPTM_HALF_REG(Regs, TAR, a_Half); /* Prescaler already in bits 23..16 */
+}
+
+/*************************************************************************************
+* Service Name      : Gptm_SetPwmHighTime
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Timer - Timer, a_Half - Half, a_HighTime - High time in timer clocks
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : FALSE if the high time is longer than the period
+* Description       : Change the PWM duty cycle, applied from the next period
+**************************************************************************************/
+boolean Gptm_SetPwmHighTime(Gptm_TimerType a_Timer, Gptm_HalfType a_Half, uint64 a_HighTime)
+{
+    volatile GPTM_RegType *Regs;
+    uint8 HalfBits;
+    uint64 Load;
+    uint64 Match;
+
+    if((a_Timer >= GPTM_TIMERS) || (a_Half == GPTM_HALF_CONCATENATED))
+    {
+        return FALSE; /* Report an Error */
+    }
+    Regs     = GPTM_TIMER(a_Timer);
+    HalfBits = GPTM_IS_WIDE(a_Timer) ? GPTM_WIDE_HALF_BITS : GPTM_HALF_BITS;
+    Load     = ((uint64)GPTM_HALF_REG(Regs, TAPR, a_Half) << HalfBits) | GPTM_HALF_REG(Regs, TAILR, a_Half);
+    if(a_HighTime > Load)
+    {
+        return FALSE; /* Report an Error */
+    }
+
+    Match = Load - a_HighTime;
+    GPTM_HALF_REG(Regs, TAPMR, a_Half)    = (uint32)(Match >> HalfBits);
+    GPTM_HALF_REG(Regs, TAMATCHR, a_Half) = (uint32)(Match & (((uint64)1 << HalfBits) - 1));
+    return TRUE;
+}
+
+/*******************************************************************************
+ *                              Timer Handlers                                 *
+ *******************************************************************************/
+#define GPTM_HANDLER(Name, Timer, Half)   void Name(void) { Gptm_Dispatch((Timer), (Half)); }
+
+GPTM_HANDLER(Timer0A_Handler,     GPTM_TIMER_0,      GPTM_HALF_A)
+GPTM_HANDLER(Timer0B_Handler,     GPTM_TIMER_0,      GPTM_HALF_B)
+GPTM_HANDLER(Timer1A_Handler,     GPTM_TIMER_1,      GPTM_HALF_A)
+GPTM_HANDLER(Timer1B_Handler,     GPTM_TIMER_1,      GPTM_HALF_B)
+GPTM_HANDLER(Timer2A_Handler,     GPTM_TIMER_2,      GPTM_HALF_A)
+GPTM_HANDLER(Timer2B_Handler,     GPTM_TIMER_2,      GPTM_HALF_B)
+GPTM_HANDLER(Timer3A_Handler,     GPTM_TIMER_3,      GPTM_HALF_A)
+GPTM_HANDLER(Timer3B_Handler,     GPTM_TIMER_3,      GPTM_HALF_B)
+GPTM_HANDLER(Timer4A_Handler,     GPTM_TIMER_4,      GPTM_HALF_A)
+GPTM_HANDLER(Timer4B_Handler,     GPTM_TIMER_4,      GPTM_HALF_B)
+GPTM_HANDLER(Timer5A_Handler,     GPTM_TIMER_5,      GPTM_HALF_A)
+GPTM_HANDLER(Timer5B_Handler,     GPTM_TIMER_5,      GPTM_HALF_B)
+GPTM_HANDLER(WideTimer0A_Handler, GPTM_WIDE_TIMER_0, GPTM_HALF_A)
+GPTM_HANDLER(WideTimer0B_Handler, GPTM_WIDE_TIMER_0, GPTM_HALF_B)
+GPTM_HANDLER(WideTimer1A_Handler, GPTM_WIDE_TIMER_1, GPTM_HALF_A)
+GPTM_HANDLER(WideTimer1B_Handler, GPTM_WIDE_TIMER_1, GPTM_HALF_B)
+GPTM_HANDLER(WideTimer2A_Handler, GPTM_WIDE_TIMER_2, GPTM_HALF_A)
+GPTM_HANDLER(WideTimer2B_Handler, GPTM_WIDE_TIMER_2, GPTM_HALF_B)
+GPTM_HANDLER(WideTimer3A_Handler, GPTM_WIDE_TIMER_3, GPTM_HALF_A)
+GPTM_HANDLER(WideTimer3B_Handler, GPTM_WIDE_TIMER_3, GPTM_HALF_B)
+GPTM_HANDLER(WideTimer4A_Handler, GPTM_WIDE_TIMER_4, GPTM_HALF_A)
+GPTM_HANDLER(WideTimer4B_Handler, GPTM_WIDE_TIMER_4, GPTM_HALF_B)
+GPTM_HANDLER(WideTimer5A_Handler, GPTM_WIDE_TIMER_5, GPTM_HALF_A)
+GPTM_HANDLER(WideTimer5B_Handler, GPTM_WIDE_TIMER_5, GPTM_HALF_B)
@@ -0,0 +1,171 @@
+/******************************************************************************
+ *
+ * Module: GPTM
+ *
+ * File Name: GPTM.h
+ *
+ * Description: Header file for the general purpose timers, one-shot, periodic, edge time capture and PWM
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef GPTM_H_
+#define GPTM_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define GPTM_CFG_CONCATENATED             0x00000000  /* 32-bit timer or 64-bit wide timer */
+#define GPTM_CFG_SPLIT                    0x00000004  /* Two 16-bit timers or two 32-bit wide timers */
+
+/* GPTM_TAMR / GPTM_TBMR */
+#define GPTM_MR_ONE_SHOT                  0x00000001
+#define GPTM_MR_PERIODIC                  0x00000002
+#define GPTM_MR_CAPTURE                   0x00000003
+#define GPTM_MR_CMR_MASK                  0x00000004  /* Edge time instead of edge count */
+#define GPTM_MR_AMS_MASK                  0x00000008  /* PWM output */
+#define GPTM_MR_CDIR_MASK                 0x00000010  /* Count up */
+#define GPTM_MR_MRSU_MASK                 0x00000400  /* Match registers updated at the next time-out */
+
+/* GPTM_CTL, timer B fields are shifted by GPTM_HALF_B_SHIFT */
+#define GPTM_CTL_EN_MASK                  0x00000001
+#define GPTM_CTL_STALL_MASK               0x00000002  /* Freeze the counter while the debugger halts the core */
+#define GPTM_CTL_EVENT_BITS_POS           2
+#define GPTM_CTL_EVENT_MASK               0x0000000C
+#define GPTM_CTL_OTE_MASK                 0x00000020  /* Time-outs trigger the ADC sequencers */
+#define GPTM_CTL_PWML_MASK                0x00000040  /* Inverted PWM output */
+
+/* GPTM_IMR / GPTM_RIS / GPTM_MIS / GPTM_ICR, timer B fields are shifted by GPTM_HALF_B_SHIFT */
+#define GPTM_INT_TIMEOUT_MASK             0x00000001
+#define GPTM_INT_CAPTURE_MATCH_MASK       0x00000002
+#define GPTM_INT_CAPTURE_EVENT_MASK       0x00000004
+#define GPTM_INT_MATCH_MASK               0x00000010
+#define GPTM_INT_HALF_MASK                0x00000017
+
+#define GPTM_HALF_B_SHIFT                 8
+
+#define GPTM_HALF_BITS                    16     /* Width of a half of a 16/32-bit timer */
+#define GPTM_WIDE_HALF_BITS               32     /* Width of a half of a 32/64-bit wide timer */
+#define GPTM_PRESCALE_BITS                8
+#define GPTM_WIDE_PRESCALE_BITS           16
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef enum
+{
+    GPTM_TIMER_0, GPTM_TIMER_1, GPTM_TIMER_2, GPTM_TIMER_3, GPTM_TIMER_4, GPTM_TIMER_5,
+    GPTM_WIDE_TIMER_0, GPTM_WIDE_TIMER_1, GPTM_WIDE_TIMER_2, GPTM_WIDE_TIMER_3, GPTM_WIDE_TIMER_4, GPTM_WIDE_TIMER_5,
+    GPTM_TIMERS
+}Gptm_TimerType;
+
+typedef enum
+{
+    GPTM_HALF_A,
+    GPTM_HALF_B,
+    GPTM_HALF_CONCATENATED                /* Both halves as one 32-bit or 64-bit timer, timer A registers and IRQ */
+}Gptm_HalfType;
+
+typedef enum
+{
+    GPTM_MODE_ONE_SHOT,
+    GPTM_MODE_PERIODIC,
+    GPTM_MODE_CAPTURE_TIME,               /* Time stamp of the input edges, split halves only */
+    GPTM_MODE_PWM                         /* Split halves only */
+}Gptm_ModeType;
+
+typedef enum
+{
+    GPTM_EDGE_RISING  = 0,
+    GPTM_EDGE_FALLING = 1,
+    GPTM_EDGE_BOTH    = 3
+}Gptm_EdgeType;
+
+/* Called from the timer handler, a_Value is the captured time stamp in capture mode and 0 otherwise */
+typedef void (*Gptm_CallbackType)(uint64 a_Value);
+
+typedef struct
+{
+    Gptm_TimerType Timer;
+    Gptm_HalfType Half;
+    Gptm_ModeType Mode;
+    uint64 Period;                        /* Timer clocks, time-out or PWM period, unused in capture mode */
+    uint64 HighTime;                      /* PWM high time in timer clocks */
+    Gptm_EdgeType Edge;                   /* Captured edges */
+    boolean InvertOutput;                 /* PWM output inverted */
+    Gptm_CallbackType Callback;           /* NULL_PTR keeps the timer interrupt disabled */
+    NVIC_IRQPriorityType Priority;
+    boolean AdcTrigger;                   /* One-shot and periodic time-outs start the ADC sequencers on timer trigger */
+}Gptm_ConfigType;
+
+
+/*************************************************************************************
+* Service Name   : Gptm_Init
+* Parameters (in): a_Config - Timer, half, mode and interrupt
+* Return value   : FALSE if the configuration is not supported by the timer
+* Description    : Enable the timer clock, configure the mode and route its interrupt through the NVIC
+**************************************************************************************/
+extern boolean Gptm_Init(const Gptm_ConfigType *a_Config);
+
+/*************************************************************************************
+* Service Name   : Gptm_ConfigureBlock
+* Parameters (in): a_Config - Timer, half and mode
+* Parameters (inout): a_Regs - Register block of the timer
+* Return value   : FALSE if the configuration is not supported by the timer
+* Description    : Program the mode registers, used by Gptm_Init and against a simulated block on the host
+**************************************************************************************/
+extern boolean Gptm_ConfigureBlock(volatile GPTM_RegType *a_Regs, const Gptm_ConfigType *a_Config);
+
+/*************************************************************************************
+* Service Name   : Gptm_Start
+* Parameters (in): a_Timer - Timer, a_Half - Half
+* Description    : Start counting
+**************************************************************************************/
+extern void Gptm_Start(Gptm_TimerType a_Timer, Gptm_HalfType a_Half);
+
+/*************************************************************************************
+* Service Name   : Gptm_Stop
+* Parameters (in): a_Timer - Timer, a_Half - Half
+* Description    : Stop counting
+**************************************************************************************/
+extern void Gptm_Stop(Gptm_TimerType a_Timer, Gptm_HalfType a_Half);
+
+/*************************************************************************************
+* Service Name   : Gptm_GetValue
+* Parameters (in): a_Timer - Timer, a_Half - Half
+* Return value   : Current counter value, prescaler extension included
+* Description    : Read the free running value of the timer
+**************************************************************************************/
+extern uint64 Gptm_GetValue(Gptm_TimerType a_Timer, Gptm_HalfType a_Half);
+
+/*************************************************************************************
+* Service Name   : Gptm_GetCapture
+* Parameters (in): a_Timer - Timer, a_Half - Half
+* Return value   : Time stamp of the last captured edge
+* Description    : Read the hardware time stamp of the last external event
+**************************************************************************************/
+extern uint64 Gptm_GetCapture(Gptm_TimerType a_Timer, Gptm_HalfType a_Half);
+
+/*************************************************************************************
+* Service Name   : Gptm_SetPwmHighTime
+* Parameters (in): a_Timer - Timer, a_Half - Half, a_HighTime - High time in timer clocks
+* Return value   : FALSE if the high time is longer than the period
+* Description    : Change the PWM duty cycle, applied from the next period
+**************************************************************************************/
+extern boolean Gptm_SetPwmHighTime(Gptm_TimerType a_Timer, Gptm_HalfType a_Half, uint64 a_HighTime);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* GPTM_H_ */
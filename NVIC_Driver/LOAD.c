@@ -0,0 +1,315 @@
+/*
+ * LOAD.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "NVIC.h"
+#include "SYSTICK.h"
+#include "POWER.h"
+#include "CLOCK.h"
+#include "LOAD.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+typedef struct
+{
+    uint64 Wall;
+    uint64 Idle;
+}Load_WindowType;
+
+static Load_WindowType Load_Short;        /* 100 ms window being filled */
+static Load_WindowType Load_Mid;          /* 1 s window being filled */
+static Load_WindowType Load_Long;         /* 10 s window being filled */
+static uint16 Load_WindowTicks = 1;       /* Ticks in a 100 ms window */
+static uint16 Load_ShortTicks = 0;
+static uint8 Load_MidWindows = 0;
+static uint8 Load_LongWindows = 0;
+static uint64 Load_LastWall = 0;
+static uint64 Load_LastIdle = 0;
+static volatile Load_StatusType Load_Status = {0, 0, 0, 0, LOAD_NO_EXCEPTION, 0, 0, 0};
+
+#if (LOAD_ISR_ACCOUNTING == TRUE)
+static volatile uint32 Load_IsrRuns[LOAD_EXCEPTIONS];
+static volatile uint32 Load_IsrCycles[LOAD_EXCEPTIONS];      /* Current 1 s window */
+static volatile uint32 Load_IsrLastCycles[LOAD_EXCEPTIONS];  /* Last completed 1 s window */
+static volatile uint32 Load_IsrMaxCycles[LOAD_EXCEPTIONS];
+static uint64 Load_IsrWindowWall = 0;     /* Length of the last completed 1 s window */
+#endif
+
+/*******************************************************************************
+ *                       Private Functions Definitions                         *
+ *******************************************************************************/
+
+/* Busy share of a window, the 64-bit division runs once per 100 ms at most */
+static uint16 Load_PerMille(uint64 a_Part, uint64 a_Wall)
+{
+    return (a_Wall != 0) ? (uint16)((a_Part * LOAD_FULL_SCALE) / a_Wall) : 0;
+}
+
+static void Load_AddWindow(Load_WindowType *a_To, Load_WindowType *a_From)
+{
+    a_To->Wall  += a_From->Wall;
+    a_To->Idle  += a_From->Idle;
+    a_From->Wall = 0;
+    a_From->Idle = 0;
+}
+
+#if (LOAD_ISR_ACCOUNTING == TRUE)
+/* Close the 1 s window of the ISR time and find the handler that used most of it. The ISR times are
+ * DWT core cycles, the window is converted from POWER_TIME_BASE_HZ cycles to core cycles first. */
+static void Load_RollIsrWindow(uint64 a_Wall)
+{
+    uint32 Hz = Clock_GetCoreClock();
+    uint32 Top = 0;
+    uint8 TopException = LOAD_NO_EXCEPTION;
+    uint8 Exception;
+    uint32 State;
+
+    for(Exception = 0; Exception < LOAD_EXCEPTIONS; Exception++)
+    {
+        State = Enter_Critical(); /* A higher priority handler may be accounting itself */
+        Load_IsrLastCycles[Exception] = Load_IsrCycles[Exception];
+        Load_IsrCycles[Exception] = 0;
+        Exit_Critical(State);
+        if(Load_IsrLastCycles[Exception] > Top)
+        {
+            Top = Load_IsrLastCycles[Exception];
+            TopException = Exception;
+        }
+    }
+    a_Wall = ((a_Wall / POWER_TIME_BASE_HZ) * Hz) + (((a_Wall % POWER_TIME_BASE_HZ) * Hz) / POWER_TIME_BASE_HZ);
+    Load_IsrWindowWall = a_Wall;
+    Load_Status.TopException     = TopException;
+    Load_Status.TopExceptionLoad = Load_PerMille(Top, a_Wall);
+}
+#endif
+
+/*************************************************************************************
+* Service Name      : Load_Init
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_TickMs - Period of the SysTick tick hooks in milliseconds
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : The idle time is the WFI time accounted by Power_Idle, call it after Power_Init.
+*                     Busy time is the rest of the wall time, ISR time included.
+**************************************************************************************/
+void Load_Init(uint16 a_TickMs)
+{
+    uint32 State;
+
+    if((a_TickMs == 0) || (a_TickMs > LOAD_SHORT_WINDOW_MS))
+    {
+        return; /* Report an Error */
+    }
+
+    State = Enter_Critical();
+    Load_WindowTicks = LOAD_SHORT_WINDOW_MS / a_TickMs;
+    Load_ShortTicks  = 0;
+    Load_MidWindows  = 0;
+    Load_LongWindows = 0;
+    Load_Short.Wall  = 0;
+    Load_Short.Idle  = 0;
+    Load_Mid.Wall    = 0;
+    Load_Mid.Idle    = 0;
+    Load_Long.Wall   = 0;
+    Load_Long.Idle   = 0;
+    Load_Status.Load100ms        = 0;
+    Load_Status.Load1s           = 0;
+    Load_Status.Load10s          = 0;
+    Load_Status.PeakLoad100ms    = 0;
+    Load_Status.TopException     = LOAD_NO_EXCEPTION;
+    Load_Status.TopExceptionLoad = 0;
+    Load_Status.Windows          = 0;
+    Power_GetIdleTime(&Load_LastWall, &Load_LastIdle);
+    Exit_Critical(State);
+
+#if (LOAD_ISR_ACCOUNTING == TRUE)
+    DWT_EnableCycleCounter();
+#endif
+    SysTick_RegisterTickHook(Load_Tick);
+}
+
+/*************************************************************************************
+* Service Name      : Load_Tick
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Account the busy and idle time of the last SysTick period, SysTick tick hook
+**************************************************************************************/
+void Load_Tick(void)
+{
+    uint64 Wall;
+    uint64 Idle;
+
+    Power_GetIdleTime(&Wall, &Idle);
+    Load_AccountTick((uint32)(Wall - Load_LastWall), (uint32)(Idle - Load_LastIdle));
+    Load_LastWall = Wall;
+    Load_LastIdle = Idle;
+}
+
+/*************************************************************************************
+* Service Name      : Load_AccountTick
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_WallCycles - Length of the period, a_IdleCycles - Part of it spent idle
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Each window is the sum of LOAD_WINDOW_RATIO windows of the level below, so a tick
+*                     costs two additions and the divisions run only when a window completes.
+**************************************************************************************/
+void Load_AccountTick(uint32 a_WallCycles, uint32 a_IdleCycles)
+{
+    if(a_IdleCycles > a_WallCycles)
+    {
+        a_IdleCycles = a_WallCycles;
+    }
+    Load_Short.Wall += a_WallCycles;
+    Load_Short.Idle += a_IdleCycles;
+    if(++Load_ShortTicks < Load_WindowTicks)
+    {
+        return;
+    }
+    Load_ShortTicks = 0;
+
+    /* 100 ms window completed */
+    Load_Status.Load100ms = Load_PerMille(Load_Short.Wall - Load_Short.Idle, Load_Short.Wall);
+    if(Load_Status.Load100ms > Load_Status.PeakLoad100ms)
+    {
+        Load_Status.PeakLoad100ms = Load_Status.Load100ms;
+    }
+    Load_Status.Windows++;
+    Load_AddWindow(&Load_Mid, &Load_Short);
+    if(++Load_MidWindows < LOAD_WINDOW_RATIO)
+    {
+        return;
+    }
+    Load_MidWindows = 0;
+
+    /* 1 s window completed */
+    Load_Status.Load1s = Load_PerMille(Load_Mid.Wall - Load_Mid.Idle, Load_Mid.Wall);
+#if (LOAD_ISR_ACCOUNTING == TRUE)
+    Load_RollIsrWindow(Load_Mid.Wall);
+#endif
+    Load_AddWindow(&Load_Long, &Load_Mid);
+    if(++Load_LongWindows < LOAD_WINDOW_RATIO)
+    {
+        return;
+    }
+    Load_LongWindows = 0;
+
+    /* 10 s window completed */
+    Load_Status.Load10s = Load_PerMille(Load_Long.Wall - Load_Long.Idle, Load_Long.Wall);
+    Load_Long.Wall = 0;
+    Load_Long.Idle = 0;
+}
+
+/*************************************************************************************
+* Service Name      : Load_AccountIsr
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_ExceptionNum - Exception number of the handler, a_Cycles - Duration of the run
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Account one handler run, called by LOAD_ISR_EXIT or with injected durations
+**************************************************************************************/
+void Load_AccountIsr(uint8 a_ExceptionNum, uint32 a_Cycles)
+{
+#if (LOAD_ISR_ACCOUNTING == TRUE)
+    uint32 State;
+
+    if(a_ExceptionNum >= LOAD_EXCEPTIONS)
+    {
+        return; /* Report an Error */
+    }
+
+    State = Enter_Critical();
+    Load_IsrRuns[a_ExceptionNum]++;
+    Load_IsrCycles[a_ExceptionNum] += a_Cycles;
+    if(a_Cycles > Load_IsrMaxCycles[a_ExceptionNum])
+    {
+        Load_IsrMaxCycles[a_ExceptionNum] = a_Cycles;
+    }
+    Exit_Critical(State);
+#else
+    (void)a_ExceptionNum;
+    (void)a_Cycles;
+#endif
+}
+
+/*************************************************************************************
+* Service Name      : Load_GetStatus
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : a_Status - Loads of the last completed windows
+* Return value      : None
+* Description       : Read the compact status record
+**************************************************************************************/
+void Load_GetStatus(Load_StatusType *a_Status)
+{
+    uint32 State;
+
+    if(a_Status == NULL_PTR)
+    {
+        return; /* Report an Error */
+    }
+
+    State = Enter_Critical();
+    a_Status->Load100ms        = Load_Status.Load100ms;
+    a_Status->Load1s           = Load_Status.Load1s;
+    a_Status->Load10s          = Load_Status.Load10s;
+    a_Status->PeakLoad100ms    = Load_Status.PeakLoad100ms;
+    a_Status->TopException     = Load_Status.TopException;
+    a_Status->Reserved         = 0;
+    a_Status->TopExceptionLoad = Load_Status.TopExceptionLoad;
+    a_Status->Windows          = Load_Status.Windows;
+    Exit_Critical(State);
+}
+
+/*************************************************************************************
+* Service Name      : Load_GetIsrStats
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_ExceptionNum - Exception number of the handler
+* Parameters (inout): None
+* Parameters (out)  : a_Stats - Runs and time of the handler
+* Return value      : FALSE if the exception number is out of range
+* Description       : Read the ISR time attributed to one exception
+**************************************************************************************/
+boolean Load_GetIsrStats(uint8 a_ExceptionNum, Load_IsrStatsType *a_Stats)
+{
+#if (LOAD_ISR_ACCOUNTING == TRUE)
+    uint32 State;
+
+    if((a_ExceptionNum >= LOAD_EXCEPTIONS) || (a_Stats == NULL_PTR))
+    {
+        return FALSE; /* Report an Error */
+    }
+
+    State = Enter_Critical();
+    a_Stats->Runs      = Load_IsrRuns[a_ExceptionNum];
+    a_Stats->Cycles    = Load_IsrLastCycles[a_ExceptionNum];
+    a_Stats->MaxCycles = Load_IsrMaxCycles[a_ExceptionNum];
+    a_Stats->Load      = Load_PerMille(Load_IsrLastCycles[a_ExceptionNum], Load_IsrWindowWall);
+    Exit_Critical(State);
+    return TRUE;
+#else
+    (void)a_ExceptionNum;
+    (void)a_Stats;
+    return FALSE; /* ISR accounting is compiled out */
+#endif
+}
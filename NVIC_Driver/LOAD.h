@@ -0,0 +1,119 @@
+/******************************************************************************
+ *
+ * Module: Load
+ *
+ * File Name: LOAD.h
+ *
+ * Description: Header file for the CPU load monitor, utilization windows and ISR time per exception
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef LOAD_H_
+#define LOAD_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "DWT.h"
+#include "NVIC.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define LOAD_ISR_ACCOUNTING               TRUE   /* FALSE removes the ISR time hooks and their tables */
+#define LOAD_EXCEPTIONS                   NVIC_EXCEPTIONS   /* 16 system exceptions + the IRQs */
+#define LOAD_SHORT_WINDOW_MS              100    /* Shortest window, each longer window is LOAD_WINDOW_RATIO times longer */
+#define LOAD_WINDOW_RATIO                 10     /* 100 ms, 1 s and 10 s windows */
+#define LOAD_FULL_SCALE                   1000   /* Loads are reported in per-mille */
+
+#define LOAD_NO_EXCEPTION                 0xFF
+
+#if (LOAD_ISR_ACCOUNTING == TRUE)
+/* Hooks to be placed at the first and last line of a handler, the time includes the nested handlers */
+#define LOAD_ISR_ENTER()                  uint32 Load_EntryCycles = DWT_GetCycles()
+#define LOAD_ISR_EXIT(ExceptionNum)       Load_AccountIsr((ExceptionNum), DWT_GetCycles() - Load_EntryCycles)
+#else
+#define LOAD_ISR_ENTER()
+#define LOAD_ISR_EXIT(ExceptionNum)
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Compact status record, loads of the last completed windows in per-mille */
+typedef struct
+{
+    uint16 Load100ms;
+    uint16 Load1s;
+    uint16 Load10s;
+    uint16 PeakLoad100ms;                 /* Highest 100 ms load since Load_Init */
+    uint8  TopException;                  /* Exception with the most ISR time in the last 1 s window */
+    uint8  Reserved;
+    uint16 TopExceptionLoad;
+    uint32 Windows;                       /* Completed 100 ms windows */
+}Load_StatusType;
+
+typedef struct
+{
+    uint32 Runs;                          /* Handler runs since Load_Init */
+    uint32 Cycles;                        /* Handler time in the last completed 1 s window */
+    uint32 MaxCycles;                     /* Longest single run */
+    uint16 Load;                          /* Share of the last completed 1 s window in per-mille */
+}Load_IsrStatsType;
+
+
+/*************************************************************************************
+* Service Name   : Load_Init
+* Parameters (in): a_TickMs - Period of the SysTick tick hooks in milliseconds
+* Description    : Reset the windows and start the measurement from the SysTick tick hook
+**************************************************************************************/
+extern void Load_Init(uint16 a_TickMs);
+
+/*************************************************************************************
+* Service Name   : Load_Tick
+* Parameters (in): None
+* Description    : Account the busy and idle time of the last SysTick period, SysTick tick hook
+**************************************************************************************/
+extern void Load_Tick(void);
+
+/*************************************************************************************
+* Service Name   : Load_AccountTick
+* Parameters (in): a_WallCycles - Length of the period, a_IdleCycles - Part of it spent idle
+* Description    : Feed one period to the windows, Load_Tick source or a simulated clock on the host
+**************************************************************************************/
+extern void Load_AccountTick(uint32 a_WallCycles, uint32 a_IdleCycles);
+
+/*************************************************************************************
+* Service Name   : Load_AccountIsr
+* Parameters (in): a_ExceptionNum - Exception number of the handler, a_Cycles - Duration of the run
+* Description    : Account one handler run, called by LOAD_ISR_EXIT or with injected durations
+**************************************************************************************/
+extern void Load_AccountIsr(uint8 a_ExceptionNum, uint32 a_Cycles);
+
+/*************************************************************************************
+* Service Name   : Load_GetStatus
+* Parameters (out): a_Status - Loads of the last completed windows
+* Description    : Read the compact status record
+**************************************************************************************/
+extern void Load_GetStatus(Load_StatusType *a_Status);
+
+/*************************************************************************************
+* Service Name   : Load_GetIsrStats
+* Parameters (in): a_ExceptionNum - Exception number of the handler
+* Parameters (out): a_Stats - Runs and time of the handler
+* Return value   : FALSE if the exception number is out of range
+* Description    : Read the ISR time attributed to one exception
+**************************************************************************************/
+extern boolean Load_GetIsrStats(uint8 a_ExceptionNum, Load_IsrStatsType *a_Stats);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* LOAD_H_ */
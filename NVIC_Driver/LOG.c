@@ -0,0 +1,171 @@
+/*
+ * LOG.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "ATOMIC.h"
+#include "SYSTICK.h"
+#include "LOG.h"
+
+#if ((LOG_BUFFER_WORDS & (LOG_BUFFER_WORDS - 1)) != 0)
+#error "LOG_BUFFER_WORDS must be a power of 2"
+#endif
+
+#define LOG_INDEX_MASK              (LOG_BUFFER_WORDS - 1)
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+volatile Log_BufferType Log_Buffer;
+
+static volatile uint32 Log_ReserveIndex;        /* Free running count of reserved words, ahead of WriteIndex */
+static volatile uint32 Log_Writers;             /* Log_Write calls in progress, nested by preemption */
+
+/*******************************************************************************
+ *                       Private Functions Definitions                         *
+ *******************************************************************************/
+
+/*
+ * Called by every writer on its way out. A writer only preempts writers of lower priority and
+ * returns before they resume, so the last writer out finds every reservation filled: it moves
+ * WriteIndex to the reservation index. A writer that preempts it between the two reads publishes
+ * a later index itself, WriteIndex is then only moved forward.
+ */
+static void Log_Publish(void)
+{
+    uint32 Reserved;
+    uint32 Written;
+
+    if(Atomic_FetchAdd(&Log_Writers, (uint32)-1) != 1)
+    {
+        return; /* A preempted writer has not filled its reservation yet, it publishes when it leaves */
+    }
+    Reserved = Log_ReserveIndex;
+    do
+    {
+        Written = Log_Buffer.Header.WriteIndex;
+        if((sint32)(Reserved - Written) <= 0)
+        {
+            return;
+        }
+    }while(!Atomic_CompareExchange(&Log_Buffer.Header.WriteIndex, Written, Reserved));
+}
+
+/*************************************************************************************
+* Service Name      : Log_Init
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_TickMs - Period of the SysTick time stamps in milliseconds
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Clear the log ring
+**************************************************************************************/
+void Log_Init(uint16 a_TickMs)
+{
+    Log_Buffer.Header.Magic      = LOG_MAGIC;
+    Log_Buffer.Header.Capacity   = LOG_BUFFER_WORDS;
+    Log_Buffer.Header.WriteIndex = 0;
+    Log_Buffer.Header.ReadIndex  = 0;
+    Log_ReserveIndex             = 0;
+    Log_Writers                  = 0;
+    Log_Buffer.Header.Dropped    = 0;
+    Log_Buffer.Header.TickHz     = (a_TickMs != 0) ? (1000 / a_TickMs) : 0;
+}
+
+/*************************************************************************************
+* Service Name      : Log_Write
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Header - LOG_HEADER(Id, Args), a_Arg0 .. a_Arg2 - Raw arguments
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : FALSE if the record was dropped because the ring is full
+* Description       : No formatting on the target and no interrupt disabled: the record space is reserved
+*                     with an LDREX/STREX compare and swap of the reservation index, then filled with 2 to
+*                     5 word stores that a higher priority writer can preempt without splitting the record.
+*                     The reader sees the records once WriteIndex is published (Log_Publish). A full ring
+*                     drops the new record and counts it, the records not drained yet are never overwritten.
+**************************************************************************************/
+boolean Log_Write(uint32 a_Header, uint32 a_Arg0, uint32 a_Arg1, uint32 a_Arg2)
+{
+    uint32 Args  = (a_Header >> LOG_ARGS_BITS_POS) & LOG_ARGS_MASK;
+    uint32 Words = LOG_RECORD_WORDS(Args);
+    uint32 Index;
+
+    (void)Atomic_FetchAdd(&Log_Writers, 1);
+    do
+    {
+        Index = Log_ReserveIndex;
+        if((Index - Log_Buffer.Header.ReadIndex + Words) > LOG_BUFFER_WORDS)
+        {
+            (void)Atomic_FetchAdd(&Log_Buffer.Header.Dropped, 1);
+            Log_Publish();
+            return FALSE;
+        }
+    }while(!Atomic_CompareExchange(&Log_ReserveIndex, Index, Index + Words));
+
+    Log_Buffer.Words[Index++ & LOG_INDEX_MASK] = a_Header;
+    Log_Buffer.Words[Index++ & LOG_INDEX_MASK] = SysTick_GetTickCount();
+    if(Args > 0)
+    {
+        Log_Buffer.Words[Index++ & LOG_INDEX_MASK] = a_Arg0;
+    }
+    if(Args > 1)
+    {
+        Log_Buffer.Words[Index++ & LOG_INDEX_MASK] = a_Arg1;
+    }
+    if(Args > 2)
+    {
+        Log_Buffer.Words[Index++ & LOG_INDEX_MASK] = a_Arg2;
+    }
+    Log_Publish();
+
+    return TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : Log_Read
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_MaxWords - Size of a_Words
+* Parameters (inout): None
+* Parameters (out)  : a_Words - Whole records drained from the ring
+* Return value      : Number of words drained
+* Description       : The writers only move WriteIndex, past filled records only, and the reader only moves
+*                     ReadIndex, so the copy runs with interrupts enabled. Only whole records are returned.
+**************************************************************************************/
+uint16 Log_Read(uint32 *a_Words, uint16 a_MaxWords)
+{
+    uint32 Read  = Log_Buffer.Header.ReadIndex;
+    uint32 Write = Log_Buffer.Header.WriteIndex;
+    uint16 Count = 0;
+    uint32 Words;
+    uint32 Word;
+
+    if(a_Words == NULL_PTR)
+    {
+        return 0; /* Report an Error */
+    }
+
+    while(Read != Write)
+    {
+        Words = LOG_RECORD_WORDS((Log_Buffer.Words[Read & LOG_INDEX_MASK] >> LOG_ARGS_BITS_POS) & LOG_ARGS_MASK);
+        if((Count + Words) > a_MaxWords)
+        {
+            break;
+        }
+        for(Word = 0; Word < Words; Word++)
+        {
+            a_Words[Count++] = Log_Buffer.Words[Read++ & LOG_INDEX_MASK];
+        }
+    }
+    Log_Buffer.Header.ReadIndex = Read;
+
+    return Count;
+}
@@ -0,0 +1,113 @@
+/******************************************************************************
+ *
+ * Module: Log
+ *
+ * File Name: LOG.h
+ *
+ * Description: Header file for the tokenized binary log, formatting is deferred to the host
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef LOG_H_
+#define LOG_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define LOG_ENABLE                        TRUE   /* FALSE removes every log call at compile time */
+#define LOG_BUFFER_WORDS                  256    /* Must be a power of 2 */
+#define LOG_MAX_ARGS                      3      /* The id and the arguments are passed in R0-R3 */
+
+#define LOG_MAGIC                         0x31474F4C  /* "LOG1" */
+
+/* Record layout: header word, SysTick tick count, then the arguments */
+#define LOG_RECORD_TAG                    0xA5        /* Lets a stream decoder resynchronize */
+#define LOG_ID_BITS_POS                   16
+#define LOG_ARGS_BITS_POS                 8
+#define LOG_ARGS_MASK                     0x0F
+#define LOG_HEADER(Id, Args)              (((uint32)(Id) << LOG_ID_BITS_POS) | ((uint32)(Args) << LOG_ARGS_BITS_POS) | LOG_RECORD_TAG)
+#define LOG_RECORD_WORDS(Args)            (2 + (Args))
+
+#if (LOG_ENABLE == TRUE)
+/* The header is a constant, a call site costs the argument moves and one call */
+#define LOG0(Id)                          Log_Write(LOG_HEADER((Id), 0), 0, 0, 0)
+#define LOG1(Id, A)                       Log_Write(LOG_HEADER((Id), 1), (uint32)(A), 0, 0)
+#define LOG2(Id, A, B)                    Log_Write(LOG_HEADER((Id), 2), (uint32)(A), (uint32)(B), 0)
+#define LOG3(Id, A, B, C)                 Log_Write(LOG_HEADER((Id), 3), (uint32)(A), (uint32)(B), (uint32)(C))
+#else
+#define LOG0(Id)
+#define LOG1(Id, A)
+#define LOG2(Id, A, B)
+#define LOG3(Id, A, B, C)
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+#define LOG_FORMAT(Id, Format)            Id,
+typedef enum
+{
+#include "LOG_FORMATS.h"
+    LOG_ID_COUNT
+}Log_IdType;
+#undef LOG_FORMAT
+
+/* Header of the log dump, the host decoder reads it from the start of Log_Buffer */
+typedef struct
+{
+    uint32 Magic;
+    uint32 Capacity;                      /* Number of words in the ring */
+    uint32 WriteIndex;                    /* Free running count of written words */
+    uint32 ReadIndex;                     /* Free running count of drained words */
+    uint32 Dropped;                       /* Records lost because the ring was full */
+    uint32 TickHz;                        /* Frequency of the record time stamps */
+}Log_HeaderType;
+
+typedef struct
+{
+    Log_HeaderType Header;
+    uint32 Words[LOG_BUFFER_WORDS];
+}Log_BufferType;
+
+/* Dump sizeof(Log_Buffer) bytes from &Log_Buffer and feed them to tools/log_decode */
+extern volatile Log_BufferType Log_Buffer;
+
+
+/*************************************************************************************
+* Service Name   : Log_Init
+* Parameters (in): a_TickMs - Period of the SysTick time stamps in milliseconds
+* Description    : Clear the log ring
+**************************************************************************************/
+extern void Log_Init(uint16 a_TickMs);
+
+/*************************************************************************************
+* Service Name   : Log_Write
+* Parameters (in): a_Header - LOG_HEADER(Id, Args), a_Arg0 .. a_Arg2 - Raw arguments
+* Return value   : FALSE if the record was dropped because the ring is full
+* Description    : Append a time stamped record to the log ring, callable from any context
+**************************************************************************************/
+extern boolean Log_Write(uint32 a_Header, uint32 a_Arg0, uint32 a_Arg1, uint32 a_Arg2);
+
+/*************************************************************************************
+* Service Name   : Log_Read
+* Parameters (in): a_MaxWords - Size of a_Words
+* Parameters (out): a_Words - Whole records drained from the ring
+* Return value   : Number of words drained
+* Description    : Drain the ring for a transport (UART, debugger channel), a single reader only
+**************************************************************************************/
+extern uint16 Log_Read(uint32 *a_Words, uint16 a_MaxWords);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* LOG_H_ */
@@ -0,0 +1,24 @@
+/******************************************************************************
+ *
+ * Module: Log
+ *
+ * File Name: LOG_FORMATS.h
+ *
+ * Description: Format strings of the tokenized log, the records only carry the index in this table.
+ *              Included by LOG.h to build the ids and by tools/log_decode.c to rebuild the messages.
+ *              Append new formats at the end so the ids of the existing dumps stay valid.
+ *              The arguments are 32-bit words, use %u, %d, %x, %X or %c only.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+/* No include guard, each user defines LOG_FORMAT(Id, Format) before including this file */
+
+LOG_FORMAT(LOG_ID_BOOT_READY,       "system ready %u cycles after reset")
+LOG_FORMAT(LOG_ID_CLOCK_CHANGED,    "core clock changed to %u Hz")
+LOG_FORMAT(LOG_ID_IRQ_THROTTLED,    "IRQ %u throttled for %u ticks")
+LOG_FORMAT(LOG_ID_IRQ_RESUMED,      "IRQ %u resumed")
+LOG_FORMAT(LOG_ID_MEM_FAULT,        "memory fault status 0x%02X address 0x%08X")
+LOG_FORMAT(LOG_ID_USER_VALUE,       "value %d")
+LOG_FORMAT(LOG_ID_WATCHDOG_RESET,   "watchdog reset: client %u fault %u exception %u")
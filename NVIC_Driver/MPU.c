@@ -0,0 +1,257 @@
+/*
+ * MPU.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "DWT.h"
+#include "MPU.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static Mpu_StatsType Mpu_Stats;
+static volatile Mpu_FaultType Mpu_LastFault;
+
+/*************************************************************************************
+* Service Name      : Mpu_EncodeRegion
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Region - Region description, a_Number - MPU region number
+* Parameters (inout): None
+* Parameters (out)  : a_Encoded - BASE (with VALID and region number) and ATTR register values
+* Return value      : FALSE if the region breaks the size or alignment rules
+* Description       : The size must be a power of 2 of at least 32 bytes, the base must be aligned to the
+*                     size and sub-regions can only be disabled in regions of 256 bytes or more.
+**************************************************************************************/
+boolean Mpu_EncodeRegion(const Mpu_RegionConfigType *a_Region, uint8 a_Number, MPU_RegionRegType *a_Encoded)
+{
+    uint32 Size;
+    uint32 Log2Size;
+
+    if((a_Region == NULL_PTR) || (a_Encoded == NULL_PTR) || (a_Number >= MPU_REGIONS))
+    {
+        return FALSE; /* Report an Error */
+    }
+
+    Size = a_Region->Size;
+    if((Size < MPU_MIN_REGION_SIZE) || ((Size & (Size - 1)) != 0) || ((a_Region->BaseAddress & (Size - 1)) != 0))
+    {
+        return FALSE; /* Report an Error */
+    }
+    if(((a_Region->Attributes & MPU_ATTR_SRD_MASK) != 0) && (Size < MPU_MIN_SUBREGION_SIZE))
+    {
+        return FALSE; /* Report an Error */
+    }
+
+    Log2Size = 31 - _norm(Size); /* Region size is 2^(SIZE + 1) */
+    a_Encoded->BASE = a_Region->BaseAddress | MPU_BASE_VALID_MASK | a_Number;
+    a_Encoded->ATTR = (a_Region->Attributes & ~(MPU_ATTR_SIZE_MASK | MPU_ATTR_ENABLE_MASK)) |
+                      ((Log2Size - 1) << MPU_ATTR_SIZE_BITS_POS) | MPU_ATTR_ENABLE_MASK;
+    return TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : Mpu_Init
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Config - Static regions table
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : FALSE if a region breaks the size or alignment rules, the MPU is left disabled
+* Description       : The static regions take numbers 0 .. MPU_STATIC_REGIONS - 1 in table order, so a later
+*                     entry wins where regions overlap, and the task regions above them win over all of them.
+*                     The default memory map stays active for privileged accesses outside the regions.
+**************************************************************************************/
+boolean Mpu_Init(const Mpu_ConfigType *a_Config)
+{
+    MPU_RegionRegType Encoded[MPU_STATIC_REGIONS];
+    uint8 Index;
+
+    if((a_Config == NULL_PTR) || (a_Config->RegionsCount > MPU_STATIC_REGIONS))
+    {
+        return FALSE; /* Report an Error */
+    }
+    for(Index = 0; Index < a_Config->RegionsCount; Index++)
+    {
+        if(!Mpu_EncodeRegion(&a_Config->Regions[Index], Index, &Encoded[Index]))
+        {
+            return FALSE; /* Report an Error */
+        }
+    }
+
+    MPU_REGS->CTRL = 0; /* Disable the MPU while the regions are reprogrammed */
+    for(Index = 0; Index < MPU_REGIONS; Index++)
+    {
+        MPU_REGS->NUMBER = Index;
+        MPU_REGS->REGION[0].ATTR = (Index < a_Config->RegionsCount) ? Encoded[Index].ATTR : 0;
+        MPU_REGS->REGION[0].BASE = (Index < a_Config->RegionsCount) ? Encoded[Index].BASE : 0;
+    }
+
+    NVIC_EnableException(EXCEPTION_MEM_FAULT_TYPE);
+    MPU_REGS->CTRL = MPU_CTRL_PRIVDEFENA_MASK | MPU_CTRL_ENABLE_MASK;
+    __asm(" DSB");
+    __asm(" ISB");
+    return TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : Mpu_BuildTaskRegions
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Regions - Task regions, a_RegionsCount - Up to MPU_TASK_REGIONS
+* Parameters (inout): None
+* Parameters (out)  : a_TaskRegions - Encoded regions, the unused task regions are disabled
+* Return value      : FALSE if a region breaks the size or alignment rules
+* Description       : Encode the regions of a task once so the context switch only copies register values
+**************************************************************************************/
+boolean Mpu_BuildTaskRegions(const Mpu_RegionConfigType *a_Regions, uint8 a_RegionsCount,
+                             Mpu_TaskRegionsType *a_TaskRegions)
+{
+    uint8 Index;
+
+    if((a_TaskRegions == NULL_PTR) || (a_RegionsCount > MPU_TASK_REGIONS) || ((a_Regions == NULL_PTR) && (a_RegionsCount != 0)))
+    {
+        return FALSE; /* Report an Error */
+    }
+    for(Index = 0; Index < MPU_TASK_REGIONS; Index++)
+    {
+        if(Index < a_RegionsCount)
+        {
+            if(!Mpu_EncodeRegion(&a_Regions[Index], MPU_STATIC_REGIONS + Index, &a_TaskRegions->Region[Index]))
+            {
+                return FALSE; /* Report an Error */
+            }
+        }
+        else
+        {
+            a_TaskRegions->Region[Index].BASE = MPU_BASE_VALID_MASK | (MPU_STATIC_REGIONS + Index);
+            a_TaskRegions->Region[Index].ATTR = 0;
+        }
+    }
+    return TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : Mpu_LoadTaskRegions
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_TaskRegions - Encoded task regions, NULL_PTR disables the task regions
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Each BASE value carries VALID and its region number, so the four BASE/ATTR alias pairs
+*                     reprogram the four task regions with eight consecutive stores and no MPU_NUMBER write.
+*                     Called by the scheduler with interrupts disabled.
+**************************************************************************************/
+void Mpu_LoadTaskRegions(const Mpu_TaskRegionsType *a_TaskRegions)
+{
+    static const Mpu_TaskRegionsType Disabled =
+    {
+        {
+            { MPU_BASE_VALID_MASK | (MPU_STATIC_REGIONS + 0), 0 },
+            { MPU_BASE_VALID_MASK | (MPU_STATIC_REGIONS + 1), 0 },
+            { MPU_BASE_VALID_MASK | (MPU_STATIC_REGIONS + 2), 0 },
+            { MPU_BASE_VALID_MASK | (MPU_STATIC_REGIONS + 3), 0 }
+        }
+    };
+    uint32 Start = DWT_GetCycles();
+    uint32 Cycles;
+    uint8 Index;
+
+    if(a_TaskRegions == NULL_PTR)
+    {
+        a_TaskRegions = &Disabled;
+    }
+    for(Index = 0; Index < MPU_TASK_REGIONS; Index++)
+    {
+        MPU_REGS->REGION[Index].BASE = a_TaskRegions->Region[Index].BASE;
+        MPU_REGS->REGION[Index].ATTR = a_TaskRegions->Region[Index].ATTR;
+    }
+    __asm(" DSB");
+    __asm(" ISB");
+
+    Cycles = DWT_GetCycles() - Start;
+    Mpu_Stats.Reloads++;
+    Mpu_Stats.LastReloadCycles = Cycles;
+    if(Cycles > Mpu_Stats.MaxReloadCycles)
+    {
+        Mpu_Stats.MaxReloadCycles = Cycles;
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Mpu_GetStats
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : a_Stats - Reload count and cost in core cycles
+* Return value      : None
+* Description       : Report the per switch cost of the task regions reload
+**************************************************************************************/
+void Mpu_GetStats(Mpu_StatsType *a_Stats)
+{
+    uint32 State;
+
+    if(a_Stats == NULL_PTR)
+    {
+        return; /* Report an Error */
+    }
+    State = Enter_Critical();
+    *a_Stats = Mpu_Stats;
+    Exit_Critical(State);
+}
+
+/*************************************************************************************
+* Service Name      : Mpu_GetLastFault
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : a_Fault - Status and address of the last memory management fault
+* Return value      : None
+* Description       : Read the diagnostic recorded by MemManage_Handler
+**************************************************************************************/
+void Mpu_GetLastFault(Mpu_FaultType *a_Fault)
+{
+    if(a_Fault == NULL_PTR)
+    {
+        return; /* Report an Error */
+    }
+    a_Fault->Status  = Mpu_LastFault.Status;
+    a_Fault->Address = Mpu_LastFault.Address;
+    a_Fault->Count   = Mpu_LastFault.Count;
+}
+
+/*************************************************************************************
+* Service Name      : MemManage_Handler
+* Sync/Async        : Asynchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Record the fault status and the faulting address, then stop here so the debugger
+*                     can inspect the stacked frame of the access that violated a region.
+**************************************************************************************/
+void MemManage_Handler(void)
+{
+    uint32 Status = SCB_REGS->FAULTSTAT & MPU_MMFSR_MASK;
+
+    Mpu_LastFault.Status  = Status;
+    Mpu_LastFault.Address = (Status & MPU_MMFSR_MMARVALID_MASK) ? SCB_REGS->MMADDR : 0;
+    Mpu_LastFault.Count++;
+    SCB_REGS->FAULTSTAT = Status; /* Write 1 to clear */
+
+    while(1)
+    {
+        /* Stop here */
+    }
+}
@@ -0,0 +1,155 @@
+/******************************************************************************
+ *
+ * Module: MPU
+ *
+ * File Name: MPU.h
+ *
+ * Description: Header file for the ARM Cortex M4 MPU region manager
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef MPU_H_
+#define MPU_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define MPU_REGIONS                       8
+#define MPU_TASK_REGIONS                  4      /* Regions MPU_REGIONS - MPU_TASK_REGIONS .. 7 follow the running task */
+#define MPU_STATIC_REGIONS                (MPU_REGIONS - MPU_TASK_REGIONS)
+#define MPU_MIN_REGION_SIZE               32
+#define MPU_MIN_SUBREGION_SIZE            256    /* Sub-regions can not be disabled in smaller regions */
+
+/* MPU_CTRL */
+#define MPU_CTRL_ENABLE_MASK              0x00000001
+#define MPU_CTRL_PRIVDEFENA_MASK          0x00000004  /* Default memory map for privileged accesses outside the regions */
+
+/* MPU_BASE */
+#define MPU_BASE_VALID_MASK               0x00000010  /* Write the REGION field to MPU_NUMBER with the base address */
+#define MPU_BASE_REGION_MASK              0x0000000F
+
+/* MPU_ATTR, attributes of Mpu_RegionConfigType */
+#define MPU_ATTR_XN                       0x10000000  /* Instruction fetches fault */
+#define MPU_ATTR_AP_NO_ACCESS             0x00000000
+#define MPU_ATTR_AP_PRIV_RW               0x01000000
+#define MPU_ATTR_AP_PRIV_RW_USER_RO       0x02000000
+#define MPU_ATTR_AP_FULL_ACCESS           0x03000000
+#define MPU_ATTR_AP_PRIV_RO               0x05000000
+#define MPU_ATTR_AP_READ_ONLY             0x06000000
+#define MPU_ATTR_MEM_FLASH                0x00020000  /* Normal, write-through, not shareable */
+#define MPU_ATTR_MEM_SRAM                 0x00060000  /* Normal, write-through, shareable */
+#define MPU_ATTR_MEM_PERIPHERAL           0x00050000  /* Device, shareable */
+#define MPU_ATTR_SRD(Mask)                ((uint32)((Mask) & 0xFF) << 8)  /* Disabled sub-regions, one bit per eighth */
+
+#define MPU_ATTR_SRD_MASK                 0x0000FF00
+#define MPU_ATTR_SIZE_MASK                0x0000003E
+#define MPU_ATTR_SIZE_BITS_POS            1
+#define MPU_ATTR_ENABLE_MASK              0x00000001
+
+/* Memory management fault status, byte 0 of SCB FAULTSTAT */
+#define MPU_MMFSR_MASK                    0x000000FF
+#define MPU_MMFSR_MMARVALID_MASK          0x00000080
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    uint32 BaseAddress;                   /* Aligned to Size */
+    uint32 Size;                          /* Power of 2, at least MPU_MIN_REGION_SIZE bytes */
+    uint32 Attributes;                    /* MPU_ATTR_XN | MPU_ATTR_AP_xxx | MPU_ATTR_MEM_xxx | MPU_ATTR_SRD(xxx) */
+}Mpu_RegionConfigType;
+
+/* Regions overlapping each other take the attributes of the last one in the table */
+typedef struct
+{
+    const Mpu_RegionConfigType *Regions;
+    uint8 RegionsCount;                   /* Up to MPU_STATIC_REGIONS */
+}Mpu_ConfigType;
+
+/* Task regions encoded once by Mpu_BuildTaskRegions, reloaded by the scheduler on each switch */
+typedef struct
+{
+    MPU_RegionRegType Region[MPU_TASK_REGIONS];
+}Mpu_TaskRegionsType;
+
+typedef struct
+{
+    uint32 Reloads;                       /* Task region reloads performed on context switches */
+    uint32 LastReloadCycles;
+    uint32 MaxReloadCycles;
+}Mpu_StatsType;
+
+typedef struct
+{
+    uint32 Status;                        /* Memory management fault status (IACCVIOL, DACCVIOL, MSTKERR ...) */
+    uint32 Address;                       /* Faulting data address, 0 when not valid */
+    uint32 Count;
+}Mpu_FaultType;
+
+
+/*************************************************************************************
+* Service Name   : Mpu_Init
+* Parameters (in): a_Config - Static regions table
+* Return value   : FALSE if a region breaks the size or alignment rules, the MPU is left disabled
+* Description    : Program the static regions, enable the MPU and the memory management fault
+**************************************************************************************/
+extern boolean Mpu_Init(const Mpu_ConfigType *a_Config);
+
+/*************************************************************************************
+* Service Name   : Mpu_EncodeRegion
+* Parameters (in): a_Region - Region description, a_Number - MPU region number
+* Parameters (out): a_Encoded - BASE (with VALID and region number) and ATTR register values
+* Return value   : FALSE if the region breaks the size or alignment rules
+* Description    : Validate a region and compute its register values
+**************************************************************************************/
+extern boolean Mpu_EncodeRegion(const Mpu_RegionConfigType *a_Region, uint8 a_Number, MPU_RegionRegType *a_Encoded);
+
+/*************************************************************************************
+* Service Name   : Mpu_BuildTaskRegions
+* Parameters (in): a_Regions - Task regions, a_RegionsCount - Up to MPU_TASK_REGIONS
+* Parameters (out): a_TaskRegions - Encoded regions, the unused task regions are disabled
+* Return value   : FALSE if a region breaks the size or alignment rules
+* Description    : Encode the regions of a task once, before the task is started
+**************************************************************************************/
+extern boolean Mpu_BuildTaskRegions(const Mpu_RegionConfigType *a_Regions, uint8 a_RegionsCount,
+                                    Mpu_TaskRegionsType *a_TaskRegions);
+
+/*************************************************************************************
+* Service Name   : Mpu_LoadTaskRegions
+* Parameters (in): a_TaskRegions - Encoded task regions, NULL_PTR disables the task regions
+* Description    : Reprogram the task regions through the alias registers, called on context switch
+**************************************************************************************/
+extern void Mpu_LoadTaskRegions(const Mpu_TaskRegionsType *a_TaskRegions);
+
+/*************************************************************************************
+* Service Name   : Mpu_GetStats
+* Parameters (out): a_Stats - Reload count and cost in core cycles
+* Description    : Report the per switch cost of the task regions reload
+**************************************************************************************/
+extern void Mpu_GetStats(Mpu_StatsType *a_Stats);
+
+/*************************************************************************************
+* Service Name   : Mpu_GetLastFault
+* Parameters (out): a_Fault - Status and address of the last memory management fault
+* Description    : Read the diagnostic recorded by MemManage_Handler
+**************************************************************************************/
+extern void Mpu_GetLastFault(Mpu_FaultType *a_Fault);
+
+extern void MemManage_Handler(void);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* MPU_H_ */
@@ -11,6 +11,9 @@
 #include "tm4c123gh6pm_registers.h"
 #include "NVIC.h"
 
+/* NVIC_IRQS.h, filtered by the peripherals of the part, must end at the last IRQ of the part */
+typedef char NVIC_IrqCount_Check[(NVIC_IRQ_COUNT == DEVICE_IRQ_COUNT) ? 1 : -1];
+
 
 
 
@@ -26,29 +29,10 @@
 **************************************************************************************/
 extern void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num)
 {
-    if(IRQ_Num <=31)
-    {
-        NVIC_EN0_REG |= (1 << IRQ_Num);
-    }
-    else if ((IRQ_Num > 31) && (IRQ_Num <=63))
-    {
-        IRQ_Num -=31;
-        NVIC_EN1_REG |= (1 << IRQ_Num);
-    }
-    else if ((IRQ_Num > 63) && (IRQ_Num <=95))
-    {
-        IRQ_Num -=63;
-        NVIC_EN2_REG |= (1 << IRQ_Num);
-    }
-    else if ((IRQ_Num > 95) && (IRQ_Num <=127))
-    {
-        IRQ_Num -=95;
-        NVIC_EN3_REG |= (1 << IRQ_Num);
-    }
-    else if ((IRQ_Num > 127) && (IRQ_Num <=138))
+    if(IRQ_Num <= NVIC_MAX_IRQ_NUM)
     {
-        IRQ_Num -=127;
-        NVIC_EN4_REG |= (1 << IRQ_Num);
+        /* Writing 0 to the ENn registers has no effect, a single store enables the IRQ */
+        NVIC_REGS->EN[IRQ_Num / NVIC_IRQ_BANK_BITS] = (1UL << (IRQ_Num % NVIC_IRQ_BANK_BITS));
     }
     else
     {
@@ -68,36 +52,15 @@ extern void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num)
 **************************************************************************************/
 extern void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num)
 {
-    if(IRQ_Num <=31)
-       {
-           NVIC_DIS0_REG |= (1 << IRQ_Num);
-       }
-       else if ((IRQ_Num > 31) && (IRQ_Num <=63))
-       {
-           IRQ_Num -=31;
-           NVIC_DIS1_REG |= (1 << IRQ_Num);
-       }
-       else if ((IRQ_Num > 63) && (IRQ_Num <=95))
-       {
-           IRQ_Num -=63;
-           NVIC_DIS2_REG |= (1 << IRQ_Num);
-       }
-       else if ((IRQ_Num > 95) && (IRQ_Num <=127))
-       {
-           IRQ_Num -=95;
-           NVIC_DIS3_REG |= (1 << IRQ_Num);
-       }
-       else if ((IRQ_Num > 127) && (IRQ_Num <=138))
-       {
-           IRQ_Num -=127;
-           NVIC_DIS4_REG |= (1 << IRQ_Num);
-       }
-       else
-       {
-           /* Report an Error*/
-       }
-
-  
+    if(IRQ_Num <= NVIC_MAX_IRQ_NUM)
+    {
+        /* The DISn registers are write 1 to clear, a read-modify-write would disable every enabled IRQ of the bank */
+        NVIC_REGS->DIS[IRQ_Num / NVIC_IRQ_BANK_BITS] = (1UL << (IRQ_Num % NVIC_IRQ_BANK_BITS));
+    }
+    else
+    {
+        /* Report an Error*/
+    }
 }
 
 /*************************************************************************************
@@ -112,15 +75,10 @@ extern void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num)
 **************************************************************************************/
 extern void NVIC_SetPriorityIRQ(NVIC_IRQType IRQ_Num, NVIC_IRQPriorityType IRQ_Priority)
 {
-    if((IRQ_Num <=138)&&(IRQ_Priority <= 7))
+    if((IRQ_Num <= NVIC_MAX_IRQ_NUM) && (IRQ_Priority <= NVIC_MAX_PRIORITY))
     {
-        volatile uint32 * Priority_Register_Pointer = ((volatile uint32 *)0xE000E400); /* Initialize pointer points to NVIC_PRIORITY_REG Base Address */
-        uint8 Priority_Register_Num = (IRQ_Num / 4); /* Calculate Priority Register number */
-        uint8 Priority_IRQ_Pos      = (IRQ_Num % 4)*8 + 5; /* Calculate IRQ position in Register */
-
-        Priority_Register_Pointer  += Priority_Register_Num; /* Increment the pointer by Priority Register number(offset)  */
-        *Priority_Register_Pointer  &= ~(7 << Priority_IRQ_Pos); /* Clear priority for desired IRQ */
-        *Priority_Register_Pointer  |= (IRQ_Priority << Priority_IRQ_Pos); /* Set the priority for the desired IRQ */
+        /* The PRIn registers are byte accessible, one byte store per IRQ instead of a read-modify-write of the word */
+        NVIC_REGS->PRI[IRQ_Num] = (uint8)(IRQ_Priority << NVIC_IRQ_PRIORITY_BITS_POS);
     }
     else
     {
@@ -149,9 +107,9 @@ extern void NVIC_EnableException(NVIC_ExceptionType Exception_Num)
     case EXCEPTION_HARD_FAULT_TYPE    : break;
     case EXCEPTION_PEND_SV_TYPE       : break;
     case EXCEPTION_SYSTICK_TYPE       : break;
-    case EXCEPTION_BUS_FAULT_TYPE     : NVIC_SYSTEM_SYSHNDCTRL |= BUS_FAULT_ENABLE_MASK;   break;
-    case EXCEPTION_USAGE_FAULT_TYPE   : NVIC_SYSTEM_SYSHNDCTRL |= USAGE_FAULT_ENABLE_MASK; break;
-    case EXCEPTION_MEM_FAULT_TYPE     : NVIC_SYSTEM_SYSHNDCTRL |= MEM_FAULT_ENABLE_MASK;   break;
+    case EXCEPTION_BUS_FAULT_TYPE     : SCB_REGS->SYSHNDCTRL |= BUS_FAULT_ENABLE_MASK;   break;
+    case EXCEPTION_USAGE_FAULT_TYPE   : SCB_REGS->SYSHNDCTRL |= USAGE_FAULT_ENABLE_MASK; break;
+    case EXCEPTION_MEM_FAULT_TYPE     : SCB_REGS->SYSHNDCTRL |= MEM_FAULT_ENABLE_MASK;   break;
     case EXCEPTION_DEBUG_MONITOR_TYPE : break;
     default                           : break; /* Report an Error */
     }
@@ -177,9 +135,9 @@ extern void NVIC_DisableException(NVIC_ExceptionType Exception_Num)
     case EXCEPTION_HARD_FAULT_TYPE    : break;
     case EXCEPTION_PEND_SV_TYPE       : break;
     case EXCEPTION_SYSTICK_TYPE       : break;
-    case EXCEPTION_BUS_FAULT_TYPE     : NVIC_SYSTEM_SYSHNDCTRL &= ~BUS_FAULT_ENABLE_MASK;   break;
-    case EXCEPTION_USAGE_FAULT_TYPE   : NVIC_SYSTEM_SYSHNDCTRL &= ~USAGE_FAULT_ENABLE_MASK; break;
-    case EXCEPTION_MEM_FAULT_TYPE     : NVIC_SYSTEM_SYSHNDCTRL &= ~MEM_FAULT_ENABLE_MASK;   break;
+    case EXCEPTION_BUS_FAULT_TYPE     : SCB_REGS->SYSHNDCTRL &= ~BUS_FAULT_ENABLE_MASK;   break;
+    case EXCEPTION_USAGE_FAULT_TYPE   : SCB_REGS->SYSHNDCTRL &= ~USAGE_FAULT_ENABLE_MASK; break;
+    case EXCEPTION_MEM_FAULT_TYPE     : SCB_REGS->SYSHNDCTRL &= ~MEM_FAULT_ENABLE_MASK;   break;
     case EXCEPTION_DEBUG_MONITOR_TYPE : break;
     default                           : break;
     }
@@ -199,13 +157,13 @@ extern void NVIC_SetPriorityException(NVIC_ExceptionType Exception_Num, NVIC_Exc
 {
     switch(Exception_Num)
     {
-    case EXCEPTION_SVC_TYPE           : NVIC_SYSTEM_PRI2_REG = (NVIC_SYSTEM_PRI2_REG & SVC_PRIORITY_MASK)           | (Exception_Priority << SVC_PRIORITY_BITS_POS);break;
-    case EXCEPTION_PEND_SV_TYPE       : NVIC_SYSTEM_PRI3_REG = (NVIC_SYSTEM_PRI3_REG & PENDSV_PRIORITY_MASK)        | (Exception_Priority << PENDSV_PRIORITY_BITS_POS);break;
-    case EXCEPTION_SYSTICK_TYPE       : NVIC_SYSTEM_PRI3_REG = (NVIC_SYSTEM_PRI3_REG & SYSTICK_PRIORITY_MASK)       | (Exception_Priority << SYSTICK_PRIORITY_BITS_POS);break;
-    case EXCEPTION_BUS_FAULT_TYPE     : NVIC_SYSTEM_PRI1_REG = (NVIC_SYSTEM_PRI1_REG & BUS_FAULT_PRIORITY_MASK)     | (Exception_Priority << BUS_FAULT_PRIORITY_BITS_POS);break;
-    case EXCEPTION_USAGE_FAULT_TYPE   : NVIC_SYSTEM_PRI1_REG = (NVIC_SYSTEM_PRI1_REG & USAGE_FAULT_PRIORITY_MASK)   | (Exception_Priority << USAGE_FAULT_PRIORITY_BITS_POS);break;
-    case EXCEPTION_MEM_FAULT_TYPE     : NVIC_SYSTEM_PRI1_REG = (NVIC_SYSTEM_PRI1_REG & MEM_FAULT_PRIORITY_MASK)     | (Exception_Priority << MEM_FAULT_PRIORITY_BITS_POS);break;
-    case EXCEPTION_DEBUG_MONITOR_TYPE : NVIC_SYSTEM_PRI3_REG = (NVIC_SYSTEM_PRI3_REG & DEBUG_MONITOR_PRIORITY_MASK) | (Exception_Priority << DEBUG_MONITOR_PRIORITY_BITS_POS);break;
+    case EXCEPTION_SVC_TYPE           : SCB_REGS->SYSPRI[SVC_SYSPRI_INDEX]           = (uint8)(Exception_Priority << NVIC_IRQ_PRIORITY_BITS_POS); break;
+    case EXCEPTION_PEND_SV_TYPE       : SCB_REGS->SYSPRI[PENDSV_SYSPRI_INDEX]        = (uint8)(Exception_Priority << NVIC_IRQ_PRIORITY_BITS_POS); break;
+    case EXCEPTION_SYSTICK_TYPE       : SCB_REGS->SYSPRI[SYSTICK_SYSPRI_INDEX]       = (uint8)(Exception_Priority << NVIC_IRQ_PRIORITY_BITS_POS); break;
+    case EXCEPTION_BUS_FAULT_TYPE     : SCB_REGS->SYSPRI[BUS_FAULT_SYSPRI_INDEX]     = (uint8)(Exception_Priority << NVIC_IRQ_PRIORITY_BITS_POS); break;
+    case EXCEPTION_USAGE_FAULT_TYPE   : SCB_REGS->SYSPRI[USAGE_FAULT_SYSPRI_INDEX]   = (uint8)(Exception_Priority << NVIC_IRQ_PRIORITY_BITS_POS); break;
+    case EXCEPTION_MEM_FAULT_TYPE     : SCB_REGS->SYSPRI[MEM_FAULT_SYSPRI_INDEX]     = (uint8)(Exception_Priority << NVIC_IRQ_PRIORITY_BITS_POS); break;
+    case EXCEPTION_DEBUG_MONITOR_TYPE : SCB_REGS->SYSPRI[DEBUG_MONITOR_SYSPRI_INDEX] = (uint8)(Exception_Priority << NVIC_IRQ_PRIORITY_BITS_POS); break;
     default                           : break;
     }
 }
@@ -17,31 +17,50 @@
  *                                Inclusions                                   *
  *******************************************************************************/
 #include "std_types.h"
+#include "DEVICE.h"
 
 /*******************************************************************************
  *                           Preprocessor Definitions                          *
  *******************************************************************************/
 
-#define MEM_FAULT_PRIORITY_MASK              0x000000E0
-#define MEM_FAULT_PRIORITY_BITS_POS          5
+#define NVIC_IRQ_PRIORITY_BITS_POS           (8 - DEVICE_PRIORITY_BITS)  /* Implemented upper bits of each PRIn byte */
+#define NVIC_MAX_PRIORITY                    ((1 << DEVICE_PRIORITY_BITS) - 1)
 
-#define BUS_FAULT_PRIORITY_MASK              0x0000E000
-#define BUS_FAULT_PRIORITY_BITS_POS          13
+#define MEM_FAULT_PRIORITY_BITS_POS          (NVIC_IRQ_PRIORITY_BITS_POS)
+#define MEM_FAULT_PRIORITY_MASK              ((uint32)NVIC_MAX_PRIORITY << MEM_FAULT_PRIORITY_BITS_POS)
 
-#define USAGE_FAULT_PRIORITY_MASK            0x00E00000
-#define USAGE_FAULT_PRIORITY_BITS_POS        21
+#define BUS_FAULT_PRIORITY_BITS_POS          (8 + NVIC_IRQ_PRIORITY_BITS_POS)
+#define BUS_FAULT_PRIORITY_MASK              ((uint32)NVIC_MAX_PRIORITY << BUS_FAULT_PRIORITY_BITS_POS)
 
-#define SVC_PRIORITY_MASK                    0xE0000000
-#define SVC_PRIORITY_BITS_POS                29
+#define USAGE_FAULT_PRIORITY_BITS_POS        (16 + NVIC_IRQ_PRIORITY_BITS_POS)
+#define USAGE_FAULT_PRIORITY_MASK            ((uint32)NVIC_MAX_PRIORITY << USAGE_FAULT_PRIORITY_BITS_POS)
 
-#define DEBUG_MONITOR_PRIORITY_MASK          0x000000E0
-#define DEBUG_MONITOR_PRIORITY_BITS_POS      5
+#define SVC_PRIORITY_BITS_POS                (24 + NVIC_IRQ_PRIORITY_BITS_POS)
+#define SVC_PRIORITY_MASK                    ((uint32)NVIC_MAX_PRIORITY << SVC_PRIORITY_BITS_POS)
 
-#define PENDSV_PRIORITY_MASK                 0x00E00000
-#define PENDSV_PRIORITY_BITS_POS             21
+#define DEBUG_MONITOR_PRIORITY_BITS_POS      (NVIC_IRQ_PRIORITY_BITS_POS)
+#define DEBUG_MONITOR_PRIORITY_MASK          ((uint32)NVIC_MAX_PRIORITY << DEBUG_MONITOR_PRIORITY_BITS_POS)
 
-#define SYSTICK_PRIORITY_MASK                0xE0000000
-#define SYSTICK_PRIORITY_BITS_POS            29
+#define PENDSV_PRIORITY_BITS_POS             (16 + NVIC_IRQ_PRIORITY_BITS_POS)
+#define PENDSV_PRIORITY_MASK                 ((uint32)NVIC_MAX_PRIORITY << PENDSV_PRIORITY_BITS_POS)
+
+#define SYSTICK_PRIORITY_BITS_POS            (24 + NVIC_IRQ_PRIORITY_BITS_POS)
+#define SYSTICK_PRIORITY_MASK                ((uint32)NVIC_MAX_PRIORITY << SYSTICK_PRIORITY_BITS_POS)
+
+#define NVIC_MAX_IRQ_NUM                     (NVIC_IRQ_COUNT - 1)
+#define NVIC_IRQ_EXCEPTION_BASE              16          /* Exception number of IRQ 0 */
+#define NVIC_EXCEPTIONS                      (NVIC_IRQ_EXCEPTION_BASE + NVIC_IRQ_COUNT)
+#define NVIC_IRQ_BANK_BITS                   32          /* IRQs per ENn / DISn register */
+#define NVIC_IRQ_BANKS                       ((DEVICE_IRQ_COUNT + NVIC_IRQ_BANK_BITS - 1) / NVIC_IRQ_BANK_BITS)
+
+/* Index of the system exceptions in the byte accessible SYSPRI1..3 registers (exception number - 4) */
+#define MEM_FAULT_SYSPRI_INDEX               0
+#define BUS_FAULT_SYSPRI_INDEX               1
+#define USAGE_FAULT_SYSPRI_INDEX             2
+#define SVC_SYSPRI_INDEX                     7
+#define DEBUG_MONITOR_SYSPRI_INDEX           8
+#define PENDSV_SYSPRI_INDEX                  10
+#define SYSTICK_SYSPRI_INDEX                 11
 
 #define MEM_FAULT_ENABLE_MASK                0x00010000
 #define BUS_FAULT_ENABLE_MASK                0x00020000
@@ -64,11 +83,23 @@
 /* Disable Faults ... This Macro disable Faults by setting the F-bit in the FAULTMASK */
 #define Disable_Faults()       __asm(" CPSID F ")
 
+/* Enter Critical Section ... This Macro disable IRQ interrupts and returns the previous PRIMASK value, usable from thread and handler mode */
+#define Enter_Critical()       _disable_interrupts()
+
+/* Exit Critical Section ... This Macro restore the PRIMASK value returned by Enter_Critical() */
+#define Exit_Critical(State)   _restore_interrupts(State)
+
 
 /*******************************************************************************
  *                           Data Types Declarations                           *
  *******************************************************************************/
-typedef uint8 NVIC_IRQType;
+#define NVIC_IRQ(Num, Name, Handler, Description)   NVIC_IRQ_##Name = (Num),
+typedef enum
+{
+#include "NVIC_IRQS.h"
+    NVIC_IRQ_COUNT                        /* Last IRQ + 1, NVIC_IRQS.h is in increasing order */
+}NVIC_IRQType;
+#undef NVIC_IRQ
 
 typedef uint8 NVIC_IRQPriorityType;
 
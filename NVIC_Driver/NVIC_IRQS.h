@@ -0,0 +1,158 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_IRQS.h
+ *
+ * Description: Interrupt sources of the device, the single description of the IRQ numbers.
+ *              Included by NVIC.h to build NVIC_IRQType and the range constants, by the startup file
+ *              to build the vector table and the weak default handlers, and by tools/irq_table.c.
+ *              Keep the numbers in increasing order, the missing numbers are reserved vectors and the
+ *              IRQs of the peripherals DEVICE.h does not list for the selected part are left out.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include "DEVICE.h"
+
+/* No include guard, each user defines NVIC_IRQ(Num, Name, Handler, Description) before including this file.
+ * Name makes NVIC_IRQ_<Name>, Handler is the vector symbol an application defines to take the IRQ over. */
+
+NVIC_IRQ(  0, GPIO_PORTA,     GPIOPortA_Handler,     "GPIO Port A")
+NVIC_IRQ(  1, GPIO_PORTB,     GPIOPortB_Handler,     "GPIO Port B")
+NVIC_IRQ(  2, GPIO_PORTC,     GPIOPortC_Handler,     "GPIO Port C")
+NVIC_IRQ(  3, GPIO_PORTD,     GPIOPortD_Handler,     "GPIO Port D")
+NVIC_IRQ(  4, GPIO_PORTE,     GPIOPortE_Handler,     "GPIO Port E")
+NVIC_IRQ(  5, UART0,          UART0_Handler,         "UART0 Rx and Tx")
+NVIC_IRQ(  6, UART1,          UART1_Handler,         "UART1 Rx and Tx")
+NVIC_IRQ(  7, SSI0,           SSI0_Handler,          "SSI0 Rx and Tx")
+NVIC_IRQ(  8, I2C0,           I2C0_Handler,          "I2C0 Master and Slave")
+NVIC_IRQ(  9, PWM0_FAULT,     PWM0Fault_Handler,     "PWM Fault")
+NVIC_IRQ( 10, PWM0_GEN0,      PWM0Gen0_Handler,      "PWM Generator 0")
+NVIC_IRQ( 11, PWM0_GEN1,      PWM0Gen1_Handler,      "PWM Generator 1")
+NVIC_IRQ( 12, PWM0_GEN2,      PWM0Gen2_Handler,      "PWM Generator 2")
+NVIC_IRQ( 13, QEI0,           QEI0_Handler,          "Quadrature Encoder 0")
+NVIC_IRQ( 14, ADC0_SS0,       ADC0Seq0_Handler,      "ADC Sequence 0")
+NVIC_IRQ( 15, ADC0_SS1,       ADC0Seq1_Handler,      "ADC Sequence 1")
+NVIC_IRQ( 16, ADC0_SS2,       ADC0Seq2_Handler,      "ADC Sequence 2")
+NVIC_IRQ( 17, ADC0_SS3,       ADC0Seq3_Handler,      "ADC Sequence 3")
+NVIC_IRQ( 18, WATCHDOG,       Watchdog_Handler,      "Watchdog timer")
+NVIC_IRQ( 19, TIMER0A,        Timer0A_Handler,       "Timer 0 subtimer A")
+NVIC_IRQ( 20, TIMER0B,        Timer0B_Handler,       "Timer 0 subtimer B")
+NVIC_IRQ( 21, TIMER1A,        Timer1A_Handler,       "Timer 1 subtimer A")
+NVIC_IRQ( 22, TIMER1B,        Timer1B_Handler,       "Timer 1 subtimer B")
+NVIC_IRQ( 23, TIMER2A,        Timer2A_Handler,       "Timer 2 subtimer A")
+NVIC_IRQ( 24, TIMER2B,        Timer2B_Handler,       "Timer 2 subtimer B")
+NVIC_IRQ( 25, COMP0,          Comparator0_Handler,   "Analog Comparator 0")
+NVIC_IRQ( 26, COMP1,          Comparator1_Handler,   "Analog Comparator 1")
+#if (DEVICE_COMPARATORS > 2)
+NVIC_IRQ( 27, COMP2,          Comparator2_Handler,   "Analog Comparator 2")
+#endif
+NVIC_IRQ( 28, SYSCTL,         SysCtl_Handler,        "System Control (PLL, OSC, BO)")
+NVIC_IRQ( 29, FLASH,          Flash_Handler,         "FLASH Control")
+NVIC_IRQ( 30, GPIO_PORTF,     GPIOPortF_Handler,     "GPIO Port F")
+#if (DEVICE_GPIO_PORTS > 6)
+NVIC_IRQ( 31, GPIO_PORTG,     GPIOPortG_Handler,     "GPIO Port G")
+#endif
+#if (DEVICE_GPIO_PORTS > 7)
+NVIC_IRQ( 32, GPIO_PORTH,     GPIOPortH_Handler,     "GPIO Port H")
+#endif
+NVIC_IRQ( 33, UART2,          UART2_Handler,         "UART2 Rx and Tx")
+NVIC_IRQ( 34, SSI1,           SSI1_Handler,          "SSI1 Rx and Tx")
+NVIC_IRQ( 35, TIMER3A,        Timer3A_Handler,       "Timer 3 subtimer A")
+NVIC_IRQ( 36, TIMER3B,        Timer3B_Handler,       "Timer 3 subtimer B")
+NVIC_IRQ( 37, I2C1,           I2C1_Handler,          "I2C1 Master and Slave")
+NVIC_IRQ( 38, QEI1,           QEI1_Handler,          "Quadrature Encoder 1")
+NVIC_IRQ( 39, CAN0,           CAN0_Handler,          "CAN0")
+NVIC_IRQ( 40, CAN1,           CAN1_Handler,          "CAN1")
+NVIC_IRQ( 43, HIBERNATE,      Hibernate_Handler,     "Hibernate")
+NVIC_IRQ( 44, USB0,           USB0_Handler,          "USB0")
+NVIC_IRQ( 45, PWM0_GEN3,      PWM0Gen3_Handler,      "PWM Generator 3")
+NVIC_IRQ( 46, UDMA_SOFTWARE,  UDMASoftware_Handler,  "uDMA Software Transfer")
+NVIC_IRQ( 47, UDMA_ERROR,     UDMAError_Handler,     "uDMA Error")
+NVIC_IRQ( 48, ADC1_SS0,       ADC1Seq0_Handler,      "ADC1 Sequence 0")
+NVIC_IRQ( 49, ADC1_SS1,       ADC1Seq1_Handler,      "ADC1 Sequence 1")
+NVIC_IRQ( 50, ADC1_SS2,       ADC1Seq2_Handler,      "ADC1 Sequence 2")
+NVIC_IRQ( 51, ADC1_SS3,       ADC1Seq3_Handler,      "ADC1 Sequence 3")
+#if (DEVICE_GPIO_PORTS > 8)
+NVIC_IRQ( 54, GPIO_PORTJ,     GPIOPortJ_Handler,     "GPIO Port J")
+#endif
+#if (DEVICE_GPIO_PORTS > 9)
+NVIC_IRQ( 55, GPIO_PORTK,     GPIOPortK_Handler,     "GPIO Port K")
+#endif
+#if (DEVICE_GPIO_PORTS > 10)
+NVIC_IRQ( 56, GPIO_PORTL,     GPIOPortL_Handler,     "GPIO Port L")
+#endif
+NVIC_IRQ( 57, SSI2,           SSI2_Handler,          "SSI2 Rx and Tx")
+NVIC_IRQ( 58, SSI3,           SSI3_Handler,          "SSI3 Rx and Tx")
+NVIC_IRQ( 59, UART3,          UART3_Handler,         "UART3 Rx and Tx")
+NVIC_IRQ( 60, UART4,          UART4_Handler,         "UART4 Rx and Tx")
+NVIC_IRQ( 61, UART5,          UART5_Handler,         "UART5 Rx and Tx")
+NVIC_IRQ( 62, UART6,          UART6_Handler,         "UART6 Rx and Tx")
+NVIC_IRQ( 63, UART7,          UART7_Handler,         "UART7 Rx and Tx")
+NVIC_IRQ( 68, I2C2,           I2C2_Handler,          "I2C2 Master and Slave")
+NVIC_IRQ( 69, I2C3,           I2C3_Handler,          "I2C3 Master and Slave")
+NVIC_IRQ( 70, TIMER4A,        Timer4A_Handler,       "Timer 4 subtimer A")
+NVIC_IRQ( 71, TIMER4B,        Timer4B_Handler,       "Timer 4 subtimer B")
+NVIC_IRQ( 92, TIMER5A,        Timer5A_Handler,       "Timer 5 subtimer A")
+NVIC_IRQ( 93, TIMER5B,        Timer5B_Handler,       "Timer 5 subtimer B")
+NVIC_IRQ( 94, WTIMER0A,       WideTimer0A_Handler,   "Wide Timer 0 subtimer A")
+NVIC_IRQ( 95, WTIMER0B,       WideTimer0B_Handler,   "Wide Timer 0 subtimer B")
+NVIC_IRQ( 96, WTIMER1A,       WideTimer1A_Handler,   "Wide Timer 1 subtimer A")
+NVIC_IRQ( 97, WTIMER1B,       WideTimer1B_Handler,   "Wide Timer 1 subtimer B")
+NVIC_IRQ( 98, WTIMER2A,       WideTimer2A_Handler,   "Wide Timer 2 subtimer A")
+NVIC_IRQ( 99, WTIMER2B,       WideTimer2B_Handler,   "Wide Timer 2 subtimer B")
+NVIC_IRQ(100, WTIMER3A,       WideTimer3A_Handler,   "Wide Timer 3 subtimer A")
+NVIC_IRQ(101, WTIMER3B,       WideTimer3B_Handler,   "Wide Timer 3 subtimer B")
+NVIC_IRQ(102, WTIMER4A,       WideTimer4A_Handler,   "Wide Timer 4 subtimer A")
+NVIC_IRQ(103, WTIMER4B,       WideTimer4B_Handler,   "Wide Timer 4 subtimer B")
+NVIC_IRQ(104, WTIMER5A,       WideTimer5A_Handler,   "Wide Timer 5 subtimer A")
+NVIC_IRQ(105, WTIMER5B,       WideTimer5B_Handler,   "Wide Timer 5 subtimer B")
+NVIC_IRQ(106, FPU,            FPU_Handler,           "FPU")
+#if (DEVICE_I2CS > 4)
+NVIC_IRQ(109, I2C4,           I2C4_Handler,          "I2C4 Master and Slave")
+#endif
+#if (DEVICE_I2CS > 5)
+NVIC_IRQ(110, I2C5,           I2C5_Handler,          "I2C5 Master and Slave")
+#endif
+#if (DEVICE_GPIO_PORTS > 11)
+NVIC_IRQ(111, GPIO_PORTM,     GPIOPortM_Handler,     "GPIO Port M")
+#endif
+#if (DEVICE_GPIO_PORTS > 12)
+NVIC_IRQ(112, GPIO_PORTN,     GPIOPortN_Handler,     "GPIO Port N")
+#endif
+#if (DEVICE_QEIS > 2)
+NVIC_IRQ(113, QEI2,           QEI2_Handler,          "Quadrature Encoder 2")
+#endif
+#if (DEVICE_GPIO_PORTS > 13)
+NVIC_IRQ(116, GPIO_PORTP,     GPIOPortP_Handler,     "GPIO Port P (Summary or P0)")
+NVIC_IRQ(117, GPIO_PORTP1,    GPIOPortP1_Handler,    "GPIO Port P1")
+NVIC_IRQ(118, GPIO_PORTP2,    GPIOPortP2_Handler,    "GPIO Port P2")
+NVIC_IRQ(119, GPIO_PORTP3,    GPIOPortP3_Handler,    "GPIO Port P3")
+NVIC_IRQ(120, GPIO_PORTP4,    GPIOPortP4_Handler,    "GPIO Port P4")
+NVIC_IRQ(121, GPIO_PORTP5,    GPIOPortP5_Handler,    "GPIO Port P5")
+NVIC_IRQ(122, GPIO_PORTP6,    GPIOPortP6_Handler,    "GPIO Port P6")
+NVIC_IRQ(123, GPIO_PORTP7,    GPIOPortP7_Handler,    "GPIO Port P7")
+#endif
+#if (DEVICE_GPIO_PORTS > 14)
+NVIC_IRQ(124, GPIO_PORTQ,     GPIOPortQ_Handler,     "GPIO Port Q (Summary or Q0)")
+NVIC_IRQ(125, GPIO_PORTQ1,    GPIOPortQ1_Handler,    "GPIO Port Q1")
+NVIC_IRQ(126, GPIO_PORTQ2,    GPIOPortQ2_Handler,    "GPIO Port Q2")
+NVIC_IRQ(127, GPIO_PORTQ3,    GPIOPortQ3_Handler,    "GPIO Port Q3")
+NVIC_IRQ(128, GPIO_PORTQ4,    GPIOPortQ4_Handler,    "GPIO Port Q4")
+NVIC_IRQ(129, GPIO_PORTQ5,    GPIOPortQ5_Handler,    "GPIO Port Q5")
+NVIC_IRQ(130, GPIO_PORTQ6,    GPIOPortQ6_Handler,    "GPIO Port Q6")
+NVIC_IRQ(131, GPIO_PORTQ7,    GPIOPortQ7_Handler,    "GPIO Port Q7")
+#endif
+#if (DEVICE_GPIO_PORTS > 15)
+NVIC_IRQ(132, GPIO_PORTR,     GPIOPortR_Handler,     "GPIO Port R")
+#endif
+#if (DEVICE_GPIO_PORTS > 16)
+NVIC_IRQ(133, GPIO_PORTS,     GPIOPortS_Handler,     "GPIO Port S")
+#endif
+NVIC_IRQ(134, PWM1_GEN0,      PWM1Gen0_Handler,      "PWM 1 Generator 0")
+NVIC_IRQ(135, PWM1_GEN1,      PWM1Gen1_Handler,      "PWM 1 Generator 1")
+NVIC_IRQ(136, PWM1_GEN2,      PWM1Gen2_Handler,      "PWM 1 Generator 2")
+NVIC_IRQ(137, PWM1_GEN3,      PWM1Gen3_Handler,      "PWM 1 Generator 3")
+NVIC_IRQ(138, PWM1_FAULT,     PWM1Fault_Handler,     "PWM 1 Fault")
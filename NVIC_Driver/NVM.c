@@ -0,0 +1,454 @@
+/*
+ * NVM.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ *
+ *  Log structured store. The region is split in NVM_SECTORS erase blocks, only one of them is
+ *  active. Records are appended to the active sector:
+ *
+ *      | header: Key(16) Words(8) Tag(8) | data[Words] | commit: checksum |
+ *
+ *  A record is valid only once its checksum word is programmed, so a power failure in the
+ *  middle of a write leaves the previous version of the key in place. When the active sector
+ *  is full, the live records are copied to the next sector (round robin, which levels the
+ *  erase cycles) and the new sector is committed with a higher sequence number.
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "tm4c123gh6pm_registers.h"
+#include "NVM.h"
+
+#define NVM_SECTOR(Index)           ((const volatile uint32 *)(NVM_BASE_ADDRESS + ((Index) * NVM_SECTOR_SIZE)))
+#define NVM_RECORD_HEADER(Key, Words)   (((uint32)(Key) << 16) | ((uint32)(Words) << 8) | NVM_RECORD_TAG)
+#define NVM_RECORD_KEY(Header)      ((Nvm_KeyType)((Header) >> 16))
+#define NVM_RECORD_WORDS(Header)    ((uint8)((Header) >> 8))
+#define NVM_RECORD_TAG_OF(Header)   ((uint8)(Header))
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+typedef struct
+{
+    Nvm_KeyType Key;
+    uint16 Offset;                        /* Word offset of the record header in the active sector */
+}Nvm_IndexEntryType;
+
+static Nvm_IndexEntryType Nvm_Index[NVM_MAX_KEYS];
+static uint8  Nvm_IndexCount = 0;
+static uint32 Nvm_ActiveSector = 0;
+static uint32 Nvm_Sequence = 0;
+static uint32 Nvm_WriteOffset = NVM_SECTOR_WORDS;
+static uint32 Nvm_FaultSequence = 0;
+static uint8  Nvm_FaultSlot = 0;
+
+/*******************************************************************************
+ *                       Private Functions Definitions                         *
+ *******************************************************************************/
+
+static uint32 Nvm_GetWriteKey(void)
+{
+    return (0 != (FLASH_BOOTCFG_REG & NVM_BOOTCFG_KEY_MASK)) ? NVM_FMC_WRKEY_BOOTCFG : NVM_FMC_WRKEY_DEFAULT;
+}
+
+/* Checksum used as commit word, never equal to the erased value */
+static uint32 Nvm_Checksum(uint32 a_Header, const volatile uint32 *a_Data, uint8 a_Words)
+{
+    uint32 Sum = a_Header;
+    uint8 Index;
+
+    for(Index = 0; Index < a_Words; Index++)
+    {
+        Sum = ((Sum << 5) | (Sum >> 27)) ^ a_Data[Index];
+    }
+    Sum ^= 0xA5A5A5A5;
+    return (Sum == NVM_ERASED_WORD) ? 0 : Sum;
+}
+
+static void Nvm_EraseSector(uint32 a_Sector)
+{
+    FLASH_FMA_REG = (uint32)NVM_SECTOR(a_Sector);
+    FLASH_FMC_REG = Nvm_GetWriteKey() | NVM_FMC_ERASE_MASK;
+    while(0 != (FLASH_FMC_REG & NVM_FMC_ERASE_MASK))
+    {
+        /* Wait for the erase to complete */
+    }
+}
+
+/* Program words through the 32-word write buffer, one buffer operation per 128 bytes aligned block */
+static void Nvm_ProgramWords(uint32 a_Address, const uint32 *a_Data, uint32 a_Words)
+{
+    volatile uint32 *WriteBuffer = &FLASH_FWBN_REG;
+    uint32 Key = Nvm_GetWriteKey();
+
+    while(a_Words != 0)
+    {
+        uint32 Block  = a_Address & ~((NVM_FWB_WORDS * 4) - 1);
+        uint32 Offset = (a_Address - Block) / 4;
+        uint32 Chunk  = NVM_FWB_WORDS - Offset;
+        uint32 Index;
+
+        if(Chunk > a_Words)
+        {
+            Chunk = a_Words;
+        }
+
+        FLASH_FMA_REG = Block;
+        for(Index = 0; Index < Chunk; Index++)
+        {
+            WriteBuffer[Offset + Index] = a_Data[Index]; /* Sets the matching FWBVAL bit */
+        }
+        FLASH_FMC2_REG = Key | NVM_FMC2_WRBUF_MASK;
+        while(0 != (FLASH_FMC2_REG & NVM_FMC2_WRBUF_MASK))
+        {
+            /* Wait for the buffered write to complete */
+        }
+
+        a_Address += Chunk * 4;
+        a_Data    += Chunk;
+        a_Words   -= Chunk;
+    }
+}
+
+static void Nvm_IndexUpdate(Nvm_KeyType a_Key, uint16 a_Offset)
+{
+    uint8 Index;
+
+    for(Index = 0; Index < Nvm_IndexCount; Index++)
+    {
+        if(Nvm_Index[Index].Key == a_Key)
+        {
+            Nvm_Index[Index].Offset = a_Offset;
+            return;
+        }
+    }
+    if(Nvm_IndexCount < NVM_MAX_KEYS)
+    {
+        Nvm_Index[Nvm_IndexCount].Key    = a_Key;
+        Nvm_Index[Nvm_IndexCount].Offset = a_Offset;
+        Nvm_IndexCount++;
+    }
+    else
+    {
+        /* Report an Error, the key can not be indexed */
+    }
+}
+
+static sint32 Nvm_IndexFind(Nvm_KeyType a_Key)
+{
+    uint8 Index;
+
+    for(Index = 0; Index < Nvm_IndexCount; Index++)
+    {
+        if(Nvm_Index[Index].Key == a_Key)
+        {
+            return Index;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Walk the records of the active sector once and index the latest committed version of
+ * every key. Records are skipped by their length, the walk stops at the first erased word.
+ */
+static void Nvm_ScanActiveSector(void)
+{
+    const volatile uint32 *Sector = NVM_SECTOR(Nvm_ActiveSector);
+    uint32 Offset = NVM_SECTOR_HEADER_WORDS;
+
+    Nvm_IndexCount = 0;
+    while(Offset < NVM_SECTOR_WORDS)
+    {
+        uint32 Header = Sector[Offset];
+        uint8 Words   = NVM_RECORD_WORDS(Header);
+
+        if(Header == NVM_ERASED_WORD)
+        {
+            break; /* End of the log */
+        }
+        if((NVM_RECORD_TAG_OF(Header) != NVM_RECORD_TAG) || (Words > NVM_MAX_RECORD_WORDS) ||
+           ((Offset + Words + 2) > NVM_SECTOR_WORDS))
+        {
+            Offset = NVM_SECTOR_WORDS; /* Torn header, the next write compacts to a fresh sector */
+            break;
+        }
+        if(Sector[Offset + 1 + Words] == Nvm_Checksum(Header, &Sector[Offset + 1], Words))
+        {
+            Nvm_IndexUpdate(NVM_RECORD_KEY(Header), (uint16)Offset);
+        }
+        else
+        {
+            /* Interrupted write, the record is ignored */
+        }
+        Offset += Words + 2;
+    }
+    Nvm_WriteOffset = Offset;
+}
+
+/*
+ * Start a new sector with a higher sequence number and copy the live records into it. a_Reserve words
+ * must be left free after the copy, nothing is erased when they would not be. The index keeps pointing
+ * into the old sector until the new one is committed, a failure leaves the store as it was.
+ */
+static boolean Nvm_Compact(uint32 a_Reserve)
+{
+    const volatile uint32 *Old = NVM_SECTOR(Nvm_ActiveSector);
+    uint32 Next = (Nvm_ActiveSector + 1) % NVM_SECTORS;
+    const volatile uint32 *New = NVM_SECTOR(Next);
+    uint32 Header[NVM_SECTOR_HEADER_WORDS - 1];
+    uint32 Record[NVM_MAX_RECORD_WORDS + 2];
+    uint16 Offsets[NVM_MAX_KEYS];
+    uint32 Offset = NVM_SECTOR_HEADER_WORDS;
+    uint32 Committed = NVM_SECTOR_COMMITTED;
+    uint8 Index;
+
+    /* Layout of the new sector */
+    for(Index = 0; Index < Nvm_IndexCount; Index++)
+    {
+        Offsets[Index] = (uint16)Offset;
+        Offset += NVM_RECORD_WORDS(Old[Nvm_Index[Index].Offset]) + 2;
+    }
+    if((Offset + a_Reserve) > NVM_SECTOR_WORDS)
+    {
+        return FALSE; /* Report an Error, live data does not fit, the next sector is left untouched */
+    }
+
+    Header[0] = NVM_SECTOR_MAGIC;
+    Header[1] = Nvm_Sequence + 1;
+    Header[2] = (New[0] == NVM_SECTOR_MAGIC) ? (New[2] + 1) : 1; /* Erase count of the sector */
+
+    Nvm_EraseSector(Next);
+    Nvm_ProgramWords((uint32)New, Header, NVM_SECTOR_HEADER_WORDS - 1);
+
+    for(Index = 0; Index < Nvm_IndexCount; Index++)
+    {
+        uint32 Words = NVM_RECORD_WORDS(Old[Nvm_Index[Index].Offset]) + 2;
+        uint32 Word;
+
+        for(Word = 0; Word < Words; Word++)
+        {
+            Record[Word] = Old[Nvm_Index[Index].Offset + Word];
+        }
+        Nvm_ProgramWords((uint32)&New[Offsets[Index]], Record, Words);
+    }
+
+    /* The new sector becomes the active one only once this word is programmed */
+    Nvm_ProgramWords((uint32)&New[NVM_SECTOR_HEADER_WORDS - 1], &Committed, 1);
+
+    for(Index = 0; Index < Nvm_IndexCount; Index++)
+    {
+        Nvm_Index[Index].Offset = Offsets[Index];
+    }
+    Nvm_ActiveSector = Next;
+    Nvm_Sequence     = Header[1];
+    Nvm_WriteOffset  = Offset;
+    return TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : Nvm_Init
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Select the committed sector with the highest sequence number, a sector left without
+*                     commit word by a power failure during compaction is ignored. The store is formatted
+*                     when no sector is valid. Only the active sector is walked to build the index.
+**************************************************************************************/
+void Nvm_Init(void)
+{
+    boolean Found = FALSE;
+    uint32 Sector;
+    uint8 Slot;
+
+    for(Sector = 0; Sector < NVM_SECTORS; Sector++)
+    {
+        const volatile uint32 *Header = NVM_SECTOR(Sector);
+
+        if((Header[0] == NVM_SECTOR_MAGIC) && (Header[NVM_SECTOR_HEADER_WORDS - 1] == NVM_SECTOR_COMMITTED) &&
+           ((Found == FALSE) || ((sint32)(Header[1] - Nvm_Sequence) > 0)))
+        {
+            Nvm_ActiveSector = Sector;
+            Nvm_Sequence     = Header[1];
+            Found            = TRUE;
+        }
+    }
+
+    if(Found)
+    {
+        Nvm_ScanActiveSector();
+    }
+    else
+    {
+        /* Blank or corrupted region, format it by compacting an empty index into sector 0 */
+        Nvm_IndexCount   = 0;
+        Nvm_ActiveSector = NVM_SECTORS - 1;
+        Nvm_Sequence     = 0;
+        (void)Nvm_Compact(0);
+    }
+
+    /* Continue the fault log after its most recent entry */
+    Nvm_FaultSequence = 0;
+    Nvm_FaultSlot     = 0;
+    for(Slot = 0; Slot < NVM_FAULT_LOG_DEPTH; Slot++)
+    {
+        uint32 Sequence;
+        uint8 Words;
+
+        if(Nvm_Read(NVM_FAULT_KEY_BASE + Slot, &Sequence, 1, &Words) && (Sequence >= Nvm_FaultSequence))
+        {
+            Nvm_FaultSequence = Sequence + 1;
+            Nvm_FaultSlot     = (Slot + 1) % NVM_FAULT_LOG_DEPTH;
+        }
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Nvm_Write
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Key - Record key, a_Data - Record data, a_Words - Data size in words
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : TRUE when the record is committed to flash
+* Description       : Append a new version of a record, header and data are programmed first and the
+*                     checksum word last, so the previous version stays valid until the commit.
+**************************************************************************************/
+boolean Nvm_Write(Nvm_KeyType a_Key, const uint32 *a_Data, uint8 a_Words)
+{
+    const volatile uint32 *Sector;
+    uint32 Record[NVM_MAX_RECORD_WORDS + 1];
+    uint32 Commit;
+    uint8 Index;
+
+    if((a_Data == NULL_PTR) || (a_Words > NVM_MAX_RECORD_WORDS) ||
+       ((Nvm_IndexFind(a_Key) < 0) && (Nvm_IndexCount >= NVM_MAX_KEYS)))
+    {
+        return FALSE; /* Report an Error */
+    }
+
+    if((Nvm_WriteOffset + a_Words + 2) > NVM_SECTOR_WORDS)
+    {
+        if(Nvm_Compact((uint32)a_Words + 2) == FALSE)
+        {
+            return FALSE; /* Report an Error, store full */
+        }
+    }
+
+    Sector    = NVM_SECTOR(Nvm_ActiveSector);
+    Record[0] = NVM_RECORD_HEADER(a_Key, a_Words);
+    for(Index = 0; Index < a_Words; Index++)
+    {
+        Record[Index + 1] = a_Data[Index];
+    }
+    Nvm_ProgramWords((uint32)&Sector[Nvm_WriteOffset], Record, a_Words + 1);
+
+    Commit = Nvm_Checksum(Record[0], &Sector[Nvm_WriteOffset + 1], a_Words);
+    Nvm_ProgramWords((uint32)&Sector[Nvm_WriteOffset + 1 + a_Words], &Commit, 1);
+
+    Nvm_IndexUpdate(a_Key, (uint16)Nvm_WriteOffset);
+    Nvm_WriteOffset += a_Words + 2;
+    return TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : Nvm_Read
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Key - Record key, a_MaxWords - Size of a_Data
+* Parameters (inout): None
+* Parameters (out)  : a_Data - Record data, a_Words - Record size in words
+* Return value      : TRUE if the key exists
+* Description       : Read the latest committed version of a record through the RAM index
+**************************************************************************************/
+boolean Nvm_Read(Nvm_KeyType a_Key, uint32 *a_Data, uint8 a_MaxWords, uint8 *a_Words)
+{
+    const volatile uint32 *Record;
+    sint32 Entry = Nvm_IndexFind(a_Key);
+    uint8 Words;
+    uint8 Index;
+
+    if((Entry < 0) || (a_Data == NULL_PTR) || (a_Words == NULL_PTR))
+    {
+        return FALSE;
+    }
+
+    Record = &NVM_SECTOR(Nvm_ActiveSector)[Nvm_Index[Entry].Offset];
+    Words  = NVM_RECORD_WORDS(Record[0]);
+    for(Index = 0; (Index < Words) && (Index < a_MaxWords); Index++)
+    {
+        a_Data[Index] = Record[Index + 1];
+    }
+    *a_Words = Words;
+    return TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : Nvm_LogFault
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Data - Fault information, a_Words - Size in words
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : TRUE when the fault record is committed to flash
+* Description       : Store a fault record prefixed by a sequence number in the next fault log slot
+**************************************************************************************/
+boolean Nvm_LogFault(const uint32 *a_Data, uint8 a_Words)
+{
+    uint32 Record[NVM_MAX_RECORD_WORDS];
+    uint8 Index;
+
+    if((a_Data == NULL_PTR) || (a_Words >= NVM_MAX_RECORD_WORDS))
+    {
+        return FALSE; /* Report an Error */
+    }
+
+    Record[0] = Nvm_FaultSequence;
+    for(Index = 0; Index < a_Words; Index++)
+    {
+        Record[Index + 1] = a_Data[Index];
+    }
+    if(Nvm_Write(NVM_FAULT_KEY_BASE + Nvm_FaultSlot, Record, a_Words + 1) == FALSE)
+    {
+        return FALSE;
+    }
+    Nvm_FaultSequence++;
+    Nvm_FaultSlot = (Nvm_FaultSlot + 1) % NVM_FAULT_LOG_DEPTH;
+    return TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : Nvm_GetStats
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : a_Stats - Store usage and wear information
+* Return value      : None
+* Description       : Report the active sector, its usage and the erase count of every sector
+**************************************************************************************/
+void Nvm_GetStats(Nvm_StatsType *a_Stats)
+{
+    uint32 Sector;
+
+    if(a_Stats == NULL_PTR)
+    {
+        return; /* Report an Error */
+    }
+
+    a_Stats->ActiveSector = Nvm_ActiveSector;
+    a_Stats->Sequence     = Nvm_Sequence;
+    a_Stats->UsedWords    = Nvm_WriteOffset;
+    a_Stats->Keys         = Nvm_IndexCount;
+    for(Sector = 0; Sector < NVM_SECTORS; Sector++)
+    {
+        const volatile uint32 *Header = NVM_SECTOR(Sector);
+
+        a_Stats->EraseCount[Sector] = (Header[0] == NVM_SECTOR_MAGIC) ? Header[2] : 0;
+    }
+}
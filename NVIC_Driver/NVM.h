@@ -0,0 +1,112 @@
+/******************************************************************************
+ *
+ * Module: NVM
+ *
+ * File Name: NVM.h
+ *
+ * Description: Header file for the flash backed persistent key/value store and fault log
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef NVM_H_
+#define NVM_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "DEVICE.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Top of the flash, reserved in tm4c123.cmd, one sector per flash erase block */
+#define NVM_BASE_ADDRESS                  DEVICE_NVM_BASE
+#define NVM_SECTOR_SIZE                   DEVICE_FLASH_SECTOR_SIZE
+#define NVM_SECTORS                       (DEVICE_NVM_SIZE / DEVICE_FLASH_SECTOR_SIZE)
+#define NVM_SECTOR_WORDS                  (NVM_SECTOR_SIZE / 4)
+
+#define NVM_MAX_KEYS                      32     /* Entries of the RAM lookup index built by Nvm_Init */
+#define NVM_MAX_RECORD_WORDS              32
+
+#define NVM_FAULT_KEY_BASE                0xFF00 /* Keys NVM_FAULT_KEY_BASE .. + NVM_FAULT_LOG_DEPTH - 1 hold the fault log */
+#define NVM_FAULT_LOG_DEPTH               4
+
+#define NVM_SECTOR_MAGIC                  0x314D564E  /* "NVM1" */
+#define NVM_SECTOR_HEADER_WORDS           4           /* Magic, sequence, erase count, commit marker */
+#define NVM_SECTOR_COMMITTED              0x00000000
+#define NVM_RECORD_TAG                    0x5A
+#define NVM_ERASED_WORD                   0xFFFFFFFF
+
+/* Flash controller */
+#define NVM_FMC_WRKEY_BOOTCFG             0xA4420000  /* Key when BOOTCFG.KEY is set */
+#define NVM_FMC_WRKEY_DEFAULT             0x71D50000
+#define NVM_BOOTCFG_KEY_MASK              0x00000010
+#define NVM_FMC_WRITE_MASK                0x00000001
+#define NVM_FMC_ERASE_MASK                0x00000002
+#define NVM_FMC2_WRBUF_MASK               0x00000001
+#define NVM_FWB_WORDS                     32          /* Write buffer covers one 128 bytes aligned block */
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef uint16 Nvm_KeyType;
+
+typedef struct
+{
+    uint32 ActiveSector;
+    uint32 Sequence;                      /* Number of compactions since the store was formatted */
+    uint32 UsedWords;                     /* Words used in the active sector */
+    uint32 EraseCount[NVM_SECTORS];       /* Wear of each sector */
+    uint32 Keys;                          /* Live keys in the index */
+}Nvm_StatsType;
+
+
+/*************************************************************************************
+* Service Name   : Nvm_Init
+* Parameters (in): None
+* Description    : Find the active sector, recover from an interrupted compaction and build the lookup index
+**************************************************************************************/
+extern void Nvm_Init(void);
+
+/*************************************************************************************
+* Service Name   : Nvm_Write
+* Parameters (in): a_Key - Record key, a_Data - Record data, a_Words - Data size in words
+* Return value   : TRUE when the record is committed to flash
+* Description    : Append a new version of a record, the previous one stays valid until the commit word is written
+**************************************************************************************/
+extern boolean Nvm_Write(Nvm_KeyType a_Key, const uint32 *a_Data, uint8 a_Words);
+
+/*************************************************************************************
+* Service Name   : Nvm_Read
+* Parameters (in): a_Key - Record key, a_MaxWords - Size of a_Data
+* Parameters (out): a_Data - Record data, a_Words - Record size in words
+* Return value   : TRUE if the key exists
+* Description    : Read the latest committed version of a record through the RAM index
+**************************************************************************************/
+extern boolean Nvm_Read(Nvm_KeyType a_Key, uint32 *a_Data, uint8 a_MaxWords, uint8 *a_Words);
+
+/*************************************************************************************
+* Service Name   : Nvm_LogFault
+* Parameters (in): a_Data - Fault information, a_Words - Size in words
+* Return value   : TRUE when the fault record is committed to flash
+* Description    : Store a fault record in the NVM_FAULT_LOG_DEPTH entries fault log, the oldest entry is replaced
+**************************************************************************************/
+extern boolean Nvm_LogFault(const uint32 *a_Data, uint8 a_Words);
+
+/*************************************************************************************
+* Service Name   : Nvm_GetStats
+* Parameters (out): a_Stats - Store usage and wear information
+* Description    : Report the active sector, its usage and the erase count of every sector
+**************************************************************************************/
+extern void Nvm_GetStats(Nvm_StatsType *a_Stats);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVM_H_ */
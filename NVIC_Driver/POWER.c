@@ -0,0 +1,343 @@
+/*
+ * POWER.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "SYSTICK.h"
+#include "CLOCK.h"
+#include "POWER.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+/* Wall clock in POWER_TIME_BASE_HZ cycles, advanced by Power_Advance from the SysTick counts */
+static uint64 Power_WallCycles = 0;
+static uint32 Power_WallRemainder = 0;     /* Fraction of a cycle, in 1 / Power_RemainderHz */
+static uint32 Power_RemainderHz = 0;
+static uint32 Power_LastTicks = 0;         /* SysTick position of the last Power_Advance */
+static uint64 Power_LastPhase = 0;
+static uint32 Power_CountHz = CLOCK_RESET_HZ;      /* Rate of the SysTick counts while running */
+static uint32 Power_DeepSleepHz = CLOCK_RESET_HZ;  /* Rate of the SysTick counts in deep-sleep */
+static uint64 Power_StartCycles = 0;
+static uint64 Power_SleepCycles = 0;
+static uint64 Power_DeepSleepCycles = 0;
+static uint32 Power_SleepEntries = 0;
+static uint32 Power_DeepSleepEntries = 0;
+static uint32 Power_LastWakeLatency = 0;
+static uint32 Power_MaxWakeLatency = 0;
+
+/*******************************************************************************
+ *                       Private Functions Definitions                         *
+ *******************************************************************************/
+
+/*
+ * Add the SysTick counts since the last call to the wall clock, converted at a_Hz, the rate the
+ * counter ran at during that interval. The DWT cycle counter can not be used here because the core
+ * clock is gated while sleeping, SysTick keeps counting: at the core clock in sleep and at the
+ * DSLPCLKCFG clock in deep-sleep. Each interval is converted when it ends, a later RELOAD or clock
+ * change does not rescale the history. Called with the interrupts disabled.
+ */
+static uint64 Power_Advance(uint32 a_Hz)
+{
+    uint32 Reload;
+    uint32 Current;
+    uint32 Ticks;
+    uint64 Counts;
+    uint64 Scaled;
+    uint64 Cycles;
+
+    if(0 == (SYSTICK_CTRL_REG & SYSTICK_TIMER_ENABLE_MASK))
+    {
+        return 0; /* Counter stopped, no time is accounted */
+    }
+
+    Reload  = SYSTICK_RELOAD_REG;
+    Current = SYSTICK_CURRENT_REG;
+    Ticks   = SysTick_GetTickCount();
+    if(0 != (NVIC_SYSTEM_INTCTRL & SYSTICK_PENDING_MASK))
+    {
+        /* The counter wrapped but the handler did not run yet */
+        Current = SYSTICK_CURRENT_REG;
+        Ticks++;
+    }
+    if(Current == 0)
+    {
+        Current = Reload; /* At the wrap, or cleared by SysTick_Init: first count of the next period */
+    }
+
+    /* Modular tick difference, the wrap of the 32-bit tick count is harmless */
+    Counts = ((uint64)(uint32)(Ticks - Power_LastTicks) * (Reload + 1)) + (Reload - Current) - Power_LastPhase;
+    Power_LastTicks = Ticks;
+    Power_LastPhase = Reload - Current;
+
+    if((a_Hz != Power_RemainderHz) && (Power_RemainderHz != 0))
+    {
+        /* Keep the fraction of a cycle, in units of the new rate */
+        Power_WallRemainder = (uint32)(((uint64)Power_WallRemainder * a_Hz) / Power_RemainderHz);
+    }
+    Power_RemainderHz = a_Hz;
+    /* Counts * BASE / a_Hz split in whole seconds and the rest, no 64-bit overflow for long intervals */
+    Scaled = ((Counts % a_Hz) * POWER_TIME_BASE_HZ) + Power_WallRemainder;
+    Cycles = ((Counts / a_Hz) * POWER_TIME_BASE_HZ) + (Scaled / a_Hz);
+    Power_WallRemainder = (uint32)(Scaled % a_Hz);
+
+    Power_WallCycles += Cycles;
+    return Cycles;
+}
+
+/* Wall clock in POWER_TIME_BASE_HZ cycles, called with the interrupts disabled */
+static uint64 Power_GetWallCycles(void)
+{
+    (void)Power_Advance(Power_CountHz);
+    return Power_WallCycles;
+}
+
+/* Clock SysTick runs from in deep-sleep, from the DSOSCSRC and DSDIVORIDE fields of SYSCTL_DSLPCLKCFG_REG */
+static uint32 Power_DeepSleepClockHz(uint32 a_DeepSleepClockCfg)
+{
+    uint32 Hz;
+
+    switch(a_DeepSleepClockCfg & POWER_DSLPCLKCFG_DSOSCSRC_MASK)
+    {
+    case POWER_DSLPCLKCFG_PIOSC:
+        Hz = POWER_PIOSC_HZ;
+        break;
+    case POWER_DSLPCLKCFG_LFIOSC:
+        Hz = POWER_LFIOSC_HZ;
+        break;
+    case POWER_DSLPCLKCFG_32KHZ:
+        Hz = POWER_HIB_OSC_HZ;
+        break;
+    default:
+        Hz = CLOCK_MOSC_HZ;
+        break;
+    }
+    return Hz / (((a_DeepSleepClockCfg & POWER_DSLPCLKCFG_DSDIVORIDE_MASK) >> POWER_DSLPCLKCFG_DSDIVORIDE_BITS_POS) + 1);
+}
+
+/* Copy one set of clock gates to the SCGCx or DCGCx bank, a_WdReg is the first register (xCGCWD) of the bank */
+static void Power_WriteClockGates(volatile uint32 *a_WdReg, const Power_ClockGateType *a_Gates)
+{
+    a_WdReg[0]  = a_Gates->Watchdog;   /* xCGCWD     */
+    a_WdReg[1]  = a_Gates->Timer;      /* xCGCTIMER  */
+    a_WdReg[2]  = a_Gates->Gpio;       /* xCGCGPIO   */
+    a_WdReg[3]  = a_Gates->Dma;        /* xCGCDMA    */
+    a_WdReg[6]  = a_Gates->Uart;       /* xCGCUART   */
+    a_WdReg[7]  = a_Gates->Ssi;        /* xCGCSSI    */
+    a_WdReg[8]  = a_Gates->I2c;        /* xCGCI2C    */
+    a_WdReg[14] = a_Gates->Adc;        /* xCGCADC    */
+    a_WdReg[23] = a_Gates->WideTimer;  /* xCGCWTIMER */
+}
+
+/*************************************************************************************
+* Service Name      : Power_Init
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Config - Peripheral clocks to keep running in sleep and deep-sleep
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Enable automatic clock gating and program the sleep mode clock gates
+**************************************************************************************/
+void Power_Init(const Power_ConfigType *a_Config)
+{
+    uint32 State;
+
+    if(a_Config == NULL_PTR)
+    {
+        return; /* Report an Error */
+    }
+
+    Power_WriteClockGates(&SYSCTL_SCGCWD_REG, &a_Config->Sleep);
+    Power_WriteClockGates(&SYSCTL_DCGCWD_REG, &a_Config->DeepSleep);
+    SYSCTL_DSLPCLKCFG_REG = a_Config->DeepSleepClockCfg;
+    Power_DeepSleepHz     = Power_DeepSleepClockHz(a_Config->DeepSleepClockCfg);
+
+    /* Use the SCGCx/DCGCx registers instead of RCGCx while the core sleeps */
+    SYSCTL_RCC_REG |= POWER_RCC_ACG_MASK;
+
+    State = Enter_Critical();
+    Power_StartCycles      = Power_GetWallCycles();
+    Power_SleepCycles      = 0;
+    Power_DeepSleepCycles  = 0;
+    Power_SleepEntries     = 0;
+    Power_DeepSleepEntries = 0;
+    Power_LastWakeLatency  = 0;
+    Power_MaxWakeLatency   = 0;
+    Exit_Critical(State);
+}
+
+/*************************************************************************************
+* Service Name      : Power_SysTickRestart
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Called by SysTick_Init before the counter is reloaded, also after a core clock
+*                     change. The counts so far are accounted at the old rate, the next ones at the
+*                     current core clock from the cleared counter.
+**************************************************************************************/
+void Power_SysTickRestart(void)
+{
+    uint32 State;
+
+    State = Enter_Critical();
+    (void)Power_Advance(Power_CountHz);
+    Power_CountHz   = Clock_GetCoreClock();
+    Power_LastTicks = SysTick_GetTickCount();
+    Power_LastPhase = (uint64)0 - 1; /* The cleared counter reloads on its first count, phase 0 is one count later */
+    Exit_Critical(State);
+}
+
+/*************************************************************************************
+* Service Name      : Power_SetSleepOnExit
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Enable - TRUE to sleep as soon as the last handler returns to thread mode
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : For interrupt only designs, the core goes back to sleep after each handler
+*                     without returning to main(). The time is not accounted in this mode.
+**************************************************************************************/
+void Power_SetSleepOnExit(boolean a_Enable)
+{
+    if(a_Enable)
+    {
+        NVIC_SYSTEM_SYSCTRL |= POWER_SLEEP_ON_EXIT_MASK;
+    }
+    else
+    {
+        NVIC_SYSTEM_SYSCTRL &= ~POWER_SLEEP_ON_EXIT_MASK;
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Power_Idle
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Mode - POWER_MODE_SLEEP or POWER_MODE_DEEP_SLEEP
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Sleep in WFI until the next interrupt. WFI is executed with PRIMASK set, a pending
+*                     interrupt still wakes the core but its handler runs only after the time stamps are
+*                     taken, so the sleep time and the wake latency exclude the handler time. The PRIMASK
+*                     of the caller is restored, inside a critical section the handler runs at its end.
+**************************************************************************************/
+void Power_Idle(Power_ModeType a_Mode)
+{
+    uint32 Hz = Power_CountHz;
+    uint64 Cycles;
+    uint32 State;
+
+    if(a_Mode == POWER_MODE_RUN)
+    {
+        return;
+    }
+
+    State = Enter_Critical();
+    if(a_Mode == POWER_MODE_DEEP_SLEEP)
+    {
+        NVIC_SYSTEM_SYSCTRL |= POWER_SLEEP_DEEP_MASK;
+        Hz = Power_DeepSleepHz;
+    }
+    else
+    {
+        NVIC_SYSTEM_SYSCTRL &= ~POWER_SLEEP_DEEP_MASK;
+    }
+
+    (void)Power_Advance(Power_CountHz); /* Awake time up to here at the core clock */
+    __asm(" DSB");
+    __asm(" WFI");
+    Cycles = Power_Advance(Hz);         /* Time in WFI at the clock SysTick ran from */
+
+    if(0 != (NVIC_SYSTEM_INTCTRL & SYSTICK_PENDING_MASK))
+    {
+        /* Woken up by SysTick, the counts since it reached 0 are the wake up latency */
+        Power_LastWakeLatency = SYSTICK_CURRENT_REG;
+        Power_LastWakeLatency = (Power_LastWakeLatency != 0) ? (SYSTICK_RELOAD_REG - Power_LastWakeLatency + 1) : 0;
+        Power_LastWakeLatency = (uint32)(((uint64)Power_LastWakeLatency * POWER_TIME_BASE_HZ) / Hz);
+        if(Power_LastWakeLatency > Power_MaxWakeLatency)
+        {
+            Power_MaxWakeLatency = Power_LastWakeLatency;
+        }
+    }
+
+    if(a_Mode == POWER_MODE_DEEP_SLEEP)
+    {
+        NVIC_SYSTEM_SYSCTRL &= ~POWER_SLEEP_DEEP_MASK;
+        Power_DeepSleepCycles += Cycles;
+        Power_DeepSleepEntries++;
+    }
+    else
+    {
+        Power_SleepCycles += Cycles;
+        Power_SleepEntries++;
+    }
+    Exit_Critical(State); /* The waking interrupt is served here */
+}
+
+/*************************************************************************************
+* Service Name      : Power_GetStats
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : a_Stats - Time spent in each power mode and wake latency
+* Return value      : None
+* Description       : Report the energy accounting counters, run time is the remaining wall time
+**************************************************************************************/
+void Power_GetStats(Power_StatsType *a_Stats)
+{
+    uint32 State;
+
+    if(a_Stats == NULL_PTR)
+    {
+        return; /* Report an Error */
+    }
+
+    State = Enter_Critical();
+    a_Stats->SleepCycles           = Power_SleepCycles;
+    a_Stats->DeepSleepCycles       = Power_DeepSleepCycles;
+    a_Stats->RunCycles             = Power_GetWallCycles() - Power_StartCycles - Power_SleepCycles - Power_DeepSleepCycles;
+    a_Stats->SleepEntries          = Power_SleepEntries;
+    a_Stats->DeepSleepEntries      = Power_DeepSleepEntries;
+    a_Stats->LastWakeLatencyCycles = Power_LastWakeLatency;
+    a_Stats->MaxWakeLatencyCycles  = Power_MaxWakeLatency;
+    Exit_Critical(State);
+}
+
+/*************************************************************************************
+* Service Name      : Power_GetIdleTime
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : a_WallCycles - Wall time since Power_Init, a_IdleCycles - Part of it spent in WFI
+* Return value      : None
+* Description       : Both counters are read in the same critical section so their difference is the busy time
+**************************************************************************************/
+void Power_GetIdleTime(uint64 *a_WallCycles, uint64 *a_IdleCycles)
+{
+    uint32 State;
+
+    if((a_WallCycles == NULL_PTR) || (a_IdleCycles == NULL_PTR))
+    {
+        return; /* Report an Error */
+    }
+
+    State = Enter_Critical();
+    *a_WallCycles = Power_GetWallCycles() - Power_StartCycles;
+    *a_IdleCycles = Power_SleepCycles + Power_DeepSleepCycles;
+    Exit_Critical(State);
+}
@@ -0,0 +1,136 @@
+/******************************************************************************
+ *
+ * Module: Power
+ *
+ * File Name: POWER.h
+ *
+ * Description: Header file for the sleep / deep-sleep power management and energy accounting
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef POWER_H_
+#define POWER_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define POWER_SLEEP_ON_EXIT_MASK          0x00000002  /* SLEEPONEXIT bit in NVIC_SYSTEM_SYSCTRL */
+#define POWER_SLEEP_DEEP_MASK             0x00000004  /* SLEEPDEEP bit in NVIC_SYSTEM_SYSCTRL */
+
+#define POWER_RCC_ACG_MASK                0x08000000  /* Auto clock gating, SCGCn/DCGCn are used in sleep modes */
+
+#define POWER_DSLPCLKCFG_DSOSCSRC_MASK    0x00000070
+#define POWER_DSLPCLKCFG_MOSC             0x00000000
+#define POWER_DSLPCLKCFG_PIOSC            0x00000010  /* Run from PIOSC in deep-sleep so the MOSC/PLL can power down */
+#define POWER_DSLPCLKCFG_LFIOSC           0x00000030
+#define POWER_DSLPCLKCFG_32KHZ            0x00000070
+#define POWER_DSLPCLKCFG_DSDIVORIDE_MASK  0x1F800000  /* Deep-sleep clock divided by DSDIVORIDE + 1 */
+#define POWER_DSLPCLKCFG_DSDIVORIDE_BITS_POS 23
+
+#define POWER_PIOSC_HZ                    16000000UL
+#define POWER_LFIOSC_HZ                   30000UL     /* Nominal, the LFIOSC is not trimmed */
+#define POWER_HIB_OSC_HZ                  32768UL
+
+/* Unit of the time accounting: cycles of a fixed 80 MHz reference, the core clock cycles at the maximum
+ * clock. The accounting does not change unit when the core clock or the deep-sleep clock differ. */
+#define POWER_TIME_BASE_HZ                80000000UL
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef enum
+{
+    POWER_MODE_RUN,
+    POWER_MODE_SLEEP,
+    POWER_MODE_DEEP_SLEEP
+}Power_ModeType;
+
+/* Peripheral clocks kept running in a sleep mode, one bit per module as in the SYSCTL_SCGCx/DCGCx registers */
+typedef struct
+{
+    uint32 Watchdog;
+    uint32 Timer;
+    uint32 Gpio;
+    uint32 Dma;
+    uint32 Uart;
+    uint32 Ssi;
+    uint32 I2c;
+    uint32 Adc;
+    uint32 WideTimer;
+}Power_ClockGateType;
+
+typedef struct
+{
+    Power_ClockGateType Sleep;            /* Written to the SYSCTL_SCGCx registers */
+    Power_ClockGateType DeepSleep;        /* Written to the SYSCTL_DCGCx registers */
+    uint32 DeepSleepClockCfg;             /* Written to SYSCTL_DSLPCLKCFG_REG */
+}Power_ConfigType;
+
+typedef struct
+{
+    uint64 RunCycles;                     /* Time spent awake, all times in POWER_TIME_BASE_HZ cycles */
+    uint64 SleepCycles;                   /* Time spent in sleep */
+    uint64 DeepSleepCycles;               /* Time spent in deep-sleep */
+    uint32 SleepEntries;
+    uint32 DeepSleepEntries;
+    uint32 LastWakeLatencyCycles;         /* From the SysTick event to the first instruction after WFI */
+    uint32 MaxWakeLatencyCycles;
+}Power_StatsType;
+
+
+/*************************************************************************************
+* Service Name   : Power_Init
+* Parameters (in): a_Config - Peripheral clocks to keep running in sleep and deep-sleep
+* Description    : Enable automatic clock gating and program the sleep mode clock gates
+**************************************************************************************/
+extern void Power_Init(const Power_ConfigType *a_Config);
+
+/*************************************************************************************
+* Service Name   : Power_SysTickRestart
+* Description    : Called by SysTick_Init before the counter is reloaded, the time so far is kept
+*                  at the rate it was counted at
+**************************************************************************************/
+extern void Power_SysTickRestart(void);
+
+/*************************************************************************************
+* Service Name   : Power_SetSleepOnExit
+* Parameters (in): a_Enable - TRUE to sleep as soon as the last handler returns to thread mode
+* Description    : For interrupt only designs, main() never runs again once it is enabled
+**************************************************************************************/
+extern void Power_SetSleepOnExit(boolean a_Enable);
+
+/*************************************************************************************
+* Service Name   : Power_Idle
+* Parameters (in): a_Mode - POWER_MODE_SLEEP or POWER_MODE_DEEP_SLEEP
+* Description    : Sleep in WFI until the next interrupt and account the time spent in the mode
+**************************************************************************************/
+extern void Power_Idle(Power_ModeType a_Mode);
+
+/*************************************************************************************
+* Service Name   : Power_GetStats
+* Parameters (out): a_Stats - Time spent in each power mode and wake latency
+* Description    : Report the energy accounting counters
+**************************************************************************************/
+extern void Power_GetStats(Power_StatsType *a_Stats);
+
+/*************************************************************************************
+* Service Name   : Power_GetIdleTime
+* Parameters (out): a_WallCycles - Wall time since Power_Init, a_IdleCycles - Part of it spent in WFI
+* Description    : Cheap read of the idle accounting for the load monitor, in POWER_TIME_BASE_HZ cycles
+**************************************************************************************/
+extern void Power_GetIdleTime(uint64 *a_WallCycles, uint64 *a_IdleCycles);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* POWER_H_ */
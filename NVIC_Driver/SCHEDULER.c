@@ -0,0 +1,456 @@
+/*
+ * SCHEDULER.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "SYSTICK.h"
+#include "DWT.h"
+#include "TRACE.h"
+#include "POWER.h"
+#include "MPU.h"
+#include "SCHEDULER.h"
+
+/* Count leading zeros, maps the highest set bit of the ready bitmap to the highest ready priority */
+#define SCHEDULER_CLZ(Value)        _norm(Value)
+
+#define SCHEDULER_PRIORITY_BIT(Priority)    (0x80000000UL >> (Priority))
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+/* Accessed by PendSV_Handler in SCHEDULER_CONTEXT.asm */
+Scheduler_TaskType * volatile Scheduler_CurrentTask = NULL_PTR;
+volatile uint32 Scheduler_LastSwitchCycles = 0;
+
+static Scheduler_TaskType Scheduler_Tasks[SCHEDULER_MAX_TASKS];
+static Scheduler_TaskType *Scheduler_ReadyHead[SCHEDULER_PRIORITY_LEVELS];
+static Scheduler_TaskType *Scheduler_ReadyTail[SCHEDULER_PRIORITY_LEVELS];
+static volatile uint32 Scheduler_ReadyBitmap = 0;
+static volatile uint32 Scheduler_ContextSwitches = 0;
+static volatile uint32 Scheduler_MaxSwitchCycles = 0;
+static const Mpu_TaskRegionsType *Scheduler_LoadedRegions = NULL_PTR;
+
+SCHEDULER_STACK(Scheduler_IdleStack, SCHEDULER_IDLE_STACK_WORDS);
+
+/*******************************************************************************
+ *                       Private Functions Definitions                         *
+ *******************************************************************************/
+
+/* Append a task to the tail of the ready queue of its priority */
+static void Scheduler_ReadyInsert(Scheduler_TaskType *a_Task)
+{
+    Scheduler_PriorityType Priority = a_Task->Priority;
+
+    a_Task->Next  = NULL_PTR;
+    a_Task->State = SCHEDULER_TASK_READY;
+    if(Scheduler_ReadyHead[Priority] == NULL_PTR)
+    {
+        Scheduler_ReadyHead[Priority] = a_Task;
+        Scheduler_ReadyBitmap |= SCHEDULER_PRIORITY_BIT(Priority);
+    }
+    else
+    {
+        Scheduler_ReadyTail[Priority]->Next = a_Task;
+    }
+    Scheduler_ReadyTail[Priority] = a_Task;
+}
+
+/* Remove the head of a ready queue, the running task is always the head of its queue */
+static void Scheduler_ReadyRemoveHead(Scheduler_PriorityType a_Priority)
+{
+    Scheduler_TaskType *Head = Scheduler_ReadyHead[a_Priority];
+
+    Scheduler_ReadyHead[a_Priority] = Head->Next;
+    Head->Next = NULL_PTR;
+    if(Scheduler_ReadyHead[a_Priority] == NULL_PTR)
+    {
+        Scheduler_ReadyTail[a_Priority] = NULL_PTR;
+        Scheduler_ReadyBitmap &= ~SCHEDULER_PRIORITY_BIT(a_Priority);
+    }
+}
+
+/* Move the head of a ready queue to its tail (round robin between equal priorities) */
+static void Scheduler_ReadyRotate(Scheduler_PriorityType a_Priority)
+{
+    Scheduler_TaskType *Head = Scheduler_ReadyHead[a_Priority];
+
+    if((Head != NULL_PTR) && (Head->Next != NULL_PTR))
+    {
+        Scheduler_ReadyHead[a_Priority] = Head->Next;
+        Head->Next = NULL_PTR;
+        Scheduler_ReadyTail[a_Priority]->Next = Head;
+        Scheduler_ReadyTail[a_Priority] = Head;
+    }
+}
+
+/* Idle task, sleeps until the next interrupt so waiting costs no CPU time and is accounted by the Power module */
+static void Scheduler_IdleTask(void)
+{
+    while(1)
+    {
+        Power_Idle(POWER_MODE_SLEEP);
+    }
+}
+
+/* Landing address for a task function that returns, the task is suspended for ever */
+static void Scheduler_TaskExit(void)
+{
+    uint32 State;
+
+    State = Enter_Critical();
+    Scheduler_CurrentTask->State = SCHEDULER_TASK_SUSPENDED;
+    Scheduler_ReadyRemoveHead(Scheduler_CurrentTask->Priority);
+    Scheduler_PendContextSwitch();
+    Exit_Critical(State);
+    while(1)
+    {
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Scheduler_Init
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Initialize the scheduler data and create the idle task
+**************************************************************************************/
+void Scheduler_Init(void)
+{
+    uint8 Index;
+
+    for(Index = 0; Index < SCHEDULER_MAX_TASKS; Index++)
+    {
+        Scheduler_Tasks[Index].State = SCHEDULER_TASK_UNUSED;
+    }
+    for(Index = 0; Index < SCHEDULER_PRIORITY_LEVELS; Index++)
+    {
+        Scheduler_ReadyHead[Index] = NULL_PTR;
+        Scheduler_ReadyTail[Index] = NULL_PTR;
+    }
+    Scheduler_ReadyBitmap     = 0;
+    Scheduler_CurrentTask     = NULL_PTR;
+    Scheduler_ContextSwitches = 0;
+    Scheduler_MaxSwitchCycles = 0;
+
+    (void)Scheduler_CreateTask(Scheduler_IdleTask, SCHEDULER_IDLE_PRIORITY,
+                               Scheduler_IdleStack, SCHEDULER_IDLE_STACK_WORDS);
+}
+
+/*************************************************************************************
+* Service Name      : Scheduler_CreateTask
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Entry - Task function, a_Priority - Task priority (0 is the highest),
+*                     a_Stack - Statically allocated stack, a_StackWords - Stack size in 32-bit words
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : Id of the created task or SCHEDULER_INVALID_TASK
+* Description       : Build the initial exception frame on the task stack and make the task ready
+**************************************************************************************/
+Scheduler_TaskIdType Scheduler_CreateTask(void (*a_Entry)(void), Scheduler_PriorityType a_Priority,
+                                          uint64 *a_Stack, uint16 a_StackWords)
+{
+    Scheduler_TaskIdType Id;
+    Scheduler_TaskType *Task;
+    uint32 *Frame;
+    uint32 State;
+
+    if((a_Entry == NULL_PTR) || (a_Stack == NULL_PTR) || (a_Priority >= SCHEDULER_PRIORITY_LEVELS) ||
+       (a_StackWords <= SCHEDULER_STACK_FRAME_WORDS))
+    {
+        return SCHEDULER_INVALID_TASK; /* Report an Error */
+    }
+
+    for(Id = 0; Id < SCHEDULER_MAX_TASKS; Id++)
+    {
+        if(Scheduler_Tasks[Id].State == SCHEDULER_TASK_UNUSED)
+        {
+            break;
+        }
+    }
+    if(Id == SCHEDULER_MAX_TASKS)
+    {
+        return SCHEDULER_INVALID_TASK; /* No free task control block */
+    }
+
+    Task  = &Scheduler_Tasks[Id];
+    Frame = (uint32 *)a_Stack + (a_StackWords & ~1U); /* Keep the top of stack 8 bytes aligned */
+
+    /* Hardware frame popped on exception return */
+    *(--Frame) = SCHEDULER_INITIAL_XPSR;
+    *(--Frame) = (uint32)a_Entry;                /* PC  */
+    *(--Frame) = (uint32)Scheduler_TaskExit;     /* LR  */
+    *(--Frame) = 0;                              /* R12 */
+    *(--Frame) = 0;                              /* R3  */
+    *(--Frame) = 0;                              /* R2  */
+    *(--Frame) = 0;                              /* R1  */
+    *(--Frame) = 0;                              /* R0  */
+
+    /* Software frame restored by PendSV_Handler */
+    *(--Frame) = SCHEDULER_EXC_RETURN_THREAD_PSP;
+    Frame -= 8;                                  /* R4-R11 */
+
+    State = Enter_Critical();
+    Task->StackPointer = Frame;
+    Task->Entry        = a_Entry;
+    Task->Priority     = a_Priority;
+    Task->DelayTicks   = 0;
+    Task->SliceTicks   = SCHEDULER_TIME_SLICE_TICKS;
+    Task->MpuRegions   = NULL_PTR;
+    Scheduler_ReadyInsert(Task);
+    Exit_Critical(State);
+
+    return Id;
+}
+
+/*************************************************************************************
+* Service Name      : Scheduler_SetTaskRegions
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Id - Task id, a_Regions - Regions encoded by Mpu_BuildTaskRegions or NULL_PTR
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Attach MPU regions to a task, they are reloaded on each switch to the task
+**************************************************************************************/
+void Scheduler_SetTaskRegions(Scheduler_TaskIdType a_Id, const Mpu_TaskRegionsType *a_Regions)
+{
+    if((a_Id >= SCHEDULER_MAX_TASKS) || (Scheduler_Tasks[a_Id].State == SCHEDULER_TASK_UNUSED))
+    {
+        return; /* Report an Error */
+    }
+    Scheduler_Tasks[a_Id].MpuRegions = a_Regions;
+}
+
+/*************************************************************************************
+* Service Name      : Scheduler_Start
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Start SysTick time slicing and switch to the highest priority task, never returns
+**************************************************************************************/
+void Scheduler_Start(void)
+{
+    DWT_EnableCycleCounter();
+
+    NVIC_SetPriorityException(EXCEPTION_PEND_SV_TYPE, SCHEDULER_PENDSV_PRIORITY);
+    NVIC_SetPriorityException(EXCEPTION_SYSTICK_TYPE, SCHEDULER_SYSTICK_PRIORITY);
+
+    SysTick_SetCallBack((volatile void (*)(void))Scheduler_Tick);
+    SysTick_Init(SCHEDULER_TICK_MS);
+
+    /* The first PendSV finds no current task, so it only restores the selected one */
+    Scheduler_PendContextSwitch();
+    Enable_Exceptions();
+
+    while(1)
+    {
+        /* Not reached, PendSV never returns to the main stack */
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Scheduler_Delay
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Ticks - Number of scheduler ticks to sleep
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Block the calling task for the given number of ticks without consuming CPU time
+**************************************************************************************/
+void Scheduler_Delay(uint32 a_Ticks)
+{
+    Scheduler_TaskType *Task = Scheduler_CurrentTask;
+    uint32 State;
+
+    if((a_Ticks == 0) || (Task == NULL_PTR) || (Task->Priority == SCHEDULER_IDLE_PRIORITY))
+    {
+        Scheduler_Yield();
+        return;
+    }
+
+    State = Enter_Critical();
+    Scheduler_ReadyRemoveHead(Task->Priority);
+    Task->DelayTicks = a_Ticks;
+    Task->State      = SCHEDULER_TASK_DELAYED;
+    Scheduler_PendContextSwitch();
+    Exit_Critical(State); /* PendSV is taken here, or when the caller leaves its own critical section */
+}
+
+/*************************************************************************************
+* Service Name      : Scheduler_Yield
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Give the CPU to the next ready task of the same priority
+**************************************************************************************/
+void Scheduler_Yield(void)
+{
+    uint32 State;
+
+    if(Scheduler_CurrentTask != NULL_PTR)
+    {
+        State = Enter_Critical();
+        Scheduler_ReadyRotate(Scheduler_CurrentTask->Priority);
+        Scheduler_CurrentTask->SliceTicks = SCHEDULER_TIME_SLICE_TICKS;
+        Scheduler_PendContextSwitch();
+        Exit_Critical(State);
+    }
+    else
+    {
+        /* Scheduler not started yet */
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Scheduler_GetCurrentTask
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : Id of the running task
+* Description       : Get the id of the running task
+**************************************************************************************/
+Scheduler_TaskIdType Scheduler_GetCurrentTask(void)
+{
+    if(Scheduler_CurrentTask == NULL_PTR)
+    {
+        return SCHEDULER_INVALID_TASK;
+    }
+    return (Scheduler_TaskIdType)(Scheduler_CurrentTask - Scheduler_Tasks);
+}
+
+/*************************************************************************************
+* Service Name      : Scheduler_GetStats
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : a_Stats - Copy of the context switch statistics
+* Return value      : None
+* Description       : Report the number of context switches and their measured cost in core cycles
+**************************************************************************************/
+void Scheduler_GetStats(Scheduler_StatsType *a_Stats)
+{
+    uint32 State;
+
+    if(a_Stats != NULL_PTR)
+    {
+        State = Enter_Critical();
+        a_Stats->ContextSwitches  = Scheduler_ContextSwitches;
+        a_Stats->LastSwitchCycles = Scheduler_LastSwitchCycles;
+        a_Stats->MaxSwitchCycles  = (Scheduler_LastSwitchCycles > Scheduler_MaxSwitchCycles) ?
+                                    Scheduler_LastSwitchCycles : Scheduler_MaxSwitchCycles;
+        Exit_Critical(State);
+    }
+    else
+    {
+        /* Report an Error */
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Scheduler_Tick
+* Sync/Async        : Asynchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Wake up expired delays and apply time slicing, called from SysTick_Handler
+**************************************************************************************/
+void Scheduler_Tick(void)
+{
+    Scheduler_TaskType *Current = Scheduler_CurrentTask;
+    boolean SwitchRequired = FALSE;
+    uint8 Index;
+
+    for(Index = 0; Index < SCHEDULER_MAX_TASKS; Index++)
+    {
+        Scheduler_TaskType *Task = &Scheduler_Tasks[Index];
+
+        if((Task->State == SCHEDULER_TASK_DELAYED) && (--Task->DelayTicks == 0))
+        {
+            Scheduler_ReadyInsert(Task);
+        }
+    }
+
+    if(Current == NULL_PTR)
+    {
+        return;
+    }
+
+    if((Current->State == SCHEDULER_TASK_READY) && (--Current->SliceTicks == 0))
+    {
+        Current->SliceTicks = SCHEDULER_TIME_SLICE_TICKS;
+        if(Current->Next != NULL_PTR)
+        {
+            Scheduler_ReadyRotate(Current->Priority);
+            SwitchRequired = TRUE;
+        }
+    }
+
+    /* Preempt if a higher priority task became ready */
+    if((Scheduler_ReadyBitmap != 0) && (SCHEDULER_CLZ(Scheduler_ReadyBitmap) < Current->Priority))
+    {
+        SwitchRequired = TRUE;
+    }
+
+    if(SwitchRequired)
+    {
+        Scheduler_PendContextSwitch();
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Scheduler_SwitchContext
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Pick the head of the highest priority ready queue in O(1), called by PendSV_Handler
+*                     with interrupts disabled
+**************************************************************************************/
+void Scheduler_SwitchContext(void)
+{
+    Scheduler_PriorityType Highest;
+
+    if(Scheduler_LastSwitchCycles > Scheduler_MaxSwitchCycles)
+    {
+        Scheduler_MaxSwitchCycles = Scheduler_LastSwitchCycles;
+    }
+    Scheduler_ContextSwitches++;
+
+    /* The idle task is never removed from its queue, so the bitmap is never empty */
+    Highest = (Scheduler_PriorityType)SCHEDULER_CLZ(Scheduler_ReadyBitmap);
+    Scheduler_CurrentTask = Scheduler_ReadyHead[Highest];
+
+    /* Tasks without regions of their own do not pay for a reload */
+    if(Scheduler_CurrentTask->MpuRegions != Scheduler_LoadedRegions)
+    {
+        Scheduler_LoadedRegions = Scheduler_CurrentTask->MpuRegions;
+        Mpu_LoadTaskRegions(Scheduler_LoadedRegions);
+    }
+    TRACE_TASK_SWITCH((uint8)(Scheduler_CurrentTask - Scheduler_Tasks));
+}
@@ -0,0 +1,165 @@
+/******************************************************************************
+ *
+ * Module: Scheduler
+ *
+ * File Name: SCHEDULER.h
+ *
+ * Description: Header file for the preemptive priority scheduler (SysTick time slicing, PendSV context switch)
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "MPU.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define SCHEDULER_MAX_TASKS               8      /* Number of task control blocks, the idle task uses one of them */
+#define SCHEDULER_PRIORITY_LEVELS         32     /* One bit per level in the ready bitmap, 0 is the highest priority */
+#define SCHEDULER_IDLE_PRIORITY           (SCHEDULER_PRIORITY_LEVELS - 1)
+#define SCHEDULER_TIME_SLICE_TICKS        10     /* Round robin slice between tasks of the same priority */
+#define SCHEDULER_TICK_MS                 1      /* SysTick period used as the scheduler time base */
+#define SCHEDULER_IDLE_STACK_WORDS        64
+
+#define SCHEDULER_INVALID_TASK            0xFF
+
+#define SCHEDULER_PENDSV_PRIORITY         7      /* PendSV must be the lowest priority exception */
+#define SCHEDULER_SYSTICK_PRIORITY        6
+
+#define SCHEDULER_PENDSV_SET_MASK         0x10000000
+#define SCHEDULER_INITIAL_XPSR            0x01000000  /* Thumb bit */
+#define SCHEDULER_EXC_RETURN_THREAD_PSP   0xFFFFFFFD
+#define SCHEDULER_STACK_FRAME_WORDS       17          /* R4-R11 + EXC_RETURN + hardware frame (R0-R3, R12, LR, PC, xPSR) */
+
+/* Declare a statically allocated task stack, the stack must be 8 bytes aligned for the AAPCS */
+#define SCHEDULER_STACK(Name, Words)      static uint64 Name[((Words) + 1) / 2]
+
+/* Trigger a context switch, the switch is performed by PendSV once no other exception is active */
+#define Scheduler_PendContextSwitch()     (NVIC_SYSTEM_INTCTRL = SCHEDULER_PENDSV_SET_MASK)
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef uint8 Scheduler_TaskIdType;
+
+typedef uint8 Scheduler_PriorityType;
+
+typedef enum
+{
+    SCHEDULER_TASK_UNUSED,
+    SCHEDULER_TASK_READY,
+    SCHEDULER_TASK_DELAYED,
+    SCHEDULER_TASK_SUSPENDED
+}Scheduler_TaskStateType;
+
+typedef struct Scheduler_Task
+{
+    uint32 *StackPointer;                 /* Must stay the first member, PendSV saves/restores it by offset 0 */
+    struct Scheduler_Task *Next;          /* Link in the ready queue of the task priority */
+    void (*Entry)(void);
+    uint32 DelayTicks;
+    uint16 SliceTicks;
+    Scheduler_PriorityType Priority;
+    Scheduler_TaskStateType State;
+    const Mpu_TaskRegionsType *MpuRegions; /* Loaded in the MPU task regions while the task runs, NULL_PTR for none */
+}Scheduler_TaskType;
+
+typedef struct
+{
+    uint32 ContextSwitches;               /* Number of switches performed by PendSV */
+    uint32 LastSwitchCycles;              /* Core cycles spent in the last PendSV switch */
+    uint32 MaxSwitchCycles;               /* Worst case switch time seen since Scheduler_Start */
+}Scheduler_StatsType;
+
+
+/*************************************************************************************
+* Service Name   : Scheduler_Init
+* Parameters (in): None
+* Description    : Initialize the scheduler data and create the idle task
+**************************************************************************************/
+extern void Scheduler_Init(void);
+
+/*************************************************************************************
+* Service Name   : Scheduler_CreateTask
+* Parameters (in): a_Entry - Task function, a_Priority - Task priority (0 is the highest),
+*                  a_Stack - Statically allocated stack, a_StackWords - Stack size in 32-bit words
+* Return value   : Id of the created task or SCHEDULER_INVALID_TASK
+* Description    : Create a task and put it in the ready queue of its priority
+**************************************************************************************/
+extern Scheduler_TaskIdType Scheduler_CreateTask(void (*a_Entry)(void), Scheduler_PriorityType a_Priority,
+                                                 uint64 *a_Stack, uint16 a_StackWords);
+
+/*************************************************************************************
+* Service Name   : Scheduler_SetTaskRegions
+* Parameters (in): a_Id - Task id, a_Regions - Regions encoded by Mpu_BuildTaskRegions or NULL_PTR
+* Description    : Attach MPU regions to a task, they are reloaded on each switch to the task
+**************************************************************************************/
+extern void Scheduler_SetTaskRegions(Scheduler_TaskIdType a_Id, const Mpu_TaskRegionsType *a_Regions);
+
+/*************************************************************************************
+* Service Name   : Scheduler_Start
+* Parameters (in): None
+* Description    : Start SysTick time slicing and switch to the highest priority task, never returns
+**************************************************************************************/
+extern void Scheduler_Start(void);
+
+/*************************************************************************************
+* Service Name   : Scheduler_Delay
+* Parameters (in): a_Ticks - Number of scheduler ticks to sleep
+* Description    : Block the calling task for the given number of ticks without consuming CPU time
+**************************************************************************************/
+extern void Scheduler_Delay(uint32 a_Ticks);
+
+/*************************************************************************************
+* Service Name   : Scheduler_Yield
+* Parameters (in): None
+* Description    : Give the CPU to the next ready task of the same priority
+**************************************************************************************/
+extern void Scheduler_Yield(void);
+
+/*************************************************************************************
+* Service Name   : Scheduler_GetCurrentTask
+* Parameters (in): None
+* Return value   : Id of the running task
+* Description    : Get the id of the running task
+**************************************************************************************/
+extern Scheduler_TaskIdType Scheduler_GetCurrentTask(void);
+
+/*************************************************************************************
+* Service Name   : Scheduler_GetStats
+* Parameters (out): a_Stats - Copy of the context switch statistics
+* Description    : Report the number of context switches and their measured cost in core cycles
+**************************************************************************************/
+extern void Scheduler_GetStats(Scheduler_StatsType *a_Stats);
+
+/*************************************************************************************
+* Service Name   : Scheduler_Tick
+* Parameters (in): None
+* Description    : Scheduler time base, called from SysTick_Handler every SCHEDULER_TICK_MS
+**************************************************************************************/
+extern void Scheduler_Tick(void);
+
+/*************************************************************************************
+* Service Name   : Scheduler_SwitchContext
+* Parameters (in): None
+* Description    : Select the next task to run, called only by PendSV_Handler
+**************************************************************************************/
+extern void Scheduler_SwitchContext(void);
+
+extern void PendSV_Handler(void);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* SCHEDULER_H_ */
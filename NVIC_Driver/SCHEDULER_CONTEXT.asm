@@ -0,0 +1,74 @@
+;******************************************************************************
+;
+; Module: Scheduler
+;
+; File Name: SCHEDULER_CONTEXT.asm
+;
+; Description: PendSV context switch for the preemptive scheduler
+;
+; Author: Muhamed Amr
+;
+;******************************************************************************
+
+        .thumb
+        .text
+
+        .global PendSV_Handler
+        .global Scheduler_CurrentTask
+        .global Scheduler_LastSwitchCycles
+        .global Scheduler_SwitchContext
+
+;******************************************************************************
+; PendSV_Handler
+; Runs at the lowest exception priority, so it never preempts another handler.
+; The hardware already stacked R0-R3, R12, LR, PC and xPSR (and S0-S15, FPSCR
+; when the task used the FPU) on the task PSP stack. This handler saves the
+; rest of the context, asks Scheduler_SwitchContext for the next task and
+; restores its context. The cost of the switch in core cycles is stored in
+; Scheduler_LastSwitchCycles.
+;******************************************************************************
+PendSV_Handler: .asmfunc
+        LDR     r3, DwtCycleCountAddr
+        LDR     r12, [r3]               ; Switch start time stamp
+
+        LDR     r2, CurrentTaskAddr
+        LDR     r1, [r2]
+        CBZ     r1, RestoreContext      ; First switch, no context to save
+
+        MRS     r0, PSP
+        TST     lr, #0x10               ; EXC_RETURN bit 4 clear -> extended FPU frame
+        IT      EQ
+        VSTMDBEQ r0!, {s16-s31}
+        STMDB   r0!, {r4-r11, lr}
+        STR     r0, [r1]                ; Current->StackPointer = PSP
+
+RestoreContext:
+        PUSH    {r3, r12}
+        CPSID   I
+        BL      Scheduler_SwitchContext
+        CPSIE   I
+        POP     {r3, r12}
+
+        LDR     r2, CurrentTaskAddr
+        LDR     r1, [r2]
+        LDR     r0, [r1]                ; r0 = Current->StackPointer
+        LDMIA   r0!, {r4-r11, lr}
+        TST     lr, #0x10
+        IT      EQ
+        VLDMIAEQ r0!, {s16-s31}
+        MSR     PSP, r0
+
+        LDR     r1, [r3]                ; Switch end time stamp
+        SUB     r1, r1, r12
+        LDR     r2, LastSwitchCyclesAddr
+        STR     r1, [r2]
+
+        BX      lr                      ; Return to thread mode on the new task PSP
+        .endasmfunc
+
+        .align  4
+CurrentTaskAddr:        .word   Scheduler_CurrentTask
+LastSwitchCyclesAddr:   .word   Scheduler_LastSwitchCycles
+DwtCycleCountAddr:      .word   0xE0001004
+
+        .end
@@ -7,10 +7,63 @@
 
 #include "tm4c123gh6pm_registers.h"
 #include "SYSTICK.h"
+#include "CLOCK.h"
+#include "TRACE.h"
+#include "FPU.h"
+#include "LOAD.h"
+#include "DELAY.h"
+#include "ATOMIC.h"
+#include "POWER.h"
 
-static volatile uint32 SysTick_OVF_Count = 0; 
-static volatile uint32 SysTick_Reload_Value = 0;
+/* One period is OVF_Count + 1 wraps of the 24 bits counter, each of Reload_Value + 1 ticks */
+typedef struct
+{
+    uint32 OVF_Count;
+    uint32 Reload_Value;
+}SysTick_PeriodType;
+
+/* Double buffer: the new period is written in the slot the handler does not use, then published
+ * with one atomic exchange of the index, the handler never reads a half updated pair */
+static SysTick_PeriodType SysTick_Periods[2];
+static volatile uint32 SysTick_ActivePeriod = 0;
 static volatile void (*UserFunctionOVF)(void) = NULL_PTR;
+static volatile uint32 SysTick_TickCount = 0;
+static volatile uint32 SysTick_WrapCount = 0; /* Counter wraps of the current period, cleared with a new period */
+static volatile uint16 SysTick_PeriodMs = 0;
+static SysTick_TickHookType SysTick_TickHooks[SYSTICK_MAX_TICK_HOOKS];
+static uint8 SysTick_TickHooksCount = 0;
+
+
+/*************************************************************************************
+* Service Name      : SysTick_ComputePeriod
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_TimeInMilliSeconds - User desired time in milli-second
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : The published period
+* Description       : Split the period in core clock ticks into equal wraps of at most 2^24 ticks, the counter
+*                     then reloads by itself on every wrap. The period is short by less than one tick per
+*                     wrap. Integer only, called from thread level only, the handler is the only other user
+*                     of the periods.
+**************************************************************************************/
+static const SysTick_PeriodType *SysTick_ComputePeriod(uint16 a_TimeInMilliSeconds)
+{
+    uint64 Ticks = (uint64)a_TimeInMilliSeconds * (Clock_GetCoreClock() / 1000); /* Core clock ticks in the period */
+    uint32 Wraps = (uint32)((Ticks + SYSTICK_RELOAD_MASK) >> SYSTICK_RELOAD_BITS); /* Wraps of at most 2^24 ticks */
+    uint32 Next  = SysTick_ActivePeriod ^ 1;
+
+    if(Wraps == 0)
+    {
+        Wraps = 1;
+        Ticks = 1;
+    }
+    SysTick_Periods[Next].OVF_Count    = Wraps - 1;                 /* The number of times the counter is repeated to obtain the desired time */
+    SysTick_Periods[Next].Reload_Value = (uint32)(Ticks / Wraps) - 1; /* The counter runs RELOAD + 1 ticks per wrap */
+    (void)Atomic_Exchange(&SysTick_ActivePeriod, Next);
+
+    return &SysTick_Periods[Next];
+}
 
 
 /*************************************************************************************
@@ -25,27 +78,26 @@ static volatile void (*UserFunctionOVF)(void) = NULL_PTR;
 **************************************************************************************/
 void SysTick_Init(uint16 a_TimeInMilliSeconds)
 {
-    float32 Tick_Time ;
-    float32 OVFTime;
-
-    SYSTICK_CTRL_REG    = 0; /* Disable the SysTick Timer by Clear the ENABLE Bit */
+    const SysTick_PeriodType *Period;
 
-    Tick_Time = (float32)1/F_CPU; /* The time required for one pulse */
-    OVFTime   = Tick_Time * 16777216;  /* The time required for SysTick counter to overflow */
+    Power_SysTickRestart(); /* Account the counts so far at the clock they ran at */
+    SYSTICK_REGS->CTRL    = 0; /* Disable the SysTick Timer by Clear the ENABLE Bit */
+    SysTick_WrapCount     = 0; /* The new period starts with the next reload */
 
+    SysTick_PeriodMs = a_TimeInMilliSeconds; /* Kept to rescale the period when the core clock changes */
+    Clock_RegisterNotifier(SysTick_ClockChanged);
 
-    SysTick_OVF_Count = ((float32)a_TimeInMilliSeconds / 1000) / OVFTime; /* The number of times the counter is repeated to obtain the desired time  */
-    SysTick_Reload_Value = (a_TimeInMilliSeconds % ((uint32)(OVFTime * 1000))) / (Tick_Time * 1000); /* The value to be set in Reload register to obtain desired time*/
+    Period = SysTick_ComputePeriod(a_TimeInMilliSeconds);
 
 
-    SYSTICK_RELOAD_REG  =  SysTick_Reload_Value; /* Set Reload Value in SYSTICK_RELOAD_REG */
-    SYSTICK_CURRENT_REG =  0 ;/* Clear the Current Register value */
+    SYSTICK_REGS->RELOAD  =  Period->Reload_Value; /* Set Reload Value in SYSTICK_RELOAD_REG */
+    SYSTICK_REGS->CURRENT =  0 ;/* Clear the Current Register value */
 
        /* Configure the SysTick Control Register
         * Enable SysTick Interrupt (INTEN = 1)
         * Choose the clock source to be System Clock (CLK_SRC = 1) 
         * Enable SysTick Timer */
-    SYSTICK_CTRL_REG   |= SYSTICK_CLK_SRC_MASK | SYSTICK_INTERRUPT_ENABLE_MASK |SYSTICK_TIMER_ENABLE_MASK ;
+    SYSTICK_REGS->CTRL   |= SYSTICK_CLK_SRC_MASK | SYSTICK_INTERRUPT_ENABLE_MASK |SYSTICK_TIMER_ENABLE_MASK ;
 }
 
 /*************************************************************************************
@@ -57,40 +109,43 @@ void SysTick_Init(uint16 a_TimeInMilliSeconds)
 * Parameters (out)  : None
 * Return value      : None
 * Description       : initialize the SysTick timer with the specified time in milliseconds using polling or busy-wait technique.
+*                     A running periodic tick is left untouched, the wait is then measured by Delay_Ms.
 **************************************************************************************/
 void SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds)
 {
-    float32 Tick_Time;
-    float32 OVFTime;
-
     uint16 Counter =0;
+    const SysTick_PeriodType *Period;
 
-    SYSTICK_CTRL_REG    = 0; /* Disable the SysTick Timer by Clear the ENABLE Bit */
+    if(0 != (SYSTICK_REGS->CTRL & SYSTICK_TIMER_ENABLE_MASK))
+    {
+        Delay_Ms(a_TimeInMilliSeconds);
+        return;
+    }
 
-    Tick_Time = (float32)1/F_CPU; /* The time required for one pulse */
-    OVFTime   = Tick_Time * 16777216;   /* The time required for SysTick counter to overflow */
-    SysTick_OVF_Count = ((float32)a_TimeInMilliSeconds / 1000) / OVFTime; /* The number of times the counter is repeated to obtain the desired time  */
-    SysTick_Reload_Value = (a_TimeInMilliSeconds % ((uint32)(OVFTime * 1000))) / (Tick_Time * 1000) ; /* The value to be set in Reload register to obtain desired time*/
+    SYSTICK_REGS->CTRL    = 0; /* Disable the SysTick Timer by Clear the ENABLE Bit */
+    SysTick_WrapCount     = 0;
 
+    Period = SysTick_ComputePeriod(a_TimeInMilliSeconds);
 
-    SYSTICK_RELOAD_REG  =  SysTick_Reload_Value; /* Set Reload Value in SYSTICK_RELOAD_REG */
-    SYSTICK_CURRENT_REG =  0; /* Clear the Current Register value */
+
+    SYSTICK_REGS->RELOAD  =  Period->Reload_Value; /* Set Reload Value in SYSTICK_RELOAD_REG */
+    SYSTICK_REGS->CURRENT =  0; /* Clear the Current Register value */
 
 
     /* Configure the SysTick Control Register
      * Disable SysTick Interrupt (INTEN = 0)
      * Choose the clock source to be System Clock (CLK_SRC = 1)
      * Enable SysTick Timer  */
-    SYSTICK_CTRL_REG    = (SYSTICK_CTRL_REG & ~SYSTICK_INTERRUPT_ENABLE_MASK) | SYSTICK_CLK_SRC_MASK | SYSTICK_INTERRUPT_ENABLE_MASK ;
+    SYSTICK_REGS->CTRL    = (SYSTICK_REGS->CTRL & ~SYSTICK_INTERRUPT_ENABLE_MASK) | SYSTICK_CLK_SRC_MASK | SYSTICK_TIMER_ENABLE_MASK ;
 
-    while(Counter != SysTick_OVF_Count + 1)
+    while(Counter != Period->OVF_Count + 1)
     {
-        if(0 != (SYSTICK_CTRL_REG & (1<<16)))
+        if(0 != (SYSTICK_REGS->CTRL & SYSTICK_COUNT_BIT_MASK))
         {
             Counter++;
         }
     }
-    SYSTICK_CTRL_REG = 0; /* Stop SysTick by disable it */
+    SYSTICK_REGS->CTRL = 0; /* Stop SysTick by disable it */
 }
 
 
@@ -103,26 +158,39 @@ void SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds)
 * Parameters (out)  : None
 * Return value      : None
 * Description       : Handler for SysTick interrupt use to call the call-back function.
+*                     The period and the call-back are read once, a thread level update is seen whole at
+*                     the next tick without any interrupt disable on the writer side.
 **************************************************************************************/
 void SysTick_Handler(void)
 {
-    static volatile uint16 Counter = 0;
-    Counter++;
-    if(Counter == SysTick_OVF_Count + 1)
+    const SysTick_PeriodType *Period = &SysTick_Periods[SysTick_ActivePeriod];
+    volatile void (*UserFunction)(void) = UserFunctionOVF;
+    uint8 Index;
+    FPU_ISR_ENTER();
+    LOAD_ISR_ENTER();
+    TRACE_ISR_ENTER(TRACE_SYSTICK_EXCEPTION_NUM);
+    SysTick_TickCount++; /* Single writer, the readers load it in one access */
+    SysTick_WrapCount++;
+    if(SysTick_WrapCount >= Period->OVF_Count + 1) /* Also ends a count left from a longer period */
     {
-        SYSTICK_CURRENT_REG = 0; /* Clearing SYSTICK_CURRENT_REG as writing any value to this register clear it */
-        SYSTICK_RELOAD_REG  =  SysTick_Reload_Value; /* Reset Reload Value */
-        Counter = 0; /* Reset Counter value */
-        if(UserFunctionOVF != NULL_PTR)
+        /* Every wrap of the period has the same RELOAD, the counter reloads by itself without losing counts */
+        SysTick_WrapCount = 0; /* Reset Counter value */
+        for(Index = 0; Index < SysTick_TickHooksCount; Index++)
         {
-            (*UserFunctionOVF)(); /* Call User Function */
+            SysTick_TickHooks[Index](); /* Call the services driven by the SysTick period */
+        }
+        if(UserFunction != NULL_PTR)
+        {
+            (*UserFunction)(); /* Call User Function */
         }
         else
         {
             /* Do nothig*/
         }
     }
-
+    TRACE_ISR_EXIT(TRACE_SYSTICK_EXCEPTION_NUM);
+    LOAD_ISR_EXIT(TRACE_SYSTICK_EXCEPTION_NUM);
+    FPU_ISR_EXIT(TRACE_SYSTICK_EXCEPTION_NUM);
 }
 
 /*************************************************************************************
@@ -154,7 +222,7 @@ void SysTick_SetCallBack(volatile void (*Ptr2Func) (void))
 **************************************************************************************/
 void SysTick_Stop(void)
 {
-    SYSTICK_CTRL_REG &= ~(SYSTICK_TIMER_ENABLE_MASK); /* Disable SysTick Timer */
+    SYSTICK_REGS->CTRL &= ~(SYSTICK_TIMER_ENABLE_MASK); /* Disable SysTick Timer */
 }
 
 /*************************************************************************************
@@ -169,7 +237,7 @@ void SysTick_Stop(void)
 **************************************************************************************/
 void SysTick_Start(void)
 {
-    SYSTICK_CTRL_REG |= SYSTICK_TIMER_ENABLE_MASK; /* Enable SysTick Timer */
+    SYSTICK_REGS->CTRL |= SYSTICK_TIMER_ENABLE_MASK; /* Enable SysTick Timer */
 }
 
 /*************************************************************************************
@@ -184,8 +252,83 @@ void SysTick_Start(void)
 **************************************************************************************/
 void SysTick_DeInit(void)
 {
-    SYSTICK_CTRL_REG    = 0; /* Clear CTRL_REG */
-    SYSTICK_CURRENT_REG = 0; /* Clear SysTick Counter value */
+    SYSTICK_REGS->CTRL    = 0; /* Clear CTRL_REG */
+    SYSTICK_REGS->CURRENT = 0; /* Clear SysTick Counter value */
     UserFunctionOVF=NULL_PTR; /* Clear call back function */
+    SysTick_PeriodMs = 0;
+}
+
+/*************************************************************************************
+* Service Name      : SysTick_GetTickCount
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : Number of SysTick interrupts since reset
+* Description       : Free running count of SysTick interrupts, used as a wall clock by the other modules.
+**************************************************************************************/
+uint32 SysTick_GetTickCount(void)
+{
+    return SysTick_TickCount;
 }
 
+/*************************************************************************************
+* Service Name      : SysTick_ClockChanged
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_CoreClockHz - New core clock
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Clock notifier, recompute the reload value so the period set by SysTick_Init
+*                     stays the same after a core clock change.
+**************************************************************************************/
+void SysTick_ClockChanged(uint32 a_CoreClockHz)
+{
+    (void)a_CoreClockHz; /* Read back through Clock_GetCoreClock() by SysTick_Init */
+    if((SysTick_PeriodMs != 0) && (0 != (SYSTICK_REGS->CTRL & SYSTICK_TIMER_ENABLE_MASK)))
+    {
+        SysTick_Init(SysTick_PeriodMs);
+    }
+    else
+    {
+        /* SysTick not running, the next SysTick_Init uses the new clock */
+    }
+}
+
+/*************************************************************************************
+* Service Name      : SysTick_RegisterTickHook
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Hook - Function called every SysTick period before the call-back function
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Register a service driven by the SysTick period (governor, coalescing ...) next to
+*                     the single user call-back, duplicates are ignored.
+**************************************************************************************/
+void SysTick_RegisterTickHook(SysTick_TickHookType a_Hook)
+{
+    uint8 Index;
+
+    if(a_Hook == NULL_PTR)
+    {
+        return; /* Report an Error */
+    }
+    for(Index = 0; Index < SysTick_TickHooksCount; Index++)
+    {
+        if(SysTick_TickHooks[Index] == a_Hook)
+        {
+            return; /* Already registered */
+        }
+    }
+    if(SysTick_TickHooksCount < SYSTICK_MAX_TICK_HOOKS)
+    {
+        SysTick_TickHooks[SysTick_TickHooksCount++] = a_Hook;
+    }
+    else
+    {
+        /* Report an Error */
+    }
+}
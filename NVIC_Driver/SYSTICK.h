@@ -22,14 +22,19 @@
  *                           Preprocessor Definitions                          *
  *******************************************************************************/
 
-#define F_CPU                             16000000UL
-
 #define SYSTICK_COUNT_BIT_MASK            0x10000
 
+#define SYSTICK_RELOAD_MASK               0x00FFFFFF  /* 24 bits counter */
+#define SYSTICK_RELOAD_BITS               24
+
 #define SYSTICK_CLK_SRC_MASK              0x4
 #define SYSTICK_INTERRUPT_ENABLE_MASK     0x2
 #define SYSTICK_TIMER_ENABLE_MASK         0x1
 
+#define SYSTICK_PENDING_MASK              0x04000000  /* PENDSTSET bit in NVIC_SYSTEM_INTCTRL */
+
+#define SYSTICK_MAX_TICK_HOOKS            6
+
 
 
 
@@ -54,7 +59,7 @@
 /*******************************************************************************
  *                           Data Types Declarations                           *
  *******************************************************************************/
-
+typedef void (*SysTick_TickHookType)(void);
 
 
 /*************************************************************************************
@@ -76,5 +81,11 @@ extern void SysTick_Start(void);
 
 extern void SysTick_DeInit(void);
 
+extern uint32 SysTick_GetTickCount(void);
+
+extern void SysTick_ClockChanged(uint32 a_CoreClockHz);
+
+extern void SysTick_RegisterTickHook(SysTick_TickHookType a_Hook);
+
 
 #endif /* SYSTICK_H_ */
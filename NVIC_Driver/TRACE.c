@@ -0,0 +1,148 @@
+/*
+ * TRACE.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "CLOCK.h"
+#include "DWT.h"
+#include "TRACE.h"
+
+#if ((TRACE_BUFFER_RECORDS & (TRACE_BUFFER_RECORDS - 1)) != 0)
+#error "TRACE_BUFFER_RECORDS must be a power of 2"
+#endif
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+volatile Trace_BufferType Trace_Buffer;
+
+static uint32 Trace_LastTimeStamp = 0;
+
+/*******************************************************************************
+ *                       Private Functions Definitions                         *
+ *******************************************************************************/
+
+/* Clock notifier, keeps the time stamp frequency of the dump up to date */
+static void Trace_ClockChanged(uint32 a_CoreClockHz)
+{
+    Trace_Buffer.Header.CoreClockHz = a_CoreClockHz;
+}
+
+/* Store one record according to the ring policy, called with interrupts disabled */
+static void Trace_Put(uint32 a_Record)
+{
+    uint32 Index = Trace_Buffer.Header.WriteIndex;
+
+    if((Index >= TRACE_BUFFER_RECORDS) && (Trace_Buffer.Header.Policy == TRACE_POLICY_STOP_WHEN_FULL))
+    {
+        Trace_Buffer.Header.Dropped++;
+    }
+    else
+    {
+        Trace_Buffer.Records[Index & (TRACE_BUFFER_RECORDS - 1)] = a_Record;
+        Trace_Buffer.Header.WriteIndex = Index + 1;
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Trace_Init
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Policy - Behaviour of the ring once it is full
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Clear the trace ring, start the cycle counter and enable recording
+**************************************************************************************/
+void Trace_Init(Trace_PolicyType a_Policy)
+{
+    DWT_EnableCycleCounter();
+
+    Trace_Buffer.Header.Enabled     = FALSE;
+    Trace_Buffer.Header.Magic       = TRACE_MAGIC;
+    Trace_Buffer.Header.Capacity    = TRACE_BUFFER_RECORDS;
+    Trace_Buffer.Header.WriteIndex  = 0;
+    Trace_Buffer.Header.Dropped     = 0;
+    Trace_Buffer.Header.CoreClockHz = Clock_GetCoreClock();
+    Trace_Buffer.Header.Policy      = (uint8)a_Policy;
+    Trace_Buffer.Header.Reserved    = 0;
+    Clock_RegisterNotifier(Trace_ClockChanged);
+
+    /* Force a sync record before the first event */
+    Trace_LastTimeStamp = DWT_GetCycles() - TRACE_TIMESTAMP_RANGE;
+    Trace_Buffer.Header.Enabled     = TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : Trace_Stop
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Freeze the trace ring, for example from a fault handler before dumping it
+**************************************************************************************/
+void Trace_Stop(void)
+{
+    Trace_Buffer.Header.Enabled = FALSE;
+}
+
+/*************************************************************************************
+* Service Name      : Trace_Start
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Resume recording after Trace_Stop
+**************************************************************************************/
+void Trace_Start(void)
+{
+    Trace_LastTimeStamp = DWT_GetCycles() - TRACE_TIMESTAMP_RANGE;
+    Trace_Buffer.Header.Enabled = TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : Trace_Record
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Event - Event type, a_Id - Exception number, task id or user code
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Append a time stamped record to the trace ring. Only the low 20 bits of the
+*                     cycle counter are stored, a sync record with the high bits is added when the
+*                     previous event is too old for the decoder to unwrap the time stamp.
+**************************************************************************************/
+void Trace_Record(Trace_EventType a_Event, uint8 a_Id)
+{
+    uint32 State;
+    uint32 Now;
+
+    if(Trace_Buffer.Header.Enabled == FALSE)
+    {
+        return;
+    }
+
+    State = Enter_Critical();
+    Now   = DWT_GetCycles();
+
+    if((Now - Trace_LastTimeStamp) >= TRACE_TIMESTAMP_RANGE)
+    {
+        Trace_Put(((uint32)TRACE_EVENT_SYNC << TRACE_EVENT_BITS_POS) | (Now >> TRACE_ID_BITS_POS));
+    }
+    Trace_Put(((uint32)a_Event << TRACE_EVENT_BITS_POS) | ((uint32)a_Id << TRACE_ID_BITS_POS) |
+              (Now & TRACE_TIMESTAMP_MASK));
+    Trace_LastTimeStamp = Now;
+
+    Exit_Critical(State);
+}
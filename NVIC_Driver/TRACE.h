@@ -0,0 +1,135 @@
+/******************************************************************************
+ *
+ * Module: Trace
+ *
+ * File Name: TRACE.h
+ *
+ * Description: Header file for the binary event trace recorder
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define TRACE_ENABLE                      TRUE   /* FALSE removes every trace hook at compile time */
+
+#define TRACE_BUFFER_RECORDS              512    /* Must be a power of 2, each record is 4 bytes */
+#define TRACE_DEFAULT_POLICY              TRACE_POLICY_OVERWRITE
+
+#define TRACE_MAGIC                       0x31435254  /* "TRC1" */
+
+/* Record layout: | 31..28 event | 27..20 id | 19..0 time stamp (core cycles, low bits) | */
+#define TRACE_EVENT_BITS_POS              28
+#define TRACE_ID_BITS_POS                 20
+#define TRACE_ID_MASK                     0xFF
+#define TRACE_TIMESTAMP_MASK              0x000FFFFF
+#define TRACE_TIMESTAMP_RANGE             0x00100000  /* A sync record is written when two events are further apart */
+
+#define TRACE_SYSTICK_EXCEPTION_NUM       15
+#define TRACE_IRQ_EXCEPTION_NUM(IRQ)      ((IRQ) + 16)
+
+#if (TRACE_ENABLE == TRUE)
+/* Hooks to be placed at the first and last line of an interrupt handler, the id is the exception number */
+#define TRACE_ISR_ENTER(ExceptionNum)     Trace_Record(TRACE_EVENT_ISR_ENTER, (ExceptionNum))
+#define TRACE_ISR_EXIT(ExceptionNum)      Trace_Record(TRACE_EVENT_ISR_EXIT, (ExceptionNum))
+#define TRACE_TASK_SWITCH(TaskId)         Trace_Record(TRACE_EVENT_TASK_SWITCH, (TaskId))
+#define TRACE_USER(Code)                  Trace_Record(TRACE_EVENT_USER, (Code))
+#define TRACE_IRQ_THROTTLE(IRQ)           Trace_Record(TRACE_EVENT_IRQ_THROTTLE, (IRQ))
+#define TRACE_IRQ_RESUME(IRQ)             Trace_Record(TRACE_EVENT_IRQ_RESUME, (IRQ))
+#else
+#define TRACE_ISR_ENTER(ExceptionNum)
+#define TRACE_ISR_EXIT(ExceptionNum)
+#define TRACE_TASK_SWITCH(TaskId)
+#define TRACE_USER(Code)
+#define TRACE_IRQ_THROTTLE(IRQ)
+#define TRACE_IRQ_RESUME(IRQ)
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef enum
+{
+    TRACE_EVENT_SYNC,                     /* Time stamp bits 31..20 of the next record, stored in the time stamp field */
+    TRACE_EVENT_ISR_ENTER,
+    TRACE_EVENT_ISR_EXIT,
+    TRACE_EVENT_TASK_SWITCH,
+    TRACE_EVENT_USER,
+    TRACE_EVENT_IRQ_THROTTLE,             /* Interrupt governor disabled a storming IRQ, the id is the IRQ number */
+    TRACE_EVENT_IRQ_RESUME                /* Interrupt governor re-enabled the IRQ after its back-off */
+}Trace_EventType;
+
+typedef enum
+{
+    TRACE_POLICY_OVERWRITE,               /* Keep the most recent records */
+    TRACE_POLICY_STOP_WHEN_FULL           /* Keep the first records and count the dropped ones */
+}Trace_PolicyType;
+
+/* Header of the trace dump, the host decoder reads it from the start of Trace_Buffer */
+typedef struct
+{
+    uint32 Magic;
+    uint32 Capacity;                      /* Number of records in the ring */
+    uint32 WriteIndex;                    /* Free running count of written records */
+    uint32 Dropped;                       /* Records lost with TRACE_POLICY_STOP_WHEN_FULL */
+    uint32 CoreClockHz;                   /* Frequency of the time stamp counter */
+    uint8  Policy;
+    uint8  Enabled;
+    uint16 Reserved;
+}Trace_HeaderType;
+
+typedef struct
+{
+    Trace_HeaderType Header;
+    uint32 Records[TRACE_BUFFER_RECORDS];
+}Trace_BufferType;
+
+/* Dump sizeof(Trace_Buffer) bytes from &Trace_Buffer and feed them to tools/trace_decode */
+extern volatile Trace_BufferType Trace_Buffer;
+
+
+/*************************************************************************************
+* Service Name   : Trace_Init
+* Parameters (in): a_Policy - Behaviour of the ring once it is full
+* Description    : Clear the trace ring, start the cycle counter and enable recording
+**************************************************************************************/
+extern void Trace_Init(Trace_PolicyType a_Policy);
+
+/*************************************************************************************
+* Service Name   : Trace_Stop
+* Parameters (in): None
+* Description    : Freeze the trace ring, for example from a fault handler before dumping it
+**************************************************************************************/
+extern void Trace_Stop(void);
+
+/*************************************************************************************
+* Service Name   : Trace_Start
+* Parameters (in): None
+* Description    : Resume recording after Trace_Stop
+**************************************************************************************/
+extern void Trace_Start(void);
+
+/*************************************************************************************
+* Service Name   : Trace_Record
+* Parameters (in): a_Event - Event type, a_Id - Exception number, task id or user code
+* Description    : Append a time stamped record to the trace ring, callable from any context
+**************************************************************************************/
+extern void Trace_Record(Trace_EventType a_Event, uint8 a_Id);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* TRACE_H_ */
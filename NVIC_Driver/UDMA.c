@@ -0,0 +1,213 @@
+/*
+ * UDMA.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "tm4c123gh6pm_registers.h"
+#include "UDMA.h"
+
+#define UDMA_CHANNEL_MASK(Channel)  ((uint32)1 << (Channel))
+#define UDMA_ENTRY(Channel, Structure) \
+    (&Udma_ControlTable[((Structure) == UDMA_ALTERNATE) ? (UDMA_CHANNELS + (Channel)) : (Channel)])
+
+#define UDMA_CHMAP_FIELD_BITS       4
+#define UDMA_CHMAP_FIELDS           8       /* Channels per map register */
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+#pragma DATA_ALIGN(Udma_ControlTable, UDMA_TABLE_ALIGN)
+UDMA_ChannelControlType Udma_ControlTable[2 * UDMA_CHANNELS];
+
+/*******************************************************************************
+ *                       Private Functions Definitions                         *
+ *******************************************************************************/
+
+/* The controller takes the address of the last item, a fixed address is its own end */
+static uint32 Udma_EndPointer(volatile const void *a_Start, uint32 a_Inc, uint16 a_Items)
+{
+    if(a_Inc == UDMA_INC_NONE)
+    {
+        return (uint32)a_Start;
+    }
+    return (uint32)a_Start + ((uint32)(a_Items - 1) << a_Inc);
+}
+
+/*************************************************************************************
+* Service Name      : Udma_Init
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Every channel starts disabled, on its primary structure, at the default priority and
+*                     with its requests unmasked.
+**************************************************************************************/
+void Udma_Init(void)
+{
+    SYSCTL_RCGCDMA_REG |= 0x01;
+    while(0 == (SYSCTL_PRDMA_REG & 0x01));
+
+    UDMA_REGS->CFG        = UDMA_CFG_MASTEN_MASK;
+    UDMA_REGS->CTLBASE    = (uint32)Udma_ControlTable;
+    UDMA_REGS->ENACLR     = 0xFFFFFFFF;
+    UDMA_REGS->ALTCLR     = 0xFFFFFFFF;
+    UDMA_REGS->PRIOCLR    = 0xFFFFFFFF;
+    UDMA_REGS->REQMASKCLR = 0xFFFFFFFF;
+    UDMA_REGS->CHIS       = 0xFFFFFFFF;
+}
+
+/*************************************************************************************
+* Service Name      : Udma_AssignChannel
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Channel - Channel, a_Encoding - Peripheral of the channel in the map registers
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Each channel has a 4-bit field in UDMA_CHMAP0 .. UDMA_CHMAP3. The channel is left
+*                     disabled and its next transfer starts from the primary structure.
+**************************************************************************************/
+void Udma_AssignChannel(Udma_ChannelType a_Channel, uint8 a_Encoding)
+{
+    uint8 Shift = (a_Channel % UDMA_CHMAP_FIELDS) * UDMA_CHMAP_FIELD_BITS;
+    volatile uint32 *Map;
+
+    if(a_Channel >= UDMA_CHANNELS)
+    {
+        return; /* Report an Error */
+    }
+
+    Map = &UDMA_REGS->CHMAP[a_Channel / UDMA_CHMAP_FIELDS];
+    UDMA_REGS->ENACLR = UDMA_CHANNEL_MASK(a_Channel);
+    UDMA_REGS->ALTCLR = UDMA_CHANNEL_MASK(a_Channel);
+    *Map = (*Map & ~((uint32)0xF << Shift)) | ((uint32)(a_Encoding & 0xF) << Shift);
+}
+
+/*************************************************************************************
+* Service Name      : Udma_SetTransfer
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant for different channels
+* Parameters (in)   : a_Channel - Channel, a_Structure - Primary or alternate, a_Control - UDMA_CONTROL(),
+*                     a_Source - First source item, a_Destination - First destination item, a_Items - 1 .. 1024
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : FALSE if the item count is out of range
+* Description       : The control word is written last, the structure is not used before its mode is set
+**************************************************************************************/
+boolean Udma_SetTransfer(Udma_ChannelType a_Channel, Udma_StructureType a_Structure, uint32 a_Control,
+                         volatile const void *a_Source, volatile void *a_Destination, uint16 a_Items)
+{
+    UDMA_ChannelControlType *Entry;
+
+    if((a_Channel >= UDMA_CHANNELS) || (a_Items == 0) || (a_Items > UDMA_MAX_ITEMS))
+    {
+        return FALSE; /* Report an Error */
+    }
+
+    Entry = UDMA_ENTRY(a_Channel, a_Structure);
+    Entry->SRCENDP = Udma_EndPointer(a_Source, (a_Control >> UDMA_CHCTL_SRCINC_BITS_POS) & UDMA_INC_MASK, a_Items);
+    Entry->DSTENDP = Udma_EndPointer(a_Destination, (a_Control >> UDMA_CHCTL_DSTINC_BITS_POS) & UDMA_INC_MASK, a_Items);
+    Udma_Rearm(a_Channel, a_Structure, a_Control, a_Items);
+
+    return TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : Udma_Rearm
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant for different channels
+* Parameters (in)   : a_Channel - Channel, a_Structure - Primary or alternate, a_Control - UDMA_CONTROL(),
+*                     a_Items - Items of the transfer
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : The controller never moves the end pointers, a completed structure only lost its item
+*                     count and its mode. One store re-arms it, cheap enough for the completion interrupt.
+**************************************************************************************/
+void Udma_Rearm(Udma_ChannelType a_Channel, Udma_StructureType a_Structure, uint32 a_Control, uint16 a_Items)
+{
+    UDMA_ENTRY(a_Channel, a_Structure)->CHCTL = (a_Control & ~(uint32)UDMA_CHCTL_XFERSIZE_MASK) |
+                                                ((uint32)(a_Items - 1) << UDMA_CHCTL_XFERSIZE_BITS_POS);
+}
+
+/*************************************************************************************
+* Service Name      : Udma_GetMode
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Channel - Channel, a_Structure - Primary or alternate
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : Transfer mode of the structure, UDMA_MODE_STOP once it completed
+* Description       : The controller writes the mode back as STOP when the structure completes
+**************************************************************************************/
+uint8 Udma_GetMode(Udma_ChannelType a_Channel, Udma_StructureType a_Structure)
+{
+    return (uint8)(UDMA_ENTRY(a_Channel, a_Structure)->CHCTL & UDMA_CHCTL_XFERMODE_MASK);
+}
+
+/*************************************************************************************
+* Service Name      : Udma_EnableChannel
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Channel - Channel
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Start serving the requests of the channel
+**************************************************************************************/
+void Udma_EnableChannel(Udma_ChannelType a_Channel)
+{
+    UDMA_REGS->ENASET = UDMA_CHANNEL_MASK(a_Channel);
+}
+
+/*************************************************************************************
+* Service Name      : Udma_DisableChannel
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Channel - Channel
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Stop serving the requests of the channel
+**************************************************************************************/
+void Udma_DisableChannel(Udma_ChannelType a_Channel)
+{
+    UDMA_REGS->ENACLR = UDMA_CHANNEL_MASK(a_Channel);
+}
+
+/*************************************************************************************
+* Service Name      : Udma_IsChannelEnabled
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Channel - Channel
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : FALSE once the controller stopped the channel on a completed structure
+* Description       : ENASET reads back the enable state of the channels
+**************************************************************************************/
+boolean Udma_IsChannelEnabled(Udma_ChannelType a_Channel)
+{
+    return (UDMA_REGS->ENASET & UDMA_CHANNEL_MASK(a_Channel)) ? TRUE : FALSE;
+}
+
+/*************************************************************************************
+* Service Name      : Udma_ClearDone
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Channel - Channel
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : UDMA_CHIS is write 1 to clear
+**************************************************************************************/
+void Udma_ClearDone(Udma_ChannelType a_Channel)
+{
+    UDMA_REGS->CHIS = UDMA_CHANNEL_MASK(a_Channel);
+}
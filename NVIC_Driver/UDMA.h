@@ -0,0 +1,149 @@
+/******************************************************************************
+ *
+ * Module: UDMA
+ *
+ * File Name: UDMA.h
+ *
+ * Description: Header file for the micro DMA controller, channel control table and ping-pong transfers
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef UDMA_H_
+#define UDMA_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define UDMA_CHANNELS                     32
+#define UDMA_TABLE_ALIGN                  1024   /* CTLBASE ignores the low 10 bits */
+#define UDMA_MAX_ITEMS                    1024   /* Items of one transfer */
+
+#define UDMA_CFG_MASTEN_MASK              0x00000001
+
+/* Channel control word */
+#define UDMA_CHCTL_DSTINC_BITS_POS        30
+#define UDMA_CHCTL_DSTSIZE_BITS_POS       28
+#define UDMA_CHCTL_SRCINC_BITS_POS        26
+#define UDMA_CHCTL_SRCSIZE_BITS_POS       24
+#define UDMA_CHCTL_ARBSIZE_BITS_POS       14     /* 2^ARBSIZE items per arbitration */
+#define UDMA_CHCTL_XFERSIZE_BITS_POS      4      /* Items - 1, counts down while the transfer runs */
+#define UDMA_CHCTL_XFERSIZE_MASK          0x00003FF0
+#define UDMA_CHCTL_XFERMODE_MASK          0x00000007
+
+#define UDMA_INC_MASK                     0x3
+
+/* Item sizes and address increments, log2 of the bytes */
+#define UDMA_SIZE_8                       0
+#define UDMA_SIZE_16                      1
+#define UDMA_SIZE_32                      2
+#define UDMA_INC_NONE                     3      /* Fixed address, a peripheral FIFO */
+
+/* Transfer modes */
+#define UDMA_MODE_STOP                    0      /* Completed, or a ping-pong half not re-armed yet */
+#define UDMA_MODE_BASIC                   1
+#define UDMA_MODE_AUTO                    2
+#define UDMA_MODE_PINGPONG                3      /* Switch to the other structure when this one completes */
+
+#define UDMA_CONTROL(DstInc, SrcInc, Size, ArbLog2, Mode) \
+    (((uint32)(DstInc) << UDMA_CHCTL_DSTINC_BITS_POS) | ((uint32)(Size) << UDMA_CHCTL_DSTSIZE_BITS_POS) | \
+     ((uint32)(SrcInc) << UDMA_CHCTL_SRCINC_BITS_POS) | ((uint32)(Size) << UDMA_CHCTL_SRCSIZE_BITS_POS) | \
+     ((uint32)(ArbLog2) << UDMA_CHCTL_ARBSIZE_BITS_POS) | (uint32)(Mode))
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef uint8 Udma_ChannelType;
+
+typedef enum
+{
+    UDMA_PRIMARY,
+    UDMA_ALTERNATE
+}Udma_StructureType;
+
+/* Primary structures of the 32 channels followed by the alternate ones */
+extern UDMA_ChannelControlType Udma_ControlTable[2 * UDMA_CHANNELS];
+
+
+/*************************************************************************************
+* Service Name   : Udma_Init
+* Description    : Enable the uDMA clock and the controller and point it at the control table
+**************************************************************************************/
+extern void Udma_Init(void);
+
+/*************************************************************************************
+* Service Name   : Udma_AssignChannel
+* Parameters (in): a_Channel - Channel, a_Encoding - Peripheral of the channel in the map registers
+* Description    : Select which peripheral drives the requests of the channel, the channel restarts on its primary structure
+**************************************************************************************/
+extern void Udma_AssignChannel(Udma_ChannelType a_Channel, uint8 a_Encoding);
+
+/*************************************************************************************
+* Service Name   : Udma_SetTransfer
+* Parameters (in): a_Channel - Channel, a_Structure - Primary or alternate, a_Control - UDMA_CONTROL(),
+*                  a_Source - First source item, a_Destination - First destination item, a_Items - 1 .. 1024
+* Return value   : FALSE if the item count is out of range
+* Description    : Fill one control structure, the end pointers follow from the increments of a_Control
+**************************************************************************************/
+extern boolean Udma_SetTransfer(Udma_ChannelType a_Channel, Udma_StructureType a_Structure, uint32 a_Control,
+                                volatile const void *a_Source, volatile void *a_Destination, uint16 a_Items);
+
+/*************************************************************************************
+* Service Name   : Udma_Rearm
+* Parameters (in): a_Channel - Channel, a_Structure - Primary or alternate, a_Control - UDMA_CONTROL(),
+*                  a_Items - Items of the transfer
+* Description    : Restart a completed structure on the same buffers, only the control word is rewritten
+**************************************************************************************/
+extern void Udma_Rearm(Udma_ChannelType a_Channel, Udma_StructureType a_Structure, uint32 a_Control, uint16 a_Items);
+
+/*************************************************************************************
+* Service Name   : Udma_GetMode
+* Parameters (in): a_Channel - Channel, a_Structure - Primary or alternate
+* Return value   : Transfer mode of the structure, UDMA_MODE_STOP once it completed
+* Description    : Tell which half of a ping-pong transfer is done
+**************************************************************************************/
+extern uint8 Udma_GetMode(Udma_ChannelType a_Channel, Udma_StructureType a_Structure);
+
+/*************************************************************************************
+* Service Name   : Udma_EnableChannel
+* Parameters (in): a_Channel - Channel
+* Description    : Start serving the requests of the channel
+**************************************************************************************/
+extern void Udma_EnableChannel(Udma_ChannelType a_Channel);
+
+/*************************************************************************************
+* Service Name   : Udma_DisableChannel
+* Parameters (in): a_Channel - Channel
+* Description    : Stop serving the requests of the channel
+**************************************************************************************/
+extern void Udma_DisableChannel(Udma_ChannelType a_Channel);
+
+/*************************************************************************************
+* Service Name   : Udma_IsChannelEnabled
+* Parameters (in): a_Channel - Channel
+* Return value   : FALSE once the controller stopped the channel on a completed structure
+* Description    : Detect a ping-pong transfer that ran into a half not re-armed in time
+**************************************************************************************/
+extern boolean Udma_IsChannelEnabled(Udma_ChannelType a_Channel);
+
+/*************************************************************************************
+* Service Name   : Udma_ClearDone
+* Parameters (in): a_Channel - Channel
+* Description    : Acknowledge the completion flag raised in the peripheral interrupt
+**************************************************************************************/
+extern void Udma_ClearDone(Udma_ChannelType a_Channel);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* UDMA_H_ */
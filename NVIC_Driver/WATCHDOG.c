@@ -0,0 +1,396 @@
+/*
+ * WATCHDOG.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Muhamed Amr
+ */
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "tm4c123gh6pm_registers.h"
+#include "NVIC.h"
+#include "SYSTICK.h"
+#include "CLOCK.h"
+#include "WATCHDOG.h"
+
+#define WATCHDOG_NVIC_BANKS               5
+#define WATCHDOG_RETTOBASE_MASK           0x00000800  /* INTCTRL: no other active exception */
+#define WATCHDOG_HARD_FAULT_EXCEPTION     3
+#define WATCHDOG_IRQ_EXCEPTION_BASE       16
+#define WATCHDOG_SYSTEM_HANDLERS          7
+#define WATCHDOG_MAX_LOAD                 0xFFFFFFFFULL
+
+/*******************************************************************************
+ *                           Private Data Types                                *
+ *******************************************************************************/
+typedef struct
+{
+    volatile uint32 LastTick;             /* SysTick count of the last check-in */
+    volatile boolean Early;               /* A check-in came before MinTicks */
+    uint8 Kind;
+    uint8 Ident;
+    uint16 MinTicks;
+    uint16 MaxTicks;
+}Watchdog_ClientStateType;
+
+/* System handler active bit in SYSHNDCTRL, exception number and SYSPRI index */
+typedef struct
+{
+    uint32 ActiveMask;
+    uint8 Exception;
+    uint8 SysPriIndex;
+}Watchdog_SystemHandlerType;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+#pragma DATA_SECTION(Watchdog_Report, ".noinit")
+static Watchdog_ReportType Watchdog_Report;
+
+static Watchdog_ReportType Watchdog_LastReport;
+static boolean Watchdog_LastReportValid = FALSE;
+static Watchdog_ClientStateType Watchdog_Clients[WATCHDOG_MAX_CLIENTS];
+static volatile uint8 Watchdog_ClientsCount = 0;
+static uint16 Watchdog_TimeoutMs = 0;
+
+static const Watchdog_SystemHandlerType Watchdog_SystemHandlers[WATCHDOG_SYSTEM_HANDLERS] =
+{
+    { 0x00000001,  4, MEM_FAULT_SYSPRI_INDEX     },
+    { 0x00000002,  5, BUS_FAULT_SYSPRI_INDEX     },
+    { 0x00000008,  6, USAGE_FAULT_SYSPRI_INDEX   },
+    { 0x00000080, 11, SVC_SYSPRI_INDEX           },
+    { 0x00000100, 12, DEBUG_MONITOR_SYSPRI_INDEX },
+    { 0x00000400, 14, PENDSV_SYSPRI_INDEX        },
+    { 0x00000800, 15, SYSTICK_SYSPRI_INDEX       }
+};
+
+/*******************************************************************************
+ *                       Private Functions Definitions                         *
+ *******************************************************************************/
+
+/* Core clocks of a_TimeoutMs, 65535 ms at 80 MHz do not fit 32 bits */
+static uint64 Watchdog_Clocks(uint16 a_TimeoutMs)
+{
+    return (uint64)a_TimeoutMs * (Clock_GetCoreClock() / 1000);
+}
+
+/* WDT0 counts core clocks, LOAD and ICR are written unlocked then locked again. A time-out longer
+ * than the 32-bit counter after a clock change is cut to the longest one */
+static void Watchdog_Load(void)
+{
+    volatile WDT_RegType *Wdt = WDT(WATCHDOG_TIMER);
+    uint64 Clocks = Watchdog_Clocks(Watchdog_TimeoutMs);
+
+    Wdt->LOCK = WATCHDOG_UNLOCK_KEY;
+    Wdt->LOAD = (Clocks > WATCHDOG_MAX_LOAD) ? (uint32)WATCHDOG_MAX_LOAD : (uint32)Clocks;
+    Wdt->LOCK = WATCHDOG_LOCK_KEY;
+}
+
+/*
+ * Nested handlers always have strictly higher priorities, the active exception of highest priority
+ * is the one the NMI interrupted. Nothing found while RETTOBASE says another exception is active
+ * means the hard fault handler, which has no active bit.
+ */
+static uint8 Watchdog_StuckException(void)
+{
+    uint8 Best = 0;
+    uint8 BestLevel = NVIC_MAX_PRIORITY + 1;
+    uint32 Active;
+    uint8 Level;
+    uint8 Irq;
+    uint8 Index;
+
+    for(Irq = 0; Irq <= NVIC_MAX_IRQ_NUM; Irq++)
+    {
+        Active = NVIC_REGS->ACTIVE[Irq / NVIC_IRQ_BANK_BITS];
+        Level  = NVIC_REGS->PRI[Irq] >> NVIC_IRQ_PRIORITY_BITS_POS;
+        if((Active & (1UL << (Irq % NVIC_IRQ_BANK_BITS))) && (Level < BestLevel))
+        {
+            Best      = WATCHDOG_IRQ_EXCEPTION_BASE + Irq;
+            BestLevel = Level;
+        }
+    }
+    for(Index = 0; Index < WATCHDOG_SYSTEM_HANDLERS; Index++)
+    {
+        Level = SCB_REGS->SYSPRI[Watchdog_SystemHandlers[Index].SysPriIndex] >> NVIC_IRQ_PRIORITY_BITS_POS;
+        if((SCB_REGS->SYSHNDCTRL & Watchdog_SystemHandlers[Index].ActiveMask) && (Level < BestLevel))
+        {
+            Best      = Watchdog_SystemHandlers[Index].Exception;
+            BestLevel = Level;
+        }
+    }
+    if((Best == 0) && (0 == (SCB_REGS->INTCTRL & WATCHDOG_RETTOBASE_MASK)))
+    {
+        Best = WATCHDOG_HARD_FAULT_EXCEPTION;
+    }
+    return Best;
+}
+
+/*************************************************************************************
+* Service Name      : Watchdog_Init
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_TimeoutMs - Hardware time-out, a_TickMs - SysTick period
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : FALSE if the time-out is not longer than two ticks, does not fit the 32-bit counter
+*                     at the current core clock (about 53 s at 80 MHz) or WDT0 did not start
+* Description       : The first time-out raises an NMI that records what was running, the second one
+*                     resets the core. The counter stalls while the debugger halts the core. INTEN can
+*                     not be cleared once set, the watchdog then runs until the next reset.
+**************************************************************************************/
+boolean Watchdog_Init(uint16 a_TimeoutMs, uint16 a_TickMs)
+{
+    volatile WDT_RegType *Wdt = WDT(WATCHDOG_TIMER);
+    uint32 Timeout = WATCHDOG_READY_TIMEOUT;
+
+    if((Watchdog_Report.Magic == WATCHDOG_REPORT_MAGIC) && (SYSCTL_RESC_REG & WATCHDOG_RESC_WDT0_MASK))
+    {
+        Watchdog_LastReport      = Watchdog_Report;
+        Watchdog_LastReportValid = TRUE;
+    }
+    SYSCTL_RESC_REG &= ~WATCHDOG_RESC_WDT0_MASK;
+    Watchdog_Report.Magic = 0;
+
+    if((a_TimeoutMs <= (2 * (uint32)a_TickMs)) || (Watchdog_Clocks(a_TimeoutMs) > WATCHDOG_MAX_LOAD))
+    {
+        return FALSE; /* Report an Error */
+    }
+
+    SYSCTL_RCGCWD_REG |= WATCHDOG_RCGC_MASK;
+    while((0 == (SYSCTL_PRWD_REG & WATCHDOG_RCGC_MASK)) && (Timeout != 0))
+    {
+        Timeout--;
+    }
+    if(Timeout == 0)
+    {
+        return FALSE; /* Report an Error */
+    }
+
+    Watchdog_TimeoutMs = a_TimeoutMs;
+    Watchdog_Load();
+    Wdt->LOCK = WATCHDOG_UNLOCK_KEY;
+    Wdt->TEST |= WATCHDOG_TEST_STALL_MASK;
+    Wdt->CTL   = WATCHDOG_CTL_INTTYPE_MASK | WATCHDOG_CTL_RESEN_MASK; /* INTTYPE must be set before INTEN */
+    Wdt->CTL  |= WATCHDOG_CTL_INTEN_MASK;
+    Wdt->LOCK  = WATCHDOG_LOCK_KEY;
+
+    Clock_RegisterNotifier(Watchdog_ClockChanged);
+    SysTick_RegisterTickHook(Watchdog_Tick);
+    return TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : Watchdog_Register
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Kind - Task or ISR, a_Ident - Task priority or IRQ number,
+*                     a_MinTicks, a_MaxTicks - Window of the time between two check-ins
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : Client handle, WATCHDOG_INVALID_CLIENT if the table is full
+* Description       : The client is filled before the count is published, the tick hook never sees a
+*                     half registered client.
+**************************************************************************************/
+Watchdog_ClientType Watchdog_Register(Watchdog_ClientKindType a_Kind, uint8 a_Ident, uint16 a_MinTicks, uint16 a_MaxTicks)
+{
+    Watchdog_ClientStateType *Client;
+    uint8 Index = Watchdog_ClientsCount;
+
+    if((Index >= WATCHDOG_MAX_CLIENTS) || (a_MaxTicks == 0) || (a_MinTicks > a_MaxTicks))
+    {
+        return WATCHDOG_INVALID_CLIENT; /* Report an Error */
+    }
+    Client = &Watchdog_Clients[Index];
+    Client->Kind     = (uint8)a_Kind;
+    Client->Ident    = a_Ident;
+    Client->MinTicks = a_MinTicks;
+    Client->MaxTicks = a_MaxTicks;
+    Client->Early    = FALSE;
+    Client->LastTick = SysTick_GetTickCount();
+    Watchdog_ClientsCount = Index + 1;
+
+    return Index;
+}
+
+/*************************************************************************************
+* Service Name      : Watchdog_CheckIn
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : a_Client - Client handle
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : One load and two stores, each client checks in from a single context.
+**************************************************************************************/
+void Watchdog_CheckIn(Watchdog_ClientType a_Client)
+{
+    Watchdog_ClientStateType *Client;
+    uint32 Now = SysTick_GetTickCount();
+
+    if(a_Client >= Watchdog_ClientsCount)
+    {
+        return; /* Report an Error */
+    }
+    Client = &Watchdog_Clients[a_Client];
+    if((Now - Client->LastTick) < Client->MinTicks)
+    {
+        Client->Early = TRUE;
+    }
+    Client->LastTick = Now;
+}
+
+/*************************************************************************************
+* Service Name      : Watchdog_Supervise
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_Now - SysTick count
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : TRUE if every client is healthy and the hardware may be fed
+* Description       : The first fault is latched, the hardware is never fed again and the NMI of the
+*                     first time-out completes the report with the exception it interrupted.
+**************************************************************************************/
+boolean Watchdog_Supervise(uint32 a_Now)
+{
+    const Watchdog_ClientStateType *Client;
+    Watchdog_FaultType Fault;
+    uint8 Count = Watchdog_ClientsCount;
+    uint8 Index;
+
+    if(Watchdog_Report.Magic == WATCHDOG_REPORT_MAGIC)
+    {
+        return FALSE; /* Latched */
+    }
+    for(Index = 0; Index < Count; Index++)
+    {
+        Client = &Watchdog_Clients[Index];
+        Fault  = WATCHDOG_FAULT_NONE;
+        if(Client->Early)
+        {
+            Fault = WATCHDOG_FAULT_EARLY;
+        }
+        else if((a_Now - Client->LastTick) > Client->MaxTicks)
+        {
+            Fault = WATCHDOG_FAULT_LATE;
+        }
+        else
+        {
+            continue;
+        }
+        Watchdog_Report.Tick           = a_Now;
+        Watchdog_Report.Client         = Index;
+        Watchdog_Report.Kind           = Client->Kind;
+        Watchdog_Report.Ident          = Client->Ident;
+        Watchdog_Report.Fault          = (uint8)Fault;
+        Watchdog_Report.StuckException = 0;
+        Watchdog_Report.Magic          = WATCHDOG_REPORT_MAGIC;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : Watchdog_Tick
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Runs in the SysTick handler: a stuck ISR of equal or higher priority stops the
+*                     feeding by itself, a stuck task or lower priority ISR misses its window.
+**************************************************************************************/
+void Watchdog_Tick(void)
+{
+    volatile WDT_RegType *Wdt = WDT(WATCHDOG_TIMER);
+
+    if(Watchdog_Supervise(SysTick_GetTickCount()))
+    {
+        Wdt->LOCK = WATCHDOG_UNLOCK_KEY;
+        Wdt->ICR  = 0; /* Any write reloads the counter */
+        Wdt->LOCK = WATCHDOG_LOCK_KEY;
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Watchdog_ClockChanged
+* Sync/Async        : Synchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : a_CoreClockHz - New core clock
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : Clock notifier, keep the time-out in milliseconds after a core clock change. At a
+*                     faster clock a time-out beyond the 32-bit counter is cut to 2^32 - 1 clocks.
+**************************************************************************************/
+void Watchdog_ClockChanged(uint32 a_CoreClockHz)
+{
+    (void)a_CoreClockHz; /* Read back through Clock_GetCoreClock() by Watchdog_Load */
+    if(Watchdog_TimeoutMs != 0)
+    {
+        Watchdog_Load();
+    }
+}
+
+/*************************************************************************************
+* Service Name      : Watchdog_GetLastReport
+* Sync/Async        : Synchronous
+* Reentrancy        : Reentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : a_Report - Report of the watchdog reset
+* Return value      : TRUE if the last reset was caused by WDT0
+* Description       : Read what was stuck before the last watchdog reset
+**************************************************************************************/
+boolean Watchdog_GetLastReport(Watchdog_ReportType *a_Report)
+{
+    if((a_Report == NULL_PTR) || !Watchdog_LastReportValid)
+    {
+        return FALSE;
+    }
+    *a_Report = Watchdog_LastReport;
+    return TRUE;
+}
+
+/*************************************************************************************
+* Service Name      : NMI_Handler
+* Sync/Async        : Asynchronous
+* Reentrancy        : Unreentrant
+* Parameters (in)   : None
+* Parameters (inout): None
+* Parameters (out)  : None
+* Return value      : None
+* Description       : The NMI preempts every handler, even a stuck one masking the SysTick. On the WDT0
+*                     first time-out the report is completed and the core waits for the reset of the
+*                     second time-out. Any other NMI stops here as before.
+**************************************************************************************/
+void NMI_Handler(void)
+{
+    uint8 Bank;
+
+    if(WDT(WATCHDOG_TIMER)->MIS & WATCHDOG_MIS_MASK)
+    {
+        if(Watchdog_Report.Magic != WATCHDOG_REPORT_MAGIC)
+        {
+            Watchdog_Report.Tick   = SysTick_GetTickCount();
+            Watchdog_Report.Client = WATCHDOG_INVALID_CLIENT;
+            Watchdog_Report.Kind   = 0;
+            Watchdog_Report.Ident  = 0;
+            Watchdog_Report.Fault  = (uint8)WATCHDOG_FAULT_TIMEOUT;
+        }
+        Watchdog_Report.StuckException = Watchdog_StuckException();
+        for(Bank = 0; Bank < WATCHDOG_NVIC_BANKS; Bank++)
+        {
+            Watchdog_Report.Active[Bank] = NVIC_REGS->ACTIVE[Bank];
+        }
+        Watchdog_Report.SysHndCtrl = SCB_REGS->SYSHNDCTRL;
+        Watchdog_Report.Magic      = WATCHDOG_REPORT_MAGIC;
+    }
+
+    while(1)
+    {
+        /* Stop here */
+    }
+}
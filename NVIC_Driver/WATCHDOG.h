@@ -0,0 +1,138 @@
+/******************************************************************************
+ *
+ * Module: Watchdog
+ *
+ * File Name: WATCHDOG.h
+ *
+ * Description: Header file for the watchdog supervisor, the hardware watchdog is fed only while
+ *              every registered task and ISR checks in within its window
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef WATCHDOG_H_
+#define WATCHDOG_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define WATCHDOG_MAX_CLIENTS              8
+#define WATCHDOG_INVALID_CLIENT           0xFF
+
+#define WATCHDOG_TIMER                    0           /* WDT0, clocked by the system clock */
+#define WATCHDOG_RCGC_MASK                0x01        /* WDT0 bit in SYSCTL_RCGCWD_REG / SYSCTL_PRWD_REG */
+#define WATCHDOG_READY_TIMEOUT            100000
+
+#define WATCHDOG_UNLOCK_KEY               0x1ACCE551
+#define WATCHDOG_LOCK_KEY                 0x00000000
+#define WATCHDOG_CTL_INTEN_MASK           0x00000001  /* Starts the counter, cleared by reset only */
+#define WATCHDOG_CTL_RESEN_MASK           0x00000002  /* Reset on the second time-out */
+#define WATCHDOG_CTL_INTTYPE_MASK         0x00000004  /* First time-out raises an NMI */
+#define WATCHDOG_MIS_MASK                 0x00000001
+#define WATCHDOG_TEST_STALL_MASK          0x00000100
+#define WATCHDOG_RESC_WDT0_MASK           0x00000008  /* Reset cause in SYSCTL_RESC_REG */
+
+#define WATCHDOG_REPORT_MAGIC             0x31474457  /* "WDG1" */
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef uint8 Watchdog_ClientType;
+
+typedef enum
+{
+    WATCHDOG_CLIENT_TASK,                 /* Ident is the task priority */
+    WATCHDOG_CLIENT_ISR                   /* Ident is the IRQ number */
+}Watchdog_ClientKindType;
+
+typedef enum
+{
+    WATCHDOG_FAULT_NONE,
+    WATCHDOG_FAULT_LATE,                  /* No check-in within MaxTicks */
+    WATCHDOG_FAULT_EARLY,                 /* Check-in before MinTicks, the client runs away */
+    WATCHDOG_FAULT_TIMEOUT                /* Hardware time-out while the supervisor saw no fault, it did not run */
+}Watchdog_FaultType;
+
+/* Kept in .noinit across the watchdog reset */
+typedef struct
+{
+    uint32 Magic;
+    uint32 Tick;                          /* SysTick count when the fault was detected */
+    uint8  Client;                        /* WATCHDOG_INVALID_CLIENT for WATCHDOG_FAULT_TIMEOUT */
+    uint8  Kind;                          /* Watchdog_ClientKindType of the client */
+    uint8  Ident;                         /* Task priority or IRQ number of the client */
+    uint8  Fault;                         /* Watchdog_FaultType */
+    uint8  StuckException;                /* Exception running at the first hardware time-out, 0 thread mode */
+    uint8  Reserved[3];
+    uint32 Active[5];                     /* NVIC ACTIVE registers at the first hardware time-out */
+    uint32 SysHndCtrl;                    /* System handlers active bits at the first hardware time-out */
+}Watchdog_ReportType;
+
+
+/*************************************************************************************
+* Service Name   : Watchdog_Init
+* Parameters (in): a_TimeoutMs - Hardware time-out, a_TickMs - SysTick period
+* Return value   : FALSE if the time-out is not longer than two ticks, does not fit the 32-bit counter
+*                  or WDT0 did not start
+* Description    : Keep the report of a previous watchdog reset, start WDT0 and supervise on every tick
+**************************************************************************************/
+extern boolean Watchdog_Init(uint16 a_TimeoutMs, uint16 a_TickMs);
+
+/*************************************************************************************
+* Service Name   : Watchdog_Register
+* Parameters (in): a_Kind - Task or ISR, a_Ident - Task priority or IRQ number,
+*                  a_MinTicks, a_MaxTicks - Window of the time between two check-ins
+* Return value   : Client handle, WATCHDOG_INVALID_CLIENT if the table is full
+* Description    : Add a supervised client, its window starts now
+**************************************************************************************/
+extern Watchdog_ClientType Watchdog_Register(Watchdog_ClientKindType a_Kind, uint8 a_Ident, uint16 a_MinTicks, uint16 a_MaxTicks);
+
+/*************************************************************************************
+* Service Name   : Watchdog_CheckIn
+* Parameters (in): a_Client - Client handle
+* Description    : Report progress, callable from the client task or ISR
+**************************************************************************************/
+extern void Watchdog_CheckIn(Watchdog_ClientType a_Client);
+
+/*************************************************************************************
+* Service Name   : Watchdog_Supervise
+* Parameters (in): a_Now - SysTick count
+* Return value   : TRUE if every client is healthy and the hardware may be fed
+* Description    : Check the windows of all the clients, the first fault is latched in the report
+**************************************************************************************/
+extern boolean Watchdog_Supervise(uint32 a_Now);
+
+/*************************************************************************************
+* Service Name   : Watchdog_Tick
+* Description    : SysTick hook, feed WDT0 while Watchdog_Supervise reports healthy
+**************************************************************************************/
+extern void Watchdog_Tick(void);
+
+/*************************************************************************************
+* Service Name   : Watchdog_ClockChanged
+* Parameters (in): a_CoreClockHz - New core clock
+* Description    : Clock notifier, rescale the WDT0 reload value
+**************************************************************************************/
+extern void Watchdog_ClockChanged(uint32 a_CoreClockHz);
+
+/*************************************************************************************
+* Service Name   : Watchdog_GetLastReport
+* Parameters (out): a_Report - Report of the watchdog reset
+* Return value   : TRUE if the last reset was caused by WDT0
+* Description    : Read what was stuck before the last watchdog reset
+**************************************************************************************/
+extern boolean Watchdog_GetLastReport(Watchdog_ReportType *a_Report);
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* WATCHDOG_H_ */
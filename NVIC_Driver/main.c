@@ -5,6 +5,15 @@
  */
 #include "SysTick.h"
 #include "NVIC.h"
+#include "SCHEDULER.h"
+#include "TRACE.h"
+#include "POWER.h"
+#include "CLOCK.h"
+#include "BOOT.h"
+#include "FPU.h"
+#include "LOG.h"
+#include "LOAD.h"
+#include "WATCHDOG.h"
 #include "tm4c123gh6pm_registers.h"
 #include <assert.h>
 
@@ -16,6 +25,32 @@
 #define PENDSV_EXCEPTION_PRIORITY           6
 #define SYSTICK_EXCEPTION_PRIORITY          7
 
+#define LED_TASK_PRIORITY                   1
+#define LED_TASK_STACK_WORDS                128
+#define LED_TOGGLE_TICKS                    (1000 / SCHEDULER_TICK_MS)
+
+#define WATCHDOG_TIMEOUT_MS                 500
+
+SCHEDULER_STACK(Led_TaskStack, LED_TASK_STACK_WORDS);
+
+static Watchdog_ClientType Led_WatchdogClient = WATCHDOG_INVALID_CLIENT;
+
+/* Keep only PORTF (LEDs) clocked while sleeping, nothing is clocked in deep-sleep */
+static const Power_ConfigType Power_Config =
+{
+    { 0, 0, 0x20, 0, 0, 0, 0, 0, 0 },
+    { 0, 0, 0,    0, 0, 0, 0, 0, 0 },
+    POWER_DSLPCLKCFG_PIOSC
+};
+
+/* Peripherals of the application, their clocks are enabled together at start-up */
+static const Boot_ConfigType Boot_Config =
+{
+    { [BOOT_CLOCK_GPIO] = 0x20 },         /* PORTF (LEDs) */
+    NULL_PTR,
+    0
+};
+
 /* Enable PF1, PF2 and PF3 (RED, Blue and Green LEDs) */
 void Leds_Init(void)
 {
@@ -79,11 +114,35 @@ void Test_Exceptions_Settings(void)
     assert(((NVIC_SYSTEM_PRI3_REG & SYSTICK_PRIORITY_MASK) >> SYSTICK_PRIORITY_BITS_POS) == SYSTICK_EXCEPTION_PRIORITY);
 }
 
+/* Cycle the RED, Blue and Green LEDs every 1 second */
+void Led_Task(void)
+{
+    while(1)
+    {
+        GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x02; /* Turn on the Red LED and disable the others */
+        Scheduler_Delay(LED_TOGGLE_TICKS); /* Sleep 1 second */
+        Watchdog_CheckIn(Led_WatchdogClient);
+        GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x04; /* Turn on the Blue LED and disable the others */
+        Scheduler_Delay(LED_TOGGLE_TICKS); /* Sleep 1 second */
+        Watchdog_CheckIn(Led_WatchdogClient);
+        GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x08; /* Turn on the Green LED and disable the others */
+        Scheduler_Delay(LED_TOGGLE_TICKS); /* Sleep 1 second */
+        Watchdog_CheckIn(Led_WatchdogClient);
+    }
+}
+
 int main(void)
 {
-    /* Enable clock for PORTF and wait for clock to start */
-    SYSCTL_RCGCGPIO_REG |= 0x20;
-    while(!(SYSCTL_PRGPIO_REG & 0x20));
+    Watchdog_ReportType Watchdog_LastReset;
+
+    Boot_Mark(BOOT_MILESTONE_MAIN);
+
+    /* Run the core at the maximum PLL frequency, SysTick and the other timing users are rescaled */
+    (void)Clock_SetCoreClock(CLOCK_MAX_HZ);
+    Boot_Mark(BOOT_MILESTONE_CLOCK);
+
+    /* Enable the clocks of all the used peripherals and wait for them to start */
+    (void)Boot_BringUp(&Boot_Config);
 
     /* Initialize the LEDs as GPIO Pins */
     Leds_Init();
@@ -95,13 +154,34 @@ int main(void)
     /* Test all System and Fault Exceptions settings */
     Test_Exceptions_Settings();
 
-    while(1)
+    /* Lazy FP context stacking, SysTick stays on the basic frame fast path */
+    Fpu_Init(FPU_STACKING_LAZY);
+    Fpu_DeclareFpFree(TRACE_SYSTICK_EXCEPTION_NUM);
+
+    /* Gate the unused peripheral clocks while the CPU sleeps */
+    Power_Init(&Power_Config);
+
+    /* Measure the CPU load from the idle task sleep time */
+    Load_Init(SCHEDULER_TICK_MS);
+
+    /* Record interrupts and task switches in the trace ring */
+    Trace_Init(TRACE_DEFAULT_POLICY);
+
+    /* Tokenized log ring, time stamped with the scheduler ticks and decoded by tools/log_decode */
+    Log_Init(SCHEDULER_TICK_MS);
+
+    /* Reset when the LED task stops checking in once per second, log what was stuck before the last watchdog reset */
+    (void)Watchdog_Init(WATCHDOG_TIMEOUT_MS, SCHEDULER_TICK_MS);
+    if(Watchdog_GetLastReport(&Watchdog_LastReset))
     {
-        GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x02; /* Turn on the Red LED and disable the others */
-        SysTick_StartBusyWait(1000); /* Wait 1 second using SysTick Timer */
-        GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x04; /* Turn on the Blue LED and disable the others */
-        SysTick_StartBusyWait(1000); /* Wait 1 second using SysTick Timer */
-        GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x08; /* Turn on the Green LED and disable the others */
-        SysTick_StartBusyWait(1000); /* Wait 1 second using SysTick Timer */
+        LOG3(LOG_ID_WATCHDOG_RESET, Watchdog_LastReset.Client, Watchdog_LastReset.Fault, Watchdog_LastReset.StuckException);
     }
+    Led_WatchdogClient = Watchdog_Register(WATCHDOG_CLIENT_TASK, LED_TASK_PRIORITY, LED_TOGGLE_TICKS / 2, 2 * LED_TOGGLE_TICKS);
+
+    /* Run the LEDs sequence as a task, the CPU sleeps in the idle task between the toggles */
+    Scheduler_Init();
+    (void)Scheduler_CreateTask(Led_Task, LED_TASK_PRIORITY, Led_TaskStack, LED_TASK_STACK_WORDS);
+    Boot_Mark(BOOT_MILESTONE_READY);
+    LOG1(LOG_ID_BOOT_READY, Boot_GetMilestone(BOOT_MILESTONE_READY).Cycles);
+    Scheduler_Start();
 }
@@ -0,0 +1,56 @@
+/******************************************************************************
+ *
+ * Linker Command file shared by the TM4C123 parts, included by the .cmd file
+ * of the part after it defines PART_TM4C123xx.  The memory map comes from
+ * DEVICE.h, the same description the C sources are compiled with.
+ *
+ * Every build configuration of .cproject excludes this file and the .cmd of
+ * the other part: CCS hands each .cmd of the project to the linker, only the
+ * part .cmd of the active configuration may reach it.
+ *
+ * This is derived from revision 15071 of the TivaWare Library.
+ *
+ *****************************************************************************/
+
+#include "DEVICE.h"
+
+--retain=g_pfnVectors
+
+MEMORY
+{
+    FLASH (RX) : origin = DEVICE_FLASH_BASE, length = DEVICE_FLASH_SIZE - DEVICE_NVM_SIZE
+    /* Top of the flash reserved for the persistent store (NVM.h), never linked */
+    NVM   (R)  : origin = DEVICE_NVM_BASE,   length = DEVICE_NVM_SIZE
+    SRAM (RWX) : origin = DEVICE_SRAM_BASE,  length = DEVICE_SRAM_SIZE
+}
+
+/* The following command line options are set as part of the CCS project.    */
+/* If you are building using the command line, or for some reason want to    */
+/* define them here, you can uncomment and modify these lines as needed.     */
+/* If you are using CCS for building, it is probably better to make any such */
+/* modifications in your CCS project and leave this file alone.              */
+/*                                                                           */
+/* --heap_size=0                                                             */
+/* --stack_size=256                                                          */
+/* --library=rtsv7M4_T_le_eabi.lib                                           */
+
+/* Section allocation in memory */
+
+SECTIONS
+{
+    .intvecs:   > DEVICE_FLASH_BASE
+    .text   :   > FLASH
+    .const  :   > FLASH
+    .cinit  :   > FLASH
+    .pinit  :   > FLASH
+    .init_array : > FLASH
+
+    .vtable :   > DEVICE_SRAM_BASE
+    .data   :   > SRAM
+    .bss    :   > SRAM
+    .noinit :   > SRAM, type = NOINIT     /* Survives a warm reset, WATCHDOG.c */
+    .sysmem :   > SRAM
+    .stack  :   > SRAM
+}
+
+__STACK_TOP = __stack + 512;
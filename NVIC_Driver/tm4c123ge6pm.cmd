@@ -1,45 +1,11 @@
 /******************************************************************************
  *
  * Default Linker Command file for the Texas Instruments TM4C123GE6PM
- *
- * This is derived from revision 15071 of the TivaWare Library.
+ * (128 KB flash, 32 KB SRAM).  Give the compiler the same PART_TM4C123GE6PM
+ * symbol so DEVICE.h describes the part this file links for.  Linked by the
+ * Debug and Release configurations of .cproject.
  *
  *****************************************************************************/
 
---retain=g_pfnVectors
-
-MEMORY
-{
-    FLASH (RX) : origin = 0x00000000, length = 0x00020000
-    SRAM (RWX) : origin = 0x20000000, length = 0x00008000
-}
-
-/* The following command line options are set as part of the CCS project.    */
-/* If you are building using the command line, or for some reason want to    */
-/* define them here, you can uncomment and modify these lines as needed.     */
-/* If you are using CCS for building, it is probably better to make any such */
-/* modifications in your CCS project and leave this file alone.              */
-/*                                                                           */
-/* --heap_size=0                                                             */
-/* --stack_size=256                                                          */
-/* --library=rtsv7M4_T_le_eabi.lib                                           */
-
-/* Section allocation in memory */
-
-SECTIONS
-{
-    .intvecs:   > 0x00000000
-    .text   :   > FLASH
-    .const  :   > FLASH
-    .cinit  :   > FLASH
-    .pinit  :   > FLASH
-    .init_array : > FLASH
-
-    .vtable :   > 0x20000000
-    .data   :   > SRAM
-    .bss    :   > SRAM
-    .sysmem :   > SRAM
-    .stack  :   > SRAM
-}
-
-__STACK_TOP = __stack + 512;
+#define PART_TM4C123GE6PM
+#include "tm4c123.cmd"
@@ -0,0 +1,11 @@
+/******************************************************************************
+ *
+ * Default Linker Command file for the Texas Instruments TM4C123GH6PM
+ * (256 KB flash, 32 KB SRAM).  Give the compiler the same PART_TM4C123GH6PM
+ * symbol so DEVICE.h describes the part this file links for.  Linked by the
+ * Debug_TM4C123GH6PM and Release_TM4C123GH6PM configurations of .cproject.
+ *
+ *****************************************************************************/
+
+#define PART_TM4C123GH6PM
+#include "tm4c123.cmd"
@@ -2,6 +2,7 @@
 #define TM4C123GH6PM_REGISTERS
 
 #include "std_types.h"
+#include <stddef.h>
 
 /*****************************************************************************
 GPIO registers (PORTA)
@@ -200,8 +201,24 @@ System Control Block Registers
 #define NVIC_SYSTEM_PRI3_REG      (*((volatile uint32 *)0xE000ED20))
 #define NVIC_SYSTEM_SYSHNDCTRL    (*((volatile uint32 *)0xE000ED24))
 #define NVIC_SYSTEM_INTCTRL       (*((volatile uint32 *)0xE000ED04))
+#define NVIC_SYSTEM_SYSCTRL       (*((volatile uint32 *)0xE000ED10))
 #define NVIC_SYSTEM_CFGCTRL       (*((volatile uint32 *)0xE000ED14))
 
+/*****************************************************************************
+Data Watchpoint and Trace Registers
+*****************************************************************************/
+#define DWT_CTRL_REG              (*((volatile uint32 *)0xE0001000))
+#define DWT_CYCCNT_REG            (*((volatile uint32 *)0xE0001004))
+#define CORE_DEBUG_DEMCR_REG      (*((volatile uint32 *)0xE000EDFC))
+
+/*****************************************************************************
+Floating Point Unit Registers
+*****************************************************************************/
+#define FPU_CPAC_REG              (*((volatile uint32 *)0xE000ED88))
+#define FPU_FPCC_REG              (*((volatile uint32 *)0xE000EF34))
+#define FPU_FPCA_REG              (*((volatile uint32 *)0xE000EF38))
+#define FPU_FPDSC_REG             (*((volatile uint32 *)0xE000EF3C))
+
 /*****************************************************************************
 MPU Registers
 *****************************************************************************/
@@ -438,5 +455,371 @@ Flash Registers
 #define FLASH_FMPPE2_REG          (*((volatile uint32 *)0x400FE408))
 #define FLASH_FMPPE3_REG          (*((volatile uint32 *)0x400FE40C))
 
+/*****************************************************************************
+Peripheral Register Overlays
+The structures below map whole peripherals, a driver loads the base address
+once and reaches every register with base + offset addressing instead of one
+literal per register. Banked registers are arrays indexed by IRQ, port,
+region or channel. The absolute address macros above stay valid.
+*****************************************************************************/
+
+/* Compile time check of the overlay layouts against the datasheet offsets */
+#define REGISTERS_LAYOUT_ASSERT(Type, Member, Offset) \
+    typedef char Type##_##Member##_Offset_Check[(offsetof(Type, Member) == (Offset)) ? 1 : -1]
+
+/* NVIC, 0xE000E100 */
+typedef struct
+{
+    uint32 EN[5];                 /* 0x000 Interrupt set enable, write 1 to set */
+    uint32 Reserved0[27];
+    uint32 DIS[5];                /* 0x080 Interrupt clear enable, write 1 to clear */
+    uint32 Reserved1[27];
+    uint32 PEND[5];               /* 0x100 Interrupt set pending */
+    uint32 Reserved2[27];
+    uint32 UNPEND[5];             /* 0x180 Interrupt clear pending */
+    uint32 Reserved3[27];
+    uint32 ACTIVE[5];             /* 0x200 Interrupt active bit */
+    uint32 Reserved4[59];
+    uint8  PRI[140];              /* 0x300 One byte per IRQ, priority in bits 7..5 */
+    uint32 Reserved5[669];
+    uint32 SWTRIG;                /* 0xE00 Software trigger interrupt */
+}NVIC_RegType;
+
+REGISTERS_LAYOUT_ASSERT(NVIC_RegType, DIS,    0x080);
+REGISTERS_LAYOUT_ASSERT(NVIC_RegType, PEND,   0x100);
+REGISTERS_LAYOUT_ASSERT(NVIC_RegType, ACTIVE, 0x200);
+REGISTERS_LAYOUT_ASSERT(NVIC_RegType, PRI,    0x300);
+REGISTERS_LAYOUT_ASSERT(NVIC_RegType, SWTRIG, 0xE00);
+
+#define NVIC_REGS                 ((volatile NVIC_RegType *)0xE000E100)
+
+/* System Control Block, 0xE000ED00 */
+typedef struct
+{
+    uint32 CPUID;                 /* 0x00 */
+    uint32 INTCTRL;               /* 0x04 Interrupt control and state */
+    uint32 VTABLE;                /* 0x08 Vector table offset */
+    uint32 APINT;                 /* 0x0C Application interrupt and reset control */
+    uint32 SYSCTRL;               /* 0x10 System control */
+    uint32 CFGCTRL;               /* 0x14 Configuration and control */
+    uint8  SYSPRI[12];            /* 0x18 One byte per system exception, exception number - 4 */
+    uint32 SYSHNDCTRL;            /* 0x24 System handler control and state */
+    uint32 FAULTSTAT;             /* 0x28 Configurable fault status */
+    uint32 HFAULTSTAT;            /* 0x2C Hard fault status */
+    uint32 DEBUGSTAT;             /* 0x30 */
+    uint32 MMADDR;                /* 0x34 Memory management fault address */
+    uint32 FAULTADDR;             /* 0x38 Bus fault address */
+}SCB_RegType;
+
+REGISTERS_LAYOUT_ASSERT(SCB_RegType, SYSPRI,     0x18);
+REGISTERS_LAYOUT_ASSERT(SCB_RegType, SYSHNDCTRL, 0x24);
+REGISTERS_LAYOUT_ASSERT(SCB_RegType, FAULTADDR,  0x38);
+
+#define SCB_REGS                  ((volatile SCB_RegType *)0xE000ED00)
+
+/* SysTick, 0xE000E010 */
+typedef struct
+{
+    uint32 CTRL;                  /* 0x00 Control and status */
+    uint32 RELOAD;                /* 0x04 Reload value */
+    uint32 CURRENT;               /* 0x08 Current value, any write clears it */
+}SYSTICK_RegType;
+
+REGISTERS_LAYOUT_ASSERT(SYSTICK_RegType, CURRENT, 0x08);
+
+#define SYSTICK_REGS              ((volatile SYSTICK_RegType *)0xE000E010)
+
+/* MPU, 0xE000ED90 */
+typedef struct
+{
+    uint32 BASE;                  /* Region base address */
+    uint32 ATTR;                  /* Region attribute and size */
+}MPU_RegionRegType;
+
+typedef struct
+{
+    uint32 TYPE;                  /* 0x00 */
+    uint32 CTRL;                  /* 0x04 */
+    uint32 NUMBER;                /* 0x08 Region number */
+    MPU_RegionRegType REGION[4];  /* 0x0C Region selected by NUMBER, then the three aliases */
+}MPU_RegType;
+
+REGISTERS_LAYOUT_ASSERT(MPU_RegType, REGION, 0x0C);
+REGISTERS_LAYOUT_ASSERT(MPU_RegType, NUMBER, 0x08);
+
+#define MPU_REGS                  ((volatile MPU_RegType *)0xE000ED90)
+
+/* GPIO ports on the APB aperture */
+typedef struct
+{
+    uint32 DATA_MASKED[255];      /* 0x000 Address bits 9..2 mask the written/read pins */
+    uint32 DATA;                  /* 0x3FC All pins */
+    uint32 DIR;                   /* 0x400 */
+    uint32 IS;                    /* 0x404 */
+    uint32 IBE;                   /* 0x408 */
+    uint32 IEV;                   /* 0x40C */
+    uint32 IM;                    /* 0x410 */
+    uint32 RIS;                   /* 0x414 */
+    uint32 MIS;                   /* 0x418 */
+    uint32 ICR;                   /* 0x41C */
+    uint32 AFSEL;                 /* 0x420 */
+    uint32 Reserved0[55];
+    uint32 DR2R;                  /* 0x500 */
+    uint32 DR4R;                  /* 0x504 */
+    uint32 DR8R;                  /* 0x508 */
+    uint32 ODR;                   /* 0x50C */
+    uint32 PUR;                   /* 0x510 */
+    uint32 PDR;                   /* 0x514 */
+    uint32 SLR;                   /* 0x518 */
+    uint32 DEN;                   /* 0x51C */
+    uint32 LOCK;                  /* 0x520 */
+    uint32 CR;                    /* 0x524 */
+    uint32 AMSEL;                 /* 0x528 */
+    uint32 PCTL;                  /* 0x52C */
+    uint32 ADCCTL;                /* 0x530 */
+    uint32 DMACTL;                /* 0x534 */
+}GPIO_RegType;
+
+REGISTERS_LAYOUT_ASSERT(GPIO_RegType, DATA,   0x3FC);
+REGISTERS_LAYOUT_ASSERT(GPIO_RegType, AFSEL,  0x420);
+REGISTERS_LAYOUT_ASSERT(GPIO_RegType, DR2R,   0x500);
+REGISTERS_LAYOUT_ASSERT(GPIO_RegType, DMACTL, 0x534);
+
+/* Port index 0 (PORTA) .. 5 (PORTF), PORTA..D follow each other at 0x40004000, PORTE..F at 0x40024000 */
+#define GPIO_PORT_BASE(Port)      (((Port) < 4) ? (0x40004000UL + ((uint32)(Port) << 12)) : (0x40024000UL + ((uint32)((Port) - 4) << 12)))
+#define GPIO_PORT(Port)           ((volatile GPIO_RegType *)GPIO_PORT_BASE(Port))
+
+/* UART0 .. UART7, 0x4000C000 + n * 0x1000 */
+typedef struct
+{
+    uint32 DR;                    /* 0x000 */
+    uint32 RSR_ECR;               /* 0x004 Receive status / error clear */
+    uint32 Reserved0[4];
+    uint32 FR;                    /* 0x018 */
+    uint32 Reserved1;
+    uint32 ILPR;                  /* 0x020 */
+    uint32 IBRD;                  /* 0x024 */
+    uint32 FBRD;                  /* 0x028 */
+    uint32 LCRH;                  /* 0x02C */
+    uint32 CTL;                   /* 0x030 */
+    uint32 IFLS;                  /* 0x034 */
+    uint32 IM;                    /* 0x038 */
+    uint32 RIS;                   /* 0x03C */
+    uint32 MIS;                   /* 0x040 */
+    uint32 ICR;                   /* 0x044 */
+    uint32 DMACTL;                /* 0x048 */
+    uint32 Reserved2[22];
+    uint32 BITADDR9;              /* 0x0A4 9-bit self address */
+    uint32 BITAMASK9;             /* 0x0A8 9-bit self address mask */
+    uint32 Reserved3[965];
+    uint32 PP;                    /* 0xFC0 */
+    uint32 Reserved4;
+    uint32 CC;                    /* 0xFC8 */
+}UART_RegType;
+
+REGISTERS_LAYOUT_ASSERT(UART_RegType, FR,       0x018);
+REGISTERS_LAYOUT_ASSERT(UART_RegType, DMACTL,   0x048);
+REGISTERS_LAYOUT_ASSERT(UART_RegType, BITADDR9, 0x0A4);
+REGISTERS_LAYOUT_ASSERT(UART_RegType, PP,       0xFC0);
+REGISTERS_LAYOUT_ASSERT(UART_RegType, CC,       0xFC8);
+
+#define UART_PORT(Uart)           ((volatile UART_RegType *)(0x4000C000UL + ((uint32)(Uart) << 12)))
+
+/* Micro DMA, 0x400FF000 */
+typedef struct
+{
+    uint32 STAT;                  /* 0x000 */
+    uint32 CFG;                   /* 0x004 */
+    uint32 CTLBASE;               /* 0x008 Channel control structure base */
+    uint32 ALTBASE;               /* 0x00C */
+    uint32 WAITSTAT;              /* 0x010 */
+    uint32 SWREQ;                 /* 0x014 */
+    uint32 USEBURSTSET;           /* 0x018 */
+    uint32 USEBURSTCLR;           /* 0x01C */
+    uint32 REQMASKSET;            /* 0x020 */
+    uint32 REQMASKCLR;            /* 0x024 */
+    uint32 ENASET;                /* 0x028 */
+    uint32 ENACLR;                /* 0x02C */
+    uint32 ALTSET;                /* 0x030 */
+    uint32 ALTCLR;                /* 0x034 */
+    uint32 PRIOSET;               /* 0x038 */
+    uint32 PRIOCLR;               /* 0x03C */
+    uint32 Reserved0[3];
+    uint32 ERRCLR;                /* 0x04C */
+    uint32 Reserved1[300];
+    uint32 CHASGN;                /* 0x500 */
+    uint32 CHIS;                  /* 0x504 */
+    uint32 Reserved2[2];
+    uint32 CHMAP[4];              /* 0x510 Channel map select 0 .. 3, 4 bits per channel */
+}UDMA_RegType;
+
+REGISTERS_LAYOUT_ASSERT(UDMA_RegType, PRIOCLR, 0x03C);
+REGISTERS_LAYOUT_ASSERT(UDMA_RegType, ERRCLR,  0x04C);
+REGISTERS_LAYOUT_ASSERT(UDMA_RegType, CHASGN,  0x500);
+REGISTERS_LAYOUT_ASSERT(UDMA_RegType, CHMAP,   0x510);
+
+#define UDMA_REGS                 ((volatile UDMA_RegType *)0x400FF000)
+
+/* Flash memory controller, 0x400FD000 */
+typedef struct
+{
+    uint32 FMA;                   /* 0x000 Address */
+    uint32 FMD;                   /* 0x004 Data */
+    uint32 FMC;                   /* 0x008 Control */
+    uint32 FCRIS;                 /* 0x00C */
+    uint32 FCIM;                  /* 0x010 */
+    uint32 FCMISC;                /* 0x014 */
+    uint32 Reserved0[2];
+    uint32 FMC2;                  /* 0x020 Control 2 */
+    uint32 Reserved1[3];
+    uint32 FWBVAL;                /* 0x030 Write buffer valid */
+    uint32 Reserved2[51];
+    uint32 FWBN[32];              /* 0x100 Write buffer */
+    uint32 Reserved3[912];
+    uint32 FSIZE;                 /* 0xFC0 */
+    uint32 SSIZE;                 /* 0xFC4 */
+    uint32 Reserved4;
+    uint32 ROMSWMAP;              /* 0xFCC */
+}FLASH_RegType;
+
+REGISTERS_LAYOUT_ASSERT(FLASH_RegType, FMC2,     0x020);
+REGISTERS_LAYOUT_ASSERT(FLASH_RegType, FWBVAL,   0x030);
+REGISTERS_LAYOUT_ASSERT(FLASH_RegType, FWBN,     0x100);
+REGISTERS_LAYOUT_ASSERT(FLASH_RegType, ROMSWMAP, 0xFCC);
+
+#define FLASH_REGS                ((volatile FLASH_RegType *)0x400FD000)
+
+/* General purpose timers, 16/32-bit Timer0..5 and 32/64-bit Wide Timer0..5 */
+typedef struct
+{
+    uint32 CFG;                   /* 0x000 Concatenated or split halves */
+    uint32 TAMR;                  /* 0x004 Timer A mode */
+    uint32 TBMR;                  /* 0x008 Timer B mode */
+    uint32 CTL;                   /* 0x00C Timer B fields are the timer A ones shifted by 8 */
+    uint32 SYNC;                  /* 0x010 Timer0 only */
+    uint32 Reserved0;
+    uint32 IMR;                   /* 0x018 */
+    uint32 RIS;                   /* 0x01C */
+    uint32 MIS;                   /* 0x020 */
+    uint32 ICR;                   /* 0x024 */
+    uint32 TAILR;                 /* 0x028 Interval load */
+    uint32 TBILR;                 /* 0x02C */
+    uint32 TAMATCHR;              /* 0x030 */
+    uint32 TBMATCHR;              /* 0x034 */
+    uint32 TAPR;                  /* 0x038 Prescale, counter extension in PWM and edge time modes */
+    uint32 TBPR;                  /* 0x03C */
+    uint32 TAPMR;                 /* 0x040 Prescale match */
+    uint32 TBPMR;                 /* 0x044 */
+    uint32 TAR;                   /* 0x048 Captured value in edge time mode */
+    uint32 TBR;                   /* 0x04C */
+    uint32 TAV;                   /* 0x050 Free running value */
+    uint32 TBV;                   /* 0x054 */
+    uint32 RTCPD;                 /* 0x058 */
+    uint32 TAPS;                  /* 0x05C Prescale snapshot */
+    uint32 TBPS;                  /* 0x060 */
+    uint32 TAPV;                  /* 0x064 Prescale value */
+    uint32 TBPV;                  /* 0x068 */
+    uint32 Reserved1[981];
+    uint32 PP;                    /* 0xFC0 Peripheral properties, SIZE bit set on the wide timers */
+}GPTM_RegType;
+
+REGISTERS_LAYOUT_ASSERT(GPTM_RegType, IMR,   0x018);
+REGISTERS_LAYOUT_ASSERT(GPTM_RegType, TAILR, 0x028);
+REGISTERS_LAYOUT_ASSERT(GPTM_RegType, TAR,   0x048);
+REGISTERS_LAYOUT_ASSERT(GPTM_RegType, TBPV,  0x068);
+REGISTERS_LAYOUT_ASSERT(GPTM_RegType, PP,    0xFC0);
+
+/* Timer index 0 .. 5 at 0x40030000, wide timers 6 .. 7 follow them, wide timers 8 .. 11 at 0x4004C000 */
+#define GPTM_TIMER_BASE(Timer)    (((Timer) < 8) ? (0x40030000UL + ((uint32)(Timer) << 12)) : (0x4004C000UL + ((uint32)((Timer) - 8) << 12)))
+#define GPTM_TIMER(Timer)         ((volatile GPTM_RegType *)GPTM_TIMER_BASE(Timer))
+
+/* Watchdog timers, WDT0 at 0x40000000 on the system clock, WDT1 at 0x40001000 on PIOSC */
+typedef struct
+{
+    uint32 LOAD;                  /* 0x000 Reload value */
+    uint32 VALUE;                 /* 0x004 Current count */
+    uint32 CTL;                   /* 0x008 INTEN, RESEN, INTTYPE, WRC (WDT1) */
+    uint32 ICR;                   /* 0x00C Any write clears the interrupt and reloads the counter */
+    uint32 RIS;                   /* 0x010 */
+    uint32 MIS;                   /* 0x014 */
+    uint32 Reserved0[256];
+    uint32 TEST;                  /* 0x418 STALL: stop counting while the debugger halts the core */
+    uint32 Reserved1[505];
+    uint32 LOCK;                  /* 0xC00 0x1ACCE551 unlocks, any other value locks */
+}WDT_RegType;
+
+REGISTERS_LAYOUT_ASSERT(WDT_RegType, MIS,  0x014);
+REGISTERS_LAYOUT_ASSERT(WDT_RegType, TEST, 0x418);
+REGISTERS_LAYOUT_ASSERT(WDT_RegType, LOCK, 0xC00);
+
+#define WDT_BASE(Wdt)             (0x40000000UL + ((uint32)(Wdt) << 12))
+#define WDT(Wdt)                  ((volatile WDT_RegType *)WDT_BASE(Wdt))
+
+/* ADC sample sequencer n, 0x040 + n * 0x20 in the ADC block */
+typedef struct
+{
+    uint32 SSMUX;                 /* 0x00 Analog input of each step, 4 bits per step */
+    uint32 SSCTL;                 /* 0x04 D, END, IE, TS of each step, 4 bits per step */
+    uint32 SSFIFO;                /* 0x08 Conversion results */
+    uint32 SSFSTAT;               /* 0x0C FIFO status */
+    uint32 SSOP;                  /* 0x10 Digital comparator operation */
+    uint32 SSDC;                  /* 0x14 Digital comparator select */
+    uint32 Reserved[2];
+}ADC_SequencerRegType;
+
+/* ADC0 at 0x40038000, ADC1 at 0x40039000 */
+typedef struct
+{
+    uint32 ACTSS;                 /* 0x000 Active sample sequencers */
+    uint32 RIS;                   /* 0x004 */
+    uint32 IM;                    /* 0x008 */
+    uint32 ISC;                   /* 0x00C Interrupt status and clear */
+    uint32 OSTAT;                 /* 0x010 FIFO overflow, write 1 to clear */
+    uint32 EMUX;                  /* 0x014 Trigger source of each sequencer, 4 bits per sequencer */
+    uint32 USTAT;                 /* 0x018 FIFO underflow, write 1 to clear */
+    uint32 TSSEL;                 /* 0x01C */
+    uint32 SSPRI;                 /* 0x020 */
+    uint32 SPC;                   /* 0x024 */
+    uint32 PSSI;                  /* 0x028 Processor sample sequence initiate */
+    uint32 Reserved0;
+    uint32 SAC;                   /* 0x030 Hardware averaging, 2^SAC samples */
+    uint32 DCISC;                 /* 0x034 */
+    uint32 CTL;                   /* 0x038 */
+    uint32 Reserved1;
+    ADC_SequencerRegType SS[4];   /* 0x040 */
+    uint32 Reserved2[784];
+    uint32 DCRIC;                 /* 0xD00 */
+    uint32 Reserved3[63];
+    uint32 DCCTL[8];              /* 0xE00 */
+    uint32 Reserved4[8];
+    uint32 DCCMP[8];              /* 0xE40 */
+    uint32 Reserved5[88];
+    uint32 PP;                    /* 0xFC0 */
+    uint32 PC;                    /* 0xFC4 Sample rate */
+    uint32 CC;                    /* 0xFC8 */
+}ADC_RegType;
+
+REGISTERS_LAYOUT_ASSERT(ADC_RegType, EMUX,  0x014);
+REGISTERS_LAYOUT_ASSERT(ADC_RegType, PSSI,  0x028);
+REGISTERS_LAYOUT_ASSERT(ADC_RegType, SS,    0x040);
+REGISTERS_LAYOUT_ASSERT(ADC_RegType, DCRIC, 0xD00);
+REGISTERS_LAYOUT_ASSERT(ADC_RegType, DCCTL, 0xE00);
+REGISTERS_LAYOUT_ASSERT(ADC_RegType, DCCMP, 0xE40);
+REGISTERS_LAYOUT_ASSERT(ADC_RegType, PP,    0xFC0);
+
+#define ADC_BASE(Adc)             (0x40038000UL + ((uint32)(Adc) << 12))
+#define ADC(Adc)                  ((volatile ADC_RegType *)ADC_BASE(Adc))
+
+/* Entry of the uDMA channel control table in SRAM, UDMA_REGS->CTLBASE points at the 1024-byte aligned table */
+typedef struct
+{
+    uint32 SRCENDP;               /* 0x0 Address of the last source item */
+    uint32 DSTENDP;               /* 0x4 Address of the last destination item */
+    uint32 CHCTL;                 /* 0x8 Sizes, increments, remaining items and transfer mode */
+    uint32 Reserved;
+}UDMA_ChannelControlType;
+
+REGISTERS_LAYOUT_ASSERT(UDMA_ChannelControlType, CHCTL, 0x8);
+
 
 #endif
@@ -0,0 +1,744 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: adc_test.c
+ *
+ * Description: Host test of NVIC_Driver/ADC.c and UDMA.c against a simulated sequencer and uDMA
+ *              controller. Each conversion writes ((sequence & 0xFF) << 4) | input in the FIFO
+ *              of the sequencer, the request of the last step moves the FIFO through the control
+ *              structure the controller is on: the destination comes from the end pointer and
+ *              the remaining items, a completed structure is written back as STOP and the
+ *              controller switches to the other one, a request on a STOP structure disables the
+ *              channel. The done flag runs the sequencer handler unless the test holds it back,
+ *              and the callback can run conversions while it works on its block.
+ *
+ *              The uDMA registers go through the model on every access. The ADC registers are
+ *              plain memory: write-1-to-clear and write-only registers keep a marker bit the
+ *              driver never writes, SSFSTAT reads empty and the FIFO is dropped with the
+ *              overflow, where the driver drains it.
+ *
+ *              Checks : sequencer and channel configuration, rejected configurations, blocks
+ *                       handed over in order from alternate buffers, every sequence whole and
+ *                       numbered in order, two blocks in one interrupt, a late interrupt or a
+ *                       slow callback stopping the transfer without writing the block in use,
+ *                       restart on a sequence boundary, processor trigger, stop, statistics.
+ *
+ *              Report : interrupts and cycles of the handler per sample for several block sizes.
+ *                       The cycles are a cost model of the Cortex-M4: the cycle counter read by
+ *                       the driver advances on every uDMA register access, the exception entry
+ *                       and exit, the ADC register accesses through the pointer of the handler
+ *                       and the control table work of each block are added per interrupt and
+ *                       per block, the timer triggers pass while the callback works. The cycles
+ *                       per sample go down as the blocks grow.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : adc_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+
+static ADC_RegType Test_Adc[2];
+static UDMA_RegType Test_UdmaRegs;
+static uint32 Test_RcgcAdc;
+static uint32 Test_RcgcDma;
+static uint32 Test_Demcr;
+static uint32 Test_DwtCtrl;
+
+static volatile UDMA_RegType *Test_UdmaAccess(void);
+static uint32 Test_Cycles(void);
+
+#undef ADC
+#undef UDMA_REGS
+#undef SYSCTL_RCGCADC_REG
+#undef SYSCTL_PRADC_REG
+#undef SYSCTL_RCGCDMA_REG
+#undef SYSCTL_PRDMA_REG
+#undef DWT_CYCCNT_REG
+#undef DWT_CTRL_REG
+#undef CORE_DEBUG_DEMCR_REG
+#define ADC(Adc)                    (&Test_Adc[(Adc)])
+#define UDMA_REGS                   Test_UdmaAccess()
+#define SYSCTL_RCGCADC_REG          Test_RcgcAdc
+#define SYSCTL_PRADC_REG            Test_RcgcAdc
+#define SYSCTL_RCGCDMA_REG          Test_RcgcDma
+#define SYSCTL_PRDMA_REG            Test_RcgcDma
+#define DWT_CYCCNT_REG              Test_Cycles()
+#define DWT_CTRL_REG                Test_DwtCtrl
+#define CORE_DEBUG_DEMCR_REG        Test_Demcr
+
+/* The control table is aligned with a pragma of the TI compiler */
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+#include "UDMA.c"
+#include "ADC.c"
+
+#define TEST_MARKER                 0x80000000  /* Never written by the driver */
+#define TEST_STEPS                  4
+#define TEST_BLOCK                  64
+#define TEST_MAX_BLOCK              ADC_MAX_BLOCK_SAMPLES
+
+/* Cost model, core cycles */
+#define TEST_REGISTER_CYCLES        3u          /* One peripheral register access over the APB bridge */
+#define TEST_ENTRY_CYCLES           12u         /* Exception entry, stacking and vector fetch */
+#define TEST_EXIT_CYCLES            10u         /* Exception return, unstacking */
+#define TEST_ADC_ACCESSES           2u          /* ISC write and OSTAT read of the handler, not counted */
+#define TEST_BLOCK_CYCLES           24u         /* Mode read, re-arm and statistics of one block in SRAM */
+#define TEST_TRIGGER_CYCLES         800u        /* Time between two timer triggers, 100 kHz at 80 MHz */
+
+static const uint8 Test_Inputs[ADC_SS0_STEPS] = { 3, 1, 7, 0, 11, 2, 9, 4 };
+static uint16 Test_Buffers[2][TEST_MAX_BLOCK];
+
+/* Sequencer under test, on ADC0 */
+static Adc_SequencerType Test_Ss;
+static uint8 Test_Steps;
+static uint16 Test_Block;
+
+/* uDMA model */
+static uint32 Test_Enabled;
+static uint32 Test_Alt;
+static uint32 Test_Done;
+static uint32 Test_Stops;
+static boolean Test_Busy;                 /* Controller on other channels, requests wait */
+
+/* Sequencer model */
+static uint32 Test_Fifo[ADC_SS0_STEPS];
+static uint32 Test_FifoCount;
+static uint32 Test_Sequence;
+static boolean Test_Overflow;
+static uint32 Test_Restart;               /* First sequence after the last restart */
+
+/* NVIC and core model */
+static boolean Test_IrqEnabled[NVIC_IRQ_COUNT];
+static NVIC_IRQPriorityType Test_IrqPriority[NVIC_IRQ_COUNT];
+static boolean Test_InIsr;
+static boolean Test_Held;
+static uint32 Test_Interrupts;
+static uint32 Test_Now;                   /* Cycle counter of the cost model */
+
+/* Callback checks */
+static uint32 Test_Blocks;
+static uint32 Test_Expected;              /* Buffer of the next block */
+static uint32 Test_LastSequence;
+static uint32 Test_LastOverruns;
+static uint32 Test_Gaps;
+static uint32 Test_Errors;
+static uint32 Test_CallbackSequences;     /* Conversions run by the callback on each block */
+
+static void (*const Test_Handlers[ADC_SEQUENCERS])(void) =
+{
+    ADC0Seq0_Handler, ADC0Seq1_Handler, ADC0Seq2_Handler, ADC0Seq3_Handler
+};
+
+/*******************************************************************************
+ *                        Modules used by the driver                           *
+ *******************************************************************************/
+
+void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num)
+{
+    Test_IrqEnabled[IRQ_Num] = TRUE;
+}
+
+void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num)
+{
+    Test_IrqEnabled[IRQ_Num] = FALSE;
+}
+
+void NVIC_SetPriorityIRQ(NVIC_IRQType IRQ_Num, NVIC_IRQPriorityType IRQ_Priority)
+{
+    Test_IrqPriority[IRQ_Num] = IRQ_Priority;
+}
+
+static uint32 Test_Cycles(void)
+{
+    return Test_Now;
+}
+
+/*******************************************************************************
+ *                                 uDMA model                                  *
+ *******************************************************************************/
+
+/* Effects of the last writes: set and clear registers, CHIS write 1 to clear */
+static void Test_UdmaSync(void)
+{
+    volatile UDMA_RegType *Regs = &Test_UdmaRegs;
+
+    Test_Enabled &= ~Regs->ENACLR;
+    if(Regs->ENASET != Test_Enabled)
+    {
+        Test_Enabled |= Regs->ENASET;
+    }
+    Test_Alt  = (Test_Alt | Regs->ALTSET) & ~Regs->ALTCLR;
+    Test_Done &= ~Regs->CHIS;
+
+    Regs->ENASET     = Test_Enabled;
+    Regs->ENACLR     = 0;
+    Regs->ALTSET     = Test_Alt;
+    Regs->ALTCLR     = 0;
+    Regs->CHIS       = 0;
+    Regs->PRIOCLR    = 0;
+    Regs->REQMASKCLR = 0;
+}
+
+static volatile UDMA_RegType *Test_UdmaAccess(void)
+{
+    Test_Now += TEST_REGISTER_CYCLES;
+    Test_UdmaSync();
+    return &Test_UdmaRegs;
+}
+
+static Udma_ChannelType Test_Channel(void)
+{
+    return (Udma_ChannelType)(14 + Test_Ss);
+}
+
+/* Request of the sequencer: the FIFO moves through the structure the controller is on */
+static void Test_Request(void)
+{
+    uint32 Mask = (uint32)1 << Test_Channel();
+    uint32 Field = (Test_UdmaRegs.CHMAP[Test_Channel() / 8] >> ((Test_Channel() % 8) * 4)) & 0xF;
+    UDMA_ChannelControlType *Entry;
+    uint32 Remaining;
+
+    if(!(Test_Enabled & Mask) || (Field != 0))
+    {
+        return;
+    }
+    while(Test_FifoCount != 0)
+    {
+        Entry = &Udma_ControlTable[(Test_Alt & Mask) ? (UDMA_CHANNELS + Test_Channel()) : Test_Channel()];
+        if((Entry->CHCTL & UDMA_CHCTL_XFERMODE_MASK) == UDMA_MODE_STOP)
+        {
+            Test_Enabled &= ~Mask; /* Ran into a half not re-armed */
+            Test_UdmaRegs.ENASET = Test_Enabled;
+            Test_Stops++;
+            return;
+        }
+        if(Entry->SRCENDP != HOST_ADDRESS(&Test_Adc[ADC_MODULE_0].SS[Test_Ss].SSFIFO))
+        {
+            Test_Errors++;
+            return;
+        }
+
+        Remaining = ((Entry->CHCTL & UDMA_CHCTL_XFERSIZE_MASK) >> UDMA_CHCTL_XFERSIZE_BITS_POS) + 1;
+        *(uint16 *)(uintptr_t)(Entry->DSTENDP - (Remaining - 1) * sizeof(uint16)) = (uint16)Test_Fifo[0];
+        Test_FifoCount--;
+        memmove(Test_Fifo, Test_Fifo + 1, Test_FifoCount * sizeof(Test_Fifo[0]));
+
+        if(Remaining == 1)
+        {
+            Entry->CHCTL &= ~(uint32)(UDMA_CHCTL_XFERSIZE_MASK | UDMA_CHCTL_XFERMODE_MASK);
+            Test_Done    |= Mask;
+            Test_Alt     ^= Mask; /* Ping-pong: on to the other structure */
+            Test_UdmaRegs.ALTSET = Test_Alt;
+        }
+        else
+        {
+            Entry->CHCTL = (Entry->CHCTL & ~(uint32)UDMA_CHCTL_XFERSIZE_MASK) |
+                           ((Remaining - 2) << UDMA_CHCTL_XFERSIZE_BITS_POS);
+        }
+    }
+}
+
+/*******************************************************************************
+ *                               Sequencer model                               *
+ *******************************************************************************/
+
+static void Test_AdcSync(void)
+{
+    volatile ADC_RegType *Regs = &Test_Adc[ADC_MODULE_0];
+    uint32 Mask = ADC_SEQUENCER_MASK(Test_Ss);
+
+    if(!(Regs->OSTAT & TEST_MARKER))
+    {
+        if(Regs->OSTAT & Mask)
+        {
+            Test_Overflow  = FALSE;
+            Test_FifoCount = 0; /* Drained by the driver */
+            Test_Restart   = Test_Sequence;
+        }
+        Regs->OSTAT = TEST_MARKER;
+    }
+    Regs->OSTAT = TEST_MARKER | (Test_Overflow ? Mask : 0);
+    Regs->ISC   = TEST_MARKER;
+    Regs->SS[Test_Ss].SSFSTAT = ADC_SSFSTAT_EMPTY_MASK;
+}
+
+static void Test_Deliver(void);
+
+/* One trigger of the sequencer */
+static void Test_Convert(void)
+{
+    volatile ADC_RegType *Regs = &Test_Adc[ADC_MODULE_0];
+    uint32 Control = Regs->SS[Test_Ss].SSCTL;
+    uint32 Step;
+    uint32 Field;
+
+    if(!(Regs->ACTSS & ADC_SEQUENCER_MASK(Test_Ss)))
+    {
+        return;
+    }
+    for(Step = 0; Step < Adc_Depths[Test_Ss]; Step++)
+    {
+        Field = (Regs->SS[Test_Ss].SSMUX >> (Step * ADC_SSCTL_STEP_BITS)) & 0xF;
+        if(Test_FifoCount < Adc_Depths[Test_Ss])
+        {
+            Test_Fifo[Test_FifoCount++] = ((Test_Sequence & 0xFF) << 4) | Field;
+        }
+        else
+        {
+            Test_Overflow = TRUE;
+        }
+        if((Control >> (Step * ADC_SSCTL_STEP_BITS)) & ADC_SSCTL_END_MASK)
+        {
+            break;
+        }
+    }
+    Test_Sequence++;
+    if(!Test_Busy && ((Control >> (Step * ADC_SSCTL_STEP_BITS)) & ADC_SSCTL_IE_MASK))
+    {
+        Test_Request();
+    }
+    Test_AdcSync();
+    Test_Deliver();
+}
+
+/* Time-out of the GPTM half that triggers the ADC */
+static void Test_Timer(uint32 a_Count)
+{
+    while(a_Count-- != 0)
+    {
+        Test_Now += TEST_TRIGGER_CYCLES;
+        if(((Test_Adc[ADC_MODULE_0].EMUX >> (Test_Ss * ADC_EMUX_FIELD_BITS)) & 0xF) == ADC_TRIGGER_TIMER)
+        {
+            Test_Convert();
+        }
+    }
+}
+
+/* The done flag of the channel raises the sequencer interrupt */
+static void Test_Deliver(void)
+{
+    NVIC_IRQType Irq = ADC_IRQ_NUM(ADC_MODULE_0, Test_Ss);
+    uint32 Entries = 0;
+
+    while((Test_Done & ((uint32)1 << Test_Channel())) && Test_IrqEnabled[Irq] && !Test_InIsr && !Test_Held)
+    {
+        if(++Entries > 2)
+        {
+            Test_Errors++; /* Done flag never cleared, the handler would run forever */
+            Test_Done = 0;
+            break;
+        }
+        Test_InIsr = TRUE;
+        Test_Handlers[Test_Ss]();
+        Test_UdmaSync();
+        Test_AdcSync();
+        Test_InIsr = FALSE;
+        Test_Interrupts++;
+    }
+}
+
+/*******************************************************************************
+ *                                 Helpers                                     *
+ *******************************************************************************/
+
+static void Test_Callback(const uint16 *a_Samples, uint16 a_Count)
+{
+    static uint16 Snapshot[TEST_MAX_BLOCK];
+    Adc_StatsType Stats;
+    uint32 Sequence;
+    uint32 Index;
+
+    Stats.Overruns = Test_LastOverruns;
+    (void)Adc_GetStats(ADC_MODULE_0, Test_Ss, &Stats);
+    if(Stats.Overruns != Test_LastOverruns)
+    {
+        Test_Expected = 0; /* Restarted on the primary structure */
+        if((a_Samples[0] >> 4) != (Test_Restart & 0xFF))
+        {
+            Test_Errors++; /* Results from before the restart */
+        }
+    }
+    if((a_Samples != Test_Buffers[Test_Expected]) || (a_Count != Test_Block))
+    {
+        Test_Errors++;
+    }
+    Test_Expected ^= 1;
+
+    for(Index = 0; Index < a_Count; Index++)
+    {
+        Sequence = a_Samples[Index] >> 4;
+        if((a_Samples[Index] & 0xF) != Test_Inputs[Index % Test_Steps])
+        {
+            Test_Errors++; /* Out of step */
+        }
+        if((Index % Test_Steps) != 0)
+        {
+            if(Sequence != Test_LastSequence)
+            {
+                Test_Errors++; /* Sequence broken */
+            }
+        }
+        else if((Test_Blocks != 0) || (Index != 0))
+        {
+            if(Sequence != ((Test_LastSequence + 1) & 0xFF))
+            {
+                Test_Gaps++; /* Sequences lost, each test matches them to the overruns */
+            }
+        }
+        Test_LastSequence = Sequence;
+    }
+    Test_LastOverruns = Stats.Overruns;
+    Test_Blocks++;
+
+    /* The other buffer fills meanwhile, this one must not change */
+    memcpy(Snapshot, a_Samples, a_Count * sizeof(uint16));
+    Test_Timer(Test_CallbackSequences);
+    if(memcmp(Snapshot, a_Samples, a_Count * sizeof(uint16)) != 0)
+    {
+        Test_Errors++;
+    }
+}
+
+static void Test_PowerOn(void)
+{
+    memset(Test_Adc, 0, sizeof(Test_Adc));
+    memset(&Test_UdmaRegs, 0, sizeof(Test_UdmaRegs));
+    memset(Udma_ControlTable, 0, sizeof(Udma_ControlTable));
+    memset(Adc_Contexts, 0, sizeof(Adc_Contexts));
+    memset(Test_Buffers, 0, sizeof(Test_Buffers));
+    memset(Test_IrqEnabled, 0, sizeof(Test_IrqEnabled));
+    Test_RcgcAdc = 0;
+    Test_RcgcDma = 0;
+    Test_Enabled = 0;
+    Test_Alt     = 0;
+    Test_Done    = 0;
+    Test_Stops   = 0;
+    Test_Busy    = FALSE;
+
+    Test_FifoCount = 0;
+    Test_Sequence  = 0;
+    Test_Overflow  = FALSE;
+    Test_Restart   = 0;
+    Test_Held      = FALSE;
+    Test_InIsr     = FALSE;
+
+    Test_Interrupts        = 0;
+    Test_Blocks            = 0;
+    Test_Expected          = 0;
+    Test_LastOverruns      = 0;
+    Test_Gaps              = 0;
+    Test_Errors            = 0;
+    Test_CallbackSequences = 0;
+
+    Udma_Init();
+    Test_UdmaSync();
+}
+
+static void Test_Config(Adc_ConfigType *a_Config, Adc_SequencerType a_Ss, Adc_TriggerType a_Trigger, uint8 a_Steps,
+                        uint16 a_Block)
+{
+    a_Config->Module       = ADC_MODULE_0;
+    a_Config->Sequencer    = a_Ss;
+    a_Config->Trigger      = a_Trigger;
+    a_Config->Inputs       = Test_Inputs;
+    a_Config->Steps        = a_Steps;
+    a_Config->Averaging    = 2;
+    a_Config->Buffers[0]   = Test_Buffers[0];
+    a_Config->Buffers[1]   = Test_Buffers[1];
+    a_Config->BlockSamples = a_Block;
+    a_Config->Callback     = Test_Callback;
+    a_Config->Priority     = 3;
+}
+
+/* Power on, Init and Start of a timer triggered sequencer */
+static void Test_Start(Adc_SequencerType a_Ss, uint8 a_Steps, uint16 a_Block)
+{
+    Adc_ConfigType Config;
+
+    Test_PowerOn();
+    Test_Ss    = a_Ss;
+    Test_Steps = a_Steps;
+    Test_Block = a_Block;
+    Test_Config(&Config, a_Ss, ADC_TRIGGER_TIMER, a_Steps, a_Block);
+    HOST_CHECK(Adc_Init(&Config));
+    Test_UdmaSync();
+    Test_AdcSync();
+    Adc_Start(ADC_MODULE_0, a_Ss);
+}
+
+/*******************************************************************************
+ *                                 Tests                                       *
+ *******************************************************************************/
+
+static void Test_Init(void)
+{
+    volatile ADC_RegType *Regs = &Test_Adc[ADC_MODULE_0];
+    const UDMA_ChannelControlType *Primary = &Udma_ControlTable[14];
+    const UDMA_ChannelControlType *Alternate = &Udma_ControlTable[UDMA_CHANNELS + 14];
+    Adc_ConfigType Config;
+
+    Test_Start(ADC_SS0, TEST_STEPS, TEST_BLOCK);
+    HOST_CHECK_EQUAL(Test_RcgcAdc, 0x01);
+    HOST_CHECK_EQUAL(Test_RcgcDma, 0x01);
+    HOST_CHECK_EQUAL(Test_UdmaRegs.CTLBASE, HOST_ADDRESS(Udma_ControlTable));
+    HOST_CHECK_EQUAL(Test_Demcr & CORE_DEBUG_TRCENA_MASK, CORE_DEBUG_TRCENA_MASK);
+    HOST_CHECK_EQUAL(Regs->ACTSS, 0x01);
+    HOST_CHECK_EQUAL(Regs->IM, 0);
+    HOST_CHECK_EQUAL(Regs->EMUX, ADC_TRIGGER_TIMER);
+    HOST_CHECK_EQUAL(Regs->SAC, 2);
+    HOST_CHECK_EQUAL(Regs->SS[0].SSMUX, 0x0713);
+    HOST_CHECK_EQUAL(Regs->SS[0].SSCTL, (uint32)(ADC_SSCTL_END_MASK | ADC_SSCTL_IE_MASK) << 12);
+
+    /* Channel 14 on ADC0 SS0, FIFO to the two buffers, 4 items per arbitration */
+    HOST_CHECK_EQUAL((Test_UdmaRegs.CHMAP[1] >> 24) & 0xF, 0);
+    HOST_CHECK_EQUAL(Test_Enabled, (uint32)1 << 14);
+    HOST_CHECK_EQUAL(Test_Alt, 0);
+    HOST_CHECK_EQUAL(Primary->SRCENDP, HOST_ADDRESS(&Regs->SS[0].SSFIFO));
+    HOST_CHECK_EQUAL(Alternate->SRCENDP, HOST_ADDRESS(&Regs->SS[0].SSFIFO));
+    HOST_CHECK_EQUAL(Primary->DSTENDP, HOST_ADDRESS(&Test_Buffers[0][TEST_BLOCK - 1]));
+    HOST_CHECK_EQUAL(Alternate->DSTENDP, HOST_ADDRESS(&Test_Buffers[1][TEST_BLOCK - 1]));
+    HOST_CHECK_EQUAL(Primary->CHCTL, UDMA_CONTROL(UDMA_SIZE_16, UDMA_INC_NONE, UDMA_SIZE_16, 2, UDMA_MODE_PINGPONG) |
+                                     ((TEST_BLOCK - 1) << UDMA_CHCTL_XFERSIZE_BITS_POS));
+    HOST_CHECK_EQUAL(Alternate->CHCTL, Primary->CHCTL);
+    HOST_CHECK(Test_IrqEnabled[NVIC_IRQ_ADC0_SS0]);
+    HOST_CHECK_EQUAL(Test_IrqPriority[NVIC_IRQ_ADC0_SS0], 3);
+
+    /* Rejected */
+    Test_Config(&Config, ADC_SS0, ADC_TRIGGER_TIMER, TEST_STEPS, TEST_BLOCK);
+    HOST_CHECK(!Adc_Init(NULL_PTR));
+    Config.Steps = 0;
+    HOST_CHECK(!Adc_Init(&Config));
+    Config.Steps = ADC_SS0_STEPS + 1;
+    HOST_CHECK(!Adc_Init(&Config));
+    Test_Config(&Config, ADC_SS3, ADC_TRIGGER_TIMER, 2, TEST_BLOCK);
+    HOST_CHECK(!Adc_Init(&Config));
+    Test_Config(&Config, ADC_SS0, ADC_TRIGGER_TIMER, 3, TEST_BLOCK);
+    HOST_CHECK(!Adc_Init(&Config)); /* 64 samples are not whole sequences of 3 */
+    Test_Config(&Config, ADC_SS0, ADC_TRIGGER_TIMER, TEST_STEPS, TEST_MAX_BLOCK + 4);
+    HOST_CHECK(!Adc_Init(&Config));
+    Test_Config(&Config, ADC_SS0, ADC_TRIGGER_TIMER, ADC_SS0_STEPS, TEST_BLOCK);
+    Config.Inputs = (const uint8 *)"\x00\x01\x02\x03\x04\x05\x06\x0C";
+    HOST_CHECK(!Adc_Init(&Config));
+    Test_Config(&Config, ADC_SS0, ADC_TRIGGER_TIMER, TEST_STEPS, TEST_BLOCK);
+    Config.Buffers[1] = NULL_PTR;
+    HOST_CHECK(!Adc_Init(&Config));
+    Test_Config(&Config, ADC_SS0, ADC_TRIGGER_TIMER, TEST_STEPS, TEST_BLOCK);
+    Config.Averaging = 7;
+    HOST_CHECK(!Adc_Init(&Config));
+    Config.Averaging = 0;
+    Config.Module = ADC_MODULES;
+    HOST_CHECK(!Adc_Init(&Config));
+    HOST_CHECK(!Adc_GetStats(ADC_MODULE_0, ADC_SEQUENCERS, NULL_PTR));
+}
+
+static void Test_Ordering(void)
+{
+    Adc_StatsType Stats;
+
+    Test_Start(ADC_SS0, TEST_STEPS, TEST_BLOCK);
+    Test_Timer(1000);
+
+    HOST_CHECK_EQUAL(Test_Errors, 0);
+    HOST_CHECK_EQUAL(Test_Gaps, 0);
+    HOST_CHECK_EQUAL(Test_Blocks, (1000 * TEST_STEPS) / TEST_BLOCK);
+    HOST_CHECK_EQUAL(Test_Interrupts, Test_Blocks);
+    HOST_CHECK_EQUAL(Test_Stops, 0);
+    HOST_CHECK(Adc_GetStats(ADC_MODULE_0, ADC_SS0, &Stats));
+    HOST_CHECK_EQUAL(Stats.Blocks, Test_Blocks);
+    HOST_CHECK_EQUAL(Stats.Samples, Test_Blocks * TEST_BLOCK);
+    HOST_CHECK_EQUAL(Stats.Overruns, 0);
+
+    /* The last sample of the last block is the one of its sequence */
+    HOST_CHECK_EQUAL(Test_LastSequence, ((Test_Blocks * TEST_BLOCK / TEST_STEPS) - 1) & 0xFF);
+}
+
+/* The interrupt comes late: two blocks are caught up, more stop the transfer */
+static void Test_Latency(void)
+{
+    uint32 Sequences = TEST_BLOCK / TEST_STEPS;
+    Adc_StatsType Stats;
+    uint32 Interrupts;
+
+    Test_Start(ADC_SS0, TEST_STEPS, TEST_BLOCK);
+    Test_Timer(3 * Sequences);
+
+    Test_Held = TRUE;
+    Test_Timer(2 * Sequences);
+    Test_Held  = FALSE;
+    Interrupts = Test_Interrupts;
+    Test_Deliver();
+    HOST_CHECK_EQUAL(Test_Interrupts - Interrupts, 1);
+    HOST_CHECK_EQUAL(Test_Blocks, 5);
+    HOST_CHECK_EQUAL(Test_Stops, 0);
+
+    /* Both halves complete, the next request finds a STOP structure */
+    Test_Held = TRUE;
+    Test_Timer(3 * Sequences);
+    HOST_CHECK_EQUAL(Test_Stops, 1);
+    HOST_CHECK(Test_Overflow);
+    Test_Held = FALSE;
+    Test_Deliver();
+    HOST_CHECK(Adc_GetStats(ADC_MODULE_0, ADC_SS0, &Stats));
+    HOST_CHECK_EQUAL(Stats.Overruns, 1);
+    HOST_CHECK_EQUAL(Test_Blocks, 7);
+    HOST_CHECK(!Test_Overflow);
+    HOST_CHECK_EQUAL(Test_Enabled, (uint32)1 << 14);
+
+    /* Restarted on a sequence boundary in the primary buffer */
+    Test_Timer(4 * Sequences);
+    HOST_CHECK_EQUAL(Test_Blocks, 11);
+    HOST_CHECK_EQUAL(Test_Gaps, 1);
+    HOST_CHECK_EQUAL(Test_Errors, 0);
+}
+
+/* The FIFO overflows while the controller is busy: the block is handed over, the restart drops the other
+ * one, which is the alternate block then the primary one */
+static void Test_FifoOverflow(void)
+{
+    uint32 Sequences = TEST_BLOCK / TEST_STEPS;
+    Adc_StatsType Stats;
+    uint32 Half;
+
+    for(Half = 0; Half < 2; Half++)
+    {
+        Test_Start(ADC_SS0, TEST_STEPS, TEST_BLOCK);
+        Test_Timer((Half + 1) * Sequences - 1);
+        Test_Busy = TRUE;
+        Test_Timer(3); /* Two sequences fit in the FIFO of SS0, the third one and the next are lost */
+        Test_Busy = FALSE;
+        HOST_CHECK(Test_Overflow);
+        HOST_CHECK_EQUAL(Test_Enabled, (uint32)1 << 14);
+
+        /* The next request ends this block and starts the other one */
+        Test_Timer(1);
+        HOST_CHECK_EQUAL(Test_Sequence, (Half + 1) * Sequences + 3);
+        HOST_CHECK(Adc_GetStats(ADC_MODULE_0, ADC_SS0, &Stats));
+        HOST_CHECK_EQUAL(Test_Blocks, Half + 1);
+        HOST_CHECK_EQUAL(Stats.Overruns, 1);
+        HOST_CHECK(!Test_Overflow);
+
+        Test_Timer(4 * Sequences);
+        HOST_CHECK_EQUAL(Test_Blocks, Half + 5);
+        HOST_CHECK_EQUAL(Test_Gaps, 1);
+        HOST_CHECK_EQUAL(Test_Stops, 0);
+        HOST_CHECK_EQUAL(Test_Errors, 0);
+    }
+}
+
+/* The callback works while the next block fills, longer than a block it stops the transfer */
+static void Test_SlowCallback(void)
+{
+    uint32 Sequences = TEST_BLOCK / TEST_STEPS;
+    Adc_StatsType Stats;
+
+    Test_Start(ADC_SS0, TEST_STEPS, TEST_BLOCK);
+    Test_CallbackSequences = Sequences - 1;
+    Test_Timer(20 * Sequences);
+    HOST_CHECK(Adc_GetStats(ADC_MODULE_0, ADC_SS0, &Stats));
+    HOST_CHECK_EQUAL(Stats.Overruns, 0);
+    HOST_CHECK(Test_Blocks >= 20);
+    HOST_CHECK_EQUAL(Test_Errors, 0);
+    HOST_CHECK(Stats.CallbackCycles > 0);
+
+    Test_Start(ADC_SS0, TEST_STEPS, TEST_BLOCK);
+    Test_CallbackSequences = Sequences + Sequences / 2;
+    Test_Timer(20 * Sequences);
+    HOST_CHECK(Adc_GetStats(ADC_MODULE_0, ADC_SS0, &Stats));
+    HOST_CHECK(Stats.Overruns > 0);
+    HOST_CHECK(Test_Stops > 0);
+    HOST_CHECK_EQUAL(Test_Gaps, Test_LastOverruns); /* Each restart lost the sequences meanwhile */
+    HOST_CHECK_EQUAL(Test_Errors, 0); /* No block written while its callback ran */
+    HOST_CHECK_EQUAL(Stats.Blocks, Test_Blocks);
+}
+
+/* SS1 on the processor trigger: converts on Adc_Trigger only, not after Adc_Stop */
+static void Test_Processor(void)
+{
+    Adc_ConfigType Config;
+    Adc_StatsType Stats;
+    uint32 Index;
+
+    Test_PowerOn();
+    Test_Ss    = ADC_SS1;
+    Test_Steps = 3;
+    Test_Block = 30;
+    Test_Config(&Config, ADC_SS1, ADC_TRIGGER_PROCESSOR, Test_Steps, Test_Block);
+    HOST_CHECK(Adc_Init(&Config));
+    Test_UdmaSync();
+    Test_AdcSync();
+    HOST_CHECK_EQUAL(Test_Adc[ADC_MODULE_0].ACTSS, 0);
+    HOST_CHECK_EQUAL((Test_Adc[ADC_MODULE_0].EMUX >> 4) & 0xF, ADC_TRIGGER_PROCESSOR);
+    HOST_CHECK_EQUAL(Udma_ControlTable[15].CHCTL >> UDMA_CHCTL_ARBSIZE_BITS_POS & 0xF, 1); /* 2 of 3 steps */
+    HOST_CHECK(Test_IrqEnabled[NVIC_IRQ_ADC0_SS0 + 1]);
+
+    Adc_Start(ADC_MODULE_0, ADC_SS1);
+    Test_Timer(10);
+    HOST_CHECK_EQUAL(Test_Sequence, 0);
+    for(Index = 0; Index < 25; Index++)
+    {
+        Adc_Trigger(ADC_MODULE_0, ADC_SS1);
+        if(Test_Adc[ADC_MODULE_0].PSSI & ADC_SEQUENCER_MASK(ADC_SS1))
+        {
+            Test_Adc[ADC_MODULE_0].PSSI = 0;
+            Test_Convert();
+        }
+    }
+    HOST_CHECK_EQUAL(Test_Sequence, 25);
+    HOST_CHECK_EQUAL(Test_Blocks, 2);
+
+    Adc_Stop(ADC_MODULE_0, ADC_SS1);
+    Test_Convert();
+    HOST_CHECK_EQUAL(Test_Sequence, 25);
+    HOST_CHECK(Adc_GetStats(ADC_MODULE_0, ADC_SS1, &Stats));
+    HOST_CHECK_EQUAL(Stats.Blocks, 2);
+    HOST_CHECK_EQUAL(Stats.Samples, 60);
+    HOST_CHECK_EQUAL(Test_Errors, 0);
+}
+
+/* Handler cost per sample for growing blocks, one interrupt per block */
+static void Test_Report(void)
+{
+    static const uint16 Blocks[] = { 16, 64, 256, 1024 };
+    Adc_StatsType Stats;
+    uint64 Cycles;
+    uint64 Previous = 0xFFFFFFFFFFFFFFFFULL;
+    uint32 Index;
+
+    for(Index = 0; Index < sizeof(Blocks) / sizeof(Blocks[0]); Index++)
+    {
+        Test_Start(ADC_SS0, TEST_STEPS, Blocks[Index]);
+        Test_Timer(65536 / TEST_STEPS);
+        HOST_CHECK(Adc_GetStats(ADC_MODULE_0, ADC_SS0, &Stats));
+        HOST_CHECK_EQUAL(Stats.Samples, 65536);
+        HOST_CHECK_EQUAL(Test_Interrupts, 65536 / Blocks[Index]);
+        HOST_CHECK_EQUAL(Stats.Overruns, 0);
+        HOST_CHECK_EQUAL(Test_Errors, 0);
+        Cycles = (uint64)Stats.DriverCycles + ((uint64)Stats.Blocks * TEST_BLOCK_CYCLES) +
+                 ((uint64)Test_Interrupts * (TEST_ENTRY_CYCLES + TEST_EXIT_CYCLES + (TEST_ADC_ACCESSES * TEST_REGISTER_CYCLES)));
+        printf("block %4u: %5u interrupts, %.4f interrupts and %.2f cycles of handler per sample\n",
+               Blocks[Index], Test_Interrupts, (double)Test_Interrupts / Stats.Samples,
+               (double)Cycles / Stats.Samples);
+        HOST_CHECK(Cycles < Previous);
+        Previous = Cycles;
+    }
+}
+
+int main(void)
+{
+    Test_Init();
+    Test_Ordering();
+    Test_Latency();
+    Test_FifoOverflow();
+    Test_SlowCallback();
+    Test_Processor();
+    Test_Report();
+
+    return Host_Report("adc_test");
+}
@@ -0,0 +1,408 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: atomic_test.c
+ *
+ * Description: Host test of the fallback of NVIC_Driver/ATOMIC.c, the operations ATOMIC.asm
+ *              implements with LDREX/STREX on the target. The stress tests run the operations
+ *              on one shared word from several threads at once, and a periodic SIGALRM plays an
+ *              interrupt: its handler runs the same operation on the same word in the middle
+ *              of the one of the thread it preempts, as an ISR would on one core. A lost or
+ *              doubled update shows in the final value or in the values the operations return.
+ *
+ *              Checks : returned and stored values of every operation, wrap of the addition,
+ *                       failed compare-exchange leaving the word unchanged, and under contention:
+ *                       every ticket of the fetch-add returned once, compare-exchange increments
+ *                       all counted, each thread finding its own bit as it left it among the
+ *                       bits of the others, exchanged tokens neither lost nor duplicated.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : atomic_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include <pthread.h>
+#include <signal.h>
+#include <sys/time.h>
+
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+
+#include "ATOMIC.c"
+
+#define TEST_THREADS                8
+#define TEST_ITERATIONS             1000000
+#define TEST_TICKETS                (TEST_THREADS * TEST_ITERATIONS)
+#define TEST_INTERRUPT_US           20
+#define TEST_MAX_INTERRUPTS         100000
+#define TEST_INTERRUPT_BIT          0x80000000
+
+static volatile uint32 Test_Word;
+static uint8 Test_Tickets[TEST_TICKETS + TEST_MAX_INTERRUPTS];
+
+/* Body of the interrupt for the running test, and the state it keeps between two interrupts */
+static void (*volatile Test_Interrupt)(void);
+static volatile uint32 Test_Interrupts;
+static volatile uint32 Test_InterruptErrors;
+static volatile uint32 Test_InterruptToken;
+static volatile char Test_InInterrupt;
+
+/* Per thread results, read after the join */
+typedef struct
+{
+    uint32 Index;
+    unsigned long Retries;
+    unsigned long Errors;
+    uint32 Token;
+}Test_ThreadType;
+
+static Test_ThreadType Test_Threads[TEST_THREADS];
+
+/* All the threads released at once so that they contend from the first iteration */
+static pthread_barrier_t Test_Start;
+
+/*******************************************************************************
+ *                                 Helpers                                     *
+ *******************************************************************************/
+
+/* One interrupt at a time as on one core, a signal taken by another thread meanwhile is dropped */
+static void Test_Handler(int a_Signal)
+{
+    (void)a_Signal;
+    if((Test_Interrupt != NULL) && (Test_Interrupts < TEST_MAX_INTERRUPTS) &&
+       !__atomic_test_and_set(&Test_InInterrupt, __ATOMIC_ACQUIRE))
+    {
+        Test_Interrupt();
+        Test_Interrupts++;
+        __atomic_clear(&Test_InInterrupt, __ATOMIC_RELEASE);
+    }
+}
+
+/* Start of a thread: released with the others, and from then on interruptible */
+static void Test_ThreadStart(void)
+{
+    sigset_t Signals;
+
+    pthread_barrier_wait(&Test_Start);
+    sigemptyset(&Signals);
+    sigaddset(&Signals, SIGALRM);
+    pthread_sigmask(SIG_UNBLOCK, &Signals, NULL);
+}
+
+static void Test_Run(void *(*a_Body)(void *), void (*a_Interrupt)(void))
+{
+    pthread_t Threads[TEST_THREADS];
+    struct itimerval Timer = { { 0, TEST_INTERRUPT_US }, { 0, TEST_INTERRUPT_US } };
+    struct itimerval Stop = { { 0, 0 }, { 0, 0 } };
+    sigset_t Signals;
+    uint32 Index;
+
+    /* Only the threads under test take the interrupt, the threads start with it masked */
+    sigemptyset(&Signals);
+    sigaddset(&Signals, SIGALRM);
+    pthread_sigmask(SIG_BLOCK, &Signals, NULL);
+    signal(SIGALRM, Test_Handler);
+    Test_Interrupt       = a_Interrupt;
+    Test_Interrupts      = 0;
+    Test_InterruptErrors = 0;
+    setitimer(ITIMER_REAL, &Timer, NULL);
+
+    pthread_barrier_init(&Test_Start, NULL, TEST_THREADS);
+    for(Index = 0; Index < TEST_THREADS; Index++)
+    {
+        memset(&Test_Threads[Index], 0, sizeof(Test_Threads[Index]));
+        Test_Threads[Index].Index = Index;
+        Test_Threads[Index].Token = (uint32)1 << Index;
+        pthread_create(&Threads[Index], NULL, a_Body, &Test_Threads[Index]);
+    }
+    for(Index = 0; Index < TEST_THREADS; Index++)
+    {
+        pthread_join(Threads[Index], NULL);
+    }
+    pthread_barrier_destroy(&Test_Start);
+
+    setitimer(ITIMER_REAL, &Stop, NULL);
+    Test_Interrupt = NULL;
+}
+
+/*******************************************************************************
+ *                                 Tests                                       *
+ *******************************************************************************/
+
+static void Test_Operations(void)
+{
+    volatile uint32 Word = 0xFFFFFFFE;
+
+    HOST_CHECK_EQUAL(Atomic_FetchAdd(&Word, 3), 0xFFFFFFFE);
+    HOST_CHECK_EQUAL(Word, 1);
+    HOST_CHECK_EQUAL(Atomic_FetchAdd(&Word, 0xFFFFFFFF), 1); /* Subtraction of 1 */
+    HOST_CHECK_EQUAL(Word, 0);
+
+    HOST_CHECK(!Atomic_CompareExchange(&Word, 5, 7));
+    HOST_CHECK_EQUAL(Word, 0);
+    HOST_CHECK(Atomic_CompareExchange(&Word, 0, 7));
+    HOST_CHECK_EQUAL(Word, 7);
+
+    HOST_CHECK_EQUAL(Atomic_Exchange(&Word, 0x12345678), 7);
+    HOST_CHECK_EQUAL(Word, 0x12345678);
+
+    Word = 0x0F;
+    HOST_CHECK_EQUAL(Atomic_SetBits(&Word, 0x30), 0x0F);
+    HOST_CHECK_EQUAL(Word, 0x3F);
+    HOST_CHECK_EQUAL(Atomic_ClearBits(&Word, 0x21), 0x3F);
+    HOST_CHECK_EQUAL(Word, 0x1E);
+    HOST_CHECK_EQUAL(Atomic_SetBits(&Word, 0), 0x1E);
+    HOST_CHECK_EQUAL(Atomic_ClearBits(&Word, 0), 0x1E);
+    HOST_CHECK_EQUAL(Word, 0x1E);
+
+    Atomic_ClearExclusive();
+    HOST_CHECK_EQUAL(ATOMIC_LOAD(Word), 0x1E);
+    ATOMIC_STORE(Word, 3);
+    HOST_CHECK_EQUAL(Word, 3);
+}
+
+/* Fetch-add as a ticket dispenser: each value returned to exactly one thread */
+static void *Test_FetchAddThread(void *a_Thread)
+{
+    uint32 Iteration;
+    uint32 Ticket;
+
+    Test_ThreadStart();
+    for(Iteration = 0; Iteration < TEST_ITERATIONS; Iteration++)
+    {
+        Ticket = Atomic_FetchAdd(&Test_Word, 1);
+        if(Ticket < (TEST_TICKETS + TEST_MAX_INTERRUPTS))
+        {
+            __atomic_fetch_add(&Test_Tickets[Ticket], 1, __ATOMIC_RELAXED);
+        }
+        else
+        {
+            ((Test_ThreadType *)a_Thread)->Errors++;
+        }
+    }
+    return NULL;
+}
+
+static void Test_FetchAddInterrupt(void)
+{
+    uint32 Ticket = Atomic_FetchAdd(&Test_Word, 1);
+
+    if(Ticket < (TEST_TICKETS + TEST_MAX_INTERRUPTS))
+    {
+        __atomic_fetch_add(&Test_Tickets[Ticket], 1, __ATOMIC_RELAXED);
+    }
+    else
+    {
+        Test_InterruptErrors++;
+    }
+}
+
+static void Test_FetchAdd(void)
+{
+    uint32 Ticket;
+    uint32 Single = 0;
+    unsigned long Errors = 0;
+    uint32 Index;
+
+    Test_Word = 0;
+    memset(Test_Tickets, 0, sizeof(Test_Tickets));
+    Test_Run(Test_FetchAddThread, Test_FetchAddInterrupt);
+
+    for(Ticket = 0; Ticket < (TEST_TICKETS + Test_Interrupts); Ticket++)
+    {
+        Single += (Test_Tickets[Ticket] == 1) ? 1 : 0;
+    }
+    for(Index = 0; Index < TEST_THREADS; Index++)
+    {
+        Errors += Test_Threads[Index].Errors;
+    }
+    HOST_CHECK_EQUAL(Test_Word, TEST_TICKETS + Test_Interrupts);
+    HOST_CHECK_EQUAL(Single, TEST_TICKETS + Test_Interrupts);
+    HOST_CHECK_EQUAL(Errors + Test_InterruptErrors, 0);
+    HOST_CHECK(Test_Interrupts > 0);
+    printf("fetch-add: %d threads, %d additions, %u interrupts\n", TEST_THREADS, TEST_TICKETS, Test_Interrupts);
+}
+
+/* Read, add and publish with compare-exchange, retried when another thread got in between */
+static void *Test_CompareExchangeThread(void *a_Thread)
+{
+    Test_ThreadType *Thread = a_Thread;
+    uint32 Iteration;
+    uint32 Value;
+
+    Test_ThreadStart();
+    for(Iteration = 0; Iteration < TEST_ITERATIONS; Iteration++)
+    {
+        for(;;)
+        {
+            Value = ATOMIC_LOAD(Test_Word);
+            if(Atomic_CompareExchange(&Test_Word, Value, Value + 3))
+            {
+                break;
+            }
+            Thread->Retries++;
+        }
+    }
+    return NULL;
+}
+
+static void Test_CompareExchangeInterrupt(void)
+{
+    uint32 Value;
+
+    do
+    {
+        Value = ATOMIC_LOAD(Test_Word);
+    }while(!Atomic_CompareExchange(&Test_Word, Value, Value + 3));
+}
+
+static void Test_CompareExchange(void)
+{
+    unsigned long Retries = 0;
+    uint32 Index;
+
+    Test_Word = 0;
+    Test_Run(Test_CompareExchangeThread, Test_CompareExchangeInterrupt);
+
+    for(Index = 0; Index < TEST_THREADS; Index++)
+    {
+        Retries += Test_Threads[Index].Retries;
+    }
+    HOST_CHECK_EQUAL(Test_Word, 3 * (TEST_TICKETS + Test_Interrupts));
+    printf("compare-exchange: %lu retries, %u interrupts\n", Retries, Test_Interrupts);
+}
+
+/* Each thread toggles its own bit, the old value must show the bit as the thread left it */
+static void *Test_BitsThread(void *a_Thread)
+{
+    Test_ThreadType *Thread = a_Thread;
+    uint32 Bit = (uint32)1 << Thread->Index;
+    uint32 Iteration;
+
+    Test_ThreadStart();
+    for(Iteration = 0; Iteration < TEST_ITERATIONS; Iteration++)
+    {
+        if(Atomic_SetBits(&Test_Word, Bit) & Bit)
+        {
+            Thread->Errors++;
+        }
+        if(!(Atomic_ClearBits(&Test_Word, Bit) & Bit))
+        {
+            Thread->Errors++;
+        }
+    }
+    Atomic_SetBits(&Test_Word, Bit << TEST_THREADS); /* Left set in the upper half */
+    return NULL;
+}
+
+/* The interrupt toggles a bit of its own */
+static void Test_BitsInterrupt(void)
+{
+    if(Atomic_SetBits(&Test_Word, TEST_INTERRUPT_BIT) & TEST_INTERRUPT_BIT)
+    {
+        Test_InterruptErrors++;
+    }
+    if(!(Atomic_ClearBits(&Test_Word, TEST_INTERRUPT_BIT) & TEST_INTERRUPT_BIT))
+    {
+        Test_InterruptErrors++;
+    }
+}
+
+static void Test_Bits(void)
+{
+    unsigned long Errors;
+    uint32 Index;
+
+    Test_Word = 0;
+    Test_Run(Test_BitsThread, Test_BitsInterrupt);
+
+    Errors = Test_InterruptErrors;
+    for(Index = 0; Index < TEST_THREADS; Index++)
+    {
+        Errors += Test_Threads[Index].Errors;
+    }
+    HOST_CHECK_EQUAL(Errors, 0);
+    HOST_CHECK_EQUAL(Test_Word, ((1u << TEST_THREADS) - 1) << TEST_THREADS);
+}
+
+/* Tokens of one bit each passed through the shared word, it holds one token or none */
+static void *Test_ExchangeThread(void *a_Thread)
+{
+    Test_ThreadType *Thread = a_Thread;
+    uint32 Iteration;
+
+    Test_ThreadStart();
+    for(Iteration = 0; Iteration < TEST_ITERATIONS; Iteration++)
+    {
+        Thread->Token = Atomic_Exchange(&Test_Word, Thread->Token);
+        if((Thread->Token & (Thread->Token - 1)) != 0)
+        {
+            Thread->Errors++; /* Two tokens merged */
+        }
+    }
+    return NULL;
+}
+
+/* The interrupt holds a token of its own between two interrupts */
+static void Test_ExchangeInterrupt(void)
+{
+    Test_InterruptToken = Atomic_Exchange(&Test_Word, Test_InterruptToken);
+    if((Test_InterruptToken & (Test_InterruptToken - 1)) != 0)
+    {
+        Test_InterruptErrors++;
+    }
+}
+
+static void Test_Exchange(void)
+{
+    unsigned long Errors = 0;
+    uint32 Tokens;
+    uint32 Count;
+    uint32 Index;
+
+    Test_Word = 0;
+    Test_InterruptToken = TEST_INTERRUPT_BIT;
+    Test_Run(Test_ExchangeThread, Test_ExchangeInterrupt);
+
+    Errors = Test_InterruptErrors;
+    Tokens = Test_Word;
+    Count  = (Test_Word != 0) ? 1 : 0;
+    if(Test_InterruptToken != 0)
+    {
+        Count++;
+        Errors += (Tokens & Test_InterruptToken) ? 1 : 0;
+        Tokens |= Test_InterruptToken;
+    }
+    for(Index = 0; Index < TEST_THREADS; Index++)
+    {
+        Errors += Test_Threads[Index].Errors;
+        if(Test_Threads[Index].Token != 0)
+        {
+            Count++;
+            if(Tokens & Test_Threads[Index].Token)
+            {
+                Errors++; /* Duplicated */
+            }
+            Tokens |= Test_Threads[Index].Token;
+        }
+    }
+    HOST_CHECK_EQUAL(Errors, 0);
+    HOST_CHECK_EQUAL(Count, TEST_THREADS + 1);
+    HOST_CHECK_EQUAL(Tokens, ((1u << TEST_THREADS) - 1) | TEST_INTERRUPT_BIT);
+}
+
+int main(void)
+{
+    Test_Operations();
+    Test_FetchAdd();
+    Test_CompareExchange();
+    Test_Bits();
+    Test_Exchange();
+
+    return Host_Report("atomic_test");
+}
@@ -0,0 +1,285 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: boot_test.c
+ *
+ * Description: Host test of NVIC_Driver/BOOT.c. The SYSCTL RCGCx and PRx banks and the DWT cycle
+ *              counter are in host memory. Each poll of the PRx bank advances the cycle counter and
+ *              runs a model of the peripherals: a peripheral reports ready a fixed number of cycles
+ *              after its RCGCx bit is set, or never.
+ *
+ *              Checks : clocks enabled in one batch before the first poll and added to the ones
+ *                       already running, bring-up time of the batch against the sum of the
+ *                       latencies of a one at a time bring-up, ready timeout, NVIC priorities and
+ *                       enables applied in one pass after the clocks, milestone records.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : boot_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+
+#define TEST_BANK_WORDS             24
+#define TEST_BITS                   32
+
+static uint32 Test_Rcgc[TEST_BANK_WORDS];
+static uint32 Test_PrBank[TEST_BANK_WORDS];
+static uint32 Test_CycCnt;
+
+static volatile uint32 *Test_Pr(void);
+
+#undef SYSCTL_RCGCWD_REG
+#undef SYSCTL_PRWD_REG
+#undef DWT_CYCCNT_REG
+#define SYSCTL_RCGCWD_REG           Test_Rcgc[0]
+#define SYSCTL_PRWD_REG             (*Test_Pr())
+#define DWT_CYCCNT_REG              Test_CycCnt
+
+#include "BOOT.c"
+
+#define TEST_POLL_CYCLES            40u         /* Cycles of one poll of the PRx bank */
+#define TEST_NEVER                  0xFFFFFFFFu
+
+static uint32 Test_Latency[TEST_BANK_WORDS];    /* Cycles from the RCGCx bit to the PRx bit, per bank */
+static uint32 Test_EnabledAt[TEST_BANK_WORDS][TEST_BITS];
+static uint32 Test_Polls;
+static uint32 Test_ClockHz = 16000000;
+
+/* NVIC calls in order */
+static NVIC_IRQType Test_PriorityIrqs[8];
+static NVIC_IRQPriorityType Test_Priorities[8];
+static uint8 Test_PriorityCalls;
+static NVIC_IRQType Test_EnabledIrqs[8];
+static uint8 Test_EnableCalls;
+static uint32 Test_FirstNvicCycle;
+
+/*******************************************************************************
+ *                        Modules used by the driver                           *
+ *******************************************************************************/
+
+void NVIC_SetPriorityIRQ(NVIC_IRQType IRQ_Num, NVIC_IRQPriorityType IRQ_Priority)
+{
+    if(Test_PriorityCalls == 0)
+    {
+        Test_FirstNvicCycle = Test_CycCnt;
+    }
+    if(Test_PriorityCalls < 8)
+    {
+        Test_PriorityIrqs[Test_PriorityCalls] = IRQ_Num;
+        Test_Priorities[Test_PriorityCalls]   = IRQ_Priority;
+    }
+    Test_PriorityCalls++;
+}
+
+void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num)
+{
+    if(Test_EnableCalls < 8)
+    {
+        Test_EnabledIrqs[Test_EnableCalls] = IRQ_Num;
+    }
+    Test_EnableCalls++;
+}
+
+uint32 Clock_GetCoreClock(void)
+{
+    return Test_ClockHz;
+}
+
+/*******************************************************************************
+ *                            Peripheral model                                 *
+ *******************************************************************************/
+
+/* One poll: time passes, the peripherals whose clock was enabled long enough become ready */
+static volatile uint32 *Test_Pr(void)
+{
+    uint32 Word;
+    uint32 Bit;
+
+    Test_Polls++;
+    Test_CycCnt += TEST_POLL_CYCLES;
+    for(Word = 0; Word < TEST_BANK_WORDS; Word++)
+    {
+        for(Bit = 0; Bit < TEST_BITS; Bit++)
+        {
+            if((0 == (Test_Rcgc[Word] & (1u << Bit))) || (Test_Latency[Word] == TEST_NEVER))
+            {
+                continue;
+            }
+            if(Test_EnabledAt[Word][Bit] == TEST_NEVER)
+            {
+                Test_EnabledAt[Word][Bit] = Test_CycCnt - TEST_POLL_CYCLES;
+            }
+            if((Test_CycCnt - Test_EnabledAt[Word][Bit]) >= Test_Latency[Word])
+            {
+                Test_PrBank[Word] |= 1u << Bit;
+            }
+        }
+    }
+    return &Test_PrBank[0];
+}
+
+static void Test_Reset(void)
+{
+    uint32 Word;
+    uint32 Bit;
+
+    memset(Test_Rcgc, 0, sizeof(Test_Rcgc));
+    memset(Test_PrBank, 0, sizeof(Test_PrBank));
+    for(Word = 0; Word < TEST_BANK_WORDS; Word++)
+    {
+        Test_Latency[Word] = 100;
+        for(Bit = 0; Bit < TEST_BITS; Bit++)
+        {
+            Test_EnabledAt[Word][Bit] = TEST_NEVER;
+        }
+    }
+    Test_Polls         = 0;
+    Test_CycCnt        = 0;
+    Test_PriorityCalls = 0;
+    Test_EnableCalls   = 0;
+    memset(Boot_Milestones, 0, sizeof(Boot_Milestones));
+}
+
+/*******************************************************************************
+ *                                 Tests                                       *
+ *******************************************************************************/
+
+static const Boot_IrqConfigType Test_Irqs[] =
+{
+    { NVIC_IRQ_GPIO_PORTF, 5, TRUE  },
+    { NVIC_IRQ_UART0,      2, FALSE },
+    { NVIC_IRQ_ADC0_SS0,   1, TRUE  },
+};
+
+static void Test_Config(Boot_ConfigType *a_Config)
+{
+    memset(a_Config, 0, sizeof(*a_Config));
+    a_Config->Clocks[BOOT_CLOCK_GPIO] = 0x21;  /* Ports A and F */
+    a_Config->Clocks[BOOT_CLOCK_UART] = 0x01;
+    a_Config->Clocks[BOOT_CLOCK_ADC]  = 0x01;
+    a_Config->Clocks[BOOT_CLOCK_DMA]  = 0x01;
+    a_Config->Irqs      = Test_Irqs;
+    a_Config->IrqsCount = sizeof(Test_Irqs) / sizeof(Test_Irqs[0]);
+}
+
+static void Test_Batch(void)
+{
+    Boot_ConfigType Config;
+    Boot_MilestoneRecordType Peripherals;
+    Boot_MilestoneRecordType Nvic;
+    uint32 Sequential = 0;
+    uint32 Slowest = 0;
+    uint32 Word;
+    uint32 Bit;
+
+    Test_Reset();
+    Test_Config(&Config);
+    Test_Latency[BOOT_CLOCK_GPIO] = 120;
+    Test_Latency[BOOT_CLOCK_UART] = 300;
+    Test_Latency[BOOT_CLOCK_ADC]  = 900;
+    Test_Latency[BOOT_CLOCK_DMA]  = 200;
+    Test_Rcgc[BOOT_CLOCK_GPIO]  = 0x02;        /* Port B already running */
+    Test_PrBank[BOOT_CLOCK_GPIO] = 0x02;
+
+    HOST_CHECK_EQUAL(Boot_BringUp(&Config), TRUE);
+    HOST_CHECK_EQUAL(Test_Rcgc[BOOT_CLOCK_GPIO], 0x23);
+    HOST_CHECK_EQUAL(Test_Rcgc[BOOT_CLOCK_UART], 0x01);
+    HOST_CHECK_EQUAL(Test_Rcgc[BOOT_CLOCK_ADC], 0x01);
+    HOST_CHECK_EQUAL(Test_Rcgc[BOOT_CLOCK_DMA], 0x01);
+
+    /* Every clock was already set at the first poll, and the wait is the one of the slowest peripheral */
+    for(Word = 0; Word < TEST_BANK_WORDS; Word++)
+    {
+        for(Bit = 0; Bit < TEST_BITS; Bit++)
+        {
+            if(0 != (Config.Clocks[Word] & (1u << Bit)))
+            {
+                HOST_CHECK_EQUAL(Test_EnabledAt[Word][Bit], 0);
+                Sequential += Test_Latency[Word] + TEST_POLL_CYCLES;
+                Slowest = (Test_Latency[Word] > Slowest) ? Test_Latency[Word] : Slowest;
+            }
+        }
+    }
+    Peripherals = Boot_GetMilestone(BOOT_MILESTONE_PERIPHERALS);
+    HOST_CHECK(Peripherals.Cycles >= Slowest);
+    HOST_CHECK(Peripherals.Cycles <= Slowest + TEST_POLL_CYCLES);
+    HOST_CHECK_EQUAL(Peripherals.CoreClockHz, Test_ClockHz);
+    printf("bring-up: batched %u cycles in %u polls, one peripheral at a time %u cycles\n",
+           Peripherals.Cycles, Test_Polls, Sequential);
+    HOST_CHECK((Peripherals.Cycles + Slowest) <= Sequential);
+
+    /* NVIC configured after the clocks, in the order of the table, only the enabled ones enabled */
+    Nvic = Boot_GetMilestone(BOOT_MILESTONE_NVIC);
+    HOST_CHECK(Test_FirstNvicCycle >= Peripherals.Cycles);
+    HOST_CHECK(Nvic.Cycles >= Peripherals.Cycles);
+    HOST_CHECK_EQUAL(Test_PriorityCalls, 3);
+    HOST_CHECK_EQUAL(Test_PriorityIrqs[0], NVIC_IRQ_GPIO_PORTF);
+    HOST_CHECK_EQUAL(Test_Priorities[0], 5);
+    HOST_CHECK_EQUAL(Test_PriorityIrqs[1], NVIC_IRQ_UART0);
+    HOST_CHECK_EQUAL(Test_Priorities[1], 2);
+    HOST_CHECK_EQUAL(Test_PriorityIrqs[2], NVIC_IRQ_ADC0_SS0);
+    HOST_CHECK_EQUAL(Test_EnableCalls, 2);
+    HOST_CHECK_EQUAL(Test_EnabledIrqs[0], NVIC_IRQ_GPIO_PORTF);
+    HOST_CHECK_EQUAL(Test_EnabledIrqs[1], NVIC_IRQ_ADC0_SS0);
+}
+
+static void Test_Timeout(void)
+{
+    Boot_ConfigType Config;
+
+    /* A peripheral that never reports ready: FALSE after the timeout, the NVIC is still configured */
+    Test_Reset();
+    Test_Config(&Config);
+    Test_Latency[BOOT_CLOCK_ADC] = TEST_NEVER;
+    HOST_CHECK_EQUAL(Boot_BringUp(&Config), FALSE);
+    HOST_CHECK_EQUAL(Test_Polls, BOOT_READY_TIMEOUT);
+    HOST_CHECK_EQUAL(Test_PriorityCalls, 3);
+
+    /* Nothing to enable: ready at the first poll */
+    Test_Reset();
+    memset(&Config, 0, sizeof(Config));
+    HOST_CHECK_EQUAL(Boot_BringUp(&Config), TRUE);
+    HOST_CHECK_EQUAL(Test_Polls, 1);
+    HOST_CHECK_EQUAL(Test_PriorityCalls, 0);
+
+    Test_Reset();
+    HOST_CHECK_EQUAL(Boot_BringUp(NULL_PTR), FALSE);
+    HOST_CHECK_EQUAL(Test_Polls, 0);
+}
+
+static void Test_Milestones(void)
+{
+    Boot_MilestoneRecordType Record;
+
+    Test_Reset();
+    Test_CycCnt  = 1234;
+    Test_ClockHz = 80000000;
+    Boot_Mark(BOOT_MILESTONE_MAIN);
+    Test_CycCnt  = 5678;
+    Boot_Mark(BOOT_MILESTONE_COUNT);
+
+    Record = Boot_GetMilestone(BOOT_MILESTONE_MAIN);
+    HOST_CHECK_EQUAL(Record.Cycles, 1234);
+    HOST_CHECK_EQUAL(Record.CoreClockHz, 80000000);
+    Record = Boot_GetMilestone(BOOT_MILESTONE_READY);
+    HOST_CHECK_EQUAL(Record.Cycles, 0);
+    Record = Boot_GetMilestone(BOOT_MILESTONE_COUNT);
+    HOST_CHECK_EQUAL(Record.Cycles, 0);
+    HOST_CHECK_EQUAL(Record.CoreClockHz, 0);
+}
+
+int main(void)
+{
+    Test_Batch();
+    Test_Timeout();
+    Test_Milestones();
+
+    return Host_Report("boot_test");
+}
@@ -0,0 +1,268 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: clock_test.c
+ *
+ * Description: Host test of NVIC_Driver/CLOCK.c. The driver is compiled in with the SYSCTL clock
+ *              registers in host memory. RIS and PLLSTAT are read through a model of the main
+ *              oscillator and of the PLL: the MOSC raises MOSCPUPRIS a number of polls after it is
+ *              enabled, the PLL locks a number of polls after it is powered up, either of them
+ *              can be set to never become ready.
+ *
+ *              Checks : SYSDIV of every requested frequency (closest not above, limits) and its
+ *                       inverse, the register sequence of a switch to the PLL and to the MOSC,
+ *                       the MOSC selected only after MOSCPUPRIS, the PLL lock timeout and the
+ *                       MOSC power up timeout (PLL powered down, 16 MHz, notifiers called),
+ *                       notifier registration.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : clock_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+
+#define TEST_RCC_RESET              0x078E3AD1u /* MOSCDIS, PIOSC, XTAL 0x0B */
+#define TEST_RCC2_RESET             0x07C06810u /* PIOSC, BYPASS2, PWRDN2 */
+#define TEST_OSCSRC2_PIOSC          0x00000010u
+#define TEST_NEVER                  0xFFFFFFFFu
+
+static uint32 Test_Rcc;
+static uint32 Test_Rcc2;
+static uint32 Test_RisReg;
+static uint32 Test_MiscReg;
+static uint32 Test_PllStatReg;
+
+static uint32 Test_MoscPolls;                   /* Polls of RIS until MOSCPUPRIS, TEST_NEVER: the crystal is dead */
+static uint32 Test_LockPolls;                   /* Polls of PLLSTAT until LOCK, TEST_NEVER: the PLL fails */
+static uint32 Test_RisReads;
+static uint32 Test_PllStatReads;
+static uint32 Test_EarlyMoscSelects;            /* OSCSRC2 on the MOSC while MOSCPUPRIS was not seen yet */
+
+static volatile uint32 *Test_Ris(void);
+static volatile uint32 *Test_PllStat(void);
+
+#undef SYSCTL_RCC_REG
+#undef SYSCTL_RCC2_REG
+#undef SYSCTL_RIS_REG
+#undef SYSCTL_MISC_REG
+#undef SYSCTL_PLLSTAT_REG
+#define SYSCTL_RCC_REG              Test_Rcc
+#define SYSCTL_RCC2_REG             Test_Rcc2
+#define SYSCTL_RIS_REG              (*Test_Ris())
+#define SYSCTL_MISC_REG             Test_MiscReg
+#define SYSCTL_PLLSTAT_REG          (*Test_PllStat())
+
+#include "CLOCK.c"
+
+static uint32 Test_Notifications;
+static uint32 Test_NotifiedHz;
+
+/*******************************************************************************
+ *                            Oscillator model                                 *
+ *******************************************************************************/
+
+static volatile uint32 *Test_Ris(void)
+{
+    if(0 != (Test_MiscReg & CLOCK_MOSCPUP_MASK))
+    {
+        Test_RisReg  &= ~CLOCK_MOSCPUP_MASK; /* Write 1 to clear */
+        Test_MiscReg &= ~CLOCK_MOSCPUP_MASK;
+    }
+    Test_RisReads++;
+    if((0 == (Test_Rcc & CLOCK_RCC_MOSCDIS_MASK)) && (Test_MoscPolls != TEST_NEVER) && (Test_RisReads > Test_MoscPolls))
+    {
+        Test_RisReg |= CLOCK_MOSCPUP_MASK;
+    }
+    if((0 == (Test_RisReg & CLOCK_MOSCPUP_MASK)) && (0 == (Test_Rcc2 & CLOCK_RCC2_OSCSRC2_MASK)))
+    {
+        Test_EarlyMoscSelects++;
+    }
+    return &Test_RisReg;
+}
+
+static volatile uint32 *Test_PllStat(void)
+{
+    if((0 != (Test_Rcc2 & CLOCK_RCC2_PWRDN2_MASK)) || (Test_LockPolls == TEST_NEVER))
+    {
+        Test_PllStatReg = 0;
+    }
+    else if(Test_PllStatReads >= Test_LockPolls)
+    {
+        Test_PllStatReg = CLOCK_PLLSTAT_LOCK_MASK;
+    }
+    Test_PllStatReads++;
+    return &Test_PllStatReg;
+}
+
+static void Test_Reset(uint32 a_MoscPolls, uint32 a_LockPolls)
+{
+    Test_Rcc              = TEST_RCC_RESET;
+    Test_Rcc2             = TEST_RCC2_RESET;
+    Test_RisReg           = CLOCK_MOSCPUP_MASK; /* Stale event, the MOSC was never started */
+    Test_MiscReg          = 0;
+    Test_PllStatReg       = 0;
+    Test_MoscPolls        = a_MoscPolls;
+    Test_LockPolls        = a_LockPolls;
+    Test_RisReads         = 0;
+    Test_PllStatReads     = 0;
+    Test_EarlyMoscSelects = 0;
+    Test_Notifications    = 0;
+    Test_NotifiedHz       = 0;
+    Clock_CoreClockHz     = CLOCK_RESET_HZ;
+}
+
+static void Test_Notifier(uint32 a_CoreClockHz)
+{
+    Test_Notifications++;
+    Test_NotifiedHz = a_CoreClockHz;
+}
+
+static void Test_OtherNotifier(uint32 a_CoreClockHz)
+{
+    (void)a_CoreClockHz;
+}
+
+/*******************************************************************************
+ *                                 Tests                                       *
+ *******************************************************************************/
+
+static void Test_Divider(void)
+{
+    uint32 Hz;
+    uint8 SysDiv;
+
+    HOST_CHECK_EQUAL(Clock_ComputeSysDiv(80000000), 4);
+    HOST_CHECK_EQUAL(Clock_ComputeSysDiv(120000000), 4);
+    HOST_CHECK_EQUAL(Clock_ComputeSysDiv(79999999), 5);
+    HOST_CHECK_EQUAL(Clock_ComputeSysDiv(66666667), 5);
+    HOST_CHECK_EQUAL(Clock_ComputeSysDiv(66666666), 6);
+    HOST_CHECK_EQUAL(Clock_ComputeSysDiv(50000000), 7);
+    HOST_CHECK_EQUAL(Clock_ComputeSysDiv(40000000), 9);
+    HOST_CHECK_EQUAL(Clock_ComputeSysDiv(20000000), 19);
+    HOST_CHECK_EQUAL(Clock_ComputeSysDiv(17000000), 23);
+    HOST_CHECK_EQUAL(Clock_ComputeSysDiv(16000001), 24);
+    HOST_CHECK_EQUAL(Clock_ComputeSysDiv(16000000), 24);
+    HOST_CHECK_EQUAL(Clock_ComputeSysDiv(1000000), 24);
+    HOST_CHECK_EQUAL(Clock_ComputeSysDiv(0), 24);
+    HOST_CHECK_EQUAL(Clock_SysDivToHz(4), 80000000);
+    HOST_CHECK_EQUAL(Clock_SysDivToHz(7), 50000000);
+    HOST_CHECK_EQUAL(Clock_SysDivToHz(24), 16000000);
+
+    /* Closest frequency not above the request over the whole PLL range */
+    for(Hz = CLOCK_MOSC_HZ + 1; Hz < CLOCK_MAX_HZ; Hz += 9973)
+    {
+        SysDiv = Clock_ComputeSysDiv(Hz);
+        if(!HOST_CHECK((SysDiv >= CLOCK_MIN_SYSDIV) && (SysDiv <= CLOCK_MAX_SYSDIV)) ||
+           !HOST_CHECK(Clock_SysDivToHz(SysDiv) <= Hz) ||
+           !HOST_CHECK((SysDiv == CLOCK_MIN_SYSDIV) || (Clock_SysDivToHz(SysDiv - 1) > Hz)))
+        {
+            fprintf(stderr, "  at %u Hz\n", Hz);
+            break;
+        }
+    }
+}
+
+static void Test_Switch(void)
+{
+    /* 80 MHz from reset: MOSC started and selected once stable, PLL locked, bypass removed */
+    Test_Reset(50, 200);
+    HOST_CHECK_EQUAL(Clock_SetCoreClock(80000000), TRUE);
+    HOST_CHECK_EQUAL(Clock_GetCoreClock(), 80000000);
+    HOST_CHECK(Test_RisReads > 50);
+    HOST_CHECK_EQUAL(Test_EarlyMoscSelects, 0);
+    HOST_CHECK(Test_PllStatReads > 200);
+    HOST_CHECK_EQUAL(Test_Rcc & CLOCK_RCC_MOSCDIS_MASK, 0);
+    HOST_CHECK_EQUAL((Test_Rcc & CLOCK_RCC_XTAL_MASK) >> CLOCK_RCC_XTAL_BITS_POS, CLOCK_RCC_XTAL_16MHZ);
+    HOST_CHECK((Test_Rcc & CLOCK_RCC_USESYSDIV_MASK) != 0);
+    HOST_CHECK((Test_Rcc2 & CLOCK_RCC2_USERCC2_MASK) != 0);
+    HOST_CHECK((Test_Rcc2 & CLOCK_RCC2_DIV400_MASK) != 0);
+    HOST_CHECK_EQUAL(Test_Rcc2 & (CLOCK_RCC2_SYSDIV2_MASK | CLOCK_RCC2_SYSDIV2LSB_MASK), 4u << (CLOCK_RCC2_SYSDIV2_BITS_POS - 1));
+    HOST_CHECK_EQUAL(Test_Rcc2 & (CLOCK_RCC2_PWRDN2_MASK | CLOCK_RCC2_BYPASS2_MASK | CLOCK_RCC2_OSCSRC2_MASK), 0);
+    HOST_CHECK_EQUAL(Test_Notifications, 1);
+    HOST_CHECK_EQUAL(Test_NotifiedHz, 80000000);
+
+    /* 50 MHz with the MOSC already running: no wait for a power up event */
+    Test_RisReads = 0;
+    Test_PllStatReads = 0;
+    HOST_CHECK_EQUAL(Clock_SetCoreClock(50000000), TRUE);
+    HOST_CHECK_EQUAL(Test_RisReads, 0);
+    HOST_CHECK_EQUAL(Clock_GetCoreClock(), 50000000);
+    HOST_CHECK_EQUAL(Test_Rcc2 & (CLOCK_RCC2_SYSDIV2_MASK | CLOCK_RCC2_SYSDIV2LSB_MASK), 7u << (CLOCK_RCC2_SYSDIV2_BITS_POS - 1));
+    HOST_CHECK_EQUAL(Test_NotifiedHz, 50000000);
+
+    /* 16 MHz and below: bypassed MOSC, PLL powered down, no divider */
+    HOST_CHECK_EQUAL(Clock_SetCoreClock(8000000), TRUE);
+    HOST_CHECK_EQUAL(Clock_GetCoreClock(), CLOCK_MOSC_HZ);
+    HOST_CHECK_EQUAL(Test_Rcc & CLOCK_RCC_USESYSDIV_MASK, 0);
+    HOST_CHECK_EQUAL(Test_Rcc2 & (CLOCK_RCC2_PWRDN2_MASK | CLOCK_RCC2_BYPASS2_MASK), CLOCK_RCC2_PWRDN2_MASK | CLOCK_RCC2_BYPASS2_MASK);
+    HOST_CHECK_EQUAL(Test_Rcc2 & CLOCK_RCC2_OSCSRC2_MASK, 0);
+    HOST_CHECK_EQUAL(Test_Notifications, 3);
+    HOST_CHECK_EQUAL(Test_NotifiedHz, CLOCK_MOSC_HZ);
+}
+
+static void Test_Timeouts(void)
+{
+    /* PLL lock timeout: PLL powered down again, 16 MHz from the bypassed MOSC, users notified */
+    Test_Reset(10, TEST_NEVER);
+    HOST_CHECK_EQUAL(Clock_SetCoreClock(80000000), FALSE);
+    HOST_CHECK_EQUAL(Test_PllStatReads, CLOCK_PLL_LOCK_TIMEOUT + 1);
+    HOST_CHECK_EQUAL(Clock_GetCoreClock(), CLOCK_MOSC_HZ);
+    HOST_CHECK_EQUAL(Test_Rcc & CLOCK_RCC_USESYSDIV_MASK, 0);
+    HOST_CHECK_EQUAL(Test_Rcc2 & (CLOCK_RCC2_PWRDN2_MASK | CLOCK_RCC2_BYPASS2_MASK), CLOCK_RCC2_PWRDN2_MASK | CLOCK_RCC2_BYPASS2_MASK);
+    HOST_CHECK_EQUAL(Test_Notifications, 1);
+    HOST_CHECK_EQUAL(Test_NotifiedHz, CLOCK_MOSC_HZ);
+
+    /* A later switch with a working PLL recovers */
+    Test_LockPolls = Test_PllStatReads + 100;
+    HOST_CHECK_EQUAL(Clock_SetCoreClock(40000000), TRUE);
+    HOST_CHECK_EQUAL(Clock_GetCoreClock(), 40000000);
+    HOST_CHECK_EQUAL(Test_NotifiedHz, 40000000);
+
+    /* Lock timeout from a running PLL clock: the users see the drop to 16 MHz */
+    Test_LockPolls = TEST_NEVER;
+    Test_Notifications = 0;
+    HOST_CHECK_EQUAL(Clock_SetCoreClock(80000000), FALSE);
+    HOST_CHECK_EQUAL(Clock_GetCoreClock(), CLOCK_MOSC_HZ);
+    HOST_CHECK_EQUAL(Test_Notifications, 1);
+    HOST_CHECK_EQUAL(Test_NotifiedHz, CLOCK_MOSC_HZ);
+
+    /* Dead crystal, with the stale power up event of reset: the event is cleared before the wait,
+     * the PIOSC stays selected and the PLL is not started */
+    Test_Reset(TEST_NEVER, 10);
+    HOST_CHECK_EQUAL(Clock_SetCoreClock(80000000), FALSE);
+    HOST_CHECK_EQUAL(Test_RisReads, CLOCK_MOSC_POWER_UP_TIMEOUT + 1);
+    HOST_CHECK_EQUAL(Test_PllStatReads, 0);
+    HOST_CHECK_EQUAL(Test_Rcc2 & CLOCK_RCC2_OSCSRC2_MASK, TEST_OSCSRC2_PIOSC);
+    HOST_CHECK((Test_Rcc2 & CLOCK_RCC2_PWRDN2_MASK) != 0);
+    HOST_CHECK_EQUAL(Test_Rcc & CLOCK_RCC_USESYSDIV_MASK, 0);
+    HOST_CHECK_EQUAL(Clock_GetCoreClock(), CLOCK_RESET_HZ);
+    HOST_CHECK_EQUAL(Test_Notifications, 1);
+    HOST_CHECK_EQUAL(Test_NotifiedHz, CLOCK_RESET_HZ);
+}
+
+static void Test_Notifiers(void)
+{
+    Clock_RegisterNotifier(Test_Notifier);
+    Clock_RegisterNotifier(NULL_PTR);
+    HOST_CHECK_EQUAL(Clock_NotifiersCount, 1);
+    Clock_RegisterNotifier(Test_OtherNotifier);
+    HOST_CHECK_EQUAL(Clock_NotifiersCount, 2);
+}
+
+int main(void)
+{
+    Clock_RegisterNotifier(Test_Notifier);
+    Test_Divider();
+    Test_Switch();
+    Test_Timeouts();
+    Test_Notifiers();
+
+    return Host_Report("clock_test");
+}
@@ -0,0 +1,256 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: coalesce_bench.c
+ *
+ * Description: Host benchmark of NVIC_Driver/COALESCE.c against one interrupt per item. A peripheral
+ *              raises one interrupt per item at a steady arrival rate and holds its request while
+ *              items wait in its FIFO. Both modes run on the same arrivals:
+ *
+ *              direct   : every arrival enters the handler, which processes its item.
+ *              coalesce : the handler calls Coalesce_Arrival, the items accumulate while the IRQ is
+ *                         masked and the batch handler processes them from Coalesce_Tick, which
+ *                         runs in every SysTick period.
+ *
+ *              The cycles are a cost model of the Cortex-M4 (exception entry and exit, work per
+ *              item, batch call, tick hook), the interrupt entries and batches come from the driver.
+ *              The rates stay under MaxBatch items per SysTick period, the most a window drains.
+ *
+ *              Checks : every item processed, batches not over MaxBatch, latency within the window,
+ *                       fewer interrupt entries than the direct mode from 2 items per window on and
+ *                       fewer cycles from 4 on, cycles per item going down as the rate goes up.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : coalesce_bench
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+
+#include "COALESCE.c"
+
+/* Cost model, core cycles */
+#define BENCH_ENTRY_CYCLES          12u         /* Exception entry, stacking and vector fetch */
+#define BENCH_EXIT_CYCLES           10u         /* Exception return, unstacking */
+#define BENCH_ITEM_CYCLES           40u         /* Read and process one item */
+#define BENCH_ARRIVAL_CYCLES        16u         /* Coalesce_Arrival and the NVIC mask write */
+#define BENCH_BATCH_CYCLES          20u         /* Batch handler call and NVIC unmask write */
+#define BENCH_HOOK_CYCLES           6u          /* Coalesce_Tick scan of one entry in every SysTick period */
+
+#define BENCH_TICK_CYCLES           80000u      /* SysTick period, 1 ms at 80 MHz */
+#define BENCH_TICKS                 1000u
+#define BENCH_WINDOW_TICKS          1u
+#define BENCH_MAX_BATCH             64u
+#define BENCH_FIFO_ITEMS            256u        /* Arrival cycle of every waiting item, for the latency */
+
+static boolean Bench_Enabled;
+static uint32 Bench_Fifo[BENCH_FIFO_ITEMS];
+static uint32 Bench_FifoHead;
+static uint32 Bench_FifoCount;
+static uint32 Bench_Now;
+static uint32 Bench_MaxLatency;
+static uint64 Bench_Cycles;
+static uint32 Bench_Entries;
+
+/*******************************************************************************
+ *                      Modules used by the driver                             *
+ *******************************************************************************/
+
+void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num)
+{
+    (void)IRQ_Num;
+    Bench_Enabled = TRUE;
+}
+
+void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num)
+{
+    (void)IRQ_Num;
+    Bench_Enabled = FALSE;
+}
+
+void SysTick_RegisterTickHook(SysTick_TickHookType a_Hook)
+{
+    (void)a_Hook;
+}
+
+/*******************************************************************************
+ *                            Peripheral model                                 *
+ *******************************************************************************/
+
+static void Bench_Push(void)
+{
+    HOST_CHECK(Bench_FifoCount < BENCH_FIFO_ITEMS);
+    Bench_Fifo[(Bench_FifoHead + Bench_FifoCount) % BENCH_FIFO_ITEMS] = Bench_Now;
+    Bench_FifoCount++;
+}
+
+static void Bench_Pop(void)
+{
+    uint32 Latency = Bench_Now - Bench_Fifo[Bench_FifoHead];
+
+    Bench_MaxLatency = (Latency > Bench_MaxLatency) ? Latency : Bench_MaxLatency;
+    Bench_FifoHead = (Bench_FifoHead + 1) % BENCH_FIFO_ITEMS;
+    Bench_FifoCount--;
+    Bench_Cycles += BENCH_ITEM_CYCLES;
+}
+
+static uint16 Bench_BatchHandler(uint16 a_MaxItems)
+{
+    uint16 Items = 0;
+
+    Bench_Cycles += BENCH_BATCH_CYCLES;
+    while((Items < a_MaxItems) && (Bench_FifoCount > 0))
+    {
+        Bench_Pop();
+        Items++;
+    }
+    return Items;
+}
+
+static void Bench_CoalescedHandler(void)
+{
+    Bench_Entries++;
+    Bench_Cycles += BENCH_ENTRY_CYCLES + BENCH_ARRIVAL_CYCLES + BENCH_EXIT_CYCLES;
+    Coalesce_Arrival(0);
+}
+
+static void Bench_DirectHandler(void)
+{
+    Bench_Entries++;
+    Bench_Cycles += BENCH_ENTRY_CYCLES + BENCH_EXIT_CYCLES;
+    Bench_Pop();
+}
+
+/*******************************************************************************
+ *                                Benchmark                                    *
+ *******************************************************************************/
+
+typedef struct
+{
+    uint32 Items;
+    uint32 Entries;
+    uint64 Cycles;
+    uint32 MaxLatency;
+}Bench_ResultType;
+
+static void Bench_Reset(void)
+{
+    Coalesce_EntriesCount = 0;
+    Bench_Enabled     = TRUE;
+    Bench_FifoHead    = 0;
+    Bench_FifoCount   = 0;
+    Bench_MaxLatency  = 0;
+    Bench_Cycles      = 0;
+    Bench_Entries     = 0;
+}
+
+/* a_Rate items per 16 SysTick periods, evenly spaced in time, then periods without arrivals until the FIFO is empty */
+static Bench_ResultType Bench_Run(uint32 a_Rate, boolean a_Coalesce)
+{
+    Coalesce_ConfigType Config = { NVIC_IRQ_ADC0_SS0, BENCH_WINDOW_TICKS, BENCH_MAX_BATCH, Bench_BatchHandler };
+    Bench_ResultType Result;
+    uint32 Arrivals = 0;
+    uint32 Next = 0;
+    uint32 Tick;
+
+    Bench_Reset();
+    if(a_Coalesce)
+    {
+        HOST_CHECK_EQUAL(Coalesce_Register(&Config), 0);
+    }
+    for(Tick = 1; (Tick <= BENCH_TICKS) || (Bench_FifoCount > 0); Tick++)
+    {
+        while((Next < (Tick * BENCH_TICK_CYCLES)) && (Tick <= BENCH_TICKS))
+        {
+            Bench_Now = Next;
+            Bench_Push();
+            if(Bench_Enabled)
+            {
+                if(a_Coalesce)
+                {
+                    Bench_CoalescedHandler();
+                }
+                else
+                {
+                    Bench_DirectHandler();
+                }
+            }
+            Arrivals++;
+            Next = (uint32)(((uint64)Arrivals * 16 * BENCH_TICK_CYCLES) / a_Rate);
+        }
+
+        Bench_Now = Tick * BENCH_TICK_CYCLES;
+        if(a_Coalesce)
+        {
+            Bench_Cycles += BENCH_HOOK_CYCLES;
+            Coalesce_Tick();
+
+            /* Unmasked with items still waiting: the held request enters the handler again */
+            if(Bench_Enabled && (Bench_FifoCount > 0))
+            {
+                Bench_CoalescedHandler();
+            }
+        }
+    }
+
+    Result.Items      = Arrivals;
+    Result.Entries    = Bench_Entries;
+    Result.Cycles     = Bench_Cycles;
+    Result.MaxLatency = Bench_MaxLatency;
+    return Result;
+}
+
+int main(void)
+{
+    static const uint32 Rates[] = { 4, 8, 16, 32, 64, 128, 256, 512 };
+    Bench_ResultType Direct;
+    Bench_ResultType Coalesced;
+    Coalesce_StatsType Stats = { 0, 0, 0, 0 };
+    uint64 PreviousPerItem = 0;
+    uint32 Index;
+
+    printf("window %u tick of %u cycles, max batch %u, %u ticks\n", BENCH_WINDOW_TICKS, BENCH_TICK_CYCLES,
+           BENCH_MAX_BATCH, BENCH_TICKS);
+    printf("%10s %8s | %8s %10s %6s | %8s %8s %10s %6s %10s\n", "items/tick", "items", "entries", "cycles",
+           "/item", "entries", "batches", "cycles", "/item", "latency");
+    for(Index = 0; Index < (sizeof(Rates) / sizeof(Rates[0])); Index++)
+    {
+        Direct    = Bench_Run(Rates[Index], FALSE);
+        Coalesced = Bench_Run(Rates[Index], TRUE);
+        Coalesce_GetStats(0, &Stats);
+
+        printf("%10.2f %8u | %8u %10llu %6llu | %8u %8u %10llu %6llu %10u\n", Rates[Index] / 16.0, Direct.Items,
+               Direct.Entries, (unsigned long long)Direct.Cycles, (unsigned long long)(Direct.Cycles / Direct.Items),
+               Coalesced.Entries, Stats.Batches, (unsigned long long)Coalesced.Cycles,
+               (unsigned long long)(Coalesced.Cycles / Coalesced.Items), Coalesced.MaxLatency);
+
+        HOST_CHECK_EQUAL(Direct.Items, Coalesced.Items);
+        HOST_CHECK_EQUAL(Direct.Entries, Direct.Items);
+        HOST_CHECK_EQUAL(Direct.MaxLatency, 0);
+        HOST_CHECK_EQUAL(Stats.Items, Coalesced.Items);
+        HOST_CHECK(Stats.MaxItems <= BENCH_MAX_BATCH);
+        HOST_CHECK(Coalesced.MaxLatency <= (BENCH_WINDOW_TICKS * BENCH_TICK_CYCLES));
+        HOST_CHECK(Coalesced.Entries <= Direct.Entries);
+        if(Rates[Index] >= (2 * 16 / BENCH_WINDOW_TICKS))
+        {
+            HOST_CHECK(Coalesced.Entries < Direct.Entries);
+        }
+        if(Rates[Index] >= (4 * 16 / BENCH_WINDOW_TICKS))
+        {
+            HOST_CHECK(Coalesced.Cycles < Direct.Cycles);
+        }
+        if(PreviousPerItem != 0)
+        {
+            HOST_CHECK((Coalesced.Cycles / Coalesced.Items) <= PreviousPerItem);
+        }
+        PreviousPerItem = Coalesced.Cycles / Coalesced.Items;
+    }
+
+    return Host_Report("coalesce_bench");
+}
@@ -0,0 +1,376 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: cyclic_gen.c
+ *
+ * Description: Frame table generator of the cyclic executive (NVIC_Driver/CYCLIC.h).
+ *              The minor frame is the greatest common divisor of the periods and the major
+ *              frame their least common multiple. Each task gets the phase offset that keeps
+ *              the most loaded frame as light as possible, so the rates that share a multiple
+ *              do not all fire on the same tick. Writes a Cyclic_TableType for Cyclic_Init.
+ *
+ *              Input : one task per line, '#' starts a comment
+ *                      <runnable> <period in ticks> <wcet> [phase in minor frames]
+ *                      the wcet is in any unit, the same as --frame-time
+ *
+ *              Build : gcc -O2 -o cyclic_gen cyclic_gen.c
+ *              Usage : cyclic_gen [--minor N] [--frame-time T] [--name Symbol] <tasks.txt>
+ *                      --minor      : ticks per minor frame, default the gcd of the periods
+ *                      --frame-time : length of a minor frame in the wcet unit, enables the
+ *                                     overload check
+ *                      --name       : name of the generated table, default Cyclic_Table
+ *
+ *              Exit status is 0 on success, 2 when a frame is overloaded (the table is
+ *              still written) and 1 on input errors.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define CYCLIC_MAX_TASKS            16      /* Must match CYCLIC.h */
+#define CYCLIC_MAX_FRAMES           65535u
+#define CYCLIC_MAX_MINOR_TICKS      255u
+#define TASK_NAME_SIZE              48
+
+typedef struct
+{
+    char Name[TASK_NAME_SIZE];
+    uint64_t Period;                        /* Ticks */
+    uint64_t Wcet;
+    long Phase;                             /* Minor frames, -1 lets the generator choose */
+    unsigned Index;                         /* Order in the input, index in the runnable table */
+}Task_Type;
+
+static Task_Type Tasks[CYCLIC_MAX_TASKS];
+static unsigned TasksCount;
+
+static uint64_t Gcd(uint64_t a_Left, uint64_t a_Right)
+{
+    while(a_Right != 0)
+    {
+        uint64_t Rest = a_Left % a_Right;
+
+        a_Left  = a_Right;
+        a_Right = Rest;
+    }
+    return a_Left;
+}
+
+/* Place the heaviest tasks first, they have the fewest good phases left once the frames fill up */
+static int Task_ComparePlacement(const void *a_Left, const void *a_Right)
+{
+    const Task_Type *Left  = a_Left;
+    const Task_Type *Right = a_Right;
+
+    if(Left->Wcet != Right->Wcet)
+    {
+        return (Left->Wcet > Right->Wcet) ? -1 : 1;
+    }
+    if(Left->Period != Right->Period)
+    {
+        return (Left->Period < Right->Period) ? -1 : 1;
+    }
+    return (int)Left->Index - (int)Right->Index;
+}
+
+/* Dispatch order inside a frame, rate monotonic then input order */
+static int Task_CompareRate(const void *a_Left, const void *a_Right)
+{
+    const Task_Type *Left  = &Tasks[*(const unsigned *)a_Left];
+    const Task_Type *Right = &Tasks[*(const unsigned *)a_Right];
+
+    if(Left->Period != Right->Period)
+    {
+        return (Left->Period < Right->Period) ? -1 : 1;
+    }
+    return (int)Left->Index - (int)Right->Index;
+}
+
+static int Read_Tasks(const char *a_Path)
+{
+    FILE *File = fopen(a_Path, "r");
+    char Line[256];
+    unsigned LineNumber = 0;
+
+    if(File == NULL)
+    {
+        perror(a_Path);
+        return 0;
+    }
+    while(fgets(Line, sizeof(Line), File) != NULL)
+    {
+        Task_Type Task;
+        unsigned long long Period, Wcet;
+        long Phase = -1;
+        char *Comment = strchr(Line, '#');
+        int Fields;
+
+        LineNumber++;
+        if(Comment != NULL)
+        {
+            *Comment = '\0';
+        }
+        memset(&Task, 0, sizeof(Task));
+        Fields = sscanf(Line, "%47s %llu %llu %ld", Task.Name, &Period, &Wcet, &Phase);
+        if(Fields <= 0)
+        {
+            continue;
+        }
+        if((Fields < 3) || (Period == 0) || ((Fields == 4) && (Phase < 0)))
+        {
+            fprintf(stderr, "%s:%u: expected <runnable> <period in ticks> <wcet> [phase]\n", a_Path, LineNumber);
+            fclose(File);
+            return 0;
+        }
+        if(TasksCount == CYCLIC_MAX_TASKS)
+        {
+            fprintf(stderr, "%s:%u: more than %u tasks\n", a_Path, LineNumber, CYCLIC_MAX_TASKS);
+            fclose(File);
+            return 0;
+        }
+        Task.Period = Period;
+        Task.Wcet   = Wcet;
+        Task.Phase  = (Fields == 4) ? Phase : -1;
+        Task.Index  = TasksCount;
+        Tasks[TasksCount++] = Task;
+    }
+    fclose(File);
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    const char *Name = "Cyclic_Table";
+    const char *Path = NULL;
+    uint64_t Minor = 0, FrameTime = 0, Major, Frames;
+    uint64_t *Load;
+    uint64_t MaxLoad = 0;
+    unsigned *Phases;
+    unsigned Order[CYCLIC_MAX_TASKS];
+    unsigned SlotsCount = 0;
+    int Overloaded = 0;
+    unsigned Index, Task;
+    uint64_t Frame;
+    int Arg;
+
+    for(Arg = 1; Arg < argc; Arg++)
+    {
+        if((strcmp(argv[Arg], "--minor") == 0) && (Arg + 1 < argc))
+        {
+            Minor = strtoull(argv[++Arg], NULL, 0);
+        }
+        else if((strcmp(argv[Arg], "--frame-time") == 0) && (Arg + 1 < argc))
+        {
+            FrameTime = strtoull(argv[++Arg], NULL, 0);
+        }
+        else if((strcmp(argv[Arg], "--name") == 0) && (Arg + 1 < argc))
+        {
+            Name = argv[++Arg];
+        }
+        else
+        {
+            Path = argv[Arg];
+        }
+    }
+    if(Path == NULL)
+    {
+        fprintf(stderr, "usage: %s [--minor N] [--frame-time T] [--name Symbol] <tasks.txt>\n", argv[0]);
+        return 1;
+    }
+    if(!Read_Tasks(Path))
+    {
+        return 1;
+    }
+    if(TasksCount == 0)
+    {
+        fprintf(stderr, "%s: no tasks\n", Path);
+        return 1;
+    }
+
+    /* Frames */
+    if(Minor == 0)
+    {
+        for(Index = 0; Index < TasksCount; Index++)
+        {
+            Minor = Gcd(Minor, Tasks[Index].Period);
+        }
+    }
+    if(Minor > CYCLIC_MAX_MINOR_TICKS)
+    {
+        fprintf(stderr, "%s: minor frame of %llu ticks, at most %u\n", Path, (unsigned long long)Minor, CYCLIC_MAX_MINOR_TICKS);
+        return 1;
+    }
+    Major = Minor;
+    for(Index = 0; Index < TasksCount; Index++)
+    {
+        if((Tasks[Index].Period % Minor) != 0)
+        {
+            fprintf(stderr, "%s: period of %s is not a multiple of the %llu ticks minor frame\n",
+                    Path, Tasks[Index].Name, (unsigned long long)Minor);
+            return 1;
+        }
+        Major = (Major / Gcd(Major, Tasks[Index].Period)) * Tasks[Index].Period;
+        if((Major / Minor) > CYCLIC_MAX_FRAMES)
+        {
+            fprintf(stderr, "%s: major frame longer than %u minor frames\n", Path, CYCLIC_MAX_FRAMES);
+            return 1;
+        }
+    }
+    Frames = Major / Minor;
+
+    /* Phases, greedy min-max placement of the heaviest task first */
+    Load   = calloc((size_t)Frames, sizeof(uint64_t));
+    Phases = calloc(TasksCount, sizeof(unsigned));
+    if((Load == NULL) || (Phases == NULL))
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    qsort(Tasks, TasksCount, sizeof(Task_Type), Task_ComparePlacement);
+    for(Task = 0; Task < TasksCount; Task++)
+    {
+        uint64_t Step = Tasks[Task].Period / Minor;
+        uint64_t Phase, BestPhase = 0, BestPeak = UINT64_MAX;
+
+        if(Tasks[Task].Phase >= 0)
+        {
+            if((uint64_t)Tasks[Task].Phase >= Step)
+            {
+                fprintf(stderr, "%s: phase of %s must be below %llu\n", Path, Tasks[Task].Name, (unsigned long long)Step);
+                return 1;
+            }
+            BestPhase = (uint64_t)Tasks[Task].Phase;
+        }
+        else
+        {
+            for(Phase = 0; Phase < Step; Phase++)
+            {
+                uint64_t Peak = 0;
+
+                for(Frame = Phase; Frame < Frames; Frame += Step)
+                {
+                    if(Load[Frame] + Tasks[Task].Wcet > Peak)
+                    {
+                        Peak = Load[Frame] + Tasks[Task].Wcet;
+                    }
+                }
+                if(Peak < BestPeak)
+                {
+                    BestPeak  = Peak;
+                    BestPhase = Phase;
+                }
+            }
+        }
+        for(Frame = BestPhase; Frame < Frames; Frame += Step)
+        {
+            Load[Frame] += Tasks[Task].Wcet;
+            SlotsCount++;
+        }
+        Phases[Tasks[Task].Index] = (unsigned)BestPhase;
+    }
+    for(Frame = 0; Frame < Frames; Frame++)
+    {
+        if(Load[Frame] > MaxLoad)
+        {
+            MaxLoad = Load[Frame];
+        }
+    }
+    Overloaded = (FrameTime != 0) && (MaxLoad > FrameTime);
+
+    /* Back to the input order, the runnable indexes follow it */
+    for(Index = 0; Index < TasksCount; Index++)
+    {
+        while(Tasks[Index].Index != Index)
+        {
+            Task_Type Swap = Tasks[Tasks[Index].Index];
+
+            Tasks[Tasks[Index].Index] = Tasks[Index];
+            Tasks[Index] = Swap;
+        }
+    }
+
+    printf("/* Generated by cyclic_gen from %s, do not edit */\n", Path);
+    printf("/* Minor frame %llu ticks, major frame %llu ticks (%llu frames), %u slots, peak frame load %llu%s */\n",
+           (unsigned long long)Minor, (unsigned long long)Major, (unsigned long long)Frames, SlotsCount,
+           (unsigned long long)MaxLoad, Overloaded ? " OVERLOADED" : "");
+    printf("#include \"CYCLIC.h\"\n\n");
+    printf("/*  %-24s %8s %8s %6s */\n", "Task", "Period", "WCET", "Phase");
+    for(Index = 0; Index < TasksCount; Index++)
+    {
+        printf("/*  %-24s %8llu %8llu %6u */\n", Tasks[Index].Name, (unsigned long long)Tasks[Index].Period,
+               (unsigned long long)Tasks[Index].Wcet, Phases[Index]);
+    }
+    printf("\n");
+    for(Index = 0; Index < TasksCount; Index++)
+    {
+        printf("extern void %s(void);\n", Tasks[Index].Name);
+    }
+
+    printf("\nstatic const Cyclic_RunnableType %s_Runnables[%u] =\n{\n", Name, TasksCount);
+    for(Index = 0; Index < TasksCount; Index++)
+    {
+        printf("    %s%s\n", Tasks[Index].Name, (Index + 1 < TasksCount) ? "," : "");
+    }
+    printf("};\n");
+
+    /* Slots of a frame in rate order, the shortest period first */
+    for(Index = 0; Index < TasksCount; Index++)
+    {
+        Order[Index] = Index;
+    }
+    qsort(Order, TasksCount, sizeof(unsigned), Task_CompareRate);
+    printf("\nstatic const uint8 %s_Slots[%u] =\n{", Name, SlotsCount);
+    for(Frame = 0; Frame < Frames; Frame++)
+    {
+        printf("\n    /* %4llu */", (unsigned long long)Frame);
+        for(Index = 0; Index < TasksCount; Index++)
+        {
+            Task = Order[Index];
+            if((Frame % (Tasks[Task].Period / Minor)) == Phases[Task])
+            {
+                printf(" %u,", Task);
+            }
+        }
+    }
+    printf("\n};\n");
+
+    printf("\nstatic const uint16 %s_FrameStart[%llu] =\n{", Name, (unsigned long long)(Frames + 1));
+    {
+        unsigned Start = 0;
+
+        for(Frame = 0; Frame <= Frames; Frame++)
+        {
+            printf("%s%u", (Frame == 0) ? "\n    " : (((Frame % 16) == 0) ? ",\n    " : ", "), Start);
+            if(Frame < Frames)
+            {
+                for(Task = 0; Task < TasksCount; Task++)
+                {
+                    if((Frame % (Tasks[Task].Period / Minor)) == Phases[Task])
+                    {
+                        Start++;
+                    }
+                }
+            }
+        }
+    }
+    printf("\n};\n");
+
+    printf("\nstatic const Cyclic_TableType %s =\n{\n", Name);
+    printf("    %s_Runnables, %s_Slots, %s_FrameStart, %llu, %u, %llu\n};\n",
+           Name, Name, Name, (unsigned long long)Frames, TasksCount, (unsigned long long)Minor);
+
+    if(Overloaded)
+    {
+        fprintf(stderr, "%s: peak frame load %llu exceeds the frame time %llu\n", Path,
+                (unsigned long long)MaxLoad, (unsigned long long)FrameTime);
+    }
+    free(Load);
+    free(Phases);
+    return Overloaded ? 2 : 0;
+}
@@ -0,0 +1,368 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: cyclic_test.c
+ *
+ * Description: Host test of NVIC_Driver/CYCLIC.c on the table cyclic_gen generates from
+ *              data/cyclic_tasks.txt (see Makefile). The SysTick tick hook is captured and
+ *              called once per tick, the runnables log the tick they run in and advance the DWT
+ *              cycle counter by their WCET, a runnable can leave the next SysTick wrap pending.
+ *
+ *              Checks : generated frames, phases, slots and peak frame load, dispatch order over
+ *                       several hyperperiods (one run per period at a constant phase, shortest
+ *                       period first inside a frame), run counts and execution times, overrun
+ *                       count and frame, minor frames of several ticks, rejected tables.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : cyclic_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+
+static SCB_RegType Test_Scb;
+static uint32 Test_CycCnt;
+static uint32 Test_Demcr;
+static uint32 Test_DwtCtrl;
+
+#undef SCB_REGS
+#undef DWT_CYCCNT_REG
+#undef DWT_CTRL_REG
+#undef CORE_DEBUG_DEMCR_REG
+#define SCB_REGS                    (&Test_Scb)
+#define DWT_CYCCNT_REG              Test_CycCnt
+#define DWT_CTRL_REG                Test_DwtCtrl
+#define CORE_DEBUG_DEMCR_REG        Test_Demcr
+
+#include "CYCLIC.c"
+#include "cyclic_table.h"
+
+#define TEST_TASKS                  4
+#define TEST_CYCLES_PER_WCET        100     /* Unit of the WCET of data/cyclic_tasks.txt */
+#define TEST_HYPERPERIODS           3
+#define TEST_MAX_RUNS               1024
+
+/* data/cyclic_tasks.txt, in the input order of the runnable indexes */
+static const uint32 Test_Periods[TEST_TASKS] = { 1, 10, 20, 100 };
+static const uint32 Test_Wcets[TEST_TASKS]   = { 2, 5, 5, 8 };
+
+typedef struct
+{
+    uint32 Tick;
+    uint8 Task;
+}Test_RunType;
+
+static SysTick_TickHookType Test_TickHook;
+static Test_RunType Test_Runs[TEST_MAX_RUNS];
+static uint32 Test_RunsCount;
+static uint32 Test_Tick;
+static uint8 Test_OverrunTask = 0xFF;
+static uint32 Test_OverrunTick;
+static uint32 Test_OverrunCycles;
+
+/*******************************************************************************
+ *                        Modules used by the driver                           *
+ *******************************************************************************/
+
+void SysTick_RegisterTickHook(SysTick_TickHookType a_Hook)
+{
+    Test_TickHook = a_Hook;
+}
+
+static void Test_Run(uint8 a_Task)
+{
+    if(Test_RunsCount < TEST_MAX_RUNS)
+    {
+        Test_Runs[Test_RunsCount].Tick = Test_Tick;
+        Test_Runs[Test_RunsCount].Task = a_Task;
+        Test_RunsCount++;
+    }
+    Test_CycCnt += Test_Wcets[a_Task] * TEST_CYCLES_PER_WCET;
+    if((a_Task == Test_OverrunTask) && (Test_Tick == Test_OverrunTick))
+    {
+        Test_CycCnt      += Test_OverrunCycles;
+        Test_Scb.INTCTRL |= SYSTICK_PENDING_MASK; /* Still running at the next wrap */
+    }
+}
+
+void Task_1ms(void)
+{
+    Test_Run(0);
+}
+
+void Task_10ms(void)
+{
+    Test_Run(1);
+}
+
+void Task_20ms(void)
+{
+    Test_Run(2);
+}
+
+void Task_100ms(void)
+{
+    Test_Run(3);
+}
+
+/*******************************************************************************
+ *                                 Helpers                                     *
+ *******************************************************************************/
+
+static void Test_Reset(void)
+{
+    memset(&Test_Scb, 0, sizeof(Test_Scb));
+    Test_TickHook    = NULL_PTR;
+    Test_RunsCount   = 0;
+    Test_Tick        = 0;
+    Test_OverrunTask = 0xFF;
+    Test_CycCnt      = 0xFFFFF000; /* The execution times are taken across the wrap */
+}
+
+/* a_Ticks SysTick periods, the wrap left pending by an overrun is taken before the next one */
+static void Test_Ticks(uint32 a_Ticks)
+{
+    while(a_Ticks-- != 0)
+    {
+        Test_Scb.INTCTRL &= ~SYSTICK_PENDING_MASK;
+        if(Test_TickHook != NULL_PTR)
+        {
+            Test_TickHook();
+        }
+        Test_Tick++;
+    }
+}
+
+/* Load of a frame of the table in WCET units */
+static uint32 Test_FrameLoad(const Cyclic_TableType *a_Table, uint16 a_Frame)
+{
+    uint32 Load = 0;
+    uint16 Slot;
+
+    for(Slot = a_Table->FrameStart[a_Frame]; Slot < a_Table->FrameStart[a_Frame + 1]; Slot++)
+    {
+        Load += Test_Wcets[a_Table->Slots[Slot]];
+    }
+    return Load;
+}
+
+/*******************************************************************************
+ *                                 Tests                                       *
+ *******************************************************************************/
+
+static void Test_Generation(void)
+{
+    uint32 PeakLoad = 0;
+    uint32 Slots = 0;
+    uint16 Frame;
+    uint16 Slot;
+    boolean Increasing = TRUE;
+    boolean Ordered = TRUE;
+
+    HOST_CHECK_EQUAL(Test_Table.FramesCount, 100);
+    HOST_CHECK_EQUAL(Test_Table.MinorTicks, 1);
+    HOST_CHECK_EQUAL(Test_Table.TasksCount, TEST_TASKS);
+    HOST_CHECK(Test_Table.Runnables[0] == Task_1ms);
+    HOST_CHECK(Test_Table.Runnables[3] == Task_100ms);
+    HOST_CHECK_EQUAL(Test_Table.FrameStart[0], 0);
+    HOST_CHECK_EQUAL(Test_Table.FrameStart[Test_Table.FramesCount], 100 + 10 + 5 + 1);
+
+    for(Frame = 0; Frame < Test_Table.FramesCount; Frame++)
+    {
+        if(Test_Table.FrameStart[Frame + 1] < Test_Table.FrameStart[Frame])
+        {
+            Increasing = FALSE;
+        }
+        for(Slot = Test_Table.FrameStart[Frame] + 1; Slot < Test_Table.FrameStart[Frame + 1]; Slot++)
+        {
+            if(Test_Periods[Test_Table.Slots[Slot - 1]] > Test_Periods[Test_Table.Slots[Slot]])
+            {
+                Ordered = FALSE;
+            }
+        }
+        if(Test_FrameLoad(&Test_Table, Frame) > PeakLoad)
+        {
+            PeakLoad = Test_FrameLoad(&Test_Table, Frame);
+        }
+        Slots += Test_Table.FrameStart[Frame + 1] - Test_Table.FrameStart[Frame];
+    }
+    HOST_CHECK(Increasing);
+    HOST_CHECK(Ordered);
+    HOST_CHECK_EQUAL(Slots, 116);
+
+    /* Heaviest first: 100 at frame 0, 10 at frame 1, 20 at frame 2, 1 everywhere. In phase the peak is 20 */
+    HOST_CHECK_EQUAL(PeakLoad, 10);
+    HOST_CHECK_EQUAL(Test_FrameLoad(&Test_Table, 0), 2 + 8);
+    HOST_CHECK_EQUAL(Test_FrameLoad(&Test_Table, 1), 2 + 5);
+    HOST_CHECK_EQUAL(Test_FrameLoad(&Test_Table, 2), 2 + 5);
+    HOST_CHECK_EQUAL(Test_FrameLoad(&Test_Table, 11), 2 + 5);
+    HOST_CHECK_EQUAL(Test_FrameLoad(&Test_Table, 22), 2 + 5);
+    HOST_CHECK_EQUAL(Test_FrameLoad(&Test_Table, 3), 2);
+}
+
+static void Test_Dispatch(void)
+{
+    uint32 Runs[TEST_TASKS] = { 0 };
+    uint32 First[TEST_TASKS];
+    uint32 Last[TEST_TASKS];
+    boolean Periodic = TRUE;
+    boolean Ordered = TRUE;
+    Cyclic_StatsType Stats;
+    Cyclic_TaskStatsType TaskStats;
+    uint32 Index;
+    uint8 Task;
+
+    Test_Reset();
+    HOST_CHECK(Cyclic_Init(&Test_Table));
+    HOST_CHECK(Test_TickHook == Cyclic_Tick);
+    HOST_CHECK(Test_Demcr & CORE_DEBUG_TRCENA_MASK);
+    HOST_CHECK(Test_DwtCtrl & DWT_CYCCNTENA_MASK);
+
+    Test_Ticks(TEST_HYPERPERIODS * 100);
+    for(Index = 0; Index < Test_RunsCount; Index++)
+    {
+        Task = Test_Runs[Index].Task;
+        if(Runs[Task] == 0)
+        {
+            First[Task] = Test_Runs[Index].Tick;
+        }
+        else if((Test_Runs[Index].Tick - Last[Task]) != Test_Periods[Task])
+        {
+            Periodic = FALSE;
+        }
+        Last[Task] = Test_Runs[Index].Tick;
+        Runs[Task]++;
+
+        /* Same tick: shortest period first */
+        if((Index > 0) && (Test_Runs[Index - 1].Tick == Test_Runs[Index].Tick) &&
+           (Test_Periods[Test_Runs[Index - 1].Task] >= Test_Periods[Task]))
+        {
+            Ordered = FALSE;
+        }
+    }
+    HOST_CHECK(Periodic);
+    HOST_CHECK(Ordered);
+    HOST_CHECK_EQUAL(Runs[0], 300);
+    HOST_CHECK_EQUAL(Runs[1], 30);
+    HOST_CHECK_EQUAL(Runs[2], 15);
+    HOST_CHECK_EQUAL(Runs[3], 3);
+    HOST_CHECK_EQUAL(First[0], 0);
+    HOST_CHECK_EQUAL(First[1], 1);
+    HOST_CHECK_EQUAL(First[2], 2);
+    HOST_CHECK_EQUAL(First[3], 0);
+    HOST_CHECK_EQUAL(Last[3], 200);
+
+    /* The first ticks of the second hyperperiod repeat the first ones */
+    HOST_CHECK_EQUAL(Test_Runs[0].Task, 0);
+    HOST_CHECK_EQUAL(Test_Runs[1].Task, 3);
+    HOST_CHECK_EQUAL(Test_Runs[2].Task, 0);
+    HOST_CHECK_EQUAL(Test_Runs[3].Task, 1);
+    HOST_CHECK_EQUAL(Test_Runs[116].Tick, 100);
+    HOST_CHECK_EQUAL(Test_Runs[116].Task, 0);
+    HOST_CHECK_EQUAL(Test_Runs[117].Task, 3);
+
+    Cyclic_GetStats(&Stats);
+    HOST_CHECK_EQUAL(Stats.Frames, 300);
+    HOST_CHECK_EQUAL(Stats.Overruns, 0);
+    HOST_CHECK_EQUAL(Stats.LastOverrunFrame, CYCLIC_NO_FRAME);
+    HOST_CHECK_EQUAL(Stats.MaxFrameCycles, 10 * TEST_CYCLES_PER_WCET);
+    for(Task = 0; Task < TEST_TASKS; Task++)
+    {
+        HOST_CHECK(Cyclic_GetTaskStats(Task, &TaskStats));
+        HOST_CHECK_EQUAL(TaskStats.Runs, Runs[Task]);
+        HOST_CHECK_EQUAL(TaskStats.LastCycles, Test_Wcets[Task] * TEST_CYCLES_PER_WCET);
+        HOST_CHECK_EQUAL(TaskStats.MaxCycles, Test_Wcets[Task] * TEST_CYCLES_PER_WCET);
+    }
+    HOST_CHECK(!Cyclic_GetTaskStats(CYCLIC_MAX_TASKS, &TaskStats));
+}
+
+static void Test_Overrun(void)
+{
+    Cyclic_StatsType Stats;
+    Cyclic_TaskStatsType TaskStats;
+
+    /* The 20 tick task runs long in frame 42 of the second hyperperiod */
+    Test_Reset();
+    HOST_CHECK(Cyclic_Init(&Test_Table));
+    Test_OverrunTask   = 2;
+    Test_OverrunTick   = 142;
+    Test_OverrunCycles = 5000;
+    Test_Ticks(TEST_HYPERPERIODS * 100);
+
+    Cyclic_GetStats(&Stats);
+    HOST_CHECK_EQUAL(Stats.Frames, 300);
+    HOST_CHECK_EQUAL(Stats.Overruns, 1);
+    HOST_CHECK_EQUAL(Stats.LastOverrunFrame, 42);
+    HOST_CHECK_EQUAL(Stats.MaxFrameCycles, (2 + 5) * TEST_CYCLES_PER_WCET + 5000);
+    HOST_CHECK(Cyclic_GetTaskStats(2, &TaskStats));
+    HOST_CHECK_EQUAL(TaskStats.MaxCycles, 5 * TEST_CYCLES_PER_WCET + 5000);
+    HOST_CHECK_EQUAL(TaskStats.LastCycles, 5 * TEST_CYCLES_PER_WCET);
+
+    /* The frames after it are dispatched on time */
+    HOST_CHECK_EQUAL(Test_Runs[Test_RunsCount - 1].Tick, 299);
+    HOST_CHECK_EQUAL(Test_RunsCount, 348);
+}
+
+static void Test_MinorTicks(void)
+{
+    static const Cyclic_RunnableType Runnables[2] = { Task_1ms, Task_10ms };
+    static const uint8 Slots[3]                   = { 0, 1, 0 };
+    static const uint16 FrameStart[3]             = { 0, 2, 3 };
+    static const uint8 BadSlots[3]                = { 0, 2, 0 };
+    static const uint16 BadStart[3]               = { 1, 2, 3 };
+    Cyclic_TableType Table = { Runnables, Slots, FrameStart, 2, 2, 3 };
+    Cyclic_TableType Bad;
+    uint32 Index;
+    boolean Expected = TRUE;
+
+    /* Two frames of three ticks: task 0 then 1 on tick 2, task 0 on tick 5, and again */
+    Test_Reset();
+    HOST_CHECK(Cyclic_Init(&Table));
+    Test_Ticks(6 * 4);
+    HOST_CHECK_EQUAL(Test_RunsCount, 3 * 4);
+    for(Index = 0; Index < Test_RunsCount; Index++)
+    {
+        if((Test_Runs[Index].Tick != ((Index / 3) * 6) + (((Index % 3) == 2) ? 5 : 2)) ||
+           (Test_Runs[Index].Task != Slots[Index % 3]))
+        {
+            Expected = FALSE;
+        }
+    }
+    HOST_CHECK(Expected);
+
+    /* Rejected tables, the running one is kept */
+    HOST_CHECK(!Cyclic_Init(NULL_PTR));
+    Bad = Table;
+    Bad.FramesCount = 0;
+    HOST_CHECK(!Cyclic_Init(&Bad));
+    Bad = Table;
+    Bad.MinorTicks = 0;
+    HOST_CHECK(!Cyclic_Init(&Bad));
+    Bad = Table;
+    Bad.TasksCount = CYCLIC_MAX_TASKS + 1;
+    HOST_CHECK(!Cyclic_Init(&Bad));
+    Bad = Table;
+    Bad.Slots = BadSlots;
+    HOST_CHECK(!Cyclic_Init(&Bad));
+    Bad = Table;
+    Bad.FrameStart = BadStart;
+    HOST_CHECK(!Cyclic_Init(&Bad));
+    Test_Ticks(6);
+    HOST_CHECK_EQUAL(Test_RunsCount, 3 * 5);
+}
+
+int main(void)
+{
+    Test_Generation();
+    Test_Dispatch();
+    Test_Overrun();
+    Test_MinorTicks();
+
+    return Host_Report("cyclic_test");
+}
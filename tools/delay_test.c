@@ -0,0 +1,478 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: delay_test.c
+ *
+ * Description: Host test of NVIC_Driver/DELAY.c with the SysTick handler of NVIC_Driver/SYSTICK.c.
+ *              The SysTick, SCB and DWT registers are in host memory behind a model of the core
+ *              clock: every register access of the drivers takes a pseudo random number of clocks,
+ *              the SysTick down counter runs from RELOAD to 0 and reloads, its wrap sets the
+ *              pending bit, and the pending tick is taken at the next access while PRIMASK is
+ *              clear. The ticks then land between any two reads of the wall clock. A write to
+ *              CURRENT clears the counter, WFI sleeps until the next wrap. The readings are checked
+ *              against the clocks since the first reload, a write of the handler shows as a drift.
+ *
+ *              Checks : wall clock readings inside the clocks of the call and without drift over
+ *                       the ticks, delays never shorter and at most a few accesses longer, a delay
+ *                       across the wrap of the 32-bit tick count, sleeps in thread mode only, a
+ *                       delay with interrupts disabled, the busy wait with SysTick stopped, the
+ *                       handler leaves the counter alone, the period between the tick hooks
+ *                       for periods of one and several wraps of the 24-bit counter.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : delay_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+
+#define TEST_MAX_STEP               24      /* Clocks of one register access: 1 .. TEST_MAX_STEP */
+#define TEST_SLACK                  (32 * TEST_MAX_STEP)
+#define TEST_NEVER_LIMIT            0xFFFFFFFFFFFFFFFFULL
+
+static SYSTICK_RegType Test_SysTick;
+static SCB_RegType Test_Scb;
+static uint32 Test_CycCnt;
+static uint32 Test_Demcr;
+static uint32 Test_DwtCtrl;
+static uint32 Test_Fpcc;
+
+static volatile void *Test_Access(volatile void *a_Register);
+static volatile uint32 *Test_Cycles(void);
+
+#undef SYSTICK_REGS
+#undef SCB_REGS
+#undef DWT_CYCCNT_REG
+#undef DWT_CTRL_REG
+#undef CORE_DEBUG_DEMCR_REG
+#undef FPU_FPCC_REG
+#define SYSTICK_REGS                ((volatile SYSTICK_RegType *)Test_Access(&Test_SysTick))
+#define SCB_REGS                    ((volatile SCB_RegType *)Test_Access(&Test_Scb))
+#define DWT_CYCCNT_REG              (*Test_Cycles())
+#define DWT_CTRL_REG                Test_DwtCtrl
+#define CORE_DEBUG_DEMCR_REG        Test_Demcr
+#define FPU_FPCC_REG                Test_Fpcc
+
+#include "ATOMIC.c"
+#include "SYSTICK.c"
+#include "DELAY.c"
+
+static uint64 Test_Clock;
+static uint64 Test_Limit;
+static uint32 Test_Current;             /* Counter value, CURRENT differs after a write of the driver */
+static uint32 Test_Random = 1;
+static boolean Test_Written;
+static uint64 Test_Origin;              /* First reload after SysTick_Init */
+static uint32 Test_TickBase;            /* Tick count at Test_Origin */
+static boolean Test_InHandler;
+static uint32 Test_Handled;
+static uint32 Test_Sleeps;
+static uint32 Test_CurrentWrites;
+static uint32 Test_CoreClock;
+static boolean Test_InWindow;           /* Every reading inside the clocks of its call */
+static uint32 Test_Hooks;               /* Calls of the tick hook, one per period */
+static uint64 Test_HookClock;           /* Clock of the last call of the tick hook */
+
+/*******************************************************************************
+ *                      Modules used by the drivers                            *
+ *******************************************************************************/
+
+uint32 Clock_GetCoreClock(void)
+{
+    return Test_CoreClock;
+}
+
+void Clock_RegisterNotifier(Clock_NotifierType a_Notifier)
+{
+    (void)a_Notifier;
+}
+
+void Power_SysTickRestart(void)
+{
+}
+
+void Trace_Record(Trace_EventType a_Event, uint8 a_Id)
+{
+    (void)a_Event;
+    (void)a_Id;
+}
+
+void Load_AccountIsr(uint8 a_ExceptionNum, uint32 a_Cycles)
+{
+    (void)a_ExceptionNum;
+    (void)a_Cycles;
+}
+
+void Fpu_IsrCheck(uint8 a_ExceptionNum, uint32 a_EntryState)
+{
+    (void)a_ExceptionNum;
+    (void)a_EntryState;
+}
+
+/*******************************************************************************
+ *                               Core model                                    *
+ *******************************************************************************/
+
+static uint32 Test_Step(void)
+{
+    Test_Random = (Test_Random * 1664525) + 1013904223;
+    return 1 + ((Test_Random >> 16) % TEST_MAX_STEP);
+}
+
+/* Count a_Clocks core clocks, the wrap of the counter sets the pending bit */
+static void Test_Advance(uint64 a_Clocks)
+{
+    uint64 Count;
+
+    while(a_Clocks != 0)
+    {
+        if(0 == (Test_SysTick.CTRL & SYSTICK_TIMER_ENABLE_MASK))
+        {
+            Test_Clock += a_Clocks;
+            break;
+        }
+        if(Test_Current == 0)
+        {
+            Test_Current = Test_SysTick.RELOAD;
+            Test_Clock++;
+            a_Clocks--;
+            if(Test_Written)
+            {
+                Test_Written  = FALSE;
+                Test_Origin   = Test_Clock;
+                Test_TickBase = SysTick_TickCount;
+            }
+            continue;
+        }
+        Count         = (a_Clocks < Test_Current) ? a_Clocks : Test_Current;
+        Test_Current -= (uint32)Count;
+        Test_Clock   += Count;
+        a_Clocks     -= Count;
+        if(Test_Current == 0)
+        {
+            Test_SysTick.CTRL |= SYSTICK_COUNT_BIT_MASK;
+            if(Test_SysTick.CTRL & SYSTICK_INTERRUPT_ENABLE_MASK)
+            {
+                Test_Scb.INTCTRL |= SYSTICK_PENDING_MASK;
+            }
+        }
+    }
+    Test_SysTick.CURRENT = Test_Current;
+    Test_CycCnt          = (uint32)Test_Clock;
+}
+
+/* The pending tick is taken between two accesses */
+static void Test_Interrupt(void)
+{
+    if((Test_Scb.INTCTRL & SYSTICK_PENDING_MASK) && (Host_Primask == 0) && !Test_InHandler)
+    {
+        Test_Scb.INTCTRL &= ~SYSTICK_PENDING_MASK;
+        Test_InHandler = TRUE;
+        Test_Handled++;
+        SysTick_Handler();
+        Test_InHandler = FALSE;
+    }
+}
+
+static volatile void *Test_Access(volatile void *a_Register)
+{
+    /* A write of the driver since the last access clears the counter */
+    if(Test_SysTick.CURRENT != Test_Current)
+    {
+        Test_Current = 0;
+        Test_CurrentWrites++;
+        Test_SysTick.CTRL &= ~SYSTICK_COUNT_BIT_MASK;
+    }
+    Test_Advance(Test_Step());
+    if(Test_Clock > Test_Limit)
+    {
+        HOST_CHECK(Test_Clock <= Test_Limit);
+        exit(Host_Report("delay_test"));
+    }
+    Test_Interrupt();
+    return a_Register;
+}
+
+static volatile uint32 *Test_Cycles(void)
+{
+    (void)Test_Access(&Test_CycCnt);
+    return &Test_CycCnt;
+}
+
+/* WFI: sleep until the next wrap, then take it */
+static void Test_Instruction(const char *a_Instruction)
+{
+    if((strcmp(a_Instruction, " WFI") == 0) && (Test_SysTick.CTRL & SYSTICK_TIMER_ENABLE_MASK))
+    {
+        Test_Sleeps++;
+        Test_Advance((Test_Current == 0) ? ((uint64)Test_SysTick.RELOAD + 1) : Test_Current);
+        Test_Interrupt();
+    }
+}
+
+static void Test_Hook(void)
+{
+    Test_Hooks++;
+    Test_HookClock = Test_Clock;
+}
+
+/* SysTick started at a_Ms with the core clock at a_CoreClock */
+static void Test_Start(uint32 a_CoreClock, uint16 a_Ms)
+{
+    memset(&Test_SysTick, 0, sizeof(Test_SysTick));
+    memset(&Test_Scb, 0, sizeof(Test_Scb));
+    Test_Clock           = 0;
+    Test_Limit           = TEST_NEVER_LIMIT;
+    Test_Current         = 0;
+    Test_Written         = TRUE;
+    Test_InWindow        = TRUE;
+    Test_CoreClock       = a_CoreClock;
+    SysTick_TickCount    = 0;
+    Host_Primask         = 0;
+    Host_InstructionHook = Test_Instruction;
+    SysTick_Init(a_Ms);
+    (void)SYSTICK_REGS->CTRL; /* First reload */
+    Test_Handled       = 0;
+    Test_Sleeps        = 0;
+    Test_CurrentWrites = 0;
+}
+
+/* Wall clock expected at a_Clock: the ticks since the origin and the counts of the current one */
+static uint64 Test_Expected(uint64 a_Clock)
+{
+    uint64 Period = (uint64)Test_SysTick.RELOAD + 1;
+    uint64 Span   = Period << 32;
+
+    return (((uint64)Test_TickBase * Period) + (a_Clock - Test_Origin)) % Span;
+}
+
+/* One reading, taken at one of the clocks of the call */
+static uint64 Test_Read(void)
+{
+    uint64 Span = ((uint64)Test_SysTick.RELOAD + 1) << 32;
+    uint64 Before = Test_Clock;
+    uint64 Wall = Delay_GetWallCycles();
+    uint64 After = Test_Clock;
+
+    if(((Wall + Span - Test_Expected(Before)) % Span) > (After - Before))
+    {
+        Test_InWindow = FALSE;
+    }
+    return Wall;
+}
+
+/* Core clocks of Delay_Us, checked against the requested time */
+static uint64 Test_Delay(uint32 a_Us)
+{
+    uint64 Cycles = (uint64)a_Us * (Test_CoreClock / 1000000);
+    uint64 Before = Test_Clock;
+    uint64 Elapsed;
+
+    Test_Limit = Test_Clock + (2 * Cycles) + TEST_SLACK + 1000000;
+    Delay_Us(a_Us);
+    Test_Limit = TEST_NEVER_LIMIT;
+    Elapsed    = Test_Clock - Before;
+    HOST_CHECK(Elapsed >= Cycles);
+    HOST_CHECK(Elapsed <= Cycles + TEST_SLACK);
+    return Elapsed;
+}
+
+/* Let the ticks come until the tick count moved by a_Ticks */
+static void Test_WaitTicks(uint32 a_Ticks)
+{
+    uint32 Start = SysTick_GetTickCount();
+
+    while((uint32)(SysTick_GetTickCount() - Start) < a_Ticks)
+    {
+        (void)SYSTICK_REGS->CTRL;
+    }
+}
+
+/*******************************************************************************
+ *                                 Tests                                       *
+ *******************************************************************************/
+
+static void Test_WallClock(void)
+{
+    uint64 Previous;
+    uint64 Wall;
+    uint64 Start;
+    uint32 Read;
+    boolean Monotonic = TRUE;
+
+    /* 1 ms at 16 MHz, the period fits the 24-bit counter */
+    Test_Start(16000000, 1);
+    HOST_CHECK_EQUAL(Test_SysTick.RELOAD, 16000 - 1);
+    Previous = Test_Read();
+    for(Read = 0; Read < 200000; Read++)
+    {
+        Wall = Test_Read();
+        if(Wall < Previous)
+        {
+            Monotonic = FALSE;
+        }
+        Previous = Wall;
+    }
+
+    /* Interrupts disabled over one wrap: the wrap is seen pending */
+    for(Read = 0; Read < 32; Read++)
+    {
+        Test_WaitTicks(2); /* The tick left pending, then one taken as it comes */
+        Host_Primask = 1;
+        Start        = Test_Clock;
+        while(Test_Clock < (Start + Test_SysTick.RELOAD + 1000))
+        {
+            Wall = Test_Read();
+            if(Wall < Previous)
+            {
+                Monotonic = FALSE;
+            }
+            Previous = Wall;
+        }
+        Host_Primask = 0;
+    }
+    HOST_CHECK(Monotonic);
+    HOST_CHECK(Test_InWindow);
+    HOST_CHECK(Test_Handled > 100);
+    HOST_CHECK_EQUAL(Test_Handled, SysTick_GetTickCount());
+
+    /* The handler never writes the counter, so the wall clock does not drift */
+    HOST_CHECK_EQUAL(Test_CurrentWrites, 0);
+}
+
+static void Test_Delays(void)
+{
+    uint32 Delay;
+    uint32 Sleeps;
+    uint32 Handled;
+
+    Test_Start(16000000, 1);
+    Test_WaitTicks(3);
+
+    /* Short and long delays, the long ones sleep between the ticks */
+    for(Delay = 0; Delay < 200; Delay++)
+    {
+        (void)Test_Delay(1 + ((Delay * 7919) % 5000));
+    }
+    Sleeps = Test_Sleeps;
+    (void)Test_Delay(10000);
+    HOST_CHECK((Test_Sleeps - Sleeps) >= 8);
+    HOST_CHECK((Test_Sleeps - Sleeps) <= 10);
+
+    /* In a handler the wait does not sleep */
+    Test_Scb.INTCTRL |= 15;
+    Sleeps = Test_Sleeps;
+    (void)Test_Delay(5000);
+    HOST_CHECK_EQUAL(Test_Sleeps, Sleeps);
+    Test_Scb.INTCTRL &= ~DELAY_VECACT_MASK;
+
+    /* Interrupts disabled: the wrap seen pending is counted, the tick is taken after */
+    Host_Primask = 1;
+    Handled = Test_Handled;
+    (void)Test_Delay(900);
+    HOST_CHECK_EQUAL(Test_Handled, Handled);
+    Host_Primask = 0;
+    (void)SYSTICK_REGS->CTRL;
+    HOST_CHECK(Test_Handled - Handled <= 1);
+
+    /* SysTick stopped: busy wait on the cycle counter */
+    SysTick_Stop();
+    (void)Test_Delay(100);
+    HOST_CHECK(Test_Demcr & CORE_DEBUG_TRCENA_MASK);
+    HOST_CHECK(Test_DwtCtrl & DWT_CYCCNTENA_MASK);
+}
+
+static void Test_TickWrap(void)
+{
+    uint32 Delay;
+
+    /* The 32-bit tick count wraps during the delays */
+    Test_Start(16000000, 1);
+    Test_WaitTicks(1);
+    Test_TickBase     = (0xFFFFFFFF - 3) - (SysTick_TickCount - Test_TickBase);
+    SysTick_TickCount = 0xFFFFFFFF - 3;
+    for(Delay = 0; Delay < 8; Delay++)
+    {
+        (void)Test_Delay(1500);
+        (void)Test_Read();
+    }
+    HOST_CHECK(SysTick_GetTickCount() < 16);
+    HOST_CHECK(Test_InWindow);
+}
+
+static void Test_LongPeriod(void)
+{
+    /* 500 ms at 80 MHz: three equal wraps of the 24-bit counter, each reloaded by the counter itself */
+    Test_Start(80000000, 500);
+    HOST_CHECK_EQUAL(SysTick_Periods[SysTick_ActivePeriod].OVF_Count, 2);
+    HOST_CHECK_EQUAL(Test_SysTick.RELOAD, 13333333 - 1);
+    Test_WaitTicks(9);
+    HOST_CHECK_EQUAL(Test_CurrentWrites, 0);
+    (void)Test_Delay(1000);
+}
+
+/* a_Periods periods of a_Ms at a_CoreClock between the tick hooks last a_Periods * a_Clocks core clocks */
+static void Test_Period(uint32 a_CoreClock, uint16 a_Ms, uint32 a_Periods, uint64 a_Clocks)
+{
+    const SysTick_PeriodType *Period;
+    uint64 First;
+    uint64 Elapsed;
+
+    Test_Start(a_CoreClock, a_Ms);
+    Period = &SysTick_Periods[SysTick_ActivePeriod];
+    HOST_CHECK_EQUAL(((uint64)Period->OVF_Count + 1) * ((uint64)Test_SysTick.RELOAD + 1), a_Clocks);
+    Test_WaitTicks(Period->OVF_Count + 1);
+    First = Test_HookClock;
+    Test_WaitTicks(a_Periods * (Period->OVF_Count + 1));
+    Elapsed = Test_HookClock - First;
+
+    /* The hook is called a few accesses after the wrap, a tick more per period shows after TEST_SLACK periods */
+    HOST_CHECK(Elapsed + TEST_SLACK >= a_Periods * a_Clocks);
+    HOST_CHECK(Elapsed <= (a_Periods * a_Clocks) + TEST_SLACK);
+}
+
+static void Test_Periods(void)
+{
+    Test_Period(16000000, 1, 2000, 16000);         /* One wrap */
+    Test_Period(80000000, 200, 2, 16000000);       /* One wrap, next to the 2^24 ticks of the counter */
+    Test_Period(80000000, 500, 2, 39999999);       /* Three wraps of 13333333 ticks */
+    Test_Period(80000000, 1000, 2, 80000000);      /* Five wraps of 16000000 ticks */
+}
+
+/* A clock change re-initialises SysTick in the middle of a period of several wraps */
+static void Test_ClockChange(void)
+{
+    uint32 Hooks;
+
+    Test_Start(80000000, 500);
+    Test_WaitTicks(3 + 2);
+    HOST_CHECK_EQUAL(SysTick_WrapCount, 2);
+
+    /* 500 ms at 16 MHz fit one wrap, the wraps counted for the old period are dropped */
+    Test_CoreClock = 16000000;
+    SysTick_ClockChanged(Test_CoreClock);
+    HOST_CHECK_EQUAL(SysTick_Periods[SysTick_ActivePeriod].OVF_Count, 0);
+    HOST_CHECK_EQUAL(SysTick_WrapCount, 0);
+    Hooks = Test_Hooks;
+    Test_WaitTicks(3);
+    HOST_CHECK_EQUAL(Test_Hooks - Hooks, 3);
+}
+
+int main(void)
+{
+    SysTick_RegisterTickHook(Test_Hook);
+    Test_WallClock();
+    Test_Delays();
+    Test_TickWrap();
+    Test_LongPeriod();
+    Test_ClockChange();
+    Test_Periods();
+
+    return Host_Report("delay_test");
+}
@@ -0,0 +1,443 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: driver_bench.c
+ *
+ * Description: Microbenchmark of the public services of NVIC_Driver/NVIC.c and SYSTICK.c. The
+ *              drivers are compiled in with the NVIC, SCB, SysTick, FPU and DWT registers in a host
+ *              register file; every use of a register by the driver goes through a counter. The
+ *              SysTick model sets COUNTFLAG on each access while the counter is enabled, so the
+ *              busy wait ends at its first poll of each overflow.
+ *
+ *              For each service the result is the register accesses per call, exact and the same
+ *              on every host, and the host time per call, the best of BENCH_REPEATS runs. A read
+ *              modify write of a register (|=, &=) counts as one access.
+ *
+ *              Baseline : one service per line, '#' starts a comment
+ *                         <service> <register accesses per call> <ns per call>
+ *
+ *              Build : make (see Makefile)
+ *              Usage : driver_bench [--baseline File] [--threshold Percent] [--accesses-only]
+ *                                   [--write-baseline File]
+ *                      --baseline      : fails when the accesses of a service differ from the file
+ *                                        or its time is more than the threshold above the file
+ *                      --threshold     : allowed time increase, default 25 percent. The time is
+ *                                        host dependent, compare baselines of the same host.
+ *                      --accesses-only : compare the accesses only, the time is printed
+ *
+ *              Exit status is 0 on success, 2 when the result is out of the baseline and 1 on
+ *              input errors.
+ *
+ *              "make check" compares the accesses of data/driver_bench_baseline.txt only, "make bench"
+ *              also compares the time with BENCH_THRESHOLD against a baseline of the same host.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include "host.h"
+#include <time.h>
+#include "tm4c123gh6pm_registers.h"
+
+static NVIC_RegType Bench_NvicRegs;
+static SCB_RegType Bench_ScbRegs;
+static SYSTICK_RegType Bench_SysTickRegs;
+static uint32 Bench_Fpcc;
+static uint32 Bench_CycCnt;
+static uint64 Bench_Accesses;
+
+/* One register access of the driver */
+static inline volatile void *Bench_Access(volatile void *a_Register)
+{
+    Bench_Accesses++;
+    return a_Register;
+}
+
+static inline volatile SYSTICK_RegType *Bench_SysTick(void)
+{
+    Bench_Accesses++;
+    if(0 != (Bench_SysTickRegs.CTRL & 0x1))
+    {
+        Bench_SysTickRegs.CTRL |= 0x10000; /* COUNTFLAG */
+    }
+    return &Bench_SysTickRegs;
+}
+
+#undef NVIC_REGS
+#undef SCB_REGS
+#undef SYSTICK_REGS
+#undef FPU_FPCC_REG
+#undef DWT_CYCCNT_REG
+#define NVIC_REGS                   ((volatile NVIC_RegType *)Bench_Access(&Bench_NvicRegs))
+#define SCB_REGS                    ((volatile SCB_RegType *)Bench_Access(&Bench_ScbRegs))
+#define SYSTICK_REGS                (Bench_SysTick())
+#define FPU_FPCC_REG                (*(volatile uint32 *)Bench_Access(&Bench_Fpcc))
+#define DWT_CYCCNT_REG              (*(volatile uint32 *)Bench_Access(&Bench_CycCnt))
+
+#include "ATOMIC.c"
+#include "NVIC.c"
+#include "SYSTICK.c"
+
+#define BENCH_REPEATS               5
+#define BENCH_NAME_SIZE             32
+#define BENCH_MAX_SERVICES          32
+
+/*******************************************************************************
+ *                      Modules used by the drivers                            *
+ *******************************************************************************/
+
+uint32 Clock_GetCoreClock(void)
+{
+    return 80000000;
+}
+
+void Clock_RegisterNotifier(Clock_NotifierType a_Notifier)
+{
+    (void)a_Notifier;
+}
+
+void Power_SysTickRestart(void)
+{
+}
+
+/* Only reached by a busy wait while the periodic tick runs, the benchmark waits with the tick stopped */
+void Delay_Ms(uint16 a_Ms)
+{
+    (void)a_Ms;
+}
+
+void Trace_Record(Trace_EventType a_Event, uint8 a_Id)
+{
+    (void)a_Event;
+    (void)a_Id;
+}
+
+void Load_AccountIsr(uint8 a_ExceptionNum, uint32 a_Cycles)
+{
+    (void)a_ExceptionNum;
+    (void)a_Cycles;
+}
+
+void Fpu_IsrCheck(uint8 a_ExceptionNum, uint32 a_EntryState)
+{
+    (void)a_ExceptionNum;
+    (void)a_EntryState;
+}
+
+/*******************************************************************************
+ *                               Services                                      *
+ *******************************************************************************/
+
+/* IRQs of the part and the exceptions with an enable or a priority, the calls cycle over them */
+#define NVIC_IRQ(Num, Name, Handler, Description)   NVIC_IRQ_##Name,
+static const NVIC_IRQType Bench_Irqs[] =
+{
+#include "NVIC_IRQS.h"
+};
+#undef NVIC_IRQ
+#define BENCH_IRQS                  (sizeof(Bench_Irqs) / sizeof(Bench_Irqs[0]))
+
+static const NVIC_ExceptionType Bench_Faults[] =
+{
+    EXCEPTION_MEM_FAULT_TYPE, EXCEPTION_BUS_FAULT_TYPE, EXCEPTION_USAGE_FAULT_TYPE
+};
+
+static const NVIC_ExceptionType Bench_Exceptions[] =
+{
+    EXCEPTION_MEM_FAULT_TYPE, EXCEPTION_BUS_FAULT_TYPE, EXCEPTION_USAGE_FAULT_TYPE, EXCEPTION_SVC_TYPE,
+    EXCEPTION_DEBUG_MONITOR_TYPE, EXCEPTION_PEND_SV_TYPE, EXCEPTION_SYSTICK_TYPE
+};
+
+static void Bench_EnableIrq(uint32 a_Call)
+{
+    NVIC_EnableIRQ(Bench_Irqs[a_Call % BENCH_IRQS]);
+}
+
+static void Bench_DisableIrq(uint32 a_Call)
+{
+    NVIC_DisableIRQ(Bench_Irqs[a_Call % BENCH_IRQS]);
+}
+
+static void Bench_SetPriorityIrq(uint32 a_Call)
+{
+    NVIC_SetPriorityIRQ(Bench_Irqs[a_Call % BENCH_IRQS], (NVIC_IRQPriorityType)(a_Call & NVIC_MAX_PRIORITY));
+}
+
+static void Bench_EnableException(uint32 a_Call)
+{
+    NVIC_EnableException(Bench_Faults[a_Call % 3]);
+}
+
+static void Bench_DisableException(uint32 a_Call)
+{
+    NVIC_DisableException(Bench_Faults[a_Call % 3]);
+}
+
+static void Bench_SetPriorityException(uint32 a_Call)
+{
+    NVIC_SetPriorityException(Bench_Exceptions[a_Call % 7], (NVIC_ExceptionPriorityType)(a_Call & NVIC_MAX_PRIORITY));
+}
+
+static void Bench_SysTickInit(uint32 a_Call)
+{
+    SysTick_Init((uint16)(1 + (a_Call % 1000)));
+}
+
+static void Bench_SysTickStart(uint32 a_Call)
+{
+    (void)a_Call;
+    SysTick_Start();
+}
+
+static void Bench_SysTickStop(uint32 a_Call)
+{
+    (void)a_Call;
+    SysTick_Stop();
+}
+
+static void Bench_SysTickBusyWait(uint32 a_Call)
+{
+    SysTick_StartBusyWait((uint16)(1 + (a_Call % 4)));
+}
+
+static void Bench_SysTickHandler(uint32 a_Call)
+{
+    (void)a_Call;
+    SysTick_Handler();
+}
+
+static void Bench_SysTickGetTickCount(uint32 a_Call)
+{
+    (void)a_Call;
+    (void)SysTick_GetTickCount();
+}
+
+static void Bench_SysTickDeInit(uint32 a_Call)
+{
+    (void)a_Call;
+    SysTick_DeInit();
+}
+
+typedef struct
+{
+    const char *Name;
+    void (*Call)(uint32 a_Call);
+    uint32 Calls;                         /* Calls of one run, a multiple of the cycled inputs */
+    boolean Ticking;                      /* SysTick running with a 1 ms period before the run */
+}Bench_ServiceType;
+
+static const Bench_ServiceType Bench_Services[] =
+{
+    { "nvic_enable_irq",             Bench_EnableIrq,            BENCH_IRQS * 10000,    FALSE },
+    { "nvic_disable_irq",            Bench_DisableIrq,           BENCH_IRQS * 10000,    FALSE },
+    { "nvic_set_priority_irq",       Bench_SetPriorityIrq,       BENCH_IRQS * 8 * 1000, FALSE },
+    { "nvic_enable_exception",       Bench_EnableException,      3 * 200000,            FALSE },
+    { "nvic_disable_exception",      Bench_DisableException,     3 * 200000,            FALSE },
+    { "nvic_set_priority_exception", Bench_SetPriorityException, 7 * 8 * 10000,         FALSE },
+    { "systick_init",                Bench_SysTickInit,          1000 * 200,            TRUE  },
+    { "systick_start",               Bench_SysTickStart,         500000,                TRUE  },
+    { "systick_stop",                Bench_SysTickStop,          500000,                TRUE  },
+    { "systick_busy_wait",           Bench_SysTickBusyWait,      4 * 50000,             FALSE },
+    { "systick_handler",             Bench_SysTickHandler,       500000,                TRUE  },
+    { "systick_get_tick_count",      Bench_SysTickGetTickCount,  500000,                TRUE  },
+    { "systick_deinit",              Bench_SysTickDeInit,        500000,                TRUE  },
+};
+#define BENCH_SERVICES              (sizeof(Bench_Services) / sizeof(Bench_Services[0]))
+
+typedef struct
+{
+    char Name[BENCH_NAME_SIZE];
+    double Accesses;
+    double Ns;
+}Bench_ResultType;
+
+static double Bench_Now(void)
+{
+    struct timespec Time;
+
+    clock_gettime(CLOCK_MONOTONIC, &Time);
+    return (double)Time.tv_sec * 1e9 + (double)Time.tv_nsec;
+}
+
+/* Registers at reset, then SysTick running with a 1 ms period or stopped */
+static void Bench_Setup(boolean a_Ticking)
+{
+    memset(&Bench_NvicRegs, 0, sizeof(Bench_NvicRegs));
+    memset(&Bench_ScbRegs, 0, sizeof(Bench_ScbRegs));
+    memset(&Bench_SysTickRegs, 0, sizeof(Bench_SysTickRegs));
+    SysTick_DeInit();
+    if(a_Ticking)
+    {
+        SysTick_Init(1);
+    }
+}
+
+static void Bench_Run(const Bench_ServiceType *a_Service, Bench_ResultType *a_Result)
+{
+    double Start;
+    double Ns;
+    uint64 Accesses;
+    uint32 Call;
+    unsigned Repeat;
+
+    snprintf(a_Result->Name, BENCH_NAME_SIZE, "%s", a_Service->Name);
+    a_Result->Ns = 0.0;
+    for(Repeat = 0; Repeat < BENCH_REPEATS; Repeat++)
+    {
+        Bench_Setup(a_Service->Ticking);
+        Accesses = Bench_Accesses;
+        Start = Bench_Now();
+        for(Call = 0; Call < a_Service->Calls; Call++)
+        {
+            a_Service->Call(Call);
+        }
+        Ns = (Bench_Now() - Start) / a_Service->Calls;
+        a_Result->Accesses = (double)(Bench_Accesses - Accesses) / a_Service->Calls;
+        if((Repeat == 0) || (Ns < a_Result->Ns))
+        {
+            a_Result->Ns = Ns;
+        }
+    }
+}
+
+/*******************************************************************************
+ *                               Baseline                                      *
+ *******************************************************************************/
+
+static void Bench_Write(FILE *a_File, const Bench_ResultType *a_Results, size_t a_Count)
+{
+    size_t Index;
+
+    fprintf(a_File, "# driver_bench: <service> <register accesses per call> <ns per call>\n");
+    for(Index = 0; Index < a_Count; Index++)
+    {
+        fprintf(a_File, "%-28s %8.2f %10.2f\n", a_Results[Index].Name, a_Results[Index].Accesses, a_Results[Index].Ns);
+    }
+}
+
+/* Every service of the baseline must be measured, with the same accesses and, when a_CheckTime, a time
+ * within the threshold */
+static int Bench_Compare(const char *a_Path, const Bench_ResultType *a_Results, size_t a_Count, double a_Threshold,
+                         int a_CheckTime)
+{
+    FILE *File = fopen(a_Path, "r");
+    char Line[128];
+    char Name[BENCH_NAME_SIZE];
+    double Accesses;
+    double Ns;
+    unsigned LineNumber = 0;
+    unsigned Found = 0;
+    int Passed = 1;
+    size_t Index;
+
+    if(File == NULL)
+    {
+        perror(a_Path);
+        return 0;
+    }
+    while(fgets(Line, sizeof(Line), File) != NULL)
+    {
+        char *Comment = strchr(Line, '#');
+
+        LineNumber++;
+        if(Comment != NULL)
+        {
+            *Comment = '\0';
+        }
+        if(sscanf(Line, "%31s %lf %lf", Name, &Accesses, &Ns) != 3)
+        {
+            continue;
+        }
+        for(Index = 0; (Index < a_Count) && (strcmp(a_Results[Index].Name, Name) != 0); Index++)
+        {
+        }
+        if(Index == a_Count)
+        {
+            fprintf(stderr, "%s:%u: %s is not measured\n", a_Path, LineNumber, Name);
+            Passed = 0;
+            continue;
+        }
+        Found++;
+        if((a_Results[Index].Accesses < (Accesses - 0.005)) || (a_Results[Index].Accesses > (Accesses + 0.005)))
+        {
+            fprintf(stderr, "%s:%u: %s makes %.2f register accesses per call, baseline %.2f\n", a_Path, LineNumber,
+                    Name, a_Results[Index].Accesses, Accesses);
+            Passed = 0;
+        }
+        if(a_CheckTime && (a_Results[Index].Ns > (Ns * (1.0 + (a_Threshold / 100.0)))))
+        {
+            fprintf(stderr, "%s:%u: %s takes %.2f ns per call, baseline %.2f ns + %.0f%%\n", a_Path, LineNumber,
+                    Name, a_Results[Index].Ns, Ns, a_Threshold);
+            Passed = 0;
+        }
+    }
+    fclose(File);
+    if(Found != a_Count)
+    {
+        fprintf(stderr, "%s: %u of %zu services in the baseline\n", a_Path, Found, a_Count);
+        Passed = 0;
+    }
+    return Passed;
+}
+
+int main(int argc, char **argv)
+{
+    static Bench_ResultType Results[BENCH_MAX_SERVICES];
+    const char *Baseline = NULL;
+    const char *NewBaseline = NULL;
+    double Threshold = 25.0;
+    int CheckTime = 1;
+    size_t Index;
+    int Arg;
+
+    for(Arg = 1; Arg < argc; Arg++)
+    {
+        if((strcmp(argv[Arg], "--baseline") == 0) && (Arg + 1 < argc))
+        {
+            Baseline = argv[++Arg];
+        }
+        else if((strcmp(argv[Arg], "--threshold") == 0) && (Arg + 1 < argc))
+        {
+            Threshold = strtod(argv[++Arg], NULL);
+        }
+        else if(strcmp(argv[Arg], "--accesses-only") == 0)
+        {
+            CheckTime = 0;
+        }
+        else if((strcmp(argv[Arg], "--write-baseline") == 0) && (Arg + 1 < argc))
+        {
+            NewBaseline = argv[++Arg];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--baseline File] [--threshold Percent] [--accesses-only] [--write-baseline File]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+
+    for(Index = 0; Index < BENCH_SERVICES; Index++)
+    {
+        Bench_Run(&Bench_Services[Index], &Results[Index]);
+    }
+    Bench_Write(stdout, Results, BENCH_SERVICES);
+
+    if(NewBaseline != NULL)
+    {
+        FILE *File = fopen(NewBaseline, "w");
+
+        if(File == NULL)
+        {
+            perror(NewBaseline);
+            return 1;
+        }
+        Bench_Write(File, Results, BENCH_SERVICES);
+        fclose(File);
+    }
+    if((Baseline != NULL) && !Bench_Compare(Baseline, Results, BENCH_SERVICES, Threshold, CheckTime))
+    {
+        return 2;
+    }
+    return 0;
+}
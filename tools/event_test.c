@@ -0,0 +1,441 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: event_test.c
+ *
+ * Description: Host test of NVIC_Driver/EVENT.c on the host fallback of NVIC_Driver/ATOMIC.c.
+ *              WFE and SEV are emulated for threads: every thread has an event register, SEV
+ *              sets all of them and WFE clears its own or sleeps until it is set. A WFE that
+ *              sleeps one second without being woken is counted as a lost wake up, the WFE after
+ *              it return at once so that a broken driver still ends the test.
+ *              The threads yield at random before their WFE and before the atomic operations of
+ *              EVENT.c, so that the other threads run between a test of the flags and the sleep
+ *              or the update that follows it.
+ *
+ *              Checks : ANY and ALL waits, clear on exit, Event_Get and Event_Clear, timeouts
+ *                       in SysTick periods with and without a ticking thread, rejected
+ *                       arguments, no lost wake up over ping pongs of two threads and over
+ *                       waits of ALL on bits set by two threads, every set consumed by exactly
+ *                       one of several waiters clearing on exit.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : event_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+
+#include "ATOMIC.c"
+
+#define TEST_ROUNDS                 20000
+#define TEST_CONSUMERS              4
+#define TEST_SETS                   20000
+#define TEST_LOST_SECONDS           1
+
+static pthread_mutex_t Test_Lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t Test_Wake  = PTHREAD_COND_INITIALIZER;
+
+/* Number of SEV, an event register is set while the count differs from the one its thread saw */
+static unsigned long Test_Events;
+static __thread unsigned long Test_Seen;
+static __thread unsigned int Test_Seed;
+
+static unsigned long Test_Wfe;
+static unsigned long Test_Lost;
+
+/* SysTick model, advanced by WFE (single thread) or by a ticking thread */
+static volatile uint32 Test_Tick;
+static boolean Test_WfeTicks;
+
+/*******************************************************************************
+ *                        Modules used by the driver                           *
+ *******************************************************************************/
+
+static void Test_Yield(void)
+{
+    if((rand_r(&Test_Seed) & 3) == 0)
+    {
+        sched_yield();
+    }
+}
+
+static uint32 Test_SetBits(volatile uint32 *a_Variable, uint32 a_Mask)
+{
+    Test_Yield();
+    return Atomic_SetBits(a_Variable, a_Mask);
+}
+
+static uint32 Test_ClearBits(volatile uint32 *a_Variable, uint32 a_Mask)
+{
+    Test_Yield();
+    return Atomic_ClearBits(a_Variable, a_Mask);
+}
+
+static boolean Test_CompareExchange(volatile uint32 *a_Variable, uint32 a_Expected, uint32 a_Desired)
+{
+    Test_Yield();
+    return Atomic_CompareExchange(a_Variable, a_Expected, a_Desired);
+}
+
+#define Atomic_SetBits              Test_SetBits
+#define Atomic_ClearBits            Test_ClearBits
+#define Atomic_CompareExchange      Test_CompareExchange
+
+#include "EVENT.c"
+
+uint32 SysTick_GetTickCount(void)
+{
+    return __atomic_load_n(&Test_Tick, __ATOMIC_SEQ_CST);
+}
+
+/*******************************************************************************
+ *                                 Helpers                                     *
+ *******************************************************************************/
+
+/* SEV, and the exception entry that wakes WFE as well */
+static void Test_Signal(void)
+{
+    pthread_mutex_lock(&Test_Lock);
+    Test_Events++;
+    pthread_cond_broadcast(&Test_Wake);
+    pthread_mutex_unlock(&Test_Lock);
+}
+
+static void Test_WaitForEvent(void)
+{
+    struct timespec Limit;
+
+    Test_Yield();
+    pthread_mutex_lock(&Test_Lock);
+    Test_Wfe++;
+    clock_gettime(CLOCK_REALTIME, &Limit);
+    Limit.tv_sec += TEST_LOST_SECONDS;
+    while((Test_Seen == Test_Events) && (Test_Lost == 0))
+    {
+        if(pthread_cond_timedwait(&Test_Wake, &Test_Lock, &Limit) != 0)
+        {
+            Test_Lost++;
+            break;
+        }
+    }
+    Test_Seen = Test_Events; /* WFE clears the event register */
+    pthread_mutex_unlock(&Test_Lock);
+}
+
+static void Test_Instruction(const char *a_Instruction)
+{
+    if(strstr(a_Instruction, "SEV") != NULL)
+    {
+        Test_Signal();
+    }
+    else if(strstr(a_Instruction, "WFE") != NULL)
+    {
+        if(Test_WfeTicks)
+        {
+            Test_Tick++; /* Only the SysTick interrupt ends the sleep */
+            Test_Wfe++;
+        }
+        else
+        {
+            Test_WaitForEvent();
+        }
+    }
+}
+
+/* The event register of a thread starts set, as a stale event would leave it */
+static void Test_ThreadInit(unsigned int a_Seed)
+{
+    Test_Seen = (unsigned long)-1;
+    Test_Seed = a_Seed;
+}
+
+/*******************************************************************************
+ *                                 Tests                                       *
+ *******************************************************************************/
+
+static void Test_Options(void)
+{
+    Event_GroupType Group;
+
+    Test_WfeTicks = TRUE;
+    Test_Tick = 0;
+
+    Event_Init(&Group);
+    HOST_CHECK_EQUAL(Event_Get(&Group), 0);
+    Event_Set(&Group, 0x05);
+    HOST_CHECK_EQUAL(Event_Get(&Group), 0x05);
+    HOST_CHECK_EQUAL(Test_Events, 1);
+
+    /* Already set: no WFE, the bits stay set unless cleared on exit */
+    Test_Wfe = 0;
+    HOST_CHECK_EQUAL(Event_Wait(&Group, 0x0C, EVENT_WAIT_ANY, 10), 0x04);
+    HOST_CHECK_EQUAL(Event_Get(&Group), 0x05);
+    HOST_CHECK_EQUAL(Event_Wait(&Group, 0x05, EVENT_WAIT_ALL | EVENT_CLEAR_ON_EXIT, 10), 0x05);
+    HOST_CHECK_EQUAL(Event_Get(&Group), 0);
+    HOST_CHECK_EQUAL(Test_Wfe, 0);
+
+    /* Part of an ALL mask: timeout after 10 periods, one WFE per period */
+    Event_Set(&Group, 0x11);
+    HOST_CHECK_EQUAL(Event_Wait(&Group, 0x03, EVENT_WAIT_ALL | EVENT_CLEAR_ON_EXIT, 10), 0);
+    HOST_CHECK_EQUAL(Test_Tick, 10);
+    HOST_CHECK_EQUAL(Test_Wfe, 10);
+    HOST_CHECK_EQUAL(Event_Get(&Group), 0x11);
+    Event_Clear(&Group, 0x10);
+    HOST_CHECK_EQUAL(Event_Get(&Group), 0x01);
+    HOST_CHECK_EQUAL(Event_Wait(&Group, 0x03, EVENT_WAIT_ANY | EVENT_CLEAR_ON_EXIT, 10), 0x01);
+    HOST_CHECK_EQUAL(Event_Get(&Group), 0);
+
+    /* No timeout: the flags are only tested */
+    Test_Wfe = 0;
+    HOST_CHECK_EQUAL(Event_Wait(&Group, 0x01, EVENT_WAIT_ANY, 0), 0);
+    HOST_CHECK_EQUAL(Test_Wfe, 0);
+
+    /* Timeout across the wrap of the tick count */
+    Test_Tick = 0xFFFFFFFE;
+    HOST_CHECK_EQUAL(Event_Wait(&Group, 0x01, EVENT_WAIT_ANY, 5), 0);
+    HOST_CHECK_EQUAL(Test_Tick, 3);
+
+    /* Rejected */
+    Test_Wfe = 0;
+    HOST_CHECK_EQUAL(Event_Wait(NULL_PTR, 0x01, EVENT_WAIT_ANY, 5), 0);
+    HOST_CHECK_EQUAL(Event_Wait(&Group, 0, EVENT_WAIT_ANY, 5), 0);
+    HOST_CHECK_EQUAL(Test_Wfe, 0);
+    HOST_CHECK_EQUAL(Event_Get(NULL_PTR), 0);
+    Event_Set(NULL_PTR, 1);
+    Event_Clear(NULL_PTR, 1);
+    Event_Init(NULL_PTR);
+
+    Test_WfeTicks = FALSE;
+}
+
+/* Ping pong: each side sets the bit of the other and sleeps until its own is set */
+static Event_GroupType Test_Ping;
+static Event_GroupType Test_Pong;
+static unsigned long Test_Pongs;
+
+static void *Test_PongThread(void *a_Argument)
+{
+    unsigned long Round;
+
+    Test_ThreadInit(2);
+    for(Round = 0; Round < TEST_ROUNDS; Round++)
+    {
+        if(Event_Wait(&Test_Ping, 0x01, EVENT_WAIT_ANY | EVENT_CLEAR_ON_EXIT, EVENT_WAIT_FOREVER) == 0x01)
+        {
+            Test_Pongs++;
+        }
+        Event_Set(&Test_Pong, 0x80000000);
+    }
+    return NULL;
+}
+
+static void Test_PingPong(void)
+{
+    pthread_t Thread;
+    unsigned long Round;
+    unsigned long Pings = 0;
+
+    Event_Init(&Test_Ping);
+    Event_Init(&Test_Pong);
+    Test_Lost = 0;
+    Test_Wfe  = 0;
+    Test_ThreadInit(1);
+
+    pthread_create(&Thread, NULL, Test_PongThread, NULL);
+    for(Round = 0; Round < TEST_ROUNDS; Round++)
+    {
+        Event_Set(&Test_Ping, 0x01);
+        if(Event_Wait(&Test_Pong, 0x80000000, EVENT_WAIT_ALL | EVENT_CLEAR_ON_EXIT, EVENT_WAIT_FOREVER) == 0x80000000)
+        {
+            Pings++;
+        }
+    }
+    pthread_join(Thread, NULL);
+
+    HOST_CHECK_EQUAL(Test_Lost, 0);
+    HOST_CHECK_EQUAL(Pings, TEST_ROUNDS);
+    HOST_CHECK_EQUAL(Test_Pongs, TEST_ROUNDS);
+    HOST_CHECK_EQUAL(Event_Get(&Test_Ping), 0);
+    HOST_CHECK_EQUAL(Event_Get(&Test_Pong), 0);
+    HOST_CHECK(Test_Wfe > 0);
+    printf("ping pong: %d rounds, %lu WFE\n", TEST_ROUNDS, Test_Wfe);
+}
+
+/* Two setters of one bit each, the waiter needs both and acknowledges each round */
+static Event_GroupType Test_Both;
+static Event_GroupType Test_Acks;
+
+static void *Test_SetterThread(void *a_Argument)
+{
+    uint32 Bit = (uint32)(uintptr_t)a_Argument;
+    unsigned long Round;
+
+    Test_ThreadInit(Bit);
+    for(Round = 0; Round < TEST_ROUNDS; Round++)
+    {
+        Event_Set(&Test_Both, Bit);
+        (void)Event_Wait(&Test_Acks, Bit, EVENT_WAIT_ANY | EVENT_CLEAR_ON_EXIT, EVENT_WAIT_FOREVER);
+    }
+    return NULL;
+}
+
+static void Test_WaitAll(void)
+{
+    pthread_t Threads[2];
+    unsigned long Round;
+    unsigned long Complete = 0;
+
+    Event_Init(&Test_Both);
+    Event_Init(&Test_Acks);
+    Test_Lost = 0;
+    Test_ThreadInit(3);
+
+    pthread_create(&Threads[0], NULL, Test_SetterThread, (void *)(uintptr_t)0x100);
+    pthread_create(&Threads[1], NULL, Test_SetterThread, (void *)(uintptr_t)0x200);
+    for(Round = 0; Round < TEST_ROUNDS; Round++)
+    {
+        if(Event_Wait(&Test_Both, 0x300, EVENT_WAIT_ALL | EVENT_CLEAR_ON_EXIT, EVENT_WAIT_FOREVER) == 0x300)
+        {
+            Complete++;
+        }
+        Event_Set(&Test_Acks, 0x300);
+    }
+    pthread_join(Threads[0], NULL);
+    pthread_join(Threads[1], NULL);
+
+    HOST_CHECK_EQUAL(Test_Lost, 0);
+    HOST_CHECK_EQUAL(Complete, TEST_ROUNDS);
+    HOST_CHECK_EQUAL(Event_Get(&Test_Both), 0);
+    HOST_CHECK_EQUAL(Event_Get(&Test_Acks), 0);
+}
+
+/* Waiters clearing on exit: each set is consumed once, whichever waiter wakes first. A set of
+   the stop bit ends one waiter */
+#define TEST_WORK                   0x01
+#define TEST_STOP                   0x02
+
+static Event_GroupType Test_Work;
+static unsigned long Test_Consumed[TEST_CONSUMERS];
+
+static void *Test_ConsumerThread(void *a_Argument)
+{
+    uintptr_t Consumer = (uintptr_t)a_Argument;
+    uint32 Bits;
+
+    Test_ThreadInit(10 + Consumer);
+    for(;;)
+    {
+        Bits = Event_Wait(&Test_Work, TEST_WORK | TEST_STOP, EVENT_WAIT_ANY | EVENT_CLEAR_ON_EXIT, EVENT_WAIT_FOREVER);
+        if(Bits & TEST_WORK)
+        {
+            Test_Consumed[Consumer]++;
+        }
+        if(Bits & TEST_STOP)
+        {
+            break;
+        }
+    }
+    return NULL;
+}
+
+static void Test_Consumers(void)
+{
+    pthread_t Threads[TEST_CONSUMERS];
+    unsigned long Set;
+    unsigned long Consumed = 0;
+    uintptr_t Consumer;
+
+    Event_Init(&Test_Work);
+    Test_Lost = 0;
+    Test_ThreadInit(4);
+
+    for(Consumer = 0; Consumer < TEST_CONSUMERS; Consumer++)
+    {
+        pthread_create(&Threads[Consumer], NULL, Test_ConsumerThread, (void *)Consumer);
+    }
+    for(Set = 0; Set < TEST_SETS; Set++)
+    {
+        Event_Set(&Test_Work, TEST_WORK);
+        while(Event_Get(&Test_Work) != 0)
+        {
+            sched_yield();
+        }
+    }
+    for(Consumer = 0; Consumer < TEST_CONSUMERS; Consumer++)
+    {
+        Event_Set(&Test_Work, TEST_STOP);
+        while(Event_Get(&Test_Work) != 0)
+        {
+            sched_yield();
+        }
+    }
+    for(Consumer = 0; Consumer < TEST_CONSUMERS; Consumer++)
+    {
+        pthread_join(Threads[Consumer], NULL);
+        Consumed += Test_Consumed[Consumer];
+    }
+
+    HOST_CHECK_EQUAL(Test_Lost, 0);
+    HOST_CHECK_EQUAL(Consumed, TEST_SETS);
+}
+
+/* Timeout of a sleeping waiter, woken by the SysTick interrupt of a ticking thread */
+static volatile uint32 Test_Ticking;
+
+static void *Test_TickThread(void *a_Argument)
+{
+    struct timespec Period = { 0, 100000 };
+
+    while(__atomic_load_n(&Test_Ticking, __ATOMIC_SEQ_CST))
+    {
+        nanosleep(&Period, NULL);
+        __atomic_fetch_add(&Test_Tick, 1, __ATOMIC_SEQ_CST);
+        Test_Signal();
+    }
+    return NULL;
+}
+
+static void Test_Timeout(void)
+{
+    Event_GroupType Group;
+    pthread_t Thread;
+    uint32 Start;
+
+    Event_Init(&Group);
+    Test_Lost    = 0;
+    Test_Tick    = 0xFFFFFFF0;
+    Test_Ticking = 1;
+    Test_ThreadInit(5);
+
+    pthread_create(&Thread, NULL, Test_TickThread, NULL);
+    Start = SysTick_GetTickCount();
+    HOST_CHECK_EQUAL(Event_Wait(&Group, 0x01, EVENT_WAIT_ANY, 50), 0);
+    HOST_CHECK((SysTick_GetTickCount() - Start) >= 50);
+    __atomic_store_n(&Test_Ticking, 0, __ATOMIC_SEQ_CST);
+    pthread_join(Thread, NULL);
+
+    HOST_CHECK_EQUAL(Test_Lost, 0);
+}
+
+int main(void)
+{
+    Host_InstructionHook = Test_Instruction;
+
+    Test_Options();
+    Test_PingPong();
+    Test_WaitAll();
+    Test_Consumers();
+    Test_Timeout();
+
+    return Host_Report("event_test");
+}
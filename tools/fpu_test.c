@@ -0,0 +1,234 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: fpu_test.c
+ *
+ * Description: Host test of NVIC_Driver/FPU.c. FPCCR, CPACR and the CONTROL register of
+ *              Fpu_GetControl are in host memory. A handler of the test uses the FPU_ISR_ENTER
+ *              and FPU_ISR_EXIT hooks of the driver; the exception entry, the FP instructions and
+ *              the lazy save are played by a model of the Cortex-M4F:
+ *
+ *              entry          : CONTROL.FPCA of the interrupted context with ASPEN and LSPEN set
+ *                               sets LSPACT (frame space reserved), CONTROL.FPCA is cleared.
+ *              FP instruction : a pending lazy save is done (LSPACT cleared), CONTROL.FPCA is set.
+ *
+ *              Checks : FPCCR value of each stacking mode and CPACR access kept, barriers after
+ *                       the CPACR write, extended frame, lazy save and FP use flags per exception,
+ *                       flags accumulated over the entries, first violation of an FP-free handler
+ *                       kept, range checks, PRIMASK of the caller kept.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : fpu_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+
+static uint32 Test_Cpac;
+static uint32 Test_Fpcc;
+
+#undef FPU_CPAC_REG
+#undef FPU_FPCC_REG
+#define FPU_CPAC_REG                Test_Cpac
+#define FPU_FPCC_REG                Test_Fpcc
+
+#include "FPU.c"
+
+#define TEST_IRQ_EXCEPTION(Irq)     ((uint8)(16 + (Irq)))
+
+static uint32 Test_Control;
+static char Test_Instructions[64];
+
+/*******************************************************************************
+ *                        Modules used by the driver                           *
+ *******************************************************************************/
+
+uint32 Fpu_GetControl(void)
+{
+    return Test_Control;
+}
+
+static void Test_Instruction(const char *a_Instruction)
+{
+    /* Record the barriers with the CPACR value they follow */
+    snprintf(Test_Instructions + strlen(Test_Instructions), sizeof(Test_Instructions) - strlen(Test_Instructions),
+             "%s%s", (Test_Cpac & FPU_CPAC_CP10_CP11_FULL_MASK) ? "" : "!", a_Instruction);
+}
+
+/*******************************************************************************
+ *                                Core model                                   *
+ *******************************************************************************/
+
+static void Test_Reset(void)
+{
+    memset((void *)Fpu_IsrReport, 0, sizeof(Fpu_IsrReport));
+    Fpu_FirstViolation = FPU_NO_VIOLATION;
+    Test_Cpac          = 0;
+    Test_Fpcc          = 0;
+    Test_Control       = 0;
+    Host_Primask       = 0;
+}
+
+/* One FP instruction */
+static void Test_FpInstruction(void)
+{
+    Test_Fpcc    &= ~FPU_FPCC_LSPACT_MASK;
+    Test_Control |= FPU_CONTROL_FPCA_MASK;
+}
+
+/* One entry of a handler of the exception, from a context that used the FPU or not, that uses it or not */
+static void Test_Handler(uint8 a_ExceptionNum, boolean a_ContextFp, boolean a_HandlerFp)
+{
+    uint32 Lazy = FPU_FPCC_ASPEN_MASK | FPU_FPCC_LSPEN_MASK;
+    uint32 ContextControl;
+
+    Test_Control   = a_ContextFp ? FPU_CONTROL_FPCA_MASK : 0;
+    ContextControl = Test_Control;
+    if(a_ContextFp && ((Test_Fpcc & Lazy) == Lazy))
+    {
+        Test_Fpcc |= FPU_FPCC_LSPACT_MASK;
+    }
+    Test_Control = 0;
+    {
+        FPU_ISR_ENTER();
+
+        if(a_HandlerFp)
+        {
+            Test_FpInstruction();
+        }
+
+        FPU_ISR_EXIT(a_ExceptionNum);
+    }
+
+    /* Exception return: the lazy save still pending is dropped, the context is back */
+    Test_Fpcc   &= ~FPU_FPCC_LSPACT_MASK;
+    Test_Control = ContextControl;
+}
+
+/*******************************************************************************
+ *                                 Tests                                       *
+ *******************************************************************************/
+
+static void Test_Init(void)
+{
+    Test_Reset();
+    Test_Cpac = 0x000F0000;
+    Test_Instructions[0] = '\0';
+    Host_InstructionHook = Test_Instruction;
+    Fpu_Init(FPU_STACKING_LAZY);
+    Host_InstructionHook = NULL;
+    HOST_CHECK_EQUAL(Test_Cpac, 0x000F0000 | FPU_CPAC_CP10_CP11_FULL_MASK);
+    HOST_CHECK_EQUAL(Test_Fpcc, FPU_FPCC_ASPEN_MASK | FPU_FPCC_LSPEN_MASK);
+    HOST_CHECK(strcmp(Test_Instructions, " DSB ISB") == 0);
+
+    Fpu_Init(FPU_STACKING_AUTOMATIC);
+    HOST_CHECK_EQUAL(Test_Fpcc, FPU_FPCC_ASPEN_MASK);
+    Fpu_Init(FPU_STACKING_NONE);
+    HOST_CHECK_EQUAL(Test_Fpcc, 0);
+
+    /* Unknown mode: the stacking is left as it was */
+    Test_Fpcc = FPU_FPCC_ASPEN_MASK;
+    Fpu_Init((Fpu_StackingType)7);
+    HOST_CHECK_EQUAL(Test_Fpcc, FPU_FPCC_ASPEN_MASK);
+}
+
+static void Test_Frames(void)
+{
+    const uint8 Free    = TEST_IRQ_EXCEPTION(NVIC_IRQ_GPIO_PORTF);
+    const uint8 User    = TEST_IRQ_EXCEPTION(NVIC_IRQ_ADC0_SS0);
+    const uint8 Idle    = TEST_IRQ_EXCEPTION(NVIC_IRQ_UART0);
+
+    Test_Reset();
+    Fpu_Init(FPU_STACKING_LAZY);
+    Fpu_DeclareFpFree(Free);
+    HOST_CHECK_EQUAL(Fpu_GetIsrReport(Free), FPU_ISR_FP_FREE);
+
+    /* Entered from integer code: basic frame, nothing recorded */
+    Test_Handler(Free, FALSE, FALSE);
+    HOST_CHECK_EQUAL(Fpu_GetIsrReport(Free), FPU_ISR_FP_FREE);
+
+    /* Entered from FP code without using the FPU: extended frame reserved, no lazy save */
+    Test_Handler(Free, TRUE, FALSE);
+    HOST_CHECK_EQUAL(Fpu_GetIsrReport(Free), FPU_ISR_FP_FREE | FPU_ISR_EXTENDED_FRAME);
+    HOST_CHECK_EQUAL(Fpu_GetFirstViolation(), FPU_NO_VIOLATION);
+
+    /* A handler using the FPU from integer code: FP use without a lazy save */
+    Test_Handler(User, FALSE, TRUE);
+    HOST_CHECK_EQUAL(Fpu_GetIsrReport(User), FPU_ISR_FP_USED);
+
+    /* From FP code: the lazy save is triggered, and the flags accumulate */
+    Test_Handler(User, TRUE, TRUE);
+    HOST_CHECK_EQUAL(Fpu_GetIsrReport(User), FPU_ISR_FP_USED | FPU_ISR_EXTENDED_FRAME | FPU_ISR_LAZY_SAVE);
+    Test_Handler(User, FALSE, FALSE);
+    HOST_CHECK_EQUAL(Fpu_GetIsrReport(User), FPU_ISR_FP_USED | FPU_ISR_EXTENDED_FRAME | FPU_ISR_LAZY_SAVE);
+
+    /* FP use in a handler not declared FP-free is not a violation */
+    HOST_CHECK_EQUAL(Fpu_GetFirstViolation(), FPU_NO_VIOLATION);
+    HOST_CHECK_EQUAL(Fpu_GetIsrReport(Idle), 0);
+
+    /* Without lazy stacking no frame space is reserved, so only the FP use is recorded */
+    Fpu_Init(FPU_STACKING_NONE);
+    Test_Handler(Idle, TRUE, TRUE);
+    HOST_CHECK_EQUAL(Fpu_GetIsrReport(Idle), FPU_ISR_FP_USED);
+}
+
+static void Test_Violations(void)
+{
+    const uint8 First  = TEST_IRQ_EXCEPTION(NVIC_IRQ_GPIO_PORTF);
+    const uint8 Second = 15;    /* SysTick */
+
+    Test_Reset();
+    Fpu_Init(FPU_STACKING_LAZY);
+    Fpu_DeclareFpFree(First);
+    Fpu_DeclareFpFree(Second);
+
+    Test_Handler(First, TRUE, TRUE);
+    HOST_CHECK_EQUAL(Fpu_GetFirstViolation(), First);
+    HOST_CHECK_EQUAL(Fpu_GetIsrReport(First),
+                     FPU_ISR_FP_FREE | FPU_ISR_FP_USED | FPU_ISR_EXTENDED_FRAME | FPU_ISR_LAZY_SAVE);
+
+    /* The first violation is kept */
+    Test_Handler(Second, FALSE, TRUE);
+    HOST_CHECK_EQUAL(Fpu_GetFirstViolation(), First);
+    HOST_CHECK_EQUAL(Fpu_GetIsrReport(Second), FPU_ISR_FP_FREE | FPU_ISR_FP_USED);
+
+    /* Declared after a use: the next use is a violation */
+    Test_Reset();
+    Test_Handler(Second, FALSE, TRUE);
+    Fpu_DeclareFpFree(Second);
+    HOST_CHECK_EQUAL(Fpu_GetFirstViolation(), FPU_NO_VIOLATION);
+    Test_Handler(Second, FALSE, TRUE);
+    HOST_CHECK_EQUAL(Fpu_GetFirstViolation(), Second);
+
+    /* Exception numbers out of range are ignored */
+    Test_Reset();
+    Fpu_DeclareFpFree(FPU_EXCEPTIONS);
+    Fpu_IsrCheck(FPU_EXCEPTIONS, FPU_FPCC_LSPACT_MASK);
+    HOST_CHECK_EQUAL(Fpu_GetIsrReport(FPU_EXCEPTIONS), 0);
+    HOST_CHECK_EQUAL(Fpu_GetFirstViolation(), FPU_NO_VIOLATION);
+
+    /* The services keep the PRIMASK of the caller */
+    Host_Primask = 1;
+    Fpu_DeclareFpFree(First);
+    HOST_CHECK_EQUAL(Host_Primask, 1);
+    Test_Handler(First, FALSE, TRUE);
+    HOST_CHECK_EQUAL(Host_Primask, 1);
+    Host_Primask = 0;
+    Test_Handler(First, FALSE, FALSE);
+    HOST_CHECK_EQUAL(Host_Primask, 0);
+}
+
+int main(void)
+{
+    Test_Init();
+    Test_Frames();
+    Test_Violations();
+
+    return Host_Report("fpu_test");
+}
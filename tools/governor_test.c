@@ -0,0 +1,376 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: governor_test.c
+ *
+ * Description: Host test of NVIC_Driver/GOVERNOR.c. Burst traces (firings per SysTick period) are
+ *              replayed against a model of the NVIC enable and pending bits: a firing of an enabled
+ *              IRQ is serviced and counted by Governor_Count, a firing of a disabled IRQ stays
+ *              pending and is serviced once the IRQ is enabled again. Governor_Tick runs at the end
+ *              of every period, the throttle and resume events are logged with their period.
+ *
+ *              Checks : steady rates under and over the budget, throttle in the period of the
+ *                       firing over the budget, resume after the back-off, back-off doubled up to
+ *                       its maximum in a storm and halved after quiet windows, a storming IRQ does
+ *                       not affect a well behaved one, register errors.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : governor_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+
+#include "GOVERNOR.c"
+
+#define TEST_MAX_EVENTS             256
+#define TEST_MAX_SEGMENTS           8
+
+/* Burst trace segment: PerTick firings every Period SysTick periods, for Ticks periods */
+typedef struct
+{
+    uint16 Ticks;
+    uint16 PerTick;
+    uint16 Period;
+}Test_SegmentType;
+
+typedef struct
+{
+    Governor_ConfigType Config;
+    Test_SegmentType Trace[TEST_MAX_SEGMENTS];
+    Governor_IdType Id;
+    boolean Pending;
+    uint32 Arrivals;
+    uint32 Serviced;
+}Test_SourceType;
+
+typedef struct
+{
+    uint32 Tick;
+    Trace_EventType Event;
+    uint8 Irq;
+}Test_EventType;
+
+static boolean Test_Enabled[NVIC_IRQ_COUNT];
+static Test_EventType Test_Events[TEST_MAX_EVENTS];
+static uint32 Test_EventsCount;
+static uint32 Test_Now;
+static SysTick_TickHookType Test_TickHook;
+
+/*******************************************************************************
+ *                      Modules used by the governor                           *
+ *******************************************************************************/
+
+void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num)
+{
+    Test_Enabled[IRQ_Num] = TRUE;
+}
+
+void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num)
+{
+    Test_Enabled[IRQ_Num] = FALSE;
+}
+
+void SysTick_RegisterTickHook(SysTick_TickHookType a_Hook)
+{
+    Test_TickHook = a_Hook;
+}
+
+void Trace_Record(Trace_EventType a_Event, uint8 a_Id)
+{
+    if(Test_EventsCount < TEST_MAX_EVENTS)
+    {
+        Test_Events[Test_EventsCount].Tick  = Test_Now;
+        Test_Events[Test_EventsCount].Event = a_Event;
+        Test_Events[Test_EventsCount].Irq   = a_Id;
+        Test_EventsCount++;
+    }
+}
+
+/*******************************************************************************
+ *                              Replay                                         *
+ *******************************************************************************/
+
+static void Test_Reset(void)
+{
+    uint32 Irq;
+
+    Governor_EntriesCount = 0;
+    Test_EventsCount      = 0;
+    Test_Now              = 0;
+    Test_TickHook         = NULL_PTR;
+    for(Irq = 0; Irq < NVIC_IRQ_COUNT; Irq++)
+    {
+        Test_Enabled[Irq] = TRUE;
+    }
+}
+
+/* One firing seen by the NVIC, the handler calls Governor_Count and services the firing */
+static void Test_Fire(Test_SourceType *a_Source)
+{
+    if(Test_Enabled[a_Source->Config.IRQ_Num] == FALSE)
+    {
+        a_Source->Pending = TRUE;
+        return;
+    }
+    (void)Governor_Count(a_Source->Id);
+    a_Source->Serviced++;
+}
+
+static uint16 Test_FiringsAt(const Test_SourceType *a_Source, uint32 a_Tick)
+{
+    const Test_SegmentType *Segment;
+    uint32 Start = 0;
+    uint8 Index;
+
+    for(Index = 0; Index < TEST_MAX_SEGMENTS; Index++)
+    {
+        Segment = &a_Source->Trace[Index];
+        if(a_Tick < Start + Segment->Ticks)
+        {
+            return (((a_Tick - Start) % Segment->Period) == 0) ? Segment->PerTick : 0;
+        }
+        Start += Segment->Ticks;
+    }
+    return 0;
+}
+
+static uint32 Test_TraceTicks(const Test_SourceType *a_Source)
+{
+    uint32 Ticks = 0;
+    uint8 Index;
+
+    for(Index = 0; Index < TEST_MAX_SEGMENTS; Index++)
+    {
+        Ticks += a_Source->Trace[Index].Ticks;
+    }
+    return Ticks;
+}
+
+/* Register the sources, then replay their traces period by period */
+static void Test_Replay(Test_SourceType *a_Sources, uint8 a_Count)
+{
+    uint32 Ticks = 0;
+    uint16 Firings;
+    uint8 Index;
+
+    for(Index = 0; Index < a_Count; Index++)
+    {
+        a_Sources[Index].Id       = Governor_Register(&a_Sources[Index].Config);
+        a_Sources[Index].Pending  = FALSE;
+        a_Sources[Index].Arrivals = 0;
+        a_Sources[Index].Serviced = 0;
+        HOST_CHECK(a_Sources[Index].Id != GOVERNOR_INVALID_ID);
+        Ticks = (Test_TraceTicks(&a_Sources[Index]) > Ticks) ? Test_TraceTicks(&a_Sources[Index]) : Ticks;
+    }
+    HOST_CHECK(Test_TickHook == Governor_Tick);
+
+    for(Test_Now = 0; Test_Now < Ticks; Test_Now++)
+    {
+        for(Index = 0; Index < a_Count; Index++)
+        {
+            Firings = Test_FiringsAt(&a_Sources[Index], Test_Now);
+            a_Sources[Index].Arrivals += Firings;
+            while(Firings-- > 0)
+            {
+                Test_Fire(&a_Sources[Index]);
+            }
+        }
+        Governor_Tick();
+
+        /* A pending IRQ is taken as soon as the SysTick handler that re-enabled it returns */
+        for(Index = 0; Index < a_Count; Index++)
+        {
+            if(a_Sources[Index].Pending && Test_Enabled[a_Sources[Index].Config.IRQ_Num])
+            {
+                a_Sources[Index].Pending = FALSE;
+                Test_Fire(&a_Sources[Index]);
+            }
+        }
+    }
+}
+
+static uint32 Test_CountEvents(Trace_EventType a_Event, NVIC_IRQType a_Irq)
+{
+    uint32 Count = 0;
+    uint32 Index;
+
+    for(Index = 0; Index < Test_EventsCount; Index++)
+    {
+        Count += ((Test_Events[Index].Event == a_Event) && (Test_Events[Index].Irq == a_Irq)) ? 1 : 0;
+    }
+    return Count;
+}
+
+/*******************************************************************************
+ *                                 Tests                                       *
+ *******************************************************************************/
+
+/* Budget 4 in a window of 8 periods (4 slots of 2), back-off 5 doubled up to 20 */
+static const Governor_ConfigType Test_Config = { NVIC_IRQ_GPIO_PORTF, 4, 8, 5, 20 };
+
+static void Test_SteadyRates(void)
+{
+    Test_SourceType Source = { Test_Config, { { 1000, 1, 2 } } };
+    Governor_StatsType Stats;
+
+    /* One firing every 2 periods is 4 per window, never throttled */
+    Test_Reset();
+    Test_Replay(&Source, 1);
+    Governor_GetStats(Source.Id, &Stats);
+    HOST_CHECK_EQUAL(Stats.Throttles, 0);
+    HOST_CHECK_EQUAL(Stats.Firings, 500);
+    HOST_CHECK_EQUAL(Source.Serviced, Source.Arrivals);
+    HOST_CHECK_EQUAL(Test_EventsCount, 0);
+
+    /* One firing every period is 8 per window, throttled */
+    Test_Reset();
+    Source.Trace[0].Period = 1;
+    Test_Replay(&Source, 1);
+    Governor_GetStats(Source.Id, &Stats);
+    HOST_CHECK(Stats.Throttles > 0);
+    HOST_CHECK(Source.Serviced < Source.Arrivals);
+    HOST_CHECK_EQUAL(Test_CountEvents(TRACE_EVENT_IRQ_THROTTLE, NVIC_IRQ_GPIO_PORTF), Stats.Throttles);
+}
+
+static void Test_Burst(void)
+{
+    Test_SourceType Source = { Test_Config, { { 10, 0, 1 }, { 1, 6, 1 }, { 100, 0, 1 } } };
+    Governor_StatsType Stats;
+
+    /* The fifth firing of the period is over the budget: throttled in that period, the sixth stays
+       pending, the IRQ is re-enabled by the fifth SysTick and the pending firing is serviced then */
+    Test_Reset();
+    Test_Replay(&Source, 1);
+    HOST_CHECK_EQUAL(Test_EventsCount, 2);
+    HOST_CHECK_EQUAL(Test_Events[0].Event, TRACE_EVENT_IRQ_THROTTLE);
+    HOST_CHECK_EQUAL(Test_Events[0].Irq, NVIC_IRQ_GPIO_PORTF);
+    HOST_CHECK_EQUAL(Test_Events[0].Tick, 10);
+    HOST_CHECK_EQUAL(Test_Events[1].Event, TRACE_EVENT_IRQ_RESUME);
+    HOST_CHECK_EQUAL(Test_Events[1].Tick, 10 + Test_Config.BackoffTicks - 1);
+    HOST_CHECK_EQUAL(Source.Serviced, 6);
+    HOST_CHECK_EQUAL(Source.Pending, FALSE);
+
+    /* The back-off doubled by the throttle went back to its first value during the quiet periods */
+    Governor_GetStats(Source.Id, &Stats);
+    HOST_CHECK_EQUAL(Stats.Firings, 6);
+    HOST_CHECK_EQUAL(Stats.Throttles, 1);
+    HOST_CHECK_EQUAL(Stats.Throttled, FALSE);
+    HOST_CHECK_EQUAL(Stats.CurrentBackoffTicks, Test_Config.BackoffTicks);
+    HOST_CHECK(Test_Enabled[NVIC_IRQ_GPIO_PORTF]);
+}
+
+static void Test_Storm(void)
+{
+    /* A storm of 10 firings per period, a quiet time, then a single burst */
+    Test_SourceType Source = { Test_Config, { { 120, 10, 1 }, { 100, 0, 1 }, { 1, 6, 1 }, { 20, 0, 1 } } };
+    static const uint16 Backoffs[] = { 5, 10, 20, 20, 20, 20 };
+    Governor_StatsType Stats;
+    uint32 Throttle = 0;
+    uint32 Index;
+
+    Test_Reset();
+    Test_Replay(&Source, 1);
+    Governor_GetStats(Source.Id, &Stats);
+    HOST_CHECK(Stats.Throttles > (sizeof(Backoffs) / sizeof(Backoffs[0])));
+    HOST_CHECK_EQUAL(Test_EventsCount, 2 * Stats.Throttles);
+    printf("storm: %u of %u firings serviced, %u throttles\n", Source.Serviced, Source.Arrivals, Stats.Throttles);
+
+    for(Index = 0; (Index + 1) < Test_EventsCount; Index += 2)
+    {
+        HOST_CHECK_EQUAL(Test_Events[Index].Event, TRACE_EVENT_IRQ_THROTTLE);
+        HOST_CHECK_EQUAL(Test_Events[Index + 1].Event, TRACE_EVENT_IRQ_RESUME);
+        if(Throttle < (sizeof(Backoffs) / sizeof(Backoffs[0])))
+        {
+            /* Doubled on each throttle in a row, up to the maximum */
+            HOST_CHECK_EQUAL(Test_Events[Index + 1].Tick - Test_Events[Index].Tick + 1, Backoffs[Throttle]);
+        }
+        if((Index + 2) < Test_EventsCount && Test_Events[Index + 2].Tick < 120)
+        {
+            /* Still storming: throttled again in the first period after the resume */
+            HOST_CHECK_EQUAL(Test_Events[Index + 2].Tick, Test_Events[Index + 1].Tick + 1);
+        }
+        Throttle++;
+    }
+
+    /* The burst after the quiet time is held off for the first back-off only */
+    HOST_CHECK_EQUAL(Test_Events[Test_EventsCount - 2].Tick, 220);
+    HOST_CHECK_EQUAL(Test_Events[Test_EventsCount - 1].Tick, 220 + Test_Config.BackoffTicks - 1);
+
+    /* At most the budget, the firing over it and the pending one per back-off */
+    HOST_CHECK(Source.Serviced <= Stats.Throttles * (Test_Config.Budget + 2));
+}
+
+static void Test_Neighbour(void)
+{
+    Test_SourceType Sources[2] =
+    {
+        { Test_Config, { { 300, 10, 1 } } },
+        { { NVIC_IRQ_UART0, 4, 8, 5, 20 }, { { 300, 1, 2 } } },
+    };
+    Governor_StatsType Stats;
+
+    Test_Reset();
+    Test_Replay(Sources, 2);
+    Governor_GetStats(Sources[0].Id, &Stats);
+    HOST_CHECK(Stats.Throttles > 0);
+    Governor_GetStats(Sources[1].Id, &Stats);
+    HOST_CHECK_EQUAL(Stats.Throttles, 0);
+    HOST_CHECK_EQUAL(Sources[1].Serviced, Sources[1].Arrivals);
+    HOST_CHECK_EQUAL(Test_CountEvents(TRACE_EVENT_IRQ_THROTTLE, NVIC_IRQ_UART0), 0);
+    HOST_CHECK(Test_Enabled[NVIC_IRQ_UART0]);
+}
+
+static void Test_Errors(void)
+{
+    Governor_ConfigType Config = Test_Config;
+    Governor_StatsType Stats = { 0, 0, 0, FALSE };
+    uint8 Index;
+
+    Test_Reset();
+    HOST_CHECK_EQUAL(Governor_Register(NULL_PTR), GOVERNOR_INVALID_ID);
+    Config.WindowTicks = 0;
+    HOST_CHECK_EQUAL(Governor_Register(&Config), GOVERNOR_INVALID_ID);
+    Config.WindowTicks = 3; /* Would slide by 1 tick over 4 */
+    HOST_CHECK_EQUAL(Governor_Register(&Config), GOVERNOR_INVALID_ID);
+    Config.WindowTicks = 6;
+    HOST_CHECK_EQUAL(Governor_Register(&Config), GOVERNOR_INVALID_ID);
+    Config = Test_Config;
+    Config.BackoffTicks = 0;
+    HOST_CHECK_EQUAL(Governor_Register(&Config), GOVERNOR_INVALID_ID);
+    HOST_CHECK(Test_TickHook == NULL_PTR);
+
+    /* A maximum back-off under the first one is raised to it */
+    Config = Test_Config;
+    Config.MaxBackoffTicks = 1;
+    HOST_CHECK_EQUAL(Governor_Register(&Config), 0);
+    HOST_CHECK_EQUAL(Governor_Entries[0].Config.MaxBackoffTicks, Test_Config.BackoffTicks);
+    for(Index = 1; Index < GOVERNOR_MAX_IRQS; Index++)
+    {
+        HOST_CHECK_EQUAL(Governor_Register(&Test_Config), Index);
+    }
+    HOST_CHECK_EQUAL(Governor_Register(&Test_Config), GOVERNOR_INVALID_ID);
+
+    /* An unknown id is never throttled and leaves the statistics untouched */
+    HOST_CHECK_EQUAL(Governor_Count(GOVERNOR_MAX_IRQS), TRUE);
+    Governor_GetStats(GOVERNOR_MAX_IRQS, &Stats);
+    HOST_CHECK_EQUAL(Stats.Firings, 0);
+    Governor_GetStats(0, NULL_PTR);
+}
+
+int main(void)
+{
+    Test_SteadyRates();
+    Test_Burst();
+    Test_Storm();
+    Test_Neighbour();
+    Test_Errors();
+
+    return Host_Report("governor_test");
+}
@@ -0,0 +1,854 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: gptm_test.c
+ *
+ * Description: Host test of NVIC_Driver/GPTM.c. The twelve timer blocks and the timer clock
+ *              gating registers are in host memory, the NVIC services are stubs. A model of the
+ *              timer block runs the configuration the driver leaves in the registers:
+ *
+ *              one-shot / periodic : down count from TnILR, the prescaler divides the clock of
+ *                                    a split half, a concatenated timer counts TBILR:TAILR.
+ *                                    The time-out sets the raw status, a one-shot clears EN.
+ *              PWM                 : down count from TnPR:TnILR, output high while the counter
+ *                                    is above TnPMR:TnMATCHR, the match is latched at the reload
+ *                                    (MRSU), PWML inverts the output.
+ *              edge time capture   : up count over TnPR:TnILR, the selected edges of the input
+ *                                    latch the counter in TnR (TnPS) and set the event status.
+ *
+ *              The model jumps from event to event, so periods of 2^40 clocks run at once. The
+ *              masked status is delivered to the timer handler of the half while its IRQ is
+ *              enabled, the writes to ICR clear the raw status.
+ *
+ *              Checks : register values of each mode and half, time-outs, one-shot stop and ADC
+ *                       trigger, prescaled periods, concatenated 32-bit and 64-bit periods, capture
+ *                       time stamps with the 24-bit and 48-bit wrap, edge selection, PWM high time,
+ *                       inversion and duty change at the next period, unsupported configurations,
+ *                       clock enable, IRQ of each half, interrupt mask without a callback, stale
+ *                       status cleared, the other half left as it was.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : gptm_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+
+#define TEST_TIMERS                 12
+
+static GPTM_RegType Test_Blocks[TEST_TIMERS];
+static uint32 Test_RcgcTimer;
+static uint32 Test_RcgcWideTimer;
+
+/* The peripheral is ready as soon as its clock is enabled */
+#undef GPTM_TIMER
+#undef SYSCTL_RCGCTIMER_REG
+#undef SYSCTL_PRTIMER_REG
+#undef SYSCTL_RCGCWTIMER_REG
+#undef SYSCTL_PRWTIMER_REG
+#define GPTM_TIMER(Timer)           ((volatile GPTM_RegType *)&Test_Blocks[(Timer)])
+#define SYSCTL_RCGCTIMER_REG        Test_RcgcTimer
+#define SYSCTL_PRTIMER_REG          Test_RcgcTimer
+#define SYSCTL_RCGCWTIMER_REG       Test_RcgcWideTimer
+#define SYSCTL_PRWTIMER_REG         Test_RcgcWideTimer
+
+#include "GPTM.c"
+
+#define TEST_NEVER                  0xFFFFFFFFFFFFFFFFULL
+
+/* Model state of one half */
+typedef struct
+{
+    uint64 Phase;                   /* Clocks since the reload, counter value of an up count */
+    uint64 Match;                   /* PWM match in use */
+    boolean Running;
+    boolean Input;                  /* Level of the capture pin */
+    uint32 Calls;
+    uint64 Values[4];               /* Callback values, the last ones */
+    uint64 FirstTime;
+    uint64 LastTime;
+    uint32 AdcTriggers;
+    uint64 HighClocks;
+}Test_HalfType;
+
+static Test_HalfType Test_Halves[TEST_TIMERS][2];
+static boolean Test_IrqEnabled[NVIC_IRQ_COUNT];
+static NVIC_IRQPriorityType Test_IrqPriority[NVIC_IRQ_COUNT];
+static uint64 Test_Now;
+static Test_HalfType *Test_Current;
+
+static void (*const Test_Handlers[TEST_TIMERS][2])(void) =
+{
+    { Timer0A_Handler,     Timer0B_Handler     }, { Timer1A_Handler,     Timer1B_Handler     },
+    { Timer2A_Handler,     Timer2B_Handler     }, { Timer3A_Handler,     Timer3B_Handler     },
+    { Timer4A_Handler,     Timer4B_Handler     }, { Timer5A_Handler,     Timer5B_Handler     },
+    { WideTimer0A_Handler, WideTimer0B_Handler }, { WideTimer1A_Handler, WideTimer1B_Handler },
+    { WideTimer2A_Handler, WideTimer2B_Handler }, { WideTimer3A_Handler, WideTimer3B_Handler },
+    { WideTimer4A_Handler, WideTimer4B_Handler }, { WideTimer5A_Handler, WideTimer5B_Handler }
+};
+
+/*******************************************************************************
+ *                        Modules used by the driver                           *
+ *******************************************************************************/
+
+void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num)
+{
+    Test_IrqEnabled[IRQ_Num] = TRUE;
+}
+
+void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num)
+{
+    Test_IrqEnabled[IRQ_Num] = FALSE;
+}
+
+void NVIC_SetPriorityIRQ(NVIC_IRQType IRQ_Num, NVIC_IRQPriorityType IRQ_Priority)
+{
+    Test_IrqPriority[IRQ_Num] = IRQ_Priority;
+}
+
+static void Test_Callback(uint64 a_Value)
+{
+    if(Test_Current->Calls == 0)
+    {
+        Test_Current->FirstTime = Test_Now;
+    }
+    Test_Current->LastTime = Test_Now;
+    Test_Current->Values[Test_Current->Calls % 4] = a_Value;
+    Test_Current->Calls++;
+}
+
+/*******************************************************************************
+ *                             Timer block model                               *
+ *******************************************************************************/
+
+static void Test_Reset(void)
+{
+    memset(Test_Blocks, 0, sizeof(Test_Blocks));
+    memset(Test_Halves, 0, sizeof(Test_Halves));
+    memset(Test_IrqEnabled, 0, sizeof(Test_IrqEnabled));
+    memset(Test_IrqPriority, 0, sizeof(Test_IrqPriority));
+    memset(Gptm_Callbacks, 0, sizeof(Gptm_Callbacks));
+    memset(Gptm_Modes, 0, sizeof(Gptm_Modes));
+    Test_RcgcTimer     = 0;
+    Test_RcgcWideTimer = 0;
+    Test_Now           = 0;
+    Host_Primask       = 0;
+}
+
+/* Gptm_Init, then the counters of the configured halves are loaded as the writes of TnILR do */
+static boolean Test_Setup(const Gptm_ConfigType *a_Config)
+{
+    boolean Result = Gptm_Init(a_Config);
+
+    if(Result)
+    {
+        if(a_Config->Half != GPTM_HALF_B)
+        {
+            memset(&Test_Halves[a_Config->Timer][0], 0, sizeof(Test_HalfType));
+        }
+        if(a_Config->Half != GPTM_HALF_A)
+        {
+            memset(&Test_Halves[a_Config->Timer][1], 0, sizeof(Test_HalfType));
+        }
+    }
+    return Result;
+}
+
+static boolean Test_Concatenated(uint8 a_Timer)
+{
+    return (Test_Blocks[a_Timer].CFG == GPTM_CFG_CONCATENATED) ? TRUE : FALSE;
+}
+
+static uint32 Test_Mode(uint8 a_Timer, Gptm_HalfType a_Half)
+{
+    return GPTM_HALF_REG(&Test_Blocks[a_Timer], TAMR, a_Half);
+}
+
+/* Counter extended by the prescaler: PWM and edge time */
+static boolean Test_Extended(uint8 a_Timer, Gptm_HalfType a_Half)
+{
+    uint32 Mode = Test_Mode(a_Timer, a_Half);
+
+    return ((Mode & GPTM_MR_AMS_MASK) || ((Mode & 0x3) == GPTM_MR_CAPTURE)) ? TRUE : FALSE;
+}
+
+static boolean Test_Capture(uint8 a_Timer, Gptm_HalfType a_Half)
+{
+    return ((Test_Mode(a_Timer, a_Half) & 0x3) == GPTM_MR_CAPTURE) ? TRUE : FALSE;
+}
+
+static boolean Test_Pwm(uint8 a_Timer, Gptm_HalfType a_Half)
+{
+    return (Test_Mode(a_Timer, a_Half) & GPTM_MR_AMS_MASK) ? TRUE : FALSE;
+}
+
+/* Clocks of one period of a down count, or the wrap of an up count */
+static uint64 Test_Period(uint8 a_Timer, Gptm_HalfType a_Half)
+{
+    GPTM_RegType *Regs = &Test_Blocks[a_Timer];
+    uint8 HalfBits = (a_Timer >= GPTM_WIDE_TIMER_0) ? GPTM_WIDE_HALF_BITS : GPTM_HALF_BITS;
+    uint64 Load;
+    uint64 Prescale;
+
+    if(Test_Concatenated(a_Timer))
+    {
+        Load = Regs->TAILR;
+        if(a_Timer >= GPTM_WIDE_TIMER_0)
+        {
+            Load |= (uint64)Regs->TBILR << 32;
+        }
+        return Load + 1;
+    }
+    Load     = GPTM_HALF_REG(Regs, TAILR, a_Half);
+    Prescale = GPTM_HALF_REG(Regs, TAPR, a_Half);
+    if(Test_Extended(a_Timer, a_Half))
+    {
+        return ((Prescale << HalfBits) | Load) + 1;
+    }
+    return (Load + 1) * (Prescale + 1);
+}
+
+static uint64 Test_PwmMatch(uint8 a_Timer, Gptm_HalfType a_Half)
+{
+    GPTM_RegType *Regs = &Test_Blocks[a_Timer];
+    uint8 HalfBits = (a_Timer >= GPTM_WIDE_TIMER_0) ? GPTM_WIDE_HALF_BITS : GPTM_HALF_BITS;
+
+    return ((uint64)GPTM_HALF_REG(Regs, TAPMR, a_Half) << HalfBits) | GPTM_HALF_REG(Regs, TAMATCHR, a_Half);
+}
+
+/* PWM output level, after the inversion */
+static boolean Test_PwmOutput(uint8 a_Timer, Gptm_HalfType a_Half)
+{
+    Test_HalfType *State = &Test_Halves[a_Timer][a_Half];
+    uint64 Load = Test_Period(a_Timer, a_Half) - 1;
+    boolean High = ((Load - State->Phase) > State->Match) ? TRUE : FALSE;
+
+    if(Test_Blocks[a_Timer].CTL & ((uint32)GPTM_CTL_PWML_MASK << GPTM_HALF_SHIFT(a_Half)))
+    {
+        High = !High;
+    }
+    return High;
+}
+
+/* Clocks until the next time-out or output change of a running half */
+static uint64 Test_NextEvent(uint8 a_Timer, Gptm_HalfType a_Half)
+{
+    Test_HalfType *State = &Test_Halves[a_Timer][a_Half];
+    uint64 Period;
+    uint64 HighTime;
+
+    if(!State->Running || Test_Capture(a_Timer, a_Half))
+    {
+        return TEST_NEVER;
+    }
+    Period = Test_Period(a_Timer, a_Half);
+    if(Test_Pwm(a_Timer, a_Half))
+    {
+        HighTime = Period - 1 - State->Match;
+        if(State->Phase < HighTime)
+        {
+            return HighTime - State->Phase;
+        }
+    }
+    return Period - State->Phase;
+}
+
+/* Value registers of the half from the model state */
+static void Test_UpdateValue(uint8 a_Timer, Gptm_HalfType a_Half)
+{
+    GPTM_RegType *Regs = &Test_Blocks[a_Timer];
+    Test_HalfType *State = &Test_Halves[a_Timer][a_Half];
+    boolean Wide = (a_Timer >= GPTM_WIDE_TIMER_0) ? TRUE : FALSE;
+    uint64 Period = Test_Period(a_Timer, a_Half);
+    uint64 Prescale;
+    uint64 Value;
+
+    if(Test_Concatenated(a_Timer))
+    {
+        Value      = Period - 1 - State->Phase;
+        Regs->TAV  = (uint32)Value;
+        Regs->TBV  = Wide ? (uint32)(Value >> 32) : Regs->TBV;
+        return;
+    }
+    if(Test_Extended(a_Timer, a_Half))
+    {
+        Value = Test_Capture(a_Timer, a_Half) ? State->Phase : (Period - 1 - State->Phase);
+        GPTM_HALF_REG(Regs, TAV, a_Half)  = Wide ? (uint32)Value : (uint32)(Value & 0xFFFFFF);
+        GPTM_HALF_REG(Regs, TAPV, a_Half) = Wide ? (uint32)(Value >> 32) : (uint32)(Value >> 16);
+        return;
+    }
+    /* True prescaler: the counter and the prescaler count down */
+    Prescale = GPTM_HALF_REG(Regs, TAPR, a_Half) + 1;
+    Value    = GPTM_HALF_REG(Regs, TAILR, a_Half) - State->Phase / Prescale;
+    Prescale = Prescale - 1 - State->Phase % Prescale;
+    GPTM_HALF_REG(Regs, TAV, a_Half)  = Wide ? (uint32)Value : (uint32)(Value | (Prescale << 16));
+    GPTM_HALF_REG(Regs, TAPV, a_Half) = (uint32)Prescale;
+}
+
+static void Test_Advance(uint8 a_Timer, Gptm_HalfType a_Half, uint64 a_Clocks)
+{
+    GPTM_RegType *Regs = &Test_Blocks[a_Timer];
+    Test_HalfType *State = &Test_Halves[a_Timer][a_Half];
+    uint8 Shift = GPTM_HALF_SHIFT(a_Half);
+    uint64 Period;
+
+    if(!State->Running)
+    {
+        return;
+    }
+    Period = Test_Period(a_Timer, a_Half);
+    if(Test_Pwm(a_Timer, a_Half) && Test_PwmOutput(a_Timer, a_Half))
+    {
+        State->HighClocks += a_Clocks;
+    }
+    State->Phase += a_Clocks;
+    if(Test_Capture(a_Timer, a_Half))
+    {
+        State->Phase %= Period;
+    }
+    else if(State->Phase == Period)
+    {
+        State->Phase = 0;
+        if(Test_Pwm(a_Timer, a_Half))
+        {
+            State->Match = Test_PwmMatch(a_Timer, a_Half);
+        }
+        else
+        {
+            Regs->RIS |= (uint32)GPTM_INT_TIMEOUT_MASK << Shift;
+            if(Regs->CTL & ((uint32)GPTM_CTL_OTE_MASK << Shift))
+            {
+                State->AdcTriggers++;
+            }
+            if((Test_Mode(a_Timer, a_Half) & 0x3) == GPTM_MR_ONE_SHOT)
+            {
+                Regs->CTL &= ~((uint32)GPTM_CTL_EN_MASK << Shift);
+                State->Running = FALSE;
+            }
+        }
+    }
+    Test_UpdateValue(a_Timer, a_Half);
+}
+
+/* Writes to ICR, masked status, then the handlers of the halves with a pending enabled interrupt */
+static void Test_Deliver(uint8 a_Timer)
+{
+    GPTM_RegType *Regs = &Test_Blocks[a_Timer];
+    uint8 Half;
+    uint8 Shift;
+
+    for(Half = 0; Half < 2; Half++)
+    {
+        Shift       = GPTM_HALF_SHIFT(Half);
+        Regs->RIS  &= ~Regs->ICR;
+        Regs->ICR   = 0;
+        Regs->MIS   = Regs->RIS & Regs->IMR;
+        if(((Regs->MIS >> Shift) & GPTM_INT_HALF_MASK) && Test_IrqEnabled[Gptm_IrqNums[a_Timer] + Half])
+        {
+            Test_Current = &Test_Halves[a_Timer][Half];
+            Test_Handlers[a_Timer][Half]();
+        }
+    }
+    Regs->RIS &= ~Regs->ICR;
+    Regs->ICR  = 0;
+    Regs->MIS  = Regs->RIS & Regs->IMR;
+}
+
+/* Halves started or stopped by the driver, a PWM latches its match when it starts or at once without MRSU */
+static void Test_Sync(uint8 a_Timer)
+{
+    Test_HalfType *State;
+    uint8 Halves = Test_Concatenated(a_Timer) ? 1 : 2;
+    uint8 Half;
+    boolean Running;
+
+    for(Half = 0; Half < Halves; Half++)
+    {
+        State   = &Test_Halves[a_Timer][Half];
+        Running = (Test_Blocks[a_Timer].CTL & ((uint32)GPTM_CTL_EN_MASK << GPTM_HALF_SHIFT(Half))) ? TRUE : FALSE;
+        if(Test_Pwm(a_Timer, Half) && (!(Test_Mode(a_Timer, Half) & GPTM_MR_MRSU_MASK) ||
+                                       (Running && !State->Running && (State->Phase == 0))))
+        {
+            State->Match = Test_PwmMatch(a_Timer, Half);
+        }
+        State->Running = Running;
+    }
+}
+
+static void Test_Run(uint8 a_Timer, uint64 a_Clocks)
+{
+    uint8 Halves;
+    uint8 Half;
+    uint64 Step;
+
+    Test_Sync(a_Timer);
+    Test_Deliver(a_Timer);
+    Halves = Test_Concatenated(a_Timer) ? 1 : 2;
+    while(a_Clocks > 0)
+    {
+        Step = a_Clocks;
+        for(Half = 0; Half < Halves; Half++)
+        {
+            if(Test_NextEvent(a_Timer, Half) < Step)
+            {
+                Step = Test_NextEvent(a_Timer, Half);
+            }
+        }
+        for(Half = 0; Half < Halves; Half++)
+        {
+            Test_Advance(a_Timer, Half, Step);
+        }
+        Test_Now += Step;
+        a_Clocks -= Step;
+        Test_Deliver(a_Timer);
+        Test_Sync(a_Timer);
+    }
+}
+
+/* Level of the capture pin of a half, the selected edges latch the counter */
+static void Test_Input(uint8 a_Timer, Gptm_HalfType a_Half, boolean a_Level)
+{
+    GPTM_RegType *Regs = &Test_Blocks[a_Timer];
+    Test_HalfType *State = &Test_Halves[a_Timer][a_Half];
+    uint8 Shift = GPTM_HALF_SHIFT(a_Half);
+    uint32 Event = (Regs->CTL >> (Shift + GPTM_CTL_EVENT_BITS_POS)) & 0x3;
+    boolean Selected;
+
+    Test_Sync(a_Timer);
+    if(a_Level == State->Input)
+    {
+        return;
+    }
+    State->Input = a_Level;
+    Selected = (Event == GPTM_EDGE_BOTH) || ((Event == GPTM_EDGE_RISING) && a_Level) ||
+               ((Event == GPTM_EDGE_FALLING) && !a_Level);
+    if(!State->Running || !Test_Capture(a_Timer, a_Half) || !Selected)
+    {
+        return;
+    }
+    if(a_Timer >= GPTM_WIDE_TIMER_0)
+    {
+        GPTM_HALF_REG(Regs, TAR, a_Half)  = (uint32)State->Phase;
+        GPTM_HALF_REG(Regs, TAPS, a_Half) = (uint32)(State->Phase >> 32);
+    }
+    else
+    {
+        GPTM_HALF_REG(Regs, TAR, a_Half)  = (uint32)State->Phase;
+        GPTM_HALF_REG(Regs, TAPS, a_Half) = (uint32)(State->Phase >> 16);
+    }
+    Regs->RIS |= (uint32)GPTM_INT_CAPTURE_EVENT_MASK << Shift;
+    Test_Deliver(a_Timer);
+}
+
+/*******************************************************************************
+ *                                 Tests                                       *
+ *******************************************************************************/
+
+static void Test_Periodic(void)
+{
+    Gptm_ConfigType Config = { GPTM_TIMER_0, GPTM_HALF_A, GPTM_MODE_PERIODIC, 1000, 0, GPTM_EDGE_RISING, FALSE,
+                               Test_Callback, 3, FALSE };
+    GPTM_RegType *Regs = &Test_Blocks[GPTM_TIMER_0];
+    Test_HalfType *A = &Test_Halves[GPTM_TIMER_0][0];
+    Test_HalfType *B = &Test_Halves[GPTM_TIMER_0][1];
+
+    Test_Reset();
+    HOST_CHECK(Test_Setup(&Config));
+    HOST_CHECK_EQUAL(Regs->CFG, GPTM_CFG_SPLIT);
+    HOST_CHECK_EQUAL(Regs->TAMR, GPTM_MR_PERIODIC);
+    HOST_CHECK_EQUAL(Regs->TAILR, 999);
+    HOST_CHECK_EQUAL(Regs->TAPR, 0);
+    HOST_CHECK_EQUAL(Regs->IMR, GPTM_INT_TIMEOUT_MASK);
+    HOST_CHECK_EQUAL(Regs->CTL, 0);
+    HOST_CHECK(Test_IrqEnabled[NVIC_IRQ_TIMER0A]);
+    HOST_CHECK_EQUAL(Test_IrqPriority[NVIC_IRQ_TIMER0A], 3);
+    HOST_CHECK_EQUAL(Test_RcgcTimer, 1 << GPTM_TIMER_0);
+
+    /* 100000 clocks do not fit 16 bits: prescaler by 2 */
+    Config.Half     = GPTM_HALF_B;
+    Config.Period   = 100000;
+    Config.Priority = 5;
+    HOST_CHECK(Test_Setup(&Config));
+    HOST_CHECK_EQUAL(Regs->TBMR, GPTM_MR_PERIODIC);
+    HOST_CHECK_EQUAL(Regs->TBPR, 1);
+    HOST_CHECK_EQUAL(Regs->TBILR, 49999);
+    HOST_CHECK_EQUAL(Regs->TAILR, 999);
+    HOST_CHECK_EQUAL(Regs->IMR, GPTM_INT_TIMEOUT_MASK | (GPTM_INT_TIMEOUT_MASK << GPTM_HALF_B_SHIFT));
+    HOST_CHECK(Test_IrqEnabled[NVIC_IRQ_TIMER0B]);
+    HOST_CHECK_EQUAL(Test_IrqPriority[NVIC_IRQ_TIMER0B], 5);
+
+    Host_Primask = 1;
+    Gptm_Start(GPTM_TIMER_0, GPTM_HALF_A);
+    HOST_CHECK_EQUAL(Host_Primask, 1);
+    Host_Primask = 0;
+    Gptm_Start(GPTM_TIMER_0, GPTM_HALF_B);
+    HOST_CHECK_EQUAL(Regs->CTL, (GPTM_CTL_EN_MASK | GPTM_CTL_STALL_MASK) * 0x101);
+
+    Test_Run(GPTM_TIMER_0, 1000000);
+    HOST_CHECK_EQUAL(A->Calls, 1000);
+    HOST_CHECK_EQUAL(A->FirstTime, 1000);
+    HOST_CHECK_EQUAL(A->Values[0], 0);
+    HOST_CHECK_EQUAL(B->Calls, 10);
+    HOST_CHECK_EQUAL(B->FirstTime, 100000);
+    HOST_CHECK_EQUAL(B->LastTime, 1000000);
+    HOST_CHECK_EQUAL(Regs->RIS, 0);
+
+    /* Counter and prescaler count of half B in the middle of a period */
+    Test_Run(GPTM_TIMER_0, 1000);
+    HOST_CHECK_EQUAL(Gptm_GetValue(GPTM_TIMER_0, GPTM_HALF_B), (49999 - 500) | (1 << 16));
+
+    /* Stopping half A leaves half B running */
+    Gptm_Stop(GPTM_TIMER_0, GPTM_HALF_A);
+    HOST_CHECK_EQUAL(Regs->CTL, GPTM_CTL_STALL_MASK | ((GPTM_CTL_EN_MASK | GPTM_CTL_STALL_MASK) << GPTM_HALF_B_SHIFT));
+    Test_Run(GPTM_TIMER_0, 200000);
+    HOST_CHECK_EQUAL(A->Calls, 1001);
+    HOST_CHECK_EQUAL(B->Calls, 12);
+
+    /* The prescaled period is the request rounded down to a multiple of the prescale */
+    Test_Reset();
+    Config.Half   = GPTM_HALF_A;
+    Config.Period = 100001;
+    HOST_CHECK(Test_Setup(&Config));
+    Gptm_Start(GPTM_TIMER_0, GPTM_HALF_A);
+    Test_Run(GPTM_TIMER_0, 300000);
+    HOST_CHECK((A->FirstTime <= 100001) && (A->FirstTime > 100001 - (Regs->TAPR + 1)));
+    HOST_CHECK_EQUAL(A->Calls, 300000 / A->FirstTime);
+
+    /* Widest split periods: 24 bits and 48 bits */
+    Config.Period = 1UL << 24;
+    HOST_CHECK(Test_Setup(&Config));
+    HOST_CHECK_EQUAL(Regs->TAPR, 0xFF);
+    HOST_CHECK_EQUAL(Regs->TAILR, 0xFFFF);
+    Config.Period = (1UL << 24) + 1;
+    HOST_CHECK(!Test_Setup(&Config));
+    Config.Timer  = GPTM_WIDE_TIMER_1;
+    Config.Period = 1ULL << 48;
+    HOST_CHECK(Test_Setup(&Config));
+    HOST_CHECK_EQUAL(Test_Blocks[GPTM_WIDE_TIMER_1].TAPR, 0xFFFF);
+    HOST_CHECK_EQUAL(Test_Blocks[GPTM_WIDE_TIMER_1].TAILR, 0xFFFFFFFF);
+    Gptm_Start(GPTM_WIDE_TIMER_1, GPTM_HALF_A);
+    Test_Now = 0;
+    Test_Run(GPTM_WIDE_TIMER_1, 1ULL << 48);
+    HOST_CHECK_EQUAL(Test_Halves[GPTM_WIDE_TIMER_1][0].FirstTime, 1ULL << 48);
+    Config.Period = (1ULL << 48) + 1;
+    HOST_CHECK(!Test_Setup(&Config));
+    Config.Period = 0;
+    HOST_CHECK(!Test_Setup(&Config));
+}
+
+static void Test_OneShot(void)
+{
+    Gptm_ConfigType Config = { GPTM_TIMER_1, GPTM_HALF_CONCATENATED, GPTM_MODE_ONE_SHOT, 5000000, 0, GPTM_EDGE_RISING,
+                               FALSE, Test_Callback, 2, TRUE };
+    GPTM_RegType *Regs = &Test_Blocks[GPTM_TIMER_1];
+    GPTM_RegType *Wide = &Test_Blocks[GPTM_WIDE_TIMER_0];
+    Test_HalfType *State = &Test_Halves[GPTM_TIMER_1][0];
+    uint64 Period = (1ULL << 33) + 5;
+    uint64 Start;
+
+    Test_Reset();
+    HOST_CHECK(Test_Setup(&Config));
+    HOST_CHECK_EQUAL(Regs->CFG, GPTM_CFG_CONCATENATED);
+    HOST_CHECK_EQUAL(Regs->TAMR, GPTM_MR_ONE_SHOT);
+    HOST_CHECK_EQUAL(Regs->TAILR, 4999999);
+    HOST_CHECK_EQUAL(Regs->CTL, GPTM_CTL_OTE_MASK);
+    HOST_CHECK(Test_IrqEnabled[NVIC_IRQ_TIMER1A]);
+    HOST_CHECK(!Test_IrqEnabled[NVIC_IRQ_TIMER1B]);
+
+    Gptm_Start(GPTM_TIMER_1, GPTM_HALF_CONCATENATED);
+    Test_Run(GPTM_TIMER_1, 4999999);
+    HOST_CHECK_EQUAL(State->Calls, 0);
+    HOST_CHECK_EQUAL(Gptm_GetValue(GPTM_TIMER_1, GPTM_HALF_CONCATENATED), 0);
+    Test_Run(GPTM_TIMER_1, 1);
+    HOST_CHECK_EQUAL(State->Calls, 1);
+    HOST_CHECK_EQUAL(State->AdcTriggers, 1);
+    HOST_CHECK_EQUAL(Regs->CTL & GPTM_CTL_EN_MASK, 0);
+    Test_Run(GPTM_TIMER_1, 10000000);
+    HOST_CHECK_EQUAL(State->Calls, 1);
+    HOST_CHECK_EQUAL(State->AdcTriggers, 1);
+
+    /* 32 bits on a 16/32-bit timer */
+    Config.Period = 1ULL << 32;
+    HOST_CHECK(Test_Setup(&Config));
+    HOST_CHECK_EQUAL(Regs->TAILR, 0xFFFFFFFF);
+    Config.Period = (1ULL << 32) + 1;
+    HOST_CHECK(!Test_Setup(&Config));
+
+    /* 64 bits on a wide timer */
+    Config.Timer      = GPTM_WIDE_TIMER_0;
+    Config.Mode       = GPTM_MODE_PERIODIC;
+    Config.Period     = Period;
+    Config.AdcTrigger = FALSE;
+    State             = &Test_Halves[GPTM_WIDE_TIMER_0][0];
+    HOST_CHECK(Test_Setup(&Config));
+    HOST_CHECK_EQUAL(Wide->TAILR, 4);
+    HOST_CHECK_EQUAL(Wide->TBILR, 2);
+    HOST_CHECK_EQUAL(Wide->CTL, 0);
+    HOST_CHECK(Test_IrqEnabled[NVIC_IRQ_WTIMER0A]);
+    HOST_CHECK_EQUAL(Test_RcgcWideTimer, 1 << 0);
+
+    Gptm_Start(GPTM_WIDE_TIMER_0, GPTM_HALF_CONCATENATED);
+    Start = Test_Now;
+    Test_Run(GPTM_WIDE_TIMER_0, 1ULL << 32);
+    HOST_CHECK_EQUAL(Gptm_GetValue(GPTM_WIDE_TIMER_0, GPTM_HALF_CONCATENATED), Period - 1 - (1ULL << 32));
+    Test_Run(GPTM_WIDE_TIMER_0, Period - (1ULL << 32));
+    HOST_CHECK_EQUAL(State->Calls, 1);
+    HOST_CHECK_EQUAL(State->FirstTime - Start, Period);
+    Test_Run(GPTM_WIDE_TIMER_0, Period);
+    HOST_CHECK_EQUAL(State->Calls, 2);
+    HOST_CHECK_EQUAL(State->AdcTriggers, 0);
+}
+
+static void Test_CaptureTime(void)
+{
+    Gptm_ConfigType Config = { GPTM_TIMER_2, GPTM_HALF_A, GPTM_MODE_CAPTURE_TIME, 0, 0, GPTM_EDGE_RISING, FALSE,
+                               Test_Callback, 1, FALSE };
+    GPTM_RegType *Regs = &Test_Blocks[GPTM_TIMER_2];
+    Test_HalfType *A = &Test_Halves[GPTM_TIMER_2][0];
+    Test_HalfType *B = &Test_Halves[GPTM_TIMER_2][1];
+    GPTM_RegType *Wide = &Test_Blocks[GPTM_WIDE_TIMER_3];
+
+    Test_Reset();
+    HOST_CHECK(Test_Setup(&Config));
+    Config.Half = GPTM_HALF_B;
+    Config.Edge = GPTM_EDGE_BOTH;
+    HOST_CHECK(Test_Setup(&Config));
+    HOST_CHECK_EQUAL(Regs->TAMR, GPTM_MR_CAPTURE | GPTM_MR_CMR_MASK | GPTM_MR_CDIR_MASK);
+    HOST_CHECK_EQUAL(Regs->TBMR, GPTM_MR_CAPTURE | GPTM_MR_CMR_MASK | GPTM_MR_CDIR_MASK);
+    HOST_CHECK_EQUAL(Regs->TAILR, 0xFFFF);
+    HOST_CHECK_EQUAL(Regs->TAPR, 0xFF);
+    HOST_CHECK_EQUAL(Regs->CTL, (uint32)GPTM_EDGE_BOTH << (GPTM_CTL_EVENT_BITS_POS + GPTM_HALF_B_SHIFT));
+    HOST_CHECK_EQUAL(Regs->IMR, GPTM_INT_CAPTURE_EVENT_MASK * 0x101);
+
+    Gptm_Start(GPTM_TIMER_2, GPTM_HALF_A);
+    Gptm_Start(GPTM_TIMER_2, GPTM_HALF_B);
+
+    /* Rising edges only on half A, both edges on half B */
+    Test_Run(GPTM_TIMER_2, 1000);
+    Test_Input(GPTM_TIMER_2, GPTM_HALF_A, TRUE);
+    Test_Input(GPTM_TIMER_2, GPTM_HALF_B, TRUE);
+    Test_Run(GPTM_TIMER_2, 500);
+    Test_Input(GPTM_TIMER_2, GPTM_HALF_A, FALSE);
+    Test_Input(GPTM_TIMER_2, GPTM_HALF_B, FALSE);
+    Test_Run(GPTM_TIMER_2, 1500);
+    Test_Input(GPTM_TIMER_2, GPTM_HALF_A, TRUE);
+    HOST_CHECK_EQUAL(A->Calls, 2);
+    HOST_CHECK_EQUAL(A->Values[0], 1000);
+    HOST_CHECK_EQUAL(A->Values[1], 3000);
+    HOST_CHECK_EQUAL(B->Calls, 2);
+    HOST_CHECK_EQUAL(B->Values[0], 1000);
+    HOST_CHECK_EQUAL(B->Values[1], 1500);
+    HOST_CHECK_EQUAL(Gptm_GetCapture(GPTM_TIMER_2, GPTM_HALF_B), 1500);
+    HOST_CHECK_EQUAL(Regs->RIS, 0);
+
+    /* The 24-bit counter wraps, the prescaler is in bits 23..16 of the time stamp */
+    Test_Run(GPTM_TIMER_2, (1UL << 24) + 5 - 3000);
+    HOST_CHECK_EQUAL(Gptm_GetValue(GPTM_TIMER_2, GPTM_HALF_A), 5);
+    Test_Run(GPTM_TIMER_2, 0x123456 - 5);
+    HOST_CHECK_EQUAL(Gptm_GetValue(GPTM_TIMER_2, GPTM_HALF_B), 0x123456);
+    Test_Input(GPTM_TIMER_2, GPTM_HALF_A, FALSE);
+    Test_Input(GPTM_TIMER_2, GPTM_HALF_A, TRUE);
+    HOST_CHECK_EQUAL(A->Calls, 3);
+    HOST_CHECK_EQUAL(A->Values[2], 0x123456);
+
+    /* 48-bit time stamps of a wide timer, without a callback the interrupt stays masked */
+    Config.Timer    = GPTM_WIDE_TIMER_3;
+    Config.Half     = GPTM_HALF_A;
+    Config.Edge     = GPTM_EDGE_FALLING;
+    Config.Callback = NULL_PTR;
+    HOST_CHECK(Test_Setup(&Config));
+    HOST_CHECK_EQUAL(Wide->TAILR, 0xFFFFFFFF);
+    HOST_CHECK_EQUAL(Wide->TAPR, 0xFFFF);
+    HOST_CHECK_EQUAL(Wide->IMR, 0);
+    HOST_CHECK(!Test_IrqEnabled[NVIC_IRQ_WTIMER3A]);
+    Gptm_Start(GPTM_WIDE_TIMER_3, GPTM_HALF_A);
+    Test_Run(GPTM_WIDE_TIMER_3, (1ULL << 32) + 7);
+    Test_Input(GPTM_WIDE_TIMER_3, GPTM_HALF_A, TRUE);
+    HOST_CHECK_EQUAL(Gptm_GetCapture(GPTM_WIDE_TIMER_3, GPTM_HALF_A), 0);
+    Test_Input(GPTM_WIDE_TIMER_3, GPTM_HALF_A, FALSE);
+    HOST_CHECK_EQUAL(Gptm_GetCapture(GPTM_WIDE_TIMER_3, GPTM_HALF_A), (1ULL << 32) + 7);
+    HOST_CHECK_EQUAL(Wide->RIS, GPTM_INT_CAPTURE_EVENT_MASK);
+    HOST_CHECK_EQUAL(Test_Halves[GPTM_WIDE_TIMER_3][0].Calls, 0);
+    Test_Run(GPTM_WIDE_TIMER_3, (1ULL << 48) - 7);
+    HOST_CHECK_EQUAL(Gptm_GetValue(GPTM_WIDE_TIMER_3, GPTM_HALF_A), 1ULL << 32);
+
+    /* Split halves only */
+    Config.Half = GPTM_HALF_CONCATENATED;
+    HOST_CHECK(!Test_Setup(&Config));
+    HOST_CHECK_EQUAL(Gptm_GetCapture(GPTM_WIDE_TIMER_3, GPTM_HALF_CONCATENATED), 0);
+}
+
+static void Test_PwmMode(void)
+{
+    Gptm_ConfigType Config = { GPTM_TIMER_3, GPTM_HALF_A, GPTM_MODE_PWM, 1000, 250, GPTM_EDGE_RISING, FALSE,
+                               Test_Callback, 4, FALSE };
+    GPTM_RegType *Regs = &Test_Blocks[GPTM_TIMER_3];
+    Test_HalfType *A = &Test_Halves[GPTM_TIMER_3][0];
+    Test_HalfType *B = &Test_Halves[GPTM_TIMER_3][1];
+
+    Test_Reset();
+    HOST_CHECK(Test_Setup(&Config));
+    Config.Half         = GPTM_HALF_B;
+    Config.InvertOutput = TRUE;
+    HOST_CHECK(Test_Setup(&Config));
+    HOST_CHECK_EQUAL(Regs->TAMR, GPTM_MR_PERIODIC | GPTM_MR_AMS_MASK | GPTM_MR_MRSU_MASK);
+    HOST_CHECK_EQUAL(Regs->TAILR, 999);
+    HOST_CHECK_EQUAL(Regs->TAMATCHR, 749);
+    HOST_CHECK_EQUAL(Regs->TAPR, 0);
+    HOST_CHECK_EQUAL(Regs->TAPMR, 0);
+    HOST_CHECK_EQUAL(Regs->CTL, GPTM_CTL_PWML_MASK << GPTM_HALF_B_SHIFT);
+    HOST_CHECK_EQUAL(Regs->IMR, 0);
+
+    Gptm_Start(GPTM_TIMER_3, GPTM_HALF_A);
+    Gptm_Start(GPTM_TIMER_3, GPTM_HALF_B);
+    Test_Run(GPTM_TIMER_3, 10000);
+    HOST_CHECK_EQUAL(A->HighClocks, 2500);
+    HOST_CHECK_EQUAL(B->HighClocks, 7500);
+    HOST_CHECK_EQUAL(A->Calls + B->Calls, 0);
+
+    /* Changed in the high phase: the period keeps its high time, the next one has the new one */
+    Test_Run(GPTM_TIMER_3, 100);
+    HOST_CHECK(Gptm_SetPwmHighTime(GPTM_TIMER_3, GPTM_HALF_A, 500));
+    HOST_CHECK_EQUAL(Regs->TAMATCHR, 499);
+    A->HighClocks = 0;
+    Test_Run(GPTM_TIMER_3, 900);
+    HOST_CHECK_EQUAL(A->HighClocks, 150);
+    Test_Run(GPTM_TIMER_3, 1000);
+    HOST_CHECK_EQUAL(A->HighClocks, 650);
+
+    /* Low all the time, high all but one clock */
+    HOST_CHECK(Gptm_SetPwmHighTime(GPTM_TIMER_3, GPTM_HALF_A, 0));
+    Test_Run(GPTM_TIMER_3, 1000);
+    A->HighClocks = 0;
+    Test_Run(GPTM_TIMER_3, 1000);
+    HOST_CHECK_EQUAL(A->HighClocks, 0);
+    HOST_CHECK(Gptm_SetPwmHighTime(GPTM_TIMER_3, GPTM_HALF_A, 999));
+    Test_Run(GPTM_TIMER_3, 1000);
+    A->HighClocks = 0;
+    Test_Run(GPTM_TIMER_3, 1000);
+    HOST_CHECK_EQUAL(A->HighClocks, 999);
+    HOST_CHECK(!Gptm_SetPwmHighTime(GPTM_TIMER_3, GPTM_HALF_A, 1000));
+    HOST_CHECK(!Gptm_SetPwmHighTime(GPTM_TIMER_3, GPTM_HALF_CONCATENATED, 10));
+    HOST_CHECK_EQUAL(Regs->TAMATCHR, 0);
+
+    /* 24-bit period: the prescaler holds the upper bits of the load and the match */
+    Config.Timer        = GPTM_TIMER_4;
+    Config.Half         = GPTM_HALF_A;
+    Config.Period       = 1000000;
+    Config.HighTime     = 300000;
+    Config.InvertOutput = FALSE;
+    HOST_CHECK(Test_Setup(&Config));
+    HOST_CHECK_EQUAL(Test_Blocks[GPTM_TIMER_4].TAPR, 999999 >> 16);
+    HOST_CHECK_EQUAL(Test_Blocks[GPTM_TIMER_4].TAILR, 999999 & 0xFFFF);
+    HOST_CHECK_EQUAL(Test_Blocks[GPTM_TIMER_4].TAPMR, 699999 >> 16);
+    HOST_CHECK_EQUAL(Test_Blocks[GPTM_TIMER_4].TAMATCHR, 699999 & 0xFFFF);
+    Gptm_Start(GPTM_TIMER_4, GPTM_HALF_A);
+    Test_Run(GPTM_TIMER_4, 2000000);
+    HOST_CHECK_EQUAL(Test_Halves[GPTM_TIMER_4][0].HighClocks, 600000);
+
+    /* 48-bit period of a wide timer */
+    Config.Timer    = GPTM_WIDE_TIMER_4;
+    Config.Period   = 1ULL << 40;
+    Config.HighTime = 1ULL << 39;
+    HOST_CHECK(Test_Setup(&Config));
+    Gptm_Start(GPTM_WIDE_TIMER_4, GPTM_HALF_A);
+    Test_Run(GPTM_WIDE_TIMER_4, 1ULL << 40);
+    HOST_CHECK_EQUAL(Test_Halves[GPTM_WIDE_TIMER_4][0].HighClocks, 1ULL << 39);
+
+    /* Unsupported */
+    Config.HighTime = Config.Period;
+    HOST_CHECK(!Test_Setup(&Config));
+    Config.Timer    = GPTM_TIMER_4;
+    Config.Period   = (1UL << 24) + 1;
+    Config.HighTime = 0;
+    HOST_CHECK(!Test_Setup(&Config));
+    Config.Period = 1000;
+    Config.Half   = GPTM_HALF_CONCATENATED;
+    HOST_CHECK(!Test_Setup(&Config));
+}
+
+static void Test_Routing(void)
+{
+    Gptm_ConfigType Config = { GPTM_WIDE_TIMER_5, GPTM_HALF_B, GPTM_MODE_PERIODIC, 1000, 0, GPTM_EDGE_RISING, FALSE,
+                               Test_Callback, 6, FALSE };
+    GPTM_RegType *Regs = &Test_Blocks[GPTM_TIMER_1];
+    Test_HalfType *A = &Test_Halves[GPTM_TIMER_1][0];
+    Test_HalfType *B = &Test_Halves[GPTM_TIMER_1][1];
+
+    Test_Reset();
+    HOST_CHECK(Test_Setup(&Config));
+    HOST_CHECK_EQUAL(Test_RcgcWideTimer, 1 << 5);
+    HOST_CHECK_EQUAL(Test_RcgcTimer, 0);
+    HOST_CHECK(Test_IrqEnabled[NVIC_IRQ_WTIMER5B]);
+    HOST_CHECK(!Test_IrqEnabled[NVIC_IRQ_WTIMER5A]);
+    HOST_CHECK_EQUAL(Test_IrqPriority[NVIC_IRQ_WTIMER5B], 6);
+    Config.Timer = GPTM_TIMER_5;
+    Config.Half  = GPTM_HALF_A;
+    HOST_CHECK(Test_Setup(&Config));
+    HOST_CHECK_EQUAL(Test_RcgcTimer, 1 << 5);
+    HOST_CHECK(Test_IrqEnabled[NVIC_IRQ_TIMER5A]);
+
+    /* A status raised before the configuration does not reach the callback */
+    Config.Timer  = GPTM_TIMER_1;
+    Config.Half   = GPTM_HALF_B;
+    Regs->RIS     = GPTM_INT_TIMEOUT_MASK << GPTM_HALF_B_SHIFT;
+    HOST_CHECK(Test_Setup(&Config));
+    Gptm_Start(GPTM_TIMER_1, GPTM_HALF_B);
+    Test_Run(GPTM_TIMER_1, 999);
+    HOST_CHECK_EQUAL(B->Calls, 0);
+    Test_Run(GPTM_TIMER_1, 1);
+    HOST_CHECK_EQUAL(B->Calls, 1);
+
+    /* Without a callback: status raised, interrupt masked and IRQ off, half B left as it was */
+    Config.Half     = GPTM_HALF_A;
+    Config.Period   = 300;
+    Config.Callback = NULL_PTR;
+    HOST_CHECK(Test_Setup(&Config));
+    HOST_CHECK(!Test_IrqEnabled[NVIC_IRQ_TIMER1A]);
+    HOST_CHECK(Test_IrqEnabled[NVIC_IRQ_TIMER1B]);
+    HOST_CHECK_EQUAL(Regs->IMR, GPTM_INT_TIMEOUT_MASK << GPTM_HALF_B_SHIFT);
+    HOST_CHECK_EQUAL(Regs->TBILR, 999);
+    HOST_CHECK_EQUAL(Regs->CTL, (GPTM_CTL_EN_MASK | GPTM_CTL_STALL_MASK) << GPTM_HALF_B_SHIFT);
+    Gptm_Start(GPTM_TIMER_1, GPTM_HALF_A);
+    Test_Run(GPTM_TIMER_1, 1000);
+    HOST_CHECK_EQUAL(A->Calls, 0);
+    HOST_CHECK_EQUAL(Regs->RIS, GPTM_INT_TIMEOUT_MASK);
+    HOST_CHECK_EQUAL(B->Calls, 2);
+
+    /* A failed configuration leaves the IRQ disabled */
+    Config.Half     = GPTM_HALF_B;
+    Config.Mode     = GPTM_MODE_PWM;
+    Config.HighTime = 2000;
+    Config.Callback = Test_Callback;
+    HOST_CHECK(!Gptm_Init(&Config));
+    HOST_CHECK(!Test_IrqEnabled[NVIC_IRQ_TIMER1B]);
+
+    HOST_CHECK(!Gptm_Init(NULL_PTR));
+    Config.Timer = GPTM_TIMERS;
+    HOST_CHECK(!Gptm_Init(&Config));
+    Config.Timer = GPTM_TIMER_1;
+    Config.Half  = (Gptm_HalfType)3;
+    HOST_CHECK(!Gptm_Init(&Config));
+    Config.Half = GPTM_HALF_A;
+    Config.Mode = (Gptm_ModeType)4;
+    HOST_CHECK(!Gptm_Init(&Config));
+    HOST_CHECK(!Gptm_ConfigureBlock(NULL_PTR, &Config));
+    HOST_CHECK_EQUAL(Gptm_GetValue(GPTM_TIMERS, GPTM_HALF_A), 0);
+}
+
+int main(void)
+{
+    Test_Periodic();
+    Test_OneShot();
+    Test_CaptureTime();
+    Test_PwmMode();
+    Test_Routing();
+
+    return Host_Report("gptm_test");
+}
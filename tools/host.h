@@ -0,0 +1,148 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: host.h
+ *
+ * Description: Host build of the driver sources for the tests and benchmarks of tools/.
+ *              Replaces std_types.h with fixed width types, maps the TI ARM compiler intrinsics
+ *              and the __asm() instructions of the drivers to a model of PRIMASK, and provides
+ *              the checks of the test programs.
+ *
+ *              A program includes this file first, then tm4c123gh6pm_registers.h, redirects the
+ *              register macros used by the driver to variables in host memory and includes the
+ *              driver .c file, as irq_replay.c does with NVIC.c.
+ *
+ *              The programs are linked with -no-pie (Makefile): the drivers keep addresses in
+ *              32-bit registers and descriptors, static objects then have addresses below 4 GB.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#ifndef HOST_H_
+#define HOST_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/* Host definitions of the firmware types, uint32 must stay 32 bits for the register layouts */
+#define STD_TYPES_H_
+#define FALSE                       (0u)
+#define TRUE                        (1u)
+#define LOGIC_HIGH                  (1u)
+#define LOGIC_LOW                   (0u)
+#define NULL_PTR                    ((void*)0)
+typedef uint8_t                     uint8;
+typedef int8_t                      sint8;
+typedef uint16_t                    uint16;
+typedef int16_t                     sint16;
+typedef uint32_t                    uint32;
+typedef int32_t                     sint32;
+typedef uint64_t                    uint64;
+typedef int64_t                     sint64;
+typedef float                       float32;
+typedef double                      float64;
+typedef uint8                       boolean;
+
+/* 32-bit address of a static object, as stored by the drivers in the registers */
+#define HOST_ADDRESS(Object)        ((uint32)(uintptr_t)(Object))
+
+/*******************************************************************************
+ *                           Core model                                        *
+ *******************************************************************************/
+
+/* PRIMASK of the model, 1 while the interrupts are disabled */
+static uint32 Host_Primask;
+
+/* Called for the instructions other than CPSID/CPSIE I (WFI, WFE, SEV, DSB, ISB ...) */
+static void (*Host_InstructionHook)(const char *a_Instruction);
+
+static inline uint32 Host_DisableInterrupts(void)
+{
+    uint32 Previous = Host_Primask;
+
+    Host_Primask = 1;
+    return Previous;
+}
+
+static inline uint32 Host_RestoreInterrupts(uint32 a_State)
+{
+    uint32 Previous = Host_Primask;
+
+    Host_Primask = a_State & 1u;
+    return Previous;
+}
+
+static inline void Host_Asm(const char *a_Instruction)
+{
+    if(strstr(a_Instruction, "CPSID I") != NULL)
+    {
+        Host_Primask = 1;
+    }
+    else if(strstr(a_Instruction, "CPSIE I") != NULL)
+    {
+        Host_Primask = 0;
+    }
+    else if(Host_InstructionHook != NULL)
+    {
+        Host_InstructionHook(a_Instruction);
+    }
+}
+
+static inline uint32 Host_Norm(uint32 a_Value)
+{
+    return (a_Value != 0) ? (uint32)__builtin_clz(a_Value) : 32u;
+}
+
+/* TI ARM compiler intrinsics */
+#define _disable_interrupts()       Host_DisableInterrupts()
+#define _restore_interrupts(State)  Host_RestoreInterrupts(State)
+#define _norm(Value)                Host_Norm(Value)
+#define __asm(Instruction)          Host_Asm(Instruction)
+
+/*******************************************************************************
+ *                           Checks                                            *
+ *******************************************************************************/
+
+static unsigned long Host_Checks;
+static unsigned long Host_Failures;
+
+static inline int Host_Check(int a_Passed, const char *a_Text, const char *a_File, int a_Line)
+{
+    Host_Checks++;
+    if(!a_Passed)
+    {
+        Host_Failures++;
+        fprintf(stderr, "%s:%d: check failed: %s\n", a_File, a_Line, a_Text);
+    }
+    return a_Passed;
+}
+
+static inline int Host_CheckEqual(uint64 a_Actual, uint64 a_Expected, const char *a_Text, const char *a_File, int a_Line)
+{
+    Host_Checks++;
+    if(a_Actual != a_Expected)
+    {
+        Host_Failures++;
+        fprintf(stderr, "%s:%d: check failed: %s is %llu (0x%llX), expected %llu (0x%llX)\n", a_File, a_Line, a_Text,
+                (unsigned long long)a_Actual, (unsigned long long)a_Actual,
+                (unsigned long long)a_Expected, (unsigned long long)a_Expected);
+    }
+    return a_Actual == a_Expected;
+}
+
+#define HOST_CHECK(Condition)               Host_Check((Condition) ? 1 : 0, #Condition, __FILE__, __LINE__)
+#define HOST_CHECK_EQUAL(Actual, Expected)  Host_CheckEqual((uint64)(Actual), (uint64)(Expected), #Actual, __FILE__, __LINE__)
+
+/* Summary line of a test program, exit status 0 when every check passed and 2 otherwise */
+static inline int Host_Report(const char *a_Name)
+{
+    printf("%s: %lu checks, %lu failed\n", a_Name, Host_Checks, Host_Failures);
+    return (Host_Failures == 0) ? 0 : 2;
+}
+
+#endif /* HOST_H_ */
@@ -0,0 +1,946 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: irq_replay.c
+ *
+ * Description: Deterministic record and replay of interrupt workloads against the NVIC driver.
+ *              NVIC_Driver/NVIC.c is compiled into this tool with NVIC_REGS and SCB_REGS pointing
+ *              to a register file in host memory.
+ *
+ *              record : runs a timed workload through the driver and writes a compact trace of the
+ *                       driver calls, the register writes each call made and the interrupt arrivals.
+ *              replay : runs the driver calls of a trace again and checks that they write the same
+ *                       registers, simulates the arrivals on a model of the NVIC (preemption by
+ *                       priority, tail-chaining, pending merge) and compares the final register
+ *                       state and the per IRQ cycle estimates with a stored baseline.
+ *
+ *              Workload : one event per line, '#' starts a comment, times in core cycles and in
+ *                         increasing order
+ *                         <cycle> enable <irq>            <cycle> disable <irq>
+ *                         <cycle> priority <irq> <level>  <cycle> cost <irq> <handler cycles>
+ *                         <cycle> exc_enable <exception>  <cycle> exc_disable <exception>
+ *                         <cycle> exc_priority <exception> <level>
+ *                         <cycle> irq <irq>               (interrupt arrival)
+ *                         exceptions are the NVIC_ExceptionType values of NVIC_Driver/NVIC.h
+ *
+ *              Build : gcc -O2 -I../NVIC_Driver -o irq_replay irq_replay.c
+ *              Usage : irq_replay record <workload.txt> <trace.bin>
+ *                      irq_replay replay [--baseline File] [--write-baseline File] <trace.bin>
+ *
+ *              Exit status is 0 on success, 2 when the driver writes diverge from the trace or the
+ *              result differs from the baseline, and 1 on input errors.
+ *
+ *              "make check" records data/irq_workload.txt, compares the trace with
+ *              data/irq_workload.bin and replays it against data/irq_replay_baseline.txt.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+/* Host definitions of the firmware types, uint32 must stay 32 bits for the register layouts */
+#define STD_TYPES_H_
+#define FALSE                       (0u)
+#define TRUE                        (1u)
+#define NULL_PTR                    ((void*)0)
+typedef uint8_t                     uint8;
+typedef int8_t                      sint8;
+typedef uint16_t                    uint16;
+typedef int16_t                     sint16;
+typedef uint32_t                    uint32;
+typedef int32_t                     sint32;
+typedef uint64_t                    uint64;
+typedef int64_t                     sint64;
+typedef uint8                       boolean;
+
+#include "tm4c123gh6pm_registers.h"
+
+static NVIC_RegType Replay_Nvic;
+static SCB_RegType Replay_Scb;
+
+#undef NVIC_REGS
+#undef SCB_REGS
+#define NVIC_REGS                   (&Replay_Nvic)
+#define SCB_REGS                    (&Replay_Scb)
+
+#include "NVIC.c"
+
+#define REPLAY_MAGIC                0x52515249u /* "IRQR" */
+#define REPLAY_VERSION              1u
+#define REPLAY_HEADER_SIZE          12u
+#define REPLAY_IRQS                 (NVIC_MAX_IRQ_NUM + 1)
+#define REPLAY_BANKS                NVIC_IRQ_BANKS
+#define REPLAY_LEVELS               (NVIC_MAX_PRIORITY + 1)
+#define REPLAY_MAX_WRITES           16
+#define REPLAY_FOREVER              UINT64_MAX
+
+/* Cortex-M4 exception timing, zero wait state memory */
+#define REPLAY_ENTRY_CYCLES         12u
+#define REPLAY_TAIL_CHAIN_CYCLES    6u
+#define REPLAY_EXIT_CYCLES          10u
+
+#define NVIC_WORDS                  (sizeof(NVIC_RegType) / 4u)
+#define SCB_WORDS                   (sizeof(SCB_RegType) / 4u)
+
+/* Trace records: operation byte, time delta from the previous record (except WRITE), operands */
+enum
+{
+    REPLAY_OP_ENABLE = 1,           /* irq */
+    REPLAY_OP_DISABLE,              /* irq */
+    REPLAY_OP_PRIORITY,             /* irq, level */
+    REPLAY_OP_EXC_ENABLE,           /* exception */
+    REPLAY_OP_EXC_DISABLE,          /* exception */
+    REPLAY_OP_EXC_PRIORITY,         /* exception, level */
+    REPLAY_OP_WRITE,                /* block, word offset, value: a write of the preceding call */
+    REPLAY_OP_ARRIVAL,              /* irq */
+    REPLAY_OP_COST                  /* irq, handler cycles */
+};
+
+enum
+{
+    REPLAY_BLOCK_NVIC,
+    REPLAY_BLOCK_SCB
+};
+
+typedef struct
+{
+    uint64_t Time;
+    uint32_t Value;                 /* Level, cost, or value of a write */
+    uint16_t Offset;                /* Word offset of a write */
+    uint8_t  Op;
+    uint8_t  Target;                /* IRQ, exception or block of a write */
+}Event_Type;
+
+typedef struct
+{
+    uint8_t  Block;
+    uint16_t Offset;
+    uint32_t Value;
+}Write_Type;
+
+typedef struct
+{
+    uint64_t Count;
+    uint64_t Lost;                  /* Arrivals merged into an already pending request */
+    uint64_t Cycles;                /* Handler and entry overhead cycles */
+    uint64_t MaxLatency;            /* Arrival to first handler instruction */
+    uint64_t MaxResponse;           /* Arrival to handler return */
+}IrqStats_Type;
+
+typedef struct
+{
+    uint64_t Remaining;
+    uint8_t  Irq;
+    uint8_t  Level;
+}Frame_Type;
+
+static Event_Type *Events;
+static size_t EventsCount;
+static size_t EventsCapacity;
+
+static uint32_t Sim_Enabled[REPLAY_BANKS];
+static uint32_t Sim_Pending[REPLAY_BANKS];
+static uint32_t Sim_Cost[REPLAY_IRQS];
+static uint64_t Sim_Arrival[REPLAY_IRQS];
+static IrqStats_Type Sim_Stats[REPLAY_IRQS];
+static Frame_Type Sim_Stack[REPLAY_LEVELS];
+static unsigned Sim_Depth;
+static uint64_t Sim_Time;
+static int Sim_TailChain;
+static unsigned long Divergences;
+
+/*******************************************************************************
+ *                              Trace encoding                                 *
+ *******************************************************************************/
+
+static void Write32(uint8_t *a_Bytes, uint32_t a_Value)
+{
+    a_Bytes[0] = (uint8_t)a_Value;
+    a_Bytes[1] = (uint8_t)(a_Value >> 8);
+    a_Bytes[2] = (uint8_t)(a_Value >> 16);
+    a_Bytes[3] = (uint8_t)(a_Value >> 24);
+}
+
+static uint32_t Read32(const uint8_t *a_Bytes)
+{
+    return (uint32_t)a_Bytes[0] | ((uint32_t)a_Bytes[1] << 8) | ((uint32_t)a_Bytes[2] << 16) | ((uint32_t)a_Bytes[3] << 24);
+}
+
+static void Put_Varint(FILE *a_File, uint64_t a_Value)
+{
+    while(a_Value >= 0x80u)
+    {
+        fputc((int)((a_Value & 0x7Fu) | 0x80u), a_File);
+        a_Value >>= 7;
+    }
+    fputc((int)a_Value, a_File);
+}
+
+static int Get_Varint(const uint8_t **a_Cursor, const uint8_t *a_End, uint64_t *a_Value)
+{
+    uint64_t Value = 0;
+    unsigned Shift = 0;
+
+    while(*a_Cursor < a_End)
+    {
+        uint8_t Byte = *(*a_Cursor)++;
+
+        Value |= (uint64_t)(Byte & 0x7Fu) << Shift;
+        if((Byte & 0x80u) == 0)
+        {
+            *a_Value = Value;
+            return 1;
+        }
+        Shift += 7;
+        if(Shift >= 64)
+        {
+            break;
+        }
+    }
+    return 0;
+}
+
+static int Event_Append(const Event_Type *a_Event)
+{
+    if(EventsCount == EventsCapacity)
+    {
+        EventsCapacity = (EventsCapacity == 0) ? 4096 : (EventsCapacity * 2);
+        Events = realloc(Events, EventsCapacity * sizeof(Event_Type));
+        if(Events == NULL)
+        {
+            fprintf(stderr, "out of memory\n");
+            return 0;
+        }
+    }
+    Events[EventsCount++] = *a_Event;
+    return 1;
+}
+
+static int Op_HasLevel(uint8_t a_Op)
+{
+    return (a_Op == REPLAY_OP_PRIORITY) || (a_Op == REPLAY_OP_EXC_PRIORITY);
+}
+
+static int Op_IsCall(uint8_t a_Op)
+{
+    return (a_Op >= REPLAY_OP_ENABLE) && (a_Op <= REPLAY_OP_EXC_PRIORITY);
+}
+
+static int Trace_Write(const char *a_Path)
+{
+    FILE *File = fopen(a_Path, "wb");
+    uint8_t Header[REPLAY_HEADER_SIZE];
+    uint64_t Previous = 0;
+    size_t Index;
+
+    if(File == NULL)
+    {
+        perror(a_Path);
+        return 0;
+    }
+    Write32(Header, REPLAY_MAGIC);
+    Write32(Header + 4, REPLAY_VERSION);
+    Write32(Header + 8, (uint32_t)EventsCount);
+    fwrite(Header, 1, sizeof(Header), File);
+
+    for(Index = 0; Index < EventsCount; Index++)
+    {
+        const Event_Type *Event = &Events[Index];
+
+        fputc(Event->Op, File);
+        if(Event->Op == REPLAY_OP_WRITE)
+        {
+            fputc(Event->Target, File);
+            Put_Varint(File, Event->Offset);
+            Put_Varint(File, Event->Value);
+            continue;
+        }
+        Put_Varint(File, Event->Time - Previous);
+        Previous = Event->Time;
+        fputc(Event->Target, File);
+        if(Op_HasLevel(Event->Op) || (Event->Op == REPLAY_OP_COST))
+        {
+            Put_Varint(File, Event->Value);
+        }
+    }
+    if(fclose(File) != 0)
+    {
+        perror(a_Path);
+        return 0;
+    }
+    return 1;
+}
+
+static int Trace_Read(const char *a_Path)
+{
+    FILE *File = fopen(a_Path, "rb");
+    const uint8_t *Cursor;
+    const uint8_t *End;
+    uint8_t *Data;
+    uint64_t Time = 0;
+    uint32_t Count;
+    uint32_t Index;
+    long Size;
+
+    if(File == NULL)
+    {
+        perror(a_Path);
+        return 0;
+    }
+    fseek(File, 0, SEEK_END);
+    Size = ftell(File);
+    fseek(File, 0, SEEK_SET);
+    Data = malloc((Size > 0) ? (size_t)Size : 1u);
+    if((Data == NULL) || (fread(Data, 1, (size_t)Size, File) != (size_t)Size))
+    {
+        fprintf(stderr, "%s: read error\n", a_Path);
+        fclose(File);
+        free(Data);
+        return 0;
+    }
+    fclose(File);
+
+    if((Size < (long)REPLAY_HEADER_SIZE) || (Read32(Data) != REPLAY_MAGIC) || (Read32(Data + 4) != REPLAY_VERSION))
+    {
+        fprintf(stderr, "%s: not an irq_replay trace\n", a_Path);
+        free(Data);
+        return 0;
+    }
+    Count  = Read32(Data + 8);
+    Cursor = Data + REPLAY_HEADER_SIZE;
+    End    = Data + Size;
+
+    for(Index = 0; Index < Count; Index++)
+    {
+        Event_Type Event;
+        uint64_t Value = 0;
+        int Valid;
+
+        memset(&Event, 0, sizeof(Event));
+        Valid = (Cursor + 2 <= End);
+        if(Valid)
+        {
+            Event.Op = *Cursor++;
+        }
+        if(Valid && (Event.Op == REPLAY_OP_WRITE))
+        {
+            Event.Target = *Cursor++;
+            Valid = Get_Varint(&Cursor, End, &Value);
+            Event.Offset = (uint16_t)Value;
+            Valid = Valid && Get_Varint(&Cursor, End, &Value);
+            Event.Value = (uint32_t)Value;
+            Event.Time  = Time;
+        }
+        else if(Valid && (Event.Op >= REPLAY_OP_ENABLE) && (Event.Op <= REPLAY_OP_COST))
+        {
+            Valid = Get_Varint(&Cursor, End, &Value) && (Cursor < End);
+            Time += Value;
+            Event.Time = Time;
+            if(Valid)
+            {
+                Event.Target = *Cursor++;
+            }
+            if(Valid && (Op_HasLevel(Event.Op) || (Event.Op == REPLAY_OP_COST)))
+            {
+                Valid = Get_Varint(&Cursor, End, &Value);
+                Event.Value = (uint32_t)Value;
+            }
+        }
+        else
+        {
+            Valid = 0;
+        }
+        if(!Valid || !Event_Append(&Event))
+        {
+            fprintf(stderr, "%s: corrupt record %u\n", a_Path, Index);
+            free(Data);
+            return 0;
+        }
+    }
+    free(Data);
+    return 1;
+}
+
+/*******************************************************************************
+ *                         Driver on the register file                         *
+ *******************************************************************************/
+
+/*
+ * The set enable / clear enable and set pending / clear pending registers are write 1 only:
+ * they are cleared before the call, every bit found set after it is a write. The other words
+ * are compared with a copy taken before the call. The model state is then written back so
+ * the driver reads the enable and pending bits as on the target.
+ */
+static unsigned Driver_Call(const Event_Type *a_Event, Write_Type *a_Writes)
+{
+    static NVIC_RegType NvicBefore;
+    static SCB_RegType ScbBefore;
+    const uint32_t *Words;
+    const uint32_t *Before;
+    unsigned Count = 0;
+    unsigned Word;
+    unsigned Bank;
+
+    memset(Replay_Nvic.EN, 0, sizeof(Replay_Nvic.EN));
+    memset(Replay_Nvic.DIS, 0, sizeof(Replay_Nvic.DIS));
+    memset(Replay_Nvic.PEND, 0, sizeof(Replay_Nvic.PEND));
+    memset(Replay_Nvic.UNPEND, 0, sizeof(Replay_Nvic.UNPEND));
+    NvicBefore = Replay_Nvic;
+    ScbBefore  = Replay_Scb;
+
+    switch(a_Event->Op)
+    {
+    case REPLAY_OP_ENABLE       : NVIC_EnableIRQ(a_Event->Target);                                                   break;
+    case REPLAY_OP_DISABLE      : NVIC_DisableIRQ(a_Event->Target);                                                  break;
+    case REPLAY_OP_PRIORITY     : NVIC_SetPriorityIRQ(a_Event->Target, (NVIC_IRQPriorityType)a_Event->Value);         break;
+    case REPLAY_OP_EXC_ENABLE   : NVIC_EnableException((NVIC_ExceptionType)a_Event->Target);                          break;
+    case REPLAY_OP_EXC_DISABLE  : NVIC_DisableException((NVIC_ExceptionType)a_Event->Target);                         break;
+    case REPLAY_OP_EXC_PRIORITY : NVIC_SetPriorityException((NVIC_ExceptionType)a_Event->Target, (NVIC_ExceptionPriorityType)a_Event->Value); break;
+    default                     : break;
+    }
+
+    Words  = (const uint32_t *)&Replay_Nvic;
+    Before = (const uint32_t *)&NvicBefore;
+    for(Word = 0; (Word < NVIC_WORDS) && (Count < REPLAY_MAX_WRITES); Word++)
+    {
+        if(Words[Word] != Before[Word])
+        {
+            a_Writes[Count].Block  = REPLAY_BLOCK_NVIC;
+            a_Writes[Count].Offset = (uint16_t)Word;
+            a_Writes[Count].Value  = Words[Word];
+            Count++;
+        }
+    }
+    Words  = (const uint32_t *)&Replay_Scb;
+    Before = (const uint32_t *)&ScbBefore;
+    for(Word = 0; (Word < SCB_WORDS) && (Count < REPLAY_MAX_WRITES); Word++)
+    {
+        if(Words[Word] != Before[Word])
+        {
+            a_Writes[Count].Block  = REPLAY_BLOCK_SCB;
+            a_Writes[Count].Offset = (uint16_t)Word;
+            a_Writes[Count].Value  = Words[Word];
+            Count++;
+        }
+    }
+
+    for(Bank = 0; Bank < REPLAY_BANKS; Bank++)
+    {
+        Sim_Enabled[Bank] = (Sim_Enabled[Bank] | Replay_Nvic.EN[Bank]) & ~Replay_Nvic.DIS[Bank];
+        Sim_Pending[Bank] = (Sim_Pending[Bank] | Replay_Nvic.PEND[Bank]) & ~Replay_Nvic.UNPEND[Bank];
+        Replay_Nvic.EN[Bank]     = Sim_Enabled[Bank];
+        Replay_Nvic.DIS[Bank]    = Sim_Enabled[Bank];
+        Replay_Nvic.PEND[Bank]   = Sim_Pending[Bank];
+        Replay_Nvic.UNPEND[Bank] = Sim_Pending[Bank];
+    }
+    return Count;
+}
+
+/*******************************************************************************
+ *                               NVIC model                                    *
+ *******************************************************************************/
+
+static unsigned Irq_Level(unsigned a_Irq)
+{
+    return (unsigned)Replay_Nvic.PRI[a_Irq] >> NVIC_IRQ_PRIORITY_BITS_POS;
+}
+
+static void Pending_Set(unsigned a_Irq, int a_Pending)
+{
+    uint32_t Mask = 1u << (a_Irq % NVIC_IRQ_BANK_BITS);
+    unsigned Bank = a_Irq / NVIC_IRQ_BANK_BITS;
+
+    Sim_Pending[Bank] = a_Pending ? (Sim_Pending[Bank] | Mask) : (Sim_Pending[Bank] & ~Mask);
+    Replay_Nvic.PEND[Bank]   = Sim_Pending[Bank];
+    Replay_Nvic.UNPEND[Bank] = Sim_Pending[Bank];
+}
+
+static void Active_Set(unsigned a_Irq, int a_Active)
+{
+    uint32_t Mask = 1u << (a_Irq % NVIC_IRQ_BANK_BITS);
+    unsigned Bank = a_Irq / NVIC_IRQ_BANK_BITS;
+
+    Replay_Nvic.ACTIVE[Bank] = a_Active ? (Replay_Nvic.ACTIVE[Bank] | Mask) : (Replay_Nvic.ACTIVE[Bank] & ~Mask);
+}
+
+/* Enabled pending IRQ that preempts the running level, lowest level then lowest number, -1 if none */
+static int Sim_Pick(void)
+{
+    unsigned Threshold = (Sim_Depth != 0) ? Sim_Stack[Sim_Depth - 1].Level : REPLAY_LEVELS;
+    unsigned Best = REPLAY_LEVELS;
+    int Pick = -1;
+    unsigned Bank;
+
+    for(Bank = 0; Bank < REPLAY_BANKS; Bank++)
+    {
+        uint32_t Ready = Sim_Pending[Bank] & Sim_Enabled[Bank];
+
+        while(Ready != 0)
+        {
+            unsigned Irq   = (Bank * NVIC_IRQ_BANK_BITS) + (unsigned)__builtin_ctz(Ready);
+            unsigned Level = Irq_Level(Irq);
+
+            Ready &= Ready - 1u;
+            if((Level < Threshold) && (Level < Best))
+            {
+                Best = Level;
+                Pick = (int)Irq;
+            }
+        }
+    }
+    return Pick;
+}
+
+static void Sim_Enter(unsigned a_Irq, uint32_t a_Overhead)
+{
+    IrqStats_Type *Stats = &Sim_Stats[a_Irq];
+    uint64_t Latency = Sim_Time + a_Overhead - Sim_Arrival[a_Irq];
+    Frame_Type *Frame = &Sim_Stack[Sim_Depth++];
+
+    Pending_Set(a_Irq, 0);
+    Active_Set(a_Irq, 1);
+    Frame->Irq       = (uint8_t)a_Irq;
+    Frame->Level     = (uint8_t)Irq_Level(a_Irq);
+    Frame->Remaining = (uint64_t)a_Overhead + Sim_Cost[a_Irq];
+    Stats->Cycles   += Frame->Remaining;
+    if(Latency > Stats->MaxLatency)
+    {
+        Stats->MaxLatency = Latency;
+    }
+}
+
+/*
+ * Runs the model up to a_Until. A request of a strictly higher level preempts the running
+ * handler with the entry cost, a request taken right after a return is tail-chained. Nested
+ * returns and returns to thread mode cost the exit time. Nothing is taken at a_Until itself,
+ * the arrivals of the same cycle are all pending before the highest one is chosen.
+ */
+static void Sim_RunUntil(uint64_t a_Until)
+{
+    for(;;)
+    {
+        int Pick;
+        Frame_Type *Top;
+
+        if((a_Until != REPLAY_FOREVER) && (Sim_Time >= a_Until))
+        {
+            return;
+        }
+        Pick = Sim_Pick();
+        if(Pick >= 0)
+        {
+            Sim_Enter((unsigned)Pick, Sim_TailChain ? REPLAY_TAIL_CHAIN_CYCLES : REPLAY_ENTRY_CYCLES);
+            Sim_TailChain = 0;
+            continue;
+        }
+        if(Sim_Depth == 0)
+        {
+            Sim_TailChain = 0;
+            if(a_Until != REPLAY_FOREVER)
+            {
+                Sim_Time = a_Until;
+            }
+            return;
+        }
+
+        Top = &Sim_Stack[Sim_Depth - 1];
+        if((a_Until != REPLAY_FOREVER) && ((Sim_Time + Top->Remaining) > a_Until))
+        {
+            Top->Remaining -= a_Until - Sim_Time;
+            Sim_Time = a_Until;
+            return;
+        }
+
+        Sim_Time += Top->Remaining;
+        Sim_Stats[Top->Irq].Count++;
+        if((Sim_Time - Sim_Arrival[Top->Irq]) > Sim_Stats[Top->Irq].MaxResponse)
+        {
+            Sim_Stats[Top->Irq].MaxResponse = Sim_Time - Sim_Arrival[Top->Irq];
+        }
+        Active_Set(Top->Irq, 0);
+        Sim_Depth--;
+        if(Sim_Pick() >= 0)
+        {
+            Sim_TailChain = 1;
+        }
+        else
+        {
+            Sim_Time += REPLAY_EXIT_CYCLES;
+        }
+    }
+}
+
+static void Sim_Arrive(unsigned a_Irq)
+{
+    if(Sim_Pending[a_Irq / NVIC_IRQ_BANK_BITS] & (1u << (a_Irq % NVIC_IRQ_BANK_BITS)))
+    {
+        Sim_Stats[a_Irq].Lost++;
+        return;
+    }
+    Sim_Arrival[a_Irq] = Sim_Time;
+    Pending_Set(a_Irq, 1);
+}
+
+static void Sim_Reset(void)
+{
+    memset(&Replay_Nvic, 0, sizeof(Replay_Nvic));
+    memset(&Replay_Scb, 0, sizeof(Replay_Scb));
+    memset(Sim_Enabled, 0, sizeof(Sim_Enabled));
+    memset(Sim_Pending, 0, sizeof(Sim_Pending));
+    memset(Sim_Cost, 0, sizeof(Sim_Cost));
+    memset(Sim_Arrival, 0, sizeof(Sim_Arrival));
+    memset(Sim_Stats, 0, sizeof(Sim_Stats));
+    Sim_Depth     = 0;
+    Sim_Time      = 0;
+    Sim_TailChain = 0;
+}
+
+/*******************************************************************************
+ *                                  Modes                                      *
+ *******************************************************************************/
+
+static int Workload_Parse(const char *a_Line, Event_Type *a_Event)
+{
+    static const struct
+    {
+        const char *Name;
+        uint8_t Op;
+        int Operands;
+    }Keywords[] =
+    {
+        { "enable",       REPLAY_OP_ENABLE,       1 },
+        { "disable",      REPLAY_OP_DISABLE,      1 },
+        { "priority",     REPLAY_OP_PRIORITY,     2 },
+        { "exc_enable",   REPLAY_OP_EXC_ENABLE,   1 },
+        { "exc_disable",  REPLAY_OP_EXC_DISABLE,  1 },
+        { "exc_priority", REPLAY_OP_EXC_PRIORITY, 2 },
+        { "irq",          REPLAY_OP_ARRIVAL,      1 },
+        { "cost",         REPLAY_OP_COST,         2 }
+    };
+    unsigned long long Time;
+    unsigned long Target, Value = 0;
+    char Name[16];
+    int Fields = sscanf(a_Line, "%llu %15s %lu %lu", &Time, Name, &Target, &Value);
+    size_t Index;
+
+    memset(a_Event, 0, sizeof(Event_Type));
+    for(Index = 0; Index < sizeof(Keywords) / sizeof(Keywords[0]); Index++)
+    {
+        if((Fields >= 2) && (strcmp(Name, Keywords[Index].Name) == 0))
+        {
+            if((Fields != 2 + Keywords[Index].Operands) || (Target >= REPLAY_IRQS))
+            {
+                return 0;
+            }
+            a_Event->Time   = Time;
+            a_Event->Op     = Keywords[Index].Op;
+            a_Event->Target = (uint8_t)Target;
+            a_Event->Value  = (uint32_t)Value;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int Mode_Record(const char *a_Workload, const char *a_Trace)
+{
+    FILE *File = fopen(a_Workload, "r");
+    Write_Type Writes[REPLAY_MAX_WRITES];
+    char Line[256];
+    unsigned LineNumber = 0;
+    uint64_t Previous = 0;
+    unsigned Count, Index;
+
+    if(File == NULL)
+    {
+        perror(a_Workload);
+        return 1;
+    }
+    Sim_Reset();
+    while(fgets(Line, sizeof(Line), File) != NULL)
+    {
+        char *Comment = strchr(Line, '#');
+        Event_Type Event;
+        char Word[2];
+
+        LineNumber++;
+        if(Comment != NULL)
+        {
+            *Comment = '\0';
+        }
+        if(sscanf(Line, "%1s", Word) != 1)
+        {
+            continue;
+        }
+        if(!Workload_Parse(Line, &Event) || (Event.Time < Previous))
+        {
+            fprintf(stderr, "%s:%u: bad event or time going backwards\n", a_Workload, LineNumber);
+            fclose(File);
+            return 1;
+        }
+        Previous = Event.Time;
+        if(!Event_Append(&Event))
+        {
+            fclose(File);
+            return 1;
+        }
+        if(Op_IsCall(Event.Op))
+        {
+            Count = Driver_Call(&Event, Writes);
+            for(Index = 0; Index < Count; Index++)
+            {
+                Event_Type Write;
+
+                memset(&Write, 0, sizeof(Write));
+                Write.Time   = Event.Time;
+                Write.Op     = REPLAY_OP_WRITE;
+                Write.Target = Writes[Index].Block;
+                Write.Offset = Writes[Index].Offset;
+                Write.Value  = Writes[Index].Value;
+                if(!Event_Append(&Write))
+                {
+                    fclose(File);
+                    return 1;
+                }
+            }
+        }
+    }
+    fclose(File);
+
+    if(!Trace_Write(a_Trace))
+    {
+        return 1;
+    }
+    fprintf(stderr, "%s: %zu records\n", a_Trace, EventsCount);
+    return 0;
+}
+
+/* Result text compared with the baseline: non zero registers then the IRQs that ran */
+static char *Result_Format(size_t *a_Size)
+{
+    const uint32_t *Words;
+    char *Text = NULL;
+    size_t Size = 0;
+    FILE *Stream = open_memstream(&Text, &Size);
+    unsigned Index;
+
+    if(Stream == NULL)
+    {
+        return NULL;
+    }
+    fprintf(Stream, "end_cycle %llu\n", (unsigned long long)Sim_Time);
+    Words = (const uint32_t *)&Replay_Nvic;
+    for(Index = 0; Index < NVIC_WORDS; Index++)
+    {
+        if(Words[Index] != 0)
+        {
+            fprintf(Stream, "nvic 0x%03X 0x%08X\n", Index * 4u, Words[Index]);
+        }
+    }
+    Words = (const uint32_t *)&Replay_Scb;
+    for(Index = 0; Index < SCB_WORDS; Index++)
+    {
+        if(Words[Index] != 0)
+        {
+            fprintf(Stream, "scb 0x%02X 0x%08X\n", Index * 4u, Words[Index]);
+        }
+    }
+    for(Index = 0; Index < REPLAY_IRQS; Index++)
+    {
+        const IrqStats_Type *Stats = &Sim_Stats[Index];
+
+        if((Stats->Count != 0) || (Stats->Lost != 0))
+        {
+            fprintf(Stream, "irq %u count %llu lost %llu cycles %llu max_latency %llu max_response %llu\n", Index,
+                    (unsigned long long)Stats->Count, (unsigned long long)Stats->Lost, (unsigned long long)Stats->Cycles,
+                    (unsigned long long)Stats->MaxLatency, (unsigned long long)Stats->MaxResponse);
+        }
+    }
+    fclose(Stream);
+    *a_Size = Size;
+    return Text;
+}
+
+/* Prints the first differing line of each side, returns 1 when the texts are equal */
+static int Result_Compare(const char *a_Result, const char *a_Path)
+{
+    FILE *File = fopen(a_Path, "r");
+    const char *Cursor = a_Result;
+    char Line[256];
+    unsigned LineNumber = 0;
+
+    if(File == NULL)
+    {
+        perror(a_Path);
+        return 0;
+    }
+    while(fgets(Line, sizeof(Line), File) != NULL)
+    {
+        size_t Length = strlen(Line);
+
+        LineNumber++;
+        if(strncmp(Cursor, Line, Length) != 0)
+        {
+            const char *End = strchr(Cursor, '\n');
+            int Shown = (End != NULL) ? (int)(End - Cursor) : (int)strlen(Cursor);
+
+            fprintf(stderr, "%s:%u: baseline: %s", a_Path, LineNumber, Line);
+            fprintf(stderr, "%s:%u: replay  : %.*s\n", a_Path, LineNumber, Shown, Cursor);
+            fclose(File);
+            return 0;
+        }
+        Cursor += Length;
+    }
+    fclose(File);
+    if(*Cursor != '\0')
+    {
+        fprintf(stderr, "%s: replay has more lines than the baseline\n", a_Path);
+        return 0;
+    }
+    return 1;
+}
+
+static int Mode_Replay(const char *a_Trace, const char *a_Baseline, const char *a_NewBaseline)
+{
+    Write_Type Writes[REPLAY_MAX_WRITES];
+    size_t Index = 0;
+    size_t Calls = 0;
+    size_t Arrivals = 0;
+    unsigned Count, Write;
+    struct timespec Start, Stop;
+    double Seconds;
+    char *Result;
+    size_t Size;
+    int Status = 0;
+
+    if(!Trace_Read(a_Trace))
+    {
+        return 1;
+    }
+
+    Sim_Reset();
+    clock_gettime(CLOCK_MONOTONIC, &Start);
+    while(Index < EventsCount)
+    {
+        const Event_Type *Event = &Events[Index++];
+
+        Sim_RunUntil(Event->Time);
+        switch(Event->Op)
+        {
+        case REPLAY_OP_ARRIVAL:
+            Sim_Arrive(Event->Target);
+            Arrivals++;
+            break;
+        case REPLAY_OP_COST:
+            Sim_Cost[Event->Target] = Event->Value;
+            break;
+        case REPLAY_OP_WRITE:
+            Divergences++; /* Recorded write the replayed call did not make */
+            break;
+        default:
+            Count = Driver_Call(Event, Writes);
+            Calls++;
+            for(Write = 0; Write < Count; Write++)
+            {
+                const Event_Type *Recorded = (Index < EventsCount) ? &Events[Index] : NULL;
+
+                if((Recorded != NULL) && (Recorded->Op == REPLAY_OP_WRITE) && (Recorded->Target == Writes[Write].Block) &&
+                   (Recorded->Offset == Writes[Write].Offset) && (Recorded->Value == Writes[Write].Value))
+                {
+                    Index++;
+                }
+                else
+                {
+                    Divergences++;
+                    fprintf(stderr, "cycle %llu: driver wrote %s word 0x%03X = 0x%08X, not in the trace\n",
+                            (unsigned long long)Event->Time, (Writes[Write].Block == REPLAY_BLOCK_NVIC) ? "nvic" : "scb",
+                            Writes[Write].Offset * 4u, Writes[Write].Value);
+                }
+            }
+            break;
+        }
+    }
+    Sim_RunUntil(REPLAY_FOREVER);
+    clock_gettime(CLOCK_MONOTONIC, &Stop);
+
+    Seconds = (double)(Stop.tv_sec - Start.tv_sec) + ((double)(Stop.tv_nsec - Start.tv_nsec) * 1e-9);
+    fprintf(stderr, "%zu records, %zu calls, %zu arrivals in %.3f s (%.2f M records/s)\n", EventsCount, Calls, Arrivals,
+            Seconds, (Seconds > 0.0) ? ((double)EventsCount / Seconds * 1e-6) : 0.0);
+    if(Divergences != 0)
+    {
+        fprintf(stderr, "%s: %lu register writes differ from the recording\n", a_Trace, Divergences);
+        Status = 2;
+    }
+
+    Result = Result_Format(&Size);
+    if(Result == NULL)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    if(a_NewBaseline != NULL)
+    {
+        FILE *File = fopen(a_NewBaseline, "w");
+
+        if((File == NULL) || (fwrite(Result, 1, Size, File) != Size) || (fclose(File) != 0))
+        {
+            perror(a_NewBaseline);
+            free(Result);
+            return 1;
+        }
+    }
+    if((a_Baseline != NULL) && !Result_Compare(Result, a_Baseline))
+    {
+        Status = 2;
+    }
+    if((a_Baseline == NULL) && (a_NewBaseline == NULL))
+    {
+        fputs(Result, stdout);
+    }
+    free(Result);
+    return Status;
+}
+
+int main(int argc, char **argv)
+{
+    const char *Baseline = NULL;
+    const char *NewBaseline = NULL;
+    const char *Path = NULL;
+    int Arg;
+
+    if((argc == 4) && (strcmp(argv[1], "record") == 0))
+    {
+        return Mode_Record(argv[2], argv[3]);
+    }
+    if((argc >= 3) && (strcmp(argv[1], "replay") == 0))
+    {
+        for(Arg = 2; Arg < argc; Arg++)
+        {
+            if((strcmp(argv[Arg], "--baseline") == 0) && (Arg + 1 < argc))
+            {
+                Baseline = argv[++Arg];
+            }
+            else if((strcmp(argv[Arg], "--write-baseline") == 0) && (Arg + 1 < argc))
+            {
+                NewBaseline = argv[++Arg];
+            }
+            else
+            {
+                Path = argv[Arg];
+            }
+        }
+        if(Path != NULL)
+        {
+            return Mode_Replay(Path, Baseline, NewBaseline);
+        }
+    }
+    fprintf(stderr, "usage: %s record <workload.txt> <trace.bin>\n"
+                    "       %s replay [--baseline File] [--write-baseline File] <trace.bin>\n", argv[0], argv[0]);
+    return 1;
+}
@@ -0,0 +1,242 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: irq_table.c
+ *
+ * Description: Listing and check of the vector table generated from NVIC_Driver/NVIC_IRQS.h.
+ *              The IRQ list is expanded here with the same NVIC_IRQ() macro as NVIC.h and the
+ *              startup file, so the listing is the layout the firmware is built with: one line
+ *              per vector from exception 16, reserved vectors included.
+ *
+ *              Checks : IRQ numbers in increasing order, unique names and handlers, the last
+ *                       IRQ matching NVIC_IRQ_COUNT and NVIC_EXCEPTIONS, and with --baseline the
+ *                       listing equal to a stored one, so an edit of the list that moves a vector
+ *                       is caught before it reaches the target.
+ *
+ *              Build : gcc -O2 -I../NVIC_Driver [-DPART_TM4C123GH6PM] -o irq_table irq_table.c
+ *                      the part is selected as in the firmware, DEVICE.h defaults to TM4C123GE6PM
+ *              Usage : irq_table [--baseline File] [--write-baseline File]
+ *
+ *              Exit status is 0 on success, 2 when a check fails or the listing differs from the
+ *              baseline, and 1 on input errors. "make check" compares the listing of every part
+ *              with data/irq_table_baseline.txt.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+/* Host definitions of the firmware types */
+#define STD_TYPES_H_
+#define FALSE                       (0u)
+#define TRUE                        (1u)
+#define NULL_PTR                    ((void*)0)
+typedef uint8_t                     uint8;
+typedef uint16_t                    uint16;
+typedef uint32_t                    uint32;
+typedef uint64_t                    uint64;
+typedef uint8                       boolean;
+
+#include "NVIC.h"
+
+#define LISTING_LINE_SIZE           128
+
+typedef struct
+{
+    unsigned Num;
+    const char *Name;
+    const char *Handler;
+    const char *Description;
+}Irq_EntryType;
+
+#define NVIC_IRQ(Num, Name, Handler, Description)   { (Num), #Name, #Handler, Description },
+static const Irq_EntryType Irq_Entries[] =
+{
+#include "NVIC_IRQS.h"
+};
+#undef NVIC_IRQ
+
+#define IRQ_ENTRIES                 (sizeof(Irq_Entries) / sizeof(Irq_Entries[0]))
+
+/* Consistency of the list itself, prints every problem found */
+static int Irq_Check(void)
+{
+    unsigned Failures = 0;
+    size_t Index;
+    size_t Other;
+
+    for(Index = 0; Index < IRQ_ENTRIES; Index++)
+    {
+        if((Index > 0) && (Irq_Entries[Index].Num <= Irq_Entries[Index - 1].Num))
+        {
+            fprintf(stderr, "IRQ %u (%s) is not after IRQ %u\n", Irq_Entries[Index].Num, Irq_Entries[Index].Name,
+                    Irq_Entries[Index - 1].Num);
+            Failures++;
+        }
+        for(Other = 0; Other < Index; Other++)
+        {
+            if(strcmp(Irq_Entries[Index].Name, Irq_Entries[Other].Name) == 0)
+            {
+                fprintf(stderr, "IRQ %u: name %s already used by IRQ %u\n", Irq_Entries[Index].Num,
+                        Irq_Entries[Index].Name, Irq_Entries[Other].Num);
+                Failures++;
+            }
+            if(strcmp(Irq_Entries[Index].Handler, Irq_Entries[Other].Handler) == 0)
+            {
+                fprintf(stderr, "IRQ %u: handler %s already used by IRQ %u\n", Irq_Entries[Index].Num,
+                        Irq_Entries[Index].Handler, Irq_Entries[Other].Num);
+                Failures++;
+            }
+        }
+    }
+    if((IRQ_ENTRIES == 0) || (Irq_Entries[IRQ_ENTRIES - 1].Num + 1 != NVIC_IRQ_COUNT) ||
+       (NVIC_EXCEPTIONS != NVIC_IRQ_EXCEPTION_BASE + NVIC_IRQ_COUNT))
+    {
+        fprintf(stderr, "NVIC_IRQ_COUNT %u does not follow the last IRQ of the list\n", (unsigned)NVIC_IRQ_COUNT);
+        Failures++;
+    }
+    return (Failures == 0) ? 1 : 0;
+}
+
+/* One line per vector from exception NVIC_IRQ_EXCEPTION_BASE, returns the listing in a malloc'ed buffer */
+static char *Irq_Listing(void)
+{
+    size_t Size = (size_t)NVIC_IRQ_COUNT * LISTING_LINE_SIZE + 1;
+    char *Text = malloc(Size);
+    size_t Length = 0;
+    size_t Index = 0;
+    unsigned Irq;
+
+    if(Text == NULL)
+    {
+        return NULL;
+    }
+    Text[0] = '\0';
+    for(Irq = 0; Irq < (unsigned)NVIC_IRQ_COUNT; Irq++)
+    {
+        if((Index < IRQ_ENTRIES) && (Irq_Entries[Index].Num == Irq))
+        {
+            Length += (size_t)snprintf(Text + Length, Size - Length, "%3u %3u %-16s %-22s %s\n",
+                                       NVIC_IRQ_EXCEPTION_BASE + Irq, Irq, Irq_Entries[Index].Name,
+                                       Irq_Entries[Index].Handler, Irq_Entries[Index].Description);
+            Index++;
+        }
+        else
+        {
+            Length += (size_t)snprintf(Text + Length, Size - Length, "%3u %3u reserved\n",
+                                       NVIC_IRQ_EXCEPTION_BASE + Irq, Irq);
+        }
+    }
+    return Text;
+}
+
+/* Prints the first differing line of each side, returns 1 when the texts are equal */
+static int Listing_Compare(const char *a_Listing, const char *a_Path)
+{
+    FILE *File = fopen(a_Path, "r");
+    const char *Cursor = a_Listing;
+    char Line[LISTING_LINE_SIZE * 2];
+    unsigned LineNumber = 0;
+
+    if(File == NULL)
+    {
+        perror(a_Path);
+        return -1;
+    }
+    while(fgets(Line, sizeof(Line), File) != NULL)
+    {
+        size_t Length = strlen(Line);
+
+        LineNumber++;
+        if(strncmp(Cursor, Line, Length) != 0)
+        {
+            const char *End = strchr(Cursor, '\n');
+            int Shown = (End != NULL) ? (int)(End - Cursor) : (int)strlen(Cursor);
+
+            fprintf(stderr, "%s:%u: baseline: %s", a_Path, LineNumber, Line);
+            fprintf(stderr, "%s:%u: list    : %.*s\n", a_Path, LineNumber, Shown, Cursor);
+            fclose(File);
+            return 0;
+        }
+        Cursor += Length;
+    }
+    fclose(File);
+    if(*Cursor != '\0')
+    {
+        fprintf(stderr, "%s: the list has more vectors than the baseline\n", a_Path);
+        return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    const char *Baseline = NULL;
+    const char *NewBaseline = NULL;
+    char *Listing;
+    int Status = 0;
+    int Equal;
+    int Arg;
+
+    for(Arg = 1; Arg < argc; Arg++)
+    {
+        if((strcmp(argv[Arg], "--baseline") == 0) && (Arg + 1 < argc))
+        {
+            Baseline = argv[++Arg];
+        }
+        else if((strcmp(argv[Arg], "--write-baseline") == 0) && (Arg + 1 < argc))
+        {
+            NewBaseline = argv[++Arg];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--baseline File] [--write-baseline File]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    Listing = Irq_Listing();
+    if(Listing == NULL)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    fputs(Listing, stdout);
+    fprintf(stderr, "%u IRQs, %u vectors\n", (unsigned)IRQ_ENTRIES, (unsigned)NVIC_EXCEPTIONS);
+
+    if(!Irq_Check())
+    {
+        Status = 2;
+    }
+    if(Baseline != NULL)
+    {
+        Equal = Listing_Compare(Listing, Baseline);
+        if(Equal < 0)
+        {
+            free(Listing);
+            return 1;
+        }
+        if(Equal == 0)
+        {
+            Status = 2;
+        }
+    }
+    if(NewBaseline != NULL)
+    {
+        FILE *File = fopen(NewBaseline, "w");
+
+        if((File == NULL) || (fputs(Listing, File) < 0) || (fclose(File) != 0))
+        {
+            perror(NewBaseline);
+            free(Listing);
+            return 1;
+        }
+    }
+    free(Listing);
+    return Status;
+}
@@ -0,0 +1,286 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: load_test.c
+ *
+ * Description: Host test of NVIC_Driver/LOAD.c on a simulated clock. The wall and idle time of
+ *              Power_GetIdleTime advance by one SysTick period per simulated tick with a given
+ *              busy share, then the tick hook Load_Tick runs as the SysTick handler would run it.
+ *              Handlers placed in a tick use the LOAD_ISR_ENTER and LOAD_ISR_EXIT hooks of the
+ *              driver, their durations are injected on the DWT cycle counter at the core clock.
+ *
+ *              Checks : 100 ms, 1 s and 10 s loads published when their window completes and
+ *                       equal to the mean of the windows below, peak 100 ms load, idle time over
+ *                       the period clamped, tick period of Load_Init, ISR time per exception
+ *                       converted from the time base to the core clock, nested handler time,
+ *                       exception with the most ISR time in the 1 s window, range checks.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : load_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+
+static uint32 Test_CycCnt;
+static uint32 Test_Demcr;
+static uint32 Test_DwtCtrl;
+
+#undef DWT_CYCCNT_REG
+#undef CORE_DEBUG_DEMCR_REG
+#undef DWT_CTRL_REG
+#define DWT_CYCCNT_REG              Test_CycCnt
+#define CORE_DEBUG_DEMCR_REG        Test_Demcr
+#define DWT_CTRL_REG                Test_DwtCtrl
+
+#include "LOAD.c"
+
+#define TEST_PERIOD                 (POWER_TIME_BASE_HZ / 1000u)   /* 1 ms SysTick period in time base cycles */
+
+static uint64 Test_Wall;
+static uint64 Test_Idle;
+static uint32 Test_CoreHz = 16000000;
+static SysTick_TickHookType Test_Hook;
+
+/*******************************************************************************
+ *                        Modules used by the driver                           *
+ *******************************************************************************/
+
+void Power_GetIdleTime(uint64 *a_WallCycles, uint64 *a_IdleCycles)
+{
+    *a_WallCycles = Test_Wall;
+    *a_IdleCycles = Test_Idle;
+}
+
+uint32 Clock_GetCoreClock(void)
+{
+    return Test_CoreHz;
+}
+
+void SysTick_RegisterTickHook(SysTick_TickHookType a_Hook)
+{
+    Test_Hook = a_Hook;
+}
+
+/*******************************************************************************
+ *                             Simulated clock                                 *
+ *******************************************************************************/
+
+/* One handler run of a_Cycles core cycles */
+static void Test_Isr(uint8 a_ExceptionNum, uint32 a_Cycles)
+{
+    LOAD_ISR_ENTER();
+
+    Test_CycCnt += a_Cycles;
+
+    LOAD_ISR_EXIT(a_ExceptionNum);
+}
+
+/* A handler of a_Cycles core cycles preempted by another one of a_NestedCycles in its middle */
+static void Test_NestedIsr(uint8 a_ExceptionNum, uint32 a_Cycles, uint8 a_NestedNum, uint32 a_NestedCycles)
+{
+    LOAD_ISR_ENTER();
+
+    Test_CycCnt += a_Cycles / 2;
+    Test_Isr(a_NestedNum, a_NestedCycles);
+    Test_CycCnt += a_Cycles - (a_Cycles / 2);
+
+    LOAD_ISR_EXIT(a_ExceptionNum);
+}
+
+/* a_Ticks SysTick periods busy for a_BusyPerMille of their time */
+static void Test_Run(uint32 a_Ticks, uint32 a_BusyPerMille)
+{
+    uint32 Tick;
+
+    for(Tick = 0; Tick < a_Ticks; Tick++)
+    {
+        Test_Wall += TEST_PERIOD;
+        Test_Idle += (TEST_PERIOD * (uint64)(LOAD_FULL_SCALE - a_BusyPerMille)) / LOAD_FULL_SCALE;
+        Test_Hook();
+    }
+}
+
+static void Test_Reset(uint16 a_TickMs)
+{
+    Test_Wall   = 123456789;    /* The measurement starts from the time at Load_Init */
+    Test_Idle   = 98765432;
+    Test_CycCnt = 0;
+    Test_Hook   = NULL;
+    memset((void *)Load_IsrRuns, 0, sizeof(Load_IsrRuns));
+    memset((void *)Load_IsrCycles, 0, sizeof(Load_IsrCycles));
+    memset((void *)Load_IsrLastCycles, 0, sizeof(Load_IsrLastCycles));
+    memset((void *)Load_IsrMaxCycles, 0, sizeof(Load_IsrMaxCycles));
+    Load_Init(a_TickMs);
+}
+
+/*******************************************************************************
+ *                                 Tests                                       *
+ *******************************************************************************/
+
+static void Test_Windows(void)
+{
+    Load_StatusType Status;
+    uint32 Window;
+
+    Test_Reset(1);
+    HOST_CHECK(Test_Hook == Load_Tick);
+    HOST_CHECK_EQUAL(Test_DwtCtrl & DWT_CYCCNTENA_MASK, DWT_CYCCNTENA_MASK);
+
+    /* Nothing published before the first window completes */
+    Test_Run(99, 300);
+    Load_GetStatus(&Status);
+    HOST_CHECK_EQUAL(Status.Windows, 0);
+    HOST_CHECK_EQUAL(Status.Load100ms, 0);
+    HOST_CHECK_EQUAL(Status.TopException, LOAD_NO_EXCEPTION);
+    Test_Run(1, 300);
+    Load_GetStatus(&Status);
+    HOST_CHECK_EQUAL(Status.Windows, 1);
+    HOST_CHECK_EQUAL(Status.Load100ms, 300);
+    HOST_CHECK_EQUAL(Status.Load1s, 0);
+
+    /* Ten 100 ms windows of 300, 100, 200 .. 900: the 1 s load is their mean */
+    for(Window = 1; Window < LOAD_WINDOW_RATIO; Window++)
+    {
+        Test_Run(100, Window * 100);
+        Load_GetStatus(&Status);
+        HOST_CHECK_EQUAL(Status.Load100ms, Window * 100);
+        HOST_CHECK_EQUAL(Status.Load1s, (Window < 9) ? 0 : ((300 + 4500) / 10));
+    }
+    HOST_CHECK_EQUAL(Status.PeakLoad100ms, 900);
+    HOST_CHECK_EQUAL(Status.Windows, 10);
+    HOST_CHECK_EQUAL(Status.Load10s, 0);
+
+    /* Nine more seconds at 50 %, a quiet 100 ms window lowers the 100 ms load but not the peak */
+    Test_Run(8900, 500);
+    Test_Run(100, 0);
+    Load_GetStatus(&Status);
+    HOST_CHECK_EQUAL(Status.Windows, 100);
+    HOST_CHECK_EQUAL(Status.Load100ms, 0);
+    HOST_CHECK_EQUAL(Status.PeakLoad100ms, 900);
+    HOST_CHECK_EQUAL(Status.Load1s, 450);
+    HOST_CHECK_EQUAL(Status.Load10s, (4800 + (89 * 500)) / 100);
+
+    /* A 10 ms tick: ten ticks per 100 ms window */
+    Test_Reset(10);
+    Test_Run(9, 1000);
+    Load_GetStatus(&Status);
+    HOST_CHECK_EQUAL(Status.Windows, 0);
+    Test_Run(1, 1000);
+    Load_GetStatus(&Status);
+    HOST_CHECK_EQUAL(Status.Windows, 1);
+    HOST_CHECK_EQUAL(Status.Load100ms, 1000);
+
+    /* Idle time over the period counts as a fully idle period */
+    Test_Reset(1);
+    Load_AccountTick(TEST_PERIOD, TEST_PERIOD * 2);
+    Test_Run(99, 1000);
+    Load_GetStatus(&Status);
+    HOST_CHECK_EQUAL(Status.Load100ms, 990);
+
+    /* Tick period out of range: the monitor keeps its configuration */
+    Test_Hook = NULL;
+    Load_Init(0);
+    Load_Init(LOAD_SHORT_WINDOW_MS + 1);
+    HOST_CHECK(Test_Hook == NULL);
+    HOST_CHECK_EQUAL(Load_WindowTicks, 100);
+    Load_GetStatus(NULL_PTR);
+}
+
+static void Test_IsrTime(void)
+{
+    const uint8 Gpio  = (uint8)(16 + NVIC_IRQ_GPIO_PORTF);
+    const uint8 Uart  = (uint8)(16 + NVIC_IRQ_UART0);
+    const uint8 Tick  = 15;
+    const uint32 CoreTick = Test_CoreHz / 1000;          /* Core cycles in a 1 ms period */
+    Load_StatusType Status;
+    Load_IsrStatsType Stats;
+    uint32 Ms;
+
+    /* 1 s: GPIO 10 % of every ms, UART 2 % of every other ms with a SysTick handler nested in it */
+    Test_Reset(1);
+    for(Ms = 0; Ms < 1000; Ms++)
+    {
+        Test_Isr(Gpio, CoreTick / 10);
+        if((Ms % 2) == 0)
+        {
+            Test_NestedIsr(Uart, (CoreTick * 4) / 100, Tick, 80);
+        }
+        Test_Run(1, 200);
+    }
+    Load_GetStatus(&Status);
+    HOST_CHECK_EQUAL(Status.Load1s, 200);
+    HOST_CHECK_EQUAL(Status.TopException, Gpio);
+    HOST_CHECK_EQUAL(Status.TopExceptionLoad, 100);
+
+    HOST_CHECK_EQUAL(Load_GetIsrStats(Gpio, &Stats), TRUE);
+    HOST_CHECK_EQUAL(Stats.Runs, 1000);
+    HOST_CHECK_EQUAL(Stats.Cycles, 1000 * (CoreTick / 10));
+    HOST_CHECK_EQUAL(Stats.MaxCycles, CoreTick / 10);
+    HOST_CHECK_EQUAL(Stats.Load, 100);
+
+    /* The time of a handler includes the handlers nested in it */
+    HOST_CHECK_EQUAL(Load_GetIsrStats(Uart, &Stats), TRUE);
+    HOST_CHECK_EQUAL(Stats.Runs, 500);
+    HOST_CHECK_EQUAL(Stats.MaxCycles, ((CoreTick * 4) / 100) + 80);
+    HOST_CHECK_EQUAL(Stats.Load, ((500 * (((CoreTick * 4) / 100) + 80)) * 1000ull) / (1000ull * CoreTick));
+    HOST_CHECK_EQUAL(Load_GetIsrStats(Tick, &Stats), TRUE);
+    HOST_CHECK_EQUAL(Stats.Runs, 500);
+    HOST_CHECK_EQUAL(Stats.Cycles, 500 * 80);
+
+    /* Next second: the UART takes over, the GPIO window is 0 but its runs and longest run stay */
+    for(Ms = 0; Ms < 1000; Ms++)
+    {
+        Test_Isr(Uart, (CoreTick * 3) / 10);
+        if(Ms == 500)
+        {
+            Test_Isr(Gpio, CoreTick / 2);
+        }
+        Test_Run(1, 300);
+    }
+    Load_GetStatus(&Status);
+    HOST_CHECK_EQUAL(Status.TopException, Uart);
+    HOST_CHECK_EQUAL(Status.TopExceptionLoad, 300);
+    HOST_CHECK_EQUAL(Load_GetIsrStats(Gpio, &Stats), TRUE);
+    HOST_CHECK_EQUAL(Stats.Runs, 1001);
+    HOST_CHECK_EQUAL(Stats.Cycles, CoreTick / 2);
+    HOST_CHECK_EQUAL(Stats.MaxCycles, CoreTick / 2);
+    HOST_CHECK_EQUAL(Stats.Load, 0);
+
+    /* A second without handlers */
+    Test_Run(1000, 0);
+    Load_GetStatus(&Status);
+    HOST_CHECK_EQUAL(Status.TopException, LOAD_NO_EXCEPTION);
+    HOST_CHECK_EQUAL(Status.TopExceptionLoad, 0);
+
+    /* At 80 MHz the same share of the period gives the same load */
+    Test_CoreHz = 80000000;
+    Test_Reset(1);
+    for(Ms = 0; Ms < 1000; Ms++)
+    {
+        Test_Isr(Gpio, (Test_CoreHz / 1000) / 4);
+        Test_Run(1, 250);
+    }
+    Load_GetStatus(&Status);
+    HOST_CHECK_EQUAL(Status.TopExceptionLoad, 250);
+    Test_CoreHz = 16000000;
+
+    /* Range checks */
+    Load_AccountIsr(LOAD_EXCEPTIONS, 100);
+    HOST_CHECK_EQUAL(Load_GetIsrStats(LOAD_EXCEPTIONS, &Stats), FALSE);
+    HOST_CHECK_EQUAL(Load_GetIsrStats(Gpio, NULL_PTR), FALSE);
+}
+
+int main(void)
+{
+    Test_Windows();
+    Test_IsrTime();
+
+    return Host_Report("load_test");
+}
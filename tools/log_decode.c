@@ -0,0 +1,239 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: log_decode.c
+ *
+ * Description: Host decoder of the tokenized log (NVIC_Driver/LOG.h).
+ *              Rebuilds the messages from the format table NVIC_Driver/LOG_FORMATS.h,
+ *              either from a dump of Log_Buffer or from the raw words drained by Log_Read
+ *              (UART stream, little endian).
+ *
+ *              Build : gcc -O2 -o log_decode log_decode.c
+ *              Usage : log_decode [--stream] [--tick-hz <Hz>] <file.bin>
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+/* Must match LOG.h */
+#define LOG_MAGIC                   0x31474F4Cu
+#define LOG_HEADER_SIZE             24u
+#define LOG_RECORD_TAG              0xA5u
+#define LOG_ID_BITS_POS             16
+#define LOG_ARGS_BITS_POS           8
+#define LOG_ARGS_MASK               0x0Fu
+#define LOG_MAX_ARGS                3u
+
+#define LOG_FORMAT(Id, Format)      Format,
+static const char *const Log_Formats[] =
+{
+#include "../NVIC_Driver/LOG_FORMATS.h"
+};
+#undef LOG_FORMAT
+
+#define LOG_FORMATS_COUNT           (sizeof(Log_Formats) / sizeof(Log_Formats[0]))
+
+static uint32_t Read32(const uint8_t *a_Bytes)
+{
+    return (uint32_t)a_Bytes[0] | ((uint32_t)a_Bytes[1] << 8) | ((uint32_t)a_Bytes[2] << 16) | ((uint32_t)a_Bytes[3] << 24);
+}
+
+/* printf the format with the raw argument words, each conversion consumes one word */
+static void Log_Print(const char *a_Format, const uint32_t *a_Args, uint32_t a_Count)
+{
+    char Spec[16];
+    uint32_t Arg = 0;
+    size_t Length;
+
+    while(*a_Format != '\0')
+    {
+        if(*a_Format != '%')
+        {
+            putchar(*a_Format++);
+            continue;
+        }
+        if(a_Format[1] == '%')
+        {
+            putchar('%');
+            a_Format += 2;
+            continue;
+        }
+        Length = strspn(a_Format + 1, "-+ #0123456789") + 2;
+        if(Length >= sizeof(Spec))
+        {
+            Length = sizeof(Spec) - 1;
+        }
+        memcpy(Spec, a_Format, Length);
+        Spec[Length] = '\0';
+        a_Format += Length;
+
+        if(Arg >= a_Count)
+        {
+            printf("<missing>");
+            continue;
+        }
+        switch(Spec[Length - 1])
+        {
+        case 'd' :
+        case 'i' : printf(Spec, (int)(int32_t)a_Args[Arg]); break;
+        case 'u' :
+        case 'x' :
+        case 'X' :
+        case 'c' : printf(Spec, (unsigned)a_Args[Arg]); break;
+        default  : printf("<bad %s>", Spec); break;
+        }
+        Arg++;
+    }
+    putchar('\n');
+}
+
+/* Decode a run of words, returns the number of records printed */
+static uint32_t Log_Decode(const uint8_t *a_Words, uint32_t a_First, uint32_t a_Count, uint32_t a_Mask, uint32_t a_TickHz)
+{
+    uint32_t Index = 0;
+    uint32_t Records = 0;
+    uint32_t Skipped = 0;
+
+    while(Index < a_Count)
+    {
+        uint32_t Header = Read32(a_Words + (((a_First + Index) & a_Mask) * 4u));
+        uint32_t Id     = Header >> LOG_ID_BITS_POS;
+        uint32_t Args   = (Header >> LOG_ARGS_BITS_POS) & LOG_ARGS_MASK;
+        uint32_t Values[LOG_MAX_ARGS];
+        uint32_t Tick;
+        uint32_t Arg;
+
+        /* A word that is not a record header, resynchronize on the next one */
+        if(((Header & 0xFFu) != LOG_RECORD_TAG) || (Args > LOG_MAX_ARGS) || ((Index + 2u + Args) > a_Count))
+        {
+            Index++;
+            Skipped++;
+            continue;
+        }
+        Tick = Read32(a_Words + (((a_First + Index + 1u) & a_Mask) * 4u));
+        for(Arg = 0; Arg < Args; Arg++)
+        {
+            Values[Arg] = Read32(a_Words + (((a_First + Index + 2u + Arg) & a_Mask) * 4u));
+        }
+        Index += 2u + Args;
+
+        if(a_TickHz != 0)
+        {
+            printf("%12.3f s  ", (double)Tick / (double)a_TickHz);
+        }
+        else
+        {
+            printf("%12u tick  ", (unsigned)Tick);
+        }
+        if(Id < LOG_FORMATS_COUNT)
+        {
+            Log_Print(Log_Formats[Id], Values, Args);
+        }
+        else
+        {
+            printf("<unknown id %u>\n", (unsigned)Id);
+        }
+        Records++;
+    }
+    if(Skipped != 0)
+    {
+        fprintf(stderr, "%u words skipped while resynchronizing\n", (unsigned)Skipped);
+    }
+    return Records;
+}
+
+int main(int argc, char **argv)
+{
+    int Stream = 0;
+    uint32_t TickHz = 0;
+    const char *Path = NULL;
+    FILE *File;
+    long Size;
+    uint8_t *Data;
+    int Arg;
+
+    for(Arg = 1; Arg < argc; Arg++)
+    {
+        if(strcmp(argv[Arg], "--stream") == 0)
+        {
+            Stream = 1;
+        }
+        else if((strcmp(argv[Arg], "--tick-hz") == 0) && ((Arg + 1) < argc))
+        {
+            TickHz = (uint32_t)strtoul(argv[++Arg], NULL, 0);
+        }
+        else
+        {
+            Path = argv[Arg];
+        }
+    }
+    if(Path == NULL)
+    {
+        fprintf(stderr, "usage: %s [--stream] [--tick-hz <Hz>] <file.bin>\n", argv[0]);
+        return 2;
+    }
+
+    File = fopen(Path, "rb");
+    if(File == NULL)
+    {
+        perror(Path);
+        return 1;
+    }
+    fseek(File, 0, SEEK_END);
+    Size = ftell(File);
+    fseek(File, 0, SEEK_SET);
+    Data = malloc((size_t)Size + 1u);
+    if((Data == NULL) || (fread(Data, 1, (size_t)Size, File) != (size_t)Size))
+    {
+        fprintf(stderr, "%s: read error\n", Path);
+        return 1;
+    }
+    fclose(File);
+
+    if(Stream)
+    {
+        Log_Decode(Data, 0, (uint32_t)Size / 4u, 0xFFFFFFFFu, TickHz);
+    }
+    else
+    {
+        uint32_t Capacity, WriteIndex, ReadIndex, Dropped, Pending;
+
+        if((Size < (long)LOG_HEADER_SIZE) || (Read32(Data) != LOG_MAGIC))
+        {
+            fprintf(stderr, "%s: not a log dump (bad magic)\n", Path);
+            return 1;
+        }
+        Capacity   = Read32(Data + 4);
+        WriteIndex = Read32(Data + 8);
+        ReadIndex  = Read32(Data + 12);
+        Dropped    = Read32(Data + 16);
+        if(TickHz == 0)
+        {
+            TickHz = Read32(Data + 20);
+        }
+        if((Capacity == 0) || (Capacity & (Capacity - 1u)) ||
+           ((uint64_t)Size < LOG_HEADER_SIZE + (uint64_t)Capacity * 4u))
+        {
+            fprintf(stderr, "%s: truncated dump\n", Path);
+            return 1;
+        }
+        /* The records not drained yet, from ReadIndex to WriteIndex */
+        Pending = WriteIndex - ReadIndex;
+        if(Pending > Capacity)
+        {
+            fprintf(stderr, "%s: inconsistent indexes\n", Path);
+            return 1;
+        }
+        printf("# %u words pending, %u records dropped, %u Hz ticks\n", (unsigned)Pending, (unsigned)Dropped, (unsigned)TickHz);
+        Log_Decode(Data + LOG_HEADER_SIZE, ReadIndex, Pending, Capacity - 1u, TickHz);
+    }
+
+    free(Data);
+    return 0;
+}
@@ -0,0 +1,429 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: log_test.c
+ *
+ * Description: Host test of NVIC_Driver/LOG.c and of the decoder tools/log_decode.c. The atomic
+ *              operations of ATOMIC.h are defined here: before and after each one, and at the time
+ *              stamp read, the test can run another Log_Write as an interrupt of higher priority
+ *              would, so every preemption point of a writer is played, nested on two levels.
+ *              The output of the decoder is captured in memory.
+ *
+ *              Checks : record words of LOG0 .. LOG3, whole records only drained by Log_Read,
+ *                       dump and stream decoding of the messages, full ring dropping and counting
+ *                       the new records without overwriting, indexes wrapping around the ring,
+ *                       records of preempting writers whole and published only once every
+ *                       preempted writer has filled its record, PRIMASK never set.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : log_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include <stdarg.h>
+#include <unistd.h>
+
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+
+#include "LOG.c"
+
+#define TEST_OUTPUT_SIZE            8192
+#define TEST_MAX_NESTING            2
+
+static uint32 Test_Tick;
+static uint32 Test_Step;
+static uint32 Test_PreemptAt[TEST_MAX_NESTING];
+static uint32 Test_Preemptions;
+static uint32 Test_PreemptCount;
+static uint32 Test_PrimaskSet;
+static char Test_Output[TEST_OUTPUT_SIZE];
+static size_t Test_OutputLength;
+
+/*******************************************************************************
+ *                                Decoder                                      *
+ *******************************************************************************/
+
+static int Test_Printf(const char *a_Format, ...)
+{
+    va_list Args;
+    int Length;
+
+    va_start(Args, a_Format);
+    Length = vsnprintf(Test_Output + Test_OutputLength, sizeof(Test_Output) - Test_OutputLength, a_Format, Args);
+    va_end(Args);
+    if(Length > 0)
+    {
+        Test_OutputLength += (size_t)Length;
+        if(Test_OutputLength >= sizeof(Test_Output))
+        {
+            Test_OutputLength = sizeof(Test_Output) - 1;
+        }
+    }
+    return Length;
+}
+
+static int Test_Putchar(int a_Char)
+{
+    return Test_Printf("%c", a_Char);
+}
+
+/* The decoder has its own copy of the record layout */
+#undef LOG_MAGIC
+#undef LOG_RECORD_TAG
+#undef LOG_ID_BITS_POS
+#undef LOG_ARGS_BITS_POS
+#undef LOG_ARGS_MASK
+#undef LOG_MAX_ARGS
+#define printf                      Test_Printf
+#define putchar                     Test_Putchar
+#define main                        Log_Decode_Main
+#include "log_decode.c"
+#undef main
+#undef putchar
+#undef printf
+
+/* Decode a dump of Log_Buffer with the decoder command line */
+static int Test_DecodeDump(void)
+{
+    char Path[] = "/tmp/log_testXXXXXX";
+    char *Argv[] = { "log_decode", Path, NULL };
+    int Descriptor = mkstemp(Path);
+    int Status;
+
+    Test_OutputLength = 0;
+    Test_Output[0]    = '\0';
+    if(Descriptor < 0)
+    {
+        HOST_CHECK(Descriptor >= 0);
+        return -1;
+    }
+    HOST_CHECK(write(Descriptor, (const void *)&Log_Buffer, sizeof(Log_Buffer)) == (ssize_t)sizeof(Log_Buffer));
+    close(Descriptor);
+    Status = Log_Decode_Main(2, Argv);
+    unlink(Path);
+    return Status;
+}
+
+/*******************************************************************************
+ *                        Modules used by the driver                           *
+ *******************************************************************************/
+
+static void Test_Preemption(void);
+
+/* A point where an interrupt can preempt the writer */
+static void Test_Point(void)
+{
+    if(Host_Primask != 0)
+    {
+        Test_PrimaskSet++;
+    }
+    Test_Step++;
+    if((Test_Preemptions < Test_PreemptCount) && (Test_Step == Test_PreemptAt[Test_Preemptions]))
+    {
+        Test_Preemptions++;
+        Test_Preemption();
+    }
+}
+
+uint32 Atomic_FetchAdd(volatile uint32 *a_Variable, uint32 a_Value)
+{
+    uint32 Previous;
+
+    Test_Point();
+    Previous    = *a_Variable;
+    *a_Variable = Previous + a_Value;
+    Test_Point();
+    return Previous;
+}
+
+boolean Atomic_CompareExchange(volatile uint32 *a_Variable, uint32 a_Expected, uint32 a_Desired)
+{
+    boolean Swapped = FALSE;
+
+    Test_Point();
+    if(*a_Variable == a_Expected)
+    {
+        *a_Variable = a_Desired;
+        Swapped     = TRUE;
+    }
+    Test_Point();
+    return Swapped;
+}
+
+uint32 SysTick_GetTickCount(void)
+{
+    Test_Point();
+    return Test_Tick;
+}
+
+/*******************************************************************************
+ *                                 Tests                                       *
+ *******************************************************************************/
+
+/* Records of Log_Read: header tag, number of arguments, TRUE if every record is whole */
+static boolean Test_Whole(const uint32 *a_Words, uint32 a_Count, uint32 *a_Records)
+{
+    uint32 Index = 0;
+    uint32 Args;
+
+    *a_Records = 0;
+    while(Index < a_Count)
+    {
+        Args = (a_Words[Index] >> LOG_ARGS_BITS_POS) & LOG_ARGS_MASK;
+        if(((a_Words[Index] & 0xFF) != LOG_RECORD_TAG) || (Args > LOG_MAX_ARGS))
+        {
+            return FALSE;
+        }
+        Index += LOG_RECORD_WORDS(Args);
+        (*a_Records)++;
+    }
+    return (Index == a_Count) ? TRUE : FALSE;
+}
+
+static void Test_Encoding(void)
+{
+    uint32 Words[LOG_BUFFER_WORDS];
+    uint16 Count;
+
+    HOST_CHECK_EQUAL(LOG_HEADER(LOG_ID_IRQ_THROTTLED, 2), 0x000202A5 | ((uint32)LOG_ID_IRQ_THROTTLED << 16));
+    HOST_CHECK_EQUAL(LOG_RECORD_WORDS(3), 5);
+
+    Log_Init(10);
+    HOST_CHECK_EQUAL(Log_Buffer.Header.Magic, LOG_MAGIC);
+    HOST_CHECK_EQUAL(Log_Buffer.Header.Capacity, LOG_BUFFER_WORDS);
+    HOST_CHECK_EQUAL(Log_Buffer.Header.TickHz, 100);
+
+    Test_Tick = 5;
+    HOST_CHECK_EQUAL(LOG0(LOG_ID_IRQ_RESUMED), TRUE);
+    HOST_CHECK_EQUAL(LOG1(LOG_ID_USER_VALUE, -5), TRUE);
+    HOST_CHECK_EQUAL(LOG2(LOG_ID_IRQ_THROTTLED, 21, 40), TRUE);
+    Test_Tick = 7;
+    HOST_CHECK_EQUAL(LOG3(LOG_ID_WATCHDOG_RESET, 1, 2, 15), TRUE);
+    HOST_CHECK_EQUAL(Log_Buffer.Header.WriteIndex, 2 + 3 + 4 + 5);
+
+    /* Whole records only: 10 words hold the first three records */
+    Count = Log_Read(Words, 10);
+    HOST_CHECK_EQUAL(Count, 9);
+    HOST_CHECK_EQUAL(Words[0], LOG_HEADER(LOG_ID_IRQ_RESUMED, 0));
+    HOST_CHECK_EQUAL(Words[1], 5);
+    HOST_CHECK_EQUAL(Words[2], LOG_HEADER(LOG_ID_USER_VALUE, 1));
+    HOST_CHECK_EQUAL(Words[4], (uint32)-5);
+    HOST_CHECK_EQUAL(Words[5], LOG_HEADER(LOG_ID_IRQ_THROTTLED, 2));
+    HOST_CHECK_EQUAL(Words[7], 21);
+    HOST_CHECK_EQUAL(Words[8], 40);
+    HOST_CHECK_EQUAL(Log_Buffer.Header.ReadIndex, 9);
+    Count = Log_Read(Words, 4);
+    HOST_CHECK_EQUAL(Count, 0);
+    Count = Log_Read(Words, LOG_BUFFER_WORDS);
+    HOST_CHECK_EQUAL(Count, 5);
+    HOST_CHECK_EQUAL(Words[0], LOG_HEADER(LOG_ID_WATCHDOG_RESET, 3));
+    HOST_CHECK_EQUAL(Words[1], 7);
+    HOST_CHECK_EQUAL(Words[4], 15);
+    HOST_CHECK_EQUAL(Log_Read(NULL_PTR, 4), 0);
+}
+
+static void Test_Decoding(void)
+{
+    uint32 Words[LOG_BUFFER_WORDS];
+    uint16 Count;
+
+    Log_Init(10);
+    Test_Tick = 5;
+    LOG1(LOG_ID_CLOCK_CHANGED, 80000000);
+    LOG1(LOG_ID_USER_VALUE, -5);
+    Test_Tick = 250;
+    LOG2(LOG_ID_MEM_FAULT, 0x82, 0x20000400);
+    LOG3(LOG_ID_WATCHDOG_RESET, 1, 2, 15);
+
+    /* The dump: the records from ReadIndex to WriteIndex, time stamps at the tick rate */
+    HOST_CHECK_EQUAL(Test_DecodeDump(), 0);
+    HOST_CHECK(strcmp(Test_Output,
+                      "# 15 words pending, 0 records dropped, 100 Hz ticks\n"
+                      "       0.050 s  core clock changed to 80000000 Hz\n"
+                      "       0.050 s  value -5\n"
+                      "       2.500 s  memory fault status 0x82 address 0x20000400\n"
+                      "       2.500 s  watchdog reset: client 1 fault 2 exception 15\n") == 0);
+
+    /* The stream of Log_Read, drained records are no longer in the dump */
+    Count = Log_Read(Words, 6);
+    HOST_CHECK_EQUAL(Count, 6);
+    Test_OutputLength = 0;
+    HOST_CHECK_EQUAL(Log_Decode((const uint8_t *)Words, 0, Count, 0xFFFFFFFFu, 0), 2);
+    HOST_CHECK(strcmp(Test_Output,
+                      "           5 tick  core clock changed to 80000000 Hz\n"
+                      "           5 tick  value -5\n") == 0);
+    HOST_CHECK_EQUAL(Test_DecodeDump(), 0);
+    HOST_CHECK(strncmp(Test_Output, "# 9 words pending, 0 records dropped", 36) == 0);
+    HOST_CHECK(strstr(Test_Output, "value -5") == NULL);
+}
+
+static void Test_Overflow(void)
+{
+    uint32 Words[LOG_BUFFER_WORDS];
+    uint32 Records;
+    uint32 Expected = 0;
+    uint32 Sequence;
+    uint32 Index;
+    uint16 Count;
+
+    Log_Init(1);
+
+    /* 51 records of 5 words leave one free word: a new record is dropped, whatever its size */
+    for(Sequence = 0; Sequence < 51; Sequence++)
+    {
+        HOST_CHECK_EQUAL(LOG3(LOG_ID_USER_VALUE, Sequence, 0, 0), TRUE);
+    }
+    HOST_CHECK_EQUAL(LOG0(LOG_ID_IRQ_RESUMED), FALSE);
+    HOST_CHECK_EQUAL(LOG3(LOG_ID_USER_VALUE, 999, 0, 0), FALSE);
+    HOST_CHECK_EQUAL(Log_Buffer.Header.Dropped, 2);
+    HOST_CHECK_EQUAL(Log_Buffer.Header.WriteIndex, 255);
+
+    /* Space drained by the reader is reused across the end of the ring */
+    Count = Log_Read(Words, 12);
+    HOST_CHECK_EQUAL(Count, 10);
+    HOST_CHECK_EQUAL(Words[2], 0);
+    HOST_CHECK_EQUAL(Words[7], 1);
+    HOST_CHECK_EQUAL(LOG3(LOG_ID_USER_VALUE, Sequence++, 0, 0), TRUE);
+    HOST_CHECK_EQUAL(LOG3(LOG_ID_USER_VALUE, Sequence++, 0, 0), TRUE);
+    HOST_CHECK_EQUAL(LOG0(LOG_ID_IRQ_RESUMED), FALSE);
+    HOST_CHECK_EQUAL(Log_Buffer.Header.Dropped, 3);
+    HOST_CHECK_EQUAL(Log_Buffer.Header.WriteIndex, 265);
+
+    /* The dump decodes across the end of the ring and reports the dropped records */
+    HOST_CHECK_EQUAL(Test_DecodeDump(), 0);
+    HOST_CHECK(strncmp(Test_Output, "# 255 words pending, 3 records dropped, 1000 Hz ticks\n", 54) == 0);
+    HOST_CHECK(strstr(Test_Output, "value 52\n") != NULL);
+    HOST_CHECK(strstr(Test_Output, "value 999") == NULL);
+
+    /* Nothing overwritten: every record after the two drained ones, in order */
+    Count = Log_Read(Words, LOG_BUFFER_WORDS);
+    HOST_CHECK_EQUAL(Count, 255);
+    HOST_CHECK_EQUAL(Test_Whole(Words, Count, &Records), TRUE);
+    HOST_CHECK_EQUAL(Records, 51);
+    Expected = 2;
+    for(Index = 0; Index < Count; Index += 5)
+    {
+        HOST_CHECK_EQUAL(Words[Index + 2], Expected);
+        Expected++;
+    }
+    HOST_CHECK_EQUAL(Log_Buffer.Header.ReadIndex, Log_Buffer.Header.WriteIndex);
+}
+
+/* Records published and not drained, left in the ring */
+static boolean Test_Published(uint32 *a_Records)
+{
+    uint32 Words[LOG_BUFFER_WORDS];
+    uint32 Index;
+    uint32 Count = Log_Buffer.Header.WriteIndex - Log_Buffer.Header.ReadIndex;
+
+    for(Index = 0; Index < Count; Index++)
+    {
+        Words[Index] = Log_Buffer.Words[(Log_Buffer.Header.ReadIndex + Index) & LOG_INDEX_MASK];
+    }
+    return Test_Whole(Words, Count, a_Records);
+}
+
+/* A writer of higher priority: its record is whole, it is not published while a preempted writer is filling its own */
+static void Test_Preemption(void)
+{
+    uint32 Written  = Log_Buffer.Header.WriteIndex;
+    uint32 Writers  = Log_Writers;
+    uint32 Records;
+
+    HOST_CHECK_EQUAL(LOG2(LOG_ID_IRQ_THROTTLED, Test_Preemptions, 0), TRUE);
+    if(Writers != 0)
+    {
+        HOST_CHECK_EQUAL(Log_Buffer.Header.WriteIndex, Written);
+    }
+    else
+    {
+        HOST_CHECK_EQUAL(Log_Buffer.Header.WriteIndex, Log_ReserveIndex);
+    }
+    HOST_CHECK_EQUAL(Test_Published(&Records), TRUE);
+}
+
+static void Test_Nesting(void)
+{
+    uint32 Words[LOG_BUFFER_WORDS];
+    uint32 Seen[TEST_MAX_NESTING + 1];
+    uint32 Points;
+    uint32 First;
+    uint32 Second;
+    uint32 Records;
+    uint32 Index;
+    uint32 Runs = 0;
+    uint32 Preempted = 0;
+    uint16 Count;
+
+    /* Preemption points of one writer that is not preempted */
+    Log_Init(1);
+    Test_Step         = 0;
+    Test_PreemptCount = 0;
+    LOG1(LOG_ID_USER_VALUE, 0);
+    Points = Test_Step;
+    HOST_CHECK(Points >= 8);
+
+    for(First = 1; First <= Points; First++)
+    {
+        for(Second = First; Second <= (First + Points + Points); Second++)
+        {
+            Test_PreemptCount = 0;
+            Log_Init(1);
+            LOG1(LOG_ID_USER_VALUE, 0);         /* Already published, not drained */
+            Test_Step         = 0;
+            Test_Preemptions  = 0;
+            Test_PrimaskSet   = 0;
+            Test_PreemptAt[0] = First;
+            Test_PreemptAt[1] = Second;         /* Same point: a single preemption */
+            Test_PreemptCount = (Second == First) ? 1 : 2;
+
+            HOST_CHECK_EQUAL(LOG1(LOG_ID_USER_VALUE, 100), TRUE);
+            HOST_CHECK_EQUAL(Test_PrimaskSet, 0);
+
+            /* Every record published, whole, once */
+            HOST_CHECK_EQUAL(Log_Writers, 0);
+            HOST_CHECK_EQUAL(Log_Buffer.Header.WriteIndex, Log_ReserveIndex);
+            Count = Log_Read(Words, LOG_BUFFER_WORDS);
+            HOST_CHECK_EQUAL(Test_Whole(Words, Count, &Records), TRUE);
+            memset(Seen, 0, sizeof(Seen));
+            for(Index = 0; Index < Count; Index += LOG_RECORD_WORDS((Words[Index] >> LOG_ARGS_BITS_POS) & LOG_ARGS_MASK))
+            {
+                if((Words[Index] >> LOG_ID_BITS_POS) == LOG_ID_IRQ_THROTTLED)
+                {
+                    Seen[Words[Index + 2]]++;
+                }
+                else if(Words[Index + 2] == 100)
+                {
+                    Seen[0]++;
+                }
+            }
+            HOST_CHECK_EQUAL(Records, 2 + Test_Preemptions);
+            HOST_CHECK_EQUAL(Seen[0], 1);
+            for(Index = 1; Index <= Test_Preemptions; Index++)
+            {
+                HOST_CHECK_EQUAL(Seen[Index], 1);
+            }
+            Runs++;
+            Preempted += (Test_Preemptions == Test_PreemptCount) ? 1 : 0;
+        }
+    }
+    printf("preemptions played: %u runs over %u points of a writer, %u with every preemption taken\n", Runs, Points, Preempted);
+    HOST_CHECK(Preempted > Points);
+    Test_PreemptCount = 0;
+}
+
+int main(void)
+{
+    Test_Encoding();
+    Test_Decoding();
+    Test_Overflow();
+    Test_Nesting();
+
+    return Host_Report("log_test");
+}
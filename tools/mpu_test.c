@@ -0,0 +1,418 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: mpu_test.c
+ *
+ * Description: Host test of NVIC_Driver/MPU.c. The MPU registers are a model in host memory: the
+ *              driver writes a register image, each access through MPU_REGS first applies the
+ *              write of the previous access to the eight regions, with the ARMv7-M rules of the
+ *              region number register and of the BASE/ATTR aliases. Each access costs
+ *              TEST_ACCESS_CYCLES on the DWT cycle counter.
+ *
+ *              The access resolution of the model follows the architecture: the highest numbered
+ *              enabled region that holds the address and whose sub-region is not disabled gives
+ *              the attributes, the default memory map applies outside every region.
+ *
+ *              Checks : BASE and ATTR values of valid regions, size, alignment and sub-region
+ *                       rejections, static regions programmed with the MPU disabled, later table
+ *                       entries and task regions winning where regions overlap, disabled
+ *                       sub-regions falling through to the regions below, task reload in eight
+ *                       alias stores without a region number write, reload cost statistics.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : mpu_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+
+static uint32 Test_CycCnt;
+
+static volatile MPU_RegType *Test_Mpu(void);
+
+#undef MPU_REGS
+#undef DWT_CYCCNT_REG
+#define MPU_REGS                    (Test_Mpu())
+#define DWT_CYCCNT_REG              Test_CycCnt
+
+#include "MPU.c"
+
+#define TEST_ACCESS_CYCLES          2u
+#define TEST_UNWRITTEN              0xA5A5A5A5u /* Image value of a register not written since the last access */
+#define TEST_DEFAULT_MAP            (-1)
+
+/* Register image written by the driver, and the state of the MPU */
+static MPU_RegType Test_Image;
+static uint32 Test_Ctrl;
+static uint32 Test_Number;
+static uint32 Test_Base[MPU_REGIONS];
+static uint32 Test_Attr[MPU_REGIONS];
+static uint32 Test_Stores;
+static uint32 Test_NumberWrites;
+static uint32 Test_RegionWritesEnabled;     /* Region writes while the MPU was enabled */
+static uint32 Test_MemFaultEnables;
+
+/*******************************************************************************
+ *                        Modules used by the driver                           *
+ *******************************************************************************/
+
+void NVIC_EnableException(NVIC_ExceptionType Exception_Num)
+{
+    if(Exception_Num == EXCEPTION_MEM_FAULT_TYPE)
+    {
+        Test_MemFaultEnables++;
+    }
+}
+
+/*******************************************************************************
+ *                                MPU model                                    *
+ *******************************************************************************/
+
+static void Test_ImageClear(void)
+{
+    uint32 *Word = (uint32 *)&Test_Image;
+    uint32 Index;
+
+    for(Index = 0; Index < (sizeof(Test_Image) / sizeof(uint32)); Index++)
+    {
+        Word[Index] = TEST_UNWRITTEN;
+    }
+}
+
+static void Test_RegionWrite(void)
+{
+    Test_Stores++;
+    if(0 != (Test_Ctrl & MPU_CTRL_ENABLE_MASK))
+    {
+        Test_RegionWritesEnabled++;
+    }
+}
+
+/* Apply the write of the previous access: the driver makes one access per MPU_REGS expression */
+static void Test_MpuApply(void)
+{
+    uint32 Alias;
+    uint32 Value;
+
+    if(Test_Image.CTRL != TEST_UNWRITTEN)
+    {
+        Test_Ctrl = Test_Image.CTRL;
+    }
+    if(Test_Image.NUMBER != TEST_UNWRITTEN)
+    {
+        Test_Number = Test_Image.NUMBER & (MPU_REGIONS - 1);
+        Test_NumberWrites++;
+    }
+    for(Alias = 0; Alias < 4; Alias++)
+    {
+        Value = Test_Image.REGION[Alias].BASE;
+        if(Value != TEST_UNWRITTEN)
+        {
+            if(0 != (Value & MPU_BASE_VALID_MASK))
+            {
+                Test_Number = Value & MPU_BASE_REGION_MASK & (MPU_REGIONS - 1);
+            }
+            Test_Base[Test_Number] = Value & ~0x1Fu;
+            Test_RegionWrite();
+        }
+        Value = Test_Image.REGION[Alias].ATTR;
+        if(Value != TEST_UNWRITTEN)
+        {
+            Test_Attr[Test_Number] = Value;
+            Test_RegionWrite();
+        }
+    }
+    Test_ImageClear();
+}
+
+static volatile MPU_RegType *Test_Mpu(void)
+{
+    Test_MpuApply();
+    Test_CycCnt += TEST_ACCESS_CYCLES;
+    return &Test_Image;
+}
+
+/* Region that gives the attributes of an access, TEST_DEFAULT_MAP outside every region */
+static int Test_RegionAt(uint32 a_Address)
+{
+    uint32 Size;
+    uint32 SubRegion;
+    int Number;
+
+    Test_MpuApply();
+    for(Number = MPU_REGIONS - 1; Number >= 0; Number--)
+    {
+        if(0 == (Test_Attr[Number] & MPU_ATTR_ENABLE_MASK))
+        {
+            continue;
+        }
+        Size = 1u << (((Test_Attr[Number] & MPU_ATTR_SIZE_MASK) >> MPU_ATTR_SIZE_BITS_POS) + 1);
+        if((a_Address - Test_Base[Number]) >= Size)
+        {
+            continue;
+        }
+        SubRegion = (a_Address - Test_Base[Number]) / (Size / 8);
+        if((Size >= MPU_MIN_SUBREGION_SIZE) && (0 != (Test_Attr[Number] & MPU_ATTR_SRD(1u << SubRegion))))
+        {
+            continue;
+        }
+        return Number;
+    }
+    return TEST_DEFAULT_MAP;
+}
+
+static void Test_Reset(void)
+{
+    Test_ImageClear();
+    Test_Ctrl                = 0;
+    Test_Number              = 0;
+    memset(Test_Base, 0, sizeof(Test_Base));
+    memset(Test_Attr, 0, sizeof(Test_Attr));
+    Test_Stores              = 0;
+    Test_NumberWrites        = 0;
+    Test_RegionWritesEnabled = 0;
+    Test_MemFaultEnables     = 0;
+    memset(&Mpu_Stats, 0, sizeof(Mpu_Stats));
+}
+
+/*******************************************************************************
+ *                                 Tests                                       *
+ *******************************************************************************/
+
+#define TEST_FLASH                  (MPU_ATTR_AP_READ_ONLY | MPU_ATTR_MEM_FLASH)
+#define TEST_SRAM                   (MPU_ATTR_XN | MPU_ATTR_AP_FULL_ACCESS | MPU_ATTR_MEM_SRAM)
+#define TEST_GUARD                  (MPU_ATTR_XN | MPU_ATTR_AP_NO_ACCESS | MPU_ATTR_MEM_SRAM)
+#define TEST_PERIPHERAL             (MPU_ATTR_XN | MPU_ATTR_AP_PRIV_RW | MPU_ATTR_MEM_PERIPHERAL)
+
+static const Mpu_RegionConfigType Test_StaticRegions[] =
+{
+    { 0x00000000, 0x00040000, TEST_FLASH      },    /* 256 KB flash */
+    { 0x20000000, 0x00008000, TEST_SRAM       },    /* 32 KB SRAM */
+    { 0x20000400, 0x00000400, TEST_GUARD      },    /* 1 KB guard inside the SRAM, wins over it */
+    { 0x40000000, 0x20000000, TEST_PERIPHERAL },    /* 512 MB peripherals */
+};
+
+static const Mpu_ConfigType Test_Config = { Test_StaticRegions, 4 };
+
+static void Test_Encode(void)
+{
+    Mpu_RegionConfigType Region;
+    MPU_RegionRegType Encoded;
+
+    /* Size field is log2(Size) - 1, VALID and the region number in BASE, enabled */
+    Region.BaseAddress = 0x20000000;
+    Region.Size        = 0x8000;
+    Region.Attributes  = TEST_SRAM;
+    HOST_CHECK_EQUAL(Mpu_EncodeRegion(&Region, 3, &Encoded), TRUE);
+    HOST_CHECK_EQUAL(Encoded.BASE, 0x20000000 | MPU_BASE_VALID_MASK | 3);
+    HOST_CHECK_EQUAL(Encoded.ATTR, TEST_SRAM | (14 << MPU_ATTR_SIZE_BITS_POS) | MPU_ATTR_ENABLE_MASK);
+
+    /* Smallest and largest sizes */
+    Region.BaseAddress = 0x20000020;
+    Region.Size        = MPU_MIN_REGION_SIZE;
+    HOST_CHECK_EQUAL(Mpu_EncodeRegion(&Region, 7, &Encoded), TRUE);
+    HOST_CHECK_EQUAL(Encoded.BASE, 0x20000020 | MPU_BASE_VALID_MASK | 7);
+    HOST_CHECK_EQUAL((Encoded.ATTR & MPU_ATTR_SIZE_MASK) >> MPU_ATTR_SIZE_BITS_POS, 4);
+    Region.BaseAddress = 0x80000000;
+    Region.Size        = 0x80000000;
+    HOST_CHECK_EQUAL(Mpu_EncodeRegion(&Region, 0, &Encoded), TRUE);
+    HOST_CHECK_EQUAL((Encoded.ATTR & MPU_ATTR_SIZE_MASK) >> MPU_ATTR_SIZE_BITS_POS, 30);
+
+    /* Size and enable bits of the attributes are the driver's, sub-regions are kept */
+    Region.BaseAddress = 0x20001000;
+    Region.Size        = 0x800;
+    Region.Attributes  = TEST_SRAM | MPU_ATTR_SRD(0x81) | MPU_ATTR_SIZE_MASK;
+    HOST_CHECK_EQUAL(Mpu_EncodeRegion(&Region, 4, &Encoded), TRUE);
+    HOST_CHECK_EQUAL(Encoded.ATTR, TEST_SRAM | MPU_ATTR_SRD(0x81) | (10 << MPU_ATTR_SIZE_BITS_POS) | MPU_ATTR_ENABLE_MASK);
+
+    /* Rejections: size under 32 bytes or not a power of 2, base not aligned to the size, sub-regions
+       of a region under 256 bytes, region number, missing arguments */
+    Region.BaseAddress = 0x20000000;
+    Region.Attributes  = TEST_SRAM;
+    Region.Size        = 16;
+    HOST_CHECK_EQUAL(Mpu_EncodeRegion(&Region, 0, &Encoded), FALSE);
+    Region.Size        = 0;
+    HOST_CHECK_EQUAL(Mpu_EncodeRegion(&Region, 0, &Encoded), FALSE);
+    Region.Size        = 0x3000;
+    HOST_CHECK_EQUAL(Mpu_EncodeRegion(&Region, 0, &Encoded), FALSE);
+    Region.BaseAddress = 0x20000200;
+    Region.Size        = 0x400;
+    HOST_CHECK_EQUAL(Mpu_EncodeRegion(&Region, 0, &Encoded), FALSE);
+    Region.BaseAddress = 0x20000000;
+    Region.Size        = 128;
+    Region.Attributes  = TEST_SRAM | MPU_ATTR_SRD(0x01);
+    HOST_CHECK_EQUAL(Mpu_EncodeRegion(&Region, 0, &Encoded), FALSE);
+    Region.Size        = MPU_MIN_SUBREGION_SIZE;
+    HOST_CHECK_EQUAL(Mpu_EncodeRegion(&Region, 0, &Encoded), TRUE);
+    HOST_CHECK_EQUAL(Mpu_EncodeRegion(&Region, MPU_REGIONS, &Encoded), FALSE);
+    HOST_CHECK_EQUAL(Mpu_EncodeRegion(NULL_PTR, 0, &Encoded), FALSE);
+    HOST_CHECK_EQUAL(Mpu_EncodeRegion(&Region, 0, NULL_PTR), FALSE);
+}
+
+static void Test_Init(void)
+{
+    static const Mpu_RegionConfigType Misaligned[] =
+    {
+        { 0x00000000, 0x00040000, TEST_FLASH },
+        { 0x20000100, 0x00000400, TEST_SRAM  },
+    };
+    Mpu_ConfigType Config = { Misaligned, 2 };
+    uint8 Number;
+
+    Test_Reset();
+    HOST_CHECK_EQUAL(Mpu_Init(&Test_Config), TRUE);
+    HOST_CHECK_EQUAL(Test_RegionAt(0), 0);
+    HOST_CHECK_EQUAL(Test_Ctrl, MPU_CTRL_PRIVDEFENA_MASK | MPU_CTRL_ENABLE_MASK);
+    HOST_CHECK_EQUAL(Test_RegionWritesEnabled, 0);
+    HOST_CHECK_EQUAL(Test_MemFaultEnables, 1);
+    for(Number = 0; Number < MPU_REGIONS; Number++)
+    {
+        if(Number < 4)
+        {
+            HOST_CHECK_EQUAL(Test_Base[Number], Test_StaticRegions[Number].BaseAddress);
+            HOST_CHECK_EQUAL(Test_Attr[Number] & ~(MPU_ATTR_SIZE_MASK | MPU_ATTR_ENABLE_MASK),
+                             Test_StaticRegions[Number].Attributes);
+            HOST_CHECK(0 != (Test_Attr[Number] & MPU_ATTR_ENABLE_MASK));
+        }
+        else
+        {
+            HOST_CHECK_EQUAL(Test_Attr[Number], 0);
+        }
+    }
+
+    /* A region that breaks the rules: nothing is written, the MPU stays as it was */
+    Test_Reset();
+    HOST_CHECK_EQUAL(Mpu_Init(&Config), FALSE);
+    HOST_CHECK_EQUAL(Test_RegionAt(0), TEST_DEFAULT_MAP);
+    HOST_CHECK_EQUAL(Test_Stores, 0);
+    HOST_CHECK_EQUAL(Test_Ctrl, 0);
+    HOST_CHECK_EQUAL(Test_MemFaultEnables, 0);
+
+    /* More regions than the static ones */
+    Config.Regions      = Test_StaticRegions;
+    Config.RegionsCount = MPU_STATIC_REGIONS + 1;
+    HOST_CHECK_EQUAL(Mpu_Init(&Config), FALSE);
+    HOST_CHECK_EQUAL(Mpu_Init(NULL_PTR), FALSE);
+    HOST_CHECK_EQUAL(Test_Stores, 0);
+}
+
+static void Test_Overlap(void)
+{
+    static const Mpu_RegionConfigType Task[] =
+    {
+        { 0x20000400, 0x00000100, TEST_SRAM                      },  /* Opens 256 bytes of the guard */
+        { 0x20001000, 0x00000800, TEST_SRAM | MPU_ATTR_SRD(0x02) },  /* Second 256 bytes disabled */
+        { 0x20001100, 0x00000020, TEST_GUARD                     },  /* Inside the disabled sub-region */
+    };
+    Mpu_TaskRegionsType TaskRegions;
+
+    Test_Reset();
+    HOST_CHECK_EQUAL(Mpu_Init(&Test_Config), TRUE);
+
+    /* Static regions: the later entry wins, the default map outside every region */
+    HOST_CHECK_EQUAL(Test_RegionAt(0x00001000), 0);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x20000000), 1);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x200003FC), 1);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x20000400), 2);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x200007FC), 2);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x20000800), 1);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x20008000), TEST_DEFAULT_MAP);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x4000C000), 3);
+    HOST_CHECK_EQUAL(Test_RegionAt(0xE000E100), TEST_DEFAULT_MAP);
+
+    /* Task regions win over every static region */
+    HOST_CHECK_EQUAL(Mpu_BuildTaskRegions(Task, 3, &TaskRegions), TRUE);
+    Mpu_LoadTaskRegions(&TaskRegions);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x20000400), MPU_STATIC_REGIONS + 0);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x200004FC), MPU_STATIC_REGIONS + 0);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x20000500), 2);
+
+    /* A disabled sub-region falls through to the regions below it */
+    HOST_CHECK_EQUAL(Test_RegionAt(0x20001000), MPU_STATIC_REGIONS + 1);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x20001120), 1);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x20001100), MPU_STATIC_REGIONS + 2);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x20001200), MPU_STATIC_REGIONS + 1);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x200017FC), MPU_STATIC_REGIONS + 1);
+
+    /* No task regions: back to the static ones */
+    Mpu_LoadTaskRegions(NULL_PTR);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x20000400), 2);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x20001000), 1);
+    HOST_CHECK_EQUAL(Test_Attr[MPU_STATIC_REGIONS + 3], 0);
+}
+
+static void Test_Reload(void)
+{
+    static const Mpu_RegionConfigType TaskA[] =
+    {
+        { 0x20002000, 0x00001000, TEST_SRAM },
+        { 0x20003000, 0x00000100, TEST_SRAM },
+    };
+    static const Mpu_RegionConfigType TaskB[] =
+    {
+        { 0x20004000, 0x00000400, TEST_SRAM },
+        { 0x20004400, 0x00000400, TEST_SRAM },
+        { 0x20004800, 0x00000400, TEST_SRAM },
+        { 0x20004C00, 0x00000400, TEST_SRAM },
+    };
+    static const Mpu_RegionConfigType TooMany[MPU_TASK_REGIONS + 1];
+    Mpu_TaskRegionsType RegionsA;
+    Mpu_TaskRegionsType RegionsB;
+    Mpu_StatsType Stats;
+    uint8 Index;
+
+    Test_Reset();
+    HOST_CHECK_EQUAL(Mpu_Init(&Test_Config), TRUE);
+    HOST_CHECK_EQUAL(Mpu_BuildTaskRegions(TaskA, 2, &RegionsA), TRUE);
+    HOST_CHECK_EQUAL(Mpu_BuildTaskRegions(TaskB, 4, &RegionsB), TRUE);
+    HOST_CHECK_EQUAL(RegionsA.Region[2].BASE, MPU_BASE_VALID_MASK | (MPU_STATIC_REGIONS + 2));
+    HOST_CHECK_EQUAL(RegionsA.Region[2].ATTR, 0);
+    HOST_CHECK_EQUAL(RegionsA.Region[3].ATTR, 0);
+
+    /* Task B then task A: the regions of B that A does not use are disabled */
+    Mpu_LoadTaskRegions(&RegionsB);
+    Test_MpuApply();
+    Test_Stores       = 0;
+    Test_NumberWrites = 0;
+    Mpu_LoadTaskRegions(&RegionsA);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x20002000), MPU_STATIC_REGIONS + 0);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x20003000), MPU_STATIC_REGIONS + 1);
+    HOST_CHECK_EQUAL(Test_RegionAt(0x20004800), 1);
+    HOST_CHECK_EQUAL(Test_Stores, 2 * MPU_TASK_REGIONS);
+    HOST_CHECK_EQUAL(Test_NumberWrites, 0);
+    for(Index = 0; Index < MPU_STATIC_REGIONS; Index++)
+    {
+        HOST_CHECK_EQUAL(Test_Base[Index], Test_StaticRegions[Index].BaseAddress);
+    }
+
+    /* One access per alias register */
+    Mpu_GetStats(&Stats);
+    HOST_CHECK_EQUAL(Stats.Reloads, 2);
+    HOST_CHECK_EQUAL(Stats.LastReloadCycles, 2 * MPU_TASK_REGIONS * TEST_ACCESS_CYCLES);
+    HOST_CHECK_EQUAL(Stats.MaxReloadCycles, 2 * MPU_TASK_REGIONS * TEST_ACCESS_CYCLES);
+    printf("task regions reload: %u stores, %u cycles at %u cycles per access\n", Test_Stores,
+           Stats.LastReloadCycles, TEST_ACCESS_CYCLES);
+
+    /* Build errors */
+    HOST_CHECK_EQUAL(Mpu_BuildTaskRegions(TooMany, MPU_TASK_REGIONS + 1, &RegionsA), FALSE);
+    HOST_CHECK_EQUAL(Mpu_BuildTaskRegions(NULL_PTR, 1, &RegionsA), FALSE);
+    HOST_CHECK_EQUAL(Mpu_BuildTaskRegions(TaskA, 2, NULL_PTR), FALSE);
+    HOST_CHECK_EQUAL(Mpu_BuildTaskRegions(NULL_PTR, 0, &RegionsA), TRUE);
+    HOST_CHECK_EQUAL(RegionsA.Region[0].ATTR, 0);
+}
+
+int main(void)
+{
+    Test_Encode();
+    Test_Init();
+    Test_Overlap();
+    Test_Reload();
+
+    return Host_Report("mpu_test");
+}
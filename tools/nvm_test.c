@@ -0,0 +1,465 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: nvm_test.c
+ *
+ * Description: Host test of NVIC_Driver/NVM.c on a simulated flash. The store region is an array
+ *              in host memory and the flash controller is modelled behind FMC and FMC2: an erase
+ *              sets a 1 KB block to ones, a buffered program clears bits only (flash can not set
+ *              a bit back to 1). A power cut can be injected at any erase or program: the
+ *              operation is left half done (half of the block erased, half of the buffer
+ *              programmed), the test then restarts from Nvm_Init like the target after reset.
+ *
+ *              Checks : format of a blank region, write / read / overwrite against a reference
+ *                       copy, compaction and erase levelling over many writes, the store full
+ *                       failure that leaves the next sector and the index untouched, a power cut
+ *                       at every flash operation of a plain write and of a compaction, fault log
+ *                       order, no program over non erased bits.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : nvm_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include <setjmp.h>
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+#include "NVM.h"
+
+#define TEST_FLASH_WORDS            (NVM_SECTORS * NVM_SECTOR_WORDS)
+
+static uint32 Test_Flash[TEST_FLASH_WORDS] __attribute__((aligned(NVM_SECTOR_SIZE)));
+static uint32 Test_Fma;
+static uint32 Test_FmcReg;
+static uint32 Test_Fmc2Reg;
+static uint32 Test_Fwb[NVM_FWB_WORDS];
+static uint32 Test_BootCfg;
+
+static volatile uint32 *Test_Fmc(void);
+static volatile uint32 *Test_Fmc2(void);
+
+#undef NVM_BASE_ADDRESS
+#undef FLASH_FMA_REG
+#undef FLASH_FMC_REG
+#undef FLASH_FMC2_REG
+#undef FLASH_FWBN_REG
+#undef FLASH_BOOTCFG_REG
+#define NVM_BASE_ADDRESS            HOST_ADDRESS(Test_Flash)
+#define FLASH_FMA_REG               Test_Fma
+#define FLASH_FMC_REG               (*Test_Fmc())
+#define FLASH_FMC2_REG              (*Test_Fmc2())
+#define FLASH_FWBN_REG              Test_Fwb[0]
+#define FLASH_BOOTCFG_REG           Test_BootCfg
+
+#include "NVM.c"
+
+#define TEST_KEYS                   8
+#define TEST_NEVER                  0xFFFFFFFFu
+
+static uint32 Test_Operations;                  /* Erases and buffered programs so far */
+static uint32 Test_Erases;
+static uint32 Test_CutAt = TEST_NEVER;          /* Operation interrupted by the power cut */
+static uint32 Test_BadPrograms;                 /* Programs of a 1 over a 0 */
+static jmp_buf Test_Reset;
+
+/* Reference copy of the store */
+static uint32 Test_Values[TEST_KEYS][NVM_MAX_RECORD_WORDS];
+static uint8 Test_Words[TEST_KEYS];
+static boolean Test_Present[TEST_KEYS];
+
+/*******************************************************************************
+ *                             Flash model                                     *
+ *******************************************************************************/
+
+static uint32 Test_WordIndex(uint32 a_Address)
+{
+    if((a_Address < NVM_BASE_ADDRESS) || (a_Address >= (NVM_BASE_ADDRESS + sizeof(Test_Flash))))
+    {
+        fprintf(stderr, "flash operation outside the store at 0x%08X\n", a_Address);
+        exit(2);
+    }
+    return (a_Address - NVM_BASE_ADDRESS) / 4;
+}
+
+/* Count the operation, a power cut leaves it half done and restarts the test from reset */
+static void Test_Operation(uint32 a_First, uint32 a_Words, const uint32 *a_Data)
+{
+    boolean Cut = (++Test_Operations == Test_CutAt);
+    uint32 Words = Cut ? (a_Words / 2) : a_Words;
+    uint32 Index;
+
+    for(Index = 0; Index < Words; Index++)
+    {
+        uint32 Word  = Cut && (a_Data == NULL) ? (a_First + a_Words - 1 - Index) : (a_First + Index);
+        uint32 Value = (a_Data == NULL) ? NVM_ERASED_WORD : a_Data[Index];
+
+        if(a_Data == NULL)
+        {
+            Test_Flash[Word] = Value; /* Erased from the end of the block when cut */
+        }
+        else
+        {
+            if((Value != NVM_ERASED_WORD) && ((Value & ~Test_Flash[Word]) != 0))
+            {
+                Test_BadPrograms++;
+            }
+            Test_Flash[Word] &= Value;
+        }
+    }
+    if(Cut)
+    {
+        /* Reset of the flash controller */
+        Test_CutAt   = TEST_NEVER;
+        Test_FmcReg  = 0;
+        Test_Fmc2Reg = 0;
+        memset(Test_Fwb, 0xFF, sizeof(Test_Fwb));
+        longjmp(Test_Reset, 1);
+    }
+}
+
+static volatile uint32 *Test_Fmc(void)
+{
+    if(0 != (Test_FmcReg & NVM_FMC_ERASE_MASK))
+    {
+        if((Test_FmcReg & 0xFFFF0000u) == NVM_FMC_WRKEY_DEFAULT)
+        {
+            Test_Erases++;
+            Test_Operation(Test_WordIndex(Test_Fma & ~(NVM_SECTOR_SIZE - 1)), NVM_SECTOR_WORDS, NULL);
+        }
+        Test_FmcReg = 0;
+    }
+    return &Test_FmcReg;
+}
+
+static volatile uint32 *Test_Fmc2(void)
+{
+    uint32 Index;
+
+    if(0 != (Test_Fmc2Reg & NVM_FMC2_WRBUF_MASK))
+    {
+        if((Test_Fmc2Reg & 0xFFFF0000u) == NVM_FMC_WRKEY_DEFAULT)
+        {
+            Test_Operation(Test_WordIndex(Test_Fma), NVM_FWB_WORDS, Test_Fwb);
+        }
+        for(Index = 0; Index < NVM_FWB_WORDS; Index++)
+        {
+            Test_Fwb[Index] = NVM_ERASED_WORD; /* Words not written by the driver program nothing */
+        }
+        Test_Fmc2Reg = 0;
+    }
+    return &Test_Fmc2Reg;
+}
+
+/*******************************************************************************
+ *                            Reference model                                  *
+ *******************************************************************************/
+
+static void Test_Format(void)
+{
+    memset(Test_Flash, 0xFF, sizeof(Test_Flash));
+    memset(Test_Fwb, 0xFF, sizeof(Test_Fwb));
+    memset(Test_Present, 0, sizeof(Test_Present));
+    Nvm_Init();
+}
+
+/* Nvm_Write of key a_Key with a_Words values derived from a_Seed, kept in the reference when it succeeds */
+static boolean Test_Write(uint8 a_Key, uint8 a_Words, uint32 a_Seed)
+{
+    uint32 Data[NVM_MAX_RECORD_WORDS];
+    uint8 Index;
+
+    for(Index = 0; Index < a_Words; Index++)
+    {
+        Data[Index] = (a_Seed * 2654435761u) ^ ((uint32)Index << 24) ^ a_Key;
+    }
+    if(Nvm_Write(a_Key, Data, a_Words) == FALSE)
+    {
+        return FALSE;
+    }
+    memcpy(Test_Values[a_Key], Data, sizeof(uint32) * a_Words);
+    Test_Words[a_Key]   = a_Words;
+    Test_Present[a_Key] = TRUE;
+    return TRUE;
+}
+
+/* Every key of the store matches the reference, except a_Skip */
+static boolean Test_Verify(sint32 a_Skip)
+{
+    uint32 Data[NVM_MAX_RECORD_WORDS];
+    uint8 Words;
+    uint8 Key;
+    boolean Passed = TRUE;
+
+    for(Key = 0; Key < TEST_KEYS; Key++)
+    {
+        if(Key == a_Skip)
+        {
+            continue;
+        }
+        if(Nvm_Read(Key, Data, NVM_MAX_RECORD_WORDS, &Words) != Test_Present[Key])
+        {
+            Passed = FALSE;
+        }
+        else if(Test_Present[Key] &&
+                ((Words != Test_Words[Key]) || (memcmp(Data, Test_Values[Key], sizeof(uint32) * Words) != 0)))
+        {
+            Passed = FALSE;
+        }
+        if(!Passed)
+        {
+            fprintf(stderr, "  key %u differs from the reference\n", Key);
+            break;
+        }
+    }
+    return Passed;
+}
+
+/*******************************************************************************
+ *                                 Tests                                       *
+ *******************************************************************************/
+
+static void Test_Basic(void)
+{
+    Nvm_StatsType Stats;
+    uint32 Data[NVM_MAX_RECORD_WORDS];
+    uint8 Words;
+
+    Test_Format();
+    Nvm_GetStats(&Stats);
+    HOST_CHECK_EQUAL(Stats.ActiveSector, 0);
+    HOST_CHECK_EQUAL(Stats.Sequence, 1);
+    HOST_CHECK_EQUAL(Stats.UsedWords, NVM_SECTOR_HEADER_WORDS);
+    HOST_CHECK_EQUAL(Stats.Keys, 0);
+    HOST_CHECK_EQUAL(Stats.EraseCount[0], 1);
+
+    HOST_CHECK(Nvm_Read(1, Data, NVM_MAX_RECORD_WORDS, &Words) == FALSE);
+    HOST_CHECK(Test_Write(1, 3, 10));
+    HOST_CHECK(Test_Write(2, 0, 11));
+    HOST_CHECK(Test_Write(3, NVM_MAX_RECORD_WORDS, 12));
+    HOST_CHECK(Test_Write(1, 5, 13));
+    HOST_CHECK(Test_Verify(-1));
+    HOST_CHECK(Nvm_Write(4, NULL_PTR, 1) == FALSE);
+    HOST_CHECK(Nvm_Write(4, Data, NVM_MAX_RECORD_WORDS + 1) == FALSE);
+
+    /* A short a_Data gets the first words, a_Words the record size */
+    HOST_CHECK(Nvm_Read(1, Data, 2, &Words));
+    HOST_CHECK_EQUAL(Words, 5);
+    HOST_CHECK_EQUAL(Data[1], Test_Values[1][1]);
+
+    Nvm_Init();
+    HOST_CHECK(Test_Verify(-1));
+    Nvm_GetStats(&Stats);
+    HOST_CHECK_EQUAL(Stats.Keys, 3);
+    HOST_CHECK_EQUAL(Stats.UsedWords, NVM_SECTOR_HEADER_WORDS + (3 + 2) + (0 + 2) + (NVM_MAX_RECORD_WORDS + 2) + (5 + 2));
+}
+
+static void Test_Compaction(void)
+{
+    Nvm_StatsType Stats;
+    uint32 Write;
+    uint32 Sector;
+    uint32 MinErase = TEST_NEVER;
+    uint32 MaxErase = 0;
+    uint32 Erases = 0;
+
+    Test_Format();
+    for(Write = 0; Write < 2000; Write++)
+    {
+        if(!HOST_CHECK(Test_Write((uint8)(Write % TEST_KEYS), (uint8)(1 + ((Write * 7) % 12)), Write)))
+        {
+            break;
+        }
+        if((Write % 97) == 0)
+        {
+            Nvm_Init();
+        }
+        if(!HOST_CHECK(Test_Verify(-1)))
+        {
+            break;
+        }
+    }
+
+    Nvm_GetStats(&Stats);
+    HOST_CHECK(Stats.Sequence > (4 * NVM_SECTORS));
+    for(Sector = 0; Sector < NVM_SECTORS; Sector++)
+    {
+        MinErase = (Stats.EraseCount[Sector] < MinErase) ? Stats.EraseCount[Sector] : MinErase;
+        MaxErase = (Stats.EraseCount[Sector] > MaxErase) ? Stats.EraseCount[Sector] : MaxErase;
+        Erases  += Stats.EraseCount[Sector];
+    }
+    HOST_CHECK(MaxErase - MinErase <= 1);
+    HOST_CHECK_EQUAL(Erases, Stats.Sequence); /* One erase per compaction, the format included */
+}
+
+/* Live records that fill the sector: the write fails before anything is erased */
+static void Test_Full(void)
+{
+    uint32 Next[NVM_SECTOR_WORDS];
+    uint32 Erases;
+    uint8 Key;
+
+    Test_Format();
+    Test_Flash[NVM_SECTOR_WORDS + 10] = 0x12345678; /* Left over in the next sector */
+    for(Key = 1; Key < TEST_KEYS; Key++)
+    {
+        HOST_CHECK(Test_Write(Key, NVM_MAX_RECORD_WORDS, Key));
+    }
+    HOST_CHECK(Test_Write(0, 2, 1));
+    memcpy(Next, &Test_Flash[NVM_SECTOR_WORDS], sizeof(Next));
+    Erases = Test_Erases;
+
+    HOST_CHECK(Test_Write(7, NVM_MAX_RECORD_WORDS, 100) == FALSE);
+    HOST_CHECK(Test_Write(3, NVM_MAX_RECORD_WORDS, 101) == FALSE);
+    HOST_CHECK_EQUAL(Test_Erases, Erases);
+    HOST_CHECK(memcmp(Next, &Test_Flash[NVM_SECTOR_WORDS], sizeof(Next)) == 0);
+    HOST_CHECK(Test_Verify(-1));
+    Nvm_Init();
+    HOST_CHECK(Test_Verify(-1));
+
+    /* A record that fits the space left is still written, then the smaller key 7 lets a compaction succeed */
+    HOST_CHECK(Test_Write(7, 1, 102));
+    HOST_CHECK(Test_Write(0, 2, 103));
+    HOST_CHECK_EQUAL(Test_Erases, Erases);
+    HOST_CHECK(Test_Write(0, 2, 104));
+    HOST_CHECK_EQUAL(Test_Erases, Erases + 1);
+    HOST_CHECK_EQUAL(Nvm_ActiveSector, 1);
+    HOST_CHECK(Test_Verify(-1));
+}
+
+/*
+ * Power cut at every flash operation of a write that compacts the store, and of a plain write.
+ * After the restart every other key has its last committed value, the key being written has its
+ * old or its new value, and the store accepts new writes.
+ */
+static void Test_PowerCuts(void)
+{
+    static uint32 Image[TEST_FLASH_WORDS];
+    static uint32 Values[TEST_KEYS][NVM_MAX_RECORD_WORDS];
+    uint8 Words[TEST_KEYS];
+    boolean Present[TEST_KEYS];
+    uint32 Data[NVM_MAX_RECORD_WORDS];
+    uint8 Length;
+    uint32 Cut;
+    uint32 Cuts = 0;
+    uint32 Start;
+    uint32 Pass;
+    volatile boolean Completed;
+
+    for(Pass = 0; Pass < 2; Pass++)
+    {
+        /* Pass 0: the next write compacts, pass 1: it is a plain append */
+        Test_Format();
+        for(Cut = 0; Cut < ((Pass == 0) ? 40 : 4); Cut++)
+        {
+            (void)Test_Write((uint8)(Cut % 5), 6, Cut);
+        }
+        if(Pass == 0)
+        {
+            while(Nvm_WriteOffset + 8 + 2 <= NVM_SECTOR_WORDS)
+            {
+                (void)Test_Write(5, 1, 500 + Nvm_WriteOffset);
+            }
+        }
+        memcpy(Image, Test_Flash, sizeof(Image));
+        memcpy(Values, Test_Values, sizeof(Values));
+        memcpy(Words, Test_Words, sizeof(Words));
+        memcpy(Present, Test_Present, sizeof(Present));
+
+        Completed = FALSE;
+        for(Cut = 1; !Completed; Cut++)
+        {
+            memcpy(Test_Flash, Image, sizeof(Image));
+            memcpy(Test_Values, Values, sizeof(Values));
+            memcpy(Test_Words, Words, sizeof(Words));
+            memcpy(Test_Present, Present, sizeof(Present));
+            Nvm_Init();
+
+            Start = Test_Operations;
+            Test_CutAt = Test_Operations + Cut;
+            if(setjmp(Test_Reset) == 0)
+            {
+                HOST_CHECK(Test_Write(6, 8, 1000 + Cut));
+                Test_CutAt = TEST_NEVER;
+                Completed = TRUE;
+            }
+            else
+            {
+                Cuts++;
+            }
+
+            Nvm_Init();
+            if(!HOST_CHECK(Test_Verify(6)))
+            {
+                fprintf(stderr, "  power cut at operation %u of pass %u\n", Test_Operations - Start, Pass);
+                break;
+            }
+            if(Nvm_Read(6, Data, NVM_MAX_RECORD_WORDS, &Length))
+            {
+                uint32 Expected[NVM_MAX_RECORD_WORDS];
+
+                Test_Words[6] = Length;
+                Test_Present[6] = TRUE;
+                for(Length = 0; Length < 8; Length++)
+                {
+                    Expected[Length] = ((1000 + Cut) * 2654435761u) ^ ((uint32)Length << 24) ^ 6;
+                }
+                HOST_CHECK(Completed || (Test_Words[6] == 8));
+                HOST_CHECK(memcmp(Data, Expected, sizeof(uint32) * 8) == 0);
+            }
+            else
+            {
+                HOST_CHECK(!Completed);
+            }
+            HOST_CHECK(Test_Write(7, 3, 2000 + Cut));
+            HOST_CHECK(Test_Verify(6));
+        }
+        HOST_CHECK(Cut > ((Pass == 0) ? 5u : 2u));
+    }
+    HOST_CHECK(Cuts > 6);
+}
+
+static void Test_FaultLog(void)
+{
+    uint32 Fault[2];
+    uint32 Data[NVM_MAX_RECORD_WORDS];
+    uint8 Words;
+    uint8 Slot;
+    uint32 Index;
+
+    Test_Format();
+    for(Index = 0; Index < 10; Index++)
+    {
+        Fault[0] = 0xDEAD0000u + Index;
+        Fault[1] = Index;
+        HOST_CHECK(Nvm_LogFault(Fault, 2));
+    }
+    Nvm_Init();
+
+    /* The last NVM_FAULT_LOG_DEPTH faults, with their sequence numbers, and the log continues */
+    for(Slot = 0; Slot < NVM_FAULT_LOG_DEPTH; Slot++)
+    {
+        HOST_CHECK(Nvm_Read(NVM_FAULT_KEY_BASE + Slot, Data, NVM_MAX_RECORD_WORDS, &Words));
+        HOST_CHECK_EQUAL(Words, 3);
+        HOST_CHECK_EQUAL(Data[1], 0xDEAD0000u + Data[0]);
+        HOST_CHECK(Data[0] >= 10 - NVM_FAULT_LOG_DEPTH);
+    }
+    HOST_CHECK_EQUAL(Nvm_FaultSequence, 10);
+    HOST_CHECK(Nvm_LogFault(Fault, NVM_MAX_RECORD_WORDS) == FALSE);
+}
+
+int main(void)
+{
+    Test_Basic();
+    Test_Compaction();
+    Test_Full();
+    Test_PowerCuts();
+    Test_FaultLog();
+    HOST_CHECK_EQUAL(Test_BadPrograms, 0);
+
+    return Host_Report("nvm_test");
+}
@@ -0,0 +1,322 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: power_test.c
+ *
+ * Description: Host test of the time accounting of NVIC_Driver/POWER.c. The driver is compiled in
+ *              with the SysTick, SCB and SYSCTL registers in host memory. The test runs a model of
+ *              the SysTick down-counter at the clock it is fed with: the core clock while awake and
+ *              in sleep, the DSLPCLKCFG clock in deep-sleep. WFI runs the counter until the next
+ *              SysTick event plus a wake up latency, with the handler held back by PRIMASK as on
+ *              the target. The true elapsed time of the model is compared with the accounting.
+ *
+ *              Checks : clock gates and DSLPCLKCFG programming, deep-sleep clock of every
+ *                       DSLPCLKCFG source and divider, wall / sleep / deep-sleep / run time
+ *                       against the model over sleep, deep-sleep at the PIOSC rate, a core
+ *                       clock change with a SysTick reload, and a wrap of the 32-bit tick count,
+ *                       wake up latency in both modes.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : power_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+
+static uint32 Test_SysTickCtrl;
+static uint32 Test_SysTickReload;
+static uint32 Test_SysTickCurrent;
+static uint32 Test_IntCtrl;
+static uint32 Test_SysCtrl;
+static uint32 Test_Scgc[24];
+static uint32 Test_Dcgc[24];
+static uint32 Test_DeepSleepClockCfg;
+static uint32 Test_Rcc;
+
+#undef SYSTICK_CTRL_REG
+#undef SYSTICK_RELOAD_REG
+#undef SYSTICK_CURRENT_REG
+#undef NVIC_SYSTEM_INTCTRL
+#undef NVIC_SYSTEM_SYSCTRL
+#undef SYSCTL_SCGCWD_REG
+#undef SYSCTL_DCGCWD_REG
+#undef SYSCTL_DSLPCLKCFG_REG
+#undef SYSCTL_RCC_REG
+#define SYSTICK_CTRL_REG            Test_SysTickCtrl
+#define SYSTICK_RELOAD_REG          Test_SysTickReload
+#define SYSTICK_CURRENT_REG         Test_SysTickCurrent
+#define NVIC_SYSTEM_INTCTRL         Test_IntCtrl
+#define NVIC_SYSTEM_SYSCTRL         Test_SysCtrl
+#define SYSCTL_SCGCWD_REG           Test_Scgc[0]
+#define SYSCTL_DCGCWD_REG           Test_Dcgc[0]
+#define SYSCTL_DSLPCLKCFG_REG       Test_DeepSleepClockCfg
+#define SYSCTL_RCC_REG              Test_Rcc
+
+#include "POWER.c"
+
+#define TEST_PIOSC_HZ               16000000u   /* Deep-sleep clock of the model */
+#define TEST_WAKE_COUNTS            120u        /* SysTick counts from the event to the end of WFI */
+#define TEST_TOLERANCE              4u          /* POWER_TIME_BASE_HZ cycles, rounding of the conversions */
+
+static uint32 Test_Ticks;                       /* SysTick_TickCount of the model */
+static uint32 Test_CoreHz;
+static double Test_Time;                        /* True time of the model in POWER_TIME_BASE_HZ cycles */
+static double Test_SleepTime;
+static double Test_DeepSleepTime;
+
+/*******************************************************************************
+ *                        Modules used by the driver                           *
+ *******************************************************************************/
+
+uint32 SysTick_GetTickCount(void)
+{
+    return Test_Ticks;
+}
+
+uint32 Clock_GetCoreClock(void)
+{
+    return Test_CoreHz;
+}
+
+/*******************************************************************************
+ *                              SysTick model                                  *
+ *******************************************************************************/
+
+/* SysTick handler, taken once the event is pending and the interrupts are enabled */
+static void Test_TakeSysTick(void)
+{
+    if(((Test_IntCtrl & SYSTICK_PENDING_MASK) != 0) && (Host_Primask == 0))
+    {
+        Test_IntCtrl &= ~SYSTICK_PENDING_MASK;
+        Test_Ticks++;
+    }
+}
+
+/* One input clock of the enabled counter: reload from 0, otherwise count down and pend the event on reaching 0 */
+static void Test_Count(uint32 a_Hz)
+{
+    Test_Time += (double)POWER_TIME_BASE_HZ / a_Hz;
+    if((Test_SysTickCtrl & SYSTICK_TIMER_ENABLE_MASK) == 0)
+    {
+        return;
+    }
+    if(Test_SysTickCurrent == 0)
+    {
+        Test_SysTickCurrent = Test_SysTickReload;
+    }
+    else if(--Test_SysTickCurrent == 0)
+    {
+        Test_IntCtrl |= SYSTICK_PENDING_MASK;
+    }
+}
+
+/* a_Counts input clocks at a_Hz, the handler runs when the interrupts are enabled */
+static double Test_Run(uint64 a_Counts, uint32 a_Hz)
+{
+    double Start = Test_Time;
+
+    while(a_Counts-- > 0)
+    {
+        Test_Count(a_Hz);
+        Test_TakeSysTick();
+    }
+    return Test_Time - Start;
+}
+
+/* WFI with PRIMASK set: the counter runs at the clock of the mode until the SysTick event wakes the core */
+static void Test_Wfi(const char *a_Instruction)
+{
+    boolean Deep = (Test_SysCtrl & POWER_SLEEP_DEEP_MASK) != 0;
+    uint32 Hz = Deep ? TEST_PIOSC_HZ : Test_CoreHz;
+    double Start = Test_Time;
+
+    if(strstr(a_Instruction, "WFI") == NULL)
+    {
+        return;
+    }
+    while((Test_IntCtrl & SYSTICK_PENDING_MASK) == 0)
+    {
+        Test_Count(Hz);
+    }
+    (void)Test_Run(TEST_WAKE_COUNTS, Hz);
+    if(Deep)
+    {
+        Test_DeepSleepTime += Test_Time - Start;
+    }
+    else
+    {
+        Test_SleepTime += Test_Time - Start;
+    }
+}
+
+/* SysTick_Init of a 1 ms period at the current core clock */
+static void Test_SysTickInit(void)
+{
+    Power_SysTickRestart();
+    Test_SysTickCtrl    = 0;
+    Test_SysTickReload  = (Test_CoreHz / 1000) - 1;
+    Test_SysTickCurrent = 0;
+    Test_SysTickCtrl    = SYSTICK_CLK_SRC_MASK | SYSTICK_INTERRUPT_ENABLE_MASK | SYSTICK_TIMER_ENABLE_MASK;
+}
+
+static void Test_Idle(Power_ModeType a_Mode)
+{
+    Power_Idle(a_Mode);
+    Test_TakeSysTick(); /* The waking interrupt is served once Power_Idle restores PRIMASK */
+}
+
+static boolean Test_Near(uint64 a_Actual, double a_Expected)
+{
+    double Error = (double)a_Actual - a_Expected;
+
+    if((Error > TEST_TOLERANCE) || (Error < -(double)TEST_TOLERANCE))
+    {
+        fprintf(stderr, "  %llu, expected %.1f\n", (unsigned long long)a_Actual, a_Expected);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/*******************************************************************************
+ *                                 Tests                                       *
+ *******************************************************************************/
+
+static void Test_Configuration(void)
+{
+    Power_ConfigType Config;
+
+    memset(&Config, 0, sizeof(Config));
+    Config.Sleep.Gpio          = 0x3F;
+    Config.Sleep.Uart          = 0x01;
+    Config.DeepSleep.Timer     = 0x02;
+    Config.DeepSleep.WideTimer = 0x04;
+    Config.DeepSleepClockCfg   = POWER_DSLPCLKCFG_PIOSC;
+    Power_Init(&Config);
+
+    HOST_CHECK_EQUAL(Test_Scgc[2], 0x3F);
+    HOST_CHECK_EQUAL(Test_Scgc[6], 0x01);
+    HOST_CHECK_EQUAL(Test_Dcgc[1], 0x02);
+    HOST_CHECK_EQUAL(Test_Dcgc[23], 0x04);
+    HOST_CHECK_EQUAL(Test_DeepSleepClockCfg, POWER_DSLPCLKCFG_PIOSC);
+    HOST_CHECK((Test_Rcc & POWER_RCC_ACG_MASK) != 0);
+
+    /* Deep-sleep clock of each source, divided by DSDIVORIDE + 1 */
+    HOST_CHECK_EQUAL(Power_DeepSleepClockHz(POWER_DSLPCLKCFG_PIOSC), 16000000);
+    HOST_CHECK_EQUAL(Power_DeepSleepClockHz(POWER_DSLPCLKCFG_MOSC), CLOCK_MOSC_HZ);
+    HOST_CHECK_EQUAL(Power_DeepSleepClockHz(POWER_DSLPCLKCFG_LFIOSC), 30000);
+    HOST_CHECK_EQUAL(Power_DeepSleepClockHz(POWER_DSLPCLKCFG_32KHZ), 32768);
+    HOST_CHECK_EQUAL(Power_DeepSleepClockHz(POWER_DSLPCLKCFG_PIOSC | (3u << POWER_DSLPCLKCFG_DSDIVORIDE_BITS_POS)), 4000000);
+    HOST_CHECK_EQUAL(Power_DeepSleepClockHz(0x07800000), 1000000); /* Reset value: MOSC / 16 */
+    HOST_CHECK_EQUAL(Power_DeepSleepHz, 16000000);
+
+    Power_Init(NULL_PTR);
+    HOST_CHECK_EQUAL(Test_DeepSleepClockCfg, POWER_DSLPCLKCFG_PIOSC);
+}
+
+/* Wall, sleep, deep-sleep and run time against the model, a_Start is the true time of Power_Init */
+static void Test_CheckTimes(double a_Start, double a_Sleep, double a_DeepSleep)
+{
+    Power_StatsType Stats;
+    uint64 Wall;
+    uint64 Idle;
+
+    Power_GetIdleTime(&Wall, &Idle);
+    HOST_CHECK(Test_Near(Wall, Test_Time - a_Start));
+    HOST_CHECK(Test_Near(Idle, a_Sleep + a_DeepSleep));
+
+    Power_GetStats(&Stats);
+    HOST_CHECK(Test_Near(Stats.SleepCycles, a_Sleep));
+    HOST_CHECK(Test_Near(Stats.DeepSleepCycles, a_DeepSleep));
+    HOST_CHECK(Test_Near(Stats.RunCycles, Test_Time - a_Start - a_Sleep - a_DeepSleep));
+}
+
+static void Test_Accounting(void)
+{
+    Power_ConfigType Config;
+    Power_StatsType Stats;
+    double Start;
+    unsigned Cycle;
+    uint32 Ticks;
+
+    Host_InstructionHook = Test_Wfi;
+    Test_CoreHz = 80000000;
+    Test_Ticks  = 0xFFFFFFF0u; /* The tick count wraps during the test */
+    Test_SysTickInit();
+    (void)Test_Run(12345, Test_CoreHz);
+
+    memset(&Config, 0, sizeof(Config));
+    Config.DeepSleepClockCfg = POWER_DSLPCLKCFG_PIOSC;
+    Power_Init(&Config);
+    Start = Test_Time;
+    Test_SleepTime     = 0;
+    Test_DeepSleepTime = 0;
+
+    /* Awake, then sleep at the core clock */
+    (void)Test_Run(250000, Test_CoreHz);
+    Test_Idle(POWER_MODE_SLEEP);
+    Test_CheckTimes(Start, Test_SleepTime, Test_DeepSleepTime);
+    Power_GetStats(&Stats);
+    HOST_CHECK_EQUAL(Stats.SleepEntries, 1);
+    HOST_CHECK_EQUAL(Stats.LastWakeLatencyCycles, TEST_WAKE_COUNTS);
+
+    /* Deep-sleep: SysTick counts at the PIOSC, one tick of the 80 MHz reload lasts 5 ms */
+    (void)Test_Run(30000, Test_CoreHz);
+    Test_Idle(POWER_MODE_DEEP_SLEEP);
+    Test_CheckTimes(Start, Test_SleepTime, Test_DeepSleepTime);
+    Power_GetStats(&Stats);
+    HOST_CHECK_EQUAL(Stats.DeepSleepEntries, 1);
+    HOST_CHECK_EQUAL(Stats.LastWakeLatencyCycles, TEST_WAKE_COUNTS * (POWER_TIME_BASE_HZ / TEST_PIOSC_HZ));
+    HOST_CHECK_EQUAL(Stats.MaxWakeLatencyCycles, TEST_WAKE_COUNTS * (POWER_TIME_BASE_HZ / TEST_PIOSC_HZ));
+
+    /* Core clock change to 50 MHz, SysTick_Init reloads the counter: the history keeps its length */
+    (void)Test_Run(77777, Test_CoreHz);
+    Test_CoreHz = 50000000;
+    Test_SysTickInit();
+    Test_CheckTimes(Start, Test_SleepTime, Test_DeepSleepTime);
+    for(Cycle = 0; Cycle < 20; Cycle++)
+    {
+        (void)Test_Run(10000 + (Cycle * 3331), Test_CoreHz);
+        Test_Idle(((Cycle % 3) == 0) ? POWER_MODE_DEEP_SLEEP : POWER_MODE_SLEEP);
+        Test_CheckTimes(Start, Test_SleepTime, Test_DeepSleepTime);
+    }
+    HOST_CHECK(Test_Ticks < 0x40u);
+
+    /* Called in a critical section: PRIMASK stays set, the waking tick is taken when the caller leaves it */
+    Ticks = Test_Ticks;
+    Host_Primask = 1;
+    Test_Idle(POWER_MODE_SLEEP);
+    HOST_CHECK_EQUAL(Host_Primask, 1);
+    HOST_CHECK_EQUAL(Test_Ticks, Ticks);
+    Host_Primask = 0;
+    Test_TakeSysTick();
+    HOST_CHECK_EQUAL(Test_Ticks, Ticks + 1);
+    Test_CheckTimes(Start, Test_SleepTime, Test_DeepSleepTime);
+
+    /* Back to 16 MHz, then a stopped counter accounts nothing */
+    Test_CoreHz = 16000000;
+    Test_SysTickInit();
+    (void)Test_Run(40000, Test_CoreHz);
+    Test_CheckTimes(Start, Test_SleepTime, Test_DeepSleepTime);
+    Test_SysTickCtrl &= ~SYSTICK_TIMER_ENABLE_MASK;
+    Start += Test_Run(40000, Test_CoreHz);
+    Test_SysTickCtrl |= SYSTICK_TIMER_ENABLE_MASK;
+    Test_CheckTimes(Start, Test_SleepTime, Test_DeepSleepTime);
+    Power_GetStats(&Stats);
+    HOST_CHECK_EQUAL(Stats.SleepEntries + Stats.DeepSleepEntries, 23);
+
+    Host_InstructionHook = NULL;
+}
+
+int main(void)
+{
+    Test_Configuration();
+    Test_Accounting();
+
+    return Host_Report("power_test");
+}
@@ -0,0 +1,430 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: rm_assign.c
+ *
+ * Description: Rate/deadline monotonic NVIC priority assignment and response time analysis.
+ *              Reads the interrupt sources, orders them by deadline (rate monotonic when the
+ *              deadline equals the period), compresses the order into the NVIC priority levels
+ *              and writes a Boot_IrqConfigType table (NVIC_Driver/BOOT.h) for Boot_BringUp.
+ *
+ *              Input : one source per line, '#' starts a comment, any time unit (us, cycles)
+ *                      <name> <irq> <period> <wcet> [deadline] [blocking]
+ *                      deadline defaults to the period, blocking (longest critical section
+ *                      of a lower priority source) defaults to 0. The IRQ must be one of
+ *                      NVIC_Driver/NVIC_IRQS.h for the part and used by one source only.
+ *
+ *              Build : gcc -O2 -I../NVIC_Driver [-DPART_TM4C123GH6PM] -o rm_assign rm_assign.c
+ *              Usage : rm_assign [--levels N] [--first L] [--name Symbol] <sources.txt>
+ *                      --levels : priority levels available to the sources, default 8
+ *                      --first  : highest (numerically lowest) level used, default 0
+ *                      --name   : name of the generated table, default Rm_IrqConfig
+ *
+ *              Exit status is 0 when every source meets its deadline, 2 when the set is
+ *              not schedulable (the table is still written, the failing sources are marked)
+ *              and 1 on input errors.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+/* Host definitions of the firmware types */
+#define STD_TYPES_H_
+#define FALSE                       (0u)
+#define TRUE                        (1u)
+#define NULL_PTR                    ((void*)0)
+typedef uint8_t                     uint8;
+typedef uint16_t                    uint16;
+typedef uint32_t                    uint32;
+typedef uint64_t                    uint64;
+typedef uint8                       boolean;
+
+#include "NVIC.h"
+
+#define NVIC_PRIORITY_LEVELS        (NVIC_MAX_PRIORITY + 1u)
+#define SOURCE_NAME_SIZE            32
+
+/* Names of the IRQs of the part, NULL for the reserved numbers */
+#define NVIC_IRQ(Num, Name, Handler, Description)   [(Num)] = #Name,
+static const char * const Irq_Names[NVIC_IRQ_COUNT] =
+{
+#include "NVIC_IRQS.h"
+};
+#undef NVIC_IRQ
+
+typedef struct
+{
+    char Name[SOURCE_NAME_SIZE];
+    int Irq;
+    uint64_t Period;
+    uint64_t Wcet;
+    uint64_t Deadline;
+    uint64_t Blocking;
+    unsigned Level;                         /* Index of the assigned level, 0 is the highest */
+    uint64_t Response;                      /* Lower bound while the levels are assigned, exact after */
+    uint64_t Demand;                        /* Work released within the deadline by the source and the ones that delay it */
+    uint64_t TrialDemand;                   /* Demand and response while a new member tries to join the level */
+    uint64_t TrialResponse;
+    int Schedulable;
+}Source_Type;
+
+static Source_Type *Sources;
+static size_t SourcesCount;
+
+static int Source_Compare(const void *a_Left, const void *a_Right)
+{
+    const Source_Type *Left  = a_Left;
+    const Source_Type *Right = a_Right;
+
+    if(Left->Deadline != Right->Deadline)
+    {
+        return (Left->Deadline < Right->Deadline) ? -1 : 1;
+    }
+    if(Left->Period != Right->Period)
+    {
+        return (Left->Period < Right->Period) ? -1 : 1;
+    }
+    return Left->Irq - Right->Irq;
+}
+
+/*
+ * Response time analysis of source a_Index against the sources 0 .. a_Count - 1, which are the
+ * sources placed so far. Sources on the same level do not preempt each other but the NVIC may
+ * serve any of them first, so they are counted as interference like the higher levels.
+ * The iteration starts from a_Start, a response known to be below the result (the response
+ * against fewer sources, the sum of the WCETs), or from the demand of the source itself.
+ * It stops above the deadline.
+ */
+static uint64_t Source_Response(size_t a_Index, size_t a_Count, uint64_t a_Start)
+{
+    const Source_Type *Source = &Sources[a_Index];
+    uint64_t Response = Source->Wcet + Source->Blocking;
+    uint64_t Next;
+    size_t Other;
+
+    if(a_Start > Response)
+    {
+        Response = a_Start;
+    }
+    for(;;)
+    {
+        Next = Source->Wcet + Source->Blocking;
+        for(Other = 0; Other < a_Count; Other++)
+        {
+            if((Other != a_Index) && (Sources[Other].Level <= Source->Level))
+            {
+                Next += ((Response + Sources[Other].Period - 1) / Sources[Other].Period) * Sources[Other].Wcet;
+            }
+        }
+        if((Next == Response) || (Next > Source->Deadline))
+        {
+            break;
+        }
+        Response = Next;
+    }
+    return Next;
+}
+
+/* Work released within the deadline of source a_Index by itself and the sources 0 .. a_Count - 1 that delay it */
+static uint64_t Source_Demand(size_t a_Index, size_t a_Count)
+{
+    const Source_Type *Source = &Sources[a_Index];
+    uint64_t Demand = Source->Wcet + Source->Blocking;
+    size_t Other;
+
+    for(Other = 0; Other < a_Count; Other++)
+    {
+        if((Other != a_Index) && (Sources[Other].Level <= Source->Level))
+        {
+            Demand += ((Source->Deadline + Sources[Other].Period - 1) / Sources[Other].Period) * Sources[Other].Wcet;
+        }
+    }
+    return Demand;
+}
+
+/*
+ * Deadline test of source a_Index against the sources 0 .. a_Count - 1 during a trial. A demand
+ * within the deadline is enough, the response is then below the deadline and is computed once
+ * the levels are final. Otherwise the response is computed now, from the last known one.
+ */
+static int Source_Fits(size_t a_Index, size_t a_Count)
+{
+    Source_Type *Source = &Sources[a_Index];
+
+    if(Source->TrialDemand <= Source->Deadline)
+    {
+        return 1;
+    }
+    Source->TrialResponse = Source_Response(a_Index, a_Count, Source->Response);
+    return (Source->TrialResponse <= Source->Deadline);
+}
+
+/*
+ * Source a_Index tries to join the level of the sources a_Start .. a_Index - 1. Only the new
+ * member and the members it delays are tested again, the higher levels do not see it. The
+ * demand of a member grows by the firings of the new source within its deadline, so most
+ * members are tested in constant time and only the tight ones need a response time analysis.
+ * The trial stops at the first missed deadline unless a_Force is set. The demands, and the
+ * responses computed on the way, are kept when the source joins.
+ */
+static int Level_Join(size_t a_Start, size_t a_Index, unsigned a_Level, int a_Force)
+{
+    Source_Type *New = &Sources[a_Index];
+    Source_Type *Source;
+    size_t Member;
+    int Fits;
+
+    New->Level         = a_Level;
+    New->TrialDemand   = Source_Demand(a_Index, a_Index + 1);
+    New->TrialResponse = 0;
+    Fits = a_Force || Source_Fits(a_Index, a_Index + 1);
+    for(Member = a_Start; (Member < a_Index) && Fits; Member++)
+    {
+        Source = &Sources[Member];
+        Source->TrialDemand   = Source->Demand + ((Source->Deadline + New->Period - 1) / New->Period) * New->Wcet;
+        Source->TrialResponse = 0;
+        Fits = a_Force || Source_Fits(Member, a_Index + 1);
+    }
+    if(!Fits)
+    {
+        return 0;
+    }
+    for(Member = a_Start; Member <= a_Index; Member++)
+    {
+        Source = &Sources[Member];
+        Source->Demand = Source->TrialDemand;
+        if(Source->TrialResponse > Source->Response)
+        {
+            Source->Response = Source->TrialResponse;
+        }
+    }
+    return 1;
+}
+
+/*
+ * Walk the sources in deadline order. While there are at least as many levels left as sources,
+ * each source gets its own level. When levels are scarce the source joins the current level if
+ * every member of that level stays schedulable, otherwise it opens the next level. The last
+ * level takes everything that is left. The responses are then computed once on the final
+ * levels, from the bounds found during the walk.
+ */
+static void Assign_Levels(unsigned a_Levels)
+{
+    unsigned Level = 0;
+    size_t LevelStart = 0;
+    size_t Index;
+    size_t End = 0;
+    uint64_t Work = 0;
+    uint64_t Start;
+
+    for(Index = 0; Index < SourcesCount; Index++)
+    {
+        Sources[Index].Response = 0;
+        if(Index > 0)
+        {
+            if(((SourcesCount - Index) > (a_Levels - 1u - Level)) && Level_Join(LevelStart, Index, Level, 0))
+            {
+                continue; /* Levels are scarce and the current one is shared */
+            }
+            if((Level + 1u) >= a_Levels)
+            {
+                (void)Level_Join(LevelStart, Index, Level, 1);
+                continue; /* Last level */
+            }
+            Level++;
+            LevelStart = Index;
+        }
+
+        /* First source of a level, delayed by all the sources before it */
+        Sources[Index].Level  = Level;
+        Sources[Index].Demand = Source_Demand(Index, Index + 1);
+    }
+
+    /* Every source of the same or a higher level runs at least once before a source completes */
+    for(Index = 0; Index < SourcesCount; Index++)
+    {
+        while((End < SourcesCount) && (Sources[End].Level <= Sources[Index].Level))
+        {
+            Work += Sources[End++].Wcet;
+        }
+        Start = Work + Sources[Index].Blocking;
+        if(Sources[Index].Response > Start)
+        {
+            Start = Sources[Index].Response;
+        }
+        Sources[Index].Response    = Source_Response(Index, SourcesCount, Start);
+        Sources[Index].Schedulable = (Sources[Index].Response <= Sources[Index].Deadline);
+    }
+}
+
+static int Read_Sources(const char *a_Path)
+{
+    FILE *File = fopen(a_Path, "r");
+    char Line[256];
+    size_t Capacity = 0;
+    unsigned LineNumber = 0;
+    unsigned IrqLines[NVIC_IRQ_COUNT] = { 0 };  /* Line of the source of each IRQ, 0 when unused */
+
+    if(File == NULL)
+    {
+        perror(a_Path);
+        return 0;
+    }
+    while(fgets(Line, sizeof(Line), File) != NULL)
+    {
+        Source_Type Source;
+        unsigned long long Period, Wcet, Deadline = 0, Blocking = 0;
+        char *Comment = strchr(Line, '#');
+        int Fields;
+
+        LineNumber++;
+        if(Comment != NULL)
+        {
+            *Comment = '\0';
+        }
+        memset(&Source, 0, sizeof(Source));
+        Fields = sscanf(Line, "%31s %d %llu %llu %llu %llu", Source.Name, &Source.Irq, &Period, &Wcet, &Deadline, &Blocking);
+        if(Fields <= 0)
+        {
+            continue;
+        }
+        if((Fields < 4) || (Source.Irq < 0) || (Source.Irq >= NVIC_IRQ_COUNT) || (Period == 0) || (Wcet == 0))
+        {
+            fprintf(stderr, "%s:%u: expected <name> <irq 0..%d> <period> <wcet> [deadline] [blocking]\n",
+                    a_Path, LineNumber, NVIC_MAX_IRQ_NUM);
+            fclose(File);
+            return 0;
+        }
+        if(Irq_Names[Source.Irq] == NULL)
+        {
+            fprintf(stderr, "%s:%u: IRQ %d is reserved on this part\n", a_Path, LineNumber, Source.Irq);
+            fclose(File);
+            return 0;
+        }
+        if(IrqLines[Source.Irq] != 0)
+        {
+            fprintf(stderr, "%s:%u: IRQ %d (%s) is already the source of line %u\n", a_Path, LineNumber,
+                    Source.Irq, Irq_Names[Source.Irq], IrqLines[Source.Irq]);
+            fclose(File);
+            return 0;
+        }
+        /* The table feeds the uint8 IrqsCount of Boot_ConfigType */
+        if(SourcesCount >= NVIC_IRQ_COUNT)
+        {
+            fprintf(stderr, "%s:%u: more than %d sources\n", a_Path, LineNumber, NVIC_IRQ_COUNT);
+            fclose(File);
+            return 0;
+        }
+        IrqLines[Source.Irq] = LineNumber;
+        Source.Period   = Period;
+        Source.Wcet     = Wcet;
+        Source.Deadline = (Fields >= 5) ? Deadline : Period;
+        Source.Blocking = Blocking;
+
+        if(SourcesCount == Capacity)
+        {
+            Capacity = (Capacity == 0) ? 64 : (Capacity * 2);
+            Sources  = realloc(Sources, Capacity * sizeof(Source_Type));
+            if(Sources == NULL)
+            {
+                fprintf(stderr, "out of memory\n");
+                fclose(File);
+                return 0;
+            }
+        }
+        Sources[SourcesCount++] = Source;
+    }
+    fclose(File);
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned Levels = NVIC_PRIORITY_LEVELS;
+    unsigned First = 0;
+    const char *Name = "Rm_IrqConfig";
+    const char *Path = NULL;
+    double Utilization = 0.0;
+    int Schedulable = 1;
+    size_t Index;
+    int Arg;
+
+    for(Arg = 1; Arg < argc; Arg++)
+    {
+        if((strcmp(argv[Arg], "--levels") == 0) && (Arg + 1 < argc))
+        {
+            Levels = (unsigned)strtoul(argv[++Arg], NULL, 0);
+        }
+        else if((strcmp(argv[Arg], "--first") == 0) && (Arg + 1 < argc))
+        {
+            First = (unsigned)strtoul(argv[++Arg], NULL, 0);
+        }
+        else if((strcmp(argv[Arg], "--name") == 0) && (Arg + 1 < argc))
+        {
+            Name = argv[++Arg];
+        }
+        else
+        {
+            Path = argv[Arg];
+        }
+    }
+    if((Path == NULL) || (Levels == 0) || (First + Levels > NVIC_PRIORITY_LEVELS))
+    {
+        fprintf(stderr, "usage: %s [--levels N] [--first L] [--name Symbol] <sources.txt>\n"
+                        "       --first + --levels must not exceed %u\n", argv[0], NVIC_PRIORITY_LEVELS);
+        return 1;
+    }
+    if(!Read_Sources(Path))
+    {
+        return 1;
+    }
+    if(SourcesCount == 0)
+    {
+        fprintf(stderr, "%s: no sources\n", Path);
+        return 1;
+    }
+
+    qsort(Sources, SourcesCount, sizeof(Source_Type), Source_Compare);
+    Assign_Levels(Levels);
+    for(Index = 0; Index < SourcesCount; Index++)
+    {
+        Schedulable &= Sources[Index].Schedulable;
+        Utilization += (double)Sources[Index].Wcet / (double)Sources[Index].Period;
+    }
+
+    printf("/* Generated by rm_assign from %s, do not edit */\n", Path);
+    printf("/* %zu sources, utilization %.3f, %s */\n", SourcesCount, Utilization,
+           Schedulable ? "schedulable" : "NOT SCHEDULABLE");
+    printf("#include \"BOOT.h\"\n\n");
+    printf("/*  %-20s %4s %5s %12s %12s %12s %12s %12s */\n", "Source", "IRQ", "Level", "Period", "WCET", "Deadline", "Blocking", "Response");
+    for(Index = 0; Index < SourcesCount; Index++)
+    {
+        const Source_Type *Source = &Sources[Index];
+
+        printf("/*  %-20s %4d %5u %12llu %12llu %12llu %12llu %12llu %s*/\n", Source->Name, Source->Irq, First + Source->Level,
+               (unsigned long long)Source->Period, (unsigned long long)Source->Wcet, (unsigned long long)Source->Deadline,
+               (unsigned long long)Source->Blocking, (unsigned long long)Source->Response,
+               Source->Schedulable ? "" : "MISSES DEADLINE ");
+    }
+    printf("\n#define %s_COUNT %zu\n\n", Name, SourcesCount);
+    printf("static const Boot_IrqConfigType %s[%s_COUNT] =\n{\n", Name, Name);
+    for(Index = 0; Index < SourcesCount; Index++)
+    {
+        printf("    { %3d, %u, TRUE }%s /* %s */\n", Sources[Index].Irq, First + Sources[Index].Level,
+               (Index + 1 < SourcesCount) ? "," : " ", Sources[Index].Name);
+    }
+    printf("};\n");
+
+    if(!Schedulable)
+    {
+        fprintf(stderr, "%s: the source set is not schedulable\n", Path);
+    }
+    free(Sources);
+    return Schedulable ? 0 : 2;
+}
@@ -0,0 +1,300 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: rm_assign_test.c
+ *
+ * Description: Unit tests of the analysis of rm_assign.c on textbook task sets. The tool is
+ *              compiled in with its main() renamed, the tests fill the source table, sort it and
+ *              assign the levels as the tool does, then check the levels and response times.
+ *
+ *              Checks : response times of textbook sets (Burns & Wellings, Buttazzo), a set
+ *                       over its deadlines, deadline monotonic order, blocking, compression into
+ *                       fewer levels, incremental analysis equal to a full analysis on random
+ *                       sets, a thousand sources in well under a second, rejected inputs
+ *                       (reserved and duplicate IRQs).
+ *
+ *              Build : make (see Makefile)
+ *              Usage : rm_assign_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include "host.h"
+#include <time.h>
+
+#define main Rm_Assign_Main
+#include "rm_assign.c"
+#undef main
+
+#define TEST_RANDOM_SETS            200
+#define TEST_LARGE_SET              1000
+
+/* Source i gets IRQ i, a deadline of 0 means the period */
+static void Test_Set(const uint64_t *a_Periods, const uint64_t *a_Wcets, const uint64_t *a_Deadlines,
+                     size_t a_Count, unsigned a_Levels)
+{
+    size_t Index;
+
+    free(Sources);
+    Sources      = calloc(a_Count, sizeof(Source_Type));
+    SourcesCount = a_Count;
+    for(Index = 0; Index < a_Count; Index++)
+    {
+        snprintf(Sources[Index].Name, SOURCE_NAME_SIZE, "S%zu", Index);
+        Sources[Index].Irq      = (int)Index;
+        Sources[Index].Period   = a_Periods[Index];
+        Sources[Index].Wcet     = a_Wcets[Index];
+        Sources[Index].Deadline = ((a_Deadlines != NULL) && (a_Deadlines[Index] != 0)) ? a_Deadlines[Index] : a_Periods[Index];
+    }
+    qsort(Sources, SourcesCount, sizeof(Source_Type), Source_Compare);
+    Assign_Levels(a_Levels);
+}
+
+static void Test_Textbook(void)
+{
+    static const uint64_t Periods1[] = { 3, 5, 7, 20 };
+    static const uint64_t Wcets1[]   = { 1, 1, 1, 5 };
+    static const uint64_t Periods2[] = { 7, 12, 20 };
+    static const uint64_t Wcets2[]   = { 3, 3, 5 };
+    static const uint64_t Periods3[] = { 2, 5 };
+    static const uint64_t Wcets3[]   = { 1, 3 };
+    size_t Index;
+
+    /* T = (3, 5, 7, 20), C = (1, 1, 1, 5): R = (1, 2, 3, 18), one level each */
+    Test_Set(Periods1, Wcets1, NULL, 4, NVIC_PRIORITY_LEVELS);
+    for(Index = 0; Index < 4; Index++)
+    {
+        HOST_CHECK_EQUAL(Sources[Index].Level, Index);
+        HOST_CHECK(Sources[Index].Schedulable);
+    }
+    HOST_CHECK_EQUAL(Sources[0].Response, 1);
+    HOST_CHECK_EQUAL(Sources[1].Response, 2);
+    HOST_CHECK_EQUAL(Sources[2].Response, 3);
+    HOST_CHECK_EQUAL(Sources[3].Response, 18);
+
+    /* T = (7, 12, 20), C = (3, 3, 5): R = (3, 6, 20), the last one meets its deadline exactly */
+    Test_Set(Periods2, Wcets2, NULL, 3, NVIC_PRIORITY_LEVELS);
+    HOST_CHECK_EQUAL(Sources[0].Response, 3);
+    HOST_CHECK_EQUAL(Sources[1].Response, 6);
+    HOST_CHECK_EQUAL(Sources[2].Response, 20);
+    HOST_CHECK(Sources[2].Schedulable);
+
+    /* T = (2, 5), C = (1, 3): utilization 1.1, the second one misses */
+    Test_Set(Periods3, Wcets3, NULL, 2, NVIC_PRIORITY_LEVELS);
+    HOST_CHECK(Sources[0].Schedulable);
+    HOST_CHECK(!Sources[1].Schedulable);
+    HOST_CHECK(Sources[1].Response > 5);
+}
+
+static void Test_DeadlineMonotonic(void)
+{
+    static const uint64_t Periods[]   = { 5, 10 };
+    static const uint64_t Wcets[]     = { 2, 1 };
+    static const uint64_t Deadlines[] = { 5, 3 };
+
+    /* The shorter deadline goes first whatever the period */
+    Test_Set(Periods, Wcets, Deadlines, 2, NVIC_PRIORITY_LEVELS);
+    HOST_CHECK_EQUAL(Sources[0].Irq, 1);
+    HOST_CHECK_EQUAL(Sources[0].Response, 1);
+    HOST_CHECK_EQUAL(Sources[1].Response, 3);
+
+    /* Blocking by a lower priority critical section adds to the response of the blocked source */
+    Test_Set(Periods, Wcets, Deadlines, 2, NVIC_PRIORITY_LEVELS);
+    Sources[0].Blocking = 2;
+    Assign_Levels(NVIC_PRIORITY_LEVELS);
+    HOST_CHECK_EQUAL(Sources[0].Response, 3);
+    HOST_CHECK(Sources[0].Schedulable);
+}
+
+static void Test_Compression(void)
+{
+    static const uint64_t Periods[] = { 3, 5, 7, 20 };
+    static const uint64_t Wcets[]   = { 1, 1, 1, 5 };
+
+    /* Two levels: the first three share level 0 (responses 3, 3, 3), the last one keeps 18 */
+    Test_Set(Periods, Wcets, NULL, 4, 2);
+    HOST_CHECK_EQUAL(Sources[0].Level, 0);
+    HOST_CHECK_EQUAL(Sources[1].Level, 0);
+    HOST_CHECK_EQUAL(Sources[2].Level, 0);
+    HOST_CHECK_EQUAL(Sources[3].Level, 1);
+    HOST_CHECK_EQUAL(Sources[0].Response, 3);
+    HOST_CHECK_EQUAL(Sources[1].Response, 3);
+    HOST_CHECK_EQUAL(Sources[2].Response, 3);
+    HOST_CHECK_EQUAL(Sources[3].Response, 18);
+    HOST_CHECK(Sources[3].Schedulable);
+
+    /* One level: the long source delays the others, the first one misses */
+    Test_Set(Periods, Wcets, NULL, 4, 1);
+    HOST_CHECK_EQUAL(Sources[3].Level, 0);
+    HOST_CHECK(!Sources[0].Schedulable);
+}
+
+/* Deterministic generator of the random sets */
+static uint32 Test_Seed = 12345;
+
+static uint32 Test_Random(uint32 a_Range)
+{
+    Test_Seed = Test_Seed * 1103515245u + 12345u;
+    return (Test_Seed >> 8) % a_Range;
+}
+
+/* Level walk with a full response time analysis of every member of the level for each new member */
+static void Test_ReferenceLevels(unsigned a_Levels, unsigned *a_Result)
+{
+    unsigned Level = 0;
+    size_t LevelStart = 0;
+    size_t Index, Member;
+    int Fits;
+
+    for(Index = 0; Index < SourcesCount; Index++)
+    {
+        Sources[Index].Level = 0xFFFFFFFFu;
+    }
+    for(Index = 1, Sources[0].Level = 0; Index < SourcesCount; Index++)
+    {
+        Fits = 0;
+        if((SourcesCount - Index) > (a_Levels - 1u - Level))
+        {
+            Sources[Index].Level = Level;
+            Fits = 1;
+            for(Member = LevelStart; (Member <= Index) && Fits; Member++)
+            {
+                Fits = (Source_Response(Member, Index + 1, 0) <= Sources[Member].Deadline);
+            }
+        }
+        if(!Fits && (Level + 1u < a_Levels))
+        {
+            Level++;
+            LevelStart = Index;
+        }
+        Sources[Index].Level = Level;
+    }
+    for(Index = 0; Index < SourcesCount; Index++)
+    {
+        a_Result[Index] = Sources[Index].Level;
+    }
+}
+
+static void Test_Incremental(void)
+{
+    uint64_t Periods[64];
+    uint64_t Wcets[64];
+    unsigned Levels[64];
+    unsigned Reference[64];
+    uint64_t Full;
+    unsigned Available;
+    unsigned Set;
+    size_t Count;
+    size_t Index;
+
+    /* Same levels as the full analysis of every member, and the responses of a full analysis of the final levels */
+    for(Set = 0; Set < TEST_RANDOM_SETS; Set++)
+    {
+        Count = 8 + Test_Random(56);
+        for(Index = 0; Index < Count; Index++)
+        {
+            Periods[Index] = 100 + Test_Random(10000);
+            Wcets[Index]   = 1 + Test_Random((uint32)(Periods[Index] / (Count * 2)) + 1);
+        }
+        Available = 1 + Test_Random(NVIC_PRIORITY_LEVELS);
+        Test_Set(Periods, Wcets, NULL, Count, Available);
+        for(Index = 0; Index < Count; Index++)
+        {
+            Levels[Index] = Sources[Index].Level;
+        }
+        for(Index = 0; Index < Count; Index++)
+        {
+            Full = Source_Response(Index, SourcesCount, 0);
+            HOST_CHECK_EQUAL(Sources[Index].Schedulable, Full <= Sources[Index].Deadline);
+            if(Sources[Index].Schedulable)
+            {
+                HOST_CHECK_EQUAL(Sources[Index].Response, Full);
+            }
+        }
+        Test_ReferenceLevels(Available, Reference);
+        HOST_CHECK(memcmp(Levels, Reference, Count * sizeof(unsigned)) == 0);
+    }
+}
+
+static void Test_Large(void)
+{
+    static uint64_t Periods[TEST_LARGE_SET];
+    static uint64_t Wcets[TEST_LARGE_SET];
+    clock_t Start;
+    double Seconds;
+    size_t Index;
+
+    for(Index = 0; Index < TEST_LARGE_SET; Index++)
+    {
+        Periods[Index] = 1000 + Test_Random(1000000);
+        Wcets[Index]   = 1 + Test_Random((uint32)(Periods[Index] / (TEST_LARGE_SET * 2)) + 1);
+    }
+    Start = clock();
+    Test_Set(Periods, Wcets, NULL, TEST_LARGE_SET, NVIC_PRIORITY_LEVELS);
+    Seconds = (double)(clock() - Start) / CLOCKS_PER_SEC;
+    printf("%u sources in %u levels: %.3f s\n", TEST_LARGE_SET, NVIC_PRIORITY_LEVELS, Seconds);
+    HOST_CHECK(Seconds < 1.0);
+    HOST_CHECK_EQUAL(Sources[TEST_LARGE_SET - 1].Level, NVIC_PRIORITY_LEVELS - 1);
+}
+
+/* Read_Sources on a file with the given text */
+static int Test_Read(const char *a_Text)
+{
+    char Path[] = "/tmp/rm_assign_testXXXXXX";
+    int Descriptor = mkstemp(Path);
+    FILE *File = fdopen(Descriptor, "w");
+    int Result;
+
+    fputs(a_Text, File);
+    fclose(File);
+    free(Sources);
+    Sources      = NULL;
+    SourcesCount = 0;
+    Result = Read_Sources(Path);
+    remove(Path);
+    return Result;
+}
+
+static void Test_Inputs(void)
+{
+    char Text[128];
+    int Reserved = -1;
+    int Irq;
+
+    HOST_CHECK_EQUAL(Test_Read("# name irq period wcet\nuart 5 100 10\nadc 14 50 5 40 2\n"), 1);
+    HOST_CHECK_EQUAL(SourcesCount, 2);
+    HOST_CHECK_EQUAL(Sources[1].Deadline, 40);
+    HOST_CHECK_EQUAL(Sources[1].Blocking, 2);
+
+    /* One source per IRQ */
+    HOST_CHECK_EQUAL(Test_Read("uart 5 100 10\nuart_again 5 50 5\n"), 0);
+
+    /* Reserved numbers and numbers past the last IRQ of the part */
+    for(Irq = 0; (Irq < NVIC_IRQ_COUNT) && (Reserved < 0); Irq++)
+    {
+        Reserved = (Irq_Names[Irq] == NULL) ? Irq : -1;
+    }
+    HOST_CHECK(Reserved >= 0);
+    snprintf(Text, sizeof(Text), "reserved %d 100 10\n", Reserved);
+    HOST_CHECK_EQUAL(Test_Read(Text), 0);
+    snprintf(Text, sizeof(Text), "past %d 100 10\n", NVIC_IRQ_COUNT);
+    HOST_CHECK_EQUAL(Test_Read(Text), 0);
+    HOST_CHECK_EQUAL(Test_Read("nowcet 5 100\n"), 0);
+}
+
+int main(void)
+{
+    Test_Textbook();
+    Test_DeadlineMonotonic();
+    Test_Compression();
+    Test_Incremental();
+    Test_Large();
+    Test_Inputs();
+
+    free(Sources);
+    return Host_Report("rm_assign_test");
+}
@@ -0,0 +1,361 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: scheduler_test.c
+ *
+ * Description: Host test of the scheduling policy of NVIC_Driver/SCHEDULER.c. The driver is
+ *              compiled in with the PendSV pending bit and the PRIMASK in host memory; the test
+ *              plays the running task (Scheduler_Delay, Scheduler_Yield), the SysTick handler
+ *              (Scheduler_Tick) and PendSV (Scheduler_SwitchContext when PendSV is pending and
+ *              the interrupts are enabled), then checks which task runs.
+ *
+ *              Checks : pick of the highest ready priority from the bitmap at every level,
+ *                       round robin on the time slice between tasks of the same priority,
+ *                       delays and wake up order, preemption by a task that wakes up, idle
+ *                       task when every task waits, initial stack frame, MPU reload only on a
+ *                       change of regions, create errors, and a PRIMASK set by the caller kept
+ *                       set by every service.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : scheduler_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+
+static uint32 Test_IntCtrl;
+static uint32 Test_Demcr;
+static uint32 Test_DwtCtrl;
+
+#undef NVIC_SYSTEM_INTCTRL
+#undef CORE_DEBUG_DEMCR_REG
+#undef DWT_CTRL_REG
+#define NVIC_SYSTEM_INTCTRL         Test_IntCtrl
+#define CORE_DEBUG_DEMCR_REG        Test_Demcr
+#define DWT_CTRL_REG                Test_DwtCtrl
+
+#include "SCHEDULER.c"
+
+#define TEST_STACK_WORDS            64
+
+SCHEDULER_STACK(Test_Stack0, TEST_STACK_WORDS);
+SCHEDULER_STACK(Test_Stack1, TEST_STACK_WORDS);
+SCHEDULER_STACK(Test_Stack2, TEST_STACK_WORDS);
+SCHEDULER_STACK(Test_Stack3, TEST_STACK_WORDS);
+SCHEDULER_STACK(Test_Stack4, TEST_STACK_WORDS);
+SCHEDULER_STACK(Test_Stack5, TEST_STACK_WORDS);
+SCHEDULER_STACK(Test_Stack6, TEST_STACK_WORDS);
+SCHEDULER_STACK(Test_Stack7, TEST_STACK_WORDS);
+
+static uint64 * const Test_Stacks[] =
+{
+    Test_Stack0, Test_Stack1, Test_Stack2, Test_Stack3, Test_Stack4, Test_Stack5, Test_Stack6, Test_Stack7
+};
+
+static unsigned Test_MpuLoads;
+static unsigned Test_TraceSwitches;
+static uint8 Test_TraceLastTask;
+
+/*******************************************************************************
+ *                      Modules used by the scheduler                          *
+ *******************************************************************************/
+
+void Power_Idle(Power_ModeType a_Mode)
+{
+    (void)a_Mode;
+}
+
+void Mpu_LoadTaskRegions(const Mpu_TaskRegionsType *a_TaskRegions)
+{
+    (void)a_TaskRegions;
+    Test_MpuLoads++;
+}
+
+void Trace_Record(Trace_EventType a_Event, uint8 a_Id)
+{
+    if(a_Event == TRACE_EVENT_TASK_SWITCH)
+    {
+        Test_TraceSwitches++;
+        Test_TraceLastTask = a_Id;
+    }
+}
+
+void SysTick_SetCallBack(volatile void (*Ptr2Func)(void))
+{
+    (void)Ptr2Func;
+}
+
+void SysTick_Init(uint16 a_TimeInMilliSeconds)
+{
+    (void)a_TimeInMilliSeconds;
+}
+
+void NVIC_SetPriorityException(NVIC_ExceptionType Exception_Num, NVIC_ExceptionPriorityType Exception_Priority)
+{
+    (void)Exception_Num;
+    (void)Exception_Priority;
+}
+
+/*******************************************************************************
+ *                              Core model                                     *
+ *******************************************************************************/
+
+static void Test_Entry(void)
+{
+}
+
+/* PendSV is taken once it is pending and the interrupts are enabled */
+static boolean Test_TakePendSV(void)
+{
+    if(((Test_IntCtrl & SCHEDULER_PENDSV_SET_MASK) == 0) || (Host_Primask != 0))
+    {
+        return FALSE;
+    }
+    Test_IntCtrl &= ~SCHEDULER_PENDSV_SET_MASK;
+    Scheduler_SwitchContext();
+    return TRUE;
+}
+
+/* SysTick interrupt followed by the PendSV it may have pended */
+static void Test_Ticks(unsigned a_Ticks)
+{
+    while(a_Ticks-- > 0)
+    {
+        Scheduler_Tick();
+        (void)Test_TakePendSV();
+    }
+}
+
+static Scheduler_TaskIdType Test_Running(void)
+{
+    return Scheduler_GetCurrentTask();
+}
+
+/* Scheduler_Init, the given tasks, then the first PendSV of Scheduler_Start */
+static void Test_Start(const Scheduler_PriorityType *a_Priorities, unsigned a_Count, Scheduler_TaskIdType *a_Ids)
+{
+    unsigned Index;
+
+    Test_IntCtrl  = 0;
+    Host_Primask  = 0;
+    Test_MpuLoads = 0;
+    Scheduler_LoadedRegions = NULL_PTR;
+    Scheduler_Init();
+    for(Index = 0; Index < a_Count; Index++)
+    {
+        a_Ids[Index] = Scheduler_CreateTask(Test_Entry, a_Priorities[Index], Test_Stacks[Index], TEST_STACK_WORDS);
+    }
+    Scheduler_PendContextSwitch();
+    (void)Test_TakePendSV();
+}
+
+/*******************************************************************************
+ *                                 Tests                                       *
+ *******************************************************************************/
+
+/* The highest ready priority is found from the bitmap at every level */
+static void Test_BitmapPick(void)
+{
+    Scheduler_PriorityType Priority;
+    Scheduler_TaskIdType Ids[2];
+
+    for(Priority = 0; Priority < SCHEDULER_IDLE_PRIORITY; Priority++)
+    {
+        Scheduler_PriorityType Priorities[2] = { SCHEDULER_IDLE_PRIORITY - 1, Priority };
+
+        Test_Start(Priorities, (Priority == (SCHEDULER_IDLE_PRIORITY - 1)) ? 1 : 2, Ids);
+        HOST_CHECK_EQUAL(Test_Running(), (Priority == (SCHEDULER_IDLE_PRIORITY - 1)) ? Ids[0] : Ids[1]);
+        HOST_CHECK_EQUAL(Scheduler_ReadyBitmap & SCHEDULER_PRIORITY_BIT(Priority), SCHEDULER_PRIORITY_BIT(Priority));
+    }
+
+    /* Only the idle task */
+    Test_Start(NULL_PTR, 0, Ids);
+    HOST_CHECK_EQUAL(Test_Running(), 0);
+    HOST_CHECK_EQUAL(Scheduler_ReadyBitmap, SCHEDULER_PRIORITY_BIT(SCHEDULER_IDLE_PRIORITY));
+}
+
+/* Tasks of the same priority share the CPU in slices, the lower priority waits */
+static void Test_RoundRobin(void)
+{
+    static const Scheduler_PriorityType Priorities[] = { 4, 4, 4, 9 };
+    Scheduler_TaskIdType Ids[4];
+    unsigned Slice;
+
+    Test_Start(Priorities, 4, Ids);
+    HOST_CHECK_EQUAL(Test_Running(), Ids[0]);
+
+    for(Slice = 0; Slice < 6; Slice++)
+    {
+        Test_Ticks(SCHEDULER_TIME_SLICE_TICKS - 1);
+        HOST_CHECK_EQUAL(Test_Running(), Ids[Slice % 3]);
+        Test_Ticks(1);
+        HOST_CHECK_EQUAL(Test_Running(), Ids[(Slice + 1) % 3]);
+    }
+
+    /* A yield hands the CPU over at once and the next task starts a full slice */
+    Scheduler_Yield();
+    (void)Test_TakePendSV();
+    HOST_CHECK_EQUAL(Test_Running(), Ids[1]);
+    Test_Ticks(SCHEDULER_TIME_SLICE_TICKS - 1);
+    HOST_CHECK_EQUAL(Test_Running(), Ids[1]);
+
+    /* A task alone at its level keeps the CPU after its slice */
+    Scheduler_Delay(1000);
+    (void)Test_TakePendSV();
+    Scheduler_Delay(1000);
+    (void)Test_TakePendSV();
+    HOST_CHECK_EQUAL(Test_Running(), Ids[0]);
+    Test_Ticks(3 * SCHEDULER_TIME_SLICE_TICKS);
+    HOST_CHECK_EQUAL(Test_Running(), Ids[0]);
+}
+
+/* Delayed tasks wake up after their ticks, a higher priority wake up preempts at once */
+static void Test_Delays(void)
+{
+    static const Scheduler_PriorityType Priorities[] = { 1, 3, 3 };
+    Scheduler_TaskIdType Ids[3];
+    Scheduler_StatsType Stats;
+    unsigned Switches;
+
+    Test_Start(Priorities, 3, Ids);
+    HOST_CHECK_EQUAL(Test_Running(), Ids[0]);
+
+    /* High sleeps 5 ticks, the two tasks below share the CPU meanwhile */
+    Scheduler_Delay(5);
+    HOST_CHECK(Test_TakePendSV());
+    HOST_CHECK_EQUAL(Test_Running(), Ids[1]);
+    HOST_CHECK_EQUAL(Scheduler_Tasks[Ids[0]].State, SCHEDULER_TASK_DELAYED);
+    Test_Ticks(4);
+    HOST_CHECK_EQUAL(Test_Running(), Ids[1]);
+    Test_Ticks(1);
+    HOST_CHECK_EQUAL(Test_Running(), Ids[0]);
+    HOST_CHECK_EQUAL(Scheduler_Tasks[Ids[0]].State, SCHEDULER_TASK_READY);
+
+    /* Every task waits: the idle task runs, the shortest delay wakes up first */
+    Scheduler_Delay(7);
+    (void)Test_TakePendSV();
+    HOST_CHECK_EQUAL(Test_Running(), Ids[1]);
+    Scheduler_Delay(2);
+    (void)Test_TakePendSV();
+    HOST_CHECK_EQUAL(Test_Running(), Ids[2]);
+    Scheduler_Delay(3);
+    (void)Test_TakePendSV();
+    HOST_CHECK_EQUAL(Test_Running(), 0);
+    Test_Ticks(2);
+    HOST_CHECK_EQUAL(Test_Running(), Ids[1]);
+    Test_Ticks(1);
+    HOST_CHECK_EQUAL(Test_Running(), Ids[1]);
+    HOST_CHECK_EQUAL(Scheduler_Tasks[Ids[2]].State, SCHEDULER_TASK_READY);
+    Test_Ticks(4);
+    HOST_CHECK_EQUAL(Test_Running(), Ids[0]);
+
+    /* A zero delay is a yield, the idle task cannot block */
+    Switches = Test_TraceSwitches;
+    Scheduler_Delay(0);
+    HOST_CHECK(Test_TakePendSV());
+    HOST_CHECK_EQUAL(Test_Running(), Ids[0]);
+    HOST_CHECK_EQUAL(Test_TraceSwitches, Switches + 1);
+    HOST_CHECK_EQUAL(Test_TraceLastTask, Ids[0]);
+
+    Scheduler_GetStats(&Stats);
+    HOST_CHECK_EQUAL(Stats.ContextSwitches, Scheduler_ContextSwitches);
+    HOST_CHECK(Stats.ContextSwitches >= 8);
+}
+
+/* Services called with the interrupts disabled leave them disabled, PendSV waits for the caller */
+static void Test_CriticalSections(void)
+{
+    static const Scheduler_PriorityType Priorities[] = { 2, 2 };
+    Scheduler_TaskIdType Ids[2];
+    Scheduler_StatsType Stats;
+    uint32 State;
+
+    Test_Start(Priorities, 2, Ids);
+
+    State = Enter_Critical();
+    Scheduler_Yield();
+    HOST_CHECK_EQUAL(Host_Primask, 1);
+    HOST_CHECK(!Test_TakePendSV());
+    Scheduler_GetStats(&Stats);
+    HOST_CHECK_EQUAL(Host_Primask, 1);
+    HOST_CHECK(Scheduler_CreateTask(Test_Entry, 6, Test_Stacks[2], TEST_STACK_WORDS) != SCHEDULER_INVALID_TASK);
+    HOST_CHECK_EQUAL(Host_Primask, 1);
+    Exit_Critical(State);
+    HOST_CHECK_EQUAL(Host_Primask, 0);
+    HOST_CHECK(Test_TakePendSV());
+    HOST_CHECK_EQUAL(Test_Running(), Ids[1]);
+
+    State = Enter_Critical();
+    Scheduler_Delay(3);
+    HOST_CHECK_EQUAL(Host_Primask, 1);
+    HOST_CHECK_EQUAL(Test_Running(), Ids[1]);
+    Exit_Critical(State);
+    HOST_CHECK(Test_TakePendSV());
+    HOST_CHECK_EQUAL(Test_Running(), Ids[0]);
+
+    /* Same services with the interrupts enabled */
+    Scheduler_GetStats(&Stats);
+    HOST_CHECK_EQUAL(Host_Primask, 0);
+    Scheduler_Yield();
+    HOST_CHECK_EQUAL(Host_Primask, 0);
+}
+
+/* Initial frame, create errors and MPU reloads */
+static void Test_Tasks(void)
+{
+    static const Scheduler_PriorityType Priorities[] = { 1, 2, 3, 4, 5, 6, 7 };
+    static Mpu_TaskRegionsType Regions;
+    Scheduler_TaskIdType Ids[7];
+    Scheduler_TaskType *Task;
+
+    Test_Start(Priorities, 7, Ids);
+    HOST_CHECK(Ids[6] != SCHEDULER_INVALID_TASK);
+    HOST_CHECK_EQUAL(Scheduler_CreateTask(Test_Entry, 8, Test_Stack7, TEST_STACK_WORDS), SCHEDULER_INVALID_TASK);
+
+    Task = &Scheduler_Tasks[Ids[0]];
+    HOST_CHECK_EQUAL(Task->StackPointer, (uint32 *)Test_Stack0 + TEST_STACK_WORDS - SCHEDULER_STACK_FRAME_WORDS);
+    HOST_CHECK_EQUAL(Task->StackPointer[8], SCHEDULER_EXC_RETURN_THREAD_PSP);
+    HOST_CHECK_EQUAL(Task->StackPointer[14], HOST_ADDRESS(Scheduler_TaskExit));
+    HOST_CHECK_EQUAL(Task->StackPointer[15], HOST_ADDRESS(Test_Entry));
+    HOST_CHECK_EQUAL(Task->StackPointer[16], SCHEDULER_INITIAL_XPSR);
+    HOST_CHECK_EQUAL(((uintptr_t)Task->StackPointer + SCHEDULER_STACK_FRAME_WORDS * 4u) & 7u, 0);
+
+    Scheduler_Init();
+    HOST_CHECK_EQUAL(Scheduler_CreateTask(NULL_PTR, 1, Test_Stack0, TEST_STACK_WORDS), SCHEDULER_INVALID_TASK);
+    HOST_CHECK_EQUAL(Scheduler_CreateTask(Test_Entry, 1, NULL_PTR, TEST_STACK_WORDS), SCHEDULER_INVALID_TASK);
+    HOST_CHECK_EQUAL(Scheduler_CreateTask(Test_Entry, SCHEDULER_PRIORITY_LEVELS, Test_Stack0, TEST_STACK_WORDS),
+                     SCHEDULER_INVALID_TASK);
+    HOST_CHECK_EQUAL(Scheduler_CreateTask(Test_Entry, 1, Test_Stack0, SCHEDULER_STACK_FRAME_WORDS), SCHEDULER_INVALID_TASK);
+
+    /* Only the switches between tasks with different regions reload the MPU */
+    Test_Start(Priorities, 2, Ids);
+    HOST_CHECK_EQUAL(Test_MpuLoads, 0);
+    Scheduler_SetTaskRegions(Ids[1], &Regions);
+    Scheduler_Delay(2);
+    (void)Test_TakePendSV();
+    HOST_CHECK_EQUAL(Test_Running(), Ids[1]);
+    HOST_CHECK_EQUAL(Test_MpuLoads, 1);
+    Test_Ticks(2);
+    HOST_CHECK_EQUAL(Test_Running(), Ids[0]);
+    HOST_CHECK_EQUAL(Test_MpuLoads, 2);
+    Scheduler_Yield();
+    (void)Test_TakePendSV();
+    HOST_CHECK_EQUAL(Test_MpuLoads, 2);
+}
+
+int main(void)
+{
+    Test_BitmapPick();
+    Test_RoundRobin();
+    Test_Delays();
+    Test_CriticalSections();
+    Test_Tasks();
+
+    return Host_Report("scheduler_test");
+}
@@ -0,0 +1,274 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: trace_decode.c
+ *
+ * Description: Host decoder for the dumps of the Trace module (NVIC_Driver/TRACE.h).
+ *              Converts the binary Trace_Buffer dump into a human readable timeline
+ *              or into a Chrome trace-event JSON file (chrome://tracing, Perfetto).
+ *
+ *              Build : gcc -O2 -o trace_decode trace_decode.c
+ *              Usage : trace_decode [--json] <dump.bin>
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+/* Must match TRACE.h */
+#define TRACE_MAGIC                 0x31435254u
+#define TRACE_HEADER_SIZE           24u
+#define TRACE_EVENT_BITS_POS        28
+#define TRACE_ID_BITS_POS           20
+#define TRACE_ID_MASK               0xFFu
+#define TRACE_TIMESTAMP_MASK        0x000FFFFFu
+
+enum
+{
+    TRACE_EVENT_SYNC,
+    TRACE_EVENT_ISR_ENTER,
+    TRACE_EVENT_ISR_EXIT,
+    TRACE_EVENT_TASK_SWITCH,
+    TRACE_EVENT_USER,
+    TRACE_EVENT_IRQ_THROTTLE,
+    TRACE_EVENT_IRQ_RESUME
+};
+
+typedef struct
+{
+    uint32_t Capacity;
+    uint32_t WriteIndex;
+    uint32_t Dropped;
+    uint32_t CoreClockHz;
+    uint8_t  Policy;
+}Trace_Header;
+
+static const char *const Core_ExceptionNames[16] =
+{
+    "Thread", "Reset", "NMI", "HardFault", "MemManage", "BusFault", "UsageFault", "Reserved7",
+    "Reserved8", "Reserved9", "Reserved10", "SVCall", "DebugMonitor", "Reserved13", "PendSV", "SysTick"
+};
+
+static uint32_t Read32(const uint8_t *a_Bytes)
+{
+    return (uint32_t)a_Bytes[0] | ((uint32_t)a_Bytes[1] << 8) | ((uint32_t)a_Bytes[2] << 16) | ((uint32_t)a_Bytes[3] << 24);
+}
+
+static void Exception_Name(uint8_t a_Num, char *a_Name, size_t a_Size)
+{
+    if(a_Num < 16)
+    {
+        snprintf(a_Name, a_Size, "%s", Core_ExceptionNames[a_Num]);
+    }
+    else
+    {
+        snprintf(a_Name, a_Size, "IRQ %u", (unsigned)(a_Num - 16));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int Json = 0;
+    const char *Path = NULL;
+    FILE *File;
+    long Size;
+    uint8_t *Dump;
+    Trace_Header Header;
+    uint32_t Count, First, Index, Skipped;
+    uint64_t High = 0, Base = 0;
+    uint32_t PrevLow = 0;
+    int HaveBase = 0, FirstEvent = 1;
+    int Arg;
+
+    for(Arg = 1; Arg < argc; Arg++)
+    {
+        if(strcmp(argv[Arg], "--json") == 0)
+        {
+            Json = 1;
+        }
+        else
+        {
+            Path = argv[Arg];
+        }
+    }
+    if(Path == NULL)
+    {
+        fprintf(stderr, "usage: %s [--json] <dump.bin>\n", argv[0]);
+        return 2;
+    }
+
+    File = fopen(Path, "rb");
+    if(File == NULL)
+    {
+        perror(Path);
+        return 1;
+    }
+    fseek(File, 0, SEEK_END);
+    Size = ftell(File);
+    fseek(File, 0, SEEK_SET);
+    Dump = malloc((size_t)Size);
+    if((Dump == NULL) || (fread(Dump, 1, (size_t)Size, File) != (size_t)Size))
+    {
+        fprintf(stderr, "%s: read error\n", Path);
+        return 1;
+    }
+    fclose(File);
+
+    if((Size < (long)TRACE_HEADER_SIZE) || (Read32(Dump) != TRACE_MAGIC))
+    {
+        fprintf(stderr, "%s: not a trace dump (bad magic)\n", Path);
+        return 1;
+    }
+    Header.Capacity    = Read32(Dump + 4);
+    Header.WriteIndex  = Read32(Dump + 8);
+    Header.Dropped     = Read32(Dump + 12);
+    Header.CoreClockHz = Read32(Dump + 16);
+    Header.Policy      = Dump[20];
+    if((Header.Capacity == 0) || ((uint64_t)Size < TRACE_HEADER_SIZE + (uint64_t)Header.Capacity * 4u))
+    {
+        fprintf(stderr, "%s: truncated dump\n", Path);
+        return 1;
+    }
+    if((Header.Capacity & (Header.Capacity - 1u)) != 0)
+    {
+        /* TRACE.c only builds with a power of 2 ring, the slots are found by masking */
+        fprintf(stderr, "%s: capacity %u is not a power of 2, corrupt or foreign dump\n", Path, (unsigned)Header.Capacity);
+        return 1;
+    }
+    if(Header.CoreClockHz == 0)
+    {
+        Header.CoreClockHz = 16000000u;
+    }
+
+    /* Oldest record first, the ring wrapped if more records than slots were written */
+    Count = (Header.WriteIndex < Header.Capacity) ? Header.WriteIndex : Header.Capacity;
+    First = Header.WriteIndex - Count;
+
+    /* Trace_Init starts with a sync record, an overwritten ring lost it: the records before the
+       first sync left have no high time stamp bits and are skipped */
+    for(Skipped = 0; Skipped < Count; Skipped++)
+    {
+        if((Read32(Dump + TRACE_HEADER_SIZE + ((First + Skipped) & (Header.Capacity - 1u)) * 4u) >> TRACE_EVENT_BITS_POS)
+           == TRACE_EVENT_SYNC)
+        {
+            break;
+        }
+    }
+
+    if(Json)
+    {
+        printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    }
+    else
+    {
+        printf("# %u records, %u dropped, %u Hz, policy %s\n", (unsigned)Count, (unsigned)Header.Dropped,
+               (unsigned)Header.CoreClockHz, (Header.Policy == 0) ? "overwrite" : "stop-when-full");
+        if(Skipped != 0)
+        {
+            printf("# %u records before the first sync skipped, their time is unknown\n", (unsigned)Skipped);
+        }
+        printf("# %14s  %-12s %s\n", "time [us]", "event", "source");
+    }
+    if(Json && (Skipped != 0))
+    {
+        fprintf(stderr, "%s: %u records before the first sync skipped, their time is unknown\n", Path, (unsigned)Skipped);
+    }
+
+    for(Index = Skipped; Index < Count; Index++)
+    {
+        uint32_t Slot   = (First + Index) & (Header.Capacity - 1u);
+        uint32_t Record = Read32(Dump + TRACE_HEADER_SIZE + Slot * 4u);
+        uint32_t Event  = Record >> TRACE_EVENT_BITS_POS;
+        uint8_t  Id     = (uint8_t)((Record >> TRACE_ID_BITS_POS) & TRACE_ID_MASK);
+        uint32_t Low    = Record & TRACE_TIMESTAMP_MASK;
+        uint64_t Cycles;
+        double   Micros;
+        char     Name[32];
+
+        if(Event == TRACE_EVENT_SYNC)
+        {
+            /* The time stamp field holds bits 31..20 of the following record */
+            uint64_t Sync = (uint64_t)Low << TRACE_ID_BITS_POS;
+
+            if(Sync < (High & 0xFFFFFFFFull))
+            {
+                High += 0x100000000ull; /* The 32-bit cycle counter wrapped */
+            }
+            High    = (High & ~0xFFFFFFFFull) | Sync;
+            PrevLow = 0;
+            continue;
+        }
+        if(Low < PrevLow)
+        {
+            High += (uint64_t)TRACE_TIMESTAMP_MASK + 1u;
+        }
+        PrevLow = Low;
+        Cycles  = High + Low;
+        if(!HaveBase)
+        {
+            Base     = Cycles;
+            HaveBase = 1;
+        }
+        Micros = (double)(Cycles - Base) * 1e6 / (double)Header.CoreClockHz;
+
+        switch(Event)
+        {
+        case TRACE_EVENT_ISR_ENTER   :
+        case TRACE_EVENT_ISR_EXIT    : Exception_Name(Id, Name, sizeof(Name)); break;
+        case TRACE_EVENT_TASK_SWITCH : snprintf(Name, sizeof(Name), "Task %u", (unsigned)Id); break;
+        case TRACE_EVENT_IRQ_THROTTLE:
+        case TRACE_EVENT_IRQ_RESUME  : snprintf(Name, sizeof(Name), "IRQ %u", (unsigned)Id); break;
+        default                      : snprintf(Name, sizeof(Name), "User %u", (unsigned)Id); break;
+        }
+
+        if(Json)
+        {
+            const char *Phase = "i";
+            const char *Thread = "ISR";
+
+            if(Event == TRACE_EVENT_ISR_ENTER)
+            {
+                Phase = "B";
+            }
+            else if(Event == TRACE_EVENT_ISR_EXIT)
+            {
+                Phase = "E";
+            }
+            else if(Event == TRACE_EVENT_TASK_SWITCH)
+            {
+                Thread = "Tasks";
+            }
+            else if((Event == TRACE_EVENT_IRQ_THROTTLE) || (Event == TRACE_EVENT_IRQ_RESUME))
+            {
+                Thread = "Governor";
+            }
+            else
+            {
+                Thread = "User";
+            }
+            printf("%s{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":0,\"tid\":\"%s\"%s}",
+                   FirstEvent ? "" : ",\n", Name, Phase, Micros, Thread,
+                   (Phase[0] == 'i') ? ",\"s\":\"t\"" : "");
+            FirstEvent = 0;
+        }
+        else
+        {
+            static const char *const EventNames[] = { "sync", "isr-enter", "isr-exit", "task-switch", "user",
+                                                     "irq-throttle", "irq-resume" };
+
+            printf("  %14.3f  %-12s %s\n", Micros, (Event <= TRACE_EVENT_IRQ_RESUME) ? EventNames[Event] : "unknown", Name);
+        }
+    }
+
+    if(Json)
+    {
+        printf("\n]}\n");
+    }
+    free(Dump);
+    return 0;
+}
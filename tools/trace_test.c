@@ -0,0 +1,399 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: trace_test.c
+ *
+ * Description: Host test of NVIC_Driver/TRACE.c and of the decoder tools/trace_decode.c. The
+ *              cycle counter is a 64-bit simulated time whose low 32 bits are read by the
+ *              driver, the test records user events at chosen intervals, dumps Trace_Buffer
+ *              and runs the decoder command line on the dump with its output captured.
+ *
+ *              Checks : stop-when-full ring keeping the first records and counting the dropped
+ *                       ones, overwritten ring skipping the records before the first sync left,
+ *                       intervals of 2^20 cycles and more (sync records), the 20-bit time stamp
+ *                       and the 32-bit counter wrapping, decoded times equal to the recorded
+ *                       ones relative to the first decoded event, JSON output.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : trace_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include <math.h>
+#include <stdarg.h>
+#include <unistd.h>
+
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+
+static uint64 Test_Now;                   /* Cycles, the counter is the low 32 bits */
+static uint32 Test_Demcr;
+static uint32 Test_DwtCtrl;
+
+#undef DWT_CYCCNT_REG
+#undef DWT_CTRL_REG
+#undef CORE_DEBUG_DEMCR_REG
+#define DWT_CYCCNT_REG              ((uint32)Test_Now)
+#define DWT_CTRL_REG                Test_DwtCtrl
+#define CORE_DEBUG_DEMCR_REG        Test_Demcr
+
+#include "TRACE.c"
+
+#define TEST_CLOCK_HZ               80000000u
+#define TEST_OUTPUT_SIZE            (512 * 1024)
+#define TEST_MAX_EVENTS             4096
+#define TEST_MAX_RECORDS            (2 * TEST_MAX_EVENTS + 1)
+#define TEST_NO_RECORD              0xFFFFFFFFu
+#define TEST_TOLERANCE_US           0.0006  /* Times are printed in us with 3 decimals */
+
+typedef struct
+{
+    uint64 Time;
+    uint32 Index;                         /* Write index of the record, TEST_NO_RECORD if dropped */
+    uint8  Code;
+}Test_EventType;
+
+static Test_EventType Test_Events[TEST_MAX_EVENTS];
+static uint32 Test_EventCount;
+static boolean Test_IsSync[TEST_MAX_RECORDS];
+static uint32 Test_Random = 12345;
+
+static char Test_Output[TEST_OUTPUT_SIZE];
+static size_t Test_OutputLength;
+
+/*******************************************************************************
+ *                                Decoder                                      *
+ *******************************************************************************/
+
+static int Test_Printf(const char *a_Format, ...)
+{
+    va_list Args;
+    int Length;
+
+    va_start(Args, a_Format);
+    Length = vsnprintf(Test_Output + Test_OutputLength, sizeof(Test_Output) - Test_OutputLength, a_Format, Args);
+    va_end(Args);
+    if(Length > 0)
+    {
+        Test_OutputLength += (size_t)Length;
+        if(Test_OutputLength >= sizeof(Test_Output))
+        {
+            Test_OutputLength = sizeof(Test_Output) - 1;
+        }
+    }
+    return Length;
+}
+
+/* The decoder has its own copy of the record layout */
+#undef TRACE_MAGIC
+#undef TRACE_EVENT_BITS_POS
+#undef TRACE_ID_BITS_POS
+#undef TRACE_ID_MASK
+#undef TRACE_TIMESTAMP_MASK
+#define TRACE_EVENT_SYNC            Decode_EventSync
+#define TRACE_EVENT_ISR_ENTER       Decode_EventIsrEnter
+#define TRACE_EVENT_ISR_EXIT        Decode_EventIsrExit
+#define TRACE_EVENT_TASK_SWITCH     Decode_EventTaskSwitch
+#define TRACE_EVENT_USER            Decode_EventUser
+#define TRACE_EVENT_IRQ_THROTTLE    Decode_EventIrqThrottle
+#define TRACE_EVENT_IRQ_RESUME      Decode_EventIrqResume
+#define printf                      Test_Printf
+#define main                        Trace_Decode_Main
+#include "trace_decode.c"
+#undef main
+#undef printf
+#undef TRACE_EVENT_SYNC
+#undef TRACE_EVENT_ISR_ENTER
+#undef TRACE_EVENT_ISR_EXIT
+#undef TRACE_EVENT_TASK_SWITCH
+#undef TRACE_EVENT_USER
+#undef TRACE_EVENT_IRQ_THROTTLE
+#undef TRACE_EVENT_IRQ_RESUME
+
+/* Decode a dump of Trace_Buffer with the decoder command line, --json if a_Json */
+static int Test_DecodeDump(boolean a_Json)
+{
+    char Path[] = "/tmp/trace_testXXXXXX";
+    char *Argv[] = { "trace_decode", Path, NULL, NULL };
+    int Descriptor = mkstemp(Path);
+    int Status;
+
+    Test_OutputLength = 0;
+    Test_Output[0]    = '\0';
+    if(Descriptor < 0)
+    {
+        HOST_CHECK(Descriptor >= 0);
+        return -1;
+    }
+    HOST_CHECK(write(Descriptor, (const void *)&Trace_Buffer, sizeof(Trace_Buffer)) == (ssize_t)sizeof(Trace_Buffer));
+    close(Descriptor);
+    if(a_Json)
+    {
+        Argv[1] = "--json";
+        Argv[2] = Path;
+    }
+    Status = Trace_Decode_Main(a_Json ? 3 : 2, Argv);
+    unlink(Path);
+    return Status;
+}
+
+/*******************************************************************************
+ *                        Modules used by the driver                           *
+ *******************************************************************************/
+
+uint32 Clock_GetCoreClock(void)
+{
+    return TEST_CLOCK_HZ;
+}
+
+void Clock_RegisterNotifier(Clock_NotifierType a_Notifier)
+{
+    (void)a_Notifier;
+}
+
+/*******************************************************************************
+ *                                 Helpers                                     *
+ *******************************************************************************/
+
+static uint32 Test_Rand(uint32 a_Range)
+{
+    Test_Random = Test_Random * 1103515245u + 12345u;
+    return (Test_Random >> 8) % a_Range;
+}
+
+static void Test_Init(Trace_PolicyType a_Policy)
+{
+    Test_Now        = 0x0123456789ull;
+    Test_EventCount = 0;
+    memset(Test_IsSync, 0, sizeof(Test_IsSync));
+    Trace_Init(a_Policy);
+}
+
+/* Advance the time by a_Delta cycles and record user event a_Code, note the records it wrote */
+static void Test_Record(uint64 a_Delta, uint8 a_Code)
+{
+    Test_EventType *Event = &Test_Events[Test_EventCount++];
+    uint32 Index = Trace_Buffer.Header.WriteIndex;
+    uint32 Record;
+
+    Test_Now += a_Delta;
+    TRACE_USER(a_Code);
+
+    Event->Time  = Test_Now;
+    Event->Code  = a_Code;
+    Event->Index = TEST_NO_RECORD;
+    for(; Index < Trace_Buffer.Header.WriteIndex; Index++)
+    {
+        Record = Trace_Buffer.Records[Index & (TRACE_BUFFER_RECORDS - 1)];
+        Test_IsSync[Index] = ((Record >> TRACE_EVENT_BITS_POS) == TRACE_EVENT_SYNC) ? TRUE : FALSE;
+        if(!Test_IsSync[Index])
+        {
+            Event->Index = Index;
+        }
+    }
+}
+
+/* Decode the dump and compare with the events recorded after the first sync left in the ring,
+   returns the number of events decoded */
+static uint32 Test_Compare(uint32 *a_Skipped)
+{
+    uint32 Written = Trace_Buffer.Header.WriteIndex;
+    uint32 Oldest = (Written > TRACE_BUFFER_RECORDS) ? (Written - TRACE_BUFFER_RECORDS) : 0;
+    uint32 FirstSync = Oldest;
+    const char *Line = Test_Output;
+    const Test_EventType *Base = NULL_PTR;
+    uint32 Event = 0;
+    uint32 Decoded = 0;
+    uint32 Mismatches = 0;
+    unsigned Code;
+    unsigned Skipped;
+    int Matched;
+    double Micros;
+    double Expected;
+
+    while((FirstSync < Written) && !Test_IsSync[FirstSync])
+    {
+        FirstSync++;
+    }
+    *a_Skipped = FirstSync - Oldest;
+
+    HOST_CHECK_EQUAL(Test_DecodeDump(FALSE), 0);
+    while(*Line != '\0')
+    {
+        Matched = 0;
+        (void)sscanf(Line, "# %u records before the first sync skipped%n", &Skipped, &Matched);
+        if(Matched != 0)
+        {
+            HOST_CHECK_EQUAL(Skipped, *a_Skipped);
+        }
+        else if(sscanf(Line, " %lf user User %u", &Micros, &Code) == 2)
+        {
+            /* Next recorded event that the ring kept after its first sync */
+            while((Event < Test_EventCount) &&
+                  ((Test_Events[Event].Index == TEST_NO_RECORD) || (Test_Events[Event].Index <= FirstSync) ||
+                   (Test_Events[Event].Index < Oldest)))
+            {
+                Event++;
+            }
+            if(Event == Test_EventCount)
+            {
+                Mismatches++;
+                break;
+            }
+            if(Base == NULL_PTR)
+            {
+                Base = &Test_Events[Event];
+            }
+            Expected = (double)(Test_Events[Event].Time - Base->Time) * 1e6 / TEST_CLOCK_HZ;
+            if((Code != Test_Events[Event].Code) || (fabs(Micros - Expected) > TEST_TOLERANCE_US))
+            {
+                if(Mismatches == 0)
+                {
+                    fprintf(stderr, "event %u: decoded %.3f us code %u, recorded %.4f us code %u\n",
+                            Event, Micros, Code, Expected, Test_Events[Event].Code);
+                }
+                Mismatches++;
+            }
+            Event++;
+            Decoded++;
+        }
+        Line = strchr(Line, '\n');
+        if(Line == NULL)
+        {
+            break;
+        }
+        Line++;
+    }
+    HOST_CHECK_EQUAL(Mismatches, 0);
+
+    /* No recorded event left out */
+    while((Event < Test_EventCount) && (Test_Events[Event].Index == TEST_NO_RECORD))
+    {
+        Event++;
+    }
+    HOST_CHECK_EQUAL(Event, Test_EventCount);
+    return Decoded;
+}
+
+/*******************************************************************************
+ *                                 Tests                                       *
+ *******************************************************************************/
+
+/* The first records are kept, the sync of Trace_Init is the first of them */
+static void Test_StopWhenFull(void)
+{
+    uint32 Skipped;
+    uint32 Index;
+
+    Test_Init(TRACE_POLICY_STOP_WHEN_FULL);
+    for(Index = 0; Index < 600; Index++)
+    {
+        Test_Record(100 + Test_Rand(20000), (uint8)Index);
+    }
+    HOST_CHECK_EQUAL(Trace_Buffer.Header.WriteIndex, TRACE_BUFFER_RECORDS);
+    HOST_CHECK_EQUAL(Trace_Buffer.Header.Dropped, 600 + 1 - TRACE_BUFFER_RECORDS);
+    HOST_CHECK_EQUAL(Test_Compare(&Skipped), TRACE_BUFFER_RECORDS - 1);
+    HOST_CHECK_EQUAL(Skipped, 0);
+    HOST_CHECK(strstr(Test_Output, "# 512 records, 89 dropped, 80000000 Hz, policy stop-when-full\n") != NULL);
+}
+
+/* The ring wrapped: the oldest records left come before the first sync left and are skipped */
+static void Test_Overwrite(void)
+{
+    uint32 Skipped;
+    uint32 Decoded;
+    uint32 Index;
+    uint32 Syncs = 0;
+
+    Test_Init(TRACE_POLICY_OVERWRITE);
+    for(Index = 0; Index < 2000; Index++)
+    {
+        /* Mostly below 2^20 cycles, the 20-bit time stamp wraps without a sync */
+        Test_Record(((Index % 97) == 50) ? (TRACE_TIMESTAMP_RANGE + Test_Rand(1000000)) : Test_Rand(300000),
+                    (uint8)Index);
+    }
+    for(Index = 0; Index < Trace_Buffer.Header.WriteIndex; Index++)
+    {
+        Syncs += Test_IsSync[Index];
+    }
+    HOST_CHECK(Syncs > 20);
+    HOST_CHECK_EQUAL(Trace_Buffer.Header.Dropped, 0);
+
+    Decoded = Test_Compare(&Skipped);
+    HOST_CHECK(Skipped > 0);
+    HOST_CHECK(strstr(Test_Output, "# 512 records, 0 dropped, 80000000 Hz, policy overwrite\n") != NULL);
+    Syncs = 0;
+    for(Index = Trace_Buffer.Header.WriteIndex - TRACE_BUFFER_RECORDS + Skipped; Index < Trace_Buffer.Header.WriteIndex; Index++)
+    {
+        Syncs += Test_IsSync[Index];
+    }
+    HOST_CHECK_EQUAL(Decoded, TRACE_BUFFER_RECORDS - Skipped - Syncs);
+}
+
+/* Intervals around and far above 2^20 cycles, the 32-bit counter wraps several times */
+static void Test_LongIntervals(void)
+{
+    static const uint64 Deltas[] =
+    {
+        1, TRACE_TIMESTAMP_RANGE - 1, TRACE_TIMESTAMP_RANGE, TRACE_TIMESTAMP_RANGE + 1, 5 * TRACE_TIMESTAMP_RANGE + 7,
+        0x80000000ull, 3 * 0x40000000ull, 12, 0xFFFFFull, 0x100000000ull - 2 * TRACE_TIMESTAMP_RANGE, 0
+    };
+    uint32 Skipped;
+    uint32 Round;
+    uint32 Index;
+
+    Test_Init(TRACE_POLICY_OVERWRITE);
+    for(Round = 0; Round < 20; Round++)
+    {
+        for(Index = 0; Index < sizeof(Deltas) / sizeof(Deltas[0]); Index++)
+        {
+            Test_Record(Deltas[Index], (uint8)(Round * 16 + Index));
+        }
+    }
+    HOST_CHECK(Test_Now > 0x1000000000ull);
+    HOST_CHECK(Trace_Buffer.Header.WriteIndex < TRACE_BUFFER_RECORDS);
+    HOST_CHECK_EQUAL(Test_Compare(&Skipped), 20 * sizeof(Deltas) / sizeof(Deltas[0]));
+    HOST_CHECK_EQUAL(Skipped, 0);
+}
+
+/* Same events in the JSON output, without the skipped records */
+static void Test_Json(void)
+{
+    static const char Start[] = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n{\"name\":\"User ";
+    const char *Text;
+    uint32 Events = 0;
+    uint32 Skipped;
+    uint32 Index;
+
+    Test_Init(TRACE_POLICY_OVERWRITE);
+    for(Index = 0; Index < 1000; Index++)
+    {
+        Test_Record(((Index % 61) == 30) ? (2 * TRACE_TIMESTAMP_RANGE) : 5000, (uint8)Index);
+    }
+    Index = Test_Compare(&Skipped);
+    HOST_CHECK(Skipped > 0);
+
+    HOST_CHECK_EQUAL(Test_DecodeDump(TRUE), 0);
+    for(Text = strstr(Test_Output, "\"ph\":\"i\""); Text != NULL; Text = strstr(Text + 1, "\"ph\":\"i\""))
+    {
+        Events++;
+    }
+    HOST_CHECK_EQUAL(Events, Index);
+    HOST_CHECK(strncmp(Test_Output, Start, strlen(Start)) == 0);
+    HOST_CHECK(strstr(Test_Output, "\"ts\":0.000,") != NULL);
+}
+
+int main(void)
+{
+    Test_StopWhenFull();
+    Test_Overwrite();
+    Test_LongIntervals();
+    Test_Json();
+
+    return Host_Report("trace_test");
+}
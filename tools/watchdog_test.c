@@ -0,0 +1,474 @@
+/******************************************************************************
+ *
+ * Module: Host Tools
+ *
+ * File Name: watchdog_test.c
+ *
+ * Description: Host test of NVIC_Driver/WATCHDOG.c against a simulated WDT0. The counter counts
+ *              core clocks down one millisecond at a time, any write of ICR reloads it, the
+ *              first time-out raises the NMI and the second one resets the core. The reset
+ *              clears the driver state but the .noinit report, as the startup code would, and
+ *              the clients check in from a schedule played by the test. A stuck ISR keeps the
+ *              SysTick hook from running and stays active in the NVIC until the reset.
+ *
+ *              Checks : WDT0 configuration, fed on every healthy tick and left locked, late and
+ *                       early check-ins latched with the client, the feeding stopped at the first
+ *                       fault, NMI after one time-out and reset after two, the report read back
+ *                       after the reset only, the exception a stuck ISR, system handler or hard
+ *                       fault was running, reload rescaled on a clock change, time-outs beyond
+ *                       the 32-bit counter rejected or cut to it, rejected arguments.
+ *
+ *              Build : make (see Makefile)
+ *              Usage : watchdog_test
+ *
+ *              Exit status is 0 when every check passes and 2 otherwise.
+ *
+ * Author: Muhamed Amr
+ *
+ *******************************************************************************/
+
+#include "host.h"
+#include "tm4c123gh6pm_registers.h"
+
+static WDT_RegType Test_Wdt[2];
+static NVIC_RegType Test_Nvic;
+static SCB_RegType Test_Scb;
+static uint32 Test_Rcgc;
+static uint32 Test_Resc;
+static boolean Test_InNmi;
+
+#undef WDT
+#undef NVIC_REGS
+#undef SCB_REGS
+#undef SYSCTL_RCGCWD_REG
+#undef SYSCTL_PRWD_REG
+#undef SYSCTL_RESC_REG
+#define WDT(Wdt)                    (&Test_Wdt[(Wdt)])
+#define NVIC_REGS                   (&Test_Nvic)
+#define SCB_REGS                    (&Test_Scb)
+#define SYSCTL_RCGCWD_REG           Test_Rcgc
+#define SYSCTL_PRWD_REG             Test_Rcgc
+#define SYSCTL_RESC_REG             Test_Resc
+
+/* NMI_Handler waits for the reset in an endless loop, the loops of the driver end once the NMI ran.
+   The report goes to .noinit with a pragma of the TI compiler */
+#define while(Condition)            while((Condition) && !Test_InNmi)
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+#include "WATCHDOG.c"
+#undef while
+
+#define TEST_CLOCK_HZ               16000000
+#define TEST_TIMEOUT_MS             100
+#define TEST_ICR_IDLE               0xFFFFFFFF  /* ICR between two writes, any write changes it */
+#define TEST_RETTOBASE_MASK         0x00000800
+
+static uint32 Test_Clock = TEST_CLOCK_HZ;
+static uint32 Test_Tick;
+static SysTick_TickHookType Test_TickHook;
+static Clock_NotifierType Test_Notifier;
+
+/* Simulated WDT0 */
+static uint32 Test_Load;
+static uint32 Test_Feeds;
+static uint32 Test_Unlocked;
+static uint32 Test_Nmis;
+static uint32 Test_NmiTick;
+static uint32 Test_Resets;
+static uint32 Test_ResetTick;
+
+/* Clients played by the test: check-in period in ticks, 0 once stuck */
+#define TEST_MAX_CLIENTS            4
+
+static uint32 Test_Periods[TEST_MAX_CLIENTS];
+static Watchdog_ClientType Test_Handles[TEST_MAX_CLIENTS];
+static uint32 Test_ClientsCount;
+static boolean Test_SysTickMasked;
+
+/*******************************************************************************
+ *                        Modules used by the driver                           *
+ *******************************************************************************/
+
+uint32 Clock_GetCoreClock(void)
+{
+    return Test_Clock;
+}
+
+void Clock_RegisterNotifier(Clock_NotifierType a_Notifier)
+{
+    Test_Notifier = a_Notifier;
+}
+
+void SysTick_RegisterTickHook(SysTick_TickHookType a_Hook)
+{
+    Test_TickHook = a_Hook;
+}
+
+uint32 SysTick_GetTickCount(void)
+{
+    return Test_Tick;
+}
+
+/*******************************************************************************
+ *                                 WDT0 model                                  *
+ *******************************************************************************/
+
+/* Effects of the register writes of the driver since the last call */
+static void Test_Sync(void)
+{
+    volatile WDT_RegType *Wdt = &Test_Wdt[WATCHDOG_TIMER];
+
+    if(Wdt->LOAD != Test_Load)
+    {
+        Test_Load  = Wdt->LOAD;
+        Wdt->VALUE = Wdt->LOAD; /* A new LOAD restarts the count */
+    }
+    if(Wdt->ICR != TEST_ICR_IDLE)
+    {
+        Wdt->VALUE = Wdt->LOAD;
+        Wdt->RIS   = 0;
+        Wdt->MIS   = 0;
+        Wdt->ICR   = TEST_ICR_IDLE;
+        Test_Feeds++;
+    }
+    if(Wdt->LOCK == WATCHDOG_UNLOCK_KEY)
+    {
+        Test_Unlocked++; /* Left unlocked by the driver */
+    }
+}
+
+/* Power on: everything cleared, the .noinit report holds what was there */
+static void Test_PowerOn(uint32 a_Resc)
+{
+    memset(Test_Wdt, 0, sizeof(Test_Wdt));
+    memset(&Test_Nvic, 0, sizeof(Test_Nvic));
+    memset(&Test_Scb, 0, sizeof(Test_Scb));
+    Test_Scb.INTCTRL = TEST_RETTOBASE_MASK; /* Thread mode, the NMI would be the only active exception */
+    Test_Wdt[WATCHDOG_TIMER].ICR = TEST_ICR_IDLE;
+    Test_Rcgc = 0;
+    Test_Resc = a_Resc;
+    Test_Load = 0;
+
+    memset(&Watchdog_LastReport, 0, sizeof(Watchdog_LastReport));
+    memset(Watchdog_Clients, 0, sizeof(Watchdog_Clients));
+    Watchdog_LastReportValid = FALSE;
+    Watchdog_ClientsCount    = 0;
+    Watchdog_TimeoutMs       = 0;
+
+    Test_TickHook      = NULL_PTR;
+    Test_Notifier      = NULL_PTR;
+    Test_Clock         = TEST_CLOCK_HZ;
+    Test_ClientsCount  = 0;
+    Test_SysTickMasked = FALSE;
+    Test_Feeds         = 0;
+    Test_Unlocked      = 0;
+    Test_Nmis          = 0;
+    Test_Resets        = 0;
+    Test_InNmi         = FALSE;
+}
+
+/* One millisecond: check-ins, WDT0 counting, then the SysTick tick. FALSE once WDT0 reset the core */
+static boolean Test_Millisecond(void)
+{
+    volatile WDT_RegType *Wdt = &Test_Wdt[WATCHDOG_TIMER];
+    uint32 Clocks = Test_Clock / 1000;
+    uint32 Client;
+
+    Test_Tick++;
+    for(Client = 0; Client < Test_ClientsCount; Client++)
+    {
+        if((Test_Periods[Client] != 0) && ((Test_Tick % Test_Periods[Client]) == 0))
+        {
+            Watchdog_CheckIn(Test_Handles[Client]);
+        }
+    }
+
+    if(Wdt->CTL & WATCHDOG_CTL_INTEN_MASK)
+    {
+        if(Wdt->VALUE > Clocks)
+        {
+            Wdt->VALUE -= Clocks;
+        }
+        else if(Wdt->RIS == 0)
+        {
+            Wdt->VALUE = Wdt->LOAD;
+            Wdt->RIS   = 1;
+            Wdt->MIS   = 1;
+            if(Wdt->CTL & WATCHDOG_CTL_INTTYPE_MASK)
+            {
+                Test_Nmis++;
+                Test_NmiTick = Test_Tick;
+                Test_InNmi   = TRUE; /* Never returns on the target, the core waits for the reset */
+                NMI_Handler();
+            }
+        }
+        else if(Wdt->CTL & WATCHDOG_CTL_RESEN_MASK)
+        {
+            Test_Resets++;
+            Test_ResetTick = Test_Tick;
+            return FALSE;
+        }
+    }
+
+    if(!Test_SysTickMasked && !Test_InNmi && (Test_TickHook != NULL_PTR))
+    {
+        Test_TickHook();
+    }
+    Test_Sync();
+    return TRUE;
+}
+
+/* At most a_Ms milliseconds, FALSE if WDT0 reset the core */
+static boolean Test_Run(uint32 a_Ms)
+{
+    while(a_Ms-- != 0)
+    {
+        if(!Test_Millisecond())
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static void Test_Client(Watchdog_ClientKindType a_Kind, uint8 a_Ident, uint16 a_Min, uint16 a_Max, uint32 a_Period)
+{
+    Test_Handles[Test_ClientsCount] = Watchdog_Register(a_Kind, a_Ident, a_Min, a_Max);
+    Test_Periods[Test_ClientsCount] = a_Period;
+    Test_ClientsCount++;
+}
+
+/* Start after power on, with a task of priority 3 every 10 ticks and IRQ 21 every 2 ticks */
+static void Test_Start(uint32 a_Resc)
+{
+    Test_PowerOn(a_Resc);
+    HOST_CHECK(Watchdog_Init(TEST_TIMEOUT_MS, 1));
+    Test_Sync();
+    Test_Client(WATCHDOG_CLIENT_TASK, 3, 5, 20, 10);
+    Test_Client(WATCHDOG_CLIENT_ISR, 21, 1, 5, 2);
+}
+
+/*******************************************************************************
+ *                                 Tests                                       *
+ *******************************************************************************/
+
+static void Test_Healthy(void)
+{
+    volatile WDT_RegType *Wdt = &Test_Wdt[WATCHDOG_TIMER];
+    Watchdog_ReportType Report;
+
+    Test_Tick = 1000;
+    Test_Start(0);
+    HOST_CHECK_EQUAL(Test_Rcgc & WATCHDOG_RCGC_MASK, WATCHDOG_RCGC_MASK);
+    HOST_CHECK_EQUAL(Wdt->LOAD, TEST_TIMEOUT_MS * (TEST_CLOCK_HZ / 1000));
+    HOST_CHECK_EQUAL(Wdt->CTL, WATCHDOG_CTL_INTEN_MASK | WATCHDOG_CTL_RESEN_MASK | WATCHDOG_CTL_INTTYPE_MASK);
+    HOST_CHECK_EQUAL(Wdt->TEST & WATCHDOG_TEST_STALL_MASK, WATCHDOG_TEST_STALL_MASK);
+    HOST_CHECK_EQUAL(Wdt->LOCK, WATCHDOG_LOCK_KEY);
+    HOST_CHECK(Test_TickHook == Watchdog_Tick);
+    HOST_CHECK(Test_Notifier == Watchdog_ClockChanged);
+    HOST_CHECK_EQUAL(Test_Handles[0], 0);
+    HOST_CHECK_EQUAL(Test_Handles[1], 1);
+    HOST_CHECK(!Watchdog_GetLastReport(&Report));
+
+    /* Ten time-outs long, fed on every tick */
+    HOST_CHECK(Test_Run(10 * TEST_TIMEOUT_MS));
+    HOST_CHECK_EQUAL(Test_Feeds, 10 * TEST_TIMEOUT_MS);
+    HOST_CHECK_EQUAL(Test_Nmis, 0);
+    HOST_CHECK_EQUAL(Test_Unlocked, 0);
+    HOST_CHECK_EQUAL(Wdt->VALUE, Wdt->LOAD);
+    HOST_CHECK(Watchdog_Supervise(Test_Tick));
+
+    /* The core clock goes to 80 MHz: same time-out in milliseconds */
+    Test_Clock = 80000000;
+    Test_Notifier(Test_Clock);
+    Test_Sync();
+    HOST_CHECK_EQUAL(Wdt->LOAD, TEST_TIMEOUT_MS * 80000);
+    HOST_CHECK(Test_Run(3 * TEST_TIMEOUT_MS));
+    HOST_CHECK_EQUAL(Test_Nmis, 0);
+    HOST_CHECK_EQUAL(Test_Unlocked, 0);
+}
+
+/* The task stops checking in: latched late, NMI one time-out later, reset one more later */
+static void Test_LateTask(void)
+{
+    Watchdog_ReportType Report;
+    uint32 Start = 0xFFFFFFFF - 210;
+    uint32 Last;
+
+    /* The last check-in is at 0xFFFFFFF0, the window ends after the wrap of the tick count */
+    Test_Tick = Start;
+    Test_Start(0);
+    HOST_CHECK(Test_Run(200));
+    Test_Periods[0] = 0;
+    Last = Watchdog_Clients[0].LastTick;
+    HOST_CHECK_EQUAL(Last, 0xFFFFFFF0);
+    HOST_CHECK(!Test_Run(1000));
+
+    /* Late once 20 ticks passed, the tick before was the last one fed */
+    HOST_CHECK_EQUAL(Watchdog_Report.Tick, Last + 21);
+    HOST_CHECK_EQUAL(Test_Feeds, (uint32)(Last + 20 - Start));
+    HOST_CHECK_EQUAL(Test_Nmis, 1);
+    HOST_CHECK_EQUAL(Test_NmiTick, Watchdog_Report.Tick - 1 + TEST_TIMEOUT_MS);
+    HOST_CHECK_EQUAL(Test_ResetTick, Test_NmiTick + TEST_TIMEOUT_MS);
+
+    /* After the reset the report is read back once, the reset cause cleared */
+    Test_PowerOn(Test_Resc | WATCHDOG_RESC_WDT0_MASK);
+    HOST_CHECK(Watchdog_Init(TEST_TIMEOUT_MS, 1));
+    HOST_CHECK_EQUAL(Test_Resc & WATCHDOG_RESC_WDT0_MASK, 0);
+    HOST_CHECK(Watchdog_GetLastReport(&Report));
+    HOST_CHECK_EQUAL(Report.Magic, WATCHDOG_REPORT_MAGIC);
+    HOST_CHECK_EQUAL(Report.Client, 0);
+    HOST_CHECK_EQUAL(Report.Kind, WATCHDOG_CLIENT_TASK);
+    HOST_CHECK_EQUAL(Report.Ident, 3);
+    HOST_CHECK_EQUAL(Report.Fault, WATCHDOG_FAULT_LATE);
+    HOST_CHECK_EQUAL(Report.StuckException, 0); /* Thread mode */
+    HOST_CHECK_EQUAL(Watchdog_Report.Magic, 0);
+    HOST_CHECK(!Watchdog_GetLastReport(NULL_PTR));
+
+    /* Power on reset: the stale report is not taken */
+    Watchdog_Report.Magic = WATCHDOG_REPORT_MAGIC;
+    Test_PowerOn(0);
+    HOST_CHECK(Watchdog_Init(TEST_TIMEOUT_MS, 1));
+    HOST_CHECK(!Watchdog_GetLastReport(&Report));
+}
+
+/* The ISR checks in faster than its window allows */
+static void Test_EarlyIsr(void)
+{
+    Watchdog_ReportType Report;
+
+    Test_Tick = 0;
+    Test_Start(0);
+    HOST_CHECK(Test_Run(50));
+    Test_Client(WATCHDOG_CLIENT_ISR, 30, 4, 8, 5);
+    HOST_CHECK(Test_Run(50));
+    Test_Periods[2] = 3;
+    HOST_CHECK(!Test_Run(1000));
+
+    Test_PowerOn(Test_Resc | WATCHDOG_RESC_WDT0_MASK);
+    HOST_CHECK(Watchdog_Init(TEST_TIMEOUT_MS, 1));
+    HOST_CHECK(Watchdog_GetLastReport(&Report));
+    HOST_CHECK_EQUAL(Report.Client, 2);
+    HOST_CHECK_EQUAL(Report.Kind, WATCHDOG_CLIENT_ISR);
+    HOST_CHECK_EQUAL(Report.Ident, 30);
+    HOST_CHECK_EQUAL(Report.Fault, WATCHDOG_FAULT_EARLY);
+    HOST_CHECK_EQUAL(Report.Tick, 102); /* 2 ticks after the check-in of tick 100 */
+}
+
+/* An ISR of higher priority than SysTick hangs: no fault seen, the NMI names it */
+static void Test_StuckIsr(void)
+{
+    Watchdog_ReportType Report;
+
+    Test_Tick = 0;
+    Test_Start(0);
+    HOST_CHECK(Test_Run(300));
+    Test_Nvic.PRI[5]         = 2 << NVIC_IRQ_PRIORITY_BITS_POS;
+    Test_Nvic.PRI[40]        = 1 << NVIC_IRQ_PRIORITY_BITS_POS; /* Nested in IRQ 5 */
+    Test_Nvic.ACTIVE[0]      = 1u << 5;
+    Test_Nvic.ACTIVE[1]      = 1u << (40 - 32);
+    Test_Scb.INTCTRL         = 0;
+    Test_Periods[0]          = 0;
+    Test_Periods[1]          = 0;
+    Test_SysTickMasked       = TRUE;
+    HOST_CHECK(!Test_Run(1000));
+    HOST_CHECK_EQUAL(Test_NmiTick, 300 + TEST_TIMEOUT_MS);
+    HOST_CHECK_EQUAL(Test_ResetTick, 300 + 2 * TEST_TIMEOUT_MS);
+
+    Test_PowerOn(Test_Resc | WATCHDOG_RESC_WDT0_MASK);
+    HOST_CHECK(Watchdog_Init(TEST_TIMEOUT_MS, 1));
+    HOST_CHECK(Watchdog_GetLastReport(&Report));
+    HOST_CHECK_EQUAL(Report.Fault, WATCHDOG_FAULT_TIMEOUT);
+    HOST_CHECK_EQUAL(Report.Client, WATCHDOG_INVALID_CLIENT);
+    HOST_CHECK_EQUAL(Report.Tick, 300 + TEST_TIMEOUT_MS);
+    HOST_CHECK_EQUAL(Report.StuckException, 16 + 40);
+    HOST_CHECK_EQUAL(Report.Active[0], 1u << 5);
+    HOST_CHECK_EQUAL(Report.Active[1], 1u << 8);
+}
+
+/* Exception found by the NMI from the active bits and priorities alone */
+static void Test_StuckException(void)
+{
+    memset(&Test_Nvic, 0, sizeof(Test_Nvic));
+    memset(&Test_Scb, 0, sizeof(Test_Scb));
+
+    Test_Scb.INTCTRL = TEST_RETTOBASE_MASK;
+    HOST_CHECK_EQUAL(Watchdog_StuckException(), 0); /* Thread mode */
+    Test_Scb.INTCTRL = 0;
+    HOST_CHECK_EQUAL(Watchdog_StuckException(), 3); /* Hard fault, no active bit */
+
+    /* SVC at level 1 preempted by IRQ 7 at level 0 */
+    Test_Scb.SYSPRI[SVC_SYSPRI_INDEX] = 1 << NVIC_IRQ_PRIORITY_BITS_POS;
+    Test_Scb.SYSHNDCTRL               = 0x00000080;
+    HOST_CHECK_EQUAL(Watchdog_StuckException(), 11);
+    Test_Nvic.ACTIVE[0] = 1u << 7;
+    HOST_CHECK_EQUAL(Watchdog_StuckException(), 16 + 7);
+
+    /* SysTick at level 0 over an IRQ at level 3 */
+    Test_Nvic.PRI[7]                      = 3 << NVIC_IRQ_PRIORITY_BITS_POS;
+    Test_Scb.SYSPRI[SYSTICK_SYSPRI_INDEX] = 0;
+    Test_Scb.SYSHNDCTRL                   = 0x00000800;
+    HOST_CHECK_EQUAL(Watchdog_StuckException(), 15);
+}
+
+/* 65535 ms at 80 MHz do not fit the 32-bit LOAD, a faster clock cuts the time-out to the counter */
+static void Test_LongTimeout(void)
+{
+    volatile WDT_RegType *Wdt = &Test_Wdt[WATCHDOG_TIMER];
+
+    Test_PowerOn(0);
+    Test_Clock = 80000000;
+    HOST_CHECK(!Watchdog_Init(65535, 1));
+    HOST_CHECK(Test_TickHook == NULL_PTR);
+    HOST_CHECK_EQUAL(Wdt->CTL, 0);
+
+    HOST_CHECK(Watchdog_Init(53687, 1));
+    HOST_CHECK_EQUAL(Wdt->LOAD, 53687UL * 80000);
+    HOST_CHECK(!Watchdog_Init(53688, 1));
+
+    Test_PowerOn(0);
+    HOST_CHECK(Watchdog_Init(65535, 1));
+    HOST_CHECK_EQUAL(Wdt->LOAD, 65535UL * 16000);
+    Test_Clock = 80000000;
+    Test_Notifier(Test_Clock);
+    HOST_CHECK_EQUAL(Wdt->LOAD, 0xFFFFFFFF);
+    HOST_CHECK_EQUAL(Wdt->LOCK, WATCHDOG_LOCK_KEY);
+    Test_Clock = 50000000;
+    Test_Notifier(Test_Clock);
+    HOST_CHECK_EQUAL(Wdt->LOAD, 65535UL * 50000);
+    Test_Clock = TEST_CLOCK_HZ;
+}
+
+static void Test_Rejected(void)
+{
+    uint32 Index;
+
+    Test_PowerOn(0);
+    HOST_CHECK(!Watchdog_Init(20, 10));
+    HOST_CHECK(Test_TickHook == NULL_PTR);
+    HOST_CHECK_EQUAL(Test_Wdt[WATCHDOG_TIMER].CTL, 0);
+
+    HOST_CHECK_EQUAL(Watchdog_Register(WATCHDOG_CLIENT_TASK, 1, 0, 0), WATCHDOG_INVALID_CLIENT);
+    HOST_CHECK_EQUAL(Watchdog_Register(WATCHDOG_CLIENT_TASK, 1, 6, 5), WATCHDOG_INVALID_CLIENT);
+    for(Index = 0; Index < WATCHDOG_MAX_CLIENTS; Index++)
+    {
+        HOST_CHECK_EQUAL(Watchdog_Register(WATCHDOG_CLIENT_TASK, 1, 0, 5), Index);
+    }
+    HOST_CHECK_EQUAL(Watchdog_Register(WATCHDOG_CLIENT_TASK, 1, 0, 5), WATCHDOG_INVALID_CLIENT);
+
+    Watchdog_CheckIn(WATCHDOG_MAX_CLIENTS);
+    Watchdog_CheckIn(WATCHDOG_INVALID_CLIENT);
+    HOST_CHECK(Watchdog_Supervise(Test_Tick));
+}
+
+int main(void)
+{
+    Test_Healthy();
+    Test_LateTask();
+    Test_EarlyIsr();
+    Test_StuckIsr();
+    Test_StuckException();
+    Test_LongTimeout();
+    Test_Rejected();
+
+    return Host_Report("watchdog_test");
+}